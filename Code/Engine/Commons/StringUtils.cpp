@@ -1,9 +1,66 @@
 //------------------------------------------------------------------------------------------------------------------------------
 #include "StringUtils.hpp"
+#include <math.h>
 #include <stdarg.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 //------------------------------------------------------------------------------------------------------------------------------
 const int STRINGF_STACK_LOCAL_TEMP_LENGTH = 2048;
+const int MAX_FAST_FLOAT_DIGITS = 19;						// fits a uint64_t without overflow
+const int MAX_FAST_FLOAT_EXPONENT = 22;						// 10^22 is the largest power of 10 a double holds exactly
+const int MAX_SLOW_FLOAT_LENGTH = 64;
+
+//------------------------------------------------------------------------------------------------------------------------------
+static const double s_powersOfTen[MAX_FAST_FLOAT_EXPONENT + 1] =
+{
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+static const char* SkipSpacesAndTabs( const char* start, const char* end )
+{
+	while (start < end && (*start == ' ' || *start == '\t'))
+	{
+		start++;
+	}
+
+	return start;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static inline bool IsDigit( char character )
+{
+	return character >= '0' && character <= '9';
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Anything the fast path can't do exactly (long mantissas, big exponents, halfway cases, inf and nan) goes through strtof
+// on a copy
+//------------------------------------------------------------------------------------------------------------------------------
+static const char* ParseFloatSlow( const char* start, const char* end, float* outValue )
+{
+	char text[MAX_SLOW_FLOAT_LENGTH + 1];
+	size_t length = static_cast<size_t>(end - start);
+	if (length > MAX_SLOW_FLOAT_LENGTH)
+	{
+		length = MAX_SLOW_FLOAT_LENGTH;
+	}
+
+	memcpy(text, start, length);
+	text[length] = '\0';
+
+	char* parseEnd = nullptr;
+	float value = strtof(text, &parseEnd);
+	if (parseEnd == text)
+	{
+		return start;
+	}
+
+	*outValue = value;
+	return start + (parseEnd - text);
+}
 
 //------------------------------------------------------------------------------------------------------------------------------
 const std::string Stringf( const char* format, ... )
@@ -64,4 +121,166 @@ std::vector<std::string> SplitStringOnDelimiter(const std::string& s, char delim
 	//Send him home
 	return splitStrings;
 
-}
\ No newline at end of file
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Digits go into one integer mantissa and the decimal point into the exponent, so the only rounding is the final
+// mantissa * 10^exponent (exact inputs while the mantissa fits 53 bits and the power of 10 is exact). That gives the
+// correctly rounded double, and narrowing it to float matches strtof unless the double lands exactly halfway between two
+// floats, which is the one case sent to the slow path.
+//------------------------------------------------------------------------------------------------------------------------------
+const char* ParseFloatFromRange( const char* start, const char* end, float* outValue )
+{
+	const char* numberStart = SkipSpacesAndTabs(start, end);
+	const char* cursor = numberStart;
+
+	bool isNegative = false;
+	if (cursor < end && (*cursor == '-' || *cursor == '+'))
+	{
+		isNegative = (*cursor == '-');
+		cursor++;
+	}
+
+	uint64_t mantissa = 0;
+	int numDigits = 0;							// significant digits, leading zeros don't count
+	int exponent = 0;
+	bool hasDigits = false;
+
+	while (cursor < end && IsDigit(*cursor))
+	{
+		hasDigits = true;
+		if (numDigits < MAX_FAST_FLOAT_DIGITS)
+		{
+			mantissa = mantissa * 10 + static_cast<uint64_t>(*cursor - '0');
+			if (mantissa != 0)
+			{
+				numDigits++;
+			}
+		}
+		else
+		{
+			exponent++;
+			numDigits++;
+		}
+		cursor++;
+	}
+
+	if (cursor < end && *cursor == '.')
+	{
+		cursor++;
+		while (cursor < end && IsDigit(*cursor))
+		{
+			hasDigits = true;
+			if (numDigits < MAX_FAST_FLOAT_DIGITS)
+			{
+				mantissa = mantissa * 10 + static_cast<uint64_t>(*cursor - '0');
+				exponent--;
+				if (mantissa != 0)
+				{
+					numDigits++;
+				}
+			}
+			else
+			{
+				numDigits++;
+			}
+			cursor++;
+		}
+	}
+
+	//No digits at all ("-", ".", "inf", "nan")
+	if (!hasDigits)
+	{
+		return ParseFloatSlow(numberStart, end, outValue);
+	}
+
+	if (cursor < end && (*cursor == 'e' || *cursor == 'E'))
+	{
+		const char* exponentCursor = cursor + 1;
+		bool isExponentNegative = false;
+		if (exponentCursor < end && (*exponentCursor == '-' || *exponentCursor == '+'))
+		{
+			isExponentNegative = (*exponentCursor == '-');
+			exponentCursor++;
+		}
+
+		if (exponentCursor < end && IsDigit(*exponentCursor))
+		{
+			int exponentValue = 0;
+			while (exponentCursor < end && IsDigit(*exponentCursor))
+			{
+				if (exponentValue < 10000)
+				{
+					exponentValue = exponentValue * 10 + (*exponentCursor - '0');
+				}
+				exponentCursor++;
+			}
+
+			exponent += isExponentNegative ? -exponentValue : exponentValue;
+			cursor = exponentCursor;
+		}
+	}
+
+	if (mantissa == 0)
+	{
+		*outValue = isNegative ? -0.f : 0.f;
+		return cursor;
+	}
+
+	if (numDigits > MAX_FAST_FLOAT_DIGITS || mantissa > (static_cast<uint64_t>(1) << 53) || exponent > MAX_FAST_FLOAT_EXPONENT || exponent < -MAX_FAST_FLOAT_EXPONENT)
+	{
+		return ParseFloatSlow(numberStart, end, outValue);
+	}
+
+	double value = static_cast<double>(mantissa);
+	if (exponent < 0)
+	{
+		value /= s_powersOfTen[-exponent];
+	}
+	else if (exponent > 0)
+	{
+		value *= s_powersOfTen[exponent];
+	}
+
+	float rounded = static_cast<float>(value);
+	double roundingError = value - static_cast<double>(rounded);
+	if (roundingError != 0.0)
+	{
+		float neighbour = nextafterf(rounded, (roundingError > 0.0) ? HUGE_VALF : -HUGE_VALF);
+		if (static_cast<double>(neighbour) - value == roundingError)
+		{
+			return ParseFloatSlow(numberStart, end, outValue);
+		}
+	}
+
+	*outValue = isNegative ? -rounded : rounded;
+	return cursor;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const char* ParseIntFromRange( const char* start, const char* end, int* outValue )
+{
+	const char* cursor = SkipSpacesAndTabs(start, end);
+
+	bool isNegative = false;
+	if (cursor < end && (*cursor == '-' || *cursor == '+'))
+	{
+		isNegative = (*cursor == '-');
+		cursor++;
+	}
+
+	if (cursor >= end || !IsDigit(*cursor))
+	{
+		return start;
+	}
+
+	int value = 0;
+	while (cursor < end && IsDigit(*cursor))
+	{
+		value = value * 10 + (*cursor - '0');
+		cursor++;
+	}
+
+	*outValue = isNegative ? -value : value;
+	return cursor;
+}
@@ -10,3 +10,9 @@ const std::string Stringf( const int maxLength, const char* format, ... );
 //------------------------------------------------------------------------------------------------------------------------------
 std::vector<std::string> SplitStringOnDelimiter(const std::string& s, char delimiter);
 
+//------------------------------------------------------------------------------------------------------------------------------
+// Allocation free number parsing over [start, end) for bulk text (OBJ files), no terminator needed.
+// Leading spaces and tabs are skipped. Returns the first character after the number, or start if there was no number.
+//------------------------------------------------------------------------------------------------------------------------------
+const char* ParseFloatFromRange(const char* start, const char* end, float* outValue);
+const char* ParseIntFromRange(const char* start, const char* end, int* outValue);
@@ -26,7 +26,13 @@ void BufferWriteUtils::SetEndianMode(eBufferEndianness endianModeToUseForSubsequ
 //------------------------------------------------------------------------------------------------------------------------------
 void BufferWriteUtils::ReserveAdditional(size_t additionalBytes)
 {
-	m_buffer.reserve(m_buffer.size() + additionalBytes);
+	//Grow geometrically, reserving the exact size would reallocate on every append
+	size_t requiredSize = m_buffer.size() + additionalBytes;
+	if (requiredSize > m_buffer.capacity())
+	{
+		size_t doubledSize = m_buffer.capacity() * 2;
+		m_buffer.reserve((requiredSize > doubledSize) ? requiredSize : doubledSize);
+	}
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
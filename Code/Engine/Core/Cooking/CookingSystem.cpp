@@ -1,4 +1,319 @@
 #include "Engine/Core/Cooking/CookingSystem.hpp"
+//Engine Systems
+#include "Engine/Commons/StringUtils.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/Image.hpp"
+#include "Engine/Core/JobSystem/Job.hpp"
+#include "Engine/Core/JobSystem/JobSystem.hpp"
+#include "Engine/Core/MemoryMappedFile.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Core/XMLUtils/XMLUtils.hpp"
+#include "Engine/Renderer/CPUMesh.hpp"
+#include "Engine/Renderer/MeshOptimizer.hpp"
+#include "Engine/Renderer/ObjectLoader.hpp"
+#include "Engine/Renderer/PMSHFormat.hpp"
+#include <algorithm>
+#include <atomic>
+#include <ctype.h>
+#include <stdlib.h>
+#include <thread>
+
+//------------------------------------------------------------------------------------------------------------------------------
+// One asset to cook. Built on the calling thread, filled in by a job.
+//------------------------------------------------------------------------------------------------------------------------------
+struct CookWorkItem
+{
+	std::string					m_sourcePath = "";
+	std::string					m_cookedPath = "";
+	eCookAssetType				m_type = COOK_ASSET_MESH;
+	std::vector<std::string>	m_dependencies;				// other files whose bytes go into the hash
+	uint64_t					m_hash = 0;
+	MeshOptimizerStats			m_optimizerStats;			// meshes only
+	uint						m_numLODs = 0;
+	bool						m_isUpToDate = false;
+	bool						m_succeeded = false;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Bump these when the cooked output changes without the loaders' format versions changing, it recooks everything
+//------------------------------------------------------------------------------------------------------------------------------
+static std::string GetCookSettings(eCookAssetType type)
+{
+	switch (type)
+	{
+	case COOK_ASSET_MESH:
+		return Stringf("PMSH %d.%d optimizer cache %u overdraw %.2f lods %u ratio %.2f tangents mikktspace", PMSH_VERSION_MAJOR, PMSH_VERSION_MINOR, MESH_OPTIMIZER_CACHE_SIZE,
+			MESH_OPTIMIZER_OVERDRAW_THRESHOLD, MESH_LOD_MAX_LEVELS, MESH_LOD_TRIANGLE_RATIO);
+	case COOK_ASSET_COLLISION:
+		return "PCVX 1";
+	case COOK_ASSET_TEXTURE:
+		return Stringf("PTEX %d", PTEX_VERSION);
+	default:
+		return "";
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static const char* GetCookAssetTypeName(eCookAssetType type)
+{
+	switch (type)
+	{
+	case COOK_ASSET_MESH:		return "mesh";
+	case COOK_ASSET_COLLISION:	return "collision";
+	case COOK_ASSET_TEXTURE:	return "texture";
+	default:					return "unknown";
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static std::string GetManifestKey(eCookAssetType type, const std::string& sourcePath)
+{
+	return std::string(GetCookAssetTypeName(type)) + ":" + sourcePath;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static std::string GetLowerCaseExtension(const std::string& filePath)
+{
+	size_t extensionStart = filePath.find_last_of('.');
+	if (extensionStart == std::string::npos)
+	{
+		return "";
+	}
+
+	std::string extension = filePath.substr(extensionStart + 1);
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return static_cast<char>(tolower(c)); });
+	return extension;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// 64 bit FNV-1a, wide enough that a collision across a whole content set isn't a concern
+//------------------------------------------------------------------------------------------------------------------------------
+static uint64_t HashBytes(uint64_t hash, const unsigned char* bytes, size_t numBytes)
+{
+	for (size_t byteIndex = 0; byteIndex < numBytes; byteIndex++)
+	{
+		hash ^= bytes[byteIndex];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static uint64_t HashFile(uint64_t hash, const std::string& filePath)
+{
+	//The path goes in too so a missing dependency and an empty one hash differently
+	hash = HashBytes(hash, reinterpret_cast<const unsigned char*>(filePath.c_str()), filePath.size() + 1);
+
+	MemoryMappedFile file;
+	if (file.Open(filePath))
+	{
+		hash = HashBytes(hash, file.GetData(), file.GetSize());
+	}
+
+	return hash;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static uint64_t HashCookInputs(const CookWorkItem& item)
+{
+	std::string settings = GetCookSettings(item.m_type);
+	uint64_t hash = HashBytes(14695981039346656037ULL, reinterpret_cast<const unsigned char*>(settings.c_str()), settings.size());
+
+	hash = HashFile(hash, item.m_sourcePath);
+	for (const std::string& dependency : item.m_dependencies)
+	{
+		hash = HashFile(hash, dependency);
+	}
+
+	return hash;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Same path the loaders take, with the cooked write done explicitly instead of in the loader's destructor
+//------------------------------------------------------------------------------------------------------------------------------
+static bool CookMeshFile(CookWorkItem* item)
+{
+	const std::string& sourcePath = item->m_sourcePath;
+
+	ObjectLoader loader;
+	loader.m_fullFileName = sourcePath;
+	loader.m_cookingRun = true;
+	loader.m_loadCollision = false;
+
+	if (GetLowerCaseExtension(sourcePath) == "mesh")
+	{
+		if (!loader.ReadSettingsFromXML(sourcePath))
+		{
+			return false;
+		}
+
+		loader.LoadFromXML(sourcePath);
+	}
+	else
+	{
+		loader.CreateFromString(sourcePath.c_str());
+		loader.CreateCPUMesh();
+	}
+
+	if (loader.m_cpuMesh == nullptr || loader.m_cpuMesh->GetIndexCount() == 0)
+	{
+		return false;
+	}
+
+	item->m_optimizerStats = loader.m_optimizerStats;
+	item->m_numLODs = loader.m_cpuMesh->GetLODCount();
+	return loader.MakeCookedVersion();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Hashing and the up to date check happen here too, reading every source is a good part of the cost of a cook.
+// The manifest is only read while jobs run, so sharing it is safe.
+//------------------------------------------------------------------------------------------------------------------------------
+static void RunCookWorkItem(CookWorkItem* item, const std::map<std::string, CookManifestEntry>& manifest, bool forceCook)
+{
+	item->m_hash = HashCookInputs(*item);
+
+	std::map<std::string, CookManifestEntry>::const_iterator entry = manifest.find(GetManifestKey(item->m_type, item->m_sourcePath));
+	item->m_isUpToDate = !forceCook && entry != manifest.end() && entry->second.m_hash == item->m_hash && DoesFileExist(item->m_cookedPath);
+	if (item->m_isUpToDate)
+	{
+		item->m_succeeded = true;
+		return;
+	}
+
+	switch (item->m_type)
+	{
+	case COOK_ASSET_MESH:
+		item->m_succeeded = CookMeshFile(item);
+		break;
+	case COOK_ASSET_TEXTURE:
+		item->m_succeeded = CookImageToFile(item->m_sourcePath, item->m_cookedPath);
+		break;
+	default:
+		//Collision goes through PhysX, which is done back on the calling thread
+		break;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+class CookWorkItemJob : public Job
+{
+public:
+	CookWorkItemJob(CookWorkItem* item, const std::map<std::string, CookManifestEntry>* manifest, bool forceCook, std::atomic<int>* jobsRemaining)
+		: m_item(item), m_manifest(manifest), m_forceCook(forceCook), m_jobsRemaining(jobsRemaining)
+	{
+	}
+
+	void Execute()
+	{
+		RunCookWorkItem(m_item, *m_manifest, m_forceCook);
+
+		//Last thing we touch, the item and counter belong to the waiting caller
+		m_jobsRemaining->fetch_sub(1);
+	}
+
+private:
+	CookWorkItem*									m_item = nullptr;
+	const std::map<std::string, CookManifestEntry>*	m_manifest = nullptr;
+	bool											m_forceCook = false;
+	std::atomic<int>*								m_jobsRemaining = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void AddWorkItemsForFile(std::vector<CookWorkItem>& items, const std::string& filePath, uint typeMask)
+{
+	std::string extension = GetLowerCaseExtension(filePath);
+
+	if (extension == "obj" && (typeMask & (1U << COOK_ASSET_MESH)))
+	{
+		CookWorkItem item;
+		item.m_sourcePath = filePath;
+		item.m_cookedPath = GetCookedMeshPath(filePath);
+		item.m_type = COOK_ASSET_MESH;
+		items.push_back(item);
+	}
+	else if (extension == "mesh")
+	{
+		ObjectLoader settings;
+		settings.m_cookingRun = false;
+		if (!settings.ReadSettingsFromXML(filePath))
+		{
+			DebuggerPrintf("\n Cooking: could not read %s", filePath.c_str());
+			return;
+		}
+
+		if (typeMask & (1U << COOK_ASSET_MESH))
+		{
+			CookWorkItem item;
+			item.m_sourcePath = filePath;
+			item.m_cookedPath = GetCookedMeshPath(filePath);
+			item.m_type = COOK_ASSET_MESH;
+			item.m_dependencies.push_back(MODEL_PATH + settings.m_source);
+			items.push_back(item);
+		}
+
+		if ((typeMask & (1U << COOK_ASSET_COLLISION)) && settings.m_collisions.size() > 0)
+		{
+			CookWorkItem item;
+			item.m_sourcePath = filePath;
+			item.m_cookedPath = GetCookedCollisionPath(filePath, 0);
+			item.m_type = COOK_ASSET_COLLISION;
+			for (const ObjCollisionSource& collision : settings.m_collisions)
+			{
+				item.m_dependencies.push_back(MODEL_PATH + collision.m_source);
+			}
+			items.push_back(item);
+		}
+	}
+	else if ((extension == "png" || extension == "jpg" || extension == "jpeg" || extension == "tga" || extension == "bmp")
+		&& (typeMask & (1U << COOK_ASSET_TEXTURE)))
+	{
+		CookWorkItem item;
+		item.m_sourcePath = filePath;
+		item.m_cookedPath = GetCookedImagePath(filePath);
+		item.m_type = COOK_ASSET_TEXTURE;
+		items.push_back(item);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// A .mesh and the .obj it wraps usually share a name and so a .pmsh. The loader finds the .pmsh by name either way,
+// so only one may write it and the .mesh wins since it carries the settings.
+//------------------------------------------------------------------------------------------------------------------------------
+static void RemoveDuplicateOutputs(std::vector<CookWorkItem>& items)
+{
+	std::map<std::string, size_t> itemByOutput;
+	std::vector<bool> isRemoved(items.size(), false);
+
+	for (size_t itemIndex = 0; itemIndex < items.size(); itemIndex++)
+	{
+		std::map<std::string, size_t>::iterator existing = itemByOutput.find(items[itemIndex].m_cookedPath);
+		if (existing == itemByOutput.end())
+		{
+			itemByOutput[items[itemIndex].m_cookedPath] = itemIndex;
+		}
+		else if (GetLowerCaseExtension(items[itemIndex].m_sourcePath) == "mesh")
+		{
+			isRemoved[existing->second] = true;
+			existing->second = itemIndex;
+		}
+		else
+		{
+			isRemoved[itemIndex] = true;
+		}
+	}
+
+	size_t numKept = 0;
+	for (size_t itemIndex = 0; itemIndex < items.size(); itemIndex++)
+	{
+		if (!isRemoved[itemIndex])
+		{
+			items[numKept++] = items[itemIndex];
+		}
+	}
+	items.resize(numKept);
+}
 
 //------------------------------------------------------------------------------------------------------------------------------
 CookingSystem::CookingSystem()
@@ -13,8 +328,233 @@ CookingSystem::~CookingSystem()
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-void CookingSystem::CookGPUMesh(const GPUMesh& mesh)
+CookStats CookingSystem::CookAssetsUnderDirectory(const std::string& directory, uint typeMask, bool forceCook)
+{
+	std::vector<std::string> filePaths;
+	GetFilesInDirectory(filePaths, directory);
+
+	std::vector<CookWorkItem> items;
+	for (const std::string& filePath : filePaths)
+	{
+		AddWorkItemsForFile(items, filePath, typeMask);
+	}
+	RemoveDuplicateOutputs(items);
+
+	CookWorkItems(items, forceCook);
+	return m_lastStats;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CookingSystem::CookMeshesUnderDirectory(const std::string& meshDir)
+{
+	CookAssetsUnderDirectory(meshDir, (1U << COOK_ASSET_MESH) | (1U << COOK_ASSET_COLLISION));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool CookingSystem::CookAsset(const std::string& sourcePath, bool forceCook)
+{
+	std::vector<CookWorkItem> items;
+	AddWorkItemsForFile(items, sourcePath, COOK_MASK_ALL);
+	if (items.empty())
+	{
+		return false;
+	}
+
+	CookWorkItems(items, forceCook);
+	return m_lastStats.m_numFailed == 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool CookingSystem::CookCPUMesh(const CPUMesh& mesh, const std::string& cookedPath)
+{
+	Buffer buffer;
+	WritePMSH(buffer, mesh);
+	return SaveBinaryFileFromBuffer(cookedPath, buffer);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CookingSystem::CookWorkItems(std::vector<CookWorkItem>& items, bool forceCook)
+{
+	if (m_isCooking)
+	{
+		//A loader cooking on demand from inside a cook would write the manifest out from under us
+		DebuggerPrintf("\n Cooking: already cooking, ignoring the nested request");
+		return;
+	}
+
+	m_isCooking = true;
+	double startTime = GetCurrentTimeSeconds();
+	LoadManifest();
+
+	int numItems = (int)items.size();
+	if (numItems > 1)
+	{
+		JobSystem* jobSystem = JobSystem::GetInstance();
+		std::atomic<int> jobsRemaining(numItems - 1);
+		for (int itemIndex = 1; itemIndex < numItems; itemIndex++)
+		{
+			jobSystem->Run(new CookWorkItemJob(&items[itemIndex], &m_manifest, forceCook, &jobsRemaining));
+		}
+
+		//Cook the first one here and help out with the rest rather than sleeping
+		RunCookWorkItem(&items[0], m_manifest, forceCook);
+		while (jobsRemaining.load() > 0)
+		{
+			if (!jobSystem->ProcessCategory(JOB_GENERIC))
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+	else if (numItems == 1)
+	{
+		RunCookWorkItem(&items[0], m_manifest, forceCook);
+	}
+
+	//Collision hulls through PhysX (or whoever listens), one event per <collision>
+	for (CookWorkItem& item : items)
+	{
+		if (item.m_type != COOK_ASSET_COLLISION || item.m_isUpToDate)
+		{
+			continue;
+		}
+
+		ObjectLoader settings;
+		settings.m_cookingRun = false;
+		settings.m_fullFileName = item.m_sourcePath;
+		if (settings.ReadSettingsFromXML(item.m_sourcePath))
+		{
+			int numCooked = settings.FireCollisionEvents("CookCollisionMesh");
+			item.m_succeeded = (numCooked == (int)settings.m_collisions.size());
+		}
+	}
+
+	m_lastStats = CookStats();
+	m_lastStats.m_numAssets = numItems;
+	for (const CookWorkItem& item : items)
+	{
+		if (item.m_isUpToDate)
+		{
+			m_lastStats.m_numUpToDate++;
+			continue;
+		}
+
+		std::string key = GetManifestKey(item.m_type, item.m_sourcePath);
+		if (!item.m_succeeded)
+		{
+			//Dropped so a failed asset is retried next time even if nothing changes
+			m_lastStats.m_numFailed++;
+			m_manifest.erase(key);
+			DebuggerPrintf("\n Cooking: failed to cook %s %s", GetCookAssetTypeName(item.m_type), item.m_sourcePath.c_str());
+			continue;
+		}
+
+		CookManifestEntry& entry = m_manifest[key];
+		entry.m_sourcePath = item.m_sourcePath;
+		entry.m_cookedPath = item.m_cookedPath;
+		entry.m_type = item.m_type;
+		entry.m_hash = item.m_hash;
+		m_lastStats.m_numCooked++;
+
+		if (item.m_type == COOK_ASSET_MESH)
+		{
+			float numTriangles = (float)(item.m_optimizerStats.m_numIndices / 3);
+			m_lastStats.m_meshVerticesBefore += item.m_optimizerStats.m_verticesBefore;
+			m_lastStats.m_meshVerticesAfter += item.m_optimizerStats.m_verticesAfter;
+			m_lastStats.m_meshTriangles += item.m_optimizerStats.m_numIndices / 3;
+			m_lastStats.m_meshLODs += item.m_numLODs;
+			m_lastStats.m_meshAcmrBefore += item.m_optimizerStats.m_acmrBefore * numTriangles;
+			m_lastStats.m_meshAcmrAfter += item.m_optimizerStats.m_acmrAfter * numTriangles;
+		}
+	}
+
+	if (m_lastStats.m_meshTriangles > 0)
+	{
+		m_lastStats.m_meshAcmrBefore /= (float)m_lastStats.m_meshTriangles;
+		m_lastStats.m_meshAcmrAfter /= (float)m_lastStats.m_meshTriangles;
+	}
+
+	if (m_lastStats.m_numCooked > 0 || m_lastStats.m_numFailed > 0)
+	{
+		SaveManifest();
+	}
+
+	m_lastStats.m_seconds = GetCurrentTimeSeconds() - startTime;
+	DebuggerPrintf("\n Cooking: %d assets, %d cooked, %d up to date, %d failed in %.2fs", m_lastStats.m_numAssets,
+		m_lastStats.m_numCooked, m_lastStats.m_numUpToDate, m_lastStats.m_numFailed, m_lastStats.m_seconds);
+
+	if (m_lastStats.m_meshTriangles > 0)
+	{
+		DebuggerPrintf("\n Cooking: meshes %u -> %u vertices, ACMR %.3f -> %.3f over %u triangles, %u LODs", m_lastStats.m_meshVerticesBefore,
+			m_lastStats.m_meshVerticesAfter, m_lastStats.m_meshAcmrBefore, m_lastStats.m_meshAcmrAfter, m_lastStats.m_meshTriangles, m_lastStats.m_meshLODs);
+	}
+
+	m_isCooking = false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CookingSystem::LoadManifest()
 {
-	
+	if (m_isManifestLoaded)
+	{
+		return;
+	}
+
+	m_isManifestLoaded = true;
+
+	tinyxml2::XMLDocument manifestDoc;
+	manifestDoc.LoadFile(COOK_MANIFEST_PATH);
+	if (manifestDoc.ErrorID() != tinyxml2::XML_SUCCESS || manifestDoc.RootElement() == nullptr)
+	{
+		//First cook, everything is out of date
+		return;
+	}
+
+	XMLElement* elem = manifestDoc.RootElement()->FirstChildElement("asset");
+	while (elem != nullptr)
+	{
+		CookManifestEntry entry;
+		entry.m_sourcePath = ParseXmlAttribute(*elem, "source", "");
+		entry.m_cookedPath = ParseXmlAttribute(*elem, "cooked", "");
+		entry.m_hash = strtoull(ParseXmlAttribute(*elem, "hash", "0").c_str(), nullptr, 16);
+
+		std::string typeName = ParseXmlAttribute(*elem, "type", "");
+		for (int typeIndex = 0; typeIndex < NUM_COOK_ASSET_TYPES; typeIndex++)
+		{
+			if (typeName == GetCookAssetTypeName((eCookAssetType)typeIndex))
+			{
+				entry.m_type = (eCookAssetType)typeIndex;
+				m_manifest[GetManifestKey(entry.m_type, entry.m_sourcePath)] = entry;
+				break;
+			}
+		}
+
+		elem = elem->NextSiblingElement("asset");
+	}
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+void CookingSystem::SaveManifest() const
+{
+	tinyxml2::XMLDocument manifestDoc;
+	XMLElement* root = manifestDoc.NewElement("CookManifest");
+	manifestDoc.InsertEndChild(root);
+
+	//std::map keeps it sorted, so the file diffs cleanly between cooks
+	for (const std::pair<const std::string, CookManifestEntry>& pair : m_manifest)
+	{
+		const CookManifestEntry& entry = pair.second;
+
+		XMLElement* elem = manifestDoc.NewElement("asset");
+		elem->SetAttribute("type", GetCookAssetTypeName(entry.m_type));
+		elem->SetAttribute("source", entry.m_sourcePath.c_str());
+		elem->SetAttribute("cooked", entry.m_cookedPath.c_str());
+		elem->SetAttribute("hash", Stringf("%016llx", (unsigned long long)entry.m_hash).c_str());
+		root->InsertEndChild(elem);
+	}
+
+	if (manifestDoc.SaveFile(COOK_MANIFEST_PATH) != tinyxml2::XML_SUCCESS)
+	{
+		DebuggerPrintf("\n Cooking: could not write %s", COOK_MANIFEST_PATH);
+	}
+}
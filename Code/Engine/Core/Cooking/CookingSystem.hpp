@@ -1,7 +1,58 @@
 #pragma once
 #include "Engine/Commons/EngineCommon.hpp"
-#include "Engine/Renderer/GPUMesh.hpp"
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class CPUMesh;
+struct CookWorkItem;
+
+//------------------------------------------------------------------------------------------------------------------------------
+enum eCookAssetType
+{
+	COOK_ASSET_MESH = 0,		// .obj and .mesh to .pmsh (and .pbvh when the .mesh asks for one)
+	COOK_ASSET_COLLISION,		// the <collision> entries of a .mesh to .pcvx, cooked by whoever handles "CookCollisionMesh"
+	COOK_ASSET_TEXTURE,			// .png .jpg .tga .bmp to .ptex
+
+	NUM_COOK_ASSET_TYPES
+};
+
+constexpr uint		COOK_MASK_ALL = (1U << NUM_COOK_ASSET_TYPES) - 1;
+constexpr char		COOK_MANIFEST_PATH[] = "Data/Bin/CookManifest.xml";
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct CookManifestEntry
+{
+	std::string			m_sourcePath = "";
+	std::string			m_cookedPath = "";			// first output, it has to exist for the entry to count as up to date
+	eCookAssetType		m_type = COOK_ASSET_MESH;
+	uint64_t			m_hash = 0;					// source bytes, dependency bytes and cook settings
+};
 
+//------------------------------------------------------------------------------------------------------------------------------
+struct CookStats
+{
+	int					m_numAssets = 0;
+	int					m_numCooked = 0;
+	int					m_numUpToDate = 0;
+	int					m_numFailed = 0;
+	double				m_seconds = 0.0;
+
+	//Totals over the meshes cooked, ACMR weighted by triangles
+	uint				m_meshVerticesBefore = 0;
+	uint				m_meshVerticesAfter = 0;
+	uint				m_meshTriangles = 0;
+	uint				m_meshLODs = 0;				// LOD1 and down
+	float				m_meshAcmrBefore = 0.f;
+	float				m_meshAcmrAfter = 0.f;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Cooks source assets into the formats the loaders read directly. Every cooked output is recorded in a manifest with
+// a hash of everything that went into it, so assets whose sources and settings haven't changed are skipped.
+// Meshes and textures are cooked in parallel on the JobSystem; collision hulls go through PhysX cooking on the calling
+// thread once the jobs are done.
 //------------------------------------------------------------------------------------------------------------------------------
 class CookingSystem
 {
@@ -9,12 +60,25 @@ public:
 	CookingSystem();
 	~CookingSystem();
 
-	void	CookMeshesUnderDirectory(const std::string& meshDir = "Data/Models/");
+	//Offline: everything under the directory (recursively) that matches the type mask
+	CookStats			CookAssetsUnderDirectory(const std::string& directory, uint typeMask = COOK_MASK_ALL, bool forceCook = false);
+	void				CookMeshesUnderDirectory(const std::string& meshDir = MODEL_PATH);
 
-	void	CookGPUMesh(const GPUMesh& mesh);
+	//On demand: one source file, and for a .mesh its collision hulls too. Returns false if anything failed.
+	bool				CookAsset(const std::string& sourcePath, bool forceCook = false);
 
-private:
-	bool	m_isCooking = false;
+	bool				CookCPUMesh(const CPUMesh& mesh, const std::string& cookedPath);
 
+	inline const CookStats&		GetLastCookStats() const		{ return m_lastStats; }
 
+private:
+	void				LoadManifest();
+	void				SaveManifest() const;
+	void				CookWorkItems(std::vector<CookWorkItem>& items, bool forceCook);
+
+private:
+	std::map<std::string, CookManifestEntry>	m_manifest;			// keyed by type and source path
+	CookStats									m_lastStats;
+	bool										m_isCooking = false;
+	bool										m_isManifestLoaded = false;
 };
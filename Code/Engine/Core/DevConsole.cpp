@@ -5,6 +5,7 @@
 #include "Engine/Core/Time.hpp"
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Commons/Profiler/Profiler.hpp"
+#include "Engine/Math/CollisionBenchmark.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
@@ -315,6 +316,7 @@ void DevConsole::Startup()
 	g_eventSystem->SubscribeEventCallBackFn("Logf", Command_Logf);
 
 	g_eventSystem->SubscribeEventCallBackFn("Screenshot", Command_ScreenShot);
+	g_eventSystem->SubscribeEventCallBackFn("BenchmarkCollision", Command_BenchmarkCollision);
 
 	m_currentInput.clear();
 }
@@ -711,3 +713,21 @@ STATIC bool DevConsole::Command_ScreenShot(EventArgs& args)
 	g_renderContext->RequestScreenshot();
 	return true;
 }
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC bool DevConsole::Command_BenchmarkCollision(EventArgs& args)
+{
+	int numIterations = args.GetValue("Iterations", 100);
+
+	std::vector<CollisionBenchmarkResult> results;
+	RunCollisionBenchmark(&results, numIterations);
+
+	g_devConsole->PrintString(CONSOLE_INFO, Stringf("Collision benchmark, %d iterations", numIterations));
+	for(int resultIndex = 0; resultIndex < static_cast<int>(results.size()); resultIndex++)
+	{
+		const CollisionBenchmarkResult& result = results[resultIndex];
+		g_devConsole->PrintString(Rgba::WHITE, Stringf("%-24s %8.2f ns/call  %d hits", result.m_name, result.m_nanosecondsPerCall, result.m_numHits));
+	}
+
+	return true;
+}
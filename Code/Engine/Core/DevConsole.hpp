@@ -75,6 +75,7 @@ public:
 	static bool		Command_Logf(EventArgs& args);
 
 	static bool		Command_ScreenShot(EventArgs& args);
+	static bool		Command_BenchmarkCollision(EventArgs& args);
 	//Uses ExecuteCommandLine for now
 	static bool		Command_Exec(EventArgs& args);
 
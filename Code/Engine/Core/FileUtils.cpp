@@ -1,7 +1,16 @@
 //------------------------------------------------------------------------------------------------------------------------------
 #include "Engine/Core/FileUtils.hpp"
+#include <algorithm>
 #include <fstream>
 
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN		// Always #define this before #including <windows.h>
+#include <windows.h>			// #include this (massive, platform-specific) header in very few places
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
 //------------------------------------------------------------------------------------------------------------------------------
 unsigned long CreateFileReadBuffer(const std::string& fileName, char **outData )
 {
@@ -133,6 +142,103 @@ std::string GetDirectoryFromFilePath(const std::string& filePath)
 	}
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+bool DoesFileExist(const std::string& filePath)
+{
+#if defined(_WIN32)
+	DWORD attributes = GetFileAttributesA(filePath.c_str());
+	return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY) == 0;
+#else
+	struct stat fileStats;
+	return stat(filePath.c_str(), &fileStats) == 0 && S_ISREG(fileStats.st_mode);
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void AppendFilesInDirectory(std::vector<std::string>& outFilePaths, const std::string& directory, bool recursive)
+{
+	std::vector<std::string> subDirectories;
+
+#if defined(_WIN32)
+	WIN32_FIND_DATAA findData;
+	HANDLE findHandle = FindFirstFileA((directory + "*").c_str(), &findData);
+	if (findHandle == INVALID_HANDLE_VALUE)
+	{
+		return;
+	}
+
+	do
+	{
+		std::string name = findData.cFileName;
+		if (name == "." || name == "..")
+		{
+			continue;
+		}
+
+		if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+		{
+			subDirectories.push_back(directory + name + "/");
+		}
+		else
+		{
+			outFilePaths.push_back(directory + name);
+		}
+	} while (FindNextFileA(findHandle, &findData));
+
+	FindClose(findHandle);
+#else
+	DIR* directoryHandle = opendir(directory.c_str());
+	if (directoryHandle == nullptr)
+	{
+		return;
+	}
+
+	while (dirent* entry = readdir(directoryHandle))
+	{
+		std::string name = entry->d_name;
+		if (name == "." || name == "..")
+		{
+			continue;
+		}
+
+		struct stat fileStats;
+		std::string path = directory + name;
+		if (stat(path.c_str(), &fileStats) == 0 && S_ISDIR(fileStats.st_mode))
+		{
+			subDirectories.push_back(path + "/");
+		}
+		else
+		{
+			outFilePaths.push_back(path);
+		}
+	}
+
+	closedir(directoryHandle);
+#endif
+
+	if (recursive)
+	{
+		for (const std::string& subDirectory : subDirectories)
+		{
+			AppendFilesInDirectory(outFilePaths, subDirectory, recursive);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void GetFilesInDirectory(std::vector<std::string>& outFilePaths, const std::string& directory, bool recursive)
+{
+	std::string searchDirectory = directory;
+	if (!searchDirectory.empty() && searchDirectory.back() != '/' && searchDirectory.back() != '\\')
+	{
+		searchDirectory += "/";
+	}
+
+	size_t firstNewPath = outFilePaths.size();
+	AppendFilesInDirectory(outFilePaths, searchDirectory, recursive);
+	std::sort(outFilePaths.begin() + firstNewPath, outFilePaths.end());
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 bool LoadBinaryFileToExistingBuffer(const std::string& filePath, std::vector<unsigned char>& outBuffer)
 {
@@ -10,6 +10,9 @@ std::ofstream*				CreateFileWriteBuffer(const std::string& fileName);
 std::ofstream*				CreateTextFileWriteBuffer(const std::string& fileName);
 
 std::string					GetDirectoryFromFilePath(const std::string& filePath);
+bool						DoesFileExist(const std::string& filePath);
+//Appends the paths (directory + name, '/' separated) of every file under directory, sorted so the order is stable
+void						GetFilesInDirectory(std::vector<std::string>& outFilePaths, const std::string& directory, bool recursive = true);
 
 //We need to load binary files as buffers as well which will go under here
 //NOTE: These functions will use fopen, fread, fwrite and fclose. Not streams
@@ -1,6 +1,9 @@
 //------------------------------------------------------------------------------------------------------------------------------
 #include "Engine/Core/Image.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/MemoryMappedFile.hpp"
 #include "Engine/Renderer/Rgba.hpp"
+#include <string.h>
 
 #pragma warning( disable: 4100) //Unreferenced formal parameter
 #define STB_IMAGE_IMPLEMENTATION
@@ -14,6 +17,12 @@ Image::Image( const char* imageFilePath )
 	m_imageFilePath = imageFilePath;
 	m_imageRawData = nullptr;
 
+	//A cooked copy next to the source skips the decode
+	if (LoadFromCookedFile(GetCookedImagePath(m_imageFilePath)))
+	{
+		return;
+	}
+
 	int imageTexelSizeX = 0; // Filled in for us to indicate image width
 	int imageTexelSizeY = 0; // Filled in for us to indicate image height
 	int numComponents = 0; // Filled in for us to indicate how many color components the image had (e.g. 3=RGB=24bit, 4=RGBA=32bit)
@@ -68,6 +77,57 @@ Image::Image( const char* imageFilePath )
 	}
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+bool Image::LoadFromCookedFile( const std::string& cookedPath )
+{
+	MemoryMappedFile cookedFile;
+	if (!cookedFile.Open(cookedPath))
+	{
+		return false;
+	}
+
+	const unsigned char* data = cookedFile.GetData();
+	size_t size = cookedFile.GetSize();
+	if (size < PTEX_HEADER_SIZE || data[0] != 'P' || data[1] != 'T' || data[2] != 'E' || data[3] != 'X' || data[4] != PTEX_VERSION)
+	{
+		return false;
+	}
+
+	uint width = 0;
+	uint height = 0;
+	memcpy(&width, data + 8, sizeof(uint));
+	memcpy(&height, data + 12, sizeof(uint));
+
+	size_t numBytes = static_cast<size_t>(width) * height * GetBytesPerPixel();
+	if (numBytes == 0 || size - PTEX_HEADER_SIZE < numBytes)
+	{
+		return false;
+	}
+
+	//malloc so the destructor's stbi_image_free works the same for both
+	m_imageRawData = (unsigned char*)malloc(numBytes);
+	memcpy(m_imageRawData, data + PTEX_HEADER_SIZE, numBytes);
+
+	m_dimensions.x = static_cast<int>(width);
+	m_dimensions.y = static_cast<int>(height);
+	FillTexelsFromRawData();
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void Image::FillTexelsFromRawData()
+{
+	int numTexels = m_dimensions.x * m_dimensions.y;
+	m_texelRepository.resize(numTexels);
+
+	for (int texelIndex = 0; texelIndex < numTexels; texelIndex++)
+	{
+		const unsigned char* texel = &m_imageRawData[texelIndex * 4];
+		m_texelRepository[texelIndex] = Rgba();
+		m_texelRepository[texelIndex].SetFromBytes(texel[0], texel[1], texel[2], texel[3]);
+	}
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 Image::Image( const Rgba& color, const int width /*= 1*/, const int height /*= 1*/ )
 {
@@ -226,4 +286,47 @@ void Image::operator=(const Image& copyFrom)
 	m_texelRepository = copyFrom.m_texelRepository;
 	m_imageRawData = copyFrom.m_imageRawData;
 }
-*/
\ No newline at end of file
+*/
+
+//------------------------------------------------------------------------------------------------------------------------------
+std::string GetCookedImagePath( const std::string& imagePath )
+{
+	size_t extensionStart = imagePath.find_last_of('.');
+	size_t directoryEnd = imagePath.find_last_of("/\\");
+	if (extensionStart == std::string::npos || (directoryEnd != std::string::npos && extensionStart < directoryEnd))
+	{
+		return imagePath + ".ptex";
+	}
+
+	return imagePath.substr(0, extensionStart) + ".ptex";
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Decodes straight from the source (never a stale .ptex) and writes the header and texels. Safe to call from jobs.
+//------------------------------------------------------------------------------------------------------------------------------
+bool CookImageToFile( const std::string& imagePath, const std::string& cookedPath )
+{
+	int width = 0;
+	int height = 0;
+	int numComponents = 0;
+	unsigned char* texels = stbi_load(imagePath.c_str(), &width, &height, &numComponents, 4);
+	if (texels == nullptr)
+	{
+		return false;
+	}
+
+	size_t numBytes = static_cast<size_t>(width) * height * 4;
+	std::vector<unsigned char> buffer(PTEX_HEADER_SIZE + numBytes, 0);
+	buffer[0] = 'P';
+	buffer[1] = 'T';
+	buffer[2] = 'E';
+	buffer[3] = 'X';
+	buffer[4] = PTEX_VERSION;
+
+	uint header[2] = { static_cast<uint>(width), static_cast<uint>(height) };
+	memcpy(&buffer[8], header, sizeof(header));
+	memcpy(&buffer[PTEX_HEADER_SIZE], texels, numBytes);
+	stbi_image_free(texels);
+
+	return SaveBinaryFileFromBuffer(cookedPath, buffer);
+}
@@ -6,6 +6,16 @@
 
 struct Rgba;
 
+//------------------------------------------------------------------------------------------------------------------------------
+// Cooked images (.ptex) are a 16 byte header (P T E X, version, 3 reserved bytes, width, height) followed by the RGBA8
+// texels exactly as stb_image decodes them. Loading one is a copy instead of a PNG/JPG decode.
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr unsigned char		PTEX_VERSION = 1;
+constexpr size_t			PTEX_HEADER_SIZE = 16;
+
+std::string					GetCookedImagePath(const std::string& imagePath);
+bool						CookImageToFile(const std::string& imagePath, const std::string& cookedPath);
+
 //------------------------------------------------------------------------------------------------------------------------------
 class Image
 {
@@ -37,6 +47,10 @@ public:
 
 	//void				operator=(const Image& copyFrom);				
 
+private:
+	bool				LoadFromCookedFile(const std::string& cookedPath);
+	void				FillTexelsFromRawData();
+
 private:
 	std::string			m_imageFilePath = "";
 	IntVec2				m_dimensions = IntVec2::ZERO;
@@ -46,6 +46,7 @@ void JobSystem::DestroyInstance()
 void JobSystem::Startup(int numGenericThreads /*= -1*/, int numCategories /*= JOB_CATEGORY_CORE_COUNT*/)
 {
 	m_genericJobsSemaphore.Create(0, 1);
+	m_ioJobsSemaphore.Create(0, 1);
 	m_isRunning = true;
 
 	//Create required number of JobCategories
@@ -72,6 +73,9 @@ void JobSystem::Startup(int numGenericThreads /*= -1*/, int numCategories /*= JO
 		//Make these threads run the generic work task
 		m_genericThreads.emplace_back(&GenericThreadWork);
 	}
+
+	//Not counted against the generic threads, it spends most of its time waiting on the disk
+	m_ioThread = std::thread(&IOThreadWork);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -79,12 +83,18 @@ void JobSystem::Shutdown()
 {
 	m_isRunning = false;
 	SignalWork();
+	SignalIOWork();
 
 	for (int threadIndex = 0; threadIndex < m_genericThreads.size(); threadIndex++)
 	{
 		m_genericThreads[threadIndex].join();
 	}
 
+	if (m_ioThread.joinable())
+	{
+		m_ioThread.join();
+	}
+
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -157,7 +167,15 @@ void JobSystem::ProcessFinishJobsForCategory(int category)
 void JobSystem::AddJobForCategory(Job* job, int category)
 {
 	m_categories[category].Enqueue(job);
-	SignalWork();
+
+	if (category == JOB_IO)
+	{
+		SignalIOWork();
+	}
+	else
+	{
+		SignalWork();
+	}
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -182,3 +200,17 @@ STATIC void JobSystem::GenericThreadWork()
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC void JobSystem::IOThreadWork()
+{
+	//Only I/O jobs, their finish callbacks are for whoever owns the data to process
+	JobSystem* system = JobSystem::GetInstance();
+	while (system->m_isRunning)
+	{
+		system->WaitForIOWork();
+		while (system->ProcessCategory(JOB_IO));
+
+		Sleep(0);
+	}
+}
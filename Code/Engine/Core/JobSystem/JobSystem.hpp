@@ -34,16 +34,21 @@ public:
 
 private:
 	static void			GenericThreadWork();
+	static void			IOThreadWork();
 
 	Semaphore			m_genericJobsSemaphore;
+	Semaphore			m_ioJobsSemaphore;
 
 	void				WaitForWork()	{ m_genericJobsSemaphore.Acquire(); }
 	void				SignalWork()	{ m_genericJobsSemaphore.Release(1); }
+	void				WaitForIOWork()	{ m_ioJobsSemaphore.Acquire(); }
+	void				SignalIOWork()	{ m_ioJobsSemaphore.Release(1); }
 
 	JobCategory*				m_categories;
 	int							m_numCategories = JOB_CATEGORY_CORE_COUNT;
 
 	std::vector<std::thread>	m_genericThreads;
+	std::thread					m_ioThread;
 
 	bool m_isRunning;
 };
\ No newline at end of file
@@ -6,6 +6,7 @@ enum eJobCategory : int
 	JOB_GENERIC = 0,
 	JOB_MAIN,
 	JOB_RENDER,
+	JOB_IO,				// file reads and decodes, run by the JobSystem's I/O thread so disk waits don't stall generic work
 
 	JOB_CATEGORY_CORE_COUNT,
 };
\ No newline at end of file
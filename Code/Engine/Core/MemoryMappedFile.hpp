@@ -0,0 +1,33 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+#include <string>
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Read only view of a whole file mapped into memory. The OS pages the file in as it is touched, so nothing is copied
+// until the data is actually used, and the view is page aligned. Pointers into it are valid until Close.
+//------------------------------------------------------------------------------------------------------------------------------
+class MemoryMappedFile
+{
+public:
+	MemoryMappedFile();
+	~MemoryMappedFile();
+
+	bool						Open(const std::string& filePath);		// false if the file is missing, empty or can't be mapped
+	void						Close();
+
+	inline bool					IsOpen() const			{ return m_data != nullptr; }
+	inline const unsigned char*	GetData() const			{ return m_data; }
+	inline size_t				GetSize() const			{ return m_size; }
+
+private:
+	//No copies, the view belongs to one owner
+	MemoryMappedFile(const MemoryMappedFile& copyFrom) = delete;
+	MemoryMappedFile&			operator=(const MemoryMappedFile& copyFrom) = delete;
+
+private:
+	const unsigned char*		m_data = nullptr;
+	size_t						m_size = 0;
+
+	void*						m_fileHandle = nullptr;
+	void*						m_mappingHandle = nullptr;
+};
@@ -308,6 +308,20 @@ void AddVertsForSolidConvexPoly2D(std::vector<Vertex_PCU>& vertexArray, const Co
 	}
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+// Outline of a convex polygon, one line per edge
+//------------------------------------------------------------------------------------------------------------------------------
+void AddVertsForConvexPoly2D(std::vector<Vertex_PCU>& vertexArray, const ConvexPoly2D& polygon, const Rgba& color, float thickness)
+{
+	const std::vector<Vec2>& points = polygon.GetConvexPoly2DPoints();
+	int numPoints = static_cast<int>(points.size());
+
+	for (int pointIndex = 0; pointIndex < numPoints; pointIndex++)
+	{
+		AddVertsForLine2D(vertexArray, points[pointIndex], points[(pointIndex + 1) % numPoints], thickness, color);
+	}
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 // Move a vertex
 //------------------------------------------------------------------------------------------------------------------------------
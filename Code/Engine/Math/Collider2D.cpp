@@ -8,6 +8,15 @@
 #include "Engine/Math/Rigidbody2D.hpp"
 #include "Engine/Math/Trigger2D.hpp"
 
+//------------------------------------------------------------------------------------------------------------------------------
+uint Collider2D::s_nextColliderId = 0U;
+
+//------------------------------------------------------------------------------------------------------------------------------
+Collider2D::Collider2D()
+{
+	m_colliderId = s_nextColliderId++;
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 bool Collider2D::IsTouching(Collision2D* collision, Collider2D* otherCollider )
 {
@@ -47,6 +56,13 @@ void Collider2D::SetCollisionEvent(const std::string& eventString)
 	m_onCollisionEvent = eventString;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+void Collider2D::SetContactCallback( ContactCallback2D callback, void* userData )
+{
+	m_onContact = callback;
+	m_contactUserData = userData;
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 void Collider2D::SetColliderType(eColliderType2D type)
 {
@@ -273,4 +289,112 @@ const Capsule2D& CapsuleCollider2D::GetReferenceShape() const
 float CapsuleCollider2D::GetCapsuleRadius() const
 {
 	return m_radius;
-}
\ No newline at end of file
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+PolygonCollider2D::PolygonCollider2D( const std::vector<Vec2>& localPoints, float rotationDegrees /*= 0.0f */ )
+{
+	m_localPoints = ConvexPoly2D::MakeConvexHullFromPoints(localPoints);
+	m_rotationDegrees = rotationDegrees;
+	SetColliderType(COLLIDER_POLYGON);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+PolygonCollider2D::~PolygonCollider2D()
+{
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PolygonCollider2D::SetMomentForObject()
+{
+	//Sum the triangles fanned out from the rigidbody position, I = m/6 * sum(cross * (pi.pi + pi.pj + pj.pj)) / sum(cross)
+	float numerator = 0.f;
+	float denominator = 0.f;
+
+	int numPoints = static_cast<int>(m_localPoints.size());
+	for (int pointIndex = 0; pointIndex < numPoints; pointIndex++)
+	{
+		const Vec2& current = m_localPoints[pointIndex];
+		const Vec2& next = m_localPoints[(pointIndex + 1) % numPoints];
+
+		float cross = current.x * next.y - current.y * next.x;
+		numerator += cross * (GetDotProduct(current, current) + GetDotProduct(current, next) + GetDotProduct(next, next));
+		denominator += cross;
+	}
+
+	if (denominator <= 0.f)
+	{
+		//Degenerate polygon, treat it as a point mass
+		m_rigidbody->m_momentOfInertia = 0.f;
+		return;
+	}
+
+	m_rigidbody->m_momentOfInertia = m_rigidbody->m_mass * numerator / (6.f * denominator);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool PolygonCollider2D::Contains( Vec2 worldPoint )
+{
+	std::vector<Vec2> worldPoints;
+	GetWorldPoints(&worldPoints);
+
+	//Points are CCW so the point has to be left of every edge
+	int numPoints = static_cast<int>(worldPoints.size());
+	for (int pointIndex = 0; pointIndex < numPoints; pointIndex++)
+	{
+		Vec2 edge = worldPoints[(pointIndex + 1) % numPoints] - worldPoints[pointIndex];
+		Vec2 toPoint = worldPoint - worldPoints[pointIndex];
+		if (edge.x * toPoint.y - edge.y * toPoint.x < 0.f)
+		{
+			return false;
+		}
+	}
+
+	return numPoints > 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+ConvexPoly2D PolygonCollider2D::GetLocalShape() const
+{
+	return ConvexPoly2D(m_localPoints);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+ConvexPoly2D PolygonCollider2D::GetWorldShape() const
+{
+	std::vector<Vec2> worldPoints;
+	GetWorldPoints(&worldPoints);
+	return ConvexPoly2D(worldPoints);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PolygonCollider2D::GetWorldPoints( std::vector<Vec2>* outPoints ) const
+{
+	Vec2 position = Vec2::ZERO;
+	if (m_rigidbody != nullptr)
+	{
+		position = m_rigidbody->GetPosition();
+	}
+	else if (m_trigger != nullptr)
+	{
+		position = m_trigger->GetPosition();
+	}
+
+	float cosDeg = CosDegrees(m_rotationDegrees);
+	float sinDeg = SinDegrees(m_rotationDegrees);
+
+	int numPoints = static_cast<int>(m_localPoints.size());
+	outPoints->resize(numPoints);
+	for (int pointIndex = 0; pointIndex < numPoints; pointIndex++)
+	{
+		const Vec2& localPoint = m_localPoints[pointIndex];
+		(*outPoints)[pointIndex] = Vec2(localPoint.x * cosDeg - localPoint.y * sinDeg + position.x, localPoint.x * sinDeg + localPoint.y * cosDeg + position.y);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PolygonCollider2D::SetRotation( float rotationDegrees )
+{
+	m_rotationDegrees = rotationDegrees;
+}
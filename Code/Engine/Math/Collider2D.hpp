@@ -3,6 +3,8 @@
 //Engine Systems
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/Capsule2D.hpp"
+#include "Engine/Math/ContactReport2D.hpp"
+#include "Engine/Math/ConvexPoly2D.hpp"
 #include "Engine/Math/Disc2D.hpp"
 #include "Engine/Math/OBB2.hpp"
 
@@ -21,6 +23,8 @@ enum eColliderType2D
 	COLLIDER_CAPSULE, 
 	COLLIDER_BOX,
 
+	COLLIDER_POLYGON,
+
 	NUM_COLLIDER_TYPES
 };
 
@@ -28,12 +32,14 @@ enum eColliderType2D
 class Collider2D
 {
 public:
+	Collider2D();
 
 	virtual void				SetMomentForObject() = 0;
 	virtual bool				Contains(Vec2 worldPoint) = 0;
 
 	void						SetCollision(bool inCollision);
 	void						SetCollisionEvent(const std::string& eventString);
+	void						SetContactCallback(ContactCallback2D callback, void* userData = nullptr);
 	void						SetColliderType(eColliderType2D type);
 	void						Destroy();
 
@@ -50,7 +56,20 @@ public:
 	bool						m_inCollision = false;
 	bool						m_isAlive = true;
 
-	std::string					m_onCollisionEvent = "";
+	std::string					m_onCollisionEvent = "";				// optional string event, fired every step we collide
+
+	ContactCallback2D			m_onContact = nullptr;				// typed begin/persist/end callback
+	void*						m_contactUserData = nullptr;
+
+	//Slot in the CollisionBatch2D world shape cache, only valid while m_shapeCacheStamp matches the batch
+	int							m_shapeCacheIndex = -1;
+	uint						m_shapeCacheStamp = 0U;
+
+	//Creation order. Unlike the address it is the same every run with the same inputs, so it is what orders contacts
+	uint						m_colliderId = 0U;
+
+private:
+	static uint					s_nextColliderId;
 };
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -127,4 +146,27 @@ public:
 
 	OBB2						m_localShape;
 	float						m_radius;
-};
\ No newline at end of file
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Any convex polygon, collides with every other collider type through GJK/EPA (see GJK2D)
+//------------------------------------------------------------------------------------------------------------------------------
+class PolygonCollider2D: public Collider2D
+{
+public:
+	explicit PolygonCollider2D( const std::vector<Vec2>& localPoints, float rotationDegrees = 0.0f );
+	~PolygonCollider2D();
+
+	virtual void				SetMomentForObject();
+	virtual bool				Contains(Vec2 worldPoint);
+
+	ConvexPoly2D				GetLocalShape() const;
+	ConvexPoly2D				GetWorldShape() const;
+	void						GetWorldPoints(std::vector<Vec2>* outPoints) const;
+
+	void						SetRotation(float rotationDegrees);
+
+public:
+	std::vector<Vec2>			m_localPoints;				//Convex hull of the points it was made with, CCW and relative to the rigidbody
+	float						m_rotationDegrees = 0.f;
+};
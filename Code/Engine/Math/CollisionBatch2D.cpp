@@ -0,0 +1,595 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Math/CollisionBatch2D.hpp"
+#include "Engine/Math/CollisionHandler.hpp"
+#include "Engine/Math/Disc2D.hpp"
+
+//AABB2 and disc pairs run 4 at a time, one per lane
+#if !defined(ENGINE_DISABLE_SIMD) && (defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__))
+#define COLLISION_BATCH_USE_SSE
+#include <xmmintrin.h>
+#endif
+
+//------------------------------------------------------------------------------------------------------------------------------
+void WorldShapeCache2D::Clear()
+{
+	m_aabbMinX.clear();
+	m_aabbMinY.clear();
+	m_aabbMaxX.clear();
+	m_aabbMaxY.clear();
+
+	m_discCenterX.clear();
+	m_discCenterY.clear();
+	m_discRadius.clear();
+
+	m_boxes.clear();
+
+	m_capsuleBoxes.clear();
+	m_capsuleRadius.clear();
+
+	m_polygonPoints.clear();
+	m_polygonFirstPoint.clear();
+	m_polygonNumPoints.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+CollisionBatch2D::CollisionBatch2D()
+{
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+CollisionBatch2D::~CollisionBatch2D()
+{
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CollisionBatch2D::BeginBatch()
+{
+	//Bumping the stamp invalidates the cache index on every collider without touching them
+	m_stamp++;
+
+	m_shapes.Clear();
+	m_entryShapeIndex.clear();
+	m_entryMoved.clear();
+
+	m_pairs.clear();
+	m_manifolds.clear();
+	m_hits.clear();
+
+	for (int typeA = 0; typeA < NUM_COLLIDER_TYPES; typeA++)
+	{
+		for (int typeB = 0; typeB < NUM_COLLIDER_TYPES; typeB++)
+		{
+			m_pairsByType[typeA][typeB].clear();
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+uint CollisionBatch2D::AddPair( Collider2D* colliderA, Collider2D* colliderB )
+{
+	uint pairIndex = static_cast<uint>(m_pairs.size());
+
+	CollisionPair2D pair;
+	pair.m_colliderA = colliderA;
+	pair.m_colliderB = colliderB;
+	pair.m_entryA = CacheWorldShape(colliderA);
+	pair.m_entryB = CacheWorldShape(colliderB);
+
+	m_pairs.push_back(pair);
+	m_manifolds.push_back(Manifold2D());
+	m_hits.push_back(0);
+
+	if (pair.m_entryA < 0 || pair.m_entryB < 0)
+	{
+		return pairIndex;
+	}
+
+	//Only bucket the pairs the lookup table knows how to test, everything else is a miss
+	eColliderType2D typeA = colliderA->GetType();
+	eColliderType2D typeB = colliderB->GetType();
+	if (COLLISION_LOOKUP_TABLE[typeA][typeB] != nullptr)
+	{
+		m_pairsByType[typeA][typeB].push_back(pairIndex);
+	}
+
+	return pairIndex;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CollisionBatch2D::RunBatch()
+{
+	RunAABB2VsAABB2Batch(m_pairsByType[COLLIDER_AABB2][COLLIDER_AABB2]);
+	RunAABB2VsDiscBatch(m_pairsByType[COLLIDER_AABB2][COLLIDER_DISC]);
+	RunDiscVsAABB2Batch(m_pairsByType[COLLIDER_DISC][COLLIDER_AABB2]);
+	RunDiscVsDiscBatch(m_pairsByType[COLLIDER_DISC][COLLIDER_DISC]);
+
+	RunCapsuleVsCapsuleBatch(m_pairsByType[COLLIDER_CAPSULE][COLLIDER_CAPSULE]);
+	RunCapsuleVsBoxBatch(m_pairsByType[COLLIDER_CAPSULE][COLLIDER_BOX]);
+	RunBoxVsCapsuleBatch(m_pairsByType[COLLIDER_BOX][COLLIDER_CAPSULE]);
+	RunBoxVsBoxBatch(m_pairsByType[COLLIDER_BOX][COLLIDER_BOX]);
+
+	//Every pair without a specialized kernel goes through GJK
+	for (int typeA = 0; typeA < NUM_COLLIDER_TYPES; typeA++)
+	{
+		for (int typeB = 0; typeB < NUM_COLLIDER_TYPES; typeB++)
+		{
+			if (COLLISION_LOOKUP_TABLE[typeA][typeB] == CheckConvexByConvex)
+			{
+				RunConvexByConvexBatch(m_pairsByType[typeA][typeB]);
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool CollisionBatch2D::GetCollision( Collision2D* out, uint pairIndex )
+{
+	const CollisionPair2D& pair = m_pairs[pairIndex];
+
+	if (pair.m_entryA < 0 || pair.m_entryB < 0)
+	{
+		out->m_Obj = nullptr;
+		out->m_otherObj = nullptr;
+		return false;
+	}
+
+	//Cached shape is out of date, test against where the colliders are now
+	if (m_entryMoved[pair.m_entryA] || m_entryMoved[pair.m_entryB])
+	{
+		return GetCollisionInfo(out, pair.m_colliderA, pair.m_colliderB);
+	}
+
+	if (m_hits[pairIndex] == 0)
+	{
+		out->m_Obj = nullptr;
+		out->m_otherObj = nullptr;
+		return false;
+	}
+
+	out->m_Obj = pair.m_colliderA;
+	out->m_otherObj = pair.m_colliderB;
+	out->m_manifold = m_manifolds[pairIndex];
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CollisionBatch2D::MarkColliderMoved( Collider2D* collider )
+{
+	if (collider->m_shapeCacheStamp == m_stamp && collider->m_shapeCacheIndex >= 0)
+	{
+		m_entryMoved[collider->m_shapeCacheIndex] = 1;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int CollisionBatch2D::CacheWorldShape( Collider2D* collider )
+{
+	if (collider->m_shapeCacheStamp == m_stamp)
+	{
+		return collider->m_shapeCacheIndex;
+	}
+
+	int shapeIndex = -1;
+
+	switch (collider->GetType())
+	{
+	case COLLIDER_AABB2:
+	{
+		AABB2 box = reinterpret_cast<AABB2Collider*>(collider)->GetWorldShape();
+
+		shapeIndex = static_cast<int>(m_shapes.m_aabbMinX.size());
+		m_shapes.m_aabbMinX.push_back(box.m_minBounds.x);
+		m_shapes.m_aabbMinY.push_back(box.m_minBounds.y);
+		m_shapes.m_aabbMaxX.push_back(box.m_maxBounds.x);
+		m_shapes.m_aabbMaxY.push_back(box.m_maxBounds.y);
+	}
+	break;
+	case COLLIDER_DISC:
+	{
+		Disc2D disc = reinterpret_cast<Disc2DCollider*>(collider)->GetWorldShape();
+
+		shapeIndex = static_cast<int>(m_shapes.m_discCenterX.size());
+		m_shapes.m_discCenterX.push_back(disc.GetCentre().x);
+		m_shapes.m_discCenterY.push_back(disc.GetCentre().y);
+		m_shapes.m_discRadius.push_back(disc.GetRadius());
+	}
+	break;
+	case COLLIDER_BOX:
+	{
+		shapeIndex = static_cast<int>(m_shapes.m_boxes.size());
+		m_shapes.m_boxes.push_back(reinterpret_cast<BoxCollider2D*>(collider)->GetWorldShape());
+	}
+	break;
+	case COLLIDER_CAPSULE:
+	{
+		CapsuleCollider2D* capsule = reinterpret_cast<CapsuleCollider2D*>(collider);
+
+		shapeIndex = static_cast<int>(m_shapes.m_capsuleBoxes.size());
+		m_shapes.m_capsuleBoxes.push_back(capsule->GetWorldShape());
+		m_shapes.m_capsuleRadius.push_back(capsule->GetCapsuleRadius());
+	}
+	break;
+	case COLLIDER_POLYGON:
+	{
+		//Append the world points straight to the packed array
+		std::vector<Vec2> worldPoints;
+		reinterpret_cast<PolygonCollider2D*>(collider)->GetWorldPoints(&worldPoints);
+
+		shapeIndex = static_cast<int>(m_shapes.m_polygonFirstPoint.size());
+		m_shapes.m_polygonFirstPoint.push_back(static_cast<int>(m_shapes.m_polygonPoints.size()));
+		m_shapes.m_polygonNumPoints.push_back(static_cast<int>(worldPoints.size()));
+		m_shapes.m_polygonPoints.insert(m_shapes.m_polygonPoints.end(), worldPoints.begin(), worldPoints.end());
+	}
+	break;
+	default:
+		break;
+	}
+
+	int entryIndex = -1;
+	if (shapeIndex >= 0)
+	{
+		entryIndex = static_cast<int>(m_entryShapeIndex.size());
+		m_entryShapeIndex.push_back(shapeIndex);
+		m_entryMoved.push_back(0);
+	}
+
+	collider->m_shapeCacheStamp = m_stamp;
+	collider->m_shapeCacheIndex = entryIndex;
+	return entryIndex;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CollisionBatch2D::SetResult( uint pairIndex, const Manifold2D& manifold )
+{
+	m_hits[pairIndex] = 1;
+	m_manifolds[pairIndex] = manifold;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Same result as GetManifold(AABB2, AABB2), 4 pairs at a time
+//------------------------------------------------------------------------------------------------------------------------------
+void CollisionBatch2D::RunAABB2VsAABB2Batch( const std::vector<uint>& pairIndices )
+{
+	uint numPairs = static_cast<uint>(pairIndices.size());
+
+#if defined(COLLISION_BATCH_USE_SSE)
+	alignas(16) float aMinX[4], aMinY[4], aMaxX[4], aMaxY[4];
+	alignas(16) float bMinX[4], bMinY[4], bMaxX[4], bMaxY[4];
+	alignas(16) float normalX[4], normalY[4], penetration[4];
+
+	const __m128 one = _mm_set1_ps(1.f);
+	const __m128 minusOne = _mm_set1_ps(-1.f);
+
+	for (uint first = 0; first < numPairs; first += 4)
+	{
+		//Gather the lanes, unused lanes are empty boxes at the origin which never overlap
+		for (uint lane = 0; lane < 4; lane++)
+		{
+			if (first + lane < numPairs)
+			{
+				const CollisionPair2D& pair = m_pairs[pairIndices[first + lane]];
+				int a = m_entryShapeIndex[pair.m_entryA];
+				int b = m_entryShapeIndex[pair.m_entryB];
+
+				aMinX[lane] = m_shapes.m_aabbMinX[a];	aMinY[lane] = m_shapes.m_aabbMinY[a];
+				aMaxX[lane] = m_shapes.m_aabbMaxX[a];	aMaxY[lane] = m_shapes.m_aabbMaxY[a];
+				bMinX[lane] = m_shapes.m_aabbMinX[b];	bMinY[lane] = m_shapes.m_aabbMinY[b];
+				bMaxX[lane] = m_shapes.m_aabbMaxX[b];	bMaxY[lane] = m_shapes.m_aabbMaxY[b];
+			}
+			else
+			{
+				aMinX[lane] = aMinY[lane] = aMaxX[lane] = aMaxY[lane] = 0.f;
+				bMinX[lane] = bMinY[lane] = bMaxX[lane] = bMaxY[lane] = 0.f;
+			}
+		}
+
+		__m128 aMinXs = _mm_load_ps(aMinX);		__m128 aMinYs = _mm_load_ps(aMinY);
+		__m128 aMaxXs = _mm_load_ps(aMaxX);		__m128 aMaxYs = _mm_load_ps(aMaxY);
+		__m128 bMinXs = _mm_load_ps(bMinX);		__m128 bMinYs = _mm_load_ps(bMinY);
+		__m128 bMaxXs = _mm_load_ps(bMaxX);		__m128 bMaxYs = _mm_load_ps(bMaxY);
+
+		//Overlap box (max of mins, min of maxs)
+		__m128 overlapMinX = _mm_max_ps(aMinXs, bMinXs);
+		__m128 overlapMinY = _mm_max_ps(aMinYs, bMinYs);
+		__m128 overlapMaxX = _mm_min_ps(aMaxXs, bMaxXs);
+		__m128 overlapMaxY = _mm_min_ps(aMaxYs, bMaxYs);
+
+		__m128 hit = _mm_and_ps(_mm_cmplt_ps(overlapMinX, overlapMaxX), _mm_cmplt_ps(overlapMinY, overlapMaxY));
+		int hitMask = _mm_movemask_ps(hit);
+		if (hitMask == 0)
+		{
+			continue;
+		}
+
+		__m128 width = _mm_sub_ps(overlapMaxX, overlapMinX);
+		__m128 height = _mm_sub_ps(overlapMaxY, overlapMinY);
+		__m128 pushOnX = _mm_cmple_ps(width, height);
+
+		//Push A away from B's center on the chosen axis (comparing center * 2 keeps the ordering)
+		__m128 flipX = _mm_cmplt_ps(_mm_add_ps(aMinXs, aMaxXs), _mm_add_ps(bMinXs, bMaxXs));
+		__m128 flipY = _mm_cmplt_ps(_mm_add_ps(aMinYs, aMaxYs), _mm_add_ps(bMinYs, bMaxYs));
+		__m128 signX = _mm_or_ps(_mm_and_ps(flipX, minusOne), _mm_andnot_ps(flipX, one));
+		__m128 signY = _mm_or_ps(_mm_and_ps(flipY, minusOne), _mm_andnot_ps(flipY, one));
+
+		_mm_store_ps(normalX, _mm_and_ps(pushOnX, signX));
+		_mm_store_ps(normalY, _mm_andnot_ps(pushOnX, signY));
+		_mm_store_ps(penetration, _mm_min_ps(width, height));
+
+		for (uint lane = 0; lane < 4; lane++)
+		{
+			if (hitMask & (1 << lane))
+			{
+				Manifold2D manifold;
+				manifold.m_normal = Vec2(normalX[lane], normalY[lane]);
+				manifold.m_penetration = penetration[lane];
+				SetResult(pairIndices[first + lane], manifold);
+			}
+		}
+	}
+#else
+	for (uint index = 0; index < numPairs; index++)
+	{
+		const CollisionPair2D& pair = m_pairs[pairIndices[index]];
+		int a = m_entryShapeIndex[pair.m_entryA];
+		int b = m_entryShapeIndex[pair.m_entryB];
+
+		AABB2 boxA(Vec2(m_shapes.m_aabbMinX[a], m_shapes.m_aabbMinY[a]), Vec2(m_shapes.m_aabbMaxX[a], m_shapes.m_aabbMaxY[a]));
+		AABB2 boxB(Vec2(m_shapes.m_aabbMinX[b], m_shapes.m_aabbMinY[b]), Vec2(m_shapes.m_aabbMaxX[b], m_shapes.m_aabbMaxY[b]));
+
+		Manifold2D manifold;
+		if (GetManifold(&manifold, boxA, boxB))
+		{
+			SetResult(pairIndices[index], manifold);
+		}
+	}
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Same result as GetManifold(Disc2D, Disc2D), 4 pairs at a time
+//------------------------------------------------------------------------------------------------------------------------------
+void CollisionBatch2D::RunDiscVsDiscBatch( const std::vector<uint>& pairIndices )
+{
+	uint numPairs = static_cast<uint>(pairIndices.size());
+
+#if defined(COLLISION_BATCH_USE_SSE)
+	alignas(16) float aX[4], aY[4], aRadius[4];
+	alignas(16) float bX[4], bY[4], bRadius[4];
+	alignas(16) float normalX[4], normalY[4], penetration[4];
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.f);
+
+	for (uint first = 0; first < numPairs; first += 4)
+	{
+		//Gather the lanes, unused lanes are zero radius discs which never overlap
+		for (uint lane = 0; lane < 4; lane++)
+		{
+			if (first + lane < numPairs)
+			{
+				const CollisionPair2D& pair = m_pairs[pairIndices[first + lane]];
+				int a = m_entryShapeIndex[pair.m_entryA];
+				int b = m_entryShapeIndex[pair.m_entryB];
+
+				aX[lane] = m_shapes.m_discCenterX[a];	aY[lane] = m_shapes.m_discCenterY[a];	aRadius[lane] = m_shapes.m_discRadius[a];
+				bX[lane] = m_shapes.m_discCenterX[b];	bY[lane] = m_shapes.m_discCenterY[b];	bRadius[lane] = m_shapes.m_discRadius[b];
+			}
+			else
+			{
+				aX[lane] = aY[lane] = aRadius[lane] = 0.f;
+				bX[lane] = bY[lane] = bRadius[lane] = 0.f;
+			}
+		}
+
+		__m128 dispX = _mm_sub_ps(_mm_load_ps(aX), _mm_load_ps(bX));
+		__m128 dispY = _mm_sub_ps(_mm_load_ps(aY), _mm_load_ps(bY));
+		__m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dispX, dispX), _mm_mul_ps(dispY, dispY));
+		__m128 radiusSum = _mm_add_ps(_mm_load_ps(aRadius), _mm_load_ps(bRadius));
+
+		__m128 hit = _mm_cmplt_ps(distanceSquared, _mm_mul_ps(radiusSum, radiusSum));
+		int hitMask = _mm_movemask_ps(hit);
+		if (hitMask == 0)
+		{
+			continue;
+		}
+
+		//Coincident centers keep a zero normal, same as Vec2::Normalize
+		__m128 distance = _mm_sqrt_ps(distanceSquared);
+		__m128 hasLength = _mm_cmpgt_ps(distance, zero);
+		__m128 inverseDistance = _mm_and_ps(_mm_div_ps(one, distance), hasLength);
+
+		_mm_store_ps(normalX, _mm_mul_ps(dispX, inverseDistance));
+		_mm_store_ps(normalY, _mm_mul_ps(dispY, inverseDistance));
+		_mm_store_ps(penetration, _mm_sub_ps(radiusSum, distance));
+
+		for (uint lane = 0; lane < 4; lane++)
+		{
+			if (hitMask & (1 << lane))
+			{
+				Manifold2D manifold;
+				manifold.m_normal = Vec2(normalX[lane], normalY[lane]);
+				manifold.m_penetration = penetration[lane];
+				SetResult(pairIndices[first + lane], manifold);
+			}
+		}
+	}
+#else
+	for (uint index = 0; index < numPairs; index++)
+	{
+		const CollisionPair2D& pair = m_pairs[pairIndices[index]];
+		int a = m_entryShapeIndex[pair.m_entryA];
+		int b = m_entryShapeIndex[pair.m_entryB];
+
+		Disc2D discA(Vec2(m_shapes.m_discCenterX[a], m_shapes.m_discCenterY[a]), m_shapes.m_discRadius[a]);
+		Disc2D discB(Vec2(m_shapes.m_discCenterX[b], m_shapes.m_discCenterY[b]), m_shapes.m_discRadius[b]);
+
+		Manifold2D manifold;
+		if (GetManifold(&manifold, discA, discB))
+		{
+			SetResult(pairIndices[index], manifold);
+		}
+	}
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CollisionBatch2D::RunAABB2VsDiscBatch( const std::vector<uint>& pairIndices )
+{
+	uint numPairs = static_cast<uint>(pairIndices.size());
+	for (uint index = 0; index < numPairs; index++)
+	{
+		const CollisionPair2D& pair = m_pairs[pairIndices[index]];
+		int a = m_entryShapeIndex[pair.m_entryA];
+		int b = m_entryShapeIndex[pair.m_entryB];
+
+		AABB2 box(Vec2(m_shapes.m_aabbMinX[a], m_shapes.m_aabbMinY[a]), Vec2(m_shapes.m_aabbMaxX[a], m_shapes.m_aabbMaxY[a]));
+		Disc2D disc(Vec2(m_shapes.m_discCenterX[b], m_shapes.m_discCenterY[b]), m_shapes.m_discRadius[b]);
+
+		Manifold2D manifold;
+		if (GetManifold(&manifold, box, disc))
+		{
+			SetResult(pairIndices[index], manifold);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CollisionBatch2D::RunDiscVsAABB2Batch( const std::vector<uint>& pairIndices )
+{
+	uint numPairs = static_cast<uint>(pairIndices.size());
+	for (uint index = 0; index < numPairs; index++)
+	{
+		const CollisionPair2D& pair = m_pairs[pairIndices[index]];
+		int a = m_entryShapeIndex[pair.m_entryA];
+		int b = m_entryShapeIndex[pair.m_entryB];
+
+		Disc2D disc(Vec2(m_shapes.m_discCenterX[a], m_shapes.m_discCenterY[a]), m_shapes.m_discRadius[a]);
+		AABB2 box(Vec2(m_shapes.m_aabbMinX[b], m_shapes.m_aabbMinY[b]), Vec2(m_shapes.m_aabbMaxX[b], m_shapes.m_aabbMaxY[b]));
+
+		Manifold2D manifold;
+		if (GetManifold(&manifold, disc, box))
+		{
+			SetResult(pairIndices[index], manifold);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CollisionBatch2D::RunBoxVsBoxBatch( const std::vector<uint>& pairIndices )
+{
+	uint numPairs = static_cast<uint>(pairIndices.size());
+	for (uint index = 0; index < numPairs; index++)
+	{
+		const CollisionPair2D& pair = m_pairs[pairIndices[index]];
+		int a = m_entryShapeIndex[pair.m_entryA];
+		int b = m_entryShapeIndex[pair.m_entryB];
+
+		Manifold2D manifold;
+		if (GetManifoldWithContact(&manifold, m_shapes.m_boxes[a], m_shapes.m_boxes[b]))
+		{
+			SetResult(pairIndices[index], manifold);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CollisionBatch2D::RunCapsuleVsCapsuleBatch( const std::vector<uint>& pairIndices )
+{
+	uint numPairs = static_cast<uint>(pairIndices.size());
+	for (uint index = 0; index < numPairs; index++)
+	{
+		const CollisionPair2D& pair = m_pairs[pairIndices[index]];
+		int a = m_entryShapeIndex[pair.m_entryA];
+		int b = m_entryShapeIndex[pair.m_entryB];
+
+		Manifold2D manifold;
+		if (GetManifold(&manifold, m_shapes.m_capsuleBoxes[a], m_shapes.m_capsuleRadius[a], m_shapes.m_capsuleBoxes[b], m_shapes.m_capsuleRadius[b]))
+		{
+			SetResult(pairIndices[index], manifold);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CollisionBatch2D::RunCapsuleVsBoxBatch( const std::vector<uint>& pairIndices )
+{
+	uint numPairs = static_cast<uint>(pairIndices.size());
+	for (uint index = 0; index < numPairs; index++)
+	{
+		const CollisionPair2D& pair = m_pairs[pairIndices[index]];
+		int a = m_entryShapeIndex[pair.m_entryA];
+		int b = m_entryShapeIndex[pair.m_entryB];
+
+		Manifold2D manifold;
+		if (GetManifold(&manifold, m_shapes.m_capsuleBoxes[a], m_shapes.m_capsuleRadius[a], m_shapes.m_boxes[b], 0.f))
+		{
+			SetResult(pairIndices[index], manifold);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CollisionBatch2D::RunBoxVsCapsuleBatch( const std::vector<uint>& pairIndices )
+{
+	uint numPairs = static_cast<uint>(pairIndices.size());
+	for (uint index = 0; index < numPairs; index++)
+	{
+		const CollisionPair2D& pair = m_pairs[pairIndices[index]];
+		int a = m_entryShapeIndex[pair.m_entryA];
+		int b = m_entryShapeIndex[pair.m_entryB];
+
+		Manifold2D manifold;
+		if (GetManifold(&manifold, m_shapes.m_boxes[a], 0.f, m_shapes.m_capsuleBoxes[b], m_shapes.m_capsuleRadius[b]))
+		{
+			SetResult(pairIndices[index], manifold);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Support shape over the cached world shape. Polygons point into m_polygonPoints so the cache must not grow while it is used
+//------------------------------------------------------------------------------------------------------------------------------
+ConvexSupport2D CollisionBatch2D::GetCachedSupport( const Collider2D* collider, int entryIndex ) const
+{
+	int shapeIndex = m_entryShapeIndex[entryIndex];
+
+	switch (collider->m_colliderType)
+	{
+	case COLLIDER_AABB2:
+		return ConvexSupport2D(AABB2(Vec2(m_shapes.m_aabbMinX[shapeIndex], m_shapes.m_aabbMinY[shapeIndex]), Vec2(m_shapes.m_aabbMaxX[shapeIndex], m_shapes.m_aabbMaxY[shapeIndex])));
+	case COLLIDER_DISC:
+		return ConvexSupport2D(Disc2D(Vec2(m_shapes.m_discCenterX[shapeIndex], m_shapes.m_discCenterY[shapeIndex]), m_shapes.m_discRadius[shapeIndex]));
+	case COLLIDER_BOX:
+		return ConvexSupport2D(m_shapes.m_boxes[shapeIndex]);
+	case COLLIDER_CAPSULE:
+		return ConvexSupport2D(m_shapes.m_capsuleBoxes[shapeIndex], m_shapes.m_capsuleRadius[shapeIndex]);
+	case COLLIDER_POLYGON:
+		return ConvexSupport2D(m_shapes.m_polygonPoints.data() + m_shapes.m_polygonFirstPoint[shapeIndex], m_shapes.m_polygonNumPoints[shapeIndex]);
+	default:
+		ERROR_AND_DIE("Collider type has no cached support shape");
+		break;
+	}
+
+	return ConvexSupport2D();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CollisionBatch2D::RunConvexByConvexBatch( const std::vector<uint>& pairIndices )
+{
+	uint numPairs = static_cast<uint>(pairIndices.size());
+	for (uint index = 0; index < numPairs; index++)
+	{
+		const CollisionPair2D& pair = m_pairs[pairIndices[index]];
+
+		ConvexSupport2D shapeA = GetCachedSupport(pair.m_colliderA, pair.m_entryA);
+		ConvexSupport2D shapeB = GetCachedSupport(pair.m_colliderB, pair.m_entryB);
+
+		Manifold2D manifold;
+		if (GetManifoldGJK(&manifold, shapeA, shapeB))
+		{
+			SetResult(pairIndices[index], manifold);
+		}
+	}
+}
@@ -0,0 +1,106 @@
+#pragma once
+//------------------------------------------------------------------------------------------------------------------------------
+//Engine Systems
+#include "Engine/Commons/EngineCommon.hpp"
+#include "Engine/Math/Collider2D.hpp"
+#include "Engine/Math/GJK2D.hpp"
+#include "Engine/Math/Manifold.hpp"
+#include <vector>
+
+struct Collision2D;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// World space shapes for every collider used in a batch, computed once per batch and stored per shape type (SoA)
+//------------------------------------------------------------------------------------------------------------------------------
+struct WorldShapeCache2D
+{
+	void						Clear();
+
+	//AABB2 colliders
+	std::vector<float>			m_aabbMinX;
+	std::vector<float>			m_aabbMinY;
+	std::vector<float>			m_aabbMaxX;
+	std::vector<float>			m_aabbMaxY;
+
+	//Disc colliders
+	std::vector<float>			m_discCenterX;
+	std::vector<float>			m_discCenterY;
+	std::vector<float>			m_discRadius;
+
+	//Box colliders
+	std::vector<OBB2>			m_boxes;
+
+	//Capsule colliders
+	std::vector<OBB2>			m_capsuleBoxes;
+	std::vector<float>			m_capsuleRadius;
+
+	//Polygon colliders, the points of every polygon packed into one array
+	std::vector<Vec2>			m_polygonPoints;
+	std::vector<int>			m_polygonFirstPoint;
+	std::vector<int>			m_polygonNumPoints;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct CollisionPair2D
+{
+	Collider2D*					m_colliderA = nullptr;
+	Collider2D*					m_colliderB = nullptr;
+	int							m_entryA = -1;
+	int							m_entryB = -1;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Batched narrow phase. Pairs are added in the order the caller wants to resolve them, bucketed by (typeA, typeB)
+// and tested with one tight kernel per shape pair. Results are read back per pair index.
+//
+// If a collider is moved after RunBatch (say when resolving an earlier pair), call MarkColliderMoved on it and
+// any later pair that uses it is re-tested against its current world shape.
+//------------------------------------------------------------------------------------------------------------------------------
+class CollisionBatch2D
+{
+public:
+	CollisionBatch2D();
+	~CollisionBatch2D();
+
+	void						BeginBatch();
+	uint						AddPair(Collider2D* colliderA, Collider2D* colliderB);
+	void						RunBatch();
+
+	bool						GetCollision(Collision2D* out, uint pairIndex);
+	void						MarkColliderMoved(Collider2D* collider);
+
+	inline uint					GetNumPairs() const			{ return static_cast<uint>(m_pairs.size()); }
+
+private:
+	int							CacheWorldShape(Collider2D* collider);
+
+	void						RunAABB2VsAABB2Batch(const std::vector<uint>& pairIndices);
+	void						RunDiscVsDiscBatch(const std::vector<uint>& pairIndices);
+	void						RunAABB2VsDiscBatch(const std::vector<uint>& pairIndices);
+	void						RunDiscVsAABB2Batch(const std::vector<uint>& pairIndices);
+	void						RunBoxVsBoxBatch(const std::vector<uint>& pairIndices);
+	void						RunCapsuleVsCapsuleBatch(const std::vector<uint>& pairIndices);
+	void						RunCapsuleVsBoxBatch(const std::vector<uint>& pairIndices);
+	void						RunBoxVsCapsuleBatch(const std::vector<uint>& pairIndices);
+	void						RunConvexByConvexBatch(const std::vector<uint>& pairIndices);
+
+	ConvexSupport2D				GetCachedSupport(const Collider2D* collider, int entryIndex) const;
+
+	void						SetResult(uint pairIndex, const Manifold2D& manifold);
+
+private:
+	uint						m_stamp = 0U;
+
+	WorldShapeCache2D			m_shapes;
+
+	//Per cache entry (one per collider in the batch)
+	std::vector<int>			m_entryShapeIndex;
+	std::vector<uchar>			m_entryMoved;
+
+	//Per pair
+	std::vector<CollisionPair2D>	m_pairs;
+	std::vector<Manifold2D>		m_manifolds;
+	std::vector<uchar>			m_hits;
+
+	std::vector<uint>			m_pairsByType[NUM_COLLIDER_TYPES][NUM_COLLIDER_TYPES];
+};
@@ -0,0 +1,234 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Math/CollisionBenchmark.hpp"
+//Engine Systems
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/CollisionHandler.hpp"
+#include "Engine/Math/ConvexPoly2D.hpp"
+#include "Engine/Math/Disc2D.hpp"
+#include "Engine/Math/GJK2D.hpp"
+#include "Engine/Math/OBB2.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Math/Ray2D.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr int			BENCHMARK_NUM_SHAPES = 256;
+constexpr float			BENCHMARK_WORLD_SIZE = 40.f;
+constexpr float			BENCHMARK_MIN_SHAPE_SIZE = 1.f;
+constexpr float			BENCHMARK_MAX_SHAPE_SIZE = 12.f;
+constexpr int			BENCHMARK_PAIR_STRIDE = 7;			// pair shape i with i + stride so every pair differs
+constexpr int			BENCHMARK_POLYGON_CLOUD_SIZE = 12;	// random points hulled into each benchmark polygon
+
+//Results are summed here so the optimizer can not drop the calls
+static volatile float	s_benchmarkSink = 0.f;
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct CollisionBenchmarkScene
+{
+	std::vector<AABB2>		m_boxes;
+	std::vector<Disc2D>		m_discs;
+	std::vector<OBB2>		m_orientedBoxes;
+	std::vector<float>		m_radii;
+	std::vector<Ray2D>		m_rays;
+	std::vector<ConvexPoly2D>	m_polygons;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void MakeBenchmarkScene(CollisionBenchmarkScene* scene, unsigned int seed)
+{
+	RandomNumberGenerator rng(seed);
+
+	for(int shapeIndex = 0; shapeIndex < BENCHMARK_NUM_SHAPES; shapeIndex++)
+	{
+		Vec2 center(rng.GetRandomFloatInRange(0.f, BENCHMARK_WORLD_SIZE), rng.GetRandomFloatInRange(0.f, BENCHMARK_WORLD_SIZE));
+		Vec2 size(rng.GetRandomFloatInRange(BENCHMARK_MIN_SHAPE_SIZE, BENCHMARK_MAX_SHAPE_SIZE), rng.GetRandomFloatInRange(BENCHMARK_MIN_SHAPE_SIZE, BENCHMARK_MAX_SHAPE_SIZE));
+		float rotationDegrees = rng.GetRandomFloatInRange(0.f, 360.f);
+		float radius = size.x * 0.5f;
+
+		scene->m_boxes.push_back(AABB2(center - size * 0.5f, center + size * 0.5f));
+		scene->m_discs.push_back(Disc2D(center, radius));
+		scene->m_orientedBoxes.push_back(OBB2(center, size, rotationDegrees));
+		scene->m_radii.push_back(radius * 0.25f);
+
+		Vec2 rayStart(rng.GetRandomFloatInRange(0.f, BENCHMARK_WORLD_SIZE), rng.GetRandomFloatInRange(0.f, BENCHMARK_WORLD_SIZE));
+		Vec2 rayDirection = Vec2::MakeFromPolarDegrees(rng.GetRandomFloatInRange(0.f, 360.f));
+		scene->m_rays.push_back(Ray2D(rayStart, rayDirection));
+	}
+
+	//Polygons use their own generator so the shapes above stay the same as in builds without them
+	RandomNumberGenerator polygonRng(seed + 1U);
+	for(int shapeIndex = 0; shapeIndex < BENCHMARK_NUM_SHAPES; shapeIndex++)
+	{
+		const Disc2D& disc = scene->m_discs[shapeIndex];
+
+		std::vector<Vec2> cloud;
+		for(int pointIndex = 0; pointIndex < BENCHMARK_POLYGON_CLOUD_SIZE; pointIndex++)
+		{
+			cloud.push_back(disc.GetCentre() + Vec2::MakeFromPolarDegrees(polygonRng.GetRandomFloatInRange(0.f, 360.f), polygonRng.GetRandomFloatInRange(0.f, disc.GetRadius())));
+		}
+		scene->m_polygons.push_back(ConvexPoly2D::MakeConvexPolyFromPoints(cloud));
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Calls test(a, b) for every shape pair numIterations times and records the time per call
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename PAIR_TEST>
+static void TimePairTest(std::vector<CollisionBenchmarkResult>* outResults, const char* name, int numIterations, PAIR_TEST test)
+{
+	CollisionBenchmarkResult result;
+	result.m_name = name;
+
+	uint64_t startHPC = GetCurrentTimeHPC();
+	for(int iteration = 0; iteration < numIterations; iteration++)
+	{
+		int numHits = 0;
+		for(int shapeIndex = 0; shapeIndex < BENCHMARK_NUM_SHAPES; shapeIndex++)
+		{
+			int otherIndex = (shapeIndex + BENCHMARK_PAIR_STRIDE) % BENCHMARK_NUM_SHAPES;
+			if(test(shapeIndex, otherIndex))
+			{
+				numHits++;
+			}
+		}
+
+		result.m_numHits = numHits;
+	}
+	uint64_t endHPC = GetCurrentTimeHPC();
+
+	result.m_numCalls = numIterations * BENCHMARK_NUM_SHAPES;
+	if(result.m_numCalls > 0)
+	{
+		result.m_nanosecondsPerCall = GetHPCToSeconds(endHPC - startHPC) * 1e9 / static_cast<double>(result.m_numCalls);
+	}
+
+	outResults->push_back(result);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void RunCollisionBenchmark(std::vector<CollisionBenchmarkResult>* outResults, int numIterations, unsigned int seed)
+{
+	CollisionBenchmarkScene scene;
+	MakeBenchmarkScene(&scene, seed);
+
+	TimePairTest(outResults, "AABB2 vs AABB2", numIterations, [&scene](int a, int b)
+	{
+		Manifold2D manifold;
+		bool hit = GetManifold(&manifold, scene.m_boxes[a], scene.m_boxes[b]);
+		s_benchmarkSink = s_benchmarkSink + manifold.m_penetration;
+		return hit;
+	});
+
+	TimePairTest(outResults, "AABB2 vs Disc", numIterations, [&scene](int a, int b)
+	{
+		Manifold2D manifold;
+		bool hit = GetManifold(&manifold, scene.m_boxes[a], scene.m_discs[b]);
+		s_benchmarkSink = s_benchmarkSink + manifold.m_penetration;
+		return hit;
+	});
+
+	TimePairTest(outResults, "Disc vs Disc", numIterations, [&scene](int a, int b)
+	{
+		Manifold2D manifold;
+		bool hit = GetManifold(&manifold, scene.m_discs[a], scene.m_discs[b]);
+		s_benchmarkSink = s_benchmarkSink + manifold.m_penetration;
+		return hit;
+	});
+
+	TimePairTest(outResults, "OBB2 vs OBB2", numIterations, [&scene](int a, int b)
+	{
+		Manifold2D manifold;
+		bool hit = GetManifold(&manifold, scene.m_orientedBoxes[a], scene.m_orientedBoxes[b]);
+		s_benchmarkSink = s_benchmarkSink + manifold.m_penetration;
+		return hit;
+	});
+
+	TimePairTest(outResults, "OBB2 vs OBB2 (contact)", numIterations, [&scene](int a, int b)
+	{
+		Manifold2D manifold;
+		bool hit = GetManifoldWithContact(&manifold, scene.m_orientedBoxes[a], scene.m_orientedBoxes[b]);
+		s_benchmarkSink = s_benchmarkSink + manifold.m_contact.x;
+		return hit;
+	});
+
+	TimePairTest(outResults, "Rounded OBB2 vs OBB2", numIterations, [&scene](int a, int b)
+	{
+		Manifold2D manifold;
+		bool hit = GetManifold(&manifold, scene.m_orientedBoxes[a], scene.m_radii[a], scene.m_orientedBoxes[b], scene.m_radii[b]);
+		s_benchmarkSink = s_benchmarkSink + manifold.m_penetration;
+		return hit;
+	});
+
+	//Same pairs through the generic GJK/EPA path, hit counts should match the specialized versions above
+	TimePairTest(outResults, "GJK AABB2 vs AABB2", numIterations, [&scene](int a, int b)
+	{
+		Manifold2D manifold;
+		bool hit = GetManifoldGJK(&manifold, ConvexSupport2D(scene.m_boxes[a]), ConvexSupport2D(scene.m_boxes[b]));
+		s_benchmarkSink = s_benchmarkSink + manifold.m_penetration;
+		return hit;
+	});
+
+	TimePairTest(outResults, "GJK AABB2 vs Disc", numIterations, [&scene](int a, int b)
+	{
+		Manifold2D manifold;
+		bool hit = GetManifoldGJK(&manifold, ConvexSupport2D(scene.m_boxes[a]), ConvexSupport2D(scene.m_discs[b]));
+		s_benchmarkSink = s_benchmarkSink + manifold.m_penetration;
+		return hit;
+	});
+
+	TimePairTest(outResults, "GJK Disc vs Disc", numIterations, [&scene](int a, int b)
+	{
+		Manifold2D manifold;
+		bool hit = GetManifoldGJK(&manifold, ConvexSupport2D(scene.m_discs[a]), ConvexSupport2D(scene.m_discs[b]));
+		s_benchmarkSink = s_benchmarkSink + manifold.m_penetration;
+		return hit;
+	});
+
+	TimePairTest(outResults, "GJK OBB2 vs OBB2", numIterations, [&scene](int a, int b)
+	{
+		Manifold2D manifold;
+		bool hit = GetManifoldGJK(&manifold, ConvexSupport2D(scene.m_orientedBoxes[a]), ConvexSupport2D(scene.m_orientedBoxes[b]));
+		s_benchmarkSink = s_benchmarkSink + manifold.m_contact.x;
+		return hit;
+	});
+
+	TimePairTest(outResults, "GJK Rounded OBB2 vs OBB2", numIterations, [&scene](int a, int b)
+	{
+		Manifold2D manifold;
+		bool hit = GetManifoldGJK(&manifold, ConvexSupport2D(scene.m_orientedBoxes[a], scene.m_radii[a]), ConvexSupport2D(scene.m_orientedBoxes[b], scene.m_radii[b]));
+		s_benchmarkSink = s_benchmarkSink + manifold.m_penetration;
+		return hit;
+	});
+
+	TimePairTest(outResults, "GJK Polygon vs Polygon", numIterations, [&scene](int a, int b)
+	{
+		Manifold2D manifold;
+		bool hit = GetManifoldGJK(&manifold, ConvexSupport2D(scene.m_polygons[a]), ConvexSupport2D(scene.m_polygons[b]));
+		s_benchmarkSink = s_benchmarkSink + manifold.m_penetration;
+		return hit;
+	});
+
+	TimePairTest(outResults, "Raycast Disc", numIterations, [&scene](int a, int b)
+	{
+		float times[2] = { 0.f, 0.f };
+		uint numHits = Raycast(times, scene.m_rays[a], scene.m_discs[b]);
+		s_benchmarkSink = s_benchmarkSink + times[0];
+		return numHits > 0;
+	});
+
+	TimePairTest(outResults, "Raycast AABB2", numIterations, [&scene](int a, int b)
+	{
+		float times[2] = { 0.f, 0.f };
+		uint numHits = Raycast(times, scene.m_rays[a], scene.m_boxes[b]);
+		s_benchmarkSink = s_benchmarkSink + times[0];
+		return numHits > 0;
+	});
+
+	TimePairTest(outResults, "Raycast OBB2", numIterations, [&scene](int a, int b)
+	{
+		float times[2] = { 0.f, 0.f };
+		uint numHits = Raycast(times, scene.m_rays[a], scene.m_orientedBoxes[b]);
+		s_benchmarkSink = s_benchmarkSink + times[0];
+		return numHits > 0;
+	});
+}
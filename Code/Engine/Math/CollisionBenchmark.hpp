@@ -0,0 +1,21 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct CollisionBenchmarkResult
+{
+	const char*				m_name = "";
+	double					m_nanosecondsPerCall = 0.0;
+	int						m_numCalls = 0;
+	int						m_numHits = 0;					// should match between runs, a change means the math changed
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Micro benchmark over the math heavy 2D collision routines (manifold generation and raycasts)
+//
+// Runs every routine over the same seeded scene so numbers from two builds can be compared directly: build the commit you
+// want to compare against, run "BenchmarkCollision" in the dev console on both and compare the ns per call. The hit counts
+// have to be the same across builds for the comparison to be valid.
+//------------------------------------------------------------------------------------------------------------------------------
+void	RunCollisionBenchmark(std::vector<CollisionBenchmarkResult>* outResults, int numIterations = 100, unsigned int seed = 0);
@@ -1,6 +1,8 @@
 //------------------------------------------------------------------------------------------------------------------------------
 #include "Engine/Math/CollisionHandler.hpp"
 #include "Engine/Math/Collider2D.hpp"
+#include "Engine/Math/Disc2D.hpp"
+#include "Engine/Math/GJK2D.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/Manifold.hpp"
 #include "Engine/Math/Plane2D.hpp"
@@ -9,13 +11,13 @@
 
 //------------------------------------------------------------------------------------------------------------------------------
 CollisionCheck2DCallback COLLISION_LOOKUP_TABLE[COLLIDER2D_COUNT][COLLIDER2D_COUNT] = {
-	/*******| aabb2 | disc  | capsl | obb2 | line  | point  */
-	/*aabb2*/ { CheckAABB2ByAABB2, CheckAABB2ByDisc, nullptr,				nullptr,			nullptr, nullptr },
-	/*disc */ { CheckDiscByAABB2,  CheckDiscByDisc,  nullptr,				nullptr,			nullptr, nullptr },
-	/*capsl*/ { nullptr,           nullptr,          CheckCapsuleByCapsule, CheckCapsuleByOBB2,	nullptr, nullptr },
-	/*obb2*/  { nullptr,           nullptr,          CheckOBB2ByCapsule,	CheckOBB2ByOBB2,	nullptr, nullptr },
-	/*line*/  { nullptr,           nullptr,          nullptr,				nullptr,			nullptr, nullptr },
-	/*point*/ { nullptr,           nullptr,          nullptr,				nullptr,			nullptr, nullptr },
+	/*******| aabb2 | disc  | capsl | obb2 | poly  | point  */
+	/*aabb2*/ { CheckAABB2ByAABB2,   CheckAABB2ByDisc,    CheckConvexByConvex,	CheckConvexByConvex,	CheckConvexByConvex, nullptr },
+	/*disc */ { CheckDiscByAABB2,    CheckDiscByDisc,     CheckConvexByConvex,	CheckConvexByConvex,	CheckConvexByConvex, nullptr },
+	/*capsl*/ { CheckConvexByConvex, CheckConvexByConvex, CheckCapsuleByCapsule, CheckCapsuleByOBB2,	CheckConvexByConvex, nullptr },
+	/*obb2*/  { CheckConvexByConvex, CheckConvexByConvex, CheckOBB2ByCapsule,	CheckOBB2ByOBB2,		CheckConvexByConvex, nullptr },
+	/*poly*/  { CheckConvexByConvex, CheckConvexByConvex, CheckConvexByConvex,	CheckConvexByConvex,	CheckConvexByConvex, nullptr },
+	/*point*/ { nullptr,             nullptr,             nullptr,				nullptr,				nullptr,			 nullptr },
 }; 
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -27,7 +29,7 @@ bool GetCollisionInfo( Collision2D* out, Collider2D* a, Collider2D* b )
 	uint aType = a->GetType(); 
 	uint bType = b->GetType(); 
 
-	if(aType >= COLLIDER2D_COUNT && bType >= COLLIDER2D_COUNT)
+	if(aType >= COLLIDER2D_COUNT || bType >= COLLIDER2D_COUNT)
 	{
 		ERROR_AND_DIE("The Collider type was not part of the COLLISION_LOOKUP_TABLE");
 	}
@@ -46,10 +48,16 @@ bool GetCollisionInfo( Collision2D* out, Collider2D* a, Collider2D* b )
 
 //------------------------------------------------------------------------------------------------------------------------------
 bool GetManifold( Manifold2D *out, AABB2Collider const &boxA, AABB2Collider const &boxB )
+{
+	return GetManifold(out, boxA.GetWorldShape(), boxB.GetWorldShape());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool GetManifold( Manifold2D *out, AABB2 const &boxAShape, AABB2 const &boxBShape )
 {
 	//Get the intersecting box
-	Vec2 min = boxA.GetWorldShape().m_maxBounds.Min(boxB.GetWorldShape().m_maxBounds);
-	Vec2 max = boxA.GetWorldShape().m_minBounds.Max(boxB.GetWorldShape().m_minBounds);
+	Vec2 min = Vec2(boxAShape.m_maxBounds).Min(boxBShape.m_maxBounds);
+	Vec2 max = Vec2(boxAShape.m_minBounds).Max(boxBShape.m_minBounds);
 
 	//AABB2 collisionBox = AABB2(max, min);
 
@@ -57,9 +65,6 @@ bool GetManifold( Manifold2D *out, AABB2Collider const &boxA, AABB2Collider cons
 	{
 		GenerateManifoldBoxToBox(out, min, max);
 
-		AABB2 boxAShape = boxA.GetWorldShape();
-		AABB2 boxBShape = boxB.GetWorldShape();
-
 		if(out->m_normal.y == 0.f)
 		{	
 			if(((boxAShape.m_maxBounds + boxAShape.m_minBounds)/2).x < ((boxBShape.m_maxBounds + boxBShape.m_minBounds)/2).x)
@@ -88,13 +93,18 @@ bool GetManifold( Manifold2D *out, AABB2Collider const &boxA, AABB2Collider cons
 //------------------------------------------------------------------------------------------------------------------------------
 bool GetManifold( Manifold2D *out, AABB2Collider const &box, Disc2DCollider const &disc )
 {
-	Vec2 discCentre = disc.GetWorldShape().GetCentre();
-	AABB2 boxShape = box.GetWorldShape();
+	return GetManifold(out, box.GetWorldShape(), disc.GetWorldShape());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool GetManifold( Manifold2D *out, AABB2 const &boxShape, Disc2D const &disc )
+{
+	Vec2 discCentre = disc.GetCentre();
 	Vec2 closestPoint = GetClosestPointOnAABB2( discCentre, boxShape );
 	Vec2 boxCenter = boxShape.GetBoxCenter() + boxShape.m_minBounds;
 
 	float distanceSquared = GetDistanceSquared2D(discCentre, closestPoint);
-	float radius = disc.GetWorldShape().GetRadius();
+	float radius = disc.GetRadius();
 	//float distanceBwCenters = GetDistanceSquared2D(discCentre, boxCenter);
 
 	float distance = 0;
@@ -132,13 +142,18 @@ bool GetManifold( Manifold2D *out, AABB2Collider const &box, Disc2DCollider cons
 //------------------------------------------------------------------------------------------------------------------------------
 bool GetManifold( Manifold2D *out, Disc2DCollider const &disc, AABB2Collider const &box)
 {
-	Vec2 discCentre = disc.GetWorldShape().GetCentre();
-	AABB2 boxShape = box.GetWorldShape();
+	return GetManifold(out, disc.GetWorldShape(), box.GetWorldShape());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool GetManifold( Manifold2D *out, Disc2D const &disc, AABB2 const &boxShape )
+{
+	Vec2 discCentre = disc.GetCentre();
 
 	Vec2 closestPoint = GetClosestPointOnAABB2( discCentre, boxShape );
 
 	float distanceSquared = GetDistanceSquared2D(discCentre, closestPoint);
-	float radius = disc.GetWorldShape().GetRadius();
+	float radius = disc.GetRadius();
 
 	if(closestPoint == discCentre)
 	{
@@ -326,9 +341,12 @@ bool GetManifold( Manifold2D *out, OBB2 const &boxA, OBB2 const &boxB)
 //------------------------------------------------------------------------------------------------------------------------------
 bool GetManifold( Manifold2D *out, BoxCollider2D const &a, BoxCollider2D const &b )
 {
-	OBB2 boxA = a.GetWorldShape();
-	OBB2 boxB = b.GetWorldShape();
+	return GetManifoldWithContact(out, a.GetWorldShape(), b.GetWorldShape());
+}
 
+//------------------------------------------------------------------------------------------------------------------------------
+bool GetManifoldWithContact( Manifold2D *out, OBB2 const &boxA, OBB2 const &boxB )
+{
 	Plane2D planesOfThis[4];    // p0
 	Plane2D planesOfOther[4];   // p1
 
@@ -761,11 +779,17 @@ bool IsDiscInBox(Manifold2D* out, const Vec2 &discCentre, const AABB2& boxShape,
 //------------------------------------------------------------------------------------------------------------------------------
 bool GetManifold( Manifold2D *out, Disc2DCollider const &discA, Disc2DCollider const &discB )
 {
-	float discARad = discA.GetWorldShape().GetRadius();
-	float discBRad = discB.GetWorldShape().GetRadius();
+	return GetManifold(out, discA.GetWorldShape(), discB.GetWorldShape());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool GetManifold( Manifold2D *out, Disc2D const &discA, Disc2D const &discB )
+{
+	float discARad = discA.GetRadius();
+	float discBRad = discB.GetRadius();
 
-	Vec2 discACenter = discA.GetWorldShape().GetCentre();
-	Vec2 discBCenter = discB.GetWorldShape().GetCentre();
+	Vec2 discACenter = discA.GetCentre();
+	Vec2 discBCenter = discB.GetCentre();
 	float distanceSquared = GetDistanceSquared2D(discACenter, discBCenter);
 	float radSumSquared = (discARad + discBRad) * (discARad + discBRad);
 
@@ -1019,6 +1043,36 @@ bool CheckOBB2ByCapsule( Collision2D* out, Collider2D* a, Collider2D* b )
 	}
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+// Any pair without a specialized function, goes through GJK/EPA on the support shapes of both colliders
+//------------------------------------------------------------------------------------------------------------------------------
+bool CheckConvexByConvex( Collision2D* out, Collider2D* a, Collider2D* b )
+{
+	std::vector<Vec2> pointStorageA;
+	std::vector<Vec2> pointStorageB;
+
+	ConvexSupport2D shapeA;
+	ConvexSupport2D shapeB;
+
+	Manifold2D manifold;
+	bool result = MakeSupportForCollider(&shapeA, &pointStorageA, a) && MakeSupportForCollider(&shapeB, &pointStorageB, b);
+	result = result && GetManifoldGJK(&manifold, shapeA, shapeB);
+
+	if(result)
+	{
+		out->m_Obj = a;
+		out->m_otherObj = b;
+		out->m_manifold = manifold;
+		return true;
+	}
+	else
+	{
+		out->m_Obj = nullptr;
+		out->m_otherObj = nullptr;
+		return false;
+	}
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 void Collision2D::InvertCollision()
 {
@@ -5,8 +5,6 @@
 #include "Engine/Commons/ErrorWarningAssert.hpp"
 #include "Engine/Math/Manifold.hpp"
 
-#include <functional>
-
 typedef unsigned int uint;
 class Collider2D;
 class AABB2Collider;
@@ -15,6 +13,7 @@ class BoxCollider2D;
 class CapsuleCollider2D;
 class OBB2;
 class Capsule2D;
+class Disc2D;
 struct AABB2;
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -27,7 +26,8 @@ struct Collision2D
 	void InvertCollision();
 };
 
-typedef std::function<bool(Collision2D* out, Collider2D* a, Collider2D* b)> CollisionCheck2DCallback ;
+// Plain function pointers so the lookup is a direct call instead of a type-erased std::function
+typedef bool (*CollisionCheck2DCallback)(Collision2D* out, Collider2D* a, Collider2D* b);
 // 2D arrays are [Y][X] remember
 extern CollisionCheck2DCallback COLLISION_LOOKUP_TABLE[][COLLIDER2D_COUNT];
 
@@ -40,6 +40,7 @@ bool				CheckOBB2ByOBB2(Collision2D* out, Collider2D* a, Collider2D* b);
 bool				CheckCapsuleByCapsule(Collision2D* out, Collider2D* a, Collider2D* b);
 bool				CheckCapsuleByOBB2(Collision2D* out, Collider2D* a, Collider2D* b);
 bool				CheckOBB2ByCapsule(Collision2D* out, Collider2D* a, Collider2D* b);
+bool				CheckConvexByConvex(Collision2D* out, Collider2D* a, Collider2D* b);		// GJK/EPA fallback for every other pair
 bool				GetCollisionInfo( Collision2D *out, Collider2D * a, Collider2D *b );
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -50,10 +51,19 @@ bool				GetManifold( Manifold2D *out, AABB2Collider const &obj0, Disc2DCollider
 bool				GetManifold( Manifold2D *out, Disc2DCollider const &obj0, Disc2DCollider const &obj1 );
 bool				GetManifold( Manifold2D *out, Disc2DCollider const &disc, AABB2Collider const &box );
 
+//------------------------------------------------------------------------------------------------------------------------------
+//World shape versions (used by the collider versions above and by the batched narrow phase)
+//------------------------------------------------------------------------------------------------------------------------------
+bool				GetManifold( Manifold2D *out, AABB2 const &boxA, AABB2 const &boxB );
+bool				GetManifold( Manifold2D *out, AABB2 const &box, Disc2D const &disc );
+bool				GetManifold( Manifold2D *out, Disc2D const &discA, Disc2D const &discB );
+bool				GetManifold( Manifold2D *out, Disc2D const &disc, AABB2 const &box );
+
 //------------------------------------------------------------------------------------------------------------------------------
 //OBB to OBB and Pillbox to Pillbox collisions
 //------------------------------------------------------------------------------------------------------------------------------
 bool				GetManifold( Manifold2D *out, OBB2 const &boxA, OBB2 const &boxB );
+bool				GetManifoldWithContact( Manifold2D *out, OBB2 const &boxA, OBB2 const &boxB );
 bool				GetManifold( Manifold2D *out, BoxCollider2D const &a, BoxCollider2D const &b );
 bool				GetManifold( Manifold2D *out, BoxCollider2D const &a, float aRadius, BoxCollider2D const &b, float bRadius );
 bool				GetManifold( Manifold2D *out, OBB2 const &a, float aRadius, OBB2 const &b, float bRadius );
@@ -0,0 +1,171 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Math/ContactReport2D.hpp"
+#include "Engine/Math/Collider2D.hpp"
+#include <algorithm>
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Pairs are keyed on the two collider ids, smallest first, so A vs B and B vs A are the same contact. Ids rather than
+// addresses keep the buffers and the callback order the same from run to run
+//------------------------------------------------------------------------------------------------------------------------------
+static void GetPairKey( uint* outLow, uint* outHigh, const Contact2D& contact )
+{
+	uint a = contact.m_collider->m_colliderId;
+	uint b = contact.m_otherCollider->m_colliderId;
+
+	*outLow = (a < b) ? a : b;
+	*outHigh = (a < b) ? b : a;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static int ComparePairs( const Contact2D& contactA, const Contact2D& contactB )
+{
+	uint lowA, highA, lowB, highB;
+	GetPairKey(&lowA, &highA, contactA);
+	GetPairKey(&lowB, &highB, contactB);
+
+	if (lowA != lowB)
+	{
+		return (lowA < lowB) ? -1 : 1;
+	}
+
+	if (highA != highB)
+	{
+		return (highA < highB) ? -1 : 1;
+	}
+
+	return 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+ContactReport2D::ContactReport2D()
+{
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+ContactReport2D::~ContactReport2D()
+{
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ContactReport2D::BeginStep()
+{
+	m_stepContacts.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ContactReport2D::AddContact( Collider2D* collider, Collider2D* otherCollider, const Manifold2D& manifold )
+{
+	Contact2D contact;
+	contact.m_collider = collider;
+	contact.m_otherCollider = otherCollider;
+	contact.m_manifold = manifold;
+
+	m_stepContacts.push_back(contact);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ContactReport2D::EndStep()
+{
+	for (int stateIndex = 0; stateIndex < NUM_CONTACT_STATES; stateIndex++)
+	{
+		m_reports[stateIndex].clear();
+	}
+
+	//A pair can be found by more than one pass in a step, keep the first time we saw it
+	SortByPair(m_stepContacts);
+	m_stepContacts.erase(std::unique(m_stepContacts.begin(), m_stepContacts.end(), [](const Contact2D& a, const Contact2D& b) { return ComparePairs(a, b) == 0; }), m_stepContacts.end());
+
+	//Both lists are sorted, so one walk splits them into begin, persist and end
+	int numContacts = static_cast<int>(m_stepContacts.size());
+	int numPrevious = static_cast<int>(m_previousContacts.size());
+	int contactIndex = 0;
+	int previousIndex = 0;
+
+	while (contactIndex < numContacts || previousIndex < numPrevious)
+	{
+		int compare;
+		if (contactIndex == numContacts)
+		{
+			compare = 1;
+		}
+		else if (previousIndex == numPrevious)
+		{
+			compare = -1;
+		}
+		else
+		{
+			compare = ComparePairs(m_stepContacts[contactIndex], m_previousContacts[previousIndex]);
+		}
+
+		if (compare == 0)
+		{
+			m_reports[CONTACT_PERSIST].push_back(m_stepContacts[contactIndex]);
+			contactIndex++;
+			previousIndex++;
+		}
+		else if (compare < 0)
+		{
+			m_reports[CONTACT_BEGIN].push_back(m_stepContacts[contactIndex]);
+			contactIndex++;
+		}
+		else
+		{
+			m_reports[CONTACT_END].push_back(m_previousContacts[previousIndex]);
+			previousIndex++;
+		}
+	}
+
+	std::swap(m_previousContacts, m_stepContacts);
+
+	for (int stateIndex = 0; stateIndex < NUM_CONTACT_STATES; stateIndex++)
+	{
+		int numReports = static_cast<int>(m_reports[stateIndex].size());
+		for (int reportIndex = 0; reportIndex < numReports; reportIndex++)
+		{
+			FireContactCallbacks(static_cast<eContactState2D>(stateIndex), m_reports[stateIndex][reportIndex]);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC void ContactReport2D::SortByPair( std::vector<Contact2D>& contacts )
+{
+	std::stable_sort(contacts.begin(), contacts.end(), [](const Contact2D& a, const Contact2D& b) { return ComparePairs(a, b) < 0; });
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ContactReport2D::FireContactCallbacks( eContactState2D state, const Contact2D& contact ) const
+{
+	if (contact.m_collider->m_onContact != nullptr)
+	{
+		contact.m_collider->m_onContact(state, contact, contact.m_collider->m_contactUserData);
+	}
+
+	if (contact.m_otherCollider->m_onContact != nullptr)
+	{
+		//Flip so the receiver is always m_collider
+		Contact2D flipped;
+		flipped.m_collider = contact.m_otherCollider;
+		flipped.m_otherCollider = contact.m_collider;
+		flipped.m_manifold = contact.m_manifold;
+		flipped.m_manifold.m_normal = contact.m_manifold.m_normal * -1.f;
+
+		contact.m_otherCollider->m_onContact(state, flipped, contact.m_otherCollider->m_contactUserData);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ContactReport2D::RemoveCollider( Collider2D* collider )
+{
+	auto usesCollider = [collider](const Contact2D& contact) { return contact.m_collider == collider || contact.m_otherCollider == collider; };
+
+	m_stepContacts.erase(std::remove_if(m_stepContacts.begin(), m_stepContacts.end(), usesCollider), m_stepContacts.end());
+	m_previousContacts.erase(std::remove_if(m_previousContacts.begin(), m_previousContacts.end(), usesCollider), m_previousContacts.end());
+
+	for (int stateIndex = 0; stateIndex < NUM_CONTACT_STATES; stateIndex++)
+	{
+		m_reports[stateIndex].erase(std::remove_if(m_reports[stateIndex].begin(), m_reports[stateIndex].end(), usesCollider), m_reports[stateIndex].end());
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+//------------------------------------------------------------------------------------------------------------------------------
+//Engine Systems
+#include "Engine/Math/Manifold.hpp"
+#include <vector>
+
+class Collider2D;
+
+//------------------------------------------------------------------------------------------------------------------------------
+enum eContactState2D
+{
+	CONTACT_BEGIN,			// first step the pair touched
+	CONTACT_PERSIST,		// touched last step and this step
+	CONTACT_END,			// touched last step but not this step
+
+	NUM_CONTACT_STATES
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct Contact2D
+{
+	Collider2D*		m_collider = nullptr;
+	Collider2D*		m_otherCollider = nullptr;
+	Manifold2D		m_manifold;						// normal is relative to m_collider; for end contacts this is the last manifold seen
+};
+
+// Typed per collider callback. The contact is always passed with m_collider set to the collider the callback is on
+typedef void (*ContactCallback2D)(eContactState2D state, const Contact2D& contact, void* userData);
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Contacts found by the physics step, sorted into begin/persist/end buffers every step. Gameplay can read the buffers
+// as arrays after the step or register a ContactCallback2D on a collider. No strings, maps or allocations per contact.
+//------------------------------------------------------------------------------------------------------------------------------
+class ContactReport2D
+{
+	friend class PhysicsSnapshot2D;
+
+public:
+	ContactReport2D();
+	~ContactReport2D();
+
+	void								BeginStep();
+	void								AddContact(Collider2D* collider, Collider2D* otherCollider, const Manifold2D& manifold);
+	void								EndStep();
+
+	//Call before a collider is deleted so no buffer keeps a dangling pointer
+	void								RemoveCollider(Collider2D* collider);
+
+	inline const std::vector<Contact2D>&	GetContacts(eContactState2D state) const		{ return m_reports[state]; }
+	inline const std::vector<Contact2D>&	GetBeginContacts() const						{ return m_reports[CONTACT_BEGIN]; }
+	inline const std::vector<Contact2D>&	GetPersistContacts() const						{ return m_reports[CONTACT_PERSIST]; }
+	inline const std::vector<Contact2D>&	GetEndContacts() const							{ return m_reports[CONTACT_END]; }
+
+private:
+	void								FireContactCallbacks(eContactState2D state, const Contact2D& contact) const;
+	static void							SortByPair(std::vector<Contact2D>& contacts);
+
+private:
+	std::vector<Contact2D>				m_stepContacts;				// found this step, in detection order (may repeat pairs)
+	std::vector<Contact2D>				m_previousContacts;			// last step's contacts, sorted by pair and unique
+
+	std::vector<Contact2D>				m_reports[NUM_CONTACT_STATES];
+};
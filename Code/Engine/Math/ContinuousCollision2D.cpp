@@ -0,0 +1,231 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Math/ContinuousCollision2D.hpp"
+#include "Engine/Math/Collider2D.hpp"
+#include "Engine/Math/Disc2D.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Ray2D.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+// What we sweep for the moving collider: an axis aligned box with rounded corners
+// AABB2 movers have no radius, every other mover is a disc (no half extents)
+//------------------------------------------------------------------------------------------------------------------------------
+struct SweptProfile2D
+{
+	Vec2	m_center = Vec2::ZERO;
+	Vec2	m_halfExtents = Vec2::ZERO;
+	float	m_radius = 0.f;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+static bool GetSweptProfile( SweptProfile2D* out, Collider2D* collider )
+{
+	switch (collider->GetType())
+	{
+	case COLLIDER_AABB2:
+	{
+		AABB2 box = reinterpret_cast<AABB2Collider*>(collider)->GetWorldShape();
+		out->m_center = (box.m_minBounds + box.m_maxBounds) * 0.5f;
+		out->m_halfExtents = (box.m_maxBounds - box.m_minBounds) * 0.5f;
+		out->m_radius = 0.f;
+		return true;
+	}
+	case COLLIDER_DISC:
+	{
+		Disc2D disc = reinterpret_cast<Disc2DCollider*>(collider)->GetWorldShape();
+		out->m_center = disc.GetCentre();
+		out->m_radius = disc.GetRadius();
+		return true;
+	}
+	case COLLIDER_BOX:
+	{
+		OBB2 box = reinterpret_cast<BoxCollider2D*>(collider)->GetWorldShape();
+		out->m_center = box.GetCenter();
+		out->m_radius = GetLowerValue(box.GetHalfExtents().x, box.GetHalfExtents().y);
+		return true;
+	}
+	case COLLIDER_CAPSULE:
+	{
+		CapsuleCollider2D* capsule = reinterpret_cast<CapsuleCollider2D*>(collider);
+		out->m_center = capsule->GetWorldShape().GetCenter();
+		out->m_radius = capsule->GetCapsuleRadius();
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool RaycastRoundedBox( float* outTime, Vec2* outNormal, const Ray2D& ray, const Vec2& boxCenter, const Vec2& halfExtents, float radius )
+{
+	float bestTime = 100000000.f;
+	bool startsInside = false;
+	float times[2];
+
+	//The rounded box is the union of 2 boxes (pushed out on x and on y) and a disc on each corner
+	AABB2 wideBox(boxCenter - Vec2(halfExtents.x + radius, halfExtents.y), boxCenter + Vec2(halfExtents.x + radius, halfExtents.y));
+	AABB2 tallBox(boxCenter - Vec2(halfExtents.x, halfExtents.y + radius), boxCenter + Vec2(halfExtents.x, halfExtents.y + radius));
+
+	AABB2 const* boxes[2] = { &wideBox, &tallBox };
+	for (int boxIndex = 0; boxIndex < 2; boxIndex++)
+	{
+		if (Raycast(times, ray, *boxes[boxIndex]) > 0)
+		{
+			if (times[0] < 0.f)
+			{
+				startsInside = true;
+			}
+			else
+			{
+				bestTime = GetLowerValue(bestTime, times[0]);
+			}
+		}
+	}
+
+	if (radius > 0.f)
+	{
+		Vec2 corners[4] =
+		{
+			boxCenter + Vec2(-halfExtents.x, -halfExtents.y),
+			boxCenter + Vec2( halfExtents.x, -halfExtents.y),
+			boxCenter + Vec2( halfExtents.x,  halfExtents.y),
+			boxCenter + Vec2(-halfExtents.x,  halfExtents.y)
+		};
+
+		for (int cornerIndex = 0; cornerIndex < 4; cornerIndex++)
+		{
+			Vec2 toCorner = corners[cornerIndex] - ray.m_start;
+			if (toCorner.GetLengthSquared() < radius * radius)
+			{
+				startsInside = true;
+				continue;
+			}
+
+			//The disc raycast reports distances, so make sure the disc is in front of us first
+			if (GetDotProduct(toCorner, ray.m_direction) <= 0.f)
+			{
+				continue;
+			}
+
+			Disc2D disc(corners[cornerIndex], radius);
+			if (Raycast(times, ray, disc) > 0)
+			{
+				bestTime = GetLowerValue(bestTime, times[0]);
+			}
+		}
+	}
+
+	//Already overlapping, the discrete pass deals with that
+	if (startsInside || bestTime == 100000000.f)
+	{
+		return false;
+	}
+
+	*outTime = bestTime;
+
+	//Normal from the feature we hit: a corner disc, or the side that is furthest out
+	Vec2 local = ray.GetPointAtTime(bestTime) - boxCenter;
+	float signX = (local.x < 0.f) ? -1.f : 1.f;
+	float signY = (local.y < 0.f) ? -1.f : 1.f;
+
+	if (abs(local.x) > halfExtents.x && abs(local.y) > halfExtents.y)
+	{
+		Vec2 corner = Vec2(signX * halfExtents.x, signY * halfExtents.y);
+		*outNormal = (local - corner).GetNormalized();
+	}
+	else if ((abs(local.x) - halfExtents.x) > (abs(local.y) - halfExtents.y))
+	{
+		*outNormal = Vec2(signX, 0.f);
+	}
+	else
+	{
+		*outNormal = Vec2(0.f, signY);
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool GetTimeOfImpact( TimeOfImpact2D* out, Collider2D* movingCollider, const Vec2& displacement, Collider2D* staticCollider )
+{
+	float distance = displacement.GetLength();
+	if (distance <= 0.f)
+	{
+		return false;
+	}
+
+	SweptProfile2D mover;
+	if (!GetSweptProfile(&mover, movingCollider))
+	{
+		return false;
+	}
+
+	Ray2D ray(mover.m_center, displacement / distance);
+
+	float timeAtHit = 0.f;
+	Vec2 normal;
+	bool hit = false;
+
+	switch (staticCollider->GetType())
+	{
+	case COLLIDER_AABB2:
+	{
+		AABB2 box = reinterpret_cast<AABB2Collider*>(staticCollider)->GetWorldShape();
+		Vec2 center = (box.m_minBounds + box.m_maxBounds) * 0.5f;
+		Vec2 halfExtents = (box.m_maxBounds - box.m_minBounds) * 0.5f;
+
+		hit = RaycastRoundedBox(&timeAtHit, &normal, ray, center, halfExtents + mover.m_halfExtents, mover.m_radius);
+	}
+	break;
+	case COLLIDER_DISC:
+	{
+		Disc2D disc = reinterpret_cast<Disc2DCollider*>(staticCollider)->GetWorldShape();
+
+		hit = RaycastRoundedBox(&timeAtHit, &normal, ray, disc.GetCentre(), mover.m_halfExtents, mover.m_radius + disc.GetRadius());
+	}
+	break;
+	case COLLIDER_BOX:
+	case COLLIDER_CAPSULE:
+	{
+		//Both are boxes in their own space, a capsule is a zero width box with rounded ends
+		OBB2 box;
+		float radius = 0.f;
+		if (staticCollider->GetType() == COLLIDER_BOX)
+		{
+			box = reinterpret_cast<BoxCollider2D*>(staticCollider)->GetWorldShape();
+		}
+		else
+		{
+			box = reinterpret_cast<CapsuleCollider2D*>(staticCollider)->GetWorldShape();
+			radius = reinterpret_cast<CapsuleCollider2D*>(staticCollider)->GetCapsuleRadius();
+		}
+
+		//Rotated shapes only sum exactly with a disc, so AABB2 movers use their inscribed disc here
+		float moverRadius = mover.m_radius;
+		if (mover.m_halfExtents != Vec2::ZERO)
+		{
+			moverRadius = GetLowerValue(mover.m_halfExtents.x, mover.m_halfExtents.y);
+		}
+
+		Ray2D localRay(box.ToLocalPoint(ray.m_start), Vec2(GetDotProduct(ray.m_direction, box.GetRight()), GetDotProduct(ray.m_direction, box.GetUp())));
+
+		Vec2 localNormal;
+		hit = RaycastRoundedBox(&timeAtHit, &localNormal, localRay, Vec2::ZERO, box.GetHalfExtents(), radius + moverRadius);
+		normal = localNormal.x * box.GetRight() + localNormal.y * box.GetUp();
+	}
+	break;
+	default:
+		break;
+	}
+
+	//Only count hits inside this step that we are moving into
+	if (!hit || timeAtHit > distance || GetDotProduct(normal, ray.m_direction) >= 0.f)
+	{
+		return false;
+	}
+
+	out->m_fraction = timeAtHit / distance;
+	out->m_normal = normal;
+	out->m_collider = staticCollider;
+	return true;
+}
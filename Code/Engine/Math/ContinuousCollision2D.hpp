@@ -0,0 +1,30 @@
+#pragma once
+//------------------------------------------------------------------------------------------------------------------------------
+//Engine Systems
+#include "Engine/Math/Vec2.hpp"
+
+class Collider2D;
+struct Ray2D;
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct TimeOfImpact2D
+{
+	float			m_fraction = 1.f;				// fraction of the displacement covered before first contact
+	Vec2			m_normal = Vec2::ZERO;			// surface normal of the shape we hit, pointing back at the mover
+	Collider2D*		m_collider = nullptr;			// the collider we hit
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Swept shape tests for continuous collision detection (CCD)
+//
+// The moving shape is swept along displacement against a shape that does not move. Each pair is reduced to a raycast
+// from the mover's center against the Minkowski sum of both shapes, using the Raycast routines in Ray2D.
+// AABB2 and disc movers are exact against AABB2 and disc shapes. Against boxes and capsules, and for box and capsule
+// movers, the mover is swept as its inscribed disc (the same "inner sphere" idea PhysX uses for CCD). It can still
+// stop a bit late, but its center never passes through a wall and the discrete pass resolves the rest.
+//------------------------------------------------------------------------------------------------------------------------------
+bool			GetTimeOfImpact( TimeOfImpact2D* out, Collider2D* movingCollider, const Vec2& displacement, Collider2D* staticCollider );
+
+// Ray against a box (centered at boxCenter, axis aligned) with its edges pushed out by radius and rounded corners
+// The ray direction must be normalized, times are distances along the ray
+bool			RaycastRoundedBox( float* outTime, Vec2* outNormal, const Ray2D& ray, const Vec2& boxCenter, const Vec2& halfExtents, float radius );
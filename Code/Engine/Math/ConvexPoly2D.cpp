@@ -1,4 +1,59 @@
 #include "Engine/Math/ConvexPoly2D.hpp"
+#include "Engine/Commons/EngineCommon.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Twice the signed area of (start, end, point), negative when point is right of start -> end
+//------------------------------------------------------------------------------------------------------------------------------
+static inline float GetSignedArea2D( const Vec2& start, const Vec2& end, const Vec2& point )
+{
+	return (end.x - start.x) * (point.y - start.y) - (end.y - start.y) * (point.x - start.x);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Adds the hull points strictly right of start -> end, in order from start to end (not including either)
+//------------------------------------------------------------------------------------------------------------------------------
+static void AddQuickhullPoints( std::vector<Vec2>* hull, const std::vector<Vec2>& candidates, const Vec2& start, const Vec2& end )
+{
+	if (candidates.empty())
+	{
+		return;
+	}
+
+	//Furthest point from the edge is on the hull
+	int farthestIndex = 0;
+	float farthestArea = 0.f;
+	for (int pointIndex = 0; pointIndex < static_cast<int>(candidates.size()); pointIndex++)
+	{
+		float area = GetSignedArea2D(start, end, candidates[pointIndex]);
+		if (area < farthestArea)
+		{
+			farthestArea = area;
+			farthestIndex = pointIndex;
+		}
+	}
+
+	Vec2 farthest = candidates[farthestIndex];
+
+	//Points inside the triangle (start, farthest, end) can not be on the hull
+	std::vector<Vec2> rightOfStart;
+	std::vector<Vec2> rightOfEnd;
+	for (int pointIndex = 0; pointIndex < static_cast<int>(candidates.size()); pointIndex++)
+	{
+		const Vec2& point = candidates[pointIndex];
+		if (GetSignedArea2D(start, farthest, point) < 0.f)
+		{
+			rightOfStart.push_back(point);
+		}
+		else if (GetSignedArea2D(farthest, end, point) < 0.f)
+		{
+			rightOfEnd.push_back(point);
+		}
+	}
+
+	AddQuickhullPoints(hull, rightOfStart, start, farthest);
+	hull->push_back(farthest);
+	AddQuickhullPoints(hull, rightOfEnd, farthest, end);
+}
 
 //------------------------------------------------------------------------------------------------------------------------------
 ConvexPoly2D::ConvexPoly2D()
@@ -30,3 +85,65 @@ int ConvexPoly2D::GetNumVertices()
 	return m_convexPolyPoints.size();
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC std::vector<Vec2> ConvexPoly2D::MakeConvexHullFromPoints( const std::vector<Vec2>& points )
+{
+	std::vector<Vec2> hull;
+	int numPoints = static_cast<int>(points.size());
+	if (numPoints == 0)
+	{
+		return hull;
+	}
+
+	//Leftmost and rightmost points are always on the hull
+	int leftIndex = 0;
+	int rightIndex = 0;
+	for (int pointIndex = 1; pointIndex < numPoints; pointIndex++)
+	{
+		const Vec2& point = points[pointIndex];
+		if (point.x < points[leftIndex].x || (point.x == points[leftIndex].x && point.y < points[leftIndex].y))
+		{
+			leftIndex = pointIndex;
+		}
+		if (point.x > points[rightIndex].x || (point.x == points[rightIndex].x && point.y > points[rightIndex].y))
+		{
+			rightIndex = pointIndex;
+		}
+	}
+
+	Vec2 left = points[leftIndex];
+	Vec2 right = points[rightIndex];
+	hull.push_back(left);
+	if (left == right)
+	{
+		return hull;
+	}
+
+	//Split the rest by the left -> right line. Going CCW we walk the bottom side first, which is right of right -> left
+	std::vector<Vec2> below;
+	std::vector<Vec2> above;
+	for (int pointIndex = 0; pointIndex < numPoints; pointIndex++)
+	{
+		float area = GetSignedArea2D(left, right, points[pointIndex]);
+		if (area < 0.f)
+		{
+			below.push_back(points[pointIndex]);
+		}
+		else if (area > 0.f)
+		{
+			above.push_back(points[pointIndex]);
+		}
+	}
+
+	AddQuickhullPoints(&hull, below, left, right);
+	hull.push_back(right);
+	AddQuickhullPoints(&hull, above, right, left);
+
+	return hull;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC ConvexPoly2D ConvexPoly2D::MakeConvexPolyFromPoints( const std::vector<Vec2>& points )
+{
+	return ConvexPoly2D(MakeConvexHullFromPoints(points));
+}
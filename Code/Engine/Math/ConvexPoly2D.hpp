@@ -13,6 +13,10 @@ public:
 
 	const std::vector<Vec2>&	GetConvexPoly2DPoints() const;
 	int							GetNumVertices();
+
+	//Quickhull, returns the hull of any point cloud as CCW points with no collinear points
+	static std::vector<Vec2>	MakeConvexHullFromPoints(const std::vector<Vec2>& points);
+	static ConvexPoly2D			MakeConvexPolyFromPoints(const std::vector<Vec2>& points);
 private:
 	std::vector<Vec2>	m_convexPolyPoints;
 };
\ No newline at end of file
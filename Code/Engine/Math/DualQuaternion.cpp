@@ -0,0 +1,136 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Math/DualQuaternion.hpp"
+//Engine Systems
+#include "Engine/Commons/EngineCommon.hpp"
+#include <math.h>
+
+const STATIC DualQuaternion DualQuaternion::IDENTITY(Quaternion(0.f, 0.f, 0.f, 1.f), Quaternion(0.f, 0.f, 0.f, 0.f));
+
+//------------------------------------------------------------------------------------------------------------------------------
+static inline void AddScaledQuaternion( Quaternion& sum, const Quaternion& quaternion, float scale )
+{
+	sum.x += quaternion.x * scale;
+	sum.y += quaternion.y * scale;
+	sum.z += quaternion.z * scale;
+	sum.w += quaternion.w * scale;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+DualQuaternion::DualQuaternion( const Quaternion& real, const Quaternion& dual )
+	: m_real(real)
+	, m_dual(dual)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const STATIC DualQuaternion DualQuaternion::MakeFromRotationTranslation( const Quaternion& rotation, const Vec3& translation )
+{
+	Quaternion halfTranslation(translation.x * 0.5f, translation.y * 0.5f, translation.z * 0.5f, 0.f);
+	return DualQuaternion(rotation, halfTranslation * rotation);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const STATIC DualQuaternion DualQuaternion::MakeFromMatrix( const Matrix44& matrix )
+{
+	return MakeFromRotationTranslation(Quaternion::MakeFromMatrix(matrix), matrix.GetTBasis());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const Vec3 DualQuaternion::GetTranslation() const
+{
+	Quaternion translation = m_dual * m_real.GetConjugate();
+	return Vec3(translation.x * 2.f, translation.y * 2.f, translation.z * 2.f);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const DualQuaternion DualQuaternion::GetConjugate() const
+{
+	return DualQuaternion(m_real.GetConjugate(), m_dual.GetConjugate());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const Vec3 DualQuaternion::TransformPosition( const Vec3& position ) const
+{
+	return m_real.RotateVector(position) + GetTranslation();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const Vec3 DualQuaternion::TransformVector( const Vec3& vector ) const
+{
+	return m_real.RotateVector(vector);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const Matrix44 DualQuaternion::GetMatrix() const
+{
+	return m_real.GetMatrix(GetTranslation());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Unit length real part, and a dual part orthogonal to it (what makes it a rigid transform)
+//------------------------------------------------------------------------------------------------------------------------------
+void DualQuaternion::Normalize()
+{
+	float lengthSquared = m_real.GetLengthSquared();
+	if (lengthSquared == 0.f)
+	{
+		*this = IDENTITY;
+		return;
+	}
+
+	float inverseLength = 1.f / sqrtf(lengthSquared);
+	Quaternion real(m_real.x * inverseLength, m_real.y * inverseLength, m_real.z * inverseLength, m_real.w * inverseLength);
+	Quaternion dual(m_dual.x * inverseLength, m_dual.y * inverseLength, m_dual.z * inverseLength, m_dual.w * inverseLength);
+	AddScaledQuaternion(dual, real, -GetDotProduct(real, dual));
+
+	m_real = real;
+	m_dual = dual;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const DualQuaternion DualQuaternion::operator*( const DualQuaternion& transformToApplyFirst ) const
+{
+	Quaternion real = m_real * transformToApplyFirst.m_real;
+	Quaternion dual = m_real * transformToApplyFirst.m_dual;
+	AddScaledQuaternion(dual, m_dual * transformToApplyFirst.m_real, 1.f);
+
+	return DualQuaternion(real, dual);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const DualQuaternion Lerp( const DualQuaternion& transformA, const DualQuaternion& transformB, float t )
+{
+	const DualQuaternion transforms[2] = { transformA, transformB };
+	const float weights[2] = { 1.f - t, t };
+	return Blend(transforms, weights, 2);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const DualQuaternion Blend( const DualQuaternion* transforms, const float* weights, int count )
+{
+	if (count <= 0)
+	{
+		return DualQuaternion::IDENTITY;
+	}
+
+	DualQuaternion result(Quaternion(0.f, 0.f, 0.f, 0.f), Quaternion(0.f, 0.f, 0.f, 0.f));
+	const Quaternion& pivot = transforms[0].m_real;
+
+	for (int transformIndex = 0; transformIndex < count; transformIndex++)
+	{
+		const DualQuaternion& transform = transforms[transformIndex];
+
+		//q and -q are the same transform, keep everything on the pivot's side so the sum does not cancel out
+		float weight = weights[transformIndex];
+		if (GetDotProduct(pivot, transform.m_real) < 0.f)
+		{
+			weight = -weight;
+		}
+
+		AddScaledQuaternion(result.m_real, transform.m_real, weight);
+		AddScaledQuaternion(result.m_dual, transform.m_dual, weight);
+	}
+
+	result.Normalize();
+	return result;
+}
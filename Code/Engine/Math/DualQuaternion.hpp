@@ -0,0 +1,49 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+//Engine Systems
+#include "Engine/Math/Quaternion.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Rigid transform (rotation + translation) as a dual quaternion: m_real is the rotation, m_dual is 0.5 * t * m_real.
+//
+// Composes like Quaternion (a * b is b followed by a, same as the matrices) and blends without the shearing or
+// shrinking you get when lerping matrices, so it is the one to use for skinning and for blending poses.
+//------------------------------------------------------------------------------------------------------------------------------
+struct DualQuaternion
+{
+public:
+	DualQuaternion() = default;
+	explicit DualQuaternion( const Quaternion& real, const Quaternion& dual );
+
+	//Statics
+	const static DualQuaternion		IDENTITY;
+
+	static const DualQuaternion		MakeFromRotationTranslation( const Quaternion& rotation, const Vec3& translation );
+	static const DualQuaternion		MakeFromMatrix( const Matrix44& matrix );						// must be rigid (orthonormal rotation)
+
+	//Access Methods
+	inline const Quaternion&		GetRotation() const			{ return m_real; }
+	const Vec3						GetTranslation() const;
+	const DualQuaternion			GetConjugate() const;										// inverse for unit dual quaternions
+
+	const Vec3						TransformPosition( const Vec3& position ) const;
+	const Vec3						TransformVector( const Vec3& vector ) const;
+	const Matrix44					GetMatrix() const;
+
+	//Mutator methods
+	void							Normalize();
+
+	// Operators
+	const DualQuaternion			operator*( const DualQuaternion& transformToApplyFirst ) const;
+
+public:
+	Quaternion						m_real = Quaternion(0.f, 0.f, 0.f, 1.f);
+	Quaternion						m_dual = Quaternion(0.f, 0.f, 0.f, 0.f);
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Dual quaternion linear blending: weighted sum (each flipped onto the first transform's side) then normalized.
+// Blend is the weighted version for skinning, weights do not need to add up to 1.
+//------------------------------------------------------------------------------------------------------------------------------
+const DualQuaternion		Lerp( const DualQuaternion& transformA, const DualQuaternion& transformB, float t );
+const DualQuaternion		Blend( const DualQuaternion* transforms, const float* weights, int count );
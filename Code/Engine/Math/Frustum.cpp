@@ -44,3 +44,67 @@ void Frustum::MakeFromAABB3(AABB3* box)
 
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+bool Frustum::IsSphereVisible(const Vec3& center, float radius) const
+{
+	for (int planeIndex = 0; planeIndex < FRUSTUM_SIDE_COUNT; planeIndex++)
+	{
+		float distance = GetDotProduct(m_planes[planeIndex].m_normal, center) - m_planes[planeIndex].m_signedDistance;
+		if (distance > radius)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool Frustum::IsAABB3Visible(const Vec3& mins, const Vec3& maxs) const
+{
+	return ClassifyAABB3(mins, maxs) != FRUSTUM_CULL_OUTSIDE;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+eFrustumCullResult Frustum::ClassifyAABB3(const Vec3& mins, const Vec3& maxs, uint planeMask, uint* outPlaneMask) const
+{
+	Vec3 center = (mins + maxs) * 0.5f;
+	Vec3 halfExtents = (maxs - mins) * 0.5f;
+
+	eFrustumCullResult result = FRUSTUM_CULL_INSIDE;
+	for (int planeIndex = 0; planeIndex < FRUSTUM_SIDE_COUNT; planeIndex++)
+	{
+		uint planeBit = 1U << planeIndex;
+		if ((planeMask & planeBit) == 0U)
+		{
+			continue;
+		}
+
+		//Distance of the center and how far the box reaches along the plane normal
+		const Plane3D& plane = m_planes[planeIndex];
+		float distance = GetDotProduct(plane.m_normal, center) - plane.m_signedDistance;
+		float reach = fabsf(plane.m_normal.x) * halfExtents.x + fabsf(plane.m_normal.y) * halfExtents.y + fabsf(plane.m_normal.z) * halfExtents.z;
+
+		if (distance > reach)
+		{
+			result = FRUSTUM_CULL_OUTSIDE;
+			break;
+		}
+
+		if (distance > -reach)
+		{
+			result = FRUSTUM_CULL_INTERSECTS;
+		}
+		else
+		{
+			planeMask &= ~planeBit;
+		}
+	}
+
+	if (outPlaneMask != nullptr)
+	{
+		*outPlaneMask = planeMask;
+	}
+
+	return result;
+}
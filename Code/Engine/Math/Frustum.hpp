@@ -3,6 +3,8 @@
 #include "Engine/Math/Vec3.hpp"
 #include "Engine/Math/Plane3D.hpp"
 
+typedef unsigned int uint;
+
 //------------------------------------------------------------------------------------------------------------------------------
 enum eFrustumFace 
 {
@@ -16,6 +18,14 @@ enum eFrustumFace
 	FRUSTUM_SIDE_COUNT,
 };
 
+//------------------------------------------------------------------------------------------------------------------------------
+enum eFrustumCullResult
+{
+	FRUSTUM_CULL_OUTSIDE = 0,
+	FRUSTUM_CULL_INTERSECTS,
+	FRUSTUM_CULL_INSIDE
+};
+
 //------------------------------------------------------------------------------------------------------------------------------
 struct Frustum
 {
@@ -23,6 +33,16 @@ public:
 	bool ContainsPoint(const Vec3& pos) const;
 	void MakeFromAABB3(AABB3* box);
 
+	//Planes face out, so anything further in front of a plane than its radius (or projected half size) is culled
+	bool				IsSphereVisible(const Vec3& center, float radius) const;
+	bool				IsAABB3Visible(const Vec3& mins, const Vec3& maxs) const;
+
+	//Only tests the planes whose bit is set in planeMask. Planes the box is fully behind are cleared from outPlaneMask
+	//so children of a box can skip them
+	eFrustumCullResult	ClassifyAABB3(const Vec3& mins, const Vec3& maxs, uint planeMask = ALL_PLANES_MASK, uint* outPlaneMask = nullptr) const;
+
+	static constexpr uint ALL_PLANES_MASK = (1U << FRUSTUM_SIDE_COUNT) - 1U;
+
 public:
 	Plane3D m_planes[FRUSTUM_SIDE_COUNT];
 };
\ No newline at end of file
@@ -0,0 +1,403 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Math/FrustumCulling.hpp"
+//Engine Systems
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <algorithm>
+
+//Bounds are in component arrays, so 4 consecutive objects load straight into one register per component
+#if !defined(ENGINE_DISABLE_SIMD) && (defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__))
+#define FRUSTUM_CULLING_USE_SSE
+#include <xmmintrin.h>
+#endif
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Frustum planes split into components, with the absolute normal for projecting box half extents
+//------------------------------------------------------------------------------------------------------------------------------
+struct CullingPlanes
+{
+	float			m_normalX[FRUSTUM_SIDE_COUNT];
+	float			m_normalY[FRUSTUM_SIDE_COUNT];
+	float			m_normalZ[FRUSTUM_SIDE_COUNT];
+	float			m_absNormalX[FRUSTUM_SIDE_COUNT];
+	float			m_absNormalY[FRUSTUM_SIDE_COUNT];
+	float			m_absNormalZ[FRUSTUM_SIDE_COUNT];
+	float			m_distance[FRUSTUM_SIDE_COUNT];
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void MakeCullingPlanes( CullingPlanes* out, const Frustum& frustum )
+{
+	for (int planeIndex = 0; planeIndex < FRUSTUM_SIDE_COUNT; planeIndex++)
+	{
+		const Plane3D& plane = frustum.m_planes[planeIndex];
+		out->m_normalX[planeIndex] = plane.m_normal.x;
+		out->m_normalY[planeIndex] = plane.m_normal.y;
+		out->m_normalZ[planeIndex] = plane.m_normal.z;
+		out->m_absNormalX[planeIndex] = fabsf(plane.m_normal.x);
+		out->m_absNormalY[planeIndex] = fabsf(plane.m_normal.y);
+		out->m_absNormalZ[planeIndex] = fabsf(plane.m_normal.z);
+		out->m_distance[planeIndex] = plane.m_signedDistance;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Same math as the SSE loop, used for the entries that do not fill a register
+//------------------------------------------------------------------------------------------------------------------------------
+static bool IsBoundsOutside( const CullingPlanes& planes, const PackedBounds3& bounds, int index, bool testBoxes )
+{
+	for (int planeIndex = 0; planeIndex < FRUSTUM_SIDE_COUNT; planeIndex++)
+	{
+		float distance = planes.m_normalX[planeIndex] * bounds.m_centerX[index] + planes.m_normalY[planeIndex] * bounds.m_centerY[index] + planes.m_normalZ[planeIndex] * bounds.m_centerZ[index];
+		distance -= planes.m_distance[planeIndex];
+
+		float reach;
+		if (testBoxes)
+		{
+			reach = planes.m_absNormalX[planeIndex] * bounds.m_halfExtentX[index] + planes.m_absNormalY[planeIndex] * bounds.m_halfExtentY[index] + planes.m_absNormalZ[planeIndex] * bounds.m_halfExtentZ[index];
+		}
+		else
+		{
+			reach = bounds.m_radius[index];
+		}
+
+		if (distance > reach)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void CullBounds( std::vector<int>* outVisible, const Frustum& frustum, const PackedBounds3& bounds, int startIndex, int endIndex, bool testBoxes )
+{
+	if (endIndex < 0)
+	{
+		endIndex = bounds.GetCount();
+	}
+
+	CullingPlanes planes;
+	MakeCullingPlanes(&planes, frustum);
+
+	int index = startIndex;
+
+#if defined(FRUSTUM_CULLING_USE_SSE)
+	for (; index + 4 <= endIndex; index += 4)
+	{
+		__m128 centerX = _mm_loadu_ps(&bounds.m_centerX[index]);
+		__m128 centerY = _mm_loadu_ps(&bounds.m_centerY[index]);
+		__m128 centerZ = _mm_loadu_ps(&bounds.m_centerZ[index]);
+		__m128 halfExtentX = _mm_loadu_ps(&bounds.m_halfExtentX[index]);
+		__m128 halfExtentY = _mm_loadu_ps(&bounds.m_halfExtentY[index]);
+		__m128 halfExtentZ = _mm_loadu_ps(&bounds.m_halfExtentZ[index]);
+		__m128 radius = _mm_loadu_ps(&bounds.m_radius[index]);
+
+		__m128 outside = _mm_setzero_ps();
+		for (int planeIndex = 0; planeIndex < FRUSTUM_SIDE_COUNT; planeIndex++)
+		{
+			__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.m_normalX[planeIndex]), centerX), _mm_mul_ps(_mm_set1_ps(planes.m_normalY[planeIndex]), centerY)), _mm_mul_ps(_mm_set1_ps(planes.m_normalZ[planeIndex]), centerZ));
+			distance = _mm_sub_ps(distance, _mm_set1_ps(planes.m_distance[planeIndex]));
+
+			__m128 reach;
+			if (testBoxes)
+			{
+				reach = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.m_absNormalX[planeIndex]), halfExtentX), _mm_mul_ps(_mm_set1_ps(planes.m_absNormalY[planeIndex]), halfExtentY)), _mm_mul_ps(_mm_set1_ps(planes.m_absNormalZ[planeIndex]), halfExtentZ));
+			}
+			else
+			{
+				reach = radius;
+			}
+
+			outside = _mm_or_ps(outside, _mm_cmpgt_ps(distance, reach));
+		}
+
+		int outsideMask = _mm_movemask_ps(outside);
+		if (outsideMask == 0xF)
+		{
+			continue;
+		}
+
+		for (int laneIndex = 0; laneIndex < 4; laneIndex++)
+		{
+			if ((outsideMask & (1 << laneIndex)) == 0)
+			{
+				outVisible->push_back(index + laneIndex);
+			}
+		}
+	}
+#endif
+
+	for (; index < endIndex; index++)
+	{
+		if (!IsBoundsOutside(planes, bounds, index, testBoxes))
+		{
+			outVisible->push_back(index);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CullSpheres( std::vector<int>* outVisible, const Frustum& frustum, const PackedBounds3& bounds, int startIndex, int endIndex )
+{
+	CullBounds(outVisible, frustum, bounds, startIndex, endIndex, false);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CullAABB3s( std::vector<int>* outVisible, const Frustum& frustum, const PackedBounds3& bounds, int startIndex, int endIndex )
+{
+	CullBounds(outVisible, frustum, bounds, startIndex, endIndex, true);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int PackedBounds3::AddBounds( const Vec3& mins, const Vec3& maxs )
+{
+	int index = GetCount();
+
+	m_centerX.push_back(0.f);
+	m_centerY.push_back(0.f);
+	m_centerZ.push_back(0.f);
+	m_halfExtentX.push_back(0.f);
+	m_halfExtentY.push_back(0.f);
+	m_halfExtentZ.push_back(0.f);
+	m_radius.push_back(0.f);
+
+	SetBounds(index, mins, maxs);
+	return index;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int PackedBounds3::AddSphere( const Vec3& center, float radius )
+{
+	int index = AddBounds(center - Vec3(radius, radius, radius), center + Vec3(radius, radius, radius));
+
+	//Keep the exact radius rather than the one around the box
+	m_radius[index] = radius;
+	return index;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PackedBounds3::SetBounds( int index, const Vec3& mins, const Vec3& maxs )
+{
+	Vec3 halfExtents = (maxs - mins) * 0.5f;
+
+	m_centerX[index] = (mins.x + maxs.x) * 0.5f;
+	m_centerY[index] = (mins.y + maxs.y) * 0.5f;
+	m_centerZ[index] = (mins.z + maxs.z) * 0.5f;
+	m_halfExtentX[index] = halfExtents.x;
+	m_halfExtentY[index] = halfExtents.y;
+	m_halfExtentZ[index] = halfExtents.z;
+	m_radius[index] = halfExtents.GetLength();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PackedBounds3::Reserve( int numBounds )
+{
+	m_centerX.reserve(numBounds);
+	m_centerY.reserve(numBounds);
+	m_centerZ.reserve(numBounds);
+	m_halfExtentX.reserve(numBounds);
+	m_halfExtentY.reserve(numBounds);
+	m_halfExtentZ.reserve(numBounds);
+	m_radius.reserve(numBounds);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PackedBounds3::Clear()
+{
+	m_centerX.clear();
+	m_centerY.clear();
+	m_centerZ.clear();
+	m_halfExtentX.clear();
+	m_halfExtentY.clear();
+	m_halfExtentZ.clear();
+	m_radius.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Vec3 PackedBounds3::GetMins( int index ) const
+{
+	return Vec3(m_centerX[index] - m_halfExtentX[index], m_centerY[index] - m_halfExtentY[index], m_centerZ[index] - m_halfExtentZ[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Vec3 PackedBounds3::GetMaxs( int index ) const
+{
+	return Vec3(m_centerX[index] + m_halfExtentX[index], m_centerY[index] + m_halfExtentY[index], m_centerZ[index] + m_halfExtentZ[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Vec3 PackedBounds3::GetCenter( int index ) const
+{
+	return Vec3(m_centerX[index], m_centerY[index], m_centerZ[index]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+CullingBVH::CullingBVH()
+{
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+CullingBVH::~CullingBVH()
+{
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CullingBVH::Clear()
+{
+	m_nodes.clear();
+	m_items.Clear();
+	m_itemIds.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CullingBVH::Build( const PackedBounds3& bounds, int maxItemsPerLeaf )
+{
+	Clear();
+
+	int numItems = bounds.GetCount();
+	if (numItems == 0)
+	{
+		return;
+	}
+
+	m_maxItemsPerLeaf = (maxItemsPerLeaf < 1) ? 1 : maxItemsPerLeaf;
+
+	std::vector<int> order;
+	order.resize(numItems);
+	for (int itemIndex = 0; itemIndex < numItems; itemIndex++)
+	{
+		order[itemIndex] = itemIndex;
+	}
+
+	m_nodes.reserve(2 * (numItems / m_maxItemsPerLeaf) + 1);
+	m_nodes.push_back(Node());
+	BuildNode(0, 0, numItems, order, bounds);
+
+	//Copy the bounds into leaf order so each leaf is a contiguous run for CullAABB3s
+	m_items.Reserve(numItems);
+	m_itemIds = order;
+	for (int itemIndex = 0; itemIndex < numItems; itemIndex++)
+	{
+		m_items.AddBounds(bounds.GetMins(order[itemIndex]), bounds.GetMaxs(order[itemIndex]));
+		m_items.m_radius[itemIndex] = bounds.m_radius[order[itemIndex]];
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CullingBVH::BuildNode( int nodeIndex, int firstItem, int numItems, std::vector<int>& order, const PackedBounds3& bounds )
+{
+	Vec3 mins = bounds.GetMins(order[firstItem]);
+	Vec3 maxs = bounds.GetMaxs(order[firstItem]);
+	Vec3 centerMins = bounds.GetCenter(order[firstItem]);
+	Vec3 centerMaxs = centerMins;
+
+	for (int itemIndex = firstItem + 1; itemIndex < firstItem + numItems; itemIndex++)
+	{
+		mins = Vec3::GetComponentMin(mins, bounds.GetMins(order[itemIndex]));
+		maxs = Vec3::GetComponentMax(maxs, bounds.GetMaxs(order[itemIndex]));
+
+		Vec3 center = bounds.GetCenter(order[itemIndex]);
+		centerMins = Vec3::GetComponentMin(centerMins, center);
+		centerMaxs = Vec3::GetComponentMax(centerMaxs, center);
+	}
+
+	m_nodes[nodeIndex].m_mins = mins;
+	m_nodes[nodeIndex].m_maxs = maxs;
+	m_nodes[nodeIndex].m_firstItem = firstItem;
+	m_nodes[nodeIndex].m_numItems = numItems;
+	m_nodes[nodeIndex].m_leftChild = -1;
+
+	if (numItems <= m_maxItemsPerLeaf)
+	{
+		return;
+	}
+
+	//Split the longest axis of the centers at the median
+	Vec3 centerSize = centerMaxs - centerMins;
+	const std::vector<float>* axisCenters = &bounds.m_centerX;
+	if (centerSize.y > centerSize.x && centerSize.y >= centerSize.z)
+	{
+		axisCenters = &bounds.m_centerY;
+	}
+	else if (centerSize.z > centerSize.x && centerSize.z > centerSize.y)
+	{
+		axisCenters = &bounds.m_centerZ;
+	}
+
+	int numLeft = numItems / 2;
+	std::vector<int>::iterator first = order.begin() + firstItem;
+	std::nth_element(first, first + numLeft, first + numItems, [axisCenters](int a, int b) { return (*axisCenters)[a] < (*axisCenters)[b]; });
+
+	//Push both children together so the right child is always next to the left
+	int leftChild = static_cast<int>(m_nodes.size());
+	m_nodes.push_back(Node());
+	m_nodes.push_back(Node());
+	m_nodes[nodeIndex].m_leftChild = leftChild;
+
+	BuildNode(leftChild, firstItem, numLeft, order, bounds);
+	BuildNode(leftChild + 1, firstItem + numLeft, numItems - numLeft, order, bounds);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CullingBVH::CullFrustum( std::vector<int>* outVisible, const Frustum& frustum ) const
+{
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	//Median splits keep the depth at log2 of the item count, this covers any tree we can build
+	constexpr int MAX_STACK_SIZE = 64;
+	int nodeStack[MAX_STACK_SIZE];
+	uint maskStack[MAX_STACK_SIZE];
+	int stackSize = 0;
+
+	nodeStack[stackSize] = 0;
+	maskStack[stackSize] = Frustum::ALL_PLANES_MASK;
+	stackSize++;
+
+	while (stackSize > 0)
+	{
+		stackSize--;
+		const Node& node = m_nodes[nodeStack[stackSize]];
+		uint planeMask = maskStack[stackSize];
+
+		eFrustumCullResult result = frustum.ClassifyAABB3(node.m_mins, node.m_maxs, planeMask, &planeMask);
+		if (result == FRUSTUM_CULL_OUTSIDE)
+		{
+			continue;
+		}
+
+		if (result == FRUSTUM_CULL_INSIDE || planeMask == 0U)
+		{
+			//Whole subtree is visible, its items are one contiguous run
+			outVisible->insert(outVisible->end(), m_itemIds.begin() + node.m_firstItem, m_itemIds.begin() + node.m_firstItem + node.m_numItems);
+			continue;
+		}
+
+		if (node.m_leftChild < 0)
+		{
+			int numBefore = static_cast<int>(outVisible->size());
+			CullAABB3s(outVisible, frustum, m_items, node.m_firstItem, node.m_firstItem + node.m_numItems);
+
+			int numAfter = static_cast<int>(outVisible->size());
+			for (int visibleIndex = numBefore; visibleIndex < numAfter; visibleIndex++)
+			{
+				(*outVisible)[visibleIndex] = m_itemIds[(*outVisible)[visibleIndex]];
+			}
+			continue;
+		}
+
+		nodeStack[stackSize] = node.m_leftChild + 1;
+		maskStack[stackSize] = planeMask;
+		stackSize++;
+
+		nodeStack[stackSize] = node.m_leftChild;
+		maskStack[stackSize] = planeMask;
+		stackSize++;
+	}
+}
@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+//Engine Systems
+#include "Engine/Math/Vec3.hpp"
+#include <vector>
+
+struct Frustum;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Bounds stored as separate arrays per component so the culling loops can test 4 objects per SSE register.
+// Every entry is an AABB3 (center and half extents) plus the radius of the sphere around it.
+//------------------------------------------------------------------------------------------------------------------------------
+class PackedBounds3
+{
+public:
+	int							AddBounds(const Vec3& mins, const Vec3& maxs);
+	int							AddSphere(const Vec3& center, float radius);
+	void						SetBounds(int index, const Vec3& mins, const Vec3& maxs);
+
+	void						Reserve(int numBounds);
+	void						Clear();
+
+	inline int					GetCount() const				{ return static_cast<int>(m_centerX.size()); }
+	Vec3						GetMins(int index) const;
+	Vec3						GetMaxs(int index) const;
+	Vec3						GetCenter(int index) const;
+
+public:
+	std::vector<float>			m_centerX;
+	std::vector<float>			m_centerY;
+	std::vector<float>			m_centerZ;
+	std::vector<float>			m_halfExtentX;
+	std::vector<float>			m_halfExtentY;
+	std::vector<float>			m_halfExtentZ;
+	std::vector<float>			m_radius;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Append the index of every entry in [startIndex, endIndex) that is not fully outside the frustum, in order.
+// endIndex < 0 means up to the end of the bounds.
+//------------------------------------------------------------------------------------------------------------------------------
+void	CullSpheres(std::vector<int>* outVisible, const Frustum& frustum, const PackedBounds3& bounds, int startIndex = 0, int endIndex = -1);
+void	CullAABB3s(std::vector<int>* outVisible, const Frustum& frustum, const PackedBounds3& bounds, int startIndex = 0, int endIndex = -1);
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Bounding volume hierarchy over static bounds for frustum queries
+//
+// Built top down by splitting the longest axis of the centers at the median. Items are reordered so every node covers a
+// contiguous range, which lets a node that is fully inside the frustum add all of its items without testing them. Planes a
+// node is fully behind are dropped for its children, and leaves test their items 4 at a time with CullAABB3s.
+//------------------------------------------------------------------------------------------------------------------------------
+class CullingBVH
+{
+public:
+	CullingBVH();
+	~CullingBVH();
+
+	//Item ids in query results are indices into the bounds passed to Build
+	void						Build(const PackedBounds3& bounds, int maxItemsPerLeaf = 4);
+	void						Clear();
+
+	void						CullFrustum(std::vector<int>* outVisible, const Frustum& frustum) const;
+
+	inline int					GetNumNodes() const				{ return static_cast<int>(m_nodes.size()); }
+	inline int					GetNumItems() const				{ return m_items.GetCount(); }
+
+private:
+	struct Node
+	{
+		Vec3					m_mins;
+		Vec3					m_maxs;
+		int						m_firstItem = 0;
+		int						m_numItems = 0;
+		int						m_leftChild = -1;		//right child is always m_leftChild + 1, -1 for leaves
+	};
+
+	void						BuildNode(int nodeIndex, int firstItem, int numItems, std::vector<int>& order, const PackedBounds3& bounds);
+
+private:
+	std::vector<Node>			m_nodes;
+	PackedBounds3				m_items;				//bounds in leaf order
+	std::vector<int>			m_itemIds;				//leaf order to the index passed to Build
+	int							m_maxItemsPerLeaf = 4;
+};
@@ -0,0 +1,672 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Math/GJK2D.hpp"
+//Engine Systems
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Capsule2D.hpp"
+#include "Engine/Math/Collider2D.hpp"
+#include "Engine/Math/ConvexPoly2D.hpp"
+#include "Engine/Math/Disc2D.hpp"
+#include "Engine/Math/OBB2.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr int			GJK_MAX_ITERATIONS = 32;
+constexpr int			EPA_MAX_ITERATIONS = 32;
+constexpr int			EPA_MAX_POLYTOPE_SIZE = EPA_MAX_ITERATIONS + 3;
+constexpr float			GJK_TOLERANCE = 1e-5f;				// core distances under this are treated as touching
+constexpr float			EPA_TOLERANCE = 1e-4f;				// stop expanding once the polytope is this close to the real boundary
+
+//------------------------------------------------------------------------------------------------------------------------------
+static inline float Dot2D( const Vec2& a, const Vec2& b )
+{
+	return a.x * b.x + a.y * b.y;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static inline float Cross2D( const Vec2& a, const Vec2& b )
+{
+	return a.x * b.y - a.y * b.x;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// A point on the Minkowski difference of the 2 cores (A - B) and the core points it came from
+//------------------------------------------------------------------------------------------------------------------------------
+struct GJKVertex2D
+{
+	Vec2					m_pointA;
+	Vec2					m_pointB;
+	Vec2					m_point;
+	float					m_weight = 1.f;					// barycentric weight of the closest point
+	int						m_indexA = 0;
+	int						m_indexB = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct GJKSimplex2D
+{
+	void					SetVertex(int vertexIndex, const ConvexSupport2D& shapeA, int indexA, const ConvexSupport2D& shapeB, int indexB);
+
+	void					Solve2();
+	void					Solve3();
+
+	Vec2					GetClosestPoint() const;
+	Vec2					GetSearchDirection() const;
+	void					GetWitnessPoints(Vec2* outPointA, Vec2* outPointB) const;
+
+	GJKVertex2D				m_vertices[3];
+	int						m_count = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+ConvexSupport2D::ConvexSupport2D( const Vec2* points, int numPoints, float radius )
+	: m_externalPoints(points)
+	, m_numPoints(numPoints)
+	, m_radius(radius)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+ConvexSupport2D::ConvexSupport2D( const AABB2& box )
+{
+	SetInlinePoint(0, box.m_minBounds);
+	SetInlinePoint(1, Vec2(box.m_maxBounds.x, box.m_minBounds.y));
+	SetInlinePoint(2, box.m_maxBounds);
+	SetInlinePoint(3, Vec2(box.m_minBounds.x, box.m_maxBounds.y));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+ConvexSupport2D::ConvexSupport2D( const Disc2D& disc )
+{
+	SetInlinePoint(0, disc.GetCentre());
+	m_radius = disc.GetRadius();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+ConvexSupport2D::ConvexSupport2D( const OBB2& box, float radius )
+{
+	box.GetCorners(m_inlinePoints);
+	m_numPoints = 4;
+	m_radius = radius;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+ConvexSupport2D::ConvexSupport2D( const Capsule2D& capsule )
+{
+	SetInlinePoint(0, capsule.GetStart());
+	SetInlinePoint(1, capsule.GetEnd());
+	m_radius = capsule.m_radius;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+ConvexSupport2D::ConvexSupport2D( const ConvexPoly2D& polygon )
+{
+	const std::vector<Vec2>& points = polygon.GetConvexPoly2DPoints();
+	m_externalPoints = points.data();
+	m_numPoints = static_cast<int>(points.size());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ConvexSupport2D::SetInlinePoint( int index, const Vec2& point )
+{
+	m_inlinePoints[index] = point;
+	if (index >= m_numPoints)
+	{
+		m_numPoints = index + 1;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int ConvexSupport2D::GetSupportIndex( const Vec2& direction ) const
+{
+	const Vec2* points = GetPoints();
+
+	int bestIndex = 0;
+	float bestDot = Dot2D(points[0], direction);
+	for (int pointIndex = 1; pointIndex < m_numPoints; pointIndex++)
+	{
+		float dot = Dot2D(points[pointIndex], direction);
+		if (dot > bestDot)
+		{
+			bestDot = dot;
+			bestIndex = pointIndex;
+		}
+	}
+
+	return bestIndex;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Vec2 ConvexSupport2D::GetSupportPoint( const Vec2& direction ) const
+{
+	Vec2 point = GetPoints()[GetSupportIndex(direction)];
+	if (m_radius > 0.f)
+	{
+		point += direction.GetNormalized() * m_radius;
+	}
+
+	return point;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Vec2 ConvexSupport2D::GetCenter() const
+{
+	const Vec2* points = GetPoints();
+
+	Vec2 center = Vec2::ZERO;
+	for (int pointIndex = 0; pointIndex < m_numPoints; pointIndex++)
+	{
+		center += points[pointIndex];
+	}
+
+	return (m_numPoints > 0) ? center / static_cast<float>(m_numPoints) : center;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void GJKSimplex2D::SetVertex( int vertexIndex, const ConvexSupport2D& shapeA, int indexA, const ConvexSupport2D& shapeB, int indexB )
+{
+	GJKVertex2D& vertex = m_vertices[vertexIndex];
+	vertex.m_indexA = indexA;
+	vertex.m_indexB = indexB;
+	vertex.m_pointA = shapeA.GetPoints()[indexA];
+	vertex.m_pointB = shapeB.GetPoints()[indexB];
+	vertex.m_point = vertex.m_pointA - vertex.m_pointB;
+	vertex.m_weight = 1.f;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Closest point to the origin on the segment, drops the vertex that does not contribute
+//------------------------------------------------------------------------------------------------------------------------------
+void GJKSimplex2D::Solve2()
+{
+	Vec2 w1 = m_vertices[0].m_point;
+	Vec2 w2 = m_vertices[1].m_point;
+	Vec2 e12 = w2 - w1;
+
+	//Region of w1
+	float d12_2 = -Dot2D(w1, e12);
+	if (d12_2 <= 0.f)
+	{
+		m_vertices[0].m_weight = 1.f;
+		m_count = 1;
+		return;
+	}
+
+	//Region of w2
+	float d12_1 = Dot2D(w2, e12);
+	if (d12_1 <= 0.f)
+	{
+		m_vertices[1].m_weight = 1.f;
+		m_vertices[0] = m_vertices[1];
+		m_count = 1;
+		return;
+	}
+
+	//Region of the edge
+	float inverseSum = 1.f / (d12_1 + d12_2);
+	m_vertices[0].m_weight = d12_1 * inverseSum;
+	m_vertices[1].m_weight = d12_2 * inverseSum;
+	m_count = 2;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Closest point to the origin on the triangle using barycentric regions, keeps the smallest feature containing it
+//------------------------------------------------------------------------------------------------------------------------------
+void GJKSimplex2D::Solve3()
+{
+	Vec2 w1 = m_vertices[0].m_point;
+	Vec2 w2 = m_vertices[1].m_point;
+	Vec2 w3 = m_vertices[2].m_point;
+
+	Vec2 e12 = w2 - w1;
+	float d12_1 = Dot2D(w2, e12);
+	float d12_2 = -Dot2D(w1, e12);
+
+	Vec2 e13 = w3 - w1;
+	float d13_1 = Dot2D(w3, e13);
+	float d13_2 = -Dot2D(w1, e13);
+
+	Vec2 e23 = w3 - w2;
+	float d23_1 = Dot2D(w3, e23);
+	float d23_2 = -Dot2D(w2, e23);
+
+	float n123 = Cross2D(e12, e13);
+	float d123_1 = n123 * Cross2D(w2, w3);
+	float d123_2 = n123 * Cross2D(w3, w1);
+	float d123_3 = n123 * Cross2D(w1, w2);
+
+	//w1 region
+	if (d12_2 <= 0.f && d13_2 <= 0.f)
+	{
+		m_vertices[0].m_weight = 1.f;
+		m_count = 1;
+		return;
+	}
+
+	//e12 region
+	if (d12_1 > 0.f && d12_2 > 0.f && d123_3 <= 0.f)
+	{
+		float inverseSum = 1.f / (d12_1 + d12_2);
+		m_vertices[0].m_weight = d12_1 * inverseSum;
+		m_vertices[1].m_weight = d12_2 * inverseSum;
+		m_count = 2;
+		return;
+	}
+
+	//e13 region
+	if (d13_1 > 0.f && d13_2 > 0.f && d123_2 <= 0.f)
+	{
+		float inverseSum = 1.f / (d13_1 + d13_2);
+		m_vertices[0].m_weight = d13_1 * inverseSum;
+		m_vertices[2].m_weight = d13_2 * inverseSum;
+		m_vertices[1] = m_vertices[2];
+		m_count = 2;
+		return;
+	}
+
+	//w2 region
+	if (d12_1 <= 0.f && d23_2 <= 0.f)
+	{
+		m_vertices[1].m_weight = 1.f;
+		m_vertices[0] = m_vertices[1];
+		m_count = 1;
+		return;
+	}
+
+	//w3 region
+	if (d13_1 <= 0.f && d23_1 <= 0.f)
+	{
+		m_vertices[2].m_weight = 1.f;
+		m_vertices[0] = m_vertices[2];
+		m_count = 1;
+		return;
+	}
+
+	//e23 region
+	if (d23_1 > 0.f && d23_2 > 0.f && d123_1 <= 0.f)
+	{
+		float inverseSum = 1.f / (d23_1 + d23_2);
+		m_vertices[1].m_weight = d23_1 * inverseSum;
+		m_vertices[2].m_weight = d23_2 * inverseSum;
+		m_vertices[0] = m_vertices[2];
+		m_count = 2;
+		return;
+	}
+
+	//Origin is inside the triangle
+	float inverseSum = 1.f / (d123_1 + d123_2 + d123_3);
+	m_vertices[0].m_weight = d123_1 * inverseSum;
+	m_vertices[1].m_weight = d123_2 * inverseSum;
+	m_vertices[2].m_weight = d123_3 * inverseSum;
+	m_count = 3;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Vec2 GJKSimplex2D::GetClosestPoint() const
+{
+	switch (m_count)
+	{
+	case 1:
+		return m_vertices[0].m_point;
+	case 2:
+		return m_vertices[0].m_point * m_vertices[0].m_weight + m_vertices[1].m_point * m_vertices[1].m_weight;
+	default:
+		return Vec2::ZERO;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Vec2 GJKSimplex2D::GetSearchDirection() const
+{
+	if (m_count == 1)
+	{
+		return m_vertices[0].m_point * -1.f;
+	}
+
+	//Perpendicular of the edge on the origin's side, more accurate than negating the closest point
+	Vec2 e12 = m_vertices[1].m_point - m_vertices[0].m_point;
+	if (Cross2D(e12, m_vertices[0].m_point * -1.f) > 0.f)
+	{
+		return e12.GetRotated90Degrees();
+	}
+	else
+	{
+		return e12.GetRotatedMinus90Degrees();
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void GJKSimplex2D::GetWitnessPoints( Vec2* outPointA, Vec2* outPointB ) const
+{
+	Vec2 pointA = Vec2::ZERO;
+	Vec2 pointB = Vec2::ZERO;
+	for (int vertexIndex = 0; vertexIndex < m_count; vertexIndex++)
+	{
+		pointA += m_vertices[vertexIndex].m_pointA * m_vertices[vertexIndex].m_weight;
+		pointB += m_vertices[vertexIndex].m_pointB * m_vertices[vertexIndex].m_weight;
+	}
+
+	*outPointA = pointA;
+	*outPointB = pointB;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// GJK on the cores (radii ignored), returns the number of iterations. The simplex is left holding the closest feature,
+// or the triangle around the origin when the cores overlap.
+//------------------------------------------------------------------------------------------------------------------------------
+static int RunGJK( GJKSimplex2D* simplex, const ConvexSupport2D& shapeA, const ConvexSupport2D& shapeB )
+{
+	simplex->SetVertex(0, shapeA, 0, shapeB, 0);
+	simplex->m_count = 1;
+
+	int iteration = 0;
+	while (iteration < GJK_MAX_ITERATIONS)
+	{
+		//Remember the vertices so we can catch the search cycling back to one of them
+		int savedCount = simplex->m_count;
+		int savedIndexA[3];
+		int savedIndexB[3];
+		for (int vertexIndex = 0; vertexIndex < savedCount; vertexIndex++)
+		{
+			savedIndexA[vertexIndex] = simplex->m_vertices[vertexIndex].m_indexA;
+			savedIndexB[vertexIndex] = simplex->m_vertices[vertexIndex].m_indexB;
+		}
+
+		if (simplex->m_count == 2)
+		{
+			simplex->Solve2();
+		}
+		else if (simplex->m_count == 3)
+		{
+			simplex->Solve3();
+		}
+
+		if (simplex->m_count == 3)
+		{
+			break;
+		}
+
+		Vec2 direction = simplex->GetSearchDirection();
+		if (direction.GetLengthSquared() < GJK_TOLERANCE * GJK_TOLERANCE)
+		{
+			//The origin is on the simplex, the cores are touching
+			break;
+		}
+
+		int indexA = shapeA.GetSupportIndex(direction);
+		int indexB = shapeB.GetSupportIndex(direction * -1.f);
+		iteration++;
+
+		bool isDuplicate = false;
+		for (int vertexIndex = 0; vertexIndex < savedCount; vertexIndex++)
+		{
+			if (savedIndexA[vertexIndex] == indexA && savedIndexB[vertexIndex] == indexB)
+			{
+				isDuplicate = true;
+				break;
+			}
+		}
+
+		if (isDuplicate)
+		{
+			//No progress, the current feature is the closest one
+			break;
+		}
+
+		simplex->SetVertex(simplex->m_count, shapeA, indexA, shapeB, indexB);
+		simplex->m_count++;
+	}
+
+	return iteration;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool GJKDistance2D( GJKResult2D* out, const ConvexSupport2D& shapeA, const ConvexSupport2D& shapeB )
+{
+	GJKSimplex2D simplex;
+	out->m_numIterations = RunGJK(&simplex, shapeA, shapeB);
+
+	Vec2 pointA;
+	Vec2 pointB;
+	simplex.GetWitnessPoints(&pointA, &pointB);
+
+	float coreDistance = (simplex.m_count == 3) ? 0.f : (pointB - pointA).GetLength();
+	float radiusSum = shapeA.GetRadius() + shapeB.GetRadius();
+
+	if (coreDistance > radiusSum && coreDistance > GJK_TOLERANCE)
+	{
+		//Move the closest points out onto the rounded surfaces
+		Vec2 normal = (pointB - pointA) / coreDistance;
+		out->m_pointOnA = pointA + normal * shapeA.GetRadius();
+		out->m_pointOnB = pointB - normal * shapeB.GetRadius();
+		out->m_distance = coreDistance - radiusSum;
+		return false;
+	}
+
+	Vec2 midPoint = (pointA + pointB) * 0.5f;
+	out->m_pointOnA = midPoint;
+	out->m_pointOnB = midPoint;
+	out->m_distance = 0.f;
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool GJKOverlap2D( const ConvexSupport2D& shapeA, const ConvexSupport2D& shapeB )
+{
+	GJKResult2D result;
+	return GJKDistance2D(&result, shapeA, shapeB);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void RemovePolytopeVertex( GJKVertex2D* polytope, int* numVertices, int removeIndex )
+{
+	for (int vertexIndex = removeIndex; vertexIndex < *numVertices - 1; vertexIndex++)
+	{
+		polytope[vertexIndex] = polytope[vertexIndex + 1];
+	}
+
+	(*numVertices)--;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Expands the GJK triangle out to the boundary of the Minkowski difference. Outputs the boundary normal closest to the
+// origin (pointing out of A - B), the depth along it and the deepest point of A's core.
+//------------------------------------------------------------------------------------------------------------------------------
+static void RunEPA( Vec2* outNormal, float* outDepth, Vec2* outPointA, const GJKSimplex2D& simplex, const ConvexSupport2D& shapeA, const ConvexSupport2D& shapeB )
+{
+	GJKVertex2D polytope[EPA_MAX_POLYTOPE_SIZE];
+	int numVertices = 3;
+
+	polytope[0] = simplex.m_vertices[0];
+	polytope[1] = simplex.m_vertices[1];
+	polytope[2] = simplex.m_vertices[2];
+
+	//Keep the polytope counter clockwise so the edge normals point out
+	if (Cross2D(polytope[1].m_point - polytope[0].m_point, polytope[2].m_point - polytope[0].m_point) < 0.f)
+	{
+		GJKVertex2D swap = polytope[1];
+		polytope[1] = polytope[2];
+		polytope[2] = swap;
+	}
+
+	int bestEdge = 0;
+	float bestDistance = 0.f;
+	Vec2 bestNormal = Vec2::UP;
+
+	for (int iteration = 0; iteration < EPA_MAX_ITERATIONS; iteration++)
+	{
+		//Edge closest to the origin
+		bestDistance = 1e30f;
+		for (int edgeIndex = 0; edgeIndex < numVertices; edgeIndex++)
+		{
+			const Vec2& start = polytope[edgeIndex].m_point;
+			const Vec2& end = polytope[(edgeIndex + 1) % numVertices].m_point;
+
+			Vec2 edge = end - start;
+			float edgeLength = edge.GetLength();
+			if (edgeLength < GJK_TOLERANCE)
+			{
+				continue;
+			}
+
+			Vec2 normal = edge.GetRotatedMinus90Degrees() / edgeLength;
+			float distance = Dot2D(normal, start);
+			if (distance < bestDistance)
+			{
+				bestDistance = distance;
+				bestNormal = normal;
+				bestEdge = edgeIndex;
+			}
+		}
+
+		//Push the edge out to the real boundary, stop when it already is there
+		int indexA = shapeA.GetSupportIndex(bestNormal);
+		int indexB = shapeB.GetSupportIndex(bestNormal * -1.f);
+		Vec2 support = shapeA.GetPoints()[indexA] - shapeB.GetPoints()[indexB];
+
+		if (Dot2D(support, bestNormal) - bestDistance < EPA_TOLERANCE || numVertices == EPA_MAX_POLYTOPE_SIZE)
+		{
+			break;
+		}
+
+		int insertIndex = bestEdge + 1;
+		for (int vertexIndex = numVertices; vertexIndex > insertIndex; vertexIndex--)
+		{
+			polytope[vertexIndex] = polytope[vertexIndex - 1];
+		}
+
+		GJKVertex2D& vertex = polytope[insertIndex];
+		vertex.m_indexA = indexA;
+		vertex.m_indexB = indexB;
+		vertex.m_pointA = shapeA.GetPoints()[indexA];
+		vertex.m_pointB = shapeB.GetPoints()[indexB];
+		vertex.m_point = support;
+		numVertices++;
+
+		//The GJK triangle can have points inside the Minkowski difference, drop any neighbour the new point made concave
+		while (numVertices > 3)
+		{
+			int previous = (insertIndex + numVertices - 1) % numVertices;
+			int beforePrevious = (insertIndex + numVertices - 2) % numVertices;
+			if (Cross2D(polytope[previous].m_point - polytope[beforePrevious].m_point, support - polytope[previous].m_point) > 0.f)
+			{
+				break;
+			}
+
+			RemovePolytopeVertex(polytope, &numVertices, previous);
+			insertIndex = (previous < insertIndex) ? insertIndex - 1 : insertIndex;
+		}
+
+		while (numVertices > 3)
+		{
+			int next = (insertIndex + 1) % numVertices;
+			int afterNext = (insertIndex + 2) % numVertices;
+			if (Cross2D(polytope[next].m_point - support, polytope[afterNext].m_point - polytope[next].m_point) > 0.f)
+			{
+				break;
+			}
+
+			RemovePolytopeVertex(polytope, &numVertices, next);
+			insertIndex = (next < insertIndex) ? insertIndex - 1 : insertIndex;
+		}
+	}
+
+	//Where the origin projects on the best edge gives the deepest point of A
+	const GJKVertex2D& start = polytope[bestEdge];
+	const GJKVertex2D& end = polytope[(bestEdge + 1) % numVertices];
+	Vec2 edge = end.m_point - start.m_point;
+
+	float edgeLengthSquared = edge.GetLengthSquared();
+	float fraction = 0.f;
+	if (edgeLengthSquared > 0.f)
+	{
+		fraction = -Dot2D(start.m_point, edge) / edgeLengthSquared;
+		fraction = (fraction < 0.f) ? 0.f : ((fraction > 1.f) ? 1.f : fraction);
+	}
+
+	*outNormal = bestNormal;
+	*outDepth = (bestDistance > 0.f) ? bestDistance : 0.f;
+	*outPointA = start.m_pointA + (end.m_pointA - start.m_pointA) * fraction;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool GetManifoldGJK( Manifold2D* out, const ConvexSupport2D& shapeA, const ConvexSupport2D& shapeB )
+{
+	GJKSimplex2D simplex;
+	RunGJK(&simplex, shapeA, shapeB);
+
+	Vec2 pointA;
+	Vec2 pointB;
+	simplex.GetWitnessPoints(&pointA, &pointB);
+
+	float radiusA = shapeA.GetRadius();
+	float radiusSum = radiusA + shapeB.GetRadius();
+
+	if (simplex.m_count == 3)
+	{
+		Vec2 boundaryNormal;
+		float depth;
+		RunEPA(&boundaryNormal, &depth, &pointA, simplex, shapeA, shapeB);
+
+		//Moving A by -boundaryNormal * depth separates the cores
+		out->m_normal = boundaryNormal * -1.f;
+		out->m_penetration = depth + radiusSum;
+		out->m_contact = pointA + boundaryNormal * radiusA;
+		return out->m_penetration > 0.f;
+	}
+
+	float coreDistance = (pointA - pointB).GetLength();
+	if (coreDistance >= radiusSum)
+	{
+		return false;
+	}
+
+	if (coreDistance > GJK_TOLERANCE)
+	{
+		//Only the rounded parts overlap, the closest points give the manifold directly
+		Vec2 normal = (pointA - pointB) / coreDistance;
+
+		out->m_normal = normal;
+		out->m_penetration = radiusSum - coreDistance;
+		out->m_contact = pointA - normal * radiusA;
+		return true;
+	}
+
+	//Cores are just touching, push apart along the line between the centers
+	Vec2 normal = shapeA.GetCenter() - shapeB.GetCenter();
+	normal = (normal.GetLengthSquared() > 0.f) ? normal.GetNormalized() : Vec2::UP;
+
+	out->m_normal = normal;
+	out->m_penetration = radiusSum;
+	out->m_contact = pointA - normal * radiusA;
+	return radiusSum > 0.f;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool MakeSupportForCollider( ConvexSupport2D* out, std::vector<Vec2>* pointStorage, const Collider2D* collider )
+{
+	switch (collider->m_colliderType)
+	{
+	case COLLIDER_AABB2:
+		*out = ConvexSupport2D(reinterpret_cast<const AABB2Collider*>(collider)->GetWorldShape());
+		return true;
+	case COLLIDER_DISC:
+		*out = ConvexSupport2D(reinterpret_cast<const Disc2DCollider*>(collider)->GetWorldShape());
+		return true;
+	case COLLIDER_BOX:
+		*out = ConvexSupport2D(reinterpret_cast<const BoxCollider2D*>(collider)->GetWorldShape());
+		return true;
+	case COLLIDER_CAPSULE:
+	{
+		const CapsuleCollider2D* capsule = reinterpret_cast<const CapsuleCollider2D*>(collider);
+		*out = ConvexSupport2D(capsule->GetWorldShape(), capsule->GetCapsuleRadius());
+		return true;
+	}
+	case COLLIDER_POLYGON:
+	{
+		reinterpret_cast<const PolygonCollider2D*>(collider)->GetWorldPoints(pointStorage);
+		*out = ConvexSupport2D(pointStorage->data(), static_cast<int>(pointStorage->size()));
+		return !pointStorage->empty();
+	}
+	default:
+		return false;
+	}
+}
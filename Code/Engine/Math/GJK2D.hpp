@@ -0,0 +1,80 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+//Engine Systems
+#include "Engine/Math/Manifold.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include <vector>
+
+class Capsule2D;
+class Collider2D;
+class ConvexPoly2D;
+class Disc2D;
+class OBB2;
+struct AABB2;
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr int			GJK_MAX_INLINE_POINTS = 8;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// A convex shape described by its support function: the convex hull of a set of core points, grown by a radius
+//
+// Boxes and polygons are their corners with no radius, a disc is its center grown by the radius, a capsule is its
+// segment grown by the radius. Small shapes keep their points inline, polygons point at points owned by someone else
+// (a ConvexPoly2D, a cached array) that have to outlive the support shape.
+//------------------------------------------------------------------------------------------------------------------------------
+struct ConvexSupport2D
+{
+public:
+	ConvexSupport2D() {}
+	explicit ConvexSupport2D(const Vec2* points, int numPoints, float radius = 0.f);
+	explicit ConvexSupport2D(const AABB2& box);
+	explicit ConvexSupport2D(const Disc2D& disc);
+	explicit ConvexSupport2D(const OBB2& box, float radius = 0.f);
+	explicit ConvexSupport2D(const Capsule2D& capsule);
+	explicit ConvexSupport2D(const ConvexPoly2D& polygon);
+
+	inline const Vec2*		GetPoints() const						{ return (m_externalPoints != nullptr) ? m_externalPoints : m_inlinePoints; }
+	inline int				GetNumPoints() const					{ return m_numPoints; }
+	inline float			GetRadius() const						{ return m_radius; }
+
+	int						GetSupportIndex(const Vec2& direction) const;		// core point furthest along direction
+	Vec2					GetSupportPoint(const Vec2& direction) const;		// including the radius
+	Vec2					GetCenter() const;
+
+private:
+	void					SetInlinePoint(int index, const Vec2& point);
+
+private:
+	Vec2					m_inlinePoints[GJK_MAX_INLINE_POINTS];
+	const Vec2*				m_externalPoints = nullptr;
+	int						m_numPoints = 0;
+	float					m_radius = 0.f;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct GJKResult2D
+{
+	float					m_distance = 0.f;				// between the rounded shapes, 0 when they overlap
+	Vec2					m_pointOnA = Vec2::ZERO;		// closest points on the rounded shapes
+	Vec2					m_pointOnB = Vec2::ZERO;
+	int						m_numIterations = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// GJK distance between two convex shapes, returns true when they overlap
+//------------------------------------------------------------------------------------------------------------------------------
+bool		GJKDistance2D(GJKResult2D* out, const ConvexSupport2D& shapeA, const ConvexSupport2D& shapeB);
+bool		GJKOverlap2D(const ConvexSupport2D& shapeA, const ConvexSupport2D& shapeB);
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Manifold for any 2 convex shapes: GJK on the cores, and EPA when the cores themselves overlap.
+// Same conventions as the specialized GetManifold functions: the normal points from B to A (the way A has to move to
+// separate) and the contact is on A's surface.
+//------------------------------------------------------------------------------------------------------------------------------
+bool		GetManifoldGJK(Manifold2D* out, const ConvexSupport2D& shapeA, const ConvexSupport2D& shapeB);
+
+//------------------------------------------------------------------------------------------------------------------------------
+// World space support shape for any collider. Polygon colliders write their world points to pointStorage, which has to
+// stay alive (and unchanged) as long as the support shape is used.
+//------------------------------------------------------------------------------------------------------------------------------
+bool		MakeSupportForCollider(ConvexSupport2D* out, std::vector<Vec2>* pointStorage, const Collider2D* collider);
@@ -1,6 +1,7 @@
 //------------------------------------------------------------------------------------------------------------------------------
 #pragma once
 #include <string>
+#include <type_traits>
 
 struct Vec2;
 
@@ -11,11 +12,10 @@ struct IntVec2
 	int y;
 
 public:
-	IntVec2();
-	~IntVec2();
-	IntVec2( const IntVec2& copyFrom );							// copy constructor (from another vec2)
+	IntVec2() = default;
+	IntVec2( const IntVec2& copyFrom ) = default;				// copy constructor (from another vec2)
 	IntVec2( const Vec2& vec2 );
-	explicit IntVec2( int initialX, int initialY );		// explicit constructor (from x, y)
+	explicit constexpr IntVec2( int initialX, int initialY );		// explicit constructor (from x, y)
 	explicit IntVec2( const char* asText);				// explicit constructor using string to construct
 
 	void					SetIntVec2(IntVec2 inValue);
@@ -30,18 +30,111 @@ public:
 	const static IntVec2 ONE;
 
 	//Operators
-	const IntVec2			operator+( const IntVec2& vecToAdd ) const;			
-	const IntVec2			operator-( const IntVec2& vecToSubtract ) const;	
-	const IntVec2			operator*( int uniformScale ) const;			
-	const IntVec2			operator/( int inverseScale ) const;			
-	void					operator+=( const IntVec2& vecToAdd );					
-	void					operator-=( const IntVec2& vecToSubtract );			
-	void					operator*=( const int uniformScale );				
-	void					operator/=( const int uniformDivisor );				
-	void					operator=( const IntVec2& copyFrom );					
-	bool					operator==( const IntVec2& compare ) const;			
-	bool					operator!=( const IntVec2& compare ) const;			
-	bool					operator<( const IntVec2& compare ) const;
-
-	friend const IntVec2	operator*( int uniformScale, const IntVec2& vecToScale );	
-};
\ No newline at end of file
+	constexpr const IntVec2	operator+( const IntVec2& vecToAdd ) const;
+	constexpr const IntVec2	operator-( const IntVec2& vecToSubtract ) const;
+	constexpr const IntVec2	operator*( int uniformScale ) const;
+	constexpr const IntVec2	operator/( int inverseScale ) const;
+	constexpr void			operator+=( const IntVec2& vecToAdd );
+	constexpr void			operator-=( const IntVec2& vecToSubtract );
+	constexpr void			operator*=( const int uniformScale );
+	constexpr void			operator/=( const int uniformDivisor );
+	IntVec2&				operator=( const IntVec2& copyFrom ) = default;
+	constexpr bool			operator==( const IntVec2& compare ) const;
+	constexpr bool			operator!=( const IntVec2& compare ) const;
+	constexpr bool			operator<( const IntVec2& compare ) const;
+
+	friend constexpr const IntVec2	operator*( int uniformScale, const IntVec2& vecToScale );
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Arithmetic is inline and constexpr, IntVec2 is used as a key and copied around by value so it stays trivially copyable
+//------------------------------------------------------------------------------------------------------------------------------
+static_assert(std::is_trivially_copyable<IntVec2>::value, "IntVec2 must stay trivially copyable");
+static_assert(sizeof(IntVec2) == 2 * sizeof(int), "IntVec2 must stay 2 packed ints");
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr IntVec2::IntVec2( int initialX, int initialY )
+	: x( initialX )
+	, y( initialY )
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const IntVec2 IntVec2::operator+( const IntVec2& vecToAdd ) const
+{
+	return IntVec2( x + vecToAdd.x, y + vecToAdd.y );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const IntVec2 IntVec2::operator-( const IntVec2& vecToSubtract ) const
+{
+	return IntVec2( x - vecToSubtract.x, y - vecToSubtract.y );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const IntVec2 IntVec2::operator*( int uniformScale ) const
+{
+	return IntVec2( x * uniformScale, y * uniformScale );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const IntVec2 IntVec2::operator/( int inverseScale ) const
+{
+	return IntVec2( x / inverseScale, y / inverseScale );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr void IntVec2::operator+=( const IntVec2& vecToAdd )
+{
+	x += vecToAdd.x;
+	y += vecToAdd.y;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr void IntVec2::operator-=( const IntVec2& vecToSubtract )
+{
+	x -= vecToSubtract.x;
+	y -= vecToSubtract.y;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr void IntVec2::operator*=( const int uniformScale )
+{
+	x *= uniformScale;
+	y *= uniformScale;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr void IntVec2::operator/=( const int uniformDivisor )
+{
+	x /= uniformDivisor;
+	y /= uniformDivisor;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr bool IntVec2::operator==( const IntVec2& compare ) const
+{
+	return (x == compare.x && y == compare.y);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr bool IntVec2::operator!=( const IntVec2& compare ) const
+{
+	return !(x == compare.x && y == compare.y);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr bool IntVec2::operator<( const IntVec2& compare ) const
+{
+	return (x < compare.x && y < compare.y);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const IntVec2 operator*( int uniformScale, const IntVec2& vecToScale )
+{
+	return IntVec2( vecToScale.x * uniformScale, vecToScale.y * uniformScale );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+inline constexpr IntVec2 IntVec2::ZERO(0, 0);
+inline constexpr IntVec2 IntVec2::ONE(1, 1);
@@ -3,6 +3,13 @@
 #include "Engine/Math/Matrix44.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/Vec4.hpp"
+#include "Engine/Math/VertexMaster.hpp"
+
+//Matrices are 4 contiguous basis vectors (column major), so each basis is one SSE register
+#if !defined(ENGINE_DISABLE_SIMD) && (defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__))
+#define MATRIX44_USE_SSE
+#include <xmmintrin.h>
+#endif
 
 const STATIC Matrix44 Matrix44::IDENTITY;
 
@@ -107,6 +114,104 @@ const Vec4 Matrix44::TransformHomogeneousPoint3D( const Vec4& homogeneousVec ) c
 	return transformedPos;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+#if defined(MATRIX44_USE_SSE)
+static inline __m128 TransformXYZ( const __m128& iBasis, const __m128& jBasis, const __m128& kBasis, const Vec3& xyz )
+{
+	__m128 result = _mm_mul_ps(iBasis, _mm_set1_ps(xyz.x));
+	result = _mm_add_ps(result, _mm_mul_ps(jBasis, _mm_set1_ps(xyz.y)));
+	result = _mm_add_ps(result, _mm_mul_ps(kBasis, _mm_set1_ps(xyz.z)));
+	return result;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Writes x,y,z only; Vec3 is 12 bytes so a full 4 wide store would run into the next value
+//------------------------------------------------------------------------------------------------------------------------------
+static inline void StoreXYZ( Vec3* out, const __m128& xyzw )
+{
+	_mm_storel_pi(reinterpret_cast<__m64*>(&out->x), xyzw);
+	_mm_store_ss(&out->z, _mm_movehl_ps(xyzw, xyzw));
+}
+#endif
+
+//------------------------------------------------------------------------------------------------------------------------------
+void Matrix44::TransformPositions3D( Vec3* positions, int numPositions ) const
+{
+#if defined(MATRIX44_USE_SSE)
+	__m128 iBasis = _mm_loadu_ps(&m_values[Ix]);
+	__m128 jBasis = _mm_loadu_ps(&m_values[Jx]);
+	__m128 kBasis = _mm_loadu_ps(&m_values[Kx]);
+	__m128 tBasis = _mm_loadu_ps(&m_values[Tx]);
+
+	for (int index = 0; index < numPositions; index++)
+	{
+		StoreXYZ(&positions[index], _mm_add_ps(TransformXYZ(iBasis, jBasis, kBasis, positions[index]), tBasis));
+	}
+#else
+	for (int index = 0; index < numPositions; index++)
+	{
+		positions[index] = TransformPosition3D(positions[index]);
+	}
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void Matrix44::TransformVectors3D( Vec3* vectors, int numVectors ) const
+{
+#if defined(MATRIX44_USE_SSE)
+	__m128 iBasis = _mm_loadu_ps(&m_values[Ix]);
+	__m128 jBasis = _mm_loadu_ps(&m_values[Jx]);
+	__m128 kBasis = _mm_loadu_ps(&m_values[Kx]);
+
+	for (int index = 0; index < numVectors; index++)
+	{
+		StoreXYZ(&vectors[index], TransformXYZ(iBasis, jBasis, kBasis, vectors[index]));
+	}
+#else
+	for (int index = 0; index < numVectors; index++)
+	{
+		vectors[index] = TransformVector3D(vectors[index]);
+	}
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void Matrix44::TransformVertices( VertexMaster* vertices, int numVertices, bool transformNormals ) const
+{
+#if defined(MATRIX44_USE_SSE)
+	__m128 iBasis = _mm_loadu_ps(&m_values[Ix]);
+	__m128 jBasis = _mm_loadu_ps(&m_values[Jx]);
+	__m128 kBasis = _mm_loadu_ps(&m_values[Kx]);
+	__m128 tBasis = _mm_loadu_ps(&m_values[Tx]);
+
+	for (int index = 0; index < numVertices; index++)
+	{
+		VertexMaster& vertex = vertices[index];
+		StoreXYZ(&vertex.m_position, _mm_add_ps(TransformXYZ(iBasis, jBasis, kBasis, vertex.m_position), tBasis));
+
+		if (transformNormals)
+		{
+			StoreXYZ(&vertex.m_normal, TransformXYZ(iBasis, jBasis, kBasis, vertex.m_normal));
+			StoreXYZ(&vertex.m_tangent, TransformXYZ(iBasis, jBasis, kBasis, vertex.m_tangent));
+			StoreXYZ(&vertex.m_biTangent, TransformXYZ(iBasis, jBasis, kBasis, vertex.m_biTangent));
+		}
+	}
+#else
+	for (int index = 0; index < numVertices; index++)
+	{
+		VertexMaster& vertex = vertices[index];
+		vertex.m_position = TransformPosition3D(vertex.m_position);
+
+		if (transformNormals)
+		{
+			vertex.m_normal = TransformVector3D(vertex.m_normal);
+			vertex.m_tangent = TransformVector3D(vertex.m_tangent);
+			vertex.m_biTangent = TransformVector3D(vertex.m_biTangent);
+		}
+	}
+#endif
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 const Vec3 Matrix44::GetIBasis() const
 {
@@ -271,6 +376,25 @@ Matrix44 Matrix44::AppendMatrix( const Matrix44& matrix )
 {
 	Matrix44 appendMatrix;
 
+#if defined(MATRIX44_USE_SSE)
+	//Each basis of the result is this matrix transforming the same basis of the appended matrix
+	__m128 iBasis = _mm_loadu_ps(&m_values[Ix]);
+	__m128 jBasis = _mm_loadu_ps(&m_values[Jx]);
+	__m128 kBasis = _mm_loadu_ps(&m_values[Kx]);
+	__m128 tBasis = _mm_loadu_ps(&m_values[Tx]);
+
+	for (int basisIndex = 0; basisIndex < 4; basisIndex++)
+	{
+		const float* basis = &matrix.m_values[basisIndex * 4];
+
+		__m128 result = _mm_mul_ps(iBasis, _mm_set1_ps(basis[0]));
+		result = _mm_add_ps(result, _mm_mul_ps(jBasis, _mm_set1_ps(basis[1])));
+		result = _mm_add_ps(result, _mm_mul_ps(kBasis, _mm_set1_ps(basis[2])));
+		result = _mm_add_ps(result, _mm_mul_ps(tBasis, _mm_set1_ps(basis[3])));
+
+		_mm_storeu_ps(&appendMatrix.m_values[basisIndex * 4], result);
+	}
+#else
 	//Row 1
 	appendMatrix.m_values[Ix] = (m_values[Ix] * matrix.m_values[Ix]) +
 								(m_values[Jx] * matrix.m_values[Iy]) + 
@@ -354,6 +478,7 @@ Matrix44 Matrix44::AppendMatrix( const Matrix44& matrix )
 								(m_values[Jw] * matrix.m_values[Ty]) + 
 								(m_values[Kw] * matrix.m_values[Tz]) +
 								(m_values[Tw] * matrix.m_values[Tw]);
+#endif
 
 	return appendMatrix;
 }
@@ -674,16 +799,14 @@ const STATIC Matrix44 Matrix44::MakeFromEuler( const Vec3& euler, eRotationOrder
 //------------------------------------------------------------------------------------------------------------------------------
 const STATIC Matrix44 Matrix44::InvertOrthoNormal( const Matrix44 sourceMatrix )
 {
-	Matrix44 invertedMatrix = sourceMatrix;
-	invertedMatrix.InverseMatrix();
+	//Inverse of a rotation is its transpose, and the translation has to be taken back through that rotation
+	Matrix44 invertedMatrix = Matrix44::TransposeRotationComponents(sourceMatrix);
 
-	/*
-	invertedMatrix = Matrix44::TransposeRotationComponents(sourceMatrix);
-	
-	invertedMatrix.m_values[Tx] *= -1;
-	invertedMatrix.m_values[Ty] *= -1;
-	invertedMatrix.m_values[Tz] *= -1;
-	*/
+	const float* values = sourceMatrix.m_values;
+	Vec3 translation = Vec3(values[Tx], values[Ty], values[Tz]);
+	invertedMatrix.m_values[Tx] = -GetDotProduct(Vec3(values[Ix], values[Iy], values[Iz]), translation);
+	invertedMatrix.m_values[Ty] = -GetDotProduct(Vec3(values[Jx], values[Jy], values[Jz]), translation);
+	invertedMatrix.m_values[Tz] = -GetDotProduct(Vec3(values[Kx], values[Ky], values[Kz]), translation);
 
 	return invertedMatrix;
 }
@@ -721,6 +844,19 @@ const Matrix44 Matrix44::Transpose( const Matrix44& sourceMatrix )
 {
 	Matrix44 TransposeMat = sourceMatrix;
 
+#if defined(MATRIX44_USE_SSE)
+	__m128 iBasis = _mm_loadu_ps(&sourceMatrix.m_values[Ix]);
+	__m128 jBasis = _mm_loadu_ps(&sourceMatrix.m_values[Jx]);
+	__m128 kBasis = _mm_loadu_ps(&sourceMatrix.m_values[Kx]);
+	__m128 tBasis = _mm_loadu_ps(&sourceMatrix.m_values[Tx]);
+
+	_MM_TRANSPOSE4_PS(iBasis, jBasis, kBasis, tBasis);
+
+	_mm_storeu_ps(&TransposeMat.m_values[Ix], iBasis);
+	_mm_storeu_ps(&TransposeMat.m_values[Jx], jBasis);
+	_mm_storeu_ps(&TransposeMat.m_values[Kx], kBasis);
+	_mm_storeu_ps(&TransposeMat.m_values[Tx], tBasis);
+#else
 	TransposeMat.m_values[Jx] = sourceMatrix.m_values[Iy];
 	TransposeMat.m_values[Kx] = sourceMatrix.m_values[Iz];
 	TransposeMat.m_values[Tx] = sourceMatrix.m_values[Iw];
@@ -731,11 +867,12 @@ const Matrix44 Matrix44::Transpose( const Matrix44& sourceMatrix )
 
 	TransposeMat.m_values[Iz] = sourceMatrix.m_values[Kx];
 	TransposeMat.m_values[Jz] = sourceMatrix.m_values[Ky];
-	TransposeMat.m_values[Tz] = sourceMatrix.m_values[Kz];
+	TransposeMat.m_values[Tz] = sourceMatrix.m_values[Kw];
 
 	TransposeMat.m_values[Iw] = sourceMatrix.m_values[Tx];
 	TransposeMat.m_values[Jw] = sourceMatrix.m_values[Ty];
 	TransposeMat.m_values[Kw] = sourceMatrix.m_values[Tz];
+#endif
 
 	return TransposeMat;
 }
@@ -763,6 +900,90 @@ STATIC const Matrix44 Matrix44::LookAt( const Vec3& position, const Vec3& focalP
 //------------------------------------------------------------------------------------------------------------------------------
 void Matrix44::InverseMatrix()
 {
+#if defined(MATRIX44_USE_SSE)
+	//Cramer's rule on 4 lanes at a time (Intel AP-928). Works for either storage order since inverse(transpose(M)) = transpose(inverse(M))
+	float* src = m_values;
+
+	__m128 minor0, minor1, minor2, minor3;
+	__m128 row0, row1, row2, row3;
+	__m128 det, tmp1;
+
+	tmp1 = _mm_setzero_ps();
+	row1 = _mm_setzero_ps();
+	row3 = _mm_setzero_ps();
+
+	tmp1 = _mm_loadh_pi(_mm_loadl_pi(tmp1, reinterpret_cast<__m64*>(src)), reinterpret_cast<__m64*>(src + 4));
+	row1 = _mm_loadh_pi(_mm_loadl_pi(row1, reinterpret_cast<__m64*>(src + 8)), reinterpret_cast<__m64*>(src + 12));
+	row0 = _mm_shuffle_ps(tmp1, row1, 0x88);
+	row1 = _mm_shuffle_ps(row1, tmp1, 0xDD);
+	tmp1 = _mm_loadh_pi(_mm_loadl_pi(tmp1, reinterpret_cast<__m64*>(src + 2)), reinterpret_cast<__m64*>(src + 6));
+	row3 = _mm_loadh_pi(_mm_loadl_pi(row3, reinterpret_cast<__m64*>(src + 10)), reinterpret_cast<__m64*>(src + 14));
+	row2 = _mm_shuffle_ps(tmp1, row3, 0x88);
+	row3 = _mm_shuffle_ps(row3, tmp1, 0xDD);
+
+	tmp1 = _mm_mul_ps(row2, row3);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+	minor0 = _mm_mul_ps(row1, tmp1);
+	minor1 = _mm_mul_ps(row0, tmp1);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+	minor0 = _mm_sub_ps(_mm_mul_ps(row1, tmp1), minor0);
+	minor1 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor1);
+	minor1 = _mm_shuffle_ps(minor1, minor1, 0x4E);
+
+	tmp1 = _mm_mul_ps(row1, row2);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+	minor0 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor0);
+	minor3 = _mm_mul_ps(row0, tmp1);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+	minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp1));
+	minor3 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor3);
+	minor3 = _mm_shuffle_ps(minor3, minor3, 0x4E);
+
+	tmp1 = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+	row2 = _mm_shuffle_ps(row2, row2, 0x4E);
+	minor0 = _mm_add_ps(_mm_mul_ps(row2, tmp1), minor0);
+	minor2 = _mm_mul_ps(row0, tmp1);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+	minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp1));
+	minor2 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor2);
+	minor2 = _mm_shuffle_ps(minor2, minor2, 0x4E);
+
+	tmp1 = _mm_mul_ps(row0, row1);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+	minor2 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor2);
+	minor3 = _mm_sub_ps(_mm_mul_ps(row2, tmp1), minor3);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+	minor2 = _mm_sub_ps(_mm_mul_ps(row3, tmp1), minor2);
+	minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, tmp1));
+
+	tmp1 = _mm_mul_ps(row0, row3);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+	minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, tmp1));
+	minor2 = _mm_add_ps(_mm_mul_ps(row1, tmp1), minor2);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+	minor1 = _mm_add_ps(_mm_mul_ps(row2, tmp1), minor1);
+	minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, tmp1));
+
+	tmp1 = _mm_mul_ps(row0, row2);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+	minor1 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor1);
+	minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, tmp1));
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+	minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, tmp1));
+	minor3 = _mm_add_ps(_mm_mul_ps(row1, tmp1), minor3);
+
+	det = _mm_mul_ps(row0, minor0);
+	det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+	det = _mm_add_ss(_mm_shuffle_ps(det, det, 0xB1), det);
+	det = _mm_div_ss(_mm_set_ss(1.f), det);
+	det = _mm_shuffle_ps(det, det, 0x00);
+
+	_mm_storeu_ps(src, _mm_mul_ps(det, minor0));
+	_mm_storeu_ps(src + 4, _mm_mul_ps(det, minor1));
+	_mm_storeu_ps(src + 8, _mm_mul_ps(det, minor2));
+	_mm_storeu_ps(src + 12, _mm_mul_ps(det, minor3));
+#else
 	double inverse[16];
 	double det;
 	double m[16];
@@ -890,6 +1111,38 @@ void Matrix44::InverseMatrix()
 	for (i = 0; i < 16; i++) {
 		m_values[i] = (float)(inverse[i] * det);
 	}
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Rotation/scale plus translation only, so invert the 3x3 with cross products and bring the translation back through it
+//------------------------------------------------------------------------------------------------------------------------------
+void Matrix44::InverseAffine()
+{
+	//Not the Get*Basis functions, those normalize
+	Vec3 iBasis = Vec3(m_values[Ix], m_values[Iy], m_values[Iz]);
+	Vec3 jBasis = Vec3(m_values[Jx], m_values[Jy], m_values[Jz]);
+	Vec3 kBasis = Vec3(m_values[Kx], m_values[Ky], m_values[Kz]);
+	Vec3 translation = Vec3(m_values[Tx], m_values[Ty], m_values[Tz]);
+
+	//Rows of the inverse
+	Vec3 row0 = GetCrossProduct(jBasis, kBasis);
+	Vec3 row1 = GetCrossProduct(kBasis, iBasis);
+	Vec3 row2 = GetCrossProduct(iBasis, jBasis);
+
+	float inverseDet = 1.f / GetDotProduct(iBasis, row0);
+	row0 *= inverseDet;
+	row1 *= inverseDet;
+	row2 *= inverseDet;
+
+	m_values[Ix] = row0.x;	m_values[Iy] = row1.x;	m_values[Iz] = row2.x;	m_values[Iw] = 0.f;
+	m_values[Jx] = row0.y;	m_values[Jy] = row1.y;	m_values[Jz] = row2.y;	m_values[Jw] = 0.f;
+	m_values[Kx] = row0.z;	m_values[Ky] = row1.z;	m_values[Kz] = row2.z;	m_values[Kw] = 0.f;
+
+	m_values[Tx] = -GetDotProduct(row0, translation);
+	m_values[Ty] = -GetDotProduct(row1, translation);
+	m_values[Tz] = -GetDotProduct(row2, translation);
+	m_values[Tw] = 1.f;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
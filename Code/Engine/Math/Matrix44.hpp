@@ -4,6 +4,7 @@
 struct Vec2;
 struct Vec3;
 struct Vec4;
+struct VertexMaster;
 
 enum eRotationOrder
 {
@@ -45,6 +46,11 @@ public:
 	const Vec3			TransformVector3D( const Vec3& vecQuantity ) const;				 //assumes w = 0;
 	const Vec4			TransformHomogeneousPoint3D ( const Vec4& homogeneousVec ) const; //assumes nothing; 
 
+	//Batch transforms, in place (SSE when available)
+	void				TransformPositions3D( Vec3* positions, int numPositions ) const;	//assumes w = 1;
+	void				TransformVectors3D( Vec3* vectors, int numVectors ) const;			//assumes w = 0;
+	void				TransformVertices( VertexMaster* vertices, int numVertices, bool transformNormals = true ) const;	//normals, tangents and bitangents as vectors
+
 	//Get axis methods
 	const Vec3			GetIBasis() const;
 	const Vec3			GetJBasis() const;
@@ -67,6 +73,7 @@ public:
 	Matrix44			AppendMatrix( const Matrix44& matrix);
 
 	void				InverseMatrix();
+	void				InverseAffine();													//last row must be (0,0,0,1)
 	void				SetRotationFromMatrix(Matrix44& out, Matrix44& sourceMatrix);
 
 	//Static methods to create required matrix
@@ -0,0 +1,1063 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Math/MeshBVH.hpp"
+//Engine Systems
+#include "Engine/Core/BufferReadUtils.hpp"
+#include "Engine/Core/BufferWriteUtils.hpp"
+#include "Engine/Core/JobSystem/Job.hpp"
+#include "Engine/Core/JobSystem/JobSystem.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Ray3D.hpp"
+#include "Engine/Renderer/CPUMesh.hpp"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+//Packets of 4 rays, one ray per lane
+#if !defined(ENGINE_DISABLE_SIMD) && (defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__))
+#define MESH_BVH_USE_SSE
+#include <emmintrin.h>
+#endif
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr int			BVH_NUM_SAH_BINS = 12;
+constexpr int			BVH_MAX_DEPTH = 64;						// deeper nodes become leaves so traversal stacks stay fixed size
+constexpr int			BVH_MAX_SAH_LEAF_SIZE = 16;				// SAH may keep up to this many triangles in a leaf if splitting costs more
+constexpr int			BVH_MIN_PARALLEL_SUBTREE = 1024;		// smaller ranges are not worth a job
+constexpr float			BVH_DET_EPSILON = 1e-12f;
+constexpr float			BVH_NO_DIRECTION_INVERSE = 1e30f;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Per source triangle data only needed while building
+//------------------------------------------------------------------------------------------------------------------------------
+struct MeshBVHBuildData
+{
+	std::vector<Vec3>		m_triangleMins;
+	std::vector<Vec3>		m_triangleMaxs;
+	std::vector<Vec3>		m_centroids;
+	std::vector<int>		m_order;
+	int						m_maxTrianglesPerLeaf = 4;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+static float GetHalfSurfaceArea( const Vec3& mins, const Vec3& maxs )
+{
+	Vec3 size = maxs - mins;
+	return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static float GetComponent( const Vec3& vec, int axis )
+{
+	return (axis == 0) ? vec.x : ((axis == 1) ? vec.y : vec.z);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static int GetSAHBin( float centroid, float centroidMin, float binScale )
+{
+	int bin = static_cast<int>((centroid - centroidMin) * binScale);
+	return (bin < BVH_NUM_SAH_BINS) ? bin : BVH_NUM_SAH_BINS - 1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Finishes the node at nodeIndex, whose m_leftOrFirst/m_numTriangles hold its triangle range until it is split. Returns
+// true if it was split, with both children appended (range set the same way) for the caller to build.
+//------------------------------------------------------------------------------------------------------------------------------
+static bool SplitBVHNode( std::vector<MeshBVH::Node>& nodes, int nodeIndex, int depth, MeshBVHBuildData& data )
+{
+	int first = nodes[nodeIndex].m_leftOrFirst;
+	int count = nodes[nodeIndex].m_numTriangles;
+
+	Vec3 mins = data.m_triangleMins[data.m_order[first]];
+	Vec3 maxs = data.m_triangleMaxs[data.m_order[first]];
+	Vec3 centroidMins = data.m_centroids[data.m_order[first]];
+	Vec3 centroidMaxs = centroidMins;
+	for (int orderIndex = first + 1; orderIndex < first + count; orderIndex++)
+	{
+		int triangleIndex = data.m_order[orderIndex];
+		mins = Vec3::GetComponentMin(mins, data.m_triangleMins[triangleIndex]);
+		maxs = Vec3::GetComponentMax(maxs, data.m_triangleMaxs[triangleIndex]);
+		centroidMins = Vec3::GetComponentMin(centroidMins, data.m_centroids[triangleIndex]);
+		centroidMaxs = Vec3::GetComponentMax(centroidMaxs, data.m_centroids[triangleIndex]);
+	}
+
+	nodes[nodeIndex].m_mins = mins;
+	nodes[nodeIndex].m_maxs = maxs;
+
+	if (count <= data.m_maxTrianglesPerLeaf || depth >= BVH_MAX_DEPTH - 1)
+	{
+		return false;
+	}
+
+	//Binned SAH on every axis the centroids spread along
+	int bestAxis = -1;
+	int bestSplitBin = 0;
+	float bestCost = 0.f;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		float centroidMin = GetComponent(centroidMins, axis);
+		float extent = GetComponent(centroidMaxs, axis) - centroidMin;
+		if (extent <= 0.f)
+		{
+			continue;
+		}
+
+		float binScale = static_cast<float>(BVH_NUM_SAH_BINS) / extent;
+		int binCounts[BVH_NUM_SAH_BINS] = {};
+		Vec3 binMins[BVH_NUM_SAH_BINS];
+		Vec3 binMaxs[BVH_NUM_SAH_BINS];
+
+		for (int orderIndex = first; orderIndex < first + count; orderIndex++)
+		{
+			int triangleIndex = data.m_order[orderIndex];
+			int bin = GetSAHBin(GetComponent(data.m_centroids[triangleIndex], axis), centroidMin, binScale);
+			if (binCounts[bin] == 0)
+			{
+				binMins[bin] = data.m_triangleMins[triangleIndex];
+				binMaxs[bin] = data.m_triangleMaxs[triangleIndex];
+			}
+			else
+			{
+				binMins[bin] = Vec3::GetComponentMin(binMins[bin], data.m_triangleMins[triangleIndex]);
+				binMaxs[bin] = Vec3::GetComponentMax(binMaxs[bin], data.m_triangleMaxs[triangleIndex]);
+			}
+			binCounts[bin]++;
+		}
+
+		//Sweep from the right to get the cost of everything right of each split
+		float rightAreas[BVH_NUM_SAH_BINS];
+		int rightCounts[BVH_NUM_SAH_BINS];
+		int runningCount = 0;
+		Vec3 runningMins;
+		Vec3 runningMaxs;
+		for (int bin = BVH_NUM_SAH_BINS - 1; bin > 0; bin--)
+		{
+			if (binCounts[bin] > 0)
+			{
+				runningMins = (runningCount == 0) ? binMins[bin] : Vec3::GetComponentMin(runningMins, binMins[bin]);
+				runningMaxs = (runningCount == 0) ? binMaxs[bin] : Vec3::GetComponentMax(runningMaxs, binMaxs[bin]);
+				runningCount += binCounts[bin];
+			}
+			rightCounts[bin] = runningCount;
+			rightAreas[bin] = (runningCount > 0) ? GetHalfSurfaceArea(runningMins, runningMaxs) : 0.f;
+		}
+
+		runningCount = 0;
+		for (int bin = 0; bin < BVH_NUM_SAH_BINS - 1; bin++)
+		{
+			if (binCounts[bin] > 0)
+			{
+				runningMins = (runningCount == 0) ? binMins[bin] : Vec3::GetComponentMin(runningMins, binMins[bin]);
+				runningMaxs = (runningCount == 0) ? binMaxs[bin] : Vec3::GetComponentMax(runningMaxs, binMaxs[bin]);
+				runningCount += binCounts[bin];
+			}
+
+			if (runningCount == 0 || rightCounts[bin + 1] == 0)
+			{
+				continue;
+			}
+
+			float cost = GetHalfSurfaceArea(runningMins, runningMaxs) * static_cast<float>(runningCount) + rightAreas[bin + 1] * static_cast<float>(rightCounts[bin + 1]);
+			if (bestAxis < 0 || cost < bestCost)
+			{
+				bestAxis = axis;
+				bestSplitBin = bin + 1;
+				bestCost = cost;
+			}
+		}
+	}
+
+	int numLeft = count / 2;
+	if (bestAxis >= 0)
+	{
+		//Traversal costs about one triangle test, keep small leaves when splitting does not beat testing them all
+		float leafCost = GetHalfSurfaceArea(mins, maxs) * static_cast<float>(count - 1);
+		if (bestCost >= leafCost && count <= BVH_MAX_SAH_LEAF_SIZE)
+		{
+			return false;
+		}
+
+		float centroidMin = GetComponent(centroidMins, bestAxis);
+		float binScale = static_cast<float>(BVH_NUM_SAH_BINS) / (GetComponent(centroidMaxs, bestAxis) - centroidMin);
+		std::vector<int>::iterator rangeStart = data.m_order.begin() + first;
+		std::vector<int>::iterator middle = std::partition(rangeStart, rangeStart + count, [&data, bestAxis, bestSplitBin, centroidMin, binScale](int triangleIndex)
+		{
+			return GetSAHBin(GetComponent(data.m_centroids[triangleIndex], bestAxis), centroidMin, binScale) < bestSplitBin;
+		});
+
+		numLeft = static_cast<int>(middle - rangeStart);
+	}
+
+	//All centroids in one spot (or one side), split the range in half so leaves stay small
+	if (numLeft == 0 || numLeft == count)
+	{
+		numLeft = count / 2;
+	}
+
+	int leftChild = static_cast<int>(nodes.size());
+	nodes.push_back(MeshBVH::Node());
+	nodes.push_back(MeshBVH::Node());
+
+	nodes[leftChild].m_leftOrFirst = first;
+	nodes[leftChild].m_numTriangles = numLeft;
+	nodes[leftChild + 1].m_leftOrFirst = first + numLeft;
+	nodes[leftChild + 1].m_numTriangles = count - numLeft;
+
+	nodes[nodeIndex].m_leftOrFirst = leftChild;
+	nodes[nodeIndex].m_numTriangles = 0;
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void BuildBVHSubtree( std::vector<MeshBVH::Node>& nodes, int nodeIndex, int depth, MeshBVHBuildData& data )
+{
+	if (SplitBVHNode(nodes, nodeIndex, depth, data))
+	{
+		int leftChild = nodes[nodeIndex].m_leftOrFirst;
+		BuildBVHSubtree(nodes, leftChild, depth + 1, data);
+		BuildBVHSubtree(nodes, leftChild + 1, depth + 1, data);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// A subtree built into its own node list, rooted at index 0, merged into the main list after all jobs finish
+//------------------------------------------------------------------------------------------------------------------------------
+struct MeshBVHSubtree
+{
+	int								m_mainNodeIndex = 0;
+	int								m_depth = 0;
+	std::vector<MeshBVH::Node>		m_nodes;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+class MeshBVHSubtreeJob : public Job
+{
+public:
+	MeshBVHSubtreeJob(MeshBVHSubtree* subtree, MeshBVHBuildData* data, std::atomic<int>* jobsRemaining)
+		: m_subtree(subtree), m_data(data), m_jobsRemaining(jobsRemaining)
+	{
+	}
+
+	void Execute()
+	{
+		BuildBVHSubtree(m_subtree->m_nodes, 0, m_subtree->m_depth, *m_data);
+
+		//Last thing we touch, the subtree and counter belong to the waiting build
+		m_jobsRemaining->fetch_sub(1);
+	}
+
+private:
+	MeshBVHSubtree*				m_subtree = nullptr;
+	MeshBVHBuildData*			m_data = nullptr;
+	std::atomic<int>*			m_jobsRemaining = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void BuildBVHInParallel( std::vector<MeshBVH::Node>& nodes, MeshBVHBuildData& data, int numJobs )
+{
+	//Split the top of the tree here until there is a subtree for every job (and a few spare to balance the load)
+	std::vector<std::pair<int, int>> frontier;
+	frontier.push_back(std::make_pair(0, 0));
+
+	int targetSubtrees = numJobs * 2;
+	while (static_cast<int>(frontier.size()) < targetSubtrees)
+	{
+		int largestIndex = 0;
+		for (int frontierIndex = 1; frontierIndex < static_cast<int>(frontier.size()); frontierIndex++)
+		{
+			if (nodes[frontier[frontierIndex].first].m_numTriangles > nodes[frontier[largestIndex].first].m_numTriangles)
+			{
+				largestIndex = frontierIndex;
+			}
+		}
+
+		int nodeIndex = frontier[largestIndex].first;
+		int depth = frontier[largestIndex].second;
+		if (nodes[nodeIndex].m_numTriangles < BVH_MIN_PARALLEL_SUBTREE)
+		{
+			break;
+		}
+
+		frontier.erase(frontier.begin() + largestIndex);
+		if (SplitBVHNode(nodes, nodeIndex, depth, data))
+		{
+			int leftChild = nodes[nodeIndex].m_leftOrFirst;
+			frontier.push_back(std::make_pair(leftChild, depth + 1));
+			frontier.push_back(std::make_pair(leftChild + 1, depth + 1));
+		}
+	}
+
+	int numSubtrees = static_cast<int>(frontier.size());
+	std::vector<MeshBVHSubtree> subtrees;
+	subtrees.resize(numSubtrees);
+	for (int subtreeIndex = 0; subtreeIndex < numSubtrees; subtreeIndex++)
+	{
+		subtrees[subtreeIndex].m_mainNodeIndex = frontier[subtreeIndex].first;
+		subtrees[subtreeIndex].m_depth = frontier[subtreeIndex].second;
+		subtrees[subtreeIndex].m_nodes.push_back(nodes[frontier[subtreeIndex].first]);
+	}
+
+	//Different subtrees own different ranges of the triangle order, so jobs never touch the same data
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	std::atomic<int> jobsRemaining(numSubtrees - 1);
+	for (int subtreeIndex = 1; subtreeIndex < numSubtrees; subtreeIndex++)
+	{
+		jobSystem->Run(new MeshBVHSubtreeJob(&subtrees[subtreeIndex], &data, &jobsRemaining));
+	}
+
+	BuildBVHSubtree(subtrees[0].m_nodes, 0, subtrees[0].m_depth, data);
+	while (jobsRemaining.load() > 0)
+	{
+		if (!jobSystem->ProcessCategory(JOB_GENERIC))
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	//Subtree node i > 0 lands at offset + i - 1, its root replaces the frontier node
+	for (int subtreeIndex = 0; subtreeIndex < numSubtrees; subtreeIndex++)
+	{
+		std::vector<MeshBVH::Node>& subtreeNodes = subtrees[subtreeIndex].m_nodes;
+		int offset = static_cast<int>(nodes.size()) - 1;
+
+		for (int nodeIndex = 0; nodeIndex < static_cast<int>(subtreeNodes.size()); nodeIndex++)
+		{
+			MeshBVH::Node node = subtreeNodes[nodeIndex];
+			if (node.m_numTriangles == 0)
+			{
+				node.m_leftOrFirst += offset;
+			}
+
+			if (nodeIndex == 0)
+			{
+				nodes[subtrees[subtreeIndex].m_mainNodeIndex] = node;
+			}
+			else
+			{
+				nodes.push_back(node);
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+MeshBVH::MeshBVH()
+{
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+MeshBVH::~MeshBVH()
+{
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void MeshBVH::Clear()
+{
+	m_nodes.clear();
+	m_triangles.clear();
+	m_triangleIds.clear();
+	m_sourceHash = 0U;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static inline uint HashBytes( uint hash, const void* data, size_t numBytes )
+{
+	const uchar* bytes = static_cast<const uchar*>(data);
+	for (size_t byteIndex = 0; byteIndex < numBytes; byteIndex++)
+	{
+		hash ^= bytes[byteIndex];
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC uint MeshBVH::HashSourceTriangles( const Vec3* positions, int numPositions, const uint* indices, int numIndices )
+{
+	int numTriangles = (indices != nullptr) ? numIndices / 3 : numPositions / 3;
+	uint hash = HashBytes(2166136261U, &numTriangles, sizeof(numTriangles));
+
+	for (int corner = 0; corner < numTriangles * 3; corner++)
+	{
+		hash = HashBytes(hash, &positions[(indices != nullptr) ? indices[corner] : corner], sizeof(Vec3));
+	}
+
+	return hash;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC uint MeshBVH::HashSourceTriangles( const CPUMesh& mesh )
+{
+	int numVertices = static_cast<int>(mesh.GetVertexCount());
+	int numIndices = static_cast<int>(mesh.GetIndexCount());
+	const VertexMaster* vertices = (numVertices > 0) ? mesh.GetVertices() : nullptr;
+	const uint* indices = (numIndices > 0) ? mesh.GetIndices() : nullptr;
+
+	int numTriangles = (indices != nullptr) ? numIndices / 3 : numVertices / 3;
+	uint hash = HashBytes(2166136261U, &numTriangles, sizeof(numTriangles));
+
+	for (int corner = 0; corner < numTriangles * 3; corner++)
+	{
+		hash = HashBytes(hash, &vertices[(indices != nullptr) ? indices[corner] : corner].m_position, sizeof(Vec3));
+	}
+
+	return hash;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void MeshBVH::BuildFromCPUMesh( const CPUMesh& mesh, int numJobs, int maxTrianglesPerLeaf )
+{
+	int numVertices = static_cast<int>(mesh.GetVertexCount());
+	std::vector<Vec3> positions;
+	positions.reserve(numVertices);
+
+	const VertexMaster* vertices = (numVertices > 0) ? mesh.GetVertices() : nullptr;
+	for (int vertexIndex = 0; vertexIndex < numVertices; vertexIndex++)
+	{
+		positions.push_back(vertices[vertexIndex].m_position);
+	}
+
+	int numIndices = static_cast<int>(mesh.GetIndexCount());
+	const uint* indices = (numIndices > 0) ? mesh.GetIndices() : nullptr;
+
+	Build(positions.data(), numVertices, indices, numIndices, numJobs, maxTrianglesPerLeaf);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void MeshBVH::Build( const Vec3* positions, int numPositions, const uint* indices, int numIndices, int numJobs, int maxTrianglesPerLeaf )
+{
+	Clear();
+	m_sourceHash = HashSourceTriangles(positions, numPositions, indices, numIndices);
+
+	int numTriangles = (indices != nullptr) ? numIndices / 3 : numPositions / 3;
+	if (numTriangles == 0)
+	{
+		return;
+	}
+
+	MeshBVHBuildData data;
+	data.m_maxTrianglesPerLeaf = (maxTrianglesPerLeaf < 1) ? 1 : maxTrianglesPerLeaf;
+	data.m_triangleMins.resize(numTriangles);
+	data.m_triangleMaxs.resize(numTriangles);
+	data.m_centroids.resize(numTriangles);
+	data.m_order.resize(numTriangles);
+
+	std::vector<Triangle> sourceTriangles;
+	sourceTriangles.resize(numTriangles);
+
+	for (int triangleIndex = 0; triangleIndex < numTriangles; triangleIndex++)
+	{
+		int firstVertex = triangleIndex * 3;
+		const Vec3& vertex0 = positions[(indices != nullptr) ? indices[firstVertex] : firstVertex];
+		const Vec3& vertex1 = positions[(indices != nullptr) ? indices[firstVertex + 1] : firstVertex + 1];
+		const Vec3& vertex2 = positions[(indices != nullptr) ? indices[firstVertex + 2] : firstVertex + 2];
+
+		sourceTriangles[triangleIndex].m_vertex0 = vertex0;
+		sourceTriangles[triangleIndex].m_edge1 = vertex1 - vertex0;
+		sourceTriangles[triangleIndex].m_edge2 = vertex2 - vertex0;
+
+		data.m_triangleMins[triangleIndex] = Vec3::GetComponentMin(Vec3::GetComponentMin(vertex0, vertex1), vertex2);
+		data.m_triangleMaxs[triangleIndex] = Vec3::GetComponentMax(Vec3::GetComponentMax(vertex0, vertex1), vertex2);
+		data.m_centroids[triangleIndex] = (data.m_triangleMins[triangleIndex] + data.m_triangleMaxs[triangleIndex]) * 0.5f;
+		data.m_order[triangleIndex] = triangleIndex;
+	}
+
+	m_nodes.reserve(2 * (numTriangles / data.m_maxTrianglesPerLeaf) + 1);
+	m_nodes.push_back(Node());
+	m_nodes[0].m_leftOrFirst = 0;
+	m_nodes[0].m_numTriangles = numTriangles;
+
+	if (numJobs > 1 && numTriangles >= 2 * BVH_MIN_PARALLEL_SUBTREE)
+	{
+		BuildBVHInParallel(m_nodes, data, numJobs);
+	}
+	else
+	{
+		BuildBVHSubtree(m_nodes, 0, 0, data);
+	}
+
+	//Store triangles in leaf order so every leaf is a contiguous run
+	m_triangles.resize(numTriangles);
+	m_triangleIds = data.m_order;
+	for (int orderIndex = 0; orderIndex < numTriangles; orderIndex++)
+	{
+		m_triangles[orderIndex] = sourceTriangles[data.m_order[orderIndex]];
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Vec3 MeshBVH::GetMins() const
+{
+	return m_nodes.empty() ? Vec3::ZERO : m_nodes[0].m_mins;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Vec3 MeshBVH::GetMaxs() const
+{
+	return m_nodes.empty() ? Vec3::ZERO : m_nodes[0].m_maxs;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static Vec3 GetSafeInverseDirection( const Vec3& direction )
+{
+	//Large finite values instead of infinities so the slab test never sees 0 * inf
+	Vec3 inverse;
+	inverse.x = (direction.x != 0.f) ? 1.f / direction.x : BVH_NO_DIRECTION_INVERSE;
+	inverse.y = (direction.y != 0.f) ? 1.f / direction.y : BVH_NO_DIRECTION_INVERSE;
+	inverse.z = (direction.z != 0.f) ? 1.f / direction.z : BVH_NO_DIRECTION_INVERSE;
+	return inverse;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static bool RaycastNodeBounds( float* outEntryTime, const MeshBVH::Node& node, const Vec3& start, const Vec3& inverseDirection, float maxTime )
+{
+	float timeX1 = (node.m_mins.x - start.x) * inverseDirection.x;
+	float timeX2 = (node.m_maxs.x - start.x) * inverseDirection.x;
+	float timeY1 = (node.m_mins.y - start.y) * inverseDirection.y;
+	float timeY2 = (node.m_maxs.y - start.y) * inverseDirection.y;
+	float timeZ1 = (node.m_mins.z - start.z) * inverseDirection.z;
+	float timeZ2 = (node.m_maxs.z - start.z) * inverseDirection.z;
+
+	float entryTime = std::max(std::max(std::min(timeX1, timeX2), std::min(timeY1, timeY2)), std::min(timeZ1, timeZ2));
+	float exitTime = std::min(std::min(std::max(timeX1, timeX2), std::max(timeY1, timeY2)), std::max(timeZ1, timeZ2));
+
+	*outEntryTime = entryTime;
+	return (exitTime >= entryTime) && (exitTime >= 0.f) && (entryTime < maxTime);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Moller-Trumbore, two sided. Same operation order as the SSE packet version so single and batched rays agree
+//------------------------------------------------------------------------------------------------------------------------------
+static bool RaycastTriangle( float* outTime, float* outU, float* outV, const MeshBVH::Triangle& triangle, const Vec3& start, const Vec3& direction, float maxTime )
+{
+	const Vec3& edge1 = triangle.m_edge1;
+	const Vec3& edge2 = triangle.m_edge2;
+
+	float pX = direction.y * edge2.z - direction.z * edge2.y;
+	float pY = direction.z * edge2.x - direction.x * edge2.z;
+	float pZ = direction.x * edge2.y - direction.y * edge2.x;
+
+	float determinant = edge1.x * pX + edge1.y * pY + edge1.z * pZ;
+	if (fabsf(determinant) <= BVH_DET_EPSILON)
+	{
+		return false;
+	}
+	float inverseDeterminant = 1.f / determinant;
+
+	float tX = start.x - triangle.m_vertex0.x;
+	float tY = start.y - triangle.m_vertex0.y;
+	float tZ = start.z - triangle.m_vertex0.z;
+
+	float u = (tX * pX + tY * pY + tZ * pZ) * inverseDeterminant;
+	if (u < 0.f || u > 1.f)
+	{
+		return false;
+	}
+
+	float qX = tY * edge1.z - tZ * edge1.y;
+	float qY = tZ * edge1.x - tX * edge1.z;
+	float qZ = tX * edge1.y - tY * edge1.x;
+
+	float v = (direction.x * qX + direction.y * qY + direction.z * qZ) * inverseDeterminant;
+	if (v < 0.f || u + v > 1.f)
+	{
+		return false;
+	}
+
+	float time = (edge2.x * qX + edge2.y * qY + edge2.z * qZ) * inverseDeterminant;
+	if (time < 0.f || time >= maxTime)
+	{
+		return false;
+	}
+
+	*outTime = time;
+	*outU = u;
+	*outV = v;
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void MeshBVH::FillHit( MeshRayHit* outHit, const Ray3D& ray, int triangleIndex, float time, float u, float v ) const
+{
+	const Triangle& triangle = m_triangles[triangleIndex];
+
+	Vec3 normal = GetCrossProduct(triangle.m_edge1, triangle.m_edge2);
+	normal.Normalize();
+	if (GetDotProduct(normal, ray.m_direction) > 0.f)
+	{
+		normal *= -1.f;
+	}
+
+	outHit->m_time = time;
+	outHit->m_position = ray.GetPointAtTime(time);
+	outHit->m_normal = normal;
+	outHit->m_u = u;
+	outHit->m_v = v;
+	outHit->m_triangleIndex = m_triangleIds[triangleIndex];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool MeshBVH::TraceRay( MeshRayHit* outHit, const Ray3D& ray, float maxTime, bool stopAtAnyHit ) const
+{
+	if (m_nodes.empty())
+	{
+		return false;
+	}
+
+	Vec3 inverseDirection = GetSafeInverseDirection(ray.m_direction);
+	float closestTime = maxTime;
+	float closestU = 0.f;
+	float closestV = 0.f;
+	int closestTriangle = -1;
+
+	float entryTime;
+	if (!RaycastNodeBounds(&entryTime, m_nodes[0], ray.m_start, inverseDirection, closestTime))
+	{
+		return false;
+	}
+
+	int nodeStack[BVH_MAX_DEPTH];
+	int stackSize = 0;
+	nodeStack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		const Node& node = m_nodes[nodeStack[--stackSize]];
+
+		if (node.m_numTriangles > 0)
+		{
+			for (int triangleIndex = node.m_leftOrFirst; triangleIndex < node.m_leftOrFirst + node.m_numTriangles; triangleIndex++)
+			{
+				float time, u, v;
+				if (RaycastTriangle(&time, &u, &v, m_triangles[triangleIndex], ray.m_start, ray.m_direction, closestTime))
+				{
+					closestTime = time;
+					closestU = u;
+					closestV = v;
+					closestTriangle = triangleIndex;
+
+					if (stopAtAnyHit)
+					{
+						break;
+					}
+				}
+			}
+
+			if (stopAtAnyHit && closestTriangle >= 0)
+			{
+				break;
+			}
+			continue;
+		}
+
+		//Visit the nearer child first so its hits shorten the ray for the other one
+		float leftEntry, rightEntry;
+		bool hitsLeft = RaycastNodeBounds(&leftEntry, m_nodes[node.m_leftOrFirst], ray.m_start, inverseDirection, closestTime);
+		bool hitsRight = RaycastNodeBounds(&rightEntry, m_nodes[node.m_leftOrFirst + 1], ray.m_start, inverseDirection, closestTime);
+
+		if (hitsLeft && hitsRight)
+		{
+			bool leftFirst = leftEntry <= rightEntry;
+			nodeStack[stackSize++] = leftFirst ? node.m_leftOrFirst + 1 : node.m_leftOrFirst;
+			nodeStack[stackSize++] = leftFirst ? node.m_leftOrFirst : node.m_leftOrFirst + 1;
+		}
+		else if (hitsLeft)
+		{
+			nodeStack[stackSize++] = node.m_leftOrFirst;
+		}
+		else if (hitsRight)
+		{
+			nodeStack[stackSize++] = node.m_leftOrFirst + 1;
+		}
+	}
+
+	if (closestTriangle < 0)
+	{
+		return false;
+	}
+
+	if (outHit != nullptr)
+	{
+		FillHit(outHit, ray, closestTriangle, closestTime, closestU, closestV);
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool MeshBVH::Raycast( MeshRayHit* outHit, const Ray3D& ray, float maxTime ) const
+{
+	outHit->m_triangleIndex = -1;
+	return TraceRay(outHit, ray, maxTime, false);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool MeshBVH::RaycastAny( const Ray3D& ray, float maxTime ) const
+{
+	return TraceRay(nullptr, ray, maxTime, true);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int MeshBVH::RaycastBatch( MeshRayHit* outHits, const Ray3D* rays, int numRays, float maxTime ) const
+{
+	int numHits = 0;
+
+#if defined(MESH_BVH_USE_SSE)
+	for (int rayIndex = 0; rayIndex < numRays; rayIndex += 4)
+	{
+		int numInPacket = (numRays - rayIndex < 4) ? numRays - rayIndex : 4;
+		TracePacket(&outHits[rayIndex], nullptr, &rays[rayIndex], numInPacket, maxTime, false);
+	}
+#else
+	for (int rayIndex = 0; rayIndex < numRays; rayIndex++)
+	{
+		Raycast(&outHits[rayIndex], rays[rayIndex], maxTime);
+	}
+#endif
+
+	for (int rayIndex = 0; rayIndex < numRays; rayIndex++)
+	{
+		numHits += (outHits[rayIndex].m_triangleIndex >= 0) ? 1 : 0;
+	}
+	return numHits;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int MeshBVH::RaycastAnyBatch( bool* outHits, const Ray3D* rays, int numRays, float maxTime ) const
+{
+	int numHits = 0;
+
+#if defined(MESH_BVH_USE_SSE)
+	for (int rayIndex = 0; rayIndex < numRays; rayIndex += 4)
+	{
+		int numInPacket = (numRays - rayIndex < 4) ? numRays - rayIndex : 4;
+		TracePacket(nullptr, &outHits[rayIndex], &rays[rayIndex], numInPacket, maxTime, true);
+	}
+#else
+	for (int rayIndex = 0; rayIndex < numRays; rayIndex++)
+	{
+		outHits[rayIndex] = RaycastAny(rays[rayIndex], maxTime);
+	}
+#endif
+
+	for (int rayIndex = 0; rayIndex < numRays; rayIndex++)
+	{
+		numHits += outHits[rayIndex] ? 1 : 0;
+	}
+	return numHits;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void MeshBVH::TracePacket( MeshRayHit* outHits, bool* outAnyHits, const Ray3D* rays, int numRays, float maxTime, bool stopAtAnyHit ) const
+{
+#if defined(MESH_BVH_USE_SSE)
+	for (int laneIndex = 0; laneIndex < numRays; laneIndex++)
+	{
+		if (outHits != nullptr)
+		{
+			outHits[laneIndex] = MeshRayHit();
+		}
+		if (outAnyHits != nullptr)
+		{
+			outAnyHits[laneIndex] = false;
+		}
+	}
+
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	//Unused lanes repeat the last ray but start inactive
+	alignas(16) float laneValues[9][4];
+	for (int laneIndex = 0; laneIndex < 4; laneIndex++)
+	{
+		const Ray3D& ray = rays[(laneIndex < numRays) ? laneIndex : numRays - 1];
+		Vec3 inverseDirection = GetSafeInverseDirection(ray.m_direction);
+
+		laneValues[0][laneIndex] = ray.m_start.x;
+		laneValues[1][laneIndex] = ray.m_start.y;
+		laneValues[2][laneIndex] = ray.m_start.z;
+		laneValues[3][laneIndex] = ray.m_direction.x;
+		laneValues[4][laneIndex] = ray.m_direction.y;
+		laneValues[5][laneIndex] = ray.m_direction.z;
+		laneValues[6][laneIndex] = inverseDirection.x;
+		laneValues[7][laneIndex] = inverseDirection.y;
+		laneValues[8][laneIndex] = inverseDirection.z;
+	}
+
+	__m128 startX = _mm_load_ps(laneValues[0]);
+	__m128 startY = _mm_load_ps(laneValues[1]);
+	__m128 startZ = _mm_load_ps(laneValues[2]);
+	__m128 directionX = _mm_load_ps(laneValues[3]);
+	__m128 directionY = _mm_load_ps(laneValues[4]);
+	__m128 directionZ = _mm_load_ps(laneValues[5]);
+	__m128 inverseX = _mm_load_ps(laneValues[6]);
+	__m128 inverseY = _mm_load_ps(laneValues[7]);
+	__m128 inverseZ = _mm_load_ps(laneValues[8]);
+
+	const int laneMasks[5] = { 0x0, 0x1, 0x3, 0x7, 0xF };
+	int activeLanes = laneMasks[numRays];
+	__m128 active = _mm_castsi128_ps(_mm_setr_epi32((numRays > 0) ? -1 : 0, (numRays > 1) ? -1 : 0, (numRays > 2) ? -1 : 0, (numRays > 3) ? -1 : 0));
+
+	__m128 closestTime = _mm_set1_ps(maxTime);
+	__m128 closestU = _mm_setzero_ps();
+	__m128 closestV = _mm_setzero_ps();
+	__m128i closestTriangle = _mm_set1_epi32(-1);
+
+	__m128 zero = _mm_setzero_ps();
+	__m128 one = _mm_set1_ps(1.f);
+	__m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	__m128 detEpsilon = _mm_set1_ps(BVH_DET_EPSILON);
+
+	int nodeStack[BVH_MAX_DEPTH];
+	int stackSize = 0;
+	nodeStack[stackSize++] = 0;
+
+	//Direction of the packet for ordering children, taken from the first real ray
+	Vec3 packetDirection = rays[0].m_direction;
+
+	while (stackSize > 0 && activeLanes != 0)
+	{
+		const Node& node = m_nodes[nodeStack[--stackSize]];
+
+		__m128 timeX1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.m_mins.x), startX), inverseX);
+		__m128 timeX2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.m_maxs.x), startX), inverseX);
+		__m128 timeY1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.m_mins.y), startY), inverseY);
+		__m128 timeY2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.m_maxs.y), startY), inverseY);
+		__m128 timeZ1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.m_mins.z), startZ), inverseZ);
+		__m128 timeZ2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.m_maxs.z), startZ), inverseZ);
+
+		__m128 entryTime = _mm_max_ps(_mm_max_ps(_mm_min_ps(timeX1, timeX2), _mm_min_ps(timeY1, timeY2)), _mm_min_ps(timeZ1, timeZ2));
+		__m128 exitTime = _mm_min_ps(_mm_min_ps(_mm_max_ps(timeX1, timeX2), _mm_max_ps(timeY1, timeY2)), _mm_max_ps(timeZ1, timeZ2));
+
+		__m128 hitsNode = _mm_and_ps(_mm_cmpge_ps(exitTime, entryTime), _mm_cmpge_ps(exitTime, zero));
+		hitsNode = _mm_and_ps(hitsNode, _mm_cmplt_ps(entryTime, closestTime));
+		hitsNode = _mm_and_ps(hitsNode, active);
+		if (_mm_movemask_ps(hitsNode) == 0)
+		{
+			continue;
+		}
+
+		if (node.m_numTriangles == 0)
+		{
+			//Far child goes on the stack first
+			const Node& leftNode = m_nodes[node.m_leftOrFirst];
+			const Node& rightNode = m_nodes[node.m_leftOrFirst + 1];
+			Vec3 centerDifference = (leftNode.m_mins + leftNode.m_maxs) - (rightNode.m_mins + rightNode.m_maxs);
+			bool leftFirst = GetDotProduct(centerDifference, packetDirection) <= 0.f;
+
+			nodeStack[stackSize++] = leftFirst ? node.m_leftOrFirst + 1 : node.m_leftOrFirst;
+			nodeStack[stackSize++] = leftFirst ? node.m_leftOrFirst : node.m_leftOrFirst + 1;
+			continue;
+		}
+
+		for (int triangleIndex = node.m_leftOrFirst; triangleIndex < node.m_leftOrFirst + node.m_numTriangles; triangleIndex++)
+		{
+			const Triangle& triangle = m_triangles[triangleIndex];
+			__m128 edge1X = _mm_set1_ps(triangle.m_edge1.x);
+			__m128 edge1Y = _mm_set1_ps(triangle.m_edge1.y);
+			__m128 edge1Z = _mm_set1_ps(triangle.m_edge1.z);
+			__m128 edge2X = _mm_set1_ps(triangle.m_edge2.x);
+			__m128 edge2Y = _mm_set1_ps(triangle.m_edge2.y);
+			__m128 edge2Z = _mm_set1_ps(triangle.m_edge2.z);
+
+			__m128 pX = _mm_sub_ps(_mm_mul_ps(directionY, edge2Z), _mm_mul_ps(directionZ, edge2Y));
+			__m128 pY = _mm_sub_ps(_mm_mul_ps(directionZ, edge2X), _mm_mul_ps(directionX, edge2Z));
+			__m128 pZ = _mm_sub_ps(_mm_mul_ps(directionX, edge2Y), _mm_mul_ps(directionY, edge2X));
+
+			__m128 determinant = _mm_add_ps(_mm_add_ps(_mm_mul_ps(edge1X, pX), _mm_mul_ps(edge1Y, pY)), _mm_mul_ps(edge1Z, pZ));
+			__m128 hits = _mm_and_ps(active, _mm_cmpgt_ps(_mm_and_ps(determinant, absMask), detEpsilon));
+			if (_mm_movemask_ps(hits) == 0)
+			{
+				continue;
+			}
+			__m128 inverseDeterminant = _mm_div_ps(one, determinant);
+
+			__m128 tX = _mm_sub_ps(startX, _mm_set1_ps(triangle.m_vertex0.x));
+			__m128 tY = _mm_sub_ps(startY, _mm_set1_ps(triangle.m_vertex0.y));
+			__m128 tZ = _mm_sub_ps(startZ, _mm_set1_ps(triangle.m_vertex0.z));
+
+			__m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tX, pX), _mm_mul_ps(tY, pY)), _mm_mul_ps(tZ, pZ)), inverseDeterminant);
+			hits = _mm_and_ps(hits, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+
+			__m128 qX = _mm_sub_ps(_mm_mul_ps(tY, edge1Z), _mm_mul_ps(tZ, edge1Y));
+			__m128 qY = _mm_sub_ps(_mm_mul_ps(tZ, edge1X), _mm_mul_ps(tX, edge1Z));
+			__m128 qZ = _mm_sub_ps(_mm_mul_ps(tX, edge1Y), _mm_mul_ps(tY, edge1X));
+
+			__m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(directionX, qX), _mm_mul_ps(directionY, qY)), _mm_mul_ps(directionZ, qZ)), inverseDeterminant);
+			hits = _mm_and_ps(hits, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+
+			__m128 time = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(edge2X, qX), _mm_mul_ps(edge2Y, qY)), _mm_mul_ps(edge2Z, qZ)), inverseDeterminant);
+			hits = _mm_and_ps(hits, _mm_and_ps(_mm_cmpge_ps(time, zero), _mm_cmplt_ps(time, closestTime)));
+
+			int hitLanes = _mm_movemask_ps(hits);
+			if (hitLanes == 0)
+			{
+				continue;
+			}
+
+			closestTime = _mm_or_ps(_mm_and_ps(hits, time), _mm_andnot_ps(hits, closestTime));
+			closestU = _mm_or_ps(_mm_and_ps(hits, u), _mm_andnot_ps(hits, closestU));
+			closestV = _mm_or_ps(_mm_and_ps(hits, v), _mm_andnot_ps(hits, closestV));
+			__m128i hitsInt = _mm_castps_si128(hits);
+			closestTriangle = _mm_or_si128(_mm_and_si128(hitsInt, _mm_set1_epi32(triangleIndex)), _mm_andnot_si128(hitsInt, closestTriangle));
+
+			if (stopAtAnyHit)
+			{
+				//A lane is done once it hits anything
+				active = _mm_andnot_ps(hits, active);
+				activeLanes &= ~hitLanes;
+				if (activeLanes == 0)
+				{
+					break;
+				}
+			}
+		}
+	}
+
+	alignas(16) float times[4];
+	alignas(16) float us[4];
+	alignas(16) float vs[4];
+	alignas(16) int triangles[4];
+	_mm_store_ps(times, closestTime);
+	_mm_store_ps(us, closestU);
+	_mm_store_ps(vs, closestV);
+	_mm_store_si128(reinterpret_cast<__m128i*>(triangles), closestTriangle);
+
+	for (int laneIndex = 0; laneIndex < numRays; laneIndex++)
+	{
+		if (triangles[laneIndex] < 0)
+		{
+			continue;
+		}
+
+		if (outHits != nullptr)
+		{
+			FillHit(&outHits[laneIndex], rays[laneIndex], triangles[laneIndex], times[laneIndex], us[laneIndex], vs[laneIndex]);
+		}
+		if (outAnyHits != nullptr)
+		{
+			outAnyHits[laneIndex] = true;
+		}
+	}
+#else
+	for (int rayIndex = 0; rayIndex < numRays; rayIndex++)
+	{
+		if (outHits != nullptr)
+		{
+			TraceRay(&outHits[rayIndex], rays[rayIndex], maxTime, stopAtAnyHit);
+		}
+		if (outAnyHits != nullptr)
+		{
+			outAnyHits[rayIndex] = TraceRay(nullptr, rays[rayIndex], maxTime, stopAtAnyHit);
+		}
+	}
+#endif
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void MeshBVH::WriteToBuffer( BufferWriteUtils& writer ) const
+{
+	//Header, same layout as the PMSH v1 header
+	writer.AppendByte('P');
+	writer.AppendByte('B');
+	writer.AppendByte('V');
+	writer.AppendByte('H');
+	writer.AppendByte(0);
+	writer.AppendByte(1);
+	writer.AppendByte(1);
+	writer.AppendByte(static_cast<uchar>(writer.m_endianMode));
+
+	int numNodes = GetNumNodes();
+	int numTriangles = GetNumTriangles();
+	writer.AppendUint32(static_cast<uint>(numNodes));
+	writer.AppendUint32(static_cast<uint>(numTriangles));
+	writer.AppendUint32(m_sourceHash);
+
+	for (int nodeIndex = 0; nodeIndex < numNodes; nodeIndex++)
+	{
+		writer.AppendVec3(m_nodes[nodeIndex].m_mins);
+		writer.AppendInt32(m_nodes[nodeIndex].m_leftOrFirst);
+		writer.AppendVec3(m_nodes[nodeIndex].m_maxs);
+		writer.AppendInt32(m_nodes[nodeIndex].m_numTriangles);
+	}
+
+	for (int triangleIndex = 0; triangleIndex < numTriangles; triangleIndex++)
+	{
+		writer.AppendVec3(m_triangles[triangleIndex].m_vertex0);
+		writer.AppendVec3(m_triangles[triangleIndex].m_edge1);
+		writer.AppendVec3(m_triangles[triangleIndex].m_edge2);
+		writer.AppendInt32(m_triangleIds[triangleIndex]);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool MeshBVH::ReadFromBuffer( BufferReadUtils& reader, uint expectedSourceHash )
+{
+	Clear();
+
+	if (!reader.IsBufferDataAvailable(20))
+	{
+		return false;
+	}
+
+	uchar fourCC[4];
+	reader.ParseByteArray(fourCC, 4);
+	if (fourCC[0] != 'P' || fourCC[1] != 'B' || fourCC[2] != 'V' || fourCC[3] != 'H')
+	{
+		DebuggerPrintf("\n FourCC code mismatch for PBVH");
+		return false;
+	}
+
+	reader.ParseByte();
+	uchar versionMajor = reader.ParseByte();
+	uchar versionMinor = reader.ParseByte();
+	//1.0 had no source hash, so there is no telling what it was built from
+	if (versionMajor != 1 || versionMinor != 1)
+	{
+		DebuggerPrintf("\n Version mismatch for PBVH");
+		return false;
+	}
+
+	reader.SetEndianMode(static_cast<eBufferEndianness>(reader.ParseByte()));
+
+	int numNodes = static_cast<int>(reader.ParseUint32());
+	int numTriangles = static_cast<int>(reader.ParseUint32());
+	uint sourceHash = reader.ParseUint32();
+	if (sourceHash != expectedSourceHash)
+	{
+		DebuggerPrintf("\n PBVH was built from a different mesh");
+		return false;
+	}
+
+	//Node is 32 bytes and triangle 40 bytes on disk
+	if (!reader.IsBufferDataAvailable(static_cast<size_t>(numNodes) * 32 + static_cast<size_t>(numTriangles) * 40))
+	{
+		DebuggerPrintf("\n PBVH is truncated");
+		return false;
+	}
+
+	m_nodes.resize(numNodes);
+	for (int nodeIndex = 0; nodeIndex < numNodes; nodeIndex++)
+	{
+		m_nodes[nodeIndex].m_mins = reader.ParseVec3();
+		m_nodes[nodeIndex].m_leftOrFirst = reader.ParseInt32();
+		m_nodes[nodeIndex].m_maxs = reader.ParseVec3();
+		m_nodes[nodeIndex].m_numTriangles = reader.ParseInt32();
+	}
+
+	m_triangles.resize(numTriangles);
+	m_triangleIds.resize(numTriangles);
+	for (int triangleIndex = 0; triangleIndex < numTriangles; triangleIndex++)
+	{
+		m_triangles[triangleIndex].m_vertex0 = reader.ParseVec3();
+		m_triangles[triangleIndex].m_edge1 = reader.ParseVec3();
+		m_triangles[triangleIndex].m_edge2 = reader.ParseVec3();
+		m_triangleIds[triangleIndex] = reader.ParseInt32();
+	}
+
+	m_sourceHash = sourceHash;
+	return true;
+}
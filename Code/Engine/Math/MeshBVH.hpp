@@ -0,0 +1,95 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+//Engine Systems
+#include "Engine/Core/BufferUtilCommons.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include <vector>
+
+class BufferReadUtils;
+class BufferWriteUtils;
+class CPUMesh;
+struct Ray3D;
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct MeshRayHit
+{
+	float					m_time = 0.f;				// along the ray direction (a distance when the direction is normalized)
+	Vec3					m_position = Vec3::ZERO;
+	Vec3					m_normal = Vec3::ZERO;		// triangle normal, flipped to face the ray
+	float					m_u = 0.f;					// barycentric weights of the triangle's 2nd and 3rd vertex
+	float					m_v = 0.f;
+	int						m_triangleIndex = -1;		// triangle in the source mesh (first index / 3), -1 for a miss
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Bounding volume hierarchy over the triangles of a mesh for ray queries (picking, line of sight, baking)
+//
+// Built with a binned surface area heuristic. With numJobs > 1 the top of the tree is split on the calling thread and the
+// subtrees below it are built on the JobSystem generic threads. Triangles are stored in leaf order as a vertex and two
+// edges, so a leaf is a contiguous run ready for the ray/triangle test, and triangles are tested two sided.
+//
+// Batched queries trace rays in packets of 4 with SSE: a node is visited if any ray in the packet hits it. This pays off
+// for coherent rays (a screen tile, a light's shadow rays), incoherent rays are better off with the single ray calls.
+//------------------------------------------------------------------------------------------------------------------------------
+class MeshBVH
+{
+public:
+	MeshBVH();
+	~MeshBVH();
+
+	//Without indices every 3 positions are a triangle
+	void						Build(const Vec3* positions, int numPositions, const uint* indices, int numIndices, int numJobs = 1, int maxTrianglesPerLeaf = 4);
+	void						BuildFromCPUMesh(const CPUMesh& mesh, int numJobs = 1, int maxTrianglesPerLeaf = 4);
+	void						Clear();
+
+	bool						Raycast(MeshRayHit* outHit, const Ray3D& ray, float maxTime = MAX_RAY_TIME) const;
+	bool						RaycastAny(const Ray3D& ray, float maxTime = MAX_RAY_TIME) const;
+
+	//Fills one entry per ray, returns how many rays hit
+	int							RaycastBatch(MeshRayHit* outHits, const Ray3D* rays, int numRays, float maxTime = MAX_RAY_TIME) const;
+	int							RaycastAnyBatch(bool* outHits, const Ray3D* rays, int numRays, float maxTime = MAX_RAY_TIME) const;
+
+	//Binary BVH block ("PBVH" v1.1) so cooked meshes do not need to rebuild it on load. Reading fails if the block was
+	//built from triangles other than the ones expectedSourceHash was taken from
+	void						WriteToBuffer(BufferWriteUtils& writer) const;
+	bool						ReadFromBuffer(BufferReadUtils& reader, uint expectedSourceHash);
+
+	//FNV-1a over the triangle count and every corner position, the same triangles Build would read
+	static uint					HashSourceTriangles(const Vec3* positions, int numPositions, const uint* indices, int numIndices);
+	static uint					HashSourceTriangles(const CPUMesh& mesh);
+
+	inline int					GetNumNodes() const				{ return static_cast<int>(m_nodes.size()); }
+	inline int					GetNumTriangles() const			{ return static_cast<int>(m_triangles.size()); }
+	inline uint					GetSourceHash() const			{ return m_sourceHash; }
+	Vec3						GetMins() const;
+	Vec3						GetMaxs() const;
+
+	static constexpr float		MAX_RAY_TIME = 1e30f;
+
+public:
+	struct Node
+	{
+		Vec3					m_mins;
+		int						m_leftOrFirst = 0;			// first triangle for leaves, left child otherwise (right is left + 1)
+		Vec3					m_maxs;
+		int						m_numTriangles = 0;			// 0 for inner nodes
+	};
+
+	struct Triangle
+	{
+		Vec3					m_vertex0;
+		Vec3					m_edge1;
+		Vec3					m_edge2;
+	};
+
+private:
+	bool						TraceRay(MeshRayHit* outHit, const Ray3D& ray, float maxTime, bool stopAtAnyHit) const;
+	void						TracePacket(MeshRayHit* outHits, bool* outAnyHits, const Ray3D* rays, int numRays, float maxTime, bool stopAtAnyHit) const;
+	void						FillHit(MeshRayHit* outHit, const Ray3D& ray, int triangleIndex, float time, float u, float v) const;
+
+private:
+	std::vector<Node>			m_nodes;
+	std::vector<Triangle>		m_triangles;				// leaf order
+	std::vector<int>			m_triangleIds;				// leaf order to source triangle index
+	uint						m_sourceHash = 0U;			// HashSourceTriangles of what it was built from
+};
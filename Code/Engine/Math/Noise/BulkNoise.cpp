@@ -0,0 +1,622 @@
+//------------------------------------------------------------------------------------------------------------------------------
+// BulkNoise.cpp
+//
+#include "Engine/Math/Noise/BulkNoise.hpp"
+//Engine Systems
+#include "Engine/Core/JobSystem/Job.hpp"
+#include "Engine/Core/JobSystem/JobSystem.hpp"
+#include "Engine/Math/Noise/RawNoiseSSE.hpp"
+#include "Engine/Math/Noise/SmoothNoise.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+//Hashes and blends 4 positions per register when RAW_NOISE_USE_SSE is on. SSE2 has no floor so it is built from what it has
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Same constants as RawNoise.hpp and SmoothNoise.cpp, the bulk results have to match the single sample functions
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr int			NOISE_LANES = 4;
+constexpr float			OCTAVE_OFFSET = 0.636764989593174f;
+
+constexpr int			NOISE_PRIME1 = 198491317;
+constexpr int			NOISE_PRIME2 = 6542989;
+
+constexpr float			PERLIN_2D_RANGE_SCALE = (1.f / 0.662578106f);
+constexpr float			PERLIN_3D_RANGE_SCALE = (1.f / 0.793856621f);
+constexpr float			SQRT_3_OVER_3 = 0.5773502691896257645091f;
+
+//Compute2dPerlinNoise gradients split into X and Y tables for lane gathers
+static const float GRADIENTS_2D_X[8] = { +0.923879533f, +0.382683432f, -0.382683432f, -0.923879533f, -0.923879533f, -0.382683432f, +0.382683432f, +0.923879533f };
+static const float GRADIENTS_2D_Y[8] = { +0.382683432f, +0.923879533f, +0.923879533f, +0.382683432f, -0.382683432f, -0.923879533f, -0.923879533f, -0.382683432f };
+
+//------------------------------------------------------------------------------------------------------------------------------
+enum eBulkNoiseType
+{
+	BULK_NOISE_FRACTAL_2D,
+	BULK_NOISE_PERLIN_2D,
+	BULK_NOISE_FRACTAL_3D,
+	BULK_NOISE_PERLIN_3D
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Everything the octave loop needs that does not depend on the position, worked out once per call
+//------------------------------------------------------------------------------------------------------------------------------
+struct BulkNoiseSettings
+{
+	eBulkNoiseType		m_type = BULK_NOISE_FRACTAL_2D;
+
+	float				m_scale = 1.f;
+	float				m_invScale = 1.f;
+	unsigned int		m_numOctaves = 1;
+	float				m_octavePersistence = 0.5f;
+	float				m_octaveScale = 2.f;
+	bool				m_renormalize = true;
+	unsigned int		m_seed = 0;
+
+	std::vector<float>	m_octaveAmplitudes;
+	float				m_totalAmplitude = 0.f;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void MakeBulkNoiseSettings( BulkNoiseSettings* out, eBulkNoiseType type, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
+{
+	out->m_type = type;
+	out->m_scale = scale;
+	out->m_invScale = (1.f / scale);
+	out->m_numOctaves = numOctaves;
+	out->m_octavePersistence = octavePersistence;
+	out->m_octaveScale = octaveScale;
+	out->m_renormalize = renormalize;
+	out->m_seed = seed;
+
+	//Accumulated in the same order as the single sample functions so the totals match exactly
+	out->m_octaveAmplitudes.resize(numOctaves);
+	out->m_totalAmplitude = 0.f;
+
+	float currentAmplitude = 1.f;
+	for (unsigned int octaveNum = 0; octaveNum < numOctaves; ++octaveNum)
+	{
+		out->m_octaveAmplitudes[octaveNum] = currentAmplitude;
+		out->m_totalAmplitude += currentAmplitude;
+		currentAmplitude *= octavePersistence;
+	}
+}
+
+#if defined(RAW_NOISE_USE_SSE)
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Unsigned to [0,1]. The 16 bit halves convert exactly, so the sum rounds once like the scalar conversion does
+//------------------------------------------------------------------------------------------------------------------------------
+static inline __m128 NoiseUintToZeroToOne4( __m128i bits )
+{
+	__m128 high = _mm_cvtepi32_ps(_mm_srli_epi32(bits, 16));
+	__m128 low = _mm_cvtepi32_ps(_mm_and_si128(bits, _mm_set1_epi32(0xFFFF)));
+	__m128 value = _mm_add_ps(_mm_mul_ps(high, _mm_set1_ps(65536.f)), low);
+
+	return _mm_mul_ps(value, _mm_set1_ps(static_cast<float>(1.0 / static_cast<double>(0xFFFFFFFF))));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// floorf per lane, also returns the cell index as ints
+//------------------------------------------------------------------------------------------------------------------------------
+static inline __m128 Floor4( __m128 value, __m128i* outIndex )
+{
+	__m128i truncated = _mm_cvttps_epi32(value);
+	__m128 truncatedFloat = _mm_cvtepi32_ps(truncated);
+
+	//Truncation rounds negative values up, step those back one (the mask is -1 as an int)
+	__m128 roundedUp = _mm_cmpgt_ps(truncatedFloat, value);
+	*outIndex = _mm_add_epi32(truncated, _mm_castps_si128(roundedUp));
+
+	return _mm_sub_ps(truncatedFloat, _mm_and_ps(roundedUp, _mm_set1_ps(1.f)));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Matches SmoothStep3 in MathUtils term for term
+//------------------------------------------------------------------------------------------------------------------------------
+static inline __m128 SmoothStep3x4( __m128 t )
+{
+	__m128 cubed = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(3.f), t), t), t);
+	__m128 squared = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(2.f), t), t);
+	return _mm_sub_ps(cubed, squared);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static inline __m128 Lerp4( __m128 weightA, __m128 valueA, __m128 weightB, __m128 valueB )
+{
+	return _mm_add_ps(_mm_mul_ps(weightA, valueA), _mm_mul_ps(weightB, valueB));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Sign of each 3D Perlin gradient component comes from one hash bit (the gradient table is ordered that way)
+//------------------------------------------------------------------------------------------------------------------------------
+static inline __m128 GetPerlin3dDot4( __m128i hash, __m128 dx, __m128 dy, __m128 dz )
+{
+	__m128 gradient = _mm_set1_ps(SQRT_3_OVER_3);
+	__m128i bit0 = _mm_and_si128(hash, _mm_set1_epi32(1));
+	__m128i bit1 = _mm_and_si128(hash, _mm_set1_epi32(2));
+	__m128i bit2 = _mm_and_si128(hash, _mm_set1_epi32(4));
+
+	__m128 gradientX = _mm_xor_ps(gradient, _mm_castsi128_ps(_mm_slli_epi32(bit0, 31)));
+	__m128 gradientY = _mm_xor_ps(gradient, _mm_castsi128_ps(_mm_slli_epi32(bit1, 30)));
+	__m128 gradientZ = _mm_xor_ps(gradient, _mm_castsi128_ps(_mm_slli_epi32(bit2, 29)));
+
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(gradientX, dx), _mm_mul_ps(gradientY, dy)), _mm_mul_ps(gradientZ, dz));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static inline __m128 GetPerlin2dDot4( __m128i hash, __m128 dx, __m128 dy )
+{
+	alignas(16) unsigned int hashes[NOISE_LANES];
+	_mm_store_si128(reinterpret_cast<__m128i*>(hashes), _mm_and_si128(hash, _mm_set1_epi32(7)));
+
+	__m128 gradientX = _mm_setr_ps(GRADIENTS_2D_X[hashes[0]], GRADIENTS_2D_X[hashes[1]], GRADIENTS_2D_X[hashes[2]], GRADIENTS_2D_X[hashes[3]]);
+	__m128 gradientY = _mm_setr_ps(GRADIENTS_2D_Y[hashes[0]], GRADIENTS_2D_Y[hashes[1]], GRADIENTS_2D_Y[hashes[2]], GRADIENTS_2D_Y[hashes[3]]);
+
+	return _mm_add_ps(_mm_mul_ps(gradientX, dx), _mm_mul_ps(gradientY, dy));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// One octave of noise for 4 positions already in noise space
+//------------------------------------------------------------------------------------------------------------------------------
+static inline __m128 ComputeOctave2d4( eBulkNoiseType type, __m128 posX, __m128 posY, __m128i seed )
+{
+	__m128i indexWestX;
+	__m128i indexSouthY;
+	__m128 cellMinsX = Floor4(posX, &indexWestX);
+	__m128 cellMinsY = Floor4(posY, &indexSouthY);
+
+	//Neighbouring corners are one step apart in the hashed index, so one multiply covers all four
+	__m128i indexSW = _mm_add_epi32(indexWestX, MultiplyLow32(indexSouthY, _mm_set1_epi32(NOISE_PRIME1)));
+	__m128i indexSE = _mm_add_epi32(indexSW, _mm_set1_epi32(1));
+	__m128i indexNW = _mm_add_epi32(indexSW, _mm_set1_epi32(NOISE_PRIME1));
+	__m128i indexNE = _mm_add_epi32(indexNW, _mm_set1_epi32(1));
+
+	__m128i noiseSW = GetNoiseUint4(indexSW, seed);
+	__m128i noiseSE = GetNoiseUint4(indexSE, seed);
+	__m128i noiseNW = GetNoiseUint4(indexNW, seed);
+	__m128i noiseNE = GetNoiseUint4(indexNE, seed);
+
+	__m128 displacementX = _mm_sub_ps(posX, cellMinsX);
+	__m128 displacementY = _mm_sub_ps(posY, cellMinsY);
+
+	__m128 valueSW, valueSE, valueNW, valueNE;
+	if (type == BULK_NOISE_PERLIN_2D)
+	{
+		__m128 one = _mm_set1_ps(1.f);
+		__m128 displacementMaxX = _mm_sub_ps(posX, _mm_add_ps(cellMinsX, one));
+		__m128 displacementMaxY = _mm_sub_ps(posY, _mm_add_ps(cellMinsY, one));
+
+		valueSW = GetPerlin2dDot4(noiseSW, displacementX, displacementY);
+		valueSE = GetPerlin2dDot4(noiseSE, displacementMaxX, displacementY);
+		valueNW = GetPerlin2dDot4(noiseNW, displacementX, displacementMaxY);
+		valueNE = GetPerlin2dDot4(noiseNE, displacementMaxX, displacementMaxY);
+	}
+	else
+	{
+		valueSW = NoiseUintToZeroToOne4(noiseSW);
+		valueSE = NoiseUintToZeroToOne4(noiseSE);
+		valueNW = NoiseUintToZeroToOne4(noiseNW);
+		valueNE = NoiseUintToZeroToOne4(noiseNE);
+	}
+
+	__m128 weightEast = SmoothStep3x4(displacementX);
+	__m128 weightNorth = SmoothStep3x4(displacementY);
+	__m128 weightWest = _mm_sub_ps(_mm_set1_ps(1.f), weightEast);
+	__m128 weightSouth = _mm_sub_ps(_mm_set1_ps(1.f), weightNorth);
+
+	__m128 blendSouth = Lerp4(weightEast, valueSE, weightWest, valueSW);
+	__m128 blendNorth = Lerp4(weightEast, valueNE, weightWest, valueNW);
+	__m128 blendTotal = Lerp4(weightSouth, blendSouth, weightNorth, blendNorth);
+
+	if (type == BULK_NOISE_PERLIN_2D)
+	{
+		return _mm_mul_ps(blendTotal, _mm_set1_ps(PERLIN_2D_RANGE_SCALE));
+	}
+
+	return _mm_mul_ps(_mm_set1_ps(2.f), _mm_sub_ps(blendTotal, _mm_set1_ps(0.5f)));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static inline __m128 ComputeOctave3d4( eBulkNoiseType type, __m128 posX, __m128 posY, __m128 posZ, __m128i seed )
+{
+	__m128i indexWestX;
+	__m128i indexSouthY;
+	__m128i indexBelowZ;
+	__m128 cellMinsX = Floor4(posX, &indexWestX);
+	__m128 cellMinsY = Floor4(posY, &indexSouthY);
+	__m128 cellMinsZ = Floor4(posZ, &indexBelowZ);
+
+	__m128i stepX = _mm_set1_epi32(1);
+	__m128i stepY = _mm_set1_epi32(NOISE_PRIME1);
+	__m128i stepZ = _mm_set1_epi32(NOISE_PRIME2);
+
+	__m128i indexBelowSW = _mm_add_epi32(_mm_add_epi32(indexWestX, MultiplyLow32(indexSouthY, stepY)), MultiplyLow32(indexBelowZ, stepZ));
+	__m128i indexBelowSE = _mm_add_epi32(indexBelowSW, stepX);
+	__m128i indexBelowNW = _mm_add_epi32(indexBelowSW, stepY);
+	__m128i indexBelowNE = _mm_add_epi32(indexBelowNW, stepX);
+	__m128i indexAboveSW = _mm_add_epi32(indexBelowSW, stepZ);
+	__m128i indexAboveSE = _mm_add_epi32(indexAboveSW, stepX);
+	__m128i indexAboveNW = _mm_add_epi32(indexAboveSW, stepY);
+	__m128i indexAboveNE = _mm_add_epi32(indexAboveNW, stepX);
+
+	__m128i noiseBelowSW = GetNoiseUint4(indexBelowSW, seed);
+	__m128i noiseBelowSE = GetNoiseUint4(indexBelowSE, seed);
+	__m128i noiseBelowNW = GetNoiseUint4(indexBelowNW, seed);
+	__m128i noiseBelowNE = GetNoiseUint4(indexBelowNE, seed);
+	__m128i noiseAboveSW = GetNoiseUint4(indexAboveSW, seed);
+	__m128i noiseAboveSE = GetNoiseUint4(indexAboveSE, seed);
+	__m128i noiseAboveNW = GetNoiseUint4(indexAboveNW, seed);
+	__m128i noiseAboveNE = GetNoiseUint4(indexAboveNE, seed);
+
+	__m128 displacementX = _mm_sub_ps(posX, cellMinsX);
+	__m128 displacementY = _mm_sub_ps(posY, cellMinsY);
+	__m128 displacementZ = _mm_sub_ps(posZ, cellMinsZ);
+
+	__m128 valueBelowSW, valueBelowSE, valueBelowNW, valueBelowNE;
+	__m128 valueAboveSW, valueAboveSE, valueAboveNW, valueAboveNE;
+	if (type == BULK_NOISE_PERLIN_3D)
+	{
+		__m128 one = _mm_set1_ps(1.f);
+		__m128 displacementMaxX = _mm_sub_ps(posX, _mm_add_ps(cellMinsX, one));
+		__m128 displacementMaxY = _mm_sub_ps(posY, _mm_add_ps(cellMinsY, one));
+		__m128 displacementMaxZ = _mm_sub_ps(posZ, _mm_add_ps(cellMinsZ, one));
+
+		valueBelowSW = GetPerlin3dDot4(noiseBelowSW, displacementX, displacementY, displacementZ);
+		valueBelowSE = GetPerlin3dDot4(noiseBelowSE, displacementMaxX, displacementY, displacementZ);
+		valueBelowNW = GetPerlin3dDot4(noiseBelowNW, displacementX, displacementMaxY, displacementZ);
+		valueBelowNE = GetPerlin3dDot4(noiseBelowNE, displacementMaxX, displacementMaxY, displacementZ);
+		valueAboveSW = GetPerlin3dDot4(noiseAboveSW, displacementX, displacementY, displacementMaxZ);
+		valueAboveSE = GetPerlin3dDot4(noiseAboveSE, displacementMaxX, displacementY, displacementMaxZ);
+		valueAboveNW = GetPerlin3dDot4(noiseAboveNW, displacementX, displacementMaxY, displacementMaxZ);
+		valueAboveNE = GetPerlin3dDot4(noiseAboveNE, displacementMaxX, displacementMaxY, displacementMaxZ);
+	}
+	else
+	{
+		valueBelowSW = NoiseUintToZeroToOne4(noiseBelowSW);
+		valueBelowSE = NoiseUintToZeroToOne4(noiseBelowSE);
+		valueBelowNW = NoiseUintToZeroToOne4(noiseBelowNW);
+		valueBelowNE = NoiseUintToZeroToOne4(noiseBelowNE);
+		valueAboveSW = NoiseUintToZeroToOne4(noiseAboveSW);
+		valueAboveSE = NoiseUintToZeroToOne4(noiseAboveSE);
+		valueAboveNW = NoiseUintToZeroToOne4(noiseAboveNW);
+		valueAboveNE = NoiseUintToZeroToOne4(noiseAboveNE);
+	}
+
+	__m128 weightEast = SmoothStep3x4(displacementX);
+	__m128 weightNorth = SmoothStep3x4(displacementY);
+	__m128 weightAbove = SmoothStep3x4(displacementZ);
+	__m128 weightWest = _mm_sub_ps(_mm_set1_ps(1.f), weightEast);
+	__m128 weightSouth = _mm_sub_ps(_mm_set1_ps(1.f), weightNorth);
+	__m128 weightBelow = _mm_sub_ps(_mm_set1_ps(1.f), weightAbove);
+
+	// 8-way blend (8 -> 4 -> 2 -> 1)
+	__m128 blendBelowSouth = Lerp4(weightEast, valueBelowSE, weightWest, valueBelowSW);
+	__m128 blendBelowNorth = Lerp4(weightEast, valueBelowNE, weightWest, valueBelowNW);
+	__m128 blendAboveSouth = Lerp4(weightEast, valueAboveSE, weightWest, valueAboveSW);
+	__m128 blendAboveNorth = Lerp4(weightEast, valueAboveNE, weightWest, valueAboveNW);
+	__m128 blendBelow = Lerp4(weightSouth, blendBelowSouth, weightNorth, blendBelowNorth);
+	__m128 blendAbove = Lerp4(weightSouth, blendAboveSouth, weightNorth, blendAboveNorth);
+	__m128 blendTotal = Lerp4(weightBelow, blendBelow, weightAbove, blendAbove);
+
+	if (type == BULK_NOISE_PERLIN_3D)
+	{
+		return _mm_mul_ps(blendTotal, _mm_set1_ps(PERLIN_3D_RANGE_SCALE));
+	}
+
+	return _mm_mul_ps(_mm_set1_ps(2.f), _mm_sub_ps(blendTotal, _mm_set1_ps(0.5f)));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// All octaves for 4 positions. Octave amplitudes come from the settings, positions and seed step the same way the single
+// sample functions step them
+//------------------------------------------------------------------------------------------------------------------------------
+static void ComputeNoiseLanes( float* outValues, const float* posX, const float* posY, const float* posZ, const BulkNoiseSettings& settings )
+{
+	__m128 invScale = _mm_set1_ps(settings.m_invScale);
+	__m128 octaveScale = _mm_set1_ps(settings.m_octaveScale);
+	__m128 octaveOffset = _mm_set1_ps(OCTAVE_OFFSET);
+
+	__m128 currentX = _mm_mul_ps(_mm_loadu_ps(posX), invScale);
+	__m128 currentY = _mm_mul_ps(_mm_loadu_ps(posY), invScale);
+	__m128 currentZ = (posZ != nullptr) ? _mm_mul_ps(_mm_loadu_ps(posZ), invScale) : _mm_setzero_ps();
+	__m128 totalNoise = _mm_setzero_ps();
+
+	bool is3d = (settings.m_type == BULK_NOISE_FRACTAL_3D || settings.m_type == BULK_NOISE_PERLIN_3D);
+	unsigned int seed = settings.m_seed;
+
+	for (unsigned int octaveNum = 0; octaveNum < settings.m_numOctaves; ++octaveNum)
+	{
+		__m128i seedLanes = _mm_set1_epi32(static_cast<int>(seed));
+		__m128 noiseThisOctave;
+		if (is3d)
+		{
+			noiseThisOctave = ComputeOctave3d4(settings.m_type, currentX, currentY, currentZ, seedLanes);
+		}
+		else
+		{
+			noiseThisOctave = ComputeOctave2d4(settings.m_type, currentX, currentY, seedLanes);
+		}
+
+		totalNoise = _mm_add_ps(totalNoise, _mm_mul_ps(noiseThisOctave, _mm_set1_ps(settings.m_octaveAmplitudes[octaveNum])));
+
+		currentX = _mm_add_ps(_mm_mul_ps(currentX, octaveScale), octaveOffset);
+		currentY = _mm_add_ps(_mm_mul_ps(currentY, octaveScale), octaveOffset);
+		currentZ = _mm_add_ps(_mm_mul_ps(currentZ, octaveScale), octaveOffset);
+		++seed;
+	}
+
+	if (settings.m_renormalize && settings.m_totalAmplitude > 0.f)
+	{
+		totalNoise = _mm_div_ps(totalNoise, _mm_set1_ps(settings.m_totalAmplitude));
+		totalNoise = _mm_add_ps(_mm_mul_ps(totalNoise, _mm_set1_ps(0.5f)), _mm_set1_ps(0.5f));
+		totalNoise = SmoothStep3x4(totalNoise);
+		totalNoise = _mm_sub_ps(_mm_mul_ps(totalNoise, _mm_set1_ps(2.f)), _mm_set1_ps(1.f));
+	}
+
+	_mm_storeu_ps(outValues, totalNoise);
+}
+
+#else
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void ComputeNoiseLanes( float* outValues, const float* posX, const float* posY, const float* posZ, const BulkNoiseSettings& settings )
+{
+	for (int laneIndex = 0; laneIndex < NOISE_LANES; laneIndex++)
+	{
+		switch (settings.m_type)
+		{
+		case BULK_NOISE_FRACTAL_2D:
+		outValues[laneIndex] = Compute2dFractalNoise(posX[laneIndex], posY[laneIndex], settings.m_scale, settings.m_numOctaves, settings.m_octavePersistence, settings.m_octaveScale, settings.m_renormalize, settings.m_seed);
+		break;
+		case BULK_NOISE_PERLIN_2D:
+		outValues[laneIndex] = Compute2dPerlinNoise(posX[laneIndex], posY[laneIndex], settings.m_scale, settings.m_numOctaves, settings.m_octavePersistence, settings.m_octaveScale, settings.m_renormalize, settings.m_seed);
+		break;
+		case BULK_NOISE_FRACTAL_3D:
+		outValues[laneIndex] = Compute3dFractalNoise(posX[laneIndex], posY[laneIndex], posZ[laneIndex], settings.m_scale, settings.m_numOctaves, settings.m_octavePersistence, settings.m_octaveScale, settings.m_renormalize, settings.m_seed);
+		break;
+		case BULK_NOISE_PERLIN_3D:
+		outValues[laneIndex] = Compute3dPerlinNoise(posX[laneIndex], posY[laneIndex], posZ[laneIndex], settings.m_scale, settings.m_numOctaves, settings.m_octavePersistence, settings.m_octaveScale, settings.m_renormalize, settings.m_seed);
+		break;
+		}
+	}
+}
+
+#endif
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Grid rows are numY * numZ rows of numX values, jobs split on rows
+//------------------------------------------------------------------------------------------------------------------------------
+struct BulkNoiseGrid
+{
+	const BulkNoiseSettings*	m_settings = nullptr;
+	float*						m_outValues = nullptr;
+
+	int							m_numX = 0;
+	int							m_numY = 0;
+	int							m_numRows = 0;
+
+	float						m_mins[3] = { 0.f, 0.f, 0.f };
+	float						m_step[3] = { 0.f, 0.f, 0.f };
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void FillNoiseGridRows( const BulkNoiseGrid& grid, int firstRow, int endRow )
+{
+	float posX[NOISE_LANES];
+	float posY[NOISE_LANES];
+	float posZ[NOISE_LANES];
+	float values[NOISE_LANES];
+
+	for (int rowIndex = firstRow; rowIndex < endRow; rowIndex++)
+	{
+		int yIndex = rowIndex % grid.m_numY;
+		int zIndex = rowIndex / grid.m_numY;
+
+		float rowY = grid.m_mins[1] + grid.m_step[1] * static_cast<float>(yIndex);
+		float rowZ = grid.m_mins[2] + grid.m_step[2] * static_cast<float>(zIndex);
+		for (int laneIndex = 0; laneIndex < NOISE_LANES; laneIndex++)
+		{
+			posY[laneIndex] = rowY;
+			posZ[laneIndex] = rowZ;
+		}
+
+		float* rowValues = grid.m_outValues + rowIndex * grid.m_numX;
+		for (int xIndex = 0; xIndex < grid.m_numX; xIndex += NOISE_LANES)
+		{
+			//The last block repeats the row's last position in the unused lanes
+			int numValid = (grid.m_numX - xIndex < NOISE_LANES) ? grid.m_numX - xIndex : NOISE_LANES;
+			for (int laneIndex = 0; laneIndex < NOISE_LANES; laneIndex++)
+			{
+				int laneX = (laneIndex < numValid) ? xIndex + laneIndex : xIndex + numValid - 1;
+				posX[laneIndex] = grid.m_mins[0] + grid.m_step[0] * static_cast<float>(laneX);
+			}
+
+			ComputeNoiseLanes(values, posX, posY, posZ, *grid.m_settings);
+
+			for (int laneIndex = 0; laneIndex < numValid; laneIndex++)
+			{
+				rowValues[xIndex + laneIndex] = values[laneIndex];
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+class NoiseGridRowsJob : public Job
+{
+public:
+	NoiseGridRowsJob(const BulkNoiseGrid* grid, int firstRow, int endRow, std::atomic<int>* jobsRemaining)
+		: m_grid(grid), m_firstRow(firstRow), m_endRow(endRow), m_jobsRemaining(jobsRemaining)
+	{
+	}
+
+	void Execute()
+	{
+		FillNoiseGridRows(*m_grid, m_firstRow, m_endRow);
+
+		//Last thing we touch, the grid and counter belong to the waiting caller
+		m_jobsRemaining->fetch_sub(1);
+	}
+
+private:
+	const BulkNoiseGrid*	m_grid = nullptr;
+	int						m_firstRow = 0;
+	int						m_endRow = 0;
+	std::atomic<int>*		m_jobsRemaining = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void FillNoiseGrid( const BulkNoiseGrid& grid, int numJobs )
+{
+	if (grid.m_numX <= 0 || grid.m_numRows <= 0)
+	{
+		return;
+	}
+
+	if (numJobs > grid.m_numRows)
+	{
+		numJobs = grid.m_numRows;
+	}
+
+	if (numJobs <= 1)
+	{
+		FillNoiseGridRows(grid, 0, grid.m_numRows);
+		return;
+	}
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	std::atomic<int> jobsRemaining(numJobs - 1);
+
+	for (int jobIndex = 1; jobIndex < numJobs; jobIndex++)
+	{
+		int firstRow = (grid.m_numRows * jobIndex) / numJobs;
+		int endRow = (grid.m_numRows * (jobIndex + 1)) / numJobs;
+
+		jobSystem->Run(new NoiseGridRowsJob(&grid, firstRow, endRow, &jobsRemaining));
+	}
+
+	FillNoiseGridRows(grid, 0, grid.m_numRows / numJobs);
+
+	//Help with whatever is still queued rather than sleeping on it
+	while (jobsRemaining.load() > 0)
+	{
+		if (!jobSystem->ProcessCategory(JOB_GENERIC))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void ComputeNoiseGrid( eBulkNoiseType type, float* outValues, int numX, int numY, int numZ, const Vec3& mins, const Vec3& step, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, int numJobs )
+{
+	BulkNoiseSettings settings;
+	MakeBulkNoiseSettings(&settings, type, scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+
+	BulkNoiseGrid grid;
+	grid.m_settings = &settings;
+	grid.m_outValues = outValues;
+	grid.m_numX = numX;
+	grid.m_numY = numY;
+	grid.m_numRows = numY * numZ;
+	grid.m_mins[0] = mins.x;
+	grid.m_mins[1] = mins.y;
+	grid.m_mins[2] = mins.z;
+	grid.m_step[0] = step.x;
+	grid.m_step[1] = step.y;
+	grid.m_step[2] = step.z;
+
+	FillNoiseGrid(grid, numJobs);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void ComputeNoiseAtPositions( eBulkNoiseType type, float* outValues, const Vec2* positions2D, const Vec3* positions3D, int numPositions, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
+{
+	BulkNoiseSettings settings;
+	MakeBulkNoiseSettings(&settings, type, scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+
+	float posX[NOISE_LANES];
+	float posY[NOISE_LANES];
+	float posZ[NOISE_LANES];
+	float values[NOISE_LANES];
+
+	for (int positionIndex = 0; positionIndex < numPositions; positionIndex += NOISE_LANES)
+	{
+		int numValid = (numPositions - positionIndex < NOISE_LANES) ? numPositions - positionIndex : NOISE_LANES;
+		for (int laneIndex = 0; laneIndex < NOISE_LANES; laneIndex++)
+		{
+			int sourceIndex = (laneIndex < numValid) ? positionIndex + laneIndex : positionIndex + numValid - 1;
+			if (positions3D != nullptr)
+			{
+				posX[laneIndex] = positions3D[sourceIndex].x;
+				posY[laneIndex] = positions3D[sourceIndex].y;
+				posZ[laneIndex] = positions3D[sourceIndex].z;
+			}
+			else
+			{
+				posX[laneIndex] = positions2D[sourceIndex].x;
+				posY[laneIndex] = positions2D[sourceIndex].y;
+				posZ[laneIndex] = 0.f;
+			}
+		}
+
+		ComputeNoiseLanes(values, posX, posY, posZ, settings);
+
+		for (int laneIndex = 0; laneIndex < numValid; laneIndex++)
+		{
+			outValues[positionIndex + laneIndex] = values[laneIndex];
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void Compute2dFractalNoiseGrid( float* outValues, int numX, int numY, const Vec2& mins, const Vec2& step, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, int numJobs )
+{
+	ComputeNoiseGrid(BULK_NOISE_FRACTAL_2D, outValues, numX, numY, 1, Vec3(mins.x, mins.y, 0.f), Vec3(step.x, step.y, 0.f), scale, numOctaves, octavePersistence, octaveScale, renormalize, seed, numJobs);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void Compute2dPerlinNoiseGrid( float* outValues, int numX, int numY, const Vec2& mins, const Vec2& step, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, int numJobs )
+{
+	ComputeNoiseGrid(BULK_NOISE_PERLIN_2D, outValues, numX, numY, 1, Vec3(mins.x, mins.y, 0.f), Vec3(step.x, step.y, 0.f), scale, numOctaves, octavePersistence, octaveScale, renormalize, seed, numJobs);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void Compute3dFractalNoiseGrid( float* outValues, int numX, int numY, int numZ, const Vec3& mins, const Vec3& step, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, int numJobs )
+{
+	ComputeNoiseGrid(BULK_NOISE_FRACTAL_3D, outValues, numX, numY, numZ, mins, step, scale, numOctaves, octavePersistence, octaveScale, renormalize, seed, numJobs);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void Compute3dPerlinNoiseGrid( float* outValues, int numX, int numY, int numZ, const Vec3& mins, const Vec3& step, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, int numJobs )
+{
+	ComputeNoiseGrid(BULK_NOISE_PERLIN_3D, outValues, numX, numY, numZ, mins, step, scale, numOctaves, octavePersistence, octaveScale, renormalize, seed, numJobs);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void Compute2dFractalNoiseAtPositions( float* outValues, const Vec2* positions, int numPositions, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
+{
+	ComputeNoiseAtPositions(BULK_NOISE_FRACTAL_2D, outValues, positions, nullptr, numPositions, scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void Compute2dPerlinNoiseAtPositions( float* outValues, const Vec2* positions, int numPositions, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
+{
+	ComputeNoiseAtPositions(BULK_NOISE_PERLIN_2D, outValues, positions, nullptr, numPositions, scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void Compute3dFractalNoiseAtPositions( float* outValues, const Vec3* positions, int numPositions, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
+{
+	ComputeNoiseAtPositions(BULK_NOISE_FRACTAL_3D, outValues, nullptr, positions, numPositions, scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void Compute3dPerlinNoiseAtPositions( float* outValues, const Vec3* positions, int numPositions, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
+{
+	ComputeNoiseAtPositions(BULK_NOISE_PERLIN_3D, outValues, nullptr, positions, numPositions, scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+}
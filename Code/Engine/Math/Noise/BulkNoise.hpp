@@ -0,0 +1,36 @@
+//------------------------------------------------------------------------------------------------------------------------------
+// BulkNoise.hpp
+//
+#pragma once
+
+struct Vec2;
+struct Vec3;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Bulk versions of the SmoothNoise fractal and Perlin functions
+//
+// Every output value is the same noise the single sample function returns for that position (to float precision), but
+// 4 positions are evaluated at once with SSE2 and the per octave amplitude, seed and scale are worked out once per call
+// instead of once per sample. Build with ENGINE_DISABLE_SIMD to fall back to calling the single sample functions.
+//
+// Grids are written row major with X fastest: outValues[(z * numY + y) * numX + x] is the noise at
+// mins + (x * step.x, y * step.y, z * step.z). outValues must hold numX * numY (* numZ) floats.
+//
+// <numJobs>			Grids only. Values above 1 split the rows across that many jobs on the JobSystem generic threads.
+//						The calling thread runs one share itself and helps with the rest, so the call still returns
+//						with the whole grid filled.
+//
+// The remaining parameters mean the same as they do in SmoothNoise.hpp
+//------------------------------------------------------------------------------------------------------------------------------
+void Compute2dFractalNoiseGrid( float* outValues, int numX, int numY, const Vec2& mins, const Vec2& step, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0, int numJobs=1 );
+void Compute2dPerlinNoiseGrid( float* outValues, int numX, int numY, const Vec2& mins, const Vec2& step, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0, int numJobs=1 );
+void Compute3dFractalNoiseGrid( float* outValues, int numX, int numY, int numZ, const Vec3& mins, const Vec3& step, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0, int numJobs=1 );
+void Compute3dPerlinNoiseGrid( float* outValues, int numX, int numY, int numZ, const Vec3& mins, const Vec3& step, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0, int numJobs=1 );
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Noise at an arbitrary list of positions, outValues[i] is the noise at positions[i]
+//------------------------------------------------------------------------------------------------------------------------------
+void Compute2dFractalNoiseAtPositions( float* outValues, const Vec2* positions, int numPositions, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
+void Compute2dPerlinNoiseAtPositions( float* outValues, const Vec2* positions, int numPositions, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
+void Compute3dFractalNoiseAtPositions( float* outValues, const Vec3* positions, int numPositions, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
+void Compute3dPerlinNoiseAtPositions( float* outValues, const Vec3* positions, int numPositions, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
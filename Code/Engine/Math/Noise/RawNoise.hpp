@@ -60,6 +60,16 @@ constexpr float Get2dNoiseNegOneToOne( int indexX, int indexY, unsigned int seed
 constexpr float Get3dNoiseNegOneToOne( int indexX, int indexY, int indexZ, unsigned int seed=0 );
 constexpr float Get4dNoiseNegOneToOne( int indexX, int indexY, int indexZ, int indexT, unsigned int seed=0 );
 
+//-----------------------------------------------------------------------------------------------
+// Counter-based streams: (seed, stream, index) names one value, so any number of independent
+//	sequences (one per thread, job, particle system...) can be drawn from one seed without
+//	sharing state, and any value can be recomputed without generating the ones before it.
+//	Stream 0 is the plain 1d noise of the seed, so existing seeded sequences do not change.
+//
+constexpr unsigned int GetNoiseStreamSeed( unsigned int stream, unsigned int seed=0 );
+constexpr unsigned int GetStreamNoiseUint( int index, unsigned int stream, unsigned int seed=0 );
+constexpr float GetStreamNoiseZeroToOne( int index, unsigned int stream, unsigned int seed=0 );
+
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 // Inline function definitions below
@@ -180,3 +190,26 @@ constexpr float Get4dNoiseNegOneToOne( int indexX, int indexY, int indexZ, int i
 }
 
 
+//-----------------------------------------------------------------------------------------------
+// Hashes the stream into a seed for the 1d noise. The salt keeps stream seeds from lining up
+//	with the values of stream 0 (which are Get1dNoiseUint( index, seed )).
+//
+constexpr unsigned int GetNoiseStreamSeed( unsigned int stream, unsigned int seed )
+{
+	constexpr unsigned int STREAM_SALT = 0x9e3779b9; // 2^32 / golden ratio
+	return (stream == 0) ? seed : Get1dNoiseUint( (int) stream, seed + STREAM_SALT );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr unsigned int GetStreamNoiseUint( int index, unsigned int stream, unsigned int seed )
+{
+	return Get1dNoiseUint( index, GetNoiseStreamSeed( stream, seed ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+constexpr float GetStreamNoiseZeroToOne( int index, unsigned int stream, unsigned int seed )
+{
+	return Get1dNoiseZeroToOne( index, GetNoiseStreamSeed( stream, seed ) );
+}
@@ -0,0 +1,65 @@
+//------------------------------------------------------------------------------------------------------------------------------
+// RawNoiseSSE.hpp
+//
+#pragma once
+
+//------------------------------------------------------------------------------------------------------------------------------
+// SSE2 versions of the RawNoise.hpp hash, 4 indices at a time. Every lane is bit for bit the scalar Get1dNoiseUint.
+// Shared by the bulk noise and bulk random number functions. Build with ENGINE_DISABLE_SIMD to turn them off, callers
+// check RAW_NOISE_USE_SSE and fall back to the scalar functions.
+//------------------------------------------------------------------------------------------------------------------------------
+#if !defined(ENGINE_DISABLE_SIMD) && (defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__))
+#define RAW_NOISE_USE_SSE
+#include <emmintrin.h>
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Low 32 bits of a 32 x 32 multiply per lane (_mm_mullo_epi32 is SSE4.1)
+//------------------------------------------------------------------------------------------------------------------------------
+inline __m128i MultiplyLow32( __m128i a, __m128i b )
+{
+	__m128i evenLanes = _mm_mul_epu32(a, b);
+	__m128i oddLanes = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(evenLanes, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(oddLanes, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Get1dNoiseUint on 4 indices
+//------------------------------------------------------------------------------------------------------------------------------
+inline __m128i GetNoiseUint4( __m128i index, __m128i seed )
+{
+	constexpr unsigned int BIT_NOISE1 = 0xd2a80a23;
+	constexpr unsigned int BIT_NOISE2 = 0xa884f197;
+	constexpr unsigned int BIT_NOISE3 = 0x1b56c4e9;
+
+	__m128i mangledBits = MultiplyLow32(index, _mm_set1_epi32(static_cast<int>(BIT_NOISE1)));
+	mangledBits = _mm_add_epi32(mangledBits, seed);
+	mangledBits = _mm_xor_si128(mangledBits, _mm_srli_epi32(mangledBits, 7));
+	mangledBits = _mm_add_epi32(mangledBits, _mm_set1_epi32(static_cast<int>(BIT_NOISE2)));
+	mangledBits = _mm_xor_si128(mangledBits, _mm_srli_epi32(mangledBits, 8));
+	mangledBits = MultiplyLow32(mangledBits, _mm_set1_epi32(static_cast<int>(BIT_NOISE3)));
+	mangledBits = _mm_xor_si128(mangledBits, _mm_srli_epi32(mangledBits, 11));
+	return mangledBits;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Get1dNoiseZeroToOne on 4 hashed values, exactly. Flipping the sign bit makes the value a signed int 2^31 below the
+// unsigned one, which converts to double and adds back without rounding. The only roundings left are the double
+// multiply and the final narrowing, same as the scalar version.
+//------------------------------------------------------------------------------------------------------------------------------
+inline __m128 NoiseUintToZeroToOneExact4( __m128i bits )
+{
+	const __m128d oneOverMaxUint = _mm_set1_pd(1.0 / static_cast<double>(0xFFFFFFFF));
+	const __m128d signOffset = _mm_set1_pd(2147483648.0);
+
+	__m128i signedBits = _mm_xor_si128(bits, _mm_set1_epi32(static_cast<int>(0x80000000)));
+
+	__m128d valueLow = _mm_add_pd(_mm_cvtepi32_pd(signedBits), signOffset);
+	__m128d valueHigh = _mm_add_pd(_mm_cvtepi32_pd(_mm_srli_si128(signedBits, 8)), signOffset);
+
+	__m128 floatsLow = _mm_cvtpd_ps(_mm_mul_pd(valueLow, oneOverMaxUint));
+	__m128 floatsHigh = _mm_cvtpd_ps(_mm_mul_pd(valueHigh, oneOverMaxUint));
+	return _mm_movelh_ps(floatsLow, floatsHigh);
+}
+
+#endif
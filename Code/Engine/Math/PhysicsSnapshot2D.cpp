@@ -0,0 +1,413 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Math/PhysicsSnapshot2D.hpp"
+#include "Engine/Commons/ErrorWarningAssert.hpp"
+#include "Engine/Core/BufferReadUtils.hpp"
+#include "Engine/Core/BufferWriteUtils.hpp"
+#include "Engine/Math/Collider2D.hpp"
+#include "Engine/Math/ContactReport2D.hpp"
+#include "Engine/Math/PhysicsSystem.hpp"
+#include "Engine/Math/RigidBodyBucket.hpp"
+#include "Engine/Math/Rigidbody2D.hpp"
+#include "Engine/Math/Trigger2D.hpp"
+#include "Engine/Math/TriggerBucket.hpp"
+#include "Engine/Math/TriggerTouch2D.hpp"
+#include <algorithm>
+#include <climits>
+
+//------------------------------------------------------------------------------------------------------------------------------
+PhysicsSnapshot2D::PhysicsSnapshot2D( PhysicsSystem* physicsSystem, int historySize )
+{
+	m_system = physicsSystem;
+
+	GUARANTEE_OR_DIE(historySize > 0, "Physics snapshot history needs at least 1 frame");
+	m_history.resize(historySize);
+	m_historyFrames.resize(historySize, UINT_MAX);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+PhysicsSnapshot2D::~PhysicsSnapshot2D()
+{
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PhysicsSnapshot2D::SaveFrame()
+{
+	uint frameCount = m_system->m_frameCount;
+	int slot = static_cast<int>(frameCount % static_cast<uint>(m_history.size()));
+
+	//clear() keeps the capacity, so after the first few frames nothing is allocated
+	m_history[slot].clear();
+	WriteState(m_history[slot]);
+	m_historyFrames[slot] = frameCount;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool PhysicsSnapshot2D::HasFrame( uint frameCount ) const
+{
+	int slot = static_cast<int>(frameCount % static_cast<uint>(m_history.size()));
+	return m_historyFrames[slot] == frameCount;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool PhysicsSnapshot2D::RestoreFrame( uint frameCount )
+{
+	if (!HasFrame(frameCount))
+	{
+		return false;
+	}
+
+	int slot = static_cast<int>(frameCount % static_cast<uint>(m_history.size()));
+	ReadState(m_history[slot]);
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PhysicsSnapshot2D::BuildColliderTable()
+{
+	m_colliders.clear();
+	m_sortedColliders.clear();
+
+	RigidBodyBucket* bucket = m_system->m_rbBucket;
+	for (int rbType = 0; rbType < NUM_SIMULATION_TYPES; rbType++)
+	{
+		int numRigidbodies = static_cast<int>(bucket->m_RbBucket[rbType].size());
+		for (int rbIndex = 0; rbIndex < numRigidbodies; rbIndex++)
+		{
+			Rigidbody2D* rigidbody = bucket->m_RbBucket[rbType][rbIndex];
+			Collider2D* collider = (rigidbody != nullptr) ? rigidbody->m_collider : nullptr;
+
+			m_colliders.push_back(collider);
+			if (collider != nullptr)
+			{
+				m_sortedColliders.push_back(std::make_pair(collider, static_cast<int>(m_colliders.size()) - 1));
+			}
+		}
+	}
+
+	std::sort(m_sortedColliders.begin(), m_sortedColliders.end());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int PhysicsSnapshot2D::GetColliderIndex( Collider2D* collider ) const
+{
+	auto itr = std::lower_bound(m_sortedColliders.begin(), m_sortedColliders.end(), std::make_pair(collider, -1));
+	if (itr == m_sortedColliders.end() || itr->first != collider)
+	{
+		return -1;
+	}
+
+	return itr->second;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Collider2D* PhysicsSnapshot2D::GetColliderAtIndex( int colliderIndex ) const
+{
+	if (colliderIndex < 0 || colliderIndex >= static_cast<int>(m_colliders.size()))
+	{
+		return nullptr;
+	}
+
+	return m_colliders[colliderIndex];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PhysicsSnapshot2D::AppendTransform( BufferWriteUtils& writer, const Transform2& transform )
+{
+	writer.AppendVec2(transform.m_position);
+	writer.AppendFloat(transform.m_rotation);
+	writer.AppendVec2(transform.m_scale);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PhysicsSnapshot2D::ParseTransform( BufferReadUtils& reader, Transform2* out )
+{
+	out->m_position = reader.ParseVec2();
+	out->m_rotation = reader.ParseFloat();
+	out->m_scale = reader.ParseVec2();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PhysicsSnapshot2D::WriteState( Buffer& out )
+{
+	BuildColliderTable();
+
+	BufferWriteUtils writer(out);
+
+	//System
+	writer.AppendUint32(m_system->m_frameCount);
+	writer.AppendFloat(m_system->m_timeAccumulator);
+	writer.AppendVec2(m_system->m_gravity);
+
+	//Rigidbodies, in bucket order
+	RigidBodyBucket* bucket = m_system->m_rbBucket;
+	for (int rbType = 0; rbType < NUM_SIMULATION_TYPES; rbType++)
+	{
+		int numRigidbodies = static_cast<int>(bucket->m_RbBucket[rbType].size());
+		writer.AppendUint32(numRigidbodies);
+
+		for (int rbIndex = 0; rbIndex < numRigidbodies; rbIndex++)
+		{
+			Rigidbody2D* rigidbody = bucket->m_RbBucket[rbType][rbIndex];
+			writer.AppendBool(rigidbody != nullptr);
+			if (rigidbody == nullptr)
+			{
+				continue;
+			}
+
+			AppendTransform(writer, rigidbody->m_transform);
+			AppendTransform(writer, rigidbody->m_previousTransform);
+			AppendTransform(writer, rigidbody->m_interpolatedTransform);
+
+			writer.AppendVec2(rigidbody->m_velocity);
+			writer.AppendFloat(rigidbody->m_angularVelocity);
+			writer.AppendFloat(rigidbody->m_rotation);
+			writer.AppendVec2(rigidbody->m_frameForces);
+			writer.AppendFloat(rigidbody->m_frameTorque);
+			writer.AppendBool(rigidbody->m_isAlive);
+			writer.AppendBool(rigidbody->m_collider != nullptr && rigidbody->m_collider->m_inCollision);
+		}
+	}
+
+	//Trigger touches, colliders saved as table indices
+	TriggerBucket* triggers = m_system->m_triggerBucket;
+	for (int triggerType = 0; triggerType < NUM_SIMULATION_TYPES; triggerType++)
+	{
+		int numTriggers = static_cast<int>(triggers->m_triggerBucket[triggerType].size());
+		writer.AppendUint32(numTriggers);
+
+		for (int triggerIndex = 0; triggerIndex < numTriggers; triggerIndex++)
+		{
+			Trigger2D* trigger = triggers->m_triggerBucket[triggerType][triggerIndex];
+			int numTouches = (trigger != nullptr) ? static_cast<int>(trigger->m_touches.size()) : 0;
+			writer.AppendUint32(numTouches);
+
+			for (int touchIndex = 0; touchIndex < numTouches; touchIndex++)
+			{
+				TriggerTouch2D* touch = trigger->m_touches[touchIndex];
+				writer.AppendInt32(GetColliderIndex(touch->GetCollider()));
+				writer.AppendUint32(touch->GetEntryFrame());
+				writer.AppendUint32(touch->GetCurrentFrame());
+			}
+		}
+	}
+
+	//Contacts the next step compares against for begin/persist/end, written by collider index so the bytes only depend on
+	//the simulation and not on the order the report keeps them in
+	std::vector<Contact2D>& contacts = m_sortedContacts;
+	contacts = m_system->m_contactReport->m_previousContacts;
+	std::sort(contacts.begin(), contacts.end(), [this](const Contact2D& a, const Contact2D& b)
+	{
+		int colliderA = GetColliderIndex(a.m_collider);
+		int colliderB = GetColliderIndex(b.m_collider);
+		if (colliderA != colliderB)
+		{
+			return colliderA < colliderB;
+		}
+
+		return GetColliderIndex(a.m_otherCollider) < GetColliderIndex(b.m_otherCollider);
+	});
+
+	int numContacts = static_cast<int>(contacts.size());
+	writer.AppendUint32(numContacts);
+
+	for (int contactIndex = 0; contactIndex < numContacts; contactIndex++)
+	{
+		writer.AppendInt32(GetColliderIndex(contacts[contactIndex].m_collider));
+		writer.AppendInt32(GetColliderIndex(contacts[contactIndex].m_otherCollider));
+		writer.AppendVec2(contacts[contactIndex].m_manifold.m_normal);
+		writer.AppendFloat(contacts[contactIndex].m_manifold.m_penetration);
+		writer.AppendVec2(contacts[contactIndex].m_manifold.m_contact);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PhysicsSnapshot2D::ReadState( const Buffer& buffer )
+{
+	BuildColliderTable();
+
+	BufferReadUtils reader(buffer);
+
+	//System
+	m_system->m_frameCount = reader.ParseUint32();
+	m_system->m_timeAccumulator = reader.ParseFloat();
+	m_system->m_gravity = reader.ParseVec2();
+
+	//Rigidbodies
+	RigidBodyBucket* bucket = m_system->m_rbBucket;
+	for (int rbType = 0; rbType < NUM_SIMULATION_TYPES; rbType++)
+	{
+		int numRigidbodies = static_cast<int>(reader.ParseUint32());
+		GUARANTEE_OR_DIE(numRigidbodies == static_cast<int>(bucket->m_RbBucket[rbType].size()), "Physics snapshot was taken with a different set of rigidbodies");
+
+		for (int rbIndex = 0; rbIndex < numRigidbodies; rbIndex++)
+		{
+			Rigidbody2D* rigidbody = bucket->m_RbBucket[rbType][rbIndex];
+			bool wasPresent = reader.ParseBool();
+			GUARANTEE_OR_DIE(wasPresent == (rigidbody != nullptr), "Physics snapshot was taken with a different set of rigidbodies");
+			if (rigidbody == nullptr)
+			{
+				continue;
+			}
+
+			ParseTransform(reader, &rigidbody->m_transform);
+			ParseTransform(reader, &rigidbody->m_previousTransform);
+			ParseTransform(reader, &rigidbody->m_interpolatedTransform);
+
+			rigidbody->m_velocity = reader.ParseVec2();
+			rigidbody->m_angularVelocity = reader.ParseFloat();
+			rigidbody->m_rotation = reader.ParseFloat();
+			rigidbody->m_frameForces = reader.ParseVec2();
+			rigidbody->m_frameTorque = reader.ParseFloat();
+			rigidbody->m_isAlive = reader.ParseBool();
+			bool inCollision = reader.ParseBool();
+
+			if (rigidbody->m_collider != nullptr)
+			{
+				rigidbody->m_collider->SetCollision(inCollision);
+				rigidbody->ApplyRotation();
+			}
+
+			//Show the restored pose, and make sure it isn't read back as the game moving the object
+			if (rigidbody->m_object_transform != nullptr)
+			{
+				*rigidbody->m_object_transform = rigidbody->m_interpolatedTransform;
+			}
+		}
+	}
+
+	//Trigger touches
+	TriggerBucket* triggers = m_system->m_triggerBucket;
+	for (int triggerType = 0; triggerType < NUM_SIMULATION_TYPES; triggerType++)
+	{
+		int numTriggers = static_cast<int>(reader.ParseUint32());
+		GUARANTEE_OR_DIE(numTriggers == static_cast<int>(triggers->m_triggerBucket[triggerType].size()), "Physics snapshot was taken with a different set of triggers");
+
+		for (int triggerIndex = 0; triggerIndex < numTriggers; triggerIndex++)
+		{
+			Trigger2D* trigger = triggers->m_triggerBucket[triggerType][triggerIndex];
+			int numTouches = static_cast<int>(reader.ParseUint32());
+
+			if (trigger != nullptr)
+			{
+				for (int touchIndex = 0; touchIndex < static_cast<int>(trigger->m_touches.size()); touchIndex++)
+				{
+					delete trigger->m_touches[touchIndex];
+				}
+				trigger->m_touches.clear();
+			}
+
+			for (int touchIndex = 0; touchIndex < numTouches; touchIndex++)
+			{
+				Collider2D* collider = GetColliderAtIndex(reader.ParseInt32());
+				uint entryFrame = reader.ParseUint32();
+				uint currentFrame = reader.ParseUint32();
+
+				if (trigger != nullptr && collider != nullptr)
+				{
+					TriggerTouch2D* touch = new TriggerTouch2D(collider, entryFrame);
+					touch->SetCurrentFrame(currentFrame);
+					trigger->m_touches.push_back(touch);
+				}
+			}
+		}
+	}
+
+	//Contacts
+	std::vector<Contact2D>& contacts = m_system->m_contactReport->m_previousContacts;
+	contacts.clear();
+
+	int numContacts = static_cast<int>(reader.ParseUint32());
+	for (int contactIndex = 0; contactIndex < numContacts; contactIndex++)
+	{
+		Contact2D contact;
+		contact.m_collider = GetColliderAtIndex(reader.ParseInt32());
+		contact.m_otherCollider = GetColliderAtIndex(reader.ParseInt32());
+		contact.m_manifold.m_normal = reader.ParseVec2();
+		contact.m_manifold.m_penetration = reader.ParseFloat();
+		contact.m_manifold.m_contact = reader.ParseVec2();
+
+		if (contact.m_collider != nullptr && contact.m_otherCollider != nullptr)
+		{
+			contacts.push_back(contact);
+		}
+	}
+
+	//Back into the order the report walks them in
+	ContactReport2D::SortByPair(contacts);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC uint PhysicsSnapshot2D::HashState( const Buffer& buffer )
+{
+	uint hash = 2166136261U;
+
+	int numBytes = static_cast<int>(buffer.size());
+	for (int byteIndex = 0; byteIndex < numBytes; byteIndex++)
+	{
+		hash ^= buffer[byteIndex];
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+PhysicsDeterminismChecker2D::PhysicsDeterminismChecker2D( PhysicsSystem* physicsSystem )
+	:	m_snapshot(physicsSystem, 1)
+{
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+PhysicsDeterminismChecker2D::~PhysicsDeterminismChecker2D()
+{
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PhysicsDeterminismChecker2D::StartRecording()
+{
+	m_frameHashes.clear();
+	m_isRecording = true;
+	m_hasMismatch = false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PhysicsDeterminismChecker2D::StartVerifying()
+{
+	m_isRecording = false;
+	m_hasMismatch = false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool PhysicsDeterminismChecker2D::CheckFrame()
+{
+	m_scratch.clear();
+	m_snapshot.WriteState(m_scratch);
+
+	//Frame count is the first thing in the snapshot
+	uint frameCount = *reinterpret_cast<const uint*>(m_scratch.data());
+	uint hash = PhysicsSnapshot2D::HashState(m_scratch);
+
+	if (m_isRecording)
+	{
+		m_frameHashes[frameCount] = hash;
+		return true;
+	}
+
+	std::map<uint, uint>::const_iterator itr = m_frameHashes.find(frameCount);
+	if (itr == m_frameHashes.end() || itr->second == hash)
+	{
+		return true;
+	}
+
+	if (!m_hasMismatch)
+	{
+		m_hasMismatch = true;
+		m_firstMismatchFrame = frameCount;
+		DebuggerPrintf("\n Physics desync at frame %u: recorded hash %08x, got %08x", frameCount, itr->second, hash);
+	}
+
+	return false;
+}
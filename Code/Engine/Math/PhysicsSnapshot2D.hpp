@@ -0,0 +1,90 @@
+#pragma once
+//------------------------------------------------------------------------------------------------------------------------------
+//Engine Systems
+#include "Engine/Core/BufferUtilCommons.hpp"
+#include <map>
+#include <vector>
+
+class BufferReadUtils;
+class BufferWriteUtils;
+class Collider2D;
+class PhysicsSystem;
+struct Contact2D;
+struct Transform2;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Binary snapshots of the 2D simulation state for rollback and replays
+//
+// A snapshot holds everything a step changes: rigidbody transforms and velocities, collision flags, trigger touches and
+// the contacts the contact report compares against. Shapes, masses and materials are setup data and are not saved.
+// Colliders are saved as indices into the rigidbody buckets, so a snapshot can only be restored into the same set of
+// bodies it was taken from (no bodies created or destroyed in between).
+//
+// SaveFrame keeps the last historySize frames in reused buffers. To roll back, RestoreFrame to the frame you need and
+// run Update(m_fixedTimeStep) once per frame you want to resimulate.
+//------------------------------------------------------------------------------------------------------------------------------
+class PhysicsSnapshot2D
+{
+public:
+	explicit PhysicsSnapshot2D(PhysicsSystem* physicsSystem, int historySize = 8);
+	~PhysicsSnapshot2D();
+
+	void						SaveFrame();
+	bool						RestoreFrame(uint frameCount);
+	bool						HasFrame(uint frameCount) const;
+
+	void						WriteState(Buffer& out);
+	void						ReadState(const Buffer& buffer);
+
+	static uint					HashState(const Buffer& buffer);	// FNV-1a over the snapshot bytes
+
+private:
+	void						BuildColliderTable();
+	int							GetColliderIndex(Collider2D* collider) const;
+	Collider2D*					GetColliderAtIndex(int colliderIndex) const;
+
+	static void					AppendTransform(BufferWriteUtils& writer, const Transform2& transform);
+	static void					ParseTransform(BufferReadUtils& reader, Transform2* out);
+
+private:
+	PhysicsSystem*				m_system = nullptr;
+
+	std::vector<Buffer>			m_history;
+	std::vector<uint>			m_historyFrames;
+
+	//Collider pointers sorted for lookup, and in bucket order for the reverse
+	std::vector<std::pair<Collider2D*, int>>	m_sortedColliders;
+	std::vector<Collider2D*>	m_colliders;
+
+	//Contacts reordered by collider index for writing, reused between writes
+	std::vector<Contact2D>		m_sortedContacts;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Records a hash of the simulation state every frame on one run, then compares on later runs (replays, other machines
+// fed the same inputs) and reports the first frame that does not match.
+//------------------------------------------------------------------------------------------------------------------------------
+class PhysicsDeterminismChecker2D
+{
+public:
+	explicit PhysicsDeterminismChecker2D(PhysicsSystem* physicsSystem);
+	~PhysicsDeterminismChecker2D();
+
+	void						StartRecording();
+	void						StartVerifying();
+
+	bool						CheckFrame();						// call once after each physics step
+
+	inline bool					HasMismatch() const					{ return m_hasMismatch; }
+	inline uint					GetFirstMismatchFrame() const		{ return m_firstMismatchFrame; }
+	inline const std::map<uint, uint>&	GetFrameHashes() const		{ return m_frameHashes; }
+
+private:
+	PhysicsSnapshot2D			m_snapshot;
+	Buffer						m_scratch;
+
+	std::map<uint, uint>		m_frameHashes;
+	bool						m_isRecording = true;
+	bool						m_hasMismatch = false;
+	uint						m_firstMismatchFrame = 0U;
+};
@@ -1,9 +1,14 @@
 //------------------------------------------------------------------------------------------------------------------------------
 #include "Engine/Math/PhysicsSystem.hpp"
+#include "Engine/Core/Clock.hpp"
 #include "Engine/Core/EventSystems.hpp"
 #include "Engine/Core/NamedProperties.hpp"
+#include "Engine/Core/Time.hpp"
 #include "Engine/Math/Collider2D.hpp"
+#include "Engine/Math/CollisionBatch2D.hpp"
 #include "Engine/Math/CollisionHandler.hpp"
+#include "Engine/Math/ContactReport2D.hpp"
+#include "Engine/Math/ContinuousCollision2D.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/RigidBodyBucket.hpp"
 #include "Engine/Math/Rigidbody2D.hpp"
@@ -18,12 +23,18 @@ PhysicsSystem::PhysicsSystem()
 {
 	m_rbBucket = new RigidBodyBucket;
 	m_triggerBucket = new TriggerBucket;
+	m_collisionBatch = new CollisionBatch2D;
+	m_contactReport = new ContactReport2D;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
 PhysicsSystem::~PhysicsSystem()
 {
+	delete m_collisionBatch;
+	m_collisionBatch = nullptr;
 
+	delete m_contactReport;
+	m_contactReport = nullptr;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -106,6 +117,12 @@ void PhysicsSystem::CopyTransformsToObjects()
 //------------------------------------------------------------------------------------------------------------------------------
 void PhysicsSystem::Update( float deltaTime )
 {
+	if (m_fixedTimeStep > 0.f)
+	{
+		RunFixedSteps(deltaTime);
+		return;
+	}
+
 	CopyTransformsFromObjects(); 
 
 	SetAllCollisionsToFalse();
@@ -115,6 +132,136 @@ void PhysicsSystem::Update( float deltaTime )
 	CopyTransformsToObjects();  
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+void PhysicsSystem::Update( Clock* clock )
+{
+	//Frame time is already dilated by the clock and 0 while it is paused, so paused physics keeps its last interpolated pose
+	Update(static_cast<float>(clock->GetFrameTime()));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PhysicsSystem::SetFixedTimeStep( float fixedTimeStep, int maxSubsteps )
+{
+	m_fixedTimeStep = fixedTimeStep;
+	m_maxSubsteps = maxSubsteps;
+	m_timeAccumulator = 0.f;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PhysicsSystem::RunFixedSteps( float deltaTime )
+{
+	CopyMovedTransformsFromObjects();
+
+	m_timeAccumulator += deltaTime;
+
+	double startTime = GetCurrentTimeSeconds();
+	int numSteps = 0;
+
+	while (m_timeAccumulator >= m_fixedTimeStep && numSteps < m_maxSubsteps)
+	{
+		StorePreviousTransforms();
+
+		SetAllCollisionsToFalse();
+		RunStep(m_fixedTimeStep);
+
+		m_timeAccumulator -= m_fixedTimeStep;
+		numSteps++;
+
+		if (m_substepBudgetSeconds > 0.0 && GetCurrentTimeSeconds() - startTime > m_substepBudgetSeconds)
+		{
+			break;
+		}
+	}
+
+	//Out of substeps or budget: drop the backlog instead of trying to catch up next frame
+	if (m_timeAccumulator >= m_fixedTimeStep)
+	{
+		m_timeAccumulator = fmodf(m_timeAccumulator, m_fixedTimeStep);
+	}
+
+	m_lastNumSubsteps = numSteps;
+	m_lastStepSeconds = GetCurrentTimeSeconds() - startTime;
+
+	CopyInterpolatedTransformsToObjects(m_timeAccumulator / m_fixedTimeStep);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Objects hold interpolated transforms between steps, so only take the object's transform if the game moved it
+//------------------------------------------------------------------------------------------------------------------------------
+void PhysicsSystem::CopyMovedTransformsFromObjects()
+{
+	for(int rigidTypes = 0; rigidTypes < NUM_SIMULATION_TYPES; rigidTypes++)
+	{
+		int numRigidbodies = static_cast<int>(m_rbBucket->m_RbBucket[rigidTypes].size());
+
+		for(int rigidbodyIndex = 0; rigidbodyIndex < numRigidbodies; rigidbodyIndex++)
+		{
+			Rigidbody2D* rigidbody = m_rbBucket->m_RbBucket[rigidTypes][rigidbodyIndex];
+			if(rigidbody == nullptr)
+			{
+				continue;
+			}
+
+			const Transform2& objectTransform = *rigidbody->m_object_transform;
+			const Transform2& written = rigidbody->m_interpolatedTransform;
+
+			if (objectTransform.m_position != written.m_position || objectTransform.m_rotation != written.m_rotation || objectTransform.m_scale != written.m_scale)
+			{
+				rigidbody->m_transform = objectTransform;
+				rigidbody->m_previousTransform = objectTransform;
+				rigidbody->m_previousTransform.m_rotation = rigidbody->m_rotation;
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PhysicsSystem::StorePreviousTransforms()
+{
+	for(int rigidTypes = 0; rigidTypes < NUM_SIMULATION_TYPES; rigidTypes++)
+	{
+		int numRigidbodies = static_cast<int>(m_rbBucket->m_RbBucket[rigidTypes].size());
+
+		for(int rigidbodyIndex = 0; rigidbodyIndex < numRigidbodies; rigidbodyIndex++)
+		{
+			Rigidbody2D* rigidbody = m_rbBucket->m_RbBucket[rigidTypes][rigidbodyIndex];
+			if(rigidbody != nullptr)
+			{
+				rigidbody->m_previousTransform = rigidbody->m_transform;
+				rigidbody->m_previousTransform.m_rotation = rigidbody->m_rotation;
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PhysicsSystem::CopyInterpolatedTransformsToObjects( float alpha )
+{
+	for(int rigidTypes = 0; rigidTypes < NUM_SIMULATION_TYPES; rigidTypes++)
+	{
+		int numRigidbodies = static_cast<int>(m_rbBucket->m_RbBucket[rigidTypes].size());
+
+		for(int rigidbodyIndex = 0; rigidbodyIndex < numRigidbodies; rigidbodyIndex++)
+		{
+			Rigidbody2D* rigidbody = m_rbBucket->m_RbBucket[rigidTypes][rigidbodyIndex];
+			if(rigidbody == nullptr)
+			{
+				continue;
+			}
+
+			const Transform2& previous = rigidbody->m_previousTransform;
+
+			Transform2 interpolated = rigidbody->m_transform;
+			interpolated.m_position = previous.m_position + (rigidbody->m_transform.m_position - previous.m_position) * alpha;
+			interpolated.m_rotation = previous.m_rotation + (rigidbody->m_rotation - previous.m_rotation) * alpha;
+
+			*rigidbody->m_object_transform = interpolated;
+			rigidbody->m_interpolatedTransform = interpolated;
+			rigidbody->m_transform.m_rotation = rigidbody->m_rotation;
+		}
+	}
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 void PhysicsSystem::SetAllCollisionsToFalse()
 {
@@ -303,6 +450,12 @@ const Vec2& PhysicsSystem::GetGravity() const
 	return m_gravity;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+const ContactReport2D& PhysicsSystem::GetContactReport() const
+{
+	return *m_contactReport;
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 void PhysicsSystem::RunStep( float deltaTime )
 {
@@ -311,7 +464,9 @@ void PhysicsSystem::RunStep( float deltaTime )
 	//First move all rigidbodies based on forces on them
 	MoveAllDynamicObjects(deltaTime);
 
+	m_contactReport->BeginStep();
 	UpdateAllCollisions();
+	m_contactReport->EndStep();
 
 	UpdateTriggers();
 }
@@ -323,12 +478,60 @@ void PhysicsSystem::MoveAllDynamicObjects(float deltaTime)
 
 	for (int objectIndex = 0; objectIndex < numObjects; objectIndex++)
 	{
-		if(m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][objectIndex] != nullptr)
+		Rigidbody2D* rigidbody = m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][objectIndex];
+		if(rigidbody != nullptr)
+		{
+			Vec2 startPosition = rigidbody->m_transform.m_position;
+			rigidbody->Move(deltaTime);
+
+			if (rigidbody->m_useCCD)
+			{
+				SweepToTimeOfImpact(rigidbody, startPosition);
+			}
+		}
+
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PhysicsSystem::SweepToTimeOfImpact( Rigidbody2D* rigidbody, const Vec2& startPosition )
+{
+	Vec2 displacement = rigidbody->m_transform.m_position - startPosition;
+	if (rigidbody->m_collider == nullptr || displacement == Vec2::ZERO)
+	{
+		return;
+	}
+
+	//Sweep the collider from where it started this step
+	rigidbody->m_transform.m_position = startPosition;
+
+	TimeOfImpact2D earliestImpact;
+	int numStaticObjects = static_cast<int>(m_rbBucket->m_RbBucket[STATIC_SIMULATION].size());
+	for (int staticIndex = 0; staticIndex < numStaticObjects; staticIndex++)
+	{
+		Rigidbody2D* staticRigidbody = m_rbBucket->m_RbBucket[STATIC_SIMULATION][staticIndex];
+		if (staticRigidbody == nullptr || staticRigidbody->m_collider == nullptr)
 		{
-			m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][objectIndex]->Move(deltaTime);
+			continue;
 		}
 
+		TimeOfImpact2D impact;
+		if (GetTimeOfImpact(&impact, rigidbody->m_collider, displacement, staticRigidbody->m_collider) && impact.m_fraction < earliestImpact.m_fraction)
+		{
+			earliestImpact = impact;
+		}
+	}
+
+	if (earliestImpact.m_collider == nullptr)
+	{
+		rigidbody->m_transform.m_position = startPosition + displacement;
+		return;
 	}
+
+	//Stop at the first impact, just inside the surface, and let the discrete pass resolve the contact.
+	//The rest of this step's motion is dropped; the bounce from the resolve carries the body on next step.
+	float fraction = Clamp(earliestImpact.m_fraction + m_ccdContactSlop / displacement.GetLength(), 0.f, 1.f);
+	rigidbody->m_transform.m_position = startPosition + displacement * fraction;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -336,7 +539,10 @@ void PhysicsSystem::CheckStaticVsStaticCollisions()
 {
 	int numStaticObjects = static_cast<int>(m_rbBucket->m_RbBucket[STATIC_SIMULATION].size());
 
-	//Set colliding or not colliding here
+	//Static objects never move, so every pair is tested in one batch
+	m_collisionBatch->BeginBatch();
+	m_batchPairs.clear();
+
 	for(int colliderIndex = 0; colliderIndex < numStaticObjects; colliderIndex++)
 	{
 		if(m_rbBucket->m_RbBucket[STATIC_SIMULATION][colliderIndex] == nullptr)
@@ -349,7 +555,8 @@ void PhysicsSystem::CheckStaticVsStaticCollisions()
 			continue;
 		}
 
-		for(int otherColliderIndex = 0; otherColliderIndex < numStaticObjects; otherColliderIndex++)
+		//Each unordered pair once, both colliders are marked and fire their event on a hit
+		for(int otherColliderIndex = colliderIndex + 1; otherColliderIndex < numStaticObjects; otherColliderIndex++)
 		{
 			//check condition where the other collider is nullptr
 			if(m_rbBucket->m_RbBucket[STATIC_SIMULATION][otherColliderIndex] == nullptr)
@@ -362,23 +569,28 @@ void PhysicsSystem::CheckStaticVsStaticCollisions()
 				continue;
 			}
 
-			//Make sure we aren't the same rigidbody
-			if(m_rbBucket->m_RbBucket[STATIC_SIMULATION][colliderIndex] == m_rbBucket->m_RbBucket[STATIC_SIMULATION][otherColliderIndex])
-			{
-				continue;
-			}
+			m_collisionBatch->AddPair(m_rbBucket->m_RbBucket[STATIC_SIMULATION][colliderIndex]->m_collider, m_rbBucket->m_RbBucket[STATIC_SIMULATION][otherColliderIndex]->m_collider);
+			m_batchPairs.push_back(IntVec2(colliderIndex, otherColliderIndex));
+		}
+	}
 
-			Collision2D collision;
-			if(m_rbBucket->m_RbBucket[STATIC_SIMULATION][colliderIndex]->m_collider->IsTouching(&collision, m_rbBucket->m_RbBucket[STATIC_SIMULATION][otherColliderIndex]->m_collider))
-			{
-				//Set collision to true
-				m_rbBucket->m_RbBucket[STATIC_SIMULATION][colliderIndex]->m_collider->SetCollision(true);
-				m_rbBucket->m_RbBucket[STATIC_SIMULATION][otherColliderIndex]->m_collider->SetCollision(true);
+	m_collisionBatch->RunBatch();
 
-				//Call required collision events
-				NamedProperties args;
-				m_rbBucket->m_RbBucket[STATIC_SIMULATION][colliderIndex]->m_collider->FireCollisionEvent(args);
-			}
+	//Set colliding or not colliding here
+	uint numPairs = m_collisionBatch->GetNumPairs();
+	for(uint pairIndex = 0; pairIndex < numPairs; pairIndex++)
+	{
+		int colliderIndex = m_batchPairs[pairIndex].x;
+		int otherColliderIndex = m_batchPairs[pairIndex].y;
+
+		Collision2D collision;
+		if(m_collisionBatch->GetCollision(&collision, pairIndex))
+		{
+			//Set collision to true
+			m_rbBucket->m_RbBucket[STATIC_SIMULATION][colliderIndex]->m_collider->SetCollision(true);
+			m_rbBucket->m_RbBucket[STATIC_SIMULATION][otherColliderIndex]->m_collider->SetCollision(true);
+
+			ReportContact(collision, true);
 		}
 	}
 }
@@ -389,7 +601,9 @@ void PhysicsSystem::ResolveDynamicVsStaticCollisions(bool canResolve)
 	int numDynamicObjects = static_cast<int>(m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION].size());
 	int numStaticObjects = static_cast<int>(m_rbBucket->m_RbBucket[STATIC_SIMULATION].size());
 
-	//Set colliding or not colliding here
+	m_collisionBatch->BeginBatch();
+	m_batchPairs.clear();
+
 	for(int colliderIndex = 0; colliderIndex < numDynamicObjects; colliderIndex++)
 	{
 		if(m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex] == nullptr)
@@ -415,89 +629,100 @@ void PhysicsSystem::ResolveDynamicVsStaticCollisions(bool canResolve)
 				continue;
 			}
 
-			Collision2D collision;
-			if(m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex]->m_collider->IsTouching(&collision, m_rbBucket->m_RbBucket[STATIC_SIMULATION][otherColliderIndex]->m_collider))
-			{
-				//Set collision to true
-				m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex]->m_collider->SetCollision(true);
-				m_rbBucket->m_RbBucket[STATIC_SIMULATION][otherColliderIndex]->m_collider->SetCollision(true);
+			m_collisionBatch->AddPair(m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex]->m_collider, m_rbBucket->m_RbBucket[STATIC_SIMULATION][otherColliderIndex]->m_collider);
+			m_batchPairs.push_back(IntVec2(colliderIndex, otherColliderIndex));
+		}
+	}
 
-				//Call the collision event
-				NamedProperties args;
-				m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex]->m_collider->FireCollisionEvent(args);
-				m_rbBucket->m_RbBucket[STATIC_SIMULATION][otherColliderIndex]->m_collider->FireCollisionEvent(args);
+	m_collisionBatch->RunBatch();
 
-				//Push the object out based on the collision manifold
-				if(collision.m_manifold.m_normal != Vec2::ZERO)
-				{
-					m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex]->m_transform.m_position += collision.m_manifold.m_normal * collision.m_manifold.m_penetration;
-				}
+	//Resolve in the same order the pairs were added. A pushed object has its later pairs re-tested by the batch
+	uint numPairs = m_collisionBatch->GetNumPairs();
+	for(uint pairIndex = 0; pairIndex < numPairs; pairIndex++)
+	{
+		int colliderIndex = m_batchPairs[pairIndex].x;
+		int otherColliderIndex = m_batchPairs[pairIndex].y;
 
+		Collision2D collision;
+		if(m_collisionBatch->GetCollision(&collision, pairIndex))
+		{
+			//Set collision to true
+			m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex]->m_collider->SetCollision(true);
+			m_rbBucket->m_RbBucket[STATIC_SIMULATION][otherColliderIndex]->m_collider->SetCollision(true);
 
-				if(canResolve)
-				{
+			ReportContact(collision, true);
 
-					Rigidbody2D* rb0 = m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex];
-					Rigidbody2D* rb1 = m_rbBucket->m_RbBucket[STATIC_SIMULATION][otherColliderIndex];
+			//Push the object out based on the collision manifold
+			if(collision.m_manifold.m_normal != Vec2::ZERO)
+			{
+				m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex]->m_transform.m_position += collision.m_manifold.m_normal * collision.m_manifold.m_penetration;
+				m_collisionBatch->MarkColliderMoved(m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex]->m_collider);
+			}
 
-					Vec2 velocity0 = rb0->m_velocity;
-					Vec2 velocity1 = rb1->m_velocity;
 
-					float mass0 = rb0->m_mass; 
-				
-					Manifold2D manifold = collision.m_manifold;
-					Vec2 contactPoint = manifold.m_contact + manifold.m_normal * (manifold.m_penetration);
+			if(canResolve)
+			{
 
-					//Get the vector from the object centre to the point of contact for both objects
-					Vec2 rb0toContact = contactPoint - rb0->m_object_transform->m_position;
-					Vec2 rb1toContact = contactPoint - rb1->m_object_transform->m_position;
+				Rigidbody2D* rb0 = m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex];
+				Rigidbody2D* rb1 = m_rbBucket->m_RbBucket[STATIC_SIMULATION][otherColliderIndex];
 
-					//Get the perpendicular of the vector from center to point
-					Vec2 toPointPerpendicular0 = rb0toContact.GetRotated90Degrees();
-					Vec2 toPointPerpendicular1 = rb1toContact.GetRotated90Degrees();
+				Vec2 velocity0 = rb0->m_velocity;
+				Vec2 velocity1 = rb1->m_velocity;
 
-					//Get the velocity at the impact point for both objects
-					Vec2 velocityAtPoint0 = velocity0 + DegreesToRadians(rb0->m_angularVelocity) * toPointPerpendicular0;
-					Vec2 velocityAtPoint1 = velocity1 + DegreesToRadians(rb1->m_angularVelocity) * toPointPerpendicular1;
+				float mass0 = rb0->m_mass; 
+			
+				Manifold2D manifold = collision.m_manifold;
+				Vec2 contactPoint = manifold.m_contact + manifold.m_normal * (manifold.m_penetration);
 
-					//Coefficient of restitution
-					float CoefficientOfRestitution = (collision.m_Obj->m_rigidbody->m_material.restitution) * (collision.m_otherObj->m_rigidbody->m_material.restitution);
-					
-					//Generate Impulse along the normal
-					float j = -(1 + CoefficientOfRestitution) * GetDotProduct((velocityAtPoint0 - velocityAtPoint1), manifold.m_normal);
-					float constant0 = ( GetDotProduct(toPointPerpendicular0, manifold.m_normal) * GetDotProduct(toPointPerpendicular0, manifold.m_normal) / rb0->m_momentOfInertia ) ;
-					float d = (1 / mass0) + (constant0);
+				//Get the vector from the object centre to the point of contact for both objects
+				Vec2 rb0toContact = contactPoint - rb0->m_object_transform->m_position;
+				Vec2 rb1toContact = contactPoint - rb1->m_object_transform->m_position;
 
-					float impulseAlongNormal = j / d;
+				//Get the perpendicular of the vector from center to point
+				Vec2 toPointPerpendicular0 = rb0toContact.GetRotated90Degrees();
+				Vec2 toPointPerpendicular1 = rb1toContact.GetRotated90Degrees();
 
-					rb0->ApplyImpulseAt( impulseAlongNormal * collision.m_manifold.m_normal, contactPoint );					
+				//Get the velocity at the impact point for both objects
+				Vec2 velocityAtPoint0 = velocity0 + DegreesToRadians(rb0->m_angularVelocity) * toPointPerpendicular0;
+				Vec2 velocityAtPoint1 = velocity1 + DegreesToRadians(rb1->m_angularVelocity) * toPointPerpendicular1;
 
-					//Get updated velocity
-					velocity0 = rb0->m_velocity;
-					velocity1 = rb1->m_velocity;
+				//Coefficient of restitution
+				float CoefficientOfRestitution = (collision.m_Obj->m_rigidbody->m_material.restitution) * (collision.m_otherObj->m_rigidbody->m_material.restitution);
+				
+				//Generate Impulse along the normal
+				float j = -(1 + CoefficientOfRestitution) * GetDotProduct((velocityAtPoint0 - velocityAtPoint1), manifold.m_normal);
+				float constant0 = ( GetDotProduct(toPointPerpendicular0, manifold.m_normal) * GetDotProduct(toPointPerpendicular0, manifold.m_normal) / rb0->m_momentOfInertia ) ;
+				float d = (1 / mass0) + (constant0);
 
-					//Get the velocity at the impact point for both objects
-					velocityAtPoint0 = velocity0 + DegreesToRadians(rb0->m_angularVelocity) * toPointPerpendicular0;
-					velocityAtPoint1 = velocity1 + DegreesToRadians(rb1->m_angularVelocity) * toPointPerpendicular1;
+				float impulseAlongNormal = j / d;
 
-					//Generate the impuse along the tangent
-					Vec2 tangent = manifold.m_normal.GetRotated90Degrees();
-					float jT = -(1 + CoefficientOfRestitution) * GetDotProduct((velocityAtPoint0 - velocityAtPoint1), tangent);
-					float constant0T = (GetDotProduct(toPointPerpendicular0, tangent) * GetDotProduct(toPointPerpendicular0, tangent) / rb0->m_momentOfInertia);
-					float dT = (1 / mass0) + (constant0T);
+				rb0->ApplyImpulseAt( impulseAlongNormal * collision.m_manifold.m_normal, contactPoint );					
 
-					float impulseAlongTangent = jT / dT;
+				//Get updated velocity
+				velocity0 = rb0->m_velocity;
+				velocity1 = rb1->m_velocity;
 
-					//Coulumb's law
-					float frictionCoefficient = sqrt(abs(rb0->m_friction * rb1->m_friction));
+				//Get the velocity at the impact point for both objects
+				velocityAtPoint0 = velocity0 + DegreesToRadians(rb0->m_angularVelocity) * toPointPerpendicular0;
+				velocityAtPoint1 = velocity1 + DegreesToRadians(rb1->m_angularVelocity) * toPointPerpendicular1;
 
-					impulseAlongTangent = Clamp(impulseAlongTangent, -impulseAlongNormal, impulseAlongNormal);
-					impulseAlongTangent *= frictionCoefficient;
+				//Generate the impuse along the tangent
+				Vec2 tangent = manifold.m_normal.GetRotated90Degrees();
+				float jT = -(1 + CoefficientOfRestitution) * GetDotProduct((velocityAtPoint0 - velocityAtPoint1), tangent);
+				float constant0T = (GetDotProduct(toPointPerpendicular0, tangent) * GetDotProduct(toPointPerpendicular0, tangent) / rb0->m_momentOfInertia);
+				float dT = (1 / mass0) + (constant0T);
 
-					rb0->ApplyImpulseAt(impulseAlongTangent * tangent, contactPoint);
-				}
+				float impulseAlongTangent = jT / dT;
+
+				//Coulumb's law
+				float frictionCoefficient = sqrt(abs(rb0->m_friction * rb1->m_friction));
 
+				impulseAlongTangent = Clamp(impulseAlongTangent, -impulseAlongNormal, impulseAlongNormal);
+				impulseAlongTangent *= frictionCoefficient;
+
+				rb0->ApplyImpulseAt(impulseAlongTangent * tangent, contactPoint);
 			}
+
 		}
 	}
 }
@@ -507,7 +732,9 @@ void PhysicsSystem::ResolveDynamicVsDynamicCollisions(bool canResolve)
 {
 	int numDynamicObjects = static_cast<int>(m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION].size());
 
-	//Set colliding or not colliding here
+	m_collisionBatch->BeginBatch();
+	m_batchPairs.clear();
+
 	for(int colliderIndex = 0; colliderIndex < numDynamicObjects; colliderIndex++)
 	{
 		if(m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex] == nullptr)
@@ -533,116 +760,153 @@ void PhysicsSystem::ResolveDynamicVsDynamicCollisions(bool canResolve)
 				continue;
 			}
 
-			Collision2D collision;
-			if(m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex]->m_collider->IsTouching(&collision, m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][otherColliderIndex]->m_collider))
+			m_collisionBatch->AddPair(m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex]->m_collider, m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][otherColliderIndex]->m_collider);
+			m_batchPairs.push_back(IntVec2(colliderIndex, otherColliderIndex));
+		}
+	}
+
+	m_collisionBatch->RunBatch();
+
+	//Resolve in the same order the pairs were added. Pushed objects have their later pairs re-tested by the batch
+	uint numPairs = m_collisionBatch->GetNumPairs();
+	for(uint pairIndex = 0; pairIndex < numPairs; pairIndex++)
+	{
+		int colliderIndex = m_batchPairs[pairIndex].x;
+		int otherColliderIndex = m_batchPairs[pairIndex].y;
+
+		Collision2D collision;
+		if(m_collisionBatch->GetCollision(&collision, pairIndex))
+		{
+			//Set collision to true
+			m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex]->m_collider->SetCollision(true);
+			m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][otherColliderIndex]->m_collider->SetCollision(true);
+
+			ReportContact(collision, false);
+
+			//Push the object out based on the collision manifold
+			if(collision.m_manifold.m_normal != Vec2::ZERO)
 			{
-				//Set collision to true
-				m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex]->m_collider->SetCollision(true);
-				m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][otherColliderIndex]->m_collider->SetCollision(true);
+				float mass0 = m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex]->m_mass; 
+				float mass1 = m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][otherColliderIndex]->m_mass; 
+				float totalMass = mass0 + mass1;
 
-				//Push the object out based on the collision manifold
-				if(collision.m_manifold.m_normal != Vec2::ZERO)
-				{
-					float mass0 = m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex]->m_mass; 
-					float mass1 = m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][otherColliderIndex]->m_mass; 
-					float totalMass = mass0 + mass1;
-
-					//Correction on system mass
-					float correct0 = mass1 / totalMass;   // move myself along the correction normal
-					float correct1 = 1 - correct0;  // move opposite along the normal
-
-					Vec2 move0 = collision.m_manifold.m_normal * collision.m_manifold.m_penetration * correct0;
-					Vec2 move1 = (collision.m_manifold.m_normal * -1) * collision.m_manifold.m_penetration * correct1;
-
-					//m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex]->m_transform.m_position += collision.m_manifold.m_normal * collision.m_manifold.m_penetration * correct0;
-					//m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][otherColliderIndex]->m_transform.m_position += (collision.m_manifold.m_normal * -1) * collision.m_manifold.m_penetration * correct1;
-					
-					m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex]->MoveBy(move0);
-					m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][otherColliderIndex]->MoveBy(move1);
-				}
+				//Correction on system mass
+				float correct0 = mass1 / totalMass;   // move myself along the correction normal
+				float correct1 = 1 - correct0;  // move opposite along the normal
 
+				Vec2 move0 = collision.m_manifold.m_normal * collision.m_manifold.m_penetration * correct0;
+				Vec2 move1 = (collision.m_manifold.m_normal * -1) * collision.m_manifold.m_penetration * correct1;
 
-				if(canResolve)
-				{
-					//resolve
-					Rigidbody2D* rb0 = m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex];
-					Rigidbody2D* rb1 = m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][otherColliderIndex];
+				//m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex]->m_transform.m_position += collision.m_manifold.m_normal * collision.m_manifold.m_penetration * correct0;
+				//m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][otherColliderIndex]->m_transform.m_position += (collision.m_manifold.m_normal * -1) * collision.m_manifold.m_penetration * correct1;
+				
+				m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex]->MoveBy(move0);
+				m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][otherColliderIndex]->MoveBy(move1);
 
-					//Vec2 *contactPoint = new Vec2();
-					//float impulseAlongNormal = GetImpulseAlongNormal(contactPoint, collision, *rb0, *rb1);
+				m_collisionBatch->MarkColliderMoved(m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex]->m_collider);
+				m_collisionBatch->MarkColliderMoved(m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][otherColliderIndex]->m_collider);
+			}
 
-					Vec2 velocity0 = rb0->m_velocity;
-					Vec2 velocity1 = rb1->m_velocity;
 
-					float mass0 = rb0->m_mass;
-					float mass1 = rb1->m_mass;
-					float totalMass = mass0 + mass1;
+			if(canResolve)
+			{
+				//resolve
+				Rigidbody2D* rb0 = m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][colliderIndex];
+				Rigidbody2D* rb1 = m_rbBucket->m_RbBucket[DYNAMIC_SIMULATION][otherColliderIndex];
 
-					//Correction on system mass
-					float correct0 = mass1 / totalMass;   // move myself along the correction normal
-					//float correct1 = 1 - correct0;  // move opposite along the normal
+				//Vec2 *contactPoint = new Vec2();
+				//float impulseAlongNormal = GetImpulseAlongNormal(contactPoint, collision, *rb0, *rb1);
 
-					Manifold2D manifold = collision.m_manifold;
-					Vec2 contactPoint = manifold.m_contact + manifold.m_normal * (manifold.m_penetration * correct0);
+				Vec2 velocity0 = rb0->m_velocity;
+				Vec2 velocity1 = rb1->m_velocity;
 
-					//Get the vector from the object centre to the point of contact for both objects
-					Vec2 rb0toContact = contactPoint - rb0->m_object_transform->m_position;
-					Vec2 rb1toContact = contactPoint - rb1->m_object_transform->m_position;
+				float mass0 = rb0->m_mass;
+				float mass1 = rb1->m_mass;
+				float totalMass = mass0 + mass1;
 
-					//Get the perpendicular of the vector from center to point
-					Vec2 toPointPerpendicular0 = rb0toContact.GetRotated90Degrees();
-					Vec2 toPointPerpendicular1 = rb1toContact.GetRotated90Degrees();
+				//Correction on system mass
+				float correct0 = mass1 / totalMass;   // move myself along the correction normal
+				//float correct1 = 1 - correct0;  // move opposite along the normal
 
-					//Get the velocity at the impact point for both objects
-					Vec2 velocityAtPoint0 = velocity0 + DegreesToRadians(rb0->m_angularVelocity) * toPointPerpendicular0;
-					Vec2 velocityAtPoint1 = velocity1 + DegreesToRadians(rb1->m_angularVelocity) * toPointPerpendicular1;
+				Manifold2D manifold = collision.m_manifold;
+				Vec2 contactPoint = manifold.m_contact + manifold.m_normal * (manifold.m_penetration * correct0);
 
-					//Coefficient of restitution
-					float CoefficientOfRestitution = (collision.m_Obj->m_rigidbody->m_material.restitution) * (collision.m_otherObj->m_rigidbody->m_material.restitution);
+				//Get the vector from the object centre to the point of contact for both objects
+				Vec2 rb0toContact = contactPoint - rb0->m_object_transform->m_position;
+				Vec2 rb1toContact = contactPoint - rb1->m_object_transform->m_position;
 
-					//Impulse along the normal
-					float j = -(1 + CoefficientOfRestitution) * GetDotProduct((velocityAtPoint0 - velocityAtPoint1), manifold.m_normal);
-					float constant0 = (GetDotProduct(toPointPerpendicular0, manifold.m_normal) * GetDotProduct(toPointPerpendicular0, manifold.m_normal) / rb0->m_momentOfInertia);
-					float constant1 = (GetDotProduct(toPointPerpendicular1, manifold.m_normal) * GetDotProduct(toPointPerpendicular1, manifold.m_normal) / rb1->m_momentOfInertia);
-					float d = ((mass0 + mass1) / (mass0 * mass1)) + constant0 + constant1;
+				//Get the perpendicular of the vector from center to point
+				Vec2 toPointPerpendicular0 = rb0toContact.GetRotated90Degrees();
+				Vec2 toPointPerpendicular1 = rb1toContact.GetRotated90Degrees();
 
-					float impulseAlongNormal = j / d;
+				//Get the velocity at the impact point for both objects
+				Vec2 velocityAtPoint0 = velocity0 + DegreesToRadians(rb0->m_angularVelocity) * toPointPerpendicular0;
+				Vec2 velocityAtPoint1 = velocity1 + DegreesToRadians(rb1->m_angularVelocity) * toPointPerpendicular1;
 
-					rb0->ApplyImpulseAt(impulseAlongNormal * collision.m_manifold.m_normal, contactPoint);
-					rb1->ApplyImpulseAt(-1.f * (impulseAlongNormal * collision.m_manifold.m_normal), contactPoint);
+				//Coefficient of restitution
+				float CoefficientOfRestitution = (collision.m_Obj->m_rigidbody->m_material.restitution) * (collision.m_otherObj->m_rigidbody->m_material.restitution);
 
-					// Get updated velocities
-					velocity0 = rb0->m_velocity;
-					velocity1 = rb1->m_velocity;
+				//Impulse along the normal
+				float j = -(1 + CoefficientOfRestitution) * GetDotProduct((velocityAtPoint0 - velocityAtPoint1), manifold.m_normal);
+				float constant0 = (GetDotProduct(toPointPerpendicular0, manifold.m_normal) * GetDotProduct(toPointPerpendicular0, manifold.m_normal) / rb0->m_momentOfInertia);
+				float constant1 = (GetDotProduct(toPointPerpendicular1, manifold.m_normal) * GetDotProduct(toPointPerpendicular1, manifold.m_normal) / rb1->m_momentOfInertia);
+				float d = ((mass0 + mass1) / (mass0 * mass1)) + constant0 + constant1;
 
-					//Get the velocity at the impact point for both objects
-					velocityAtPoint0 = velocity0 + DegreesToRadians(rb0->m_angularVelocity) * toPointPerpendicular0;
-					velocityAtPoint1 = velocity1 + DegreesToRadians(rb1->m_angularVelocity) * toPointPerpendicular1;
+				float impulseAlongNormal = j / d;
 
-					//Impulse along the tangent
-					Vec2 tangent = manifold.m_normal.GetRotated90Degrees();
-					float jT = -(1 + CoefficientOfRestitution) * GetDotProduct((velocityAtPoint0 - velocityAtPoint1), tangent);
-					float constant0T = (GetDotProduct(toPointPerpendicular0, tangent) * GetDotProduct(toPointPerpendicular0, tangent) / rb0->m_momentOfInertia);
-					float constant1T = (GetDotProduct(toPointPerpendicular1, tangent) * GetDotProduct(toPointPerpendicular1, tangent) / rb1->m_momentOfInertia);
-					float dT = ((mass0 + mass1) / (mass0 * mass1)) + constant0T + constant1T;
+				rb0->ApplyImpulseAt(impulseAlongNormal * collision.m_manifold.m_normal, contactPoint);
+				rb1->ApplyImpulseAt(-1.f * (impulseAlongNormal * collision.m_manifold.m_normal), contactPoint);
 
-					float impulseAlongTangent = jT / dT;
+				// Get updated velocities
+				velocity0 = rb0->m_velocity;
+				velocity1 = rb1->m_velocity;
 
-					//Coulumb's law
-					float frictionCoefficient = sqrt(abs(rb0->m_friction * rb1->m_friction));
+				//Get the velocity at the impact point for both objects
+				velocityAtPoint0 = velocity0 + DegreesToRadians(rb0->m_angularVelocity) * toPointPerpendicular0;
+				velocityAtPoint1 = velocity1 + DegreesToRadians(rb1->m_angularVelocity) * toPointPerpendicular1;
 
-					impulseAlongTangent = Clamp(impulseAlongTangent, -impulseAlongNormal, impulseAlongNormal);
-					impulseAlongTangent *= frictionCoefficient;
+				//Impulse along the tangent
+				Vec2 tangent = manifold.m_normal.GetRotated90Degrees();
+				float jT = -(1 + CoefficientOfRestitution) * GetDotProduct((velocityAtPoint0 - velocityAtPoint1), tangent);
+				float constant0T = (GetDotProduct(toPointPerpendicular0, tangent) * GetDotProduct(toPointPerpendicular0, tangent) / rb0->m_momentOfInertia);
+				float constant1T = (GetDotProduct(toPointPerpendicular1, tangent) * GetDotProduct(toPointPerpendicular1, tangent) / rb1->m_momentOfInertia);
+				float dT = ((mass0 + mass1) / (mass0 * mass1)) + constant0T + constant1T;
 
-					rb0->ApplyImpulseAt( impulseAlongTangent * tangent, contactPoint );
-					rb1->ApplyImpulseAt( -1.f * (impulseAlongTangent * tangent), contactPoint );
-				}
+				float impulseAlongTangent = jT / dT;
+
+				//Coulumb's law
+				float frictionCoefficient = sqrt(abs(rb0->m_friction * rb1->m_friction));
+
+				impulseAlongTangent = Clamp(impulseAlongTangent, -impulseAlongNormal, impulseAlongNormal);
+				impulseAlongTangent *= frictionCoefficient;
 
+				rb0->ApplyImpulseAt( impulseAlongTangent * tangent, contactPoint );
+				rb1->ApplyImpulseAt( -1.f * (impulseAlongTangent * tangent), contactPoint );
 			}
+
 		}
 	}
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+void PhysicsSystem::ReportContact( const Collision2D& collision, bool fireEvents )
+{
+	m_contactReport->AddContact(collision.m_Obj, collision.m_otherObj, collision.m_manifold);
+
+	//String events are opt in, only build the args when one of the colliders listens
+	if (!fireEvents || !m_fireCollisionEvents)
+	{
+		return;
+	}
+
+	if (collision.m_Obj->m_onCollisionEvent != "" || collision.m_otherObj->m_onCollisionEvent != "")
+	{
+		NamedProperties args;
+		collision.m_Obj->FireCollisionEvent(args);
+		collision.m_otherObj->FireCollisionEvent(args);
+	}
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 float PhysicsSystem::GetImpulseAlongNormal(Vec2 *out, const Collision2D& collision, const Rigidbody2D& rb0, const Rigidbody2D& rb1)
 {
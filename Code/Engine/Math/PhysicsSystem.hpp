@@ -1,11 +1,16 @@
 //------------------------------------------------------------------------------------------------------------------------------
 #pragma once
 #include "Engine/Commons/EngineCommon.hpp"
+#include "Engine/Math/IntVec2.hpp"
 #include "Engine/Math/Rigidbody2D.hpp"
+#include <vector>
 
 //------------------------------------------------------------------------------------------------------------------------------
+class Clock;
 class RenderContext;
 class Collider2D;
+class CollisionBatch2D;
+class ContactReport2D;
 class RigidBodyBucket;
 class Trigger2D;
 class TriggerBucket;
@@ -30,6 +35,8 @@ public:
 	void					CopyTransformsFromObjects();
 	void					CopyTransformsToObjects();
 	void					Update(float deltaTime);
+	void					Update(Clock* clock);
+	void					SetFixedTimeStep(float fixedTimeStep, int maxSubsteps);
 	void					SetAllCollisionsToFalse();
 	void					UpdateAllCollisions();
 	void					UpdateTriggers();
@@ -41,15 +48,23 @@ public:
 	void					DebugRenderTriggers( RenderContext* renderContext ) const;
 
 	const Vec2&				GetGravity() const;
+	const ContactReport2D&	GetContactReport() const;
 
 private:
 
 	void					RunStep(float deltaTime);
+	void					RunFixedSteps(float deltaTime);
+
+	void					CopyMovedTransformsFromObjects();
+	void					StorePreviousTransforms();
+	void					CopyInterpolatedTransformsToObjects(float alpha);
 
 	void					MoveAllDynamicObjects(float deltaTime);
+	void					SweepToTimeOfImpact( Rigidbody2D* rigidbody, const Vec2& startPosition );
 	void					CheckStaticVsStaticCollisions();
 	void					ResolveDynamicVsStaticCollisions( bool canResolve );
 	void					ResolveDynamicVsDynamicCollisions( bool canResolve );
+	void					ReportContact( const Collision2D& collision, bool fireEvents );
 
 	//Utilities
 	float					GetImpulseAlongNormal( Vec2* out, const Collision2D& collision, const Rigidbody2D& rb0, const Rigidbody2D& rb1 );
@@ -61,7 +76,29 @@ public:
 	TriggerBucket*					m_triggerBucket;
 	uint							m_frameCount = 0U;
 
+	//Narrow phase, reused by every collision pass (x,y are the bucket indices of each pair)
+	CollisionBatch2D*				m_collisionBatch = nullptr;
+	std::vector<IntVec2>			m_batchPairs;
+
+	//Begin/persist/end contacts of the last step
+	ContactReport2D*				m_contactReport = nullptr;
+	bool							m_fireCollisionEvents = true;		// string collision events, turn off if only using contact reports
+
 
 	//system info like gravity
 	Vec2							m_gravity = Vec2(0.0f, -9.8f);
+
+	//Fixed step: Update runs as many m_fixedTimeStep steps as the accumulated time allows and interpolates the rest.
+	//0 (the default) runs one step with the frame's delta time, games opt in with SetFixedTimeStep.
+	float							m_fixedTimeStep = 0.f;
+	int								m_maxSubsteps = 5;					// per Update, time past this is dropped so slow frames can't spiral
+	double							m_substepBudgetSeconds = 0.0;		// wall time allowed for the substeps of one Update, 0 is no budget
+	float							m_timeAccumulator = 0.f;
+
+	//Stats from the last Update
+	int								m_lastNumSubsteps = 0;
+	double							m_lastStepSeconds = 0.0;
+
+	//How far a CCD body is moved past its time of impact so the discrete pass sees the contact
+	float							m_ccdContactSlop = 0.01f;
 };
\ No newline at end of file
@@ -0,0 +1,409 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Math/Quaternion.hpp"
+//Engine Systems
+#include "Engine/Commons/EngineCommon.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <math.h>
+
+//Quaternions are one SSE register (x, y, z, w), batches are worked on as 4 quaternions transposed into x, y, z, w registers
+#if !defined(ENGINE_DISABLE_SIMD) && (defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__))
+#define QUATERNION_USE_SSE
+#include <xmmintrin.h>
+#endif
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr float			SLERP_NLERP_THRESHOLD = 0.9995f;		// past this dot the angle is too small for slerp's divide by sin
+
+const STATIC Quaternion Quaternion::IDENTITY(0.f, 0.f, 0.f, 1.f);
+
+#if defined(QUATERNION_USE_SSE)
+//------------------------------------------------------------------------------------------------------------------------------
+// Negates the lanes whose mask bit is set (x, y, z, w order)
+//------------------------------------------------------------------------------------------------------------------------------
+static inline __m128 FlipSigns( __m128 value, bool flipX, bool flipY, bool flipZ, bool flipW )
+{
+	const __m128 signMask = _mm_set_ps(flipW ? -0.f : 0.f, flipZ ? -0.f : 0.f, flipY ? -0.f : 0.f, flipX ? -0.f : 0.f);
+	return _mm_xor_ps(value, signMask);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Hamilton product a * b with b's components shuffled into place for each of a's components
+//------------------------------------------------------------------------------------------------------------------------------
+static inline __m128 MultiplyQuaternions( __m128 a, __m128 b )
+{
+	__m128 aX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0));
+	__m128 aY = _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1));
+	__m128 aZ = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2));
+	__m128 aW = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3));
+
+	__m128 result = _mm_mul_ps(aW, b);
+	result = _mm_add_ps(result, _mm_mul_ps(aX, FlipSigns(_mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)), false, true, false, true)));
+	result = _mm_add_ps(result, _mm_mul_ps(aY, FlipSigns(_mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)), false, false, true, true)));
+	result = _mm_add_ps(result, _mm_mul_ps(aZ, FlipSigns(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)), true, false, false, true)));
+	return result;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static inline __m128 DotQuaternions( __m128 a, __m128 b )
+{
+	__m128 products = _mm_mul_ps(a, b);
+	__m128 sums = _mm_add_ps(products, _mm_shuffle_ps(products, products, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_add_ps(sums, _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+#endif
+
+//------------------------------------------------------------------------------------------------------------------------------
+Quaternion::Quaternion( float initialX, float initialY, float initialZ, float initialW )
+	: x(initialX)
+	, y(initialY)
+	, z(initialZ)
+	, w(initialW)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const STATIC Quaternion Quaternion::MakeFromAxisAngleDegrees( const Vec3& axis, float degrees )
+{
+	float halfRadians = DegreesToRadians(degrees) * 0.5f;
+	float sine = sinf(halfRadians);
+
+	return Quaternion(axis.x * sine, axis.y * sine, axis.z * sine, cosf(halfRadians));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Same rotation as Matrix44::MakeFromEuler. The engine's X and Y rotation matrices turn the opposite way to the right hand
+// rule (Z does not), so those two angles go in negated.
+//------------------------------------------------------------------------------------------------------------------------------
+const STATIC Quaternion Quaternion::MakeFromEuler( const Vec3& eulerDegrees, eRotationOrder rotationOrder )
+{
+	Quaternion rotatedX = MakeFromAxisAngleDegrees(Vec3(1.f, 0.f, 0.f), -eulerDegrees.x);
+	Quaternion rotatedY = MakeFromAxisAngleDegrees(Vec3(0.f, 1.f, 0.f), -eulerDegrees.y);
+	Quaternion rotatedZ = MakeFromAxisAngleDegrees(Vec3(0.f, 0.f, 1.f), eulerDegrees.z);
+
+	if (rotationOrder == ROTATION_ORDER_ZXY)
+	{
+		return rotatedY * rotatedX * rotatedZ;
+	}
+	else
+	{
+		return rotatedZ * rotatedY * rotatedX;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Shepperd's method: solve for the largest component first so the divide never gets close to 0
+//------------------------------------------------------------------------------------------------------------------------------
+const STATIC Quaternion Quaternion::MakeFromMatrix( const Matrix44& matrix )
+{
+	const float* values = matrix.m_values;
+	float trace = values[Matrix44::Ix] + values[Matrix44::Jy] + values[Matrix44::Kz];
+
+	Quaternion result;
+	if (trace > 0.f)
+	{
+		float scale = sqrtf(trace + 1.f) * 2.f;
+		result.w = 0.25f * scale;
+		result.x = (values[Matrix44::Jz] - values[Matrix44::Ky]) / scale;
+		result.y = (values[Matrix44::Kx] - values[Matrix44::Iz]) / scale;
+		result.z = (values[Matrix44::Iy] - values[Matrix44::Jx]) / scale;
+	}
+	else if (values[Matrix44::Ix] > values[Matrix44::Jy] && values[Matrix44::Ix] > values[Matrix44::Kz])
+	{
+		float scale = sqrtf(1.f + values[Matrix44::Ix] - values[Matrix44::Jy] - values[Matrix44::Kz]) * 2.f;
+		result.w = (values[Matrix44::Jz] - values[Matrix44::Ky]) / scale;
+		result.x = 0.25f * scale;
+		result.y = (values[Matrix44::Jx] + values[Matrix44::Iy]) / scale;
+		result.z = (values[Matrix44::Kx] + values[Matrix44::Iz]) / scale;
+	}
+	else if (values[Matrix44::Jy] > values[Matrix44::Kz])
+	{
+		float scale = sqrtf(1.f + values[Matrix44::Jy] - values[Matrix44::Ix] - values[Matrix44::Kz]) * 2.f;
+		result.w = (values[Matrix44::Kx] - values[Matrix44::Iz]) / scale;
+		result.x = (values[Matrix44::Jx] + values[Matrix44::Iy]) / scale;
+		result.y = 0.25f * scale;
+		result.z = (values[Matrix44::Ky] + values[Matrix44::Jz]) / scale;
+	}
+	else
+	{
+		float scale = sqrtf(1.f + values[Matrix44::Kz] - values[Matrix44::Ix] - values[Matrix44::Jy]) * 2.f;
+		result.w = (values[Matrix44::Iy] - values[Matrix44::Jx]) / scale;
+		result.x = (values[Matrix44::Kx] + values[Matrix44::Iz]) / scale;
+		result.y = (values[Matrix44::Ky] + values[Matrix44::Jz]) / scale;
+		result.z = 0.25f * scale;
+	}
+
+	return result;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+float Quaternion::GetLengthSquared() const
+{
+	return x * x + y * y + z * z + w * w;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const Quaternion Quaternion::GetNormalized() const
+{
+	Quaternion result = *this;
+	result.Normalize();
+	return result;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const Quaternion Quaternion::GetConjugate() const
+{
+	return Quaternion(-x, -y, -z, w);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const Quaternion Quaternion::GetInverse() const
+{
+	float lengthSquared = GetLengthSquared();
+	if (lengthSquared == 0.f)
+	{
+		return IDENTITY;
+	}
+
+	float inverseLengthSquared = 1.f / lengthSquared;
+	return Quaternion(-x * inverseLengthSquared, -y * inverseLengthSquared, -z * inverseLengthSquared, w * inverseLengthSquared);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// v + 2w(u x v) + 2u x (u x v), cheaper than building the matrix for a single vector
+//------------------------------------------------------------------------------------------------------------------------------
+const Vec3 Quaternion::RotateVector( const Vec3& vector ) const
+{
+	Vec3 axis(x, y, z);
+	Vec3 twiceCross = GetCrossProduct(axis, vector) * 2.f;
+
+	return vector + twiceCross * w + GetCrossProduct(axis, twiceCross);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const Matrix44 Quaternion::GetMatrix() const
+{
+	return GetMatrix(Vec3::ZERO);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const Matrix44 Quaternion::GetMatrix( const Vec3& translation ) const
+{
+	Matrix44 matrix;
+	MakeMatricesFromQuaternions(&matrix, this, &translation, 1);
+	return matrix;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void Quaternion::Normalize()
+{
+	float lengthSquared = GetLengthSquared();
+	if (lengthSquared == 0.f)
+	{
+		*this = IDENTITY;
+		return;
+	}
+
+	float inverseLength = 1.f / sqrtf(lengthSquared);
+	x *= inverseLength;
+	y *= inverseLength;
+	z *= inverseLength;
+	w *= inverseLength;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const Quaternion Quaternion::operator*( const Quaternion& rotationToApplyFirst ) const
+{
+	Quaternion result;
+
+#if defined(QUATERNION_USE_SSE)
+	_mm_storeu_ps(&result.x, MultiplyQuaternions(_mm_loadu_ps(&x), _mm_loadu_ps(&rotationToApplyFirst.x)));
+#else
+	const Quaternion& b = rotationToApplyFirst;
+	result.x = w * b.x + x * b.w + y * b.z - z * b.y;
+	result.y = w * b.y - x * b.z + y * b.w + z * b.x;
+	result.z = w * b.z + x * b.y - y * b.x + z * b.w;
+	result.w = w * b.w - x * b.x - y * b.y - z * b.z;
+#endif
+
+	return result;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void Quaternion::operator*=( const Quaternion& rotationToApplyFirst )
+{
+	*this = *this * rotationToApplyFirst;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool Quaternion::operator==( const Quaternion& compare ) const
+{
+	return x == compare.x && y == compare.y && z == compare.z && w == compare.w;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+float GetDotProduct( const Quaternion& rotationA, const Quaternion& rotationB )
+{
+	return rotationA.x * rotationB.x + rotationA.y * rotationB.y + rotationA.z * rotationB.z + rotationA.w * rotationB.w;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const Quaternion Nlerp( const Quaternion& rotationA, const Quaternion& rotationB, float t )
+{
+	Quaternion result;
+
+#if defined(QUATERNION_USE_SSE)
+	__m128 a = _mm_loadu_ps(&rotationA.x);
+	__m128 b = _mm_loadu_ps(&rotationB.x);
+
+	//q and -q are the same rotation, flip b onto a's side so we take the short way
+	__m128 dot = DotQuaternions(a, b);
+	__m128 sign = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.f));
+	b = _mm_xor_ps(b, sign);
+
+	__m128 blended = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), _mm_set1_ps(t)));
+	__m128 length = _mm_sqrt_ps(DotQuaternions(blended, blended));
+	_mm_storeu_ps(&result.x, _mm_div_ps(blended, length));
+#else
+	float sign = (GetDotProduct(rotationA, rotationB) < 0.f) ? -1.f : 1.f;
+	result.x = rotationA.x + (rotationB.x * sign - rotationA.x) * t;
+	result.y = rotationA.y + (rotationB.y * sign - rotationA.y) * t;
+	result.z = rotationA.z + (rotationB.z * sign - rotationA.z) * t;
+	result.w = rotationA.w + (rotationB.w * sign - rotationA.w) * t;
+	result.Normalize();
+#endif
+
+	return result;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const Quaternion Slerp( const Quaternion& rotationA, const Quaternion& rotationB, float t )
+{
+	float dot = GetDotProduct(rotationA, rotationB);
+	Quaternion endRotation = rotationB;
+	if (dot < 0.f)
+	{
+		dot = -dot;
+		endRotation = Quaternion(-rotationB.x, -rotationB.y, -rotationB.z, -rotationB.w);
+	}
+
+	if (dot > SLERP_NLERP_THRESHOLD)
+	{
+		return Nlerp(rotationA, endRotation, t);
+	}
+
+	float angle = acosf(dot);
+	float inverseSine = 1.f / sinf(angle);
+	float weightA = sinf((1.f - t) * angle) * inverseSine;
+	float weightB = sinf(t * angle) * inverseSine;
+
+	Quaternion result;
+
+#if defined(QUATERNION_USE_SSE)
+	__m128 blended = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&rotationA.x), _mm_set1_ps(weightA)), _mm_mul_ps(_mm_loadu_ps(&endRotation.x), _mm_set1_ps(weightB)));
+	_mm_storeu_ps(&result.x, blended);
+#else
+	result.x = rotationA.x * weightA + endRotation.x * weightB;
+	result.y = rotationA.y * weightA + endRotation.y * weightB;
+	result.z = rotationA.z * weightA + endRotation.z * weightB;
+	result.w = rotationA.w * weightA + endRotation.w * weightB;
+#endif
+
+	return result;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Each basis is the rotated axis:
+//	I = (1 - 2(yy + zz), 2(xy + zw), 2(xz - yw))
+//	J = (2(xy - zw), 1 - 2(xx + zz), 2(yz + xw))
+//	K = (2(xz + yw), 2(yz - xw), 1 - 2(xx + yy))
+//------------------------------------------------------------------------------------------------------------------------------
+void MakeMatricesFromQuaternions( Matrix44* outMatrices, const Quaternion* rotations, const Vec3* translations, int count )
+{
+	int matrixIndex = 0;
+
+#if defined(QUATERNION_USE_SSE)
+	const __m128 one = _mm_set1_ps(1.f);
+	const __m128 two = _mm_set1_ps(2.f);
+	const __m128 zero = _mm_setzero_ps();
+
+	for (; matrixIndex + 4 <= count; matrixIndex += 4)
+	{
+		//4 quaternions in, transposed to x, y, z, w registers
+		__m128 xs = _mm_loadu_ps(&rotations[matrixIndex].x);
+		__m128 ys = _mm_loadu_ps(&rotations[matrixIndex + 1].x);
+		__m128 zs = _mm_loadu_ps(&rotations[matrixIndex + 2].x);
+		__m128 ws = _mm_loadu_ps(&rotations[matrixIndex + 3].x);
+		_MM_TRANSPOSE4_PS(xs, ys, zs, ws);
+
+		__m128 twoX = _mm_mul_ps(xs, two);
+		__m128 twoY = _mm_mul_ps(ys, two);
+		__m128 twoZ = _mm_mul_ps(zs, two);
+
+		__m128 xx = _mm_mul_ps(xs, twoX);		__m128 yy = _mm_mul_ps(ys, twoY);		__m128 zz = _mm_mul_ps(zs, twoZ);
+		__m128 xy = _mm_mul_ps(xs, twoY);		__m128 xz = _mm_mul_ps(xs, twoZ);		__m128 yz = _mm_mul_ps(ys, twoZ);
+		__m128 xw = _mm_mul_ps(ws, twoX);		__m128 yw = _mm_mul_ps(ws, twoY);		__m128 zw = _mm_mul_ps(ws, twoZ);
+
+		__m128 iX = _mm_sub_ps(one, _mm_add_ps(yy, zz));
+		__m128 iY = _mm_add_ps(xy, zw);
+		__m128 iZ = _mm_sub_ps(xz, yw);
+		__m128 iW = zero;
+
+		__m128 jX = _mm_sub_ps(xy, zw);
+		__m128 jY = _mm_sub_ps(one, _mm_add_ps(xx, zz));
+		__m128 jZ = _mm_add_ps(yz, xw);
+		__m128 jW = zero;
+
+		__m128 kX = _mm_add_ps(xz, yw);
+		__m128 kY = _mm_sub_ps(yz, xw);
+		__m128 kZ = _mm_sub_ps(one, _mm_add_ps(xx, yy));
+		__m128 kW = zero;
+
+		//Transpose back so each register is one matrix's basis
+		_MM_TRANSPOSE4_PS(iX, iY, iZ, iW);
+		_MM_TRANSPOSE4_PS(jX, jY, jZ, jW);
+		_MM_TRANSPOSE4_PS(kX, kY, kZ, kW);
+
+		__m128 iBases[4] = { iX, iY, iZ, iW };
+		__m128 jBases[4] = { jX, jY, jZ, jW };
+		__m128 kBases[4] = { kX, kY, kZ, kW };
+
+		for (int lane = 0; lane < 4; lane++)
+		{
+			float* values = outMatrices[matrixIndex + lane].m_values;
+			_mm_storeu_ps(&values[Matrix44::Ix], iBases[lane]);
+			_mm_storeu_ps(&values[Matrix44::Jx], jBases[lane]);
+			_mm_storeu_ps(&values[Matrix44::Kx], kBases[lane]);
+
+			const Vec3& translation = (translations != nullptr) ? translations[matrixIndex + lane] : Vec3::ZERO;
+			values[Matrix44::Tx] = translation.x;
+			values[Matrix44::Ty] = translation.y;
+			values[Matrix44::Tz] = translation.z;
+			values[Matrix44::Tw] = 1.f;
+		}
+	}
+#endif
+
+	for (; matrixIndex < count; matrixIndex++)
+	{
+		const Quaternion& rotation = rotations[matrixIndex];
+		float* values = outMatrices[matrixIndex].m_values;
+
+		float twoX = rotation.x * 2.f;
+		float twoY = rotation.y * 2.f;
+		float twoZ = rotation.z * 2.f;
+
+		float xx = rotation.x * twoX;		float yy = rotation.y * twoY;		float zz = rotation.z * twoZ;
+		float xy = rotation.x * twoY;		float xz = rotation.x * twoZ;		float yz = rotation.y * twoZ;
+		float xw = rotation.w * twoX;		float yw = rotation.w * twoY;		float zw = rotation.w * twoZ;
+
+		values[Matrix44::Ix] = 1.f - (yy + zz);	values[Matrix44::Iy] = xy + zw;			values[Matrix44::Iz] = xz - yw;			values[Matrix44::Iw] = 0.f;
+		values[Matrix44::Jx] = xy - zw;			values[Matrix44::Jy] = 1.f - (xx + zz);	values[Matrix44::Jz] = yz + xw;			values[Matrix44::Jw] = 0.f;
+		values[Matrix44::Kx] = xz + yw;			values[Matrix44::Ky] = yz - xw;			values[Matrix44::Kz] = 1.f - (xx + yy);	values[Matrix44::Kw] = 0.f;
+
+		const Vec3& translation = (translations != nullptr) ? translations[matrixIndex] : Vec3::ZERO;
+		values[Matrix44::Tx] = translation.x;
+		values[Matrix44::Ty] = translation.y;
+		values[Matrix44::Tz] = translation.z;
+		values[Matrix44::Tw] = 1.f;
+	}
+}
@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+//Engine Systems
+#include "Engine/Math/Matrix44.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include <type_traits>
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Unit quaternion rotation (x, y, z vector part, w scalar part)
+//
+// Matches the engine's matrices: GetMatrix() of MakeFromEuler(euler) is Matrix44::MakeFromEuler(euler), and a * b is the
+// rotation b followed by a, same as a.GetMatrix().AppendMatrix(b.GetMatrix()). Compose rotations here and build the
+// matrix once at the end instead of going through Euler angles.
+//------------------------------------------------------------------------------------------------------------------------------
+struct Quaternion
+{
+public:
+	Quaternion() = default;
+	explicit Quaternion( float initialX, float initialY, float initialZ, float initialW );
+
+	//Statics
+	const static Quaternion		IDENTITY;
+
+	static const Quaternion		MakeFromAxisAngleDegrees( const Vec3& axis, float degrees );			// axis must be normalized
+	static const Quaternion		MakeFromEuler( const Vec3& eulerDegrees, eRotationOrder rotationOrder = ROTATION_ORDER_DEFAULT );
+	static const Quaternion		MakeFromMatrix( const Matrix44& matrix );								// rotation part, must be orthonormal
+
+	//Access Methods
+	float						GetLengthSquared() const;
+	const Quaternion			GetNormalized() const;
+	const Quaternion			GetConjugate() const;												// inverse for unit quaternions
+	const Quaternion			GetInverse() const;
+
+	const Vec3					RotateVector( const Vec3& vector ) const;
+	const Matrix44				GetMatrix() const;
+	const Matrix44				GetMatrix( const Vec3& translation ) const;
+
+	//Mutator methods
+	void						Normalize();
+
+	// Operators
+	const Quaternion			operator*( const Quaternion& rotationToApplyFirst ) const;
+	void						operator*=( const Quaternion& rotationToApplyFirst );
+	bool						operator==( const Quaternion& compare ) const;
+
+public:
+	float x;
+	float y;
+	float z;
+	float w;
+};
+
+static_assert(std::is_trivially_copyable<Quaternion>::value, "Quaternion must stay trivially copyable");
+static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Quaternion must stay 4 packed floats");
+
+//------------------------------------------------------------------------------------------------------------------------------
+float					GetDotProduct( const Quaternion& rotationA, const Quaternion& rotationB );
+
+//Both take the short way around, t = 0 is rotationA and t = 1 is rotationB
+const Quaternion		Nlerp( const Quaternion& rotationA, const Quaternion& rotationB, float t );			// cheap, speed not constant in t
+const Quaternion		Slerp( const Quaternion& rotationA, const Quaternion& rotationB, float t );			// constant angular speed
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Batch rotation + translation to matrix, outMatrices[i] = rotations[i].GetMatrix(translations[i]). 4 at a time with SSE.
+// translations can be nullptr for pure rotation matrices.
+//------------------------------------------------------------------------------------------------------------------------------
+void					MakeMatricesFromQuaternions( Matrix44* outMatrices, const Quaternion* rotations, const Vec3* translations, int count );
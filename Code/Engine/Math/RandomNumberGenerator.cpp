@@ -1,13 +1,78 @@
 //------------------------------------------------------------------------------------------------------------------------------
 #include "RandomNumberGenerator.hpp"
+#include "Engine/Commons/EngineCommon.hpp"
 #include "Engine/Math/Noise/RawNoise.hpp"
+#include "Engine/Math/Noise/RawNoiseSSE.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include <math.h>
 
 RandomNumberGenerator* g_RNG = nullptr;
 
 //------------------------------------------------------------------------------------------------------------------------------
-RandomNumberGenerator::RandomNumberGenerator(unsigned int seed)
+constexpr float			RNG_TWO_PI = 6.28318530717958647692f;
+constexpr int			RNG_BULK_CHUNK_SIZE = 256;			// directions are filled in chunks of this many values on the stack
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Values [firstIndex, firstIndex + count) of the stream with the given stream seed
+//------------------------------------------------------------------------------------------------------------------------------
+static void FillStreamUints( uint* outValues, int count, uint streamSeed, uint firstIndex )
+{
+	int valueIndex = 0;
+
+#if defined(RAW_NOISE_USE_SSE)
+	const __m128i seeds = _mm_set1_epi32(static_cast<int>(streamSeed));
+	const __m128i laneStep = _mm_set1_epi32(4);
+	__m128i indices = _mm_add_epi32(_mm_set1_epi32(static_cast<int>(firstIndex)), _mm_set_epi32(3, 2, 1, 0));
+
+	for (; valueIndex + 4 <= count; valueIndex += 4)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(outValues + valueIndex), GetNoiseUint4(indices, seeds));
+		indices = _mm_add_epi32(indices, laneStep);
+	}
+#endif
+
+	for (; valueIndex < count; valueIndex++)
+	{
+		outValues[valueIndex] = Get1dNoiseUint(static_cast<int>(firstIndex + valueIndex), streamSeed);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Same as FillStreamUints but mapped to [0,1] like Get1dNoiseZeroToOne, outValues[i] = outRangeStart + value * outRange
+//------------------------------------------------------------------------------------------------------------------------------
+static void FillStreamFloats( float* outValues, int count, uint streamSeed, uint firstIndex, float outRangeStart, float outRange )
+{
+	int valueIndex = 0;
+
+#if defined(RAW_NOISE_USE_SSE)
+	const __m128i seeds = _mm_set1_epi32(static_cast<int>(streamSeed));
+	const __m128i laneStep = _mm_set1_epi32(4);
+	const __m128 rangeStarts = _mm_set1_ps(outRangeStart);
+	const __m128 ranges = _mm_set1_ps(outRange);
+	__m128i indices = _mm_add_epi32(_mm_set1_epi32(static_cast<int>(firstIndex)), _mm_set_epi32(3, 2, 1, 0));
+
+	for (; valueIndex + 4 <= count; valueIndex += 4)
+	{
+		__m128 values = NoiseUintToZeroToOneExact4(GetNoiseUint4(indices, seeds));
+		_mm_storeu_ps(outValues + valueIndex, _mm_add_ps(rangeStarts, _mm_mul_ps(values, ranges)));
+		indices = _mm_add_epi32(indices, laneStep);
+	}
+#endif
+
+	for (; valueIndex < count; valueIndex++)
+	{
+		float value = Get1dNoiseZeroToOne(static_cast<int>(firstIndex + valueIndex), streamSeed);
+		outValues[valueIndex] = outRangeStart + value * outRange;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+RandomNumberGenerator::RandomNumberGenerator(unsigned int seed, unsigned int stream)
 	: m_currentSeed(seed)
+	, m_stream(stream)
+	, m_streamSeed(GetNoiseStreamSeed(stream, seed))
 	, m_position(0)
 {
 
@@ -27,7 +92,7 @@ int RandomNumberGenerator::GetRandomIntLessThan( int maxInt )
 	//int ranInt = rand() % minInt;
 	//return ranInt;
 
-	unsigned int randNum = Get1dNoiseUint( m_position, m_currentSeed );
+	unsigned int randNum = Get1dNoiseUint( m_position, m_streamSeed );
 	m_position++;
 	return randNum % maxInt;
 }
@@ -39,7 +104,7 @@ int RandomNumberGenerator::GetRandomIntInRange( int minInt, int maxInt )
 {
 	//return minInt + (rand() % (maxInt - minInt + 1));
 
-	unsigned int randNum = Get1dNoiseUint(m_position, m_currentSeed);
+	unsigned int randNum = Get1dNoiseUint(m_position, m_streamSeed);
 	m_position++;
 	//get ranfe here
 
@@ -58,7 +123,7 @@ uint RandomNumberGenerator::GetCurrentSeed()
 //------------------------------------------------------------------------------------------------------------------------------
 float RandomNumberGenerator::GetRandomFloatZeroToOne()
 {
-	float randNum = Get1dNoiseZeroToOne(m_position, m_currentSeed);
+	float randNum = Get1dNoiseZeroToOne(m_position, m_streamSeed);
 	m_position++;
 	return randNum;
 }
@@ -71,7 +136,7 @@ float RandomNumberGenerator::GetRandomFloatInRange( float minFloat, float maxFlo
 	//float ranFloat = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
 	//return minFloat + ranFloat / (maxFloat - minFloat);
 
-	float randZeroToOne = Get1dNoiseZeroToOne(m_position, m_currentSeed);
+	float randZeroToOne = Get1dNoiseZeroToOne(m_position, m_streamSeed);
 	m_position++;
 	float randNum = RangeMapFloat(randZeroToOne, 0.0f, 1.0f, minFloat, maxFloat);
 	return randNum;
@@ -81,6 +146,134 @@ float RandomNumberGenerator::GetRandomFloatInRange( float minFloat, float maxFlo
 void RandomNumberGenerator::Seed( unsigned int newSeed )
 {
 	m_currentSeed = newSeed;
+	m_streamSeed = GetNoiseStreamSeed(m_stream, m_currentSeed);
+	m_position = 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool RandomNumberGenerator::PercentChance( float probabilityToReturnTrue )
+{
+	return GetRandomFloatZeroToOne() < probabilityToReturnTrue;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+uint RandomNumberGenerator::GetRandomUint()
+{
+	uint randNum = Get1dNoiseUint(m_position, m_streamSeed);
+	m_position++;
+	return randNum;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Vec2 RandomNumberGenerator::GetRandomDirection2D()
+{
+	float radians = GetRandomFloatZeroToOne() * RNG_TWO_PI;
+	return Vec2(cosf(radians), sinf(radians));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Uniform on the sphere: z is uniform in [-1,1] (Archimedes) and the angle around z is uniform
+//------------------------------------------------------------------------------------------------------------------------------
+Vec3 RandomNumberGenerator::GetRandomDirection3D()
+{
+	float z = GetRandomFloatZeroToOne() * 2.f - 1.f;
+	float radians = GetRandomFloatZeroToOne() * RNG_TWO_PI;
+
+	float radiusXY = sqrtf(fmaxf(0.f, 1.f - z * z));
+	return Vec3(radiusXY * cosf(radians), radiusXY * sinf(radians), z);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void RandomNumberGenerator::SetStream( uint stream )
+{
+	m_stream = stream;
+	m_streamSeed = GetNoiseStreamSeed(m_stream, m_currentSeed);
 	m_position = 0;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+// The split's stream is hashed from this generator's stream, so splits of splits stay independent too
+//------------------------------------------------------------------------------------------------------------------------------
+RandomNumberGenerator RandomNumberGenerator::GetSplit( uint splitIndex ) const
+{
+	return RandomNumberGenerator(m_currentSeed, Get2dNoiseUint(static_cast<int>(splitIndex), static_cast<int>(m_stream), m_currentSeed) | 1U);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC uint RandomNumberGenerator::GetUintAt( uint seed, uint stream, uint index )
+{
+	return GetStreamNoiseUint(static_cast<int>(index), stream, seed);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC float RandomNumberGenerator::GetFloatZeroToOneAt( uint seed, uint stream, uint index )
+{
+	return GetStreamNoiseZeroToOne(static_cast<int>(index), stream, seed);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void RandomNumberGenerator::FillUints( uint* outValues, int count )
+{
+	FillStreamUints(outValues, count, m_streamSeed, m_position);
+	m_position += count;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void RandomNumberGenerator::FillFloatsZeroToOne( float* outValues, int count )
+{
+	FillStreamFloats(outValues, count, m_streamSeed, m_position, 0.f, 1.f);
+	m_position += count;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Same math as RangeMapFloat from [0,1], so the values match GetRandomFloatInRange
+//------------------------------------------------------------------------------------------------------------------------------
+void RandomNumberGenerator::FillFloatsInRange( float* outValues, int count, float minFloat, float maxFloat )
+{
+	FillStreamFloats(outValues, count, m_streamSeed, m_position, minFloat, maxFloat - minFloat);
+	m_position += count;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void RandomNumberGenerator::FillDirections2D( Vec2* outDirections, int count )
+{
+	float radians[RNG_BULK_CHUNK_SIZE];
+
+	for (int first = 0; first < count; first += RNG_BULK_CHUNK_SIZE)
+	{
+		int chunkSize = (count - first < RNG_BULK_CHUNK_SIZE) ? count - first : RNG_BULK_CHUNK_SIZE;
+		FillStreamFloats(radians, chunkSize, m_streamSeed, m_position, 0.f, 1.f);
+		m_position += chunkSize;
+
+		for (int valueIndex = 0; valueIndex < chunkSize; valueIndex++)
+		{
+			float angle = radians[valueIndex] * RNG_TWO_PI;
+			outDirections[first + valueIndex] = Vec2(cosf(angle), sinf(angle));
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void RandomNumberGenerator::FillDirections3D( Vec3* outDirections, int count )
+{
+	//Pairs of values (z, angle) per direction, same order as GetRandomDirection3D
+	float values[RNG_BULK_CHUNK_SIZE];
+	constexpr int DIRECTIONS_PER_CHUNK = RNG_BULK_CHUNK_SIZE / 2;
+
+	for (int first = 0; first < count; first += DIRECTIONS_PER_CHUNK)
+	{
+		int chunkSize = (count - first < DIRECTIONS_PER_CHUNK) ? count - first : DIRECTIONS_PER_CHUNK;
+		FillStreamFloats(values, chunkSize * 2, m_streamSeed, m_position, 0.f, 1.f);
+		m_position += chunkSize * 2;
+
+		for (int valueIndex = 0; valueIndex < chunkSize; valueIndex++)
+		{
+			float z = values[valueIndex * 2] * 2.f - 1.f;
+			float angle = values[valueIndex * 2 + 1] * RNG_TWO_PI;
+
+			float radiusXY = sqrtf(fmaxf(0.f, 1.f - z * z));
+			outDirections[first + valueIndex] = Vec3(radiusXY * cosf(angle), radiusXY * sinf(angle), z);
+		}
+	}
+}
+
@@ -2,11 +2,20 @@
 #pragma once
 typedef unsigned int uint;
 
+struct Vec2;
+struct Vec3;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Counter-based random numbers: value N of a generator is GetStreamNoiseUint(N, stream, seed) from RawNoise.hpp, so the
+// generator is just a (seed, stream, position) triple. Skipping ahead is free, two generators on different streams never
+// share state, and the bulk Fill functions return exactly what the same number of single calls would have.
+//
+// For parallel work give every job or thread its own generator with GetSplit(jobIndex) instead of sharing one.
 //------------------------------------------------------------------------------------------------------------------------------
 class RandomNumberGenerator
 {
 public:
-	RandomNumberGenerator(unsigned int seed = 0);
+	RandomNumberGenerator(unsigned int seed = 0, unsigned int stream = 0);
 	~RandomNumberGenerator();
 
 	//Public Methods
@@ -18,8 +27,34 @@ public:
 	bool				PercentChance(float probabilityToReturnTrue);
 	void				Seed (unsigned int newSeed);
 
+	uint				GetRandomUint();
+	Vec2				GetRandomDirection2D();						// uses 1 value
+	Vec3				GetRandomDirection3D();						// uses 2 values
+
+	//Streams and positions
+	inline uint			GetStream() const							{ return m_stream; }
+	inline uint			GetPosition() const							{ return m_position; }
+	inline void			SetPosition(uint position)					{ m_position = position; }
+	inline void			Skip(uint numValues)						{ m_position += numValues; }
+	void				SetStream(uint stream);
+
+	RandomNumberGenerator	GetSplit(uint splitIndex) const;		// independent generator keyed by this one's seed and stream
+
+	//Stateless access, value <index> of stream <stream> for <seed>
+	static uint			GetUintAt(uint seed, uint stream, uint index);
+	static float		GetFloatZeroToOneAt(uint seed, uint stream, uint index);
+
+	//Bulk versions, each fills count values and moves the position past them
+	void				FillUints(uint* outValues, int count);
+	void				FillFloatsZeroToOne(float* outValues, int count);
+	void				FillFloatsInRange(float* outValues, int count, float minFloat, float maxFloat);
+	void				FillDirections2D(Vec2* outDirections, int count);
+	void				FillDirections3D(Vec3* outDirections, int count);
+
 private:
 	//Private Methods
 	uint				m_currentSeed = 0;
+	uint				m_stream = 0;
+	uint				m_streamSeed = 0;							// GetNoiseStreamSeed(m_stream, m_currentSeed)
 	uint				m_position = 0;
 };
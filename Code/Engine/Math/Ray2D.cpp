@@ -1,8 +1,10 @@
 #include "Engine/Math/Ray2D.hpp"
+#include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/Capsule2D.hpp"
 #include "Engine/Math/ConvexHull2D.hpp"
 #include "Engine/Math/Disc2D.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/OBB2.hpp"
 #include "Engine/Math/Plane2D.hpp"
 #include "Engine/Commons/EngineCommon.hpp"
 #include "Engine/Commons/Profiler/Profiler.hpp"
@@ -326,3 +328,65 @@ uint Raycast(RayHit2D *out, const Ray2D& ray, ConvexHull2D const &hull, float ep
 	//gProfiler->ProfilerPop();
 	return numHits;
 }
+
+//------------------------------------------------------------------------------------------------------------------------------
+uint Raycast(float *out, Ray2D ray, OBB2 const &box)
+{
+	//Move the ray into the box's space and it becomes an AABB2 test
+	Vec2 localStart = box.ToLocalPoint(ray.m_start);
+	Vec2 localDirection = Vec2(GetDotProduct(ray.m_direction, box.GetRight()), GetDotProduct(ray.m_direction, box.GetUp()));
+
+	Ray2D localRay(localStart, localDirection);
+	AABB2 localBox(box.GetHalfExtents() * -1.f, box.GetHalfExtents());
+
+	return Raycast(out, localRay, localBox);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+uint Raycast(float *out, Ray2D ray, AABB2 const &box)
+{
+	// Slab test, out[0] is the time we enter the box and out[1] the time we leave it
+	// out[0] is negative when the ray starts inside the box
+	float timeEnter = -100000000.f;
+	float timeExit = 100000000.f;
+
+	float starts[2] = { ray.m_start.x, ray.m_start.y };
+	float directions[2] = { ray.m_direction.x, ray.m_direction.y };
+	float mins[2] = { box.m_minBounds.x, box.m_minBounds.y };
+	float maxs[2] = { box.m_maxBounds.x, box.m_maxBounds.y };
+
+	for (int axis = 0; axis < 2; axis++)
+	{
+		if (directions[axis] == 0.f)
+		{
+			//Parallel to this slab, we miss unless we start between the sides
+			if (starts[axis] < mins[axis] || starts[axis] > maxs[axis])
+			{
+				return 0U;
+			}
+			continue;
+		}
+
+		float inverseDirection = 1.f / directions[axis];
+		float timeToMin = (mins[axis] - starts[axis]) * inverseDirection;
+		float timeToMax = (maxs[axis] - starts[axis]) * inverseDirection;
+
+		timeEnter = GetHigherValue(timeEnter, GetLowerValue(timeToMin, timeToMax));
+		timeExit = GetLowerValue(timeExit, GetHigherValue(timeToMin, timeToMax));
+
+		if (timeEnter > timeExit)
+		{
+			return 0U;
+		}
+	}
+
+	//Box is behind the ray
+	if (timeExit < 0.f)
+	{
+		return 0U;
+	}
+
+	out[0] = timeEnter;
+	out[1] = timeExit;
+	return 2U;
+}
@@ -0,0 +1,744 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Math/RaycastBatch2D.hpp"
+//Engine Systems
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/ConvexHull2D.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <algorithm>
+
+//4 rays per packet, one per lane
+#if !defined(ENGINE_DISABLE_SIMD) && (defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__))
+#define RAYCAST_BATCH_USE_SSE
+#include <emmintrin.h>
+#endif
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr float			RAYCAST_NO_DIRECTION_INVERSE = 1e30f;		// finite so the slab test never sees 0 * inf
+constexpr int			RAYCAST_MAX_STACK_SIZE = 64;				// median splits keep the depth at log2 of the shape count
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct RaycastShapes2D::RayPacket
+{
+	alignas(16) float		m_startX[4];
+	alignas(16) float		m_startY[4];
+	alignas(16) float		m_directionX[4];
+	alignas(16) float		m_directionY[4];
+	alignas(16) float		m_inverseX[4];
+	alignas(16) float		m_inverseY[4];
+	alignas(16) float		m_lengthSquared[4];
+	alignas(16) float		m_bestTime[4];				// -1 for lanes without a ray, so nothing is ever closer
+	alignas(16) int			m_bestShape[4];
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+void RayBatch2D::AddRay( const Ray2D& ray, float maxTime )
+{
+	AddRay(ray.m_start, ray.m_direction, maxTime);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void RayBatch2D::AddRay( const Vec2& start, const Vec2& direction, float maxTime )
+{
+	m_startX.push_back(start.x);
+	m_startY.push_back(start.y);
+	m_directionX.push_back(direction.x);
+	m_directionY.push_back(direction.y);
+	m_maxTime.push_back(maxTime);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void RayBatch2D::Reserve( int numRays )
+{
+	m_startX.reserve(numRays);
+	m_startY.reserve(numRays);
+	m_directionX.reserve(numRays);
+	m_directionY.reserve(numRays);
+	m_maxTime.reserve(numRays);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void RayBatch2D::Clear()
+{
+	m_startX.clear();
+	m_startY.clear();
+	m_directionX.clear();
+	m_directionY.clear();
+	m_maxTime.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Kernels. Each tests every lane of a packet against one shape and keeps the hit if it is closer than the lane's best.
+// The scalar and SSE versions do the same operations in the same order.
+//------------------------------------------------------------------------------------------------------------------------------
+#if defined(RAYCAST_BATCH_USE_SSE)
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void KeepCloserHits( RaycastShapes2D::RayPacket& packet, __m128 hits, __m128 times, int shapeId )
+{
+	__m128 bestTime = _mm_load_ps(packet.m_bestTime);
+	hits = _mm_and_ps(hits, _mm_cmplt_ps(times, bestTime));
+	if (_mm_movemask_ps(hits) == 0)
+	{
+		return;
+	}
+
+	_mm_store_ps(packet.m_bestTime, _mm_or_ps(_mm_and_ps(hits, times), _mm_andnot_ps(hits, bestTime)));
+
+	__m128i hitsInt = _mm_castps_si128(hits);
+	__m128i bestShape = _mm_load_si128(reinterpret_cast<const __m128i*>(packet.m_bestShape));
+	bestShape = _mm_or_si128(_mm_and_si128(hitsInt, _mm_set1_epi32(shapeId)), _mm_andnot_si128(hitsInt, bestShape));
+	_mm_store_si128(reinterpret_cast<__m128i*>(packet.m_bestShape), bestShape);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static __m128 RaycastSlabs4( __m128* outTimes, __m128 startX, __m128 startY, __m128 inverseX, __m128 inverseY, float minX, float minY, float maxX, float maxY )
+{
+	__m128 timeX1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(minX), startX), inverseX);
+	__m128 timeX2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(maxX), startX), inverseX);
+	__m128 timeY1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(minY), startY), inverseY);
+	__m128 timeY2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(maxY), startY), inverseY);
+
+	__m128 enterTime = _mm_max_ps(_mm_min_ps(timeX1, timeX2), _mm_min_ps(timeY1, timeY2));
+	__m128 exitTime = _mm_min_ps(_mm_max_ps(timeX1, timeX2), _mm_max_ps(timeY1, timeY2));
+
+	*outTimes = _mm_max_ps(enterTime, _mm_setzero_ps());
+	return _mm_and_ps(_mm_cmpge_ps(exitTime, enterTime), _mm_cmpge_ps(exitTime, _mm_setzero_ps()));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void RaycastAABB2Packet( RaycastShapes2D::RayPacket& packet, float minX, float minY, float maxX, float maxY, int shapeId )
+{
+	__m128 times;
+	__m128 hits = RaycastSlabs4(&times, _mm_load_ps(packet.m_startX), _mm_load_ps(packet.m_startY), _mm_load_ps(packet.m_inverseX), _mm_load_ps(packet.m_inverseY), minX, minY, maxX, maxY);
+	KeepCloserHits(packet, hits, times, shapeId);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void RaycastDiscPacket( RaycastShapes2D::RayPacket& packet, float centerX, float centerY, float radius, int shapeId )
+{
+	//|s + td - c|^2 = r^2 with m = s - c  ->  (d.d)t^2 + 2(m.d)t + (m.m - r^2) = 0
+	__m128 toStartX = _mm_sub_ps(_mm_load_ps(packet.m_startX), _mm_set1_ps(centerX));
+	__m128 toStartY = _mm_sub_ps(_mm_load_ps(packet.m_startY), _mm_set1_ps(centerY));
+	__m128 directionX = _mm_load_ps(packet.m_directionX);
+	__m128 directionY = _mm_load_ps(packet.m_directionY);
+	__m128 lengthSquared = _mm_load_ps(packet.m_lengthSquared);
+
+	__m128 halfB = _mm_add_ps(_mm_mul_ps(toStartX, directionX), _mm_mul_ps(toStartY, directionY));
+	__m128 c = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(toStartX, toStartX), _mm_mul_ps(toStartY, toStartY)), _mm_set1_ps(radius * radius));
+	__m128 discriminant = _mm_sub_ps(_mm_mul_ps(halfB, halfB), _mm_mul_ps(lengthSquared, c));
+
+	__m128 inside = _mm_cmple_ps(c, _mm_setzero_ps());
+	__m128 approaching = _mm_and_ps(_mm_cmplt_ps(halfB, _mm_setzero_ps()), _mm_cmpge_ps(discriminant, _mm_setzero_ps()));
+
+	//Misses may divide by 0 here, they are masked out below
+	__m128 root = _mm_sqrt_ps(_mm_max_ps(discriminant, _mm_setzero_ps()));
+	__m128 times = _mm_div_ps(_mm_sub_ps(_mm_setzero_ps(), _mm_add_ps(halfB, root)), lengthSquared);
+	times = _mm_andnot_ps(inside, times);
+
+	KeepCloserHits(packet, _mm_or_ps(inside, approaching), times, shapeId);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void RaycastBoxPacket( RaycastShapes2D::RayPacket& packet, const OBB2& box, int shapeId )
+{
+	//Move the rays into the box's space and it becomes an AABB2 test
+	__m128 rightX = _mm_set1_ps(box.m_right.x);
+	__m128 rightY = _mm_set1_ps(box.m_right.y);
+	__m128 upX = _mm_set1_ps(box.m_up.x);
+	__m128 upY = _mm_set1_ps(box.m_up.y);
+
+	__m128 toStartX = _mm_sub_ps(_mm_load_ps(packet.m_startX), _mm_set1_ps(box.m_center.x));
+	__m128 toStartY = _mm_sub_ps(_mm_load_ps(packet.m_startY), _mm_set1_ps(box.m_center.y));
+	__m128 directionX = _mm_load_ps(packet.m_directionX);
+	__m128 directionY = _mm_load_ps(packet.m_directionY);
+
+	__m128 localStartX = _mm_add_ps(_mm_mul_ps(toStartX, rightX), _mm_mul_ps(toStartY, rightY));
+	__m128 localStartY = _mm_add_ps(_mm_mul_ps(toStartX, upX), _mm_mul_ps(toStartY, upY));
+	__m128 localDirectionX = _mm_add_ps(_mm_mul_ps(directionX, rightX), _mm_mul_ps(directionY, rightY));
+	__m128 localDirectionY = _mm_add_ps(_mm_mul_ps(directionX, upX), _mm_mul_ps(directionY, upY));
+
+	__m128 noDirection = _mm_set1_ps(RAYCAST_NO_DIRECTION_INVERSE);
+	__m128 zeroX = _mm_cmpeq_ps(localDirectionX, _mm_setzero_ps());
+	__m128 zeroY = _mm_cmpeq_ps(localDirectionY, _mm_setzero_ps());
+	__m128 inverseX = _mm_or_ps(_mm_and_ps(zeroX, noDirection), _mm_andnot_ps(zeroX, _mm_div_ps(_mm_set1_ps(1.f), localDirectionX)));
+	__m128 inverseY = _mm_or_ps(_mm_and_ps(zeroY, noDirection), _mm_andnot_ps(zeroY, _mm_div_ps(_mm_set1_ps(1.f), localDirectionY)));
+
+	const Vec2& halfExtents = box.m_halfExtents;
+	__m128 times;
+	__m128 hits = RaycastSlabs4(&times, localStartX, localStartY, inverseX, inverseY, -halfExtents.x, -halfExtents.y, halfExtents.x, halfExtents.y);
+	KeepCloserHits(packet, hits, times, shapeId);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static bool PacketHitsBounds( const RaycastShapes2D::RayPacket& packet, const Vec2& mins, const Vec2& maxs )
+{
+	__m128 times;
+	__m128 hits = RaycastSlabs4(&times, _mm_load_ps(packet.m_startX), _mm_load_ps(packet.m_startY), _mm_load_ps(packet.m_inverseX), _mm_load_ps(packet.m_inverseY), mins.x, mins.y, maxs.x, maxs.y);
+	hits = _mm_and_ps(hits, _mm_cmplt_ps(times, _mm_load_ps(packet.m_bestTime)));
+	return _mm_movemask_ps(hits) != 0;
+}
+
+#else
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void KeepCloserHit( RaycastShapes2D::RayPacket& packet, int lane, float time, int shapeId )
+{
+	if (time < packet.m_bestTime[lane])
+	{
+		packet.m_bestTime[lane] = time;
+		packet.m_bestShape[lane] = shapeId;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static bool RaycastSlabs( float* outTime, float startX, float startY, float inverseX, float inverseY, float minX, float minY, float maxX, float maxY )
+{
+	float timeX1 = (minX - startX) * inverseX;
+	float timeX2 = (maxX - startX) * inverseX;
+	float timeY1 = (minY - startY) * inverseY;
+	float timeY2 = (maxY - startY) * inverseY;
+
+	float enterTime = std::max(std::min(timeX1, timeX2), std::min(timeY1, timeY2));
+	float exitTime = std::min(std::max(timeX1, timeX2), std::max(timeY1, timeY2));
+
+	*outTime = std::max(enterTime, 0.f);
+	return (exitTime >= enterTime) && (exitTime >= 0.f);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void RaycastAABB2Packet( RaycastShapes2D::RayPacket& packet, float minX, float minY, float maxX, float maxY, int shapeId )
+{
+	for (int lane = 0; lane < 4; lane++)
+	{
+		float time;
+		if (RaycastSlabs(&time, packet.m_startX[lane], packet.m_startY[lane], packet.m_inverseX[lane], packet.m_inverseY[lane], minX, minY, maxX, maxY))
+		{
+			KeepCloserHit(packet, lane, time, shapeId);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void RaycastDiscPacket( RaycastShapes2D::RayPacket& packet, float centerX, float centerY, float radius, int shapeId )
+{
+	for (int lane = 0; lane < 4; lane++)
+	{
+		float toStartX = packet.m_startX[lane] - centerX;
+		float toStartY = packet.m_startY[lane] - centerY;
+
+		float halfB = toStartX * packet.m_directionX[lane] + toStartY * packet.m_directionY[lane];
+		float c = (toStartX * toStartX + toStartY * toStartY) - radius * radius;
+		float discriminant = halfB * halfB - packet.m_lengthSquared[lane] * c;
+
+		if (c <= 0.f)
+		{
+			KeepCloserHit(packet, lane, 0.f, shapeId);
+		}
+		else if (halfB < 0.f && discriminant >= 0.f)
+		{
+			KeepCloserHit(packet, lane, (0.f - (halfB + sqrtf(discriminant))) / packet.m_lengthSquared[lane], shapeId);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void RaycastBoxPacket( RaycastShapes2D::RayPacket& packet, const OBB2& box, int shapeId )
+{
+	const Vec2& halfExtents = box.m_halfExtents;
+	for (int lane = 0; lane < 4; lane++)
+	{
+		float toStartX = packet.m_startX[lane] - box.m_center.x;
+		float toStartY = packet.m_startY[lane] - box.m_center.y;
+
+		float localStartX = toStartX * box.m_right.x + toStartY * box.m_right.y;
+		float localStartY = toStartX * box.m_up.x + toStartY * box.m_up.y;
+		float localDirectionX = packet.m_directionX[lane] * box.m_right.x + packet.m_directionY[lane] * box.m_right.y;
+		float localDirectionY = packet.m_directionX[lane] * box.m_up.x + packet.m_directionY[lane] * box.m_up.y;
+
+		float inverseX = (localDirectionX == 0.f) ? RAYCAST_NO_DIRECTION_INVERSE : 1.f / localDirectionX;
+		float inverseY = (localDirectionY == 0.f) ? RAYCAST_NO_DIRECTION_INVERSE : 1.f / localDirectionY;
+
+		float time;
+		if (RaycastSlabs(&time, localStartX, localStartY, inverseX, inverseY, -halfExtents.x, -halfExtents.y, halfExtents.x, halfExtents.y))
+		{
+			KeepCloserHit(packet, lane, time, shapeId);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static bool PacketHitsBounds( const RaycastShapes2D::RayPacket& packet, const Vec2& mins, const Vec2& maxs )
+{
+	for (int lane = 0; lane < 4; lane++)
+	{
+		float time;
+		if (RaycastSlabs(&time, packet.m_startX[lane], packet.m_startY[lane], packet.m_inverseX[lane], packet.m_inverseY[lane], mins.x, mins.y, maxs.x, maxs.y) && time < packet.m_bestTime[lane])
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+#endif
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void RaycastHullPacket( RaycastShapes2D::RayPacket& packet, const ConvexHull2D& hull, int shapeId )
+{
+	//No kernel for hulls, use the single ray test for each lane that still has a ray
+	for (int lane = 0; lane < 4; lane++)
+	{
+		if (packet.m_bestTime[lane] < 0.f)
+		{
+			continue;
+		}
+
+		Ray2D ray(Vec2(packet.m_startX[lane], packet.m_startY[lane]), Vec2(packet.m_directionX[lane], packet.m_directionY[lane]));
+		RayHit2D hit;
+		if (Raycast(&hit, ray, hull) > 0 && hit.m_timeAtHit >= 0.f && hit.m_timeAtHit < packet.m_bestTime[lane])
+		{
+			packet.m_bestTime[lane] = hit.m_timeAtHit;
+			packet.m_bestShape[lane] = shapeId;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+RaycastShapes2D::RaycastShapes2D()
+{
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+RaycastShapes2D::~RaycastShapes2D()
+{
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int RaycastShapes2D::AddShape( eRaycastShapeType2D type, int typeIndex, const AABB2& bounds )
+{
+	m_shapeTypes.push_back(static_cast<uchar>(type));
+	m_shapeTypeIndices.push_back(typeIndex);
+	m_shapeBounds.push_back(bounds);
+
+	m_broadPhaseDirty = true;
+	return static_cast<int>(m_shapeTypes.size()) - 1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int RaycastShapes2D::AddAABB2( const AABB2& box )
+{
+	m_aabbMinX.push_back(box.m_minBounds.x);
+	m_aabbMinY.push_back(box.m_minBounds.y);
+	m_aabbMaxX.push_back(box.m_maxBounds.x);
+	m_aabbMaxY.push_back(box.m_maxBounds.y);
+
+	return AddShape(RAYCAST_SHAPE_AABB2, static_cast<int>(m_aabbMinX.size()) - 1, box);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int RaycastShapes2D::AddDisc( const Vec2& center, float radius )
+{
+	m_discCenterX.push_back(center.x);
+	m_discCenterY.push_back(center.y);
+	m_discRadius.push_back(radius);
+
+	AABB2 bounds(Vec2(center.x - radius, center.y - radius), Vec2(center.x + radius, center.y + radius));
+	return AddShape(RAYCAST_SHAPE_DISC, static_cast<int>(m_discRadius.size()) - 1, bounds);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int RaycastShapes2D::AddBox( const OBB2& box )
+{
+	m_boxes.push_back(box);
+
+	Vec2 corners[4];
+	box.GetCorners(corners);
+
+	AABB2 bounds(corners[0], corners[0]);
+	for (int cornerIndex = 1; cornerIndex < 4; cornerIndex++)
+	{
+		bounds.m_minBounds = Vec2(GetLowerValue(bounds.m_minBounds.x, corners[cornerIndex].x), GetLowerValue(bounds.m_minBounds.y, corners[cornerIndex].y));
+		bounds.m_maxBounds = Vec2(GetHigherValue(bounds.m_maxBounds.x, corners[cornerIndex].x), GetHigherValue(bounds.m_maxBounds.y, corners[cornerIndex].y));
+	}
+
+	return AddShape(RAYCAST_SHAPE_BOX, static_cast<int>(m_boxes.size()) - 1, bounds);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int RaycastShapes2D::AddCapsule( const Capsule2D& capsule )
+{
+	m_capsules.push_back(capsule);
+
+	//The body between the end discs is a box as long as the segment and as thick as the capsule
+	Vec2 segment = capsule.m_end - capsule.m_start;
+	float length = segment.GetLength();
+
+	OBB2 body;
+	body.m_right = (length > 0.f) ? segment / length : Vec2(1.f, 0.f);
+	body.m_up = body.m_right.GetRotated90Degrees();
+	body.m_center = (capsule.m_start + capsule.m_end) * 0.5f;
+	body.m_halfExtents = Vec2(length * 0.5f, capsule.m_radius);
+	m_capsuleBoxes.push_back(body);
+
+	return AddShape(RAYCAST_SHAPE_CAPSULE, static_cast<int>(m_capsules.size()) - 1, capsule.GetBoundingAABB());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int RaycastShapes2D::AddConvexHull( const ConvexHull2D* hull, const AABB2& bounds )
+{
+	m_hulls.push_back(hull);
+	return AddShape(RAYCAST_SHAPE_HULL, static_cast<int>(m_hulls.size()) - 1, bounds);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void RaycastShapes2D::Clear()
+{
+	m_shapeTypes.clear();
+	m_shapeTypeIndices.clear();
+	m_shapeBounds.clear();
+
+	m_aabbMinX.clear();
+	m_aabbMinY.clear();
+	m_aabbMaxX.clear();
+	m_aabbMaxY.clear();
+
+	m_discCenterX.clear();
+	m_discCenterY.clear();
+	m_discRadius.clear();
+
+	m_boxes.clear();
+	m_capsules.clear();
+	m_capsuleBoxes.clear();
+	m_hulls.clear();
+
+	m_nodes.clear();
+	m_leafShapeIds.clear();
+	m_broadPhaseDirty = true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void RaycastShapes2D::EnableBroadPhase( bool enable, int maxShapesPerLeaf )
+{
+	m_useBroadPhase = enable;
+
+	int leafSize = (maxShapesPerLeaf < 1) ? 1 : maxShapesPerLeaf;
+	if (leafSize != m_maxShapesPerLeaf)
+	{
+		m_maxShapesPerLeaf = leafSize;
+		m_broadPhaseDirty = true;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void RaycastShapes2D::BuildBroadPhase()
+{
+	m_nodes.clear();
+	m_leafShapeIds.clear();
+	m_broadPhaseDirty = false;
+
+	int numShapes = GetNumShapes();
+	if (numShapes == 0)
+	{
+		return;
+	}
+
+	m_leafShapeIds.resize(numShapes);
+	for (int shapeIndex = 0; shapeIndex < numShapes; shapeIndex++)
+	{
+		m_leafShapeIds[shapeIndex] = shapeIndex;
+	}
+
+	m_nodes.reserve(2 * (numShapes / m_maxShapesPerLeaf) + 1);
+	m_nodes.push_back(Node());
+	BuildNode(0, 0, numShapes);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void RaycastShapes2D::BuildNode( int nodeIndex, int firstShape, int numShapes )
+{
+	const AABB2& firstBounds = m_shapeBounds[m_leafShapeIds[firstShape]];
+	Vec2 mins = firstBounds.m_minBounds;
+	Vec2 maxs = firstBounds.m_maxBounds;
+	Vec2 centerMins = (mins + maxs) * 0.5f;
+	Vec2 centerMaxs = centerMins;
+
+	for (int shapeIndex = firstShape + 1; shapeIndex < firstShape + numShapes; shapeIndex++)
+	{
+		const AABB2& bounds = m_shapeBounds[m_leafShapeIds[shapeIndex]];
+		mins = Vec2(GetLowerValue(mins.x, bounds.m_minBounds.x), GetLowerValue(mins.y, bounds.m_minBounds.y));
+		maxs = Vec2(GetHigherValue(maxs.x, bounds.m_maxBounds.x), GetHigherValue(maxs.y, bounds.m_maxBounds.y));
+
+		Vec2 center = (bounds.m_minBounds + bounds.m_maxBounds) * 0.5f;
+		centerMins = Vec2(GetLowerValue(centerMins.x, center.x), GetLowerValue(centerMins.y, center.y));
+		centerMaxs = Vec2(GetHigherValue(centerMaxs.x, center.x), GetHigherValue(centerMaxs.y, center.y));
+	}
+
+	m_nodes[nodeIndex].m_mins = mins;
+	m_nodes[nodeIndex].m_maxs = maxs;
+	m_nodes[nodeIndex].m_leftOrFirst = firstShape;
+	m_nodes[nodeIndex].m_numShapes = numShapes;
+
+	if (numShapes <= m_maxShapesPerLeaf)
+	{
+		return;
+	}
+
+	//Split the longest axis of the centers at the median
+	bool splitOnY = (centerMaxs.y - centerMins.y) > (centerMaxs.x - centerMins.x);
+	const std::vector<AABB2>& shapeBounds = m_shapeBounds;
+
+	int numLeft = numShapes / 2;
+	std::vector<int>::iterator first = m_leafShapeIds.begin() + firstShape;
+	std::nth_element(first, first + numLeft, first + numShapes, [&shapeBounds, splitOnY](int a, int b)
+	{
+		return splitOnY ? (shapeBounds[a].m_minBounds.y + shapeBounds[a].m_maxBounds.y) < (shapeBounds[b].m_minBounds.y + shapeBounds[b].m_maxBounds.y)
+			: (shapeBounds[a].m_minBounds.x + shapeBounds[a].m_maxBounds.x) < (shapeBounds[b].m_minBounds.x + shapeBounds[b].m_maxBounds.x);
+	});
+
+	//Push both children together so the right child is always next to the left
+	int leftChild = static_cast<int>(m_nodes.size());
+	m_nodes.push_back(Node());
+	m_nodes.push_back(Node());
+	m_nodes[nodeIndex].m_leftOrFirst = leftChild;
+	m_nodes[nodeIndex].m_numShapes = 0;
+
+	BuildNode(leftChild, firstShape, numLeft);
+	BuildNode(leftChild + 1, firstShape + numLeft, numShapes - numLeft);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void RaycastShapes2D::TestShape( RayPacket& packet, int shapeId ) const
+{
+	int typeIndex = m_shapeTypeIndices[shapeId];
+
+	switch (m_shapeTypes[shapeId])
+	{
+	case RAYCAST_SHAPE_AABB2:
+	{
+		RaycastAABB2Packet(packet, m_aabbMinX[typeIndex], m_aabbMinY[typeIndex], m_aabbMaxX[typeIndex], m_aabbMaxY[typeIndex], shapeId);
+	}
+	break;
+	case RAYCAST_SHAPE_DISC:
+	{
+		RaycastDiscPacket(packet, m_discCenterX[typeIndex], m_discCenterY[typeIndex], m_discRadius[typeIndex], shapeId);
+	}
+	break;
+	case RAYCAST_SHAPE_BOX:
+	{
+		RaycastBoxPacket(packet, m_boxes[typeIndex], shapeId);
+	}
+	break;
+	case RAYCAST_SHAPE_CAPSULE:
+	{
+		//Nearest of the two end discs and the body is the nearest hit on the capsule
+		const Capsule2D& capsule = m_capsules[typeIndex];
+		RaycastDiscPacket(packet, capsule.m_start.x, capsule.m_start.y, capsule.m_radius, shapeId);
+		RaycastDiscPacket(packet, capsule.m_end.x, capsule.m_end.y, capsule.m_radius, shapeId);
+		RaycastBoxPacket(packet, m_capsuleBoxes[typeIndex], shapeId);
+	}
+	break;
+	case RAYCAST_SHAPE_HULL:
+	{
+		RaycastHullPacket(packet, *m_hulls[typeIndex], shapeId);
+	}
+	break;
+	default:
+	break;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void RaycastShapes2D::TracePacket( RayPacket& packet ) const
+{
+	if (!m_useBroadPhase)
+	{
+		int numShapes = GetNumShapes();
+		for (int shapeId = 0; shapeId < numShapes; shapeId++)
+		{
+			TestShape(packet, shapeId);
+		}
+		return;
+	}
+
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	//Children are ordered along the direction of the first ray, coherent packets (a sensor fan) share it
+	Vec2 packetDirection(packet.m_directionX[0], packet.m_directionY[0]);
+
+	int nodeStack[RAYCAST_MAX_STACK_SIZE];
+	int stackSize = 0;
+	nodeStack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		const Node& node = m_nodes[nodeStack[--stackSize]];
+		if (!PacketHitsBounds(packet, node.m_mins, node.m_maxs))
+		{
+			continue;
+		}
+
+		if (node.m_numShapes > 0)
+		{
+			for (int leafIndex = node.m_leftOrFirst; leafIndex < node.m_leftOrFirst + node.m_numShapes; leafIndex++)
+			{
+				TestShape(packet, m_leafShapeIds[leafIndex]);
+			}
+			continue;
+		}
+
+		//Far child goes on the stack first
+		const Node& leftNode = m_nodes[node.m_leftOrFirst];
+		const Node& rightNode = m_nodes[node.m_leftOrFirst + 1];
+		Vec2 centerDifference = (leftNode.m_mins + leftNode.m_maxs) - (rightNode.m_mins + rightNode.m_maxs);
+		bool leftFirst = GetDotProduct(centerDifference, packetDirection) <= 0.f;
+
+		nodeStack[stackSize++] = leftFirst ? node.m_leftOrFirst + 1 : node.m_leftOrFirst;
+		nodeStack[stackSize++] = leftFirst ? node.m_leftOrFirst : node.m_leftOrFirst + 1;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Vec2 RaycastShapes2D::GetHitNormal( int shapeId, const Ray2D& ray, float time ) const
+{
+	//Starting inside the shape, same answer as the convex hull raycast
+	if (time <= 0.f)
+	{
+		return Vec2::UP;
+	}
+
+	int typeIndex = m_shapeTypeIndices[shapeId];
+	Vec2 hitPoint = ray.GetPointAtTime(time);
+
+	switch (m_shapeTypes[shapeId])
+	{
+	case RAYCAST_SHAPE_AABB2:
+	{
+		//The slab we entered last is the face we hit
+		float timeX = (ray.m_direction.x > 0.f) ? (m_aabbMinX[typeIndex] - ray.m_start.x) / ray.m_direction.x : ((ray.m_direction.x < 0.f) ? (m_aabbMaxX[typeIndex] - ray.m_start.x) / ray.m_direction.x : -RAYCAST_NO_DIRECTION_INVERSE);
+		float timeY = (ray.m_direction.y > 0.f) ? (m_aabbMinY[typeIndex] - ray.m_start.y) / ray.m_direction.y : ((ray.m_direction.y < 0.f) ? (m_aabbMaxY[typeIndex] - ray.m_start.y) / ray.m_direction.y : -RAYCAST_NO_DIRECTION_INVERSE);
+
+		if (timeX >= timeY)
+		{
+			return Vec2((ray.m_direction.x > 0.f) ? -1.f : 1.f, 0.f);
+		}
+		return Vec2(0.f, (ray.m_direction.y > 0.f) ? -1.f : 1.f);
+	}
+	case RAYCAST_SHAPE_DISC:
+	{
+		Vec2 normal = hitPoint - Vec2(m_discCenterX[typeIndex], m_discCenterY[typeIndex]);
+		float length = normal.GetLength();
+		return (length > 0.f) ? normal / length : Vec2::UP;
+	}
+	case RAYCAST_SHAPE_BOX:
+	{
+		//Largest local coordinate relative to the extents picks the face
+		const OBB2& box = m_boxes[typeIndex];
+		Vec2 localPoint = box.ToLocalPoint(hitPoint);
+		float faceX = (box.m_halfExtents.x > 0.f) ? fabsf(localPoint.x) / box.m_halfExtents.x : 0.f;
+		float faceY = (box.m_halfExtents.y > 0.f) ? fabsf(localPoint.y) / box.m_halfExtents.y : 0.f;
+
+		if (faceX >= faceY)
+		{
+			return (localPoint.x >= 0.f) ? box.m_right : box.m_right * -1.f;
+		}
+		return (localPoint.y >= 0.f) ? box.m_up : box.m_up * -1.f;
+	}
+	case RAYCAST_SHAPE_CAPSULE:
+	{
+		//Away from the closest point on the segment covers both the ends and the sides
+		const Capsule2D& capsule = m_capsules[typeIndex];
+		Vec2 segment = capsule.m_end - capsule.m_start;
+		float lengthSquared = segment.GetLengthSquared();
+		float fraction = (lengthSquared > 0.f) ? Clamp(GetDotProduct(hitPoint - capsule.m_start, segment) / lengthSquared, 0.f, 1.f) : 0.f;
+
+		Vec2 normal = hitPoint - (capsule.m_start + segment * fraction);
+		float length = normal.GetLength();
+		return (length > 0.f) ? normal / length : Vec2::UP;
+	}
+	case RAYCAST_SHAPE_HULL:
+	{
+		RayHit2D hit;
+		if (Raycast(&hit, ray, *m_hulls[typeIndex]) > 0)
+		{
+			return hit.m_impactNormal;
+		}
+		return Vec2::UP;
+	}
+	default:
+	break;
+	}
+
+	return Vec2::UP;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int RaycastShapes2D::RaycastNearest( RayHit2D* outHits, int* outShapeIds, const RayBatch2D& rays )
+{
+	if (m_useBroadPhase && m_broadPhaseDirty)
+	{
+		BuildBroadPhase();
+	}
+
+	int numRays = rays.GetCount();
+	int numHits = 0;
+
+	RayPacket packet;
+	for (int firstRay = 0; firstRay < numRays; firstRay += 4)
+	{
+		int numInPacket = (numRays - firstRay < 4) ? numRays - firstRay : 4;
+
+		//Unused lanes repeat the last ray with a best time nothing can beat
+		for (int lane = 0; lane < 4; lane++)
+		{
+			int rayIndex = firstRay + ((lane < numInPacket) ? lane : numInPacket - 1);
+			float directionX = rays.m_directionX[rayIndex];
+			float directionY = rays.m_directionY[rayIndex];
+
+			packet.m_startX[lane] = rays.m_startX[rayIndex];
+			packet.m_startY[lane] = rays.m_startY[rayIndex];
+			packet.m_directionX[lane] = directionX;
+			packet.m_directionY[lane] = directionY;
+			packet.m_inverseX[lane] = (directionX == 0.f) ? RAYCAST_NO_DIRECTION_INVERSE : 1.f / directionX;
+			packet.m_inverseY[lane] = (directionY == 0.f) ? RAYCAST_NO_DIRECTION_INVERSE : 1.f / directionY;
+			packet.m_lengthSquared[lane] = directionX * directionX + directionY * directionY;
+			packet.m_bestTime[lane] = (lane < numInPacket) ? rays.m_maxTime[rayIndex] : -1.f;
+			packet.m_bestShape[lane] = -1;
+		}
+
+		TracePacket(packet);
+
+		for (int lane = 0; lane < numInPacket; lane++)
+		{
+			int rayIndex = firstRay + lane;
+			int shapeId = packet.m_bestShape[lane];
+			Ray2D ray(Vec2(rays.m_startX[rayIndex], rays.m_startY[rayIndex]), Vec2(rays.m_directionX[rayIndex], rays.m_directionY[rayIndex]));
+
+			if (shapeId >= 0)
+			{
+				outHits[rayIndex].m_timeAtHit = packet.m_bestTime[lane];
+				outHits[rayIndex].m_hitPoint = ray.GetPointAtTime(packet.m_bestTime[lane]);
+				outHits[rayIndex].m_impactNormal = GetHitNormal(shapeId, ray, packet.m_bestTime[lane]);
+				numHits++;
+			}
+			else
+			{
+				outHits[rayIndex].m_timeAtHit = -1.f;
+				outHits[rayIndex].m_hitPoint = ray.m_start;
+				outHits[rayIndex].m_impactNormal = Vec2::ZERO;
+			}
+
+			if (outShapeIds != nullptr)
+			{
+				outShapeIds[rayIndex] = shapeId;
+			}
+		}
+	}
+
+	return numHits;
+}
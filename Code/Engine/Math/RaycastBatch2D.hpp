@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+//Engine Systems
+#include "Engine/Math/Capsule2D.hpp"
+#include "Engine/Math/OBB2.hpp"
+#include "Engine/Math/Ray2D.hpp"
+#include <vector>
+
+class ConvexHull2D;
+
+//------------------------------------------------------------------------------------------------------------------------------
+enum eRaycastShapeType2D
+{
+	RAYCAST_SHAPE_AABB2 = 0,
+	RAYCAST_SHAPE_DISC,
+	RAYCAST_SHAPE_BOX,
+	RAYCAST_SHAPE_CAPSULE,
+	RAYCAST_SHAPE_HULL,
+
+	NUM_RAYCAST_SHAPE_TYPES
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Rays for a batched query stored per component (SoA). Times are in units of the direction, so they are distances
+// when the directions are normalized.
+//------------------------------------------------------------------------------------------------------------------------------
+struct RayBatch2D
+{
+	void						AddRay(const Ray2D& ray, float maxTime = RAY_BATCH_MAX_TIME);
+	void						AddRay(const Vec2& start, const Vec2& direction, float maxTime = RAY_BATCH_MAX_TIME);
+
+	void						Reserve(int numRays);
+	void						Clear();
+
+	inline int					GetCount() const				{ return static_cast<int>(m_startX.size()); }
+
+	static constexpr float		RAY_BATCH_MAX_TIME = 1e30f;
+
+	std::vector<float>			m_startX;
+	std::vector<float>			m_startY;
+	std::vector<float>			m_directionX;
+	std::vector<float>			m_directionY;
+	std::vector<float>			m_maxTime;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// World space shapes that batches of rays are cast against, returning the nearest hit per ray
+//
+// Rays are traced 4 at a time with SSE against one shape at a time: AABB2s and boxes with a slab test (boxes move the rays
+// into their local space), discs with the quadratic, capsules as two discs and a box. Hulls fall back to the single ray
+// Raycast per ray. With the broad phase on, a median split BVH over the shape bounds is built lazily and a packet only
+// visits the nodes one of its rays can still hit, otherwise every shape is tested.
+//
+// A ray that starts inside a shape hits it at time 0 with Vec2::UP as the normal, the same as the convex hull Raycast.
+//------------------------------------------------------------------------------------------------------------------------------
+class RaycastShapes2D
+{
+public:
+	RaycastShapes2D();
+	~RaycastShapes2D();
+
+	//Returns the shape id reported in hits
+	int							AddAABB2(const AABB2& box);
+	int							AddDisc(const Vec2& center, float radius);
+	int							AddBox(const OBB2& box);
+	int							AddCapsule(const Capsule2D& capsule);
+	int							AddConvexHull(const ConvexHull2D* hull, const AABB2& bounds);		// hull is not copied, bounds are only used by the broad phase
+
+	void						Clear();
+	void						EnableBroadPhase(bool enable, int maxShapesPerLeaf = 4);
+
+	//Nearest hit per ray, returns the number of rays that hit something. Misses get a time of -1 and shape id -1.
+	//outShapeIds is optional.
+	int							RaycastNearest(RayHit2D* outHits, int* outShapeIds, const RayBatch2D& rays);
+
+	inline int					GetNumShapes() const			{ return static_cast<int>(m_shapeTypes.size()); }
+	inline int					GetNumNodes() const				{ return static_cast<int>(m_nodes.size()); }
+
+public:
+	struct RayPacket;
+
+private:
+	struct Node
+	{
+		Vec2					m_mins;
+		Vec2					m_maxs;
+		int						m_leftOrFirst = 0;				// first entry in m_leafShapeIds for leaves, left child otherwise
+		int						m_numShapes = 0;				// 0 for inner nodes, right child is left + 1
+	};
+
+	int							AddShape(eRaycastShapeType2D type, int typeIndex, const AABB2& bounds);
+	void						BuildBroadPhase();
+	void						BuildNode(int nodeIndex, int firstShape, int numShapes);
+
+	void						TracePacket(RayPacket& packet) const;
+	void						TestShape(RayPacket& packet, int shapeId) const;
+	Vec2						GetHitNormal(int shapeId, const Ray2D& ray, float time) const;
+
+private:
+	//Per shape
+	std::vector<uchar>			m_shapeTypes;
+	std::vector<int>			m_shapeTypeIndices;
+	std::vector<AABB2>			m_shapeBounds;
+
+	//Per type (SoA for the SIMD kernels)
+	std::vector<float>			m_aabbMinX;
+	std::vector<float>			m_aabbMinY;
+	std::vector<float>			m_aabbMaxX;
+	std::vector<float>			m_aabbMaxY;
+
+	std::vector<float>			m_discCenterX;
+	std::vector<float>			m_discCenterY;
+	std::vector<float>			m_discRadius;
+
+	std::vector<OBB2>			m_boxes;
+	std::vector<Capsule2D>		m_capsules;
+	std::vector<OBB2>			m_capsuleBoxes;					// the part between the two end discs
+	std::vector<const ConvexHull2D*>	m_hulls;
+
+	//Broad phase
+	bool						m_useBroadPhase = false;
+	bool						m_broadPhaseDirty = true;
+	int							m_maxShapesPerLeaf = 4;
+	std::vector<Node>			m_nodes;
+	std::vector<int>			m_leafShapeIds;
+};
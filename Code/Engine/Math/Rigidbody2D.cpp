@@ -40,6 +40,7 @@ Rigidbody2D::~Rigidbody2D()
 
 	if (m_collider != nullptr)
 	{
+		m_system->m_contactReport->RemoveCollider(m_collider);
 		delete m_collider;
 		m_collider = nullptr;
 	}
@@ -110,6 +111,12 @@ void Rigidbody2D::ApplyRotation()
 		collider->m_localShape.SetRotation(m_rotation * m_constraints.z);
 	}
 	break;
+	case COLLIDER_POLYGON:
+	{
+		PolygonCollider2D* collider = reinterpret_cast<PolygonCollider2D*>(m_collider);
+		collider->SetRotation(m_rotation * m_constraints.z);
+	}
+	break;
 	}
 }
 
@@ -158,6 +165,13 @@ void Rigidbody2D::DebugRender( RenderContext* renderContext, const Rgba& color )
 		AddVertsForLine2D(verts, collider->GetWorldShape().m_center, collider->GetWorldShape().m_center + collider->GetCapsuleRadius() * Vec2(0.f, 1.f).GetRotatedDegrees(m_rotation), 0.2f, Rgba::WHITE);
 		break;
 	}
+	case COLLIDER_POLYGON:
+	{
+		PolygonCollider2D* collider = reinterpret_cast<PolygonCollider2D*>(m_collider);
+
+		AddVertsForConvexPoly2D(verts, collider->GetWorldShape(), color, 0.5f);
+		break;
+	}
 	case NUM_COLLIDER_TYPES:
 		break;
 	default:
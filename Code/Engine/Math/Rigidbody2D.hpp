@@ -47,6 +47,7 @@ public:
 	void									SetObject(void* object, Transform2* objectTransform);
 	void									SetConstraints(const Vec3& constraints);
 	void									SetConstraints(bool x, bool y, bool rotation);
+	inline void								SetContinuousCollision(bool useCCD) { m_useCCD = useCCD; }
 	void									Destroy();
 
 	//Accessors
@@ -62,6 +63,8 @@ public:
 	Transform2*								m_object_transform = nullptr;	// what does this rigidbody affect
 
 	Transform2								m_transform;					// rigidbody transform (mimics the object at start of frame, and used to tell the change to object at end of frame)
+	Transform2								m_previousTransform;			// transform before the last fixed step (position and m_rotation), to interpolate from
+	Transform2								m_interpolatedTransform;		// what we last wrote to the object, so we can tell if the game moved it
 	Vec2									m_gravity_scale = Vec2::ONE;	// how much are we affected by gravity
 	Vec2									m_velocity = Vec2::ZERO; 
 	float 									m_angularVelocity = 0.f;
@@ -84,6 +87,7 @@ public:
 
 	Vec3									m_constraints = Vec3(0.f, 1.f, 0.f);		//x,z = movement constraint on x,z axis, z = rotation constraint
 	bool									m_isAlive = true;
+	bool									m_useCCD = false;				// sweep against static colliders when moving (for fast bodies that would tunnel)
 
 private:
 	eSimulationType							m_simulationType = TYPE_UNKOWN;
@@ -0,0 +1,493 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Math/TransformHierarchy.hpp"
+//Engine Systems
+#include "Engine/Commons/EngineCommon.hpp"
+#include "Engine/Core/JobSystem/Job.hpp"
+#include "Engine/Core/JobSystem/JobSystem.hpp"
+#include <atomic>
+#include <string.h>
+#include <thread>
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr int			TRANSFORM_MIN_PER_JOB = 1024;			// smaller runs of a level are not worth a job
+
+//------------------------------------------------------------------------------------------------------------------------------
+class TransformLevelJob : public Job
+{
+public:
+	TransformLevelJob(TransformHierarchy* hierarchy, int startIndex, int endIndex, std::atomic<int>* numUpdated, std::atomic<int>* jobsRemaining)
+		: m_hierarchy(hierarchy), m_startIndex(startIndex), m_endIndex(endIndex), m_numUpdated(numUpdated), m_jobsRemaining(jobsRemaining)
+	{
+	}
+
+	void Execute()
+	{
+		m_numUpdated->fetch_add(m_hierarchy->UpdateRange(m_startIndex, m_endIndex));
+
+		//Last thing we touch, the hierarchy and counters belong to the waiting caller
+		m_jobsRemaining->fetch_sub(1);
+	}
+
+private:
+	TransformHierarchy*		m_hierarchy = nullptr;
+	int						m_startIndex = 0;
+	int						m_endIndex = 0;
+	std::atomic<int>*		m_numUpdated = nullptr;
+	std::atomic<int>*		m_jobsRemaining = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+TransformHierarchy::TransformHierarchy()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+TransformHierarchy::~TransformHierarchy()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+TransformHandle TransformHierarchy::CreateTransform( TransformHandle parent, const Vec3& position, const Quaternion& rotation, const Vec3& scale )
+{
+	int parentIndex = -1;
+	if (parent != INVALID_TRANSFORM_HANDLE)
+	{
+		parentIndex = GetIndex(parent);
+	}
+
+	TransformHandle handle;
+	if (!m_freeHandles.empty())
+	{
+		handle = m_freeHandles.back();
+		m_freeHandles.pop_back();
+	}
+	else
+	{
+		handle = static_cast<TransformHandle>(m_handleToIndex.size());
+		m_handleToIndex.push_back(-1);
+	}
+
+	//Appending keeps parents before children, the level order is fixed up on the next update
+	int index = static_cast<int>(m_handles.size());
+	m_handleToIndex[handle] = index;
+
+	m_localPositions.push_back(position);
+	m_localRotations.push_back(rotation);
+	m_localScales.push_back(scale);
+	m_worldMatrices.push_back(Matrix44::IDENTITY);
+	m_parentIndices.push_back(parentIndex);
+	m_dirtyFlags.push_back(0);
+	m_handles.push_back(handle);
+
+	m_numTransforms++;
+	m_needsRebuild = true;
+	MarkDirty(index);
+
+	return handle;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::DestroyTransform( TransformHandle handle )
+{
+	//Children are found with one forward pass, which needs parents before children
+	if (m_needsRebuild)
+	{
+		RebuildOrder();
+	}
+
+	int index = GetIndex(handle);
+	m_parentIndices[index] = TRANSFORM_DESTROYED;
+
+	int numTransforms = static_cast<int>(m_handles.size());
+	for (int transformIndex = index; transformIndex < numTransforms; transformIndex++)
+	{
+		int parentIndex = m_parentIndices[transformIndex];
+		if (transformIndex != index && (parentIndex < 0 || m_parentIndices[parentIndex] != TRANSFORM_DESTROYED))
+		{
+			continue;
+		}
+
+		m_parentIndices[transformIndex] = TRANSFORM_DESTROYED;
+		m_handleToIndex[m_handles[transformIndex]] = -1;
+		m_freeHandles.push_back(m_handles[transformIndex]);
+		m_handles[transformIndex] = INVALID_TRANSFORM_HANDLE;
+		m_numTransforms--;
+	}
+
+	m_needsRebuild = true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::SetParent( TransformHandle handle, TransformHandle parent )
+{
+	int index = GetIndex(handle);
+	int parentIndex = -1;
+
+	if (parent != INVALID_TRANSFORM_HANDLE)
+	{
+		parentIndex = GetIndex(parent);
+
+		for (int ancestorIndex = parentIndex; ancestorIndex >= 0; ancestorIndex = m_parentIndices[ancestorIndex])
+		{
+			GUARANTEE_OR_DIE(ancestorIndex != index, "TransformHierarchy::SetParent would make a transform its own ancestor");
+		}
+	}
+
+	if (m_parentIndices[index] == parentIndex)
+	{
+		return;
+	}
+
+	m_parentIndices[index] = parentIndex;
+	m_needsRebuild = true;
+	MarkDirty(index);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+TransformHandle TransformHierarchy::GetParent( TransformHandle handle ) const
+{
+	int parentIndex = m_parentIndices[GetIndex(handle)];
+	return (parentIndex < 0) ? INVALID_TRANSFORM_HANDLE : m_handles[parentIndex];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool TransformHierarchy::IsValid( TransformHandle handle ) const
+{
+	return handle >= 0 && handle < static_cast<int>(m_handleToIndex.size()) && m_handleToIndex[handle] >= 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::Clear()
+{
+	m_localPositions.clear();
+	m_localRotations.clear();
+	m_localScales.clear();
+	m_worldMatrices.clear();
+	m_parentIndices.clear();
+	m_dirtyFlags.clear();
+	m_handles.clear();
+	m_levelStarts.clear();
+	m_handleToIndex.clear();
+	m_freeHandles.clear();
+
+	m_numTransforms = 0;
+	m_firstDirtyIndex = TRANSFORM_NONE_DIRTY;
+	m_needsRebuild = false;
+	m_numUpdatedLastUpdate = 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::SetLocalTransform( TransformHandle handle, const Vec3& position, const Quaternion& rotation, const Vec3& scale )
+{
+	int index = GetIndex(handle);
+	m_localPositions[index] = position;
+	m_localRotations[index] = rotation;
+	m_localScales[index] = scale;
+	MarkDirty(index);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::SetLocalPosition( TransformHandle handle, const Vec3& position )
+{
+	int index = GetIndex(handle);
+	m_localPositions[index] = position;
+	MarkDirty(index);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::SetLocalRotation( TransformHandle handle, const Quaternion& rotation )
+{
+	int index = GetIndex(handle);
+	m_localRotations[index] = rotation;
+	MarkDirty(index);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::SetLocalScale( TransformHandle handle, const Vec3& scale )
+{
+	int index = GetIndex(handle);
+	m_localScales[index] = scale;
+	MarkDirty(index);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const Vec3& TransformHierarchy::GetLocalPosition( TransformHandle handle ) const
+{
+	return m_localPositions[GetIndex(handle)];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const Quaternion& TransformHierarchy::GetLocalRotation( TransformHandle handle ) const
+{
+	return m_localRotations[GetIndex(handle)];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const Vec3& TransformHierarchy::GetLocalScale( TransformHandle handle ) const
+{
+	return m_localScales[GetIndex(handle)];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::UpdateWorldMatrices( int numJobs )
+{
+	if (m_needsRebuild)
+	{
+		RebuildOrder();
+	}
+
+	m_numUpdatedLastUpdate = 0;
+
+	int numTransforms = static_cast<int>(m_handles.size());
+	if (m_firstDirtyIndex >= numTransforms)
+	{
+		m_firstDirtyIndex = TRANSFORM_NONE_DIRTY;
+		return;
+	}
+
+	JobSystem* jobSystem = (numJobs > 1) ? JobSystem::GetInstance() : nullptr;
+
+	//Levels go in order, everything inside a level is independent
+	int numLevels = GetNumLevels();
+	for (int levelIndex = 0; levelIndex < numLevels; levelIndex++)
+	{
+		int startIndex = (m_levelStarts[levelIndex] > m_firstDirtyIndex) ? m_levelStarts[levelIndex] : m_firstDirtyIndex;
+		int endIndex = m_levelStarts[levelIndex + 1];
+		int numInLevel = endIndex - startIndex;
+		if (numInLevel <= 0)
+		{
+			continue;
+		}
+
+		int numLevelJobs = numInLevel / TRANSFORM_MIN_PER_JOB;
+		if (numLevelJobs > numJobs)
+		{
+			numLevelJobs = numJobs;
+		}
+
+		if (jobSystem == nullptr || numLevelJobs <= 1)
+		{
+			m_numUpdatedLastUpdate += UpdateRange(startIndex, endIndex);
+			continue;
+		}
+
+		std::atomic<int> numUpdated(0);
+		std::atomic<int> jobsRemaining(numLevelJobs - 1);
+
+		for (int jobIndex = 1; jobIndex < numLevelJobs; jobIndex++)
+		{
+			int jobStart = startIndex + (numInLevel * jobIndex) / numLevelJobs;
+			int jobEnd = startIndex + (numInLevel * (jobIndex + 1)) / numLevelJobs;
+
+			jobSystem->Run(new TransformLevelJob(this, jobStart, jobEnd, &numUpdated, &jobsRemaining));
+		}
+
+		numUpdated.fetch_add(UpdateRange(startIndex, startIndex + numInLevel / numLevelJobs));
+
+		//Help with whatever is still queued rather than sleeping on it
+		while (jobsRemaining.load() > 0)
+		{
+			if (!jobSystem->ProcessCategory(JOB_GENERIC))
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		m_numUpdatedLastUpdate += numUpdated.load();
+	}
+
+	memset(&m_dirtyFlags[m_firstDirtyIndex], 0, numTransforms - m_firstDirtyIndex);
+	m_firstDirtyIndex = TRANSFORM_NONE_DIRTY;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const Matrix44& TransformHierarchy::GetWorldMatrix( TransformHandle handle ) const
+{
+	return m_worldMatrices[GetIndex(handle)];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int TransformHierarchy::GetIndex( TransformHandle handle ) const
+{
+	GUARANTEE_OR_DIE(IsValid(handle), "Invalid or destroyed TransformHandle");
+	return m_handleToIndex[handle];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::MarkDirty( int index )
+{
+	m_dirtyFlags[index] = 1;
+	if (index < m_firstDirtyIndex)
+	{
+		m_firstDirtyIndex = index;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Counting sort by depth, stable so siblings keep their relative order. Destroyed transforms are dropped here.
+//------------------------------------------------------------------------------------------------------------------------------
+void TransformHierarchy::RebuildOrder()
+{
+	int numTransforms = static_cast<int>(m_handles.size());
+
+	//Depths, walking up to the first ancestor with a known depth (reparenting can put a parent after its child)
+	std::vector<int> depths;
+	depths.resize(numTransforms, -1);
+	std::vector<int> walkStack;
+	int maxDepth = -1;
+
+	for (int transformIndex = 0; transformIndex < numTransforms; transformIndex++)
+	{
+		if (m_parentIndices[transformIndex] == TRANSFORM_DESTROYED || depths[transformIndex] >= 0)
+		{
+			continue;
+		}
+
+		int walkIndex = transformIndex;
+		while (walkIndex >= 0 && depths[walkIndex] < 0)
+		{
+			walkStack.push_back(walkIndex);
+			walkIndex = m_parentIndices[walkIndex];
+		}
+
+		int depth = (walkIndex >= 0) ? depths[walkIndex] : -1;
+		while (!walkStack.empty())
+		{
+			depth++;
+			depths[walkStack.back()] = depth;
+			walkStack.pop_back();
+		}
+	}
+
+	std::vector<int> levelCounts;
+	for (int transformIndex = 0; transformIndex < numTransforms; transformIndex++)
+	{
+		if (depths[transformIndex] > maxDepth)
+		{
+			maxDepth = depths[transformIndex];
+		}
+	}
+
+	levelCounts.resize(maxDepth + 2, 0);
+	for (int transformIndex = 0; transformIndex < numTransforms; transformIndex++)
+	{
+		if (depths[transformIndex] >= 0)
+		{
+			levelCounts[depths[transformIndex] + 1]++;
+		}
+	}
+
+	for (int levelIndex = 1; levelIndex < static_cast<int>(levelCounts.size()); levelIndex++)
+	{
+		levelCounts[levelIndex] += levelCounts[levelIndex - 1];
+	}
+
+	m_levelStarts = levelCounts;
+
+	//levelCounts becomes the write cursor of each level
+	std::vector<int> newIndices;
+	newIndices.resize(numTransforms, -1);
+	for (int transformIndex = 0; transformIndex < numTransforms; transformIndex++)
+	{
+		if (depths[transformIndex] >= 0)
+		{
+			newIndices[transformIndex] = levelCounts[depths[transformIndex]]++;
+		}
+	}
+
+	int numAlive = m_levelStarts.back();
+	std::vector<Vec3> localPositions(numAlive);
+	std::vector<Quaternion> localRotations(numAlive);
+	std::vector<Vec3> localScales(numAlive);
+	std::vector<Matrix44> worldMatrices(numAlive);
+	std::vector<int> parentIndices(numAlive);
+	std::vector<unsigned char> dirtyFlags(numAlive);
+	std::vector<TransformHandle> handles(numAlive);
+
+	for (int transformIndex = 0; transformIndex < numTransforms; transformIndex++)
+	{
+		int newIndex = newIndices[transformIndex];
+		if (newIndex < 0)
+		{
+			continue;
+		}
+
+		int parentIndex = m_parentIndices[transformIndex];
+
+		localPositions[newIndex] = m_localPositions[transformIndex];
+		localRotations[newIndex] = m_localRotations[transformIndex];
+		localScales[newIndex] = m_localScales[transformIndex];
+		worldMatrices[newIndex] = m_worldMatrices[transformIndex];
+		parentIndices[newIndex] = (parentIndex >= 0) ? newIndices[parentIndex] : -1;
+		dirtyFlags[newIndex] = m_dirtyFlags[transformIndex];
+		handles[newIndex] = m_handles[transformIndex];
+
+		m_handleToIndex[m_handles[transformIndex]] = newIndex;
+	}
+
+	m_localPositions.swap(localPositions);
+	m_localRotations.swap(localRotations);
+	m_localScales.swap(localScales);
+	m_worldMatrices.swap(worldMatrices);
+	m_parentIndices.swap(parentIndices);
+	m_dirtyFlags.swap(dirtyFlags);
+	m_handles.swap(handles);
+
+	m_firstDirtyIndex = TRANSFORM_NONE_DIRTY;
+	for (int transformIndex = 0; transformIndex < numAlive; transformIndex++)
+	{
+		if (m_dirtyFlags[transformIndex] != 0)
+		{
+			m_firstDirtyIndex = transformIndex;
+			break;
+		}
+	}
+
+	m_needsRebuild = false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// A transform is recomputed if it was set or its parent was recomputed earlier in this update
+//------------------------------------------------------------------------------------------------------------------------------
+int TransformHierarchy::UpdateRange( int startIndex, int endIndex )
+{
+	int numUpdated = 0;
+
+	for (int transformIndex = startIndex; transformIndex < endIndex; transformIndex++)
+	{
+		int parentIndex = m_parentIndices[transformIndex];
+
+		if (m_dirtyFlags[transformIndex] == 0)
+		{
+			if (parentIndex < 0 || m_dirtyFlags[parentIndex] == 0)
+			{
+				continue;
+			}
+
+			m_dirtyFlags[transformIndex] = 1;
+		}
+
+		//Local = translation * rotation * scale, the scale just stretches the rotated bases
+		const Vec3& scale = m_localScales[transformIndex];
+		Matrix44 localMatrix = m_localRotations[transformIndex].GetMatrix(m_localPositions[transformIndex]);
+		for (int component = 0; component < 3; component++)
+		{
+			localMatrix.m_values[Matrix44::Ix + component] *= scale.x;
+			localMatrix.m_values[Matrix44::Jx + component] *= scale.y;
+			localMatrix.m_values[Matrix44::Kx + component] *= scale.z;
+		}
+
+		if (parentIndex < 0)
+		{
+			m_worldMatrices[transformIndex] = localMatrix;
+		}
+		else
+		{
+			m_worldMatrices[transformIndex] = m_worldMatrices[parentIndex].AppendMatrix(localMatrix);
+		}
+
+		numUpdated++;
+	}
+
+	return numUpdated;
+}
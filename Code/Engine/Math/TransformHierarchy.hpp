@@ -0,0 +1,89 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+//Engine Systems
+#include "Engine/Math/Matrix44.hpp"
+#include "Engine/Math/Quaternion.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------------------
+typedef int TransformHandle;
+constexpr TransformHandle	INVALID_TRANSFORM_HANDLE = -1;
+constexpr int				TRANSFORM_NONE_DIRTY = 0x7fffffff;
+constexpr int				TRANSFORM_DESTROYED = -2;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Scene graph of local transforms (position, rotation, scale) and the world matrices they produce
+//
+// Transforms live in flat arrays sorted by depth, so a parent always comes before its children and every depth is one
+// contiguous level. Setting a local transform only flags it dirty; UpdateWorldMatrices then walks the levels once,
+// pulling the flag down from the parent, and recomputes world = parentWorld * local only for the flagged transforms.
+// Everything before the first dirty transform is skipped outright, so a frame where nothing moved costs nothing.
+//
+// Transforms in one level only read the level above, so with numJobs > 1 large levels are split across the JobSystem
+// generic threads. Creating, destroying and reparenting re-sort the arrays on the next update, which is linear but
+// much more expensive than moving things, so keep structural changes out of per frame code where possible.
+//
+// Handles stay valid until the transform is destroyed, the array index behind them does not.
+//------------------------------------------------------------------------------------------------------------------------------
+class TransformHierarchy
+{
+	friend class TransformLevelJob;
+
+public:
+	TransformHierarchy();
+	~TransformHierarchy();
+
+	//Structure
+	TransformHandle				CreateTransform(TransformHandle parent = INVALID_TRANSFORM_HANDLE, const Vec3& position = Vec3::ZERO
+												, const Quaternion& rotation = Quaternion::IDENTITY, const Vec3& scale = Vec3::ONE);
+	void						DestroyTransform(TransformHandle handle);							// and all of its children
+	void						SetParent(TransformHandle handle, TransformHandle parent);			// keeps the local transform
+	TransformHandle				GetParent(TransformHandle handle) const;
+	bool						IsValid(TransformHandle handle) const;
+	void						Clear();
+
+	//Local transforms, applied as scale then rotation then translation
+	void						SetLocalTransform(TransformHandle handle, const Vec3& position, const Quaternion& rotation, const Vec3& scale = Vec3::ONE);
+	void						SetLocalPosition(TransformHandle handle, const Vec3& position);
+	void						SetLocalRotation(TransformHandle handle, const Quaternion& rotation);
+	void						SetLocalScale(TransformHandle handle, const Vec3& scale);
+
+	const Vec3&					GetLocalPosition(TransformHandle handle) const;
+	const Quaternion&			GetLocalRotation(TransformHandle handle) const;
+	const Vec3&					GetLocalScale(TransformHandle handle) const;
+
+	//World matrices, as of the last UpdateWorldMatrices
+	void						UpdateWorldMatrices(int numJobs = 1);
+	const Matrix44&				GetWorldMatrix(TransformHandle handle) const;
+
+	//Stats
+	inline int					GetNumTransforms() const				{ return m_numTransforms; }
+	inline int					GetNumLevels() const					{ return static_cast<int>(m_levelStarts.size()) - 1; }
+	inline int					GetNumUpdatedLastUpdate() const			{ return m_numUpdatedLastUpdate; }
+
+private:
+	int							GetIndex(TransformHandle handle) const;
+	void						MarkDirty(int index);
+	void						RebuildOrder();
+	int							UpdateRange(int startIndex, int endIndex);	// [startIndex, endIndex) must be in one level
+
+private:
+	//Sorted by depth, indexed by array index
+	std::vector<Vec3>			m_localPositions;
+	std::vector<Quaternion>		m_localRotations;
+	std::vector<Vec3>			m_localScales;
+	std::vector<Matrix44>		m_worldMatrices;
+	std::vector<int>			m_parentIndices;					// -1 for roots, TRANSFORM_DESTROYED until the next rebuild
+	std::vector<unsigned char>	m_dirtyFlags;
+	std::vector<TransformHandle>	m_handles;
+
+	std::vector<int>			m_levelStarts;						// level N is [m_levelStarts[N], m_levelStarts[N + 1])
+	std::vector<int>			m_handleToIndex;					// -1 for free handles
+	std::vector<TransformHandle>	m_freeHandles;
+
+	int							m_numTransforms = 0;
+	int							m_firstDirtyIndex = TRANSFORM_NONE_DIRTY;
+	bool						m_needsRebuild = false;
+	int							m_numUpdatedLastUpdate = 0;
+};
@@ -162,6 +162,13 @@ void Trigger2D::DebugRender(RenderContext* renderContext, const Rgba& color) con
 		AddVertsForLine2D(verts, collider->GetWorldShape().m_center, collider->GetWorldShape().m_center + collider->GetCapsuleRadius() * Vec2(0.f, 1.f).GetRotatedDegrees(m_transform.m_rotation), 0.2f, Rgba::WHITE);
 	}
 	break;
+	case COLLIDER_POLYGON:
+	{
+		PolygonCollider2D* collider = reinterpret_cast<PolygonCollider2D*>(m_collider);
+
+		AddVertsForConvexPoly2D(verts, collider->GetWorldShape(), color, 0.5f);
+	}
+	break;
 	case NUM_COLLIDER_TYPES:
 		break;
 	default:
@@ -14,6 +14,8 @@ struct Rgba;
 //------------------------------------------------------------------------------------------------------------------------------
 class Trigger2D
 {
+	friend class PhysicsSnapshot2D;
+
 public:
 	Trigger2D(PhysicsSystem* physicsSystem, eSimulationType simType);
 	~Trigger2D();
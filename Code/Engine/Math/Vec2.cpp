@@ -6,65 +6,12 @@
 #include <vector>
 #include <string>
 
-//------------------------------------------------------------------------------------------------------------------------------
-const STATIC Vec2 Vec2::ZERO(0.f,0.f);
-const STATIC Vec2 Vec2::ONE(1.f, 1.f);
-const STATIC Vec2 Vec2::NEGATIVE_ONE(-1.f, -1.f);
-
-const STATIC Vec2 Vec2::ALIGN_CENTERED(0.5f, 0.5f);
-const STATIC Vec2 Vec2::ALIGN_LEFT_BOTTOM(0.0f, 0.0f);
-const STATIC Vec2 Vec2::ALIGN_LEFT_CENTERED(0.0f, 0.5f);
-const STATIC Vec2 Vec2::ALIGN_LEFT_TOP(0.0f, 1.0f);
-const STATIC Vec2 Vec2::ALIGN_RIGHT_BOTTOM(1.0f, 0.0f);
-const STATIC Vec2 Vec2::ALIGN_RIGHT_CENTERED(1.f, 0.5f);
-const STATIC Vec2 Vec2::ALIGN_RIGHT_TOP(1.f, 1.f);
-const STATIC Vec2 Vec2::ALIGN_TOP_CENTERED(0.5f, 1.f);
-const STATIC Vec2 Vec2::ALIGN_BOTTOM_CENTERED(0.5f, 0.f);
-
-const STATIC Vec2 Vec2::RIGHT(1.f, 0.f);
-const STATIC Vec2 Vec2::UP(0.f, 1.f);
-const STATIC Vec2 Vec2::LEFT(-1.f, 0.f);
-const STATIC Vec2 Vec2::DOWN(0.f, -1.f);
-
-//------------------------------------------------------------------------------------------------------------------------------
-Vec2::Vec2( const Vec2& copy )
-   	: x( copy.x )
-	, y( copy.y )
-{
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-Vec2::Vec2( float initialX, float initialY )
-	: x( initialX )
-	, y( initialY )
-{
-}
-
 //------------------------------------------------------------------------------------------------------------------------------
 Vec2::Vec2( const char* asText )
 {
 	SetFromText(asText);
 }
 
-//------------------------------------------------------------------------------------------------------------------------------
-Vec2::Vec2(const IntVec2& copyFrom)
-{
-	x = (float)copyFrom.x;
-	y = (float)copyFrom.y;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-float Vec2::GetLength() const
-{
-	return sqrtf( x*x + y*y );
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-float Vec2::GetLengthSquared() const
-{
-	return (x*x + y*y);
-}
-
 //------------------------------------------------------------------------------------------------------------------------------
 float Vec2::GetAngleDegrees() const
 {
@@ -77,18 +24,6 @@ float Vec2::GetAngleRadians() const
 	return atan2f(y, x);
 }
 
-//------------------------------------------------------------------------------------------------------------------------------
-const Vec2 Vec2::GetRotated90Degrees() const
-{
-	return Vec2(-y, x);
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-const Vec2 Vec2::GetRotatedMinus90Degrees() const
-{
-	return Vec2(y, -x);
-}
-
 //------------------------------------------------------------------------------------------------------------------------------
 const Vec2 Vec2::GetRotatedDegrees( float degreesToRotate ) const
 {
@@ -142,7 +77,6 @@ const Vec2 Vec2::GetNormalized() const
 	return Vec2(xNorm, yNorm);
 }
 
-
 //------------------------------------------------------------------------------------------------------------------------------
 const Vec2 Vec2::MakeFromPolarDegrees( const float polarDegrees, float r) 
 {
@@ -317,123 +251,3 @@ const float Vec2::GetY()
 	return y;
 }
 
-//------------------------------------------------------------------------------------------------------------------------------
-const Vec2 Vec2::operator + ( const Vec2& vecToAdd ) const
-{
-	return Vec2( x + vecToAdd.x, y + vecToAdd.y );
-}
-
-
-//------------------------------------------------------------------------------------------------------------------------------
-const Vec2 Vec2::operator-( const Vec2& vecToSubtract ) const
-{
-	return Vec2( x - vecToSubtract.x, y - vecToSubtract.y ); 
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-bool Vec2::operator<( const Vec2& compare ) const
-{
-	return (x < compare.x && y < compare.y);
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-bool Vec2::operator>( const Vec2& compare ) const
-{
-	return (x > compare.x && y > compare.y);
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-Vec2 Vec2::Min( const Vec2& compare )
-{
-	return Vec2(GetLowerValue(x, compare.x), GetLowerValue(y, compare.y));
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-Vec2 Vec2::Max( const Vec2& compare )
-{
-	return Vec2(GetHigherValue(x, compare.x), GetHigherValue(y, compare.y));
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-const Vec2 Vec2::operator*( float uniformScale ) const
-{
-	return Vec2( x * uniformScale, y * uniformScale ); 
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-const Vec2 Vec2::operator*( const Vec2& vecToMultiply ) const
-{
-	return Vec2(x * vecToMultiply.x, y * vecToMultiply.y);
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-const Vec2 Vec2::operator/( float inverseScale ) const
-{
-	return Vec2( x / inverseScale, y / inverseScale ); 
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-void Vec2::operator+=(float floatToAdd)
-{
-	x += floatToAdd;
-	y += floatToAdd;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-void Vec2::operator+=( const Vec2& vecToAdd )
-{
-	x += vecToAdd.x;
-	y += vecToAdd.y; 
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-void Vec2::operator-=( const Vec2& vecToSubtract )
-{
-	x -= vecToSubtract.x;
-	y -= vecToSubtract.y;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-void Vec2::operator*=( const float uniformScale )
-{
-	x *= uniformScale;
-	y *= uniformScale;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-void Vec2::operator/=( const float uniformDivisor )
-{
-	x /= uniformDivisor;
-	y /= uniformDivisor;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-void Vec2::operator=( const Vec2& copyFrom )
-{
-	x = copyFrom.x;
-	y = copyFrom.y;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-const Vec2 operator*( float uniformScale, const Vec2& vecToScale )
-{
-	return Vec2( vecToScale.x * uniformScale, vecToScale.y * uniformScale); 
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-bool Vec2::operator==( const Vec2& compare ) const
-{
-	if(x == compare.x && y == compare.y)
-		return true;
-	else
-		return false;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-bool Vec2::operator!=( const Vec2& compare ) const
-{
-	if(x == compare.x && y == compare.y)
-		return false;
-	else
-		return true;
-}
@@ -1,17 +1,18 @@
 #pragma once
+#include "Engine/Math/IntVec2.hpp"
+#include <math.h>
 #include <string>
-
-struct IntVec2;
+#include <type_traits>
 
 //-----------------------------------------------------------------------------------------------
 struct Vec2
 {
 public:
 	// Construction/Destruction
-	Vec2() {}												// default constructor: do nothing (for speed)
-	Vec2( const Vec2& copyFrom );							// copy constructor (from another Vec2)
-	Vec2( const IntVec2& copyFrom );						// copy constructor (from an IntVec2)
-	explicit Vec2( float initialX, float initialY );		// explicit constructor (from x, y)
+	Vec2() = default;										// default constructor: do nothing (for speed)
+	Vec2( const Vec2& copyFrom ) = default;					// copy constructor (from another Vec2)
+	constexpr Vec2( const IntVec2& copyFrom );				// copy constructor (from an IntVec2)
+	explicit constexpr Vec2( float initialX, float initialY );		// explicit constructor (from x, y)
 	explicit Vec2( const char* asText);
 
 	//Static Vectors
@@ -40,12 +41,12 @@ public:
 
 
 	//Accessor methods
-	float				GetLength() const;
-	float				GetLengthSquared() const;
+	inline float		GetLength() const;
+	constexpr float		GetLengthSquared() const;
 	float				GetAngleDegrees() const;
 	float				GetAngleRadians() const;
-	const Vec2			GetRotated90Degrees() const;
-	const Vec2			GetRotatedMinus90Degrees() const;
+	constexpr const Vec2	GetRotated90Degrees() const;
+	constexpr const Vec2	GetRotatedMinus90Degrees() const;
 	const Vec2			GetRotatedDegrees(float degreesToRotate) const;
 	const Vec2			GetRotatedRadians(float radiansToRotate) const;
 	const Vec2			GetClamped(float maxLenth) const;
@@ -76,30 +77,200 @@ public:
 	const float			GetY();
 
 	// Operators
-	const Vec2			operator+( const Vec2& vecToAdd ) const;				// vec2 + vec2
-	const Vec2			operator-( const Vec2& vecToSubtract ) const;			// vec2 - vec2
-	const Vec2			operator*( float uniformScale ) const;					// vec2 * float
-	const Vec2			operator*( const Vec2& vecToMultiply) const;			// vec2 * vec2
-	const Vec2			operator/( float inverseScale ) const;					// vec2 / float
-	void				operator+=( const Vec2& vecToAdd );						// vec2 += vec2
-	void				operator+=( float floatToAdd );							// vec2 += float
-	void				operator-=( const Vec2& vecToSubtract );				// vec2 -= vec2
-	void				operator*=( const float uniformScale );					// vec2 *= float
-	void				operator/=( const float uniformDivisor );				// vec2 /= float
-	void				operator=( const Vec2& copyFrom );						// vec2 = vec2
-	bool				operator==( const Vec2& compare ) const;				// vec2 == vec2
-	bool				operator!=( const Vec2& compare ) const;				// vec2 != vec2
-	bool				operator<( const Vec2& compare ) const;					// vec2 < vec2
-	bool				operator>( const Vec2& compare ) const;					// vec2 > vec2
-
-	Vec2				Min(const Vec2& compare);
-	Vec2				Max(const Vec2& compare);
-
-	friend const Vec2 operator*( float uniformScale, const Vec2& vecToScale );	// float * vec2
+	constexpr const Vec2	operator+( const Vec2& vecToAdd ) const;				// vec2 + vec2
+	constexpr const Vec2	operator-( const Vec2& vecToSubtract ) const;			// vec2 - vec2
+	constexpr const Vec2	operator*( float uniformScale ) const;					// vec2 * float
+	constexpr const Vec2	operator*( const Vec2& vecToMultiply) const;			// vec2 * vec2
+	constexpr const Vec2	operator/( float inverseScale ) const;					// vec2 / float
+	constexpr void		operator+=( const Vec2& vecToAdd );						// vec2 += vec2
+	constexpr void		operator+=( float floatToAdd );							// vec2 += float
+	constexpr void		operator-=( const Vec2& vecToSubtract );				// vec2 -= vec2
+	constexpr void		operator*=( const float uniformScale );					// vec2 *= float
+	constexpr void		operator/=( const float uniformDivisor );				// vec2 /= float
+	Vec2&				operator=( const Vec2& copyFrom ) = default;			// vec2 = vec2
+	constexpr bool		operator==( const Vec2& compare ) const;				// vec2 == vec2
+	constexpr bool		operator!=( const Vec2& compare ) const;				// vec2 != vec2
+	constexpr bool		operator<( const Vec2& compare ) const;					// vec2 < vec2
+	constexpr bool		operator>( const Vec2& compare ) const;					// vec2 > vec2
+
+	constexpr Vec2		Min(const Vec2& compare);
+	constexpr Vec2		Max(const Vec2& compare);
+
+	friend constexpr const Vec2 operator*( float uniformScale, const Vec2& vecToScale );	// float * vec2
 
 public:
 	float x;
 	float y;
 };
 
+//------------------------------------------------------------------------------------------------------------------------------
+// Core arithmetic lives here so it inlines everywhere and works in constant expressions. The type must stay trivially
+// copyable and tightly packed as it is memcpy'd into vertex and constant buffers.
+//------------------------------------------------------------------------------------------------------------------------------
+static_assert(std::is_trivially_copyable<Vec2>::value, "Vec2 must stay trivially copyable");
+static_assert(sizeof(Vec2) == 2 * sizeof(float), "Vec2 must stay 2 packed floats");
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr Vec2::Vec2( float initialX, float initialY )
+	: x( initialX )
+	, y( initialY )
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr Vec2::Vec2( const IntVec2& copyFrom )
+	: x( static_cast<float>(copyFrom.x) )
+	, y( static_cast<float>(copyFrom.y) )
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+inline float Vec2::GetLength() const
+{
+	return sqrtf( x*x + y*y );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr float Vec2::GetLengthSquared() const
+{
+	return (x*x + y*y);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec2 Vec2::GetRotated90Degrees() const
+{
+	return Vec2(-y, x);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec2 Vec2::GetRotatedMinus90Degrees() const
+{
+	return Vec2(y, -x);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec2 Vec2::operator+( const Vec2& vecToAdd ) const
+{
+	return Vec2( x + vecToAdd.x, y + vecToAdd.y );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec2 Vec2::operator-( const Vec2& vecToSubtract ) const
+{
+	return Vec2( x - vecToSubtract.x, y - vecToSubtract.y );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec2 Vec2::operator*( float uniformScale ) const
+{
+	return Vec2( x * uniformScale, y * uniformScale );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec2 Vec2::operator*( const Vec2& vecToMultiply ) const
+{
+	return Vec2( x * vecToMultiply.x, y * vecToMultiply.y );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec2 Vec2::operator/( float inverseScale ) const
+{
+	return Vec2( x / inverseScale, y / inverseScale );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr void Vec2::operator+=( const Vec2& vecToAdd )
+{
+	x += vecToAdd.x;
+	y += vecToAdd.y;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr void Vec2::operator+=( float floatToAdd )
+{
+	x += floatToAdd;
+	y += floatToAdd;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr void Vec2::operator-=( const Vec2& vecToSubtract )
+{
+	x -= vecToSubtract.x;
+	y -= vecToSubtract.y;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr void Vec2::operator*=( const float uniformScale )
+{
+	x *= uniformScale;
+	y *= uniformScale;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr void Vec2::operator/=( const float uniformDivisor )
+{
+	x /= uniformDivisor;
+	y /= uniformDivisor;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr bool Vec2::operator==( const Vec2& compare ) const
+{
+	return (x == compare.x && y == compare.y);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr bool Vec2::operator!=( const Vec2& compare ) const
+{
+	return !(x == compare.x && y == compare.y);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr bool Vec2::operator<( const Vec2& compare ) const
+{
+	return (x < compare.x && y < compare.y);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr bool Vec2::operator>( const Vec2& compare ) const
+{
+	return (x > compare.x && y > compare.y);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr Vec2 Vec2::Min( const Vec2& compare )
+{
+	return Vec2((x < compare.x) ? x : compare.x, (y < compare.y) ? y : compare.y);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr Vec2 Vec2::Max( const Vec2& compare )
+{
+	return Vec2((x > compare.x) ? x : compare.x, (y > compare.y) ? y : compare.y);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec2 operator*( float uniformScale, const Vec2& vecToScale )
+{
+	return Vec2( vecToScale.x * uniformScale, vecToScale.y * uniformScale );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+inline constexpr Vec2 Vec2::ZERO(0.f, 0.f);
+inline constexpr Vec2 Vec2::ONE(1.f, 1.f);
+inline constexpr Vec2 Vec2::NEGATIVE_ONE(-1.f, -1.f);
+
+inline constexpr Vec2 Vec2::ALIGN_CENTERED(0.5f, 0.5f);
+inline constexpr Vec2 Vec2::ALIGN_LEFT_BOTTOM(0.0f, 0.0f);
+inline constexpr Vec2 Vec2::ALIGN_LEFT_CENTERED(0.0f, 0.5f);
+inline constexpr Vec2 Vec2::ALIGN_LEFT_TOP(0.0f, 1.0f);
+inline constexpr Vec2 Vec2::ALIGN_RIGHT_BOTTOM(1.0f, 0.0f);
+inline constexpr Vec2 Vec2::ALIGN_RIGHT_CENTERED(1.f, 0.5f);
+inline constexpr Vec2 Vec2::ALIGN_RIGHT_TOP(1.f, 1.f);
+inline constexpr Vec2 Vec2::ALIGN_TOP_CENTERED(0.5f, 1.f);
+inline constexpr Vec2 Vec2::ALIGN_BOTTOM_CENTERED(0.5f, 0.f);
 
+inline constexpr Vec2 Vec2::RIGHT(1.f, 0.f);
+inline constexpr Vec2 Vec2::UP(0.f, 1.f);
+inline constexpr Vec2 Vec2::LEFT(-1.f, 0.f);
+inline constexpr Vec2 Vec2::DOWN(0.f, -1.f);
@@ -6,83 +6,12 @@
 #include <vector>
 #include <string>
 
-//------------------------------------------------------------------------------------------------------------------------------
-const STATIC Vec3 Vec3::ZERO(0.f, 0.f, 0.f);
-const STATIC Vec3 Vec3::ONE(1.f, 1.f, 1.f);
-const STATIC Vec3 Vec3::FRONT(0.f, 0.f, 1.f);
-const STATIC Vec3 Vec3::FORWARD(0.f, 0.f, 1.f);
-const STATIC Vec3 Vec3::BACK(0.f, 0.f, -1.f);
-const STATIC Vec3 Vec3::LEFT(-1.f, 0.f, 0.f);
-const STATIC Vec3 Vec3::RIGHT(1.f, 0.f, 0.f);
-const STATIC Vec3 Vec3::UP(0.f, 1.f, 0.f);
-const STATIC Vec3 Vec3::DOWN(0.f, -1.f, 0.f);
-
-//------------------------------------------------------------------------------------------------------------------------------
-Vec3::Vec3( const Vec3& copy )
-	: x( copy.x )
-	, y( copy.y )
-	, z( copy.z )
-{
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-Vec3::Vec3( float initialX, float initialY, float initialZ )
-	: x( initialX )
-	, y( initialY )
-	, z( initialZ )
-{
-}
-
 //------------------------------------------------------------------------------------------------------------------------------
 Vec3::Vec3( const char* asText )
 {
 	SetFromText(asText);
 }
 
-//------------------------------------------------------------------------------------------------------------------------------
-Vec3::Vec3( const Vec2& copyFrom )
-	: x( copyFrom.x )
-	, y( copyFrom.y )
-	, z( 0.f )
-{
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-float Vec3::GetLength() const
-{
-	return sqrtf(x*x + y*y + z*z);
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-float Vec3::GetLengthXY() const
-{
-	return sqrtf(x*x + y*y);
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-float Vec3::GetLengthXZ() const
-{
-	return sqrtf(x*x + z*z);
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-float Vec3::GetLengthYZ() const
-{
-	return sqrtf(y*y + z*z);
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-float Vec3::GetLengthSquared() const
-{
-	return (x*x + y*y + z*z);
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-float Vec3::GetLengthSquaredXY() const
-{
-	return (x*x + y*y);
-}
-
 //------------------------------------------------------------------------------------------------------------------------------
 float Vec3::GetAngleAboutZDegrees() const
 {
@@ -216,52 +145,6 @@ std::string Vec3::GetAsString() const
 	return string;
 }
 
-//------------------------------------------------------------------------------------------------------------------------------
-STATIC const Vec3 Vec3::GetComponentMin(const Vec3& min, const Vec3& max)
-{
-	Vec3 newMin;
-
-	newMin.x = GetLowerValue(min.x, max.x);
-	newMin.y = GetLowerValue(min.y, max.y);
-	newMin.z = GetLowerValue(min.z, max.z);
-
-	return newMin;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-STATIC const Vec3 Vec3::GetComponentMinXY(const Vec3& min, const Vec3& max)
-{
-	Vec3 newMin;
-
-	newMin.x = GetLowerValue(min.x, max.x);
-	newMin.y = GetLowerValue(min.y, max.y);
-
-	return newMin;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-STATIC const Vec3 Vec3::GetComponentMax(const Vec3& min, const Vec3& max)
-{
-	Vec3 newMax;
-
-	newMax.x = GetHigherValue(min.x, max.x);
-	newMax.y = GetHigherValue(min.y, max.y);
-	newMax.z = GetHigherValue(min.z, max.z);
-
-	return newMax;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-STATIC const Vec3 Vec3::GetComponentMaxXY(const Vec3& min, const Vec3& max)
-{
-	Vec3 newMax;
-
-	newMax.x = GetHigherValue(min.x, max.x);
-	newMax.y = GetHigherValue(min.y, max.y);
-
-	return newMax;
-}
-
 //------------------------------------------------------------------------------------------------------------------------------
 void Vec3::SetFromText( const char* asText )
 {
@@ -294,30 +177,6 @@ void Vec3::ClampLengthXY( float maxLength )
 	}
 }
 
-//------------------------------------------------------------------------------------------------------------------------------
-const Vec3 Vec3::operator + ( const Vec3& vecToAdd ) const
-{
-	return Vec3( x + vecToAdd.x, y + vecToAdd.y, z + vecToAdd.z ); 
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-const Vec3 Vec3::operator-( const Vec3& vecToSubtract ) const
-{
-	return Vec3( x - vecToSubtract.x, y - vecToSubtract.y, z - vecToSubtract.z ); 
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-const Vec3 Vec3::operator*( float uniformScale ) const
-{
-	return Vec3( x * uniformScale, y * uniformScale, z * uniformScale ); 
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-const Vec3 Vec3::operator/( float inverseScale ) const
-{
-	return Vec3( x / inverseScale, y / inverseScale, z / inverseScale ); 
-}
-
 //------------------------------------------------------------------------------------------------------------------------------
 void Vec3::SetLengthXY( float setLength )
 {
@@ -356,66 +215,3 @@ STATIC const Vec3 Vec3::LerpVector(Vec3& toLerp, const Vec3& lerpDestination, fl
 	return result;
 }
 
-//------------------------------------------------------------------------------------------------------------------------------
-void Vec3::operator+=( const Vec3& vecToAdd )
-{
-	x += vecToAdd.x;
-	y += vecToAdd.y; 
-	z += vecToAdd.z;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-void Vec3::operator-=( const Vec3& vecToSubtract )
-{
-	x -= vecToSubtract.x;
-	y -= vecToSubtract.y;
-	z -= vecToSubtract.z;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-void Vec3::operator*=( const float uniformScale )
-{
-	x *= uniformScale;
-	y *= uniformScale;
-	z *= uniformScale;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-void Vec3::operator/=( const float uniformDivisor )
-{
-	x /= uniformDivisor;
-	y /= uniformDivisor;
-	z /= uniformDivisor;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-void Vec3::operator=( const Vec3& copyFrom )
-{
-	x = copyFrom.x;
-	y = copyFrom.y;
-	z = copyFrom.z;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-const Vec3 operator*( float uniformScale, const Vec3& vecToScale )
-{
-	return Vec3( vecToScale.x * uniformScale, vecToScale.y * uniformScale, vecToScale.z * uniformScale);
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-bool Vec3::operator==( const Vec3& compare ) const
-{
-	if(x == compare.x && y == compare.y && z == compare.z)
-		return true;
-	else
-		return false;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-bool Vec3::operator!=( const Vec3& compare ) const
-{
-	if(x == compare.x && y == compare.y && z == compare.z)
-		return false;
-	else
-		return true;
-}
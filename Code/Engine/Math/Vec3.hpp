@@ -1,18 +1,18 @@
 #pragma once
+#include "Engine/Math/Vec2.hpp"
+#include <math.h>
 #include <string>
-//------------------------------------------------------------------------------------------------------------------------------
-struct Vec2;
+#include <type_traits>
 
 //------------------------------------------------------------------------------------------------------------------------------
 struct Vec3
 {
 public:
 	// Construction/Destruction
-	~Vec3() {}																// destructor: do nothing (for speed)
-	Vec3() {}																// default constructor: do nothing (for speed)
-	Vec3( const Vec3& copyFrom );											// copy constructor (from another vec3)
-	Vec3( const Vec2& copyFrom );
-	explicit Vec3( float initialX, float initialY, float initialZ );		// explicit constructor (from x, y, z)
+	Vec3() = default;														// default constructor: do nothing (for speed)
+	Vec3( const Vec3& copyFrom ) = default;									// copy constructor (from another vec3)
+	constexpr Vec3( const Vec2& copyFrom );
+	explicit constexpr Vec3( float initialX, float initialY, float initialZ );	// explicit constructor (from x, y, z)
 	explicit Vec3(const char* asText);
 
 	//Static Vectors
@@ -26,18 +26,18 @@ public:
 	const static Vec3	UP;
 	const static Vec3	DOWN;
 
-	static const Vec3			GetComponentMin(const Vec3& min, const Vec3& max);
-	static const Vec3			GetComponentMinXY(const Vec3& min, const Vec3& max);
-	static const Vec3			GetComponentMax(const Vec3& min, const Vec3& max);
-	static const Vec3			GetComponentMaxXY(const Vec3& min, const Vec3& max);
+	static constexpr const Vec3	GetComponentMin(const Vec3& min, const Vec3& max);
+	static constexpr const Vec3	GetComponentMinXY(const Vec3& min, const Vec3& max);
+	static constexpr const Vec3	GetComponentMax(const Vec3& min, const Vec3& max);
+	static constexpr const Vec3	GetComponentMaxXY(const Vec3& min, const Vec3& max);
 
 	//Access Methods
-	float				GetLength() const;
-	float				GetLengthXY() const;
-	float				GetLengthXZ() const;
-	float				GetLengthYZ() const;
-	float				GetLengthSquared() const;
-	float				GetLengthSquaredXY() const;
+	inline float		GetLength() const;
+	inline float		GetLengthXY() const;
+	inline float		GetLengthXZ() const;
+	inline float		GetLengthYZ() const;
+	constexpr float		GetLengthSquared() const;
+	constexpr float		GetLengthSquaredXY() const;
 	float				GetAngleAboutZDegrees() const;
 	float				GetAngleAboutZRadians() const;
 	float				GetAngleAboutYDegrees() const;
@@ -64,19 +64,19 @@ public:
 	const static Vec3	LerpVector(Vec3& toLerp, const Vec3& lerpDestination, float lerpPercent);
 
 	// Operators
-	const Vec3			operator+( const Vec3& vecToAdd ) const;					// vec3 + vec3
-	const Vec3			operator-( const Vec3& vecToSubtract ) const;				// vec3 - vec3
-	const Vec3			operator*( float uniformScale ) const;						// vec3 * float
-	const Vec3			operator/( float inverseScale ) const;						// vec3 / float
-	void				operator+=( const Vec3& vecToAdd );							// vec3 += vec3
-	void				operator-=( const Vec3& vecToSubtract );					// vec3 -= vec3
-	void				operator*=( const float uniformScale );						// vec3 *= float
-	void				operator/=( const float uniformDivisor );					// vec3 /= float
-	void				operator=( const Vec3& copyFrom );							// vec3 = vec3
-	bool				operator==( const Vec3& compare ) const;					// vec3 == vec3
-	bool				operator!=( const Vec3& compare ) const;					// vec3 != vec3
-
-	friend const Vec3	operator*( float uniformScale, const Vec3& vecToScale );	// float * vec3
+	constexpr const Vec3	operator+( const Vec3& vecToAdd ) const;					// vec3 + vec3
+	constexpr const Vec3	operator-( const Vec3& vecToSubtract ) const;				// vec3 - vec3
+	constexpr const Vec3	operator*( float uniformScale ) const;						// vec3 * float
+	constexpr const Vec3	operator/( float inverseScale ) const;						// vec3 / float
+	constexpr void		operator+=( const Vec3& vecToAdd );							// vec3 += vec3
+	constexpr void		operator-=( const Vec3& vecToSubtract );					// vec3 -= vec3
+	constexpr void		operator*=( const float uniformScale );						// vec3 *= float
+	constexpr void		operator/=( const float uniformDivisor );					// vec3 /= float
+	Vec3&				operator=( const Vec3& copyFrom ) = default;				// vec3 = vec3
+	constexpr bool		operator==( const Vec3& compare ) const;					// vec3 == vec3
+	constexpr bool		operator!=( const Vec3& compare ) const;					// vec3 != vec3
+
+	friend constexpr const Vec3	operator*( float uniformScale, const Vec3& vecToScale );	// float * vec3
 
 public: 
 	float x;
@@ -84,4 +84,170 @@ public:
 	float z;
 };
 
+//------------------------------------------------------------------------------------------------------------------------------
+// Core arithmetic is inline and constexpr. Vec3 is memcpy'd into vertex buffers and cooked mesh files, so it has to stay
+// trivially copyable and 3 packed floats.
+//------------------------------------------------------------------------------------------------------------------------------
+static_assert(std::is_trivially_copyable<Vec3>::value, "Vec3 must stay trivially copyable");
+static_assert(sizeof(Vec3) == 3 * sizeof(float), "Vec3 must stay 3 packed floats");
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr Vec3::Vec3( float initialX, float initialY, float initialZ )
+	: x( initialX )
+	, y( initialY )
+	, z( initialZ )
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr Vec3::Vec3( const Vec2& copyFrom )
+	: x( copyFrom.x )
+	, y( copyFrom.y )
+	, z( 0.f )
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec3 Vec3::GetComponentMin( const Vec3& min, const Vec3& max )
+{
+	return Vec3((min.x < max.x) ? min.x : max.x, (min.y < max.y) ? min.y : max.y, (min.z < max.z) ? min.z : max.z);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec3 Vec3::GetComponentMinXY( const Vec3& min, const Vec3& max )
+{
+	return Vec3((min.x < max.x) ? min.x : max.x, (min.y < max.y) ? min.y : max.y, 0.f);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec3 Vec3::GetComponentMax( const Vec3& min, const Vec3& max )
+{
+	return Vec3((min.x > max.x) ? min.x : max.x, (min.y > max.y) ? min.y : max.y, (min.z > max.z) ? min.z : max.z);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec3 Vec3::GetComponentMaxXY( const Vec3& min, const Vec3& max )
+{
+	return Vec3((min.x > max.x) ? min.x : max.x, (min.y > max.y) ? min.y : max.y, 0.f);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+inline float Vec3::GetLength() const
+{
+	return sqrtf(x*x + y*y + z*z);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+inline float Vec3::GetLengthXY() const
+{
+	return sqrtf(x*x + y*y);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+inline float Vec3::GetLengthXZ() const
+{
+	return sqrtf(x*x + z*z);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+inline float Vec3::GetLengthYZ() const
+{
+	return sqrtf(y*y + z*z);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr float Vec3::GetLengthSquared() const
+{
+	return (x*x + y*y + z*z);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr float Vec3::GetLengthSquaredXY() const
+{
+	return (x*x + y*y);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec3 Vec3::operator+( const Vec3& vecToAdd ) const
+{
+	return Vec3( x + vecToAdd.x, y + vecToAdd.y, z + vecToAdd.z );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec3 Vec3::operator-( const Vec3& vecToSubtract ) const
+{
+	return Vec3( x - vecToSubtract.x, y - vecToSubtract.y, z - vecToSubtract.z );
+}
 
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec3 Vec3::operator*( float uniformScale ) const
+{
+	return Vec3( x * uniformScale, y * uniformScale, z * uniformScale );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec3 Vec3::operator/( float inverseScale ) const
+{
+	return Vec3( x / inverseScale, y / inverseScale, z / inverseScale );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr void Vec3::operator+=( const Vec3& vecToAdd )
+{
+	x += vecToAdd.x;
+	y += vecToAdd.y;
+	z += vecToAdd.z;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr void Vec3::operator-=( const Vec3& vecToSubtract )
+{
+	x -= vecToSubtract.x;
+	y -= vecToSubtract.y;
+	z -= vecToSubtract.z;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr void Vec3::operator*=( const float uniformScale )
+{
+	x *= uniformScale;
+	y *= uniformScale;
+	z *= uniformScale;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr void Vec3::operator/=( const float uniformDivisor )
+{
+	x /= uniformDivisor;
+	y /= uniformDivisor;
+	z /= uniformDivisor;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr bool Vec3::operator==( const Vec3& compare ) const
+{
+	return (x == compare.x && y == compare.y && z == compare.z);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr bool Vec3::operator!=( const Vec3& compare ) const
+{
+	return !(x == compare.x && y == compare.y && z == compare.z);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec3 operator*( float uniformScale, const Vec3& vecToScale )
+{
+	return Vec3( vecToScale.x * uniformScale, vecToScale.y * uniformScale, vecToScale.z * uniformScale );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+inline constexpr Vec3 Vec3::ZERO(0.f, 0.f, 0.f);
+inline constexpr Vec3 Vec3::ONE(1.f, 1.f, 1.f);
+inline constexpr Vec3 Vec3::FRONT(0.f, 0.f, 1.f);
+inline constexpr Vec3 Vec3::FORWARD(0.f, 0.f, 1.f);
+inline constexpr Vec3 Vec3::BACK(0.f, 0.f, -1.f);
+inline constexpr Vec3 Vec3::LEFT(-1.f, 0.f, 0.f);
+inline constexpr Vec3 Vec3::RIGHT(1.f, 0.f, 0.f);
+inline constexpr Vec3 Vec3::UP(0.f, 1.f, 0.f);
+inline constexpr Vec3 Vec3::DOWN(0.f, -1.f, 0.f);
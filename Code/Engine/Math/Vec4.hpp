@@ -1,19 +1,19 @@
 //------------------------------------------------------------------------------------------------------------------------------
 #pragma once
+#include "Engine/Math/Vec3.hpp"
+#include <type_traits>
 
 struct Matrix44;
-struct Vec3;
 
 //------------------------------------------------------------------------------------------------------------------------------
 struct Vec4
 {
 public:
-	Vec4() {}
-	~Vec4() {}
+	Vec4() = default;
 
-	Vec4( const Vec4& copyFrom );											// copy constructor (from another vec4)
-	Vec4( const Vec3& copyFrom );
-	explicit Vec4( float initialX, float initialY, float initialZ, float initialW );		// explicit constructor (from x, y, z, w)
+	Vec4( const Vec4& copyFrom ) = default;									// copy constructor (from another vec4)
+	constexpr Vec4( const Vec3& copyFrom );
+	explicit constexpr Vec4( float initialX, float initialY, float initialZ, float initialW );		// explicit constructor (from x, y, z, w)
 	explicit Vec4(const char* asText);
 
 	//Statics
@@ -28,19 +28,19 @@ public:
 	void						SetFromText(const char* asText);
 	
 	// Operators
-	const Vec4					operator+( const Vec4& vecToAdd ) const;					// vec2 + vec2
-	const Vec4					operator-( const Vec4& vecToSubtract ) const;				// vec2 - vec2
-	const Vec4					operator*( float uniformScale ) const;						// vec2 * float
-	const Vec4					operator/( float inverseScale ) const;						// vec2 / float
-	void						operator+=( const Vec4& vecToAdd );							// vec2 += vec2
-	void						operator-=( const Vec4& vecToSubtract );					// vec2 -= vec2
-	void						operator*=( const float uniformScale );						// vec2 *= float
-	void						operator/=( const float uniformDivisor );					// vec2 /= float
-	void						operator=( const Vec4& copyFrom );							// vec2 = vec2
-	bool						operator==( const Vec4& compare ) const;					// vec2 == vec2
-	bool						operator!=( const Vec4& compare ) const;					// vec2 != vec2
-
-	friend const Vec4			operator*( float uniformScale, const Vec4& vecToScale );	// float * vec2
+	constexpr const Vec4		operator+( const Vec4& vecToAdd ) const;					// vec2 + vec2
+	constexpr const Vec4		operator-( const Vec4& vecToSubtract ) const;				// vec2 - vec2
+	constexpr const Vec4		operator*( float uniformScale ) const;						// vec2 * float
+	constexpr const Vec4		operator/( float inverseScale ) const;						// vec2 / float
+	constexpr void				operator+=( const Vec4& vecToAdd );							// vec2 += vec2
+	constexpr void				operator-=( const Vec4& vecToSubtract );					// vec2 -= vec2
+	constexpr void				operator*=( const float uniformScale );						// vec2 *= float
+	constexpr void				operator/=( const float uniformDivisor );					// vec2 /= float
+	Vec4&						operator=( const Vec4& copyFrom ) = default;				// vec2 = vec2
+	constexpr bool				operator==( const Vec4& compare ) const;					// vec2 == vec2
+	constexpr bool				operator!=( const Vec4& compare ) const;					// vec2 != vec2
+
+	friend constexpr const Vec4	operator*( float uniformScale, const Vec4& vecToScale );	// float * vec2
 	void						operator*=(const Matrix44 matrix);
 
 public: 
@@ -48,4 +48,110 @@ public:
 	float y;
 	float z;
 	float w;
-};
\ No newline at end of file
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Inline constexpr arithmetic, Vec4 goes straight into constant buffers so it stays trivially copyable and 4 packed floats
+//------------------------------------------------------------------------------------------------------------------------------
+static_assert(std::is_trivially_copyable<Vec4>::value, "Vec4 must stay trivially copyable");
+static_assert(sizeof(Vec4) == 4 * sizeof(float), "Vec4 must stay 4 packed floats");
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr Vec4::Vec4( float initialX, float initialY, float initialZ, float initialW )
+	: x( initialX )
+	, y( initialY )
+	, z( initialZ )
+	, w( initialW )
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr Vec4::Vec4( const Vec3& copyFrom )
+	: x( copyFrom.x )
+	, y( copyFrom.y )
+	, z( copyFrom.z )
+	, w( 0.f )
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec4 Vec4::operator+( const Vec4& vecToAdd ) const
+{
+	return Vec4( x + vecToAdd.x, y + vecToAdd.y, z + vecToAdd.z, w + vecToAdd.w );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec4 Vec4::operator-( const Vec4& vecToSubtract ) const
+{
+	return Vec4( x - vecToSubtract.x, y - vecToSubtract.y, z - vecToSubtract.z, w - vecToSubtract.w );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec4 Vec4::operator*( float uniformScale ) const
+{
+	return Vec4( x * uniformScale, y * uniformScale, z * uniformScale, w * uniformScale );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec4 Vec4::operator/( float inverseScale ) const
+{
+	return Vec4( x / inverseScale, y / inverseScale, z / inverseScale, w / inverseScale );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr void Vec4::operator+=( const Vec4& vecToAdd )
+{
+	x += vecToAdd.x;
+	y += vecToAdd.y;
+	z += vecToAdd.z;
+	w += vecToAdd.w;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr void Vec4::operator-=( const Vec4& vecToSubtract )
+{
+	x -= vecToSubtract.x;
+	y -= vecToSubtract.y;
+	z -= vecToSubtract.z;
+	w -= vecToSubtract.w;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr void Vec4::operator*=( const float uniformScale )
+{
+	x *= uniformScale;
+	y *= uniformScale;
+	z *= uniformScale;
+	w *= uniformScale;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr void Vec4::operator/=( const float uniformDivisor )
+{
+	x /= uniformDivisor;
+	y /= uniformDivisor;
+	z /= uniformDivisor;
+	w /= uniformDivisor;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr bool Vec4::operator==( const Vec4& compare ) const
+{
+	return (x == compare.x && y == compare.y && z == compare.z && w == compare.w);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr bool Vec4::operator!=( const Vec4& compare ) const
+{
+	return !(x == compare.x && y == compare.y && z == compare.z && w == compare.w);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr const Vec4 operator*( float uniformScale, const Vec4& vecToScale )
+{
+	return Vec4( vecToScale.x * uniformScale, vecToScale.y * uniformScale, vecToScale.z * uniformScale, vecToScale.w * uniformScale );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+inline constexpr Vec4 Vec4::ZERO(0.f, 0.f, 0.f, 0.f);
+inline constexpr Vec4 Vec4::ONE(1.f, 1.f, 1.f, 1.f);
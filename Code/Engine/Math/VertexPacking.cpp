@@ -0,0 +1,404 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Math/VertexPacking.hpp"
+//Engine Systems
+#include "Engine/Math/VertexMaster.hpp"
+#include "Engine/Renderer/Rgba.hpp"
+#include <cmath>
+#include <string.h>
+
+#if !defined(ENGINE_DISABLE_SIMD) && (defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__))
+#define VERTEX_PACKING_SSE2
+#include <emmintrin.h>
+#endif
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr float		OCTAHEDRAL_MIN_LENGTH = 1e-20f;		// zero vectors encode as (0, 0), which decodes to +Z
+constexpr float		SNORM16_MAX = 32767.f;
+constexpr float		UNORM16_MAX = 65535.f;
+constexpr float		UNORM8_MAX = 255.f;
+
+//------------------------------------------------------------------------------------------------------------------------------
+static inline float ClampZeroToOneForPacking(float value)
+{
+	//Written so a NaN comes out as 0 like _mm_max_ps does
+	value = (value > 0.f) ? value : 0.f;
+	return (value < 1.f) ? value : 1.f;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static inline int RoundForPacking(float value)
+{
+	//Round to nearest even, what _mm_cvtps_epi32 does in the default rounding mode
+	return static_cast<int>(std::nearbyint(value));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+uint EncodeOctahedralSnorm16(const Vec3& direction)
+{
+	float absX = fabsf(direction.x);
+	float absY = fabsf(direction.y);
+	float absZ = fabsf(direction.z);
+
+	float sum = absX + absY + absZ;
+	sum = (sum > OCTAHEDRAL_MIN_LENGTH) ? sum : OCTAHEDRAL_MIN_LENGTH;
+	float invSum = 1.f / sum;
+
+	float octX = direction.x * invSum;
+	float octY = direction.y * invSum;
+
+	//The lower hemisphere folds over the diagonals
+	if (direction.z < 0.f)
+	{
+		float signX = std::signbit(octX) ? -1.f : 1.f;
+		float signY = std::signbit(octY) ? -1.f : 1.f;
+		float foldedX = (1.f - fabsf(octY)) * signX;
+		float foldedY = (1.f - fabsf(octX)) * signY;
+		octX = foldedX;
+		octY = foldedY;
+	}
+
+	//Only does anything for non finite directions. Written like _mm_max_ps and _mm_min_ps so a NaN comes out as -1.
+	octX = (octX > -1.f) ? octX : -1.f;
+	octX = (octX < 1.f) ? octX : 1.f;
+	octY = (octY > -1.f) ? octY : -1.f;
+	octY = (octY < 1.f) ? octY : 1.f;
+
+	ushort packedX = static_cast<ushort>(static_cast<short>(RoundForPacking(octX * SNORM16_MAX)));
+	ushort packedY = static_cast<ushort>(static_cast<short>(RoundForPacking(octY * SNORM16_MAX)));
+	return static_cast<uint>(packedX) | (static_cast<uint>(packedY) << 16);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Vec3 DecodeOctahedralSnorm16(uint packed)
+{
+	float octX = static_cast<float>(static_cast<short>(packed & 0xffff)) / SNORM16_MAX;
+	float octY = static_cast<float>(static_cast<short>(packed >> 16)) / SNORM16_MAX;
+	octX = (octX < -1.f) ? -1.f : octX;
+	octY = (octY < -1.f) ? -1.f : octY;
+
+	Vec3 direction(octX, octY, 1.f - fabsf(octX) - fabsf(octY));
+	float fold = (-direction.z > 0.f) ? -direction.z : 0.f;
+	direction.x += (direction.x >= 0.f) ? -fold : fold;
+	direction.y += (direction.y >= 0.f) ? -fold : fold;
+
+	return direction.GetNormalized();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+ushort FloatToHalf(float value)
+{
+	uint bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	uint sign = bits & 0x80000000u;
+	bits ^= sign;
+
+	uint half;
+	if (bits >= 0x47800000u)
+	{
+		//Too big for a half, or already inf/NaN
+		half = (bits > 0x7f800000u) ? 0x7e00u : 0x7c00u;
+	}
+	else if (bits < 0x38800000u)
+	{
+		//Subnormal half (or zero), the float add does the rounding
+		const uint magicBits = 0x3f000000u;
+		float magic;
+		float absValue;
+		memcpy(&magic, &magicBits, sizeof(magic));
+		memcpy(&absValue, &bits, sizeof(absValue));
+
+		absValue += magic;
+		memcpy(&half, &absValue, sizeof(half));
+		half -= magicBits;
+	}
+	else
+	{
+		//Rebias the exponent and round the mantissa to nearest even
+		uint mantissaOdd = (bits >> 13) & 1u;
+		bits += 0xc8000fffu;
+		bits += mantissaOdd;
+		half = bits >> 13;
+	}
+
+	return static_cast<ushort>(half | (sign >> 16));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+float HalfToFloat(ushort half)
+{
+	uint sign = static_cast<uint>(half & 0x8000u) << 16;
+	uint exponent = (half >> 10) & 0x1fu;
+	uint mantissa = half & 0x3ffu;
+
+	uint bits;
+	if (exponent == 0x1fu)
+	{
+		bits = sign | 0x7f800000u | (mantissa << 13);
+	}
+	else if (exponent != 0)
+	{
+		bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+	}
+	else
+	{
+		//Subnormal halfs are normal floats
+		float value = static_cast<float>(mantissa) * (1.f / 16777216.f);
+		memcpy(&bits, &value, sizeof(bits));
+		bits |= sign;
+	}
+
+	float result;
+	memcpy(&result, &bits, sizeof(result));
+	return result;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+uint PackRgba8(const Rgba& color)
+{
+	uint r = static_cast<uint>(RoundForPacking(ClampZeroToOneForPacking(color.r) * UNORM8_MAX));
+	uint g = static_cast<uint>(RoundForPacking(ClampZeroToOneForPacking(color.g) * UNORM8_MAX));
+	uint b = static_cast<uint>(RoundForPacking(ClampZeroToOneForPacking(color.b) * UNORM8_MAX));
+	uint a = static_cast<uint>(RoundForPacking(ClampZeroToOneForPacking(color.a) * UNORM8_MAX));
+
+	return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+uint PackHalf2(float x, float y)
+{
+	return static_cast<uint>(FloatToHalf(x)) | (static_cast<uint>(FloatToHalf(y)) << 16);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void GetPositionQuantization(const Vec3& boundsMins, const Vec3& boundsMaxs, Vec3* outOffset, Vec3* outScale)
+{
+	Vec3 extents = boundsMaxs - boundsMins;
+
+	*outOffset = boundsMins;
+	*outScale = Vec3(extents.x > 0.f ? extents.x : 1.f, extents.y > 0.f ? extents.y : 1.f, extents.z > 0.f ? extents.z : 1.f);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const VertexMaster* GetVertexBlock(const VertexMaster* vertices, uint first, uint count, VertexMaster* scratch)
+{
+	if (first + 4 <= count)
+	{
+		return vertices + first;
+	}
+
+	for (uint blockIndex = 0; blockIndex < 4; blockIndex++)
+	{
+		uint vertexIndex = (first + blockIndex < count) ? first + blockIndex : count - 1;
+		scratch[blockIndex] = vertices[vertexIndex];
+	}
+
+	return scratch;
+}
+
+#if defined(VERTEX_PACKING_SSE2)
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The three directions of four vertices, transposed so each register holds one component of all four
+//------------------------------------------------------------------------------------------------------------------------------
+static inline void LoadDirections4(const Vec3* direction0, const Vec3* direction1, const Vec3* direction2, const Vec3* direction3, __m128* outX, __m128* outY, __m128* outZ)
+{
+	//16 byte loads are fine, every direction in VertexMaster has more of the vertex after it
+	__m128 row0 = _mm_loadu_ps(&direction0->x);
+	__m128 row1 = _mm_loadu_ps(&direction1->x);
+	__m128 row2 = _mm_loadu_ps(&direction2->x);
+	__m128 row3 = _mm_loadu_ps(&direction3->x);
+	_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+	*outX = row0;
+	*outY = row1;
+	*outZ = row2;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static inline __m128 SelectPS(__m128 mask, __m128 ifTrue, __m128 ifFalse)
+{
+	return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static inline __m128i EncodeOctahedral4(__m128 x, __m128 y, __m128 z)
+{
+	const __m128 signMask = _mm_set1_ps(-0.f);
+	const __m128 one = _mm_set1_ps(1.f);
+
+	__m128 absX = _mm_andnot_ps(signMask, x);
+	__m128 absY = _mm_andnot_ps(signMask, y);
+	__m128 absZ = _mm_andnot_ps(signMask, z);
+
+	__m128 sum = _mm_add_ps(_mm_add_ps(absX, absY), absZ);
+	sum = _mm_max_ps(sum, _mm_set1_ps(OCTAHEDRAL_MIN_LENGTH));
+	__m128 invSum = _mm_div_ps(one, sum);
+
+	__m128 octX = _mm_mul_ps(x, invSum);
+	__m128 octY = _mm_mul_ps(y, invSum);
+
+	__m128 signX = _mm_or_ps(_mm_and_ps(octX, signMask), one);
+	__m128 signY = _mm_or_ps(_mm_and_ps(octY, signMask), one);
+	__m128 foldedX = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, octY)), signX);
+	__m128 foldedY = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, octX)), signY);
+
+	__m128 isLower = _mm_cmplt_ps(z, _mm_setzero_ps());
+	octX = SelectPS(isLower, foldedX, octX);
+	octY = SelectPS(isLower, foldedY, octY);
+
+	//NaN has to clamp before the convert, which would make it 0x80000000 and pack it to -32768
+	const __m128 minusOne = _mm_set1_ps(-1.f);
+	octX = _mm_min_ps(_mm_max_ps(octX, minusOne), one);
+	octY = _mm_min_ps(_mm_max_ps(octY, minusOne), one);
+
+	const __m128 snormScale = _mm_set1_ps(SNORM16_MAX);
+	__m128i packedX = _mm_cvtps_epi32(_mm_mul_ps(octX, snormScale));
+	__m128i packedY = _mm_cvtps_epi32(_mm_mul_ps(octY, snormScale));
+
+	//x0 y0 x1 y1 ... so each uint has x in the low half
+	packedX = _mm_packs_epi32(packedX, packedX);
+	packedY = _mm_packs_epi32(packedY, packedY);
+	return _mm_unpacklo_epi16(packedX, packedY);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// ryg's float to half (RTNE), four at a time. The results are in the low 16 bits of each lane, sign extended so a
+// saturating pack keeps them intact.
+//------------------------------------------------------------------------------------------------------------------------------
+static inline __m128i FloatToHalf4(__m128 value)
+{
+	const __m128i halfMax = _mm_set1_epi32(0x47800000);
+	const __m128i minNormal = _mm_set1_epi32(0x38800000);
+	const __m128i subnormalMagic = _mm_set1_epi32(0x3f000000);
+	const __m128i normalBias = _mm_set1_epi32(static_cast<int>(0xc8000fffu));
+	const __m128i nanBit = _mm_set1_epi32(0x200);
+	const __m128i infinity = _mm_set1_epi32(0x7c00);
+
+	__m128 sign = _mm_and_ps(value, _mm_set1_ps(-0.f));
+	__m128 absValue = _mm_xor_ps(value, sign);
+	__m128i absBits = _mm_castps_si128(absValue);
+
+	__m128 isNaN = _mm_cmpunord_ps(absValue, absValue);
+	__m128i isRegular = _mm_cmpgt_epi32(halfMax, absBits);
+	__m128i infOrNaN = _mm_or_si128(_mm_and_si128(_mm_castps_si128(isNaN), nanBit), infinity);
+
+	__m128i isSubnormal = _mm_cmpgt_epi32(minNormal, absBits);
+	__m128 subnormalRounded = _mm_add_ps(absValue, _mm_castsi128_ps(subnormalMagic));
+	__m128i subnormal = _mm_sub_epi32(_mm_castps_si128(subnormalRounded), subnormalMagic);
+
+	__m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absBits, 18), 31);
+	__m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absBits, normalBias), mantissaOdd), 13);
+
+	__m128i finite = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+	__m128i half = _mm_or_si128(_mm_and_si128(isRegular, finite), _mm_andnot_si128(isRegular, infOrNaN));
+
+	return _mm_or_si128(half, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static inline __m128 LoadUV(const Vec2& uv)
+{
+	//8 byte load, the UV is the last thing in VertexMaster
+	return _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(&uv.x)));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static inline __m128i PackUnorm8Color(const Rgba& color)
+{
+	__m128 value = _mm_loadu_ps(&color.r);
+	value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.f));
+	return _mm_cvtps_epi32(_mm_mul_ps(value, _mm_set1_ps(UNORM8_MAX)));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PackAttributesForBlock(const VertexMaster* block, PackedVertexBlock* out)
+{
+	__m128 x;
+	__m128 y;
+	__m128 z;
+
+	LoadDirections4(&block[0].m_normal, &block[1].m_normal, &block[2].m_normal, &block[3].m_normal, &x, &y, &z);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out->m_normals), EncodeOctahedral4(x, y, z));
+
+	LoadDirections4(&block[0].m_tangent, &block[1].m_tangent, &block[2].m_tangent, &block[3].m_tangent, &x, &y, &z);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out->m_tangents), EncodeOctahedral4(x, y, z));
+
+	LoadDirections4(&block[0].m_biTangent, &block[1].m_biTangent, &block[2].m_biTangent, &block[3].m_biTangent, &x, &y, &z);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out->m_biTangents), EncodeOctahedral4(x, y, z));
+
+	//RGBA per lane, two saturating packs take them down to bytes in order
+	__m128i colors01 = _mm_packs_epi32(PackUnorm8Color(block[0].m_color), PackUnorm8Color(block[1].m_color));
+	__m128i colors23 = _mm_packs_epi32(PackUnorm8Color(block[2].m_color), PackUnorm8Color(block[3].m_color));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out->m_colors), _mm_packus_epi16(colors01, colors23));
+
+	//u0 v0 u1 v1 and u2 v2 u3 v3 halfs, packed to 16 bits they're already in vertex order
+	__m128 uvs01 = _mm_movelh_ps(LoadUV(block[0].m_uv), LoadUV(block[1].m_uv));
+	__m128 uvs23 = _mm_movelh_ps(LoadUV(block[2].m_uv), LoadUV(block[3].m_uv));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out->m_uvs), _mm_packs_epi32(FloatToHalf4(uvs01), FloatToHalf4(uvs23)));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static inline __m128i QuantizePosition(const Vec3& position, __m128 offset, __m128 invScale)
+{
+	//The 4th float is the normal's x, the mask drops it
+	__m128 value = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&position.x), offset), invScale);
+	value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.f));
+
+	__m128i quantized = _mm_cvtps_epi32(_mm_mul_ps(value, _mm_set1_ps(UNORM16_MAX)));
+	quantized = _mm_and_si128(quantized, _mm_set_epi32(0, -1, -1, -1));
+
+	//SSE2 has no unsigned pack from 32 bits, so go through signed and flip the top bit back
+	return _mm_sub_epi32(quantized, _mm_set1_epi32(32768));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void QuantizePositionsForBlock(const VertexMaster* block, const Vec3& offset, const Vec3& scale, PackedVertexBlock* out)
+{
+	__m128 offset4 = _mm_set_ps(0.f, offset.z, offset.y, offset.x);
+	__m128 invScale4 = _mm_set_ps(0.f, 1.f / scale.z, 1.f / scale.y, 1.f / scale.x);
+	const __m128i flip = _mm_set1_epi16(static_cast<short>(0x8000));
+
+	__m128i positions01 = _mm_packs_epi32(QuantizePosition(block[0].m_position, offset4, invScale4), QuantizePosition(block[1].m_position, offset4, invScale4));
+	__m128i positions23 = _mm_packs_epi32(QuantizePosition(block[2].m_position, offset4, invScale4), QuantizePosition(block[3].m_position, offset4, invScale4));
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out->m_positions[0]), _mm_xor_si128(positions01, flip));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out->m_positions[2]), _mm_xor_si128(positions23, flip));
+}
+
+#else
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PackAttributesForBlock(const VertexMaster* block, PackedVertexBlock* out)
+{
+	for (uint blockIndex = 0; blockIndex < 4; blockIndex++)
+	{
+		const VertexMaster& vertex = block[blockIndex];
+		out->m_normals[blockIndex] = EncodeOctahedralSnorm16(vertex.m_normal);
+		out->m_tangents[blockIndex] = EncodeOctahedralSnorm16(vertex.m_tangent);
+		out->m_biTangents[blockIndex] = EncodeOctahedralSnorm16(vertex.m_biTangent);
+		out->m_colors[blockIndex] = PackRgba8(vertex.m_color);
+		out->m_uvs[blockIndex] = PackHalf2(vertex.m_uv.x, vertex.m_uv.y);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void QuantizePositionsForBlock(const VertexMaster* block, const Vec3& offset, const Vec3& scale, PackedVertexBlock* out)
+{
+	float invScale[3] = { 1.f / scale.x, 1.f / scale.y, 1.f / scale.z };
+	float offsets[3] = { offset.x, offset.y, offset.z };
+
+	for (uint blockIndex = 0; blockIndex < 4; blockIndex++)
+	{
+		const float* position = &block[blockIndex].m_position.x;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			float value = ClampZeroToOneForPacking((position[axis] - offsets[axis]) * invScale[axis]);
+			out->m_positions[blockIndex][axis] = static_cast<ushort>(RoundForPacking(value * UNORM16_MAX));
+		}
+
+		out->m_positions[blockIndex][3] = 0;
+	}
+}
+
+#endif
@@ -0,0 +1,49 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+//Engine Systems
+#include "Engine/Commons/EngineCommon.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+struct Rgba;
+struct VertexMaster;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Encoders for the packed vertex formats. Everything comes in a scalar version and a four vertices at a time version
+// the CopyFromMaster functions use, which is SSE2 where the compiler has it. Both give bit identical results.
+//
+//	Directions:	octahedral, two snorm16 in one uint (x in the low half). Non finite components clamp to -1 or 1, NaN
+//				to -1. Decode in HLSL with
+//				float3 n = float3(e.xy, 1 - abs(e.x) - abs(e.y));
+//				n.xy += (n.xy >= 0 ? -1 : 1) * saturate(-n.z);
+//				n = normalize(n);
+//	Colors:		RGBA8 unorm
+//	UVs:		two half floats, round to nearest even. Halfs rather than unorm16 so tiling UVs outside 0-1 still work
+//	Positions:	unorm16 xyz (w is 0) across the mesh bounds, position = offset + value * scale
+//------------------------------------------------------------------------------------------------------------------------------
+uint		EncodeOctahedralSnorm16(const Vec3& direction);
+Vec3		DecodeOctahedralSnorm16(uint packed);
+ushort		FloatToHalf(float value);
+float		HalfToFloat(ushort half);
+uint		PackRgba8(const Rgba& color);
+uint		PackHalf2(float x, float y);
+
+// Extents of zero get a scale of one so the encode never divides by zero
+void		GetPositionQuantization(const Vec3& boundsMins, const Vec3& boundsMaxs, Vec3* outOffset, Vec3* outScale);
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct PackedVertexBlock
+{
+	uint		m_normals[4];
+	uint		m_tangents[4];
+	uint		m_biTangents[4];
+	uint		m_colors[4];
+	uint		m_uvs[4];
+	ushort		m_positions[4][4];		// only filled by QuantizePositionsForBlock
+};
+
+// Four vertices starting at first. Past the end of the array the last vertex is repeated into scratch, so the block
+// functions can always work on four.
+const VertexMaster*		GetVertexBlock(const VertexMaster* vertices, uint first, uint count, VertexMaster* scratch);
+
+void		PackAttributesForBlock(const VertexMaster* block, PackedVertexBlock* out);
+void		QuantizePositionsForBlock(const VertexMaster* block, const Vec3& offset, const Vec3& scale, PackedVertexBlock* out);
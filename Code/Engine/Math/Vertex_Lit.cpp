@@ -2,6 +2,7 @@
 #include "Engine/Math/Vertex_Lit.hpp"
 #include "Engine/Renderer/BufferLayout.hpp"
 #include "Engine/Renderer/CPUMesh.hpp"
+#include <stddef.h>
 
 //------------------------------------------------------------------------------------------------------------------------------
 Vertex_Lit::Vertex_Lit( const VertexMaster& master )
@@ -33,7 +34,21 @@ STATIC BufferAttributeT Vertex_Lit::LAYOUT[] = {
 };
 
 //------------------------------------------------------------------------------------------------------------------------------
-const BufferLayout* Vertex_Lit::layout = BufferLayout::For<Vertex_Lit>();
+static_assert(sizeof(Vertex_Lit) == sizeof(VertexMaster) && offsetof(Vertex_Lit, m_normal) == offsetof(VertexMaster, m_normal)
+	&& offsetof(Vertex_Lit, m_tangent) == offsetof(VertexMaster, m_tangent) && offsetof(Vertex_Lit, m_biTangent) == offsetof(VertexMaster, m_biTangent)
+	&& offsetof(Vertex_Lit, m_color) == offsetof(VertexMaster, m_color) && offsetof(Vertex_Lit, m_uv) == offsetof(VertexMaster, m_uv),
+	"Vertex_Lit has to match VertexMaster for its layout to set m_matchesMaster");
+
+//------------------------------------------------------------------------------------------------------------------------------
+static const BufferLayout* CreateVertexLitLayout()
+{
+	BufferLayout* layout = const_cast<BufferLayout*>(BufferLayout::For<Vertex_Lit>());
+	layout->m_matchesMaster = true;
+	return layout;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const BufferLayout* Vertex_Lit::layout = CreateVertexLitLayout();
 
 //------------------------------------------------------------------------------------------------------------------------------
 STATIC void Vertex_Lit::CopyFromMaster( void *buffer, VertexMaster const *src, uint count )
@@ -0,0 +1,64 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Math/Vertex_LitPacked.hpp"
+#include "Engine/Math/VertexPacking.hpp"
+#include "Engine/Renderer/BufferLayout.hpp"
+#include "Engine/Renderer/CPUMesh.hpp"
+#include <stddef.h>
+
+//------------------------------------------------------------------------------------------------------------------------------
+Vertex_LitPacked::Vertex_LitPacked( const VertexMaster& master )
+{
+	m_position = master.m_position;
+	m_normal = EncodeOctahedralSnorm16(master.m_normal);
+	m_tangent = EncodeOctahedralSnorm16(master.m_tangent);
+	m_biTangent = EncodeOctahedralSnorm16(master.m_biTangent);
+
+	m_color = PackRgba8(master.m_color);
+	m_uv = PackHalf2(master.m_uv.x, master.m_uv.y);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Vertex_LitPacked::Vertex_LitPacked()
+{
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC BufferAttributeT Vertex_LitPacked::LAYOUT[] = {
+	BufferAttributeT( "POSITION",  DF_VEC3,			offsetof(Vertex_LitPacked, m_position)	), 
+	BufferAttributeT( "NORMAL",    DF_SNORM16_2,	offsetof(Vertex_LitPacked, m_normal)	), 
+	BufferAttributeT( "TANGENT",   DF_SNORM16_2,	offsetof(Vertex_LitPacked, m_tangent)	),
+	BufferAttributeT( "BITANGENT", DF_SNORM16_2,	offsetof(Vertex_LitPacked, m_biTangent)	),
+	BufferAttributeT( "COLOR",     DF_RGBA8_UNORM,	offsetof(Vertex_LitPacked, m_color)		), 
+	BufferAttributeT( "TEXCOORD",  DF_HALF2,		offsetof(Vertex_LitPacked, m_uv)		), 
+	BufferAttributeT() // end		
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+const BufferLayout* Vertex_LitPacked::layout = BufferLayout::For<Vertex_LitPacked>();
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC void Vertex_LitPacked::CopyFromMaster( void *buffer, VertexMaster const *src, uint count )
+{
+	Vertex_LitPacked *dst = (Vertex_LitPacked*)buffer; 
+
+	VertexMaster scratch[4];
+	PackedVertexBlock packed;
+
+	for (uint first = 0; first < count; first += 4)
+	{
+		const VertexMaster* block = GetVertexBlock(src, first, count, scratch);
+		PackAttributesForBlock(block, &packed);
+
+		for (uint i = 0; i < 4 && first + i < count; ++i)
+		{
+			Vertex_LitPacked& vertex = dst[first + i];
+			vertex.m_position = block[i].m_position;
+			vertex.m_normal = packed.m_normals[i];
+			vertex.m_tangent = packed.m_tangents[i];
+			vertex.m_biTangent = packed.m_biTangents[i];
+			vertex.m_color = packed.m_colors[i];
+			vertex.m_uv = packed.m_uvs[i];
+		}
+	}
+}
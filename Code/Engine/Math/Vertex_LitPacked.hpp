@@ -0,0 +1,35 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+#include "Engine/Math/Vec3.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct VertexMaster;
+struct BufferAttributeT;
+class BufferLayout;
+
+typedef unsigned int uint;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Vertex_Lit in 32 bytes instead of 80. Directions are octahedral snorm16, color is RGBA8 and the UV is two halfs
+// (see VertexPacking.hpp for the decode); the shader has to unpack them.
+//------------------------------------------------------------------------------------------------------------------------------
+struct Vertex_LitPacked
+{
+public:
+	Vec3 m_position;
+	uint m_normal;
+	uint m_tangent;
+	uint m_biTangent;
+
+	uint m_color;
+	uint m_uv;
+
+public:
+	Vertex_LitPacked();
+	explicit Vertex_LitPacked(const VertexMaster& master);
+	~Vertex_LitPacked() {}
+
+	static BufferAttributeT LAYOUT[]; 
+	static const BufferLayout* layout;
+	static void CopyFromMaster( void *buffer, VertexMaster const *src, uint count ); 
+};
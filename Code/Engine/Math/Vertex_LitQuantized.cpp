@@ -0,0 +1,71 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Math/Vertex_LitQuantized.hpp"
+#include "Engine/Math/VertexPacking.hpp"
+#include "Engine/Renderer/BufferLayout.hpp"
+#include "Engine/Renderer/CPUMesh.hpp"
+#include <stddef.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------------------------------------------------------
+Vertex_LitQuantized::Vertex_LitQuantized()
+{
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC BufferAttributeT Vertex_LitQuantized::LAYOUT[] = {
+	BufferAttributeT( "POSITION",  DF_UNORM16_4,	offsetof(Vertex_LitQuantized, m_position)	), 
+	BufferAttributeT( "NORMAL",    DF_SNORM16_2,	offsetof(Vertex_LitQuantized, m_normal)		), 
+	BufferAttributeT( "TANGENT",   DF_SNORM16_2,	offsetof(Vertex_LitQuantized, m_tangent)	),
+	BufferAttributeT( "BITANGENT", DF_SNORM16_2,	offsetof(Vertex_LitQuantized, m_biTangent)	),
+	BufferAttributeT( "COLOR",     DF_RGBA8_UNORM,	offsetof(Vertex_LitQuantized, m_color)		), 
+	BufferAttributeT( "TEXCOORD",  DF_HALF2,		offsetof(Vertex_LitQuantized, m_uv)			), 
+	BufferAttributeT() // end		
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+const BufferLayout* Vertex_LitQuantized::layout = BufferLayout::For<Vertex_LitQuantized>();
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC void Vertex_LitQuantized::CopyFromMaster( void *buffer, VertexMaster const *src, uint count )
+{
+	Vertex_LitQuantized *dst = (Vertex_LitQuantized*)buffer; 
+	if (count == 0)
+	{
+		return;
+	}
+
+	//Same bounds CPUMesh::GetBounds gives the GPUMesh, so the offset and scale match
+	Vec3 mins = src[0].m_position;
+	Vec3 maxs = src[0].m_position;
+	for (uint i = 1; i < count; ++i)
+	{
+		mins = Vec3::GetComponentMin(mins, src[i].m_position);
+		maxs = Vec3::GetComponentMax(maxs, src[i].m_position);
+	}
+
+	Vec3 offset;
+	Vec3 scale;
+	GetPositionQuantization(mins, maxs, &offset, &scale);
+
+	VertexMaster scratch[4];
+	PackedVertexBlock packed;
+
+	for (uint first = 0; first < count; first += 4)
+	{
+		const VertexMaster* block = GetVertexBlock(src, first, count, scratch);
+		PackAttributesForBlock(block, &packed);
+		QuantizePositionsForBlock(block, offset, scale, &packed);
+
+		for (uint i = 0; i < 4 && first + i < count; ++i)
+		{
+			Vertex_LitQuantized& vertex = dst[first + i];
+			memcpy(vertex.m_position, packed.m_positions[i], sizeof(vertex.m_position));
+			vertex.m_normal = packed.m_normals[i];
+			vertex.m_tangent = packed.m_tangents[i];
+			vertex.m_biTangent = packed.m_biTangents[i];
+			vertex.m_color = packed.m_colors[i];
+			vertex.m_uv = packed.m_uvs[i];
+		}
+	}
+}
@@ -0,0 +1,33 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+#include "Engine/Commons/EngineCommon.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct VertexMaster;
+struct BufferAttributeT;
+class BufferLayout;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Vertex_LitPacked with the position as unorm16 across the mesh bounds, 28 bytes. The GPUMesh keeps the offset and
+// scale and RenderContext puts them in the model buffer, position = PositionOffset + value * PositionScale.
+// CopyFromMaster works the bounds out from the vertices it is given, so it has to be given the whole mesh.
+//------------------------------------------------------------------------------------------------------------------------------
+struct Vertex_LitQuantized
+{
+public:
+	ushort m_position[4];
+	uint m_normal;
+	uint m_tangent;
+	uint m_biTangent;
+
+	uint m_color;
+	uint m_uv;
+
+public:
+	Vertex_LitQuantized();
+	~Vertex_LitQuantized() {}
+
+	static BufferAttributeT LAYOUT[]; 
+	static const BufferLayout* layout;
+	static void CopyFromMaster( void *buffer, VertexMaster const *src, uint count ); 
+};
@@ -3,10 +3,12 @@
 #include "Engine/Commons/EngineCommon.hpp"
 #include "Engine/Commons/Profiler/Profiler.hpp"
 #include "Engine/Core/EventSystems.hpp"
+#include "Engine/Core/FileUtils.hpp"
 #include "Engine/Renderer/CPUMesh.hpp"
 #include "Engine/Core/NamedProperties.hpp"
 #include "Engine/Math/Matrix44.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Quaternion.hpp"
 #include "Engine/Math/Vec3.hpp"
 #include "Engine/Math/Vec4.hpp"
 //PhysX API
@@ -96,6 +98,7 @@ void PhysXSystem::StartUp()
 {
 	//First subscribe the LoadCollisionMeshFromData function as a ReadCollisionMeshFromData event
 	g_eventSystem->SubscribeEventCallBackFn("ReadCollisionMeshFromData", LoadCollisionMeshFromData);
+	g_eventSystem->SubscribeEventCallBackFn("CookCollisionMesh", CookCollisionMeshToFile);
 
 
 	//PhysX starts off by setting up a Physics Foundation
@@ -1097,6 +1100,20 @@ STATIC physx::PxVec4 PhysXSystem::VecToPxVector(const Vec4& vector)
 	return pxVector;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC Quaternion PhysXSystem::PxQuatToQuaternion(const PxQuat& pxQuat)
+{
+	Quaternion quaternion(pxQuat.x, pxQuat.y, pxQuat.z, pxQuat.w);
+	return quaternion;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC physx::PxQuat PhysXSystem::QuaternionToPxQuat(const Quaternion& quaternion)
+{
+	PxQuat pxQuat(quaternion.x, quaternion.y, quaternion.z, quaternion.w);
+	return pxQuat;
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 STATIC Vec3 PhysXSystem::QuaternionToEulerAngles(const PxQuat& quat) 
 {
@@ -1151,24 +1168,12 @@ STATIC physx::PxQuat PhysXSystem::EulerAnglesToQuaternion(const Vec3& eulerAngle
 	return quaternion;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+// Our matrices hold the rotation PhysX calls the conjugate, see MakeMatrixFromQuaternion
 //------------------------------------------------------------------------------------------------------------------------------
 STATIC PxQuat PhysXSystem::MakeQuaternionFromMatrix(const Matrix44& matrix)
 {
-	//Quaternion
-	float w = sqrtf(1.0f + matrix.m_values[Matrix44::Ix] + matrix.m_values[Matrix44::Jy] + matrix.m_values[Matrix44::Kz]) / 2.0f;
-
-	if (w == 0)
-	{
-		w = 1.f;
-	}
-
-	float one_over_w4 = 1.f / (4.0f * w);
-	float x = (matrix.m_values[Matrix44::Ky] - matrix.m_values[Matrix44::Jz]) * one_over_w4;
-	float y = (matrix.m_values[Matrix44::Iz] - matrix.m_values[Matrix44::Kx]) * one_over_w4;
-	float z = (matrix.m_values[Matrix44::Jx] - matrix.m_values[Matrix44::Iy]) * one_over_w4;
-
-	PxQuat quaternion = PxQuat(x, y, z, w);
-	return quaternion;
+	return QuaternionToPxQuat(Quaternion::MakeFromMatrix(matrix).GetConjugate());
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -1178,30 +1183,33 @@ STATIC float PhysXSystem::GetRadiansPerSecondToRotationsPerMinute(float radiansP
 	return rotationsPerMinute;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+// The engine matrix is the rotation of the conjugate quaternion (I basis is the first row of the PhysX rotation)
 //------------------------------------------------------------------------------------------------------------------------------
 STATIC Matrix44 PhysXSystem::MakeMatrixFromQuaternion(const PxQuat& quat, const PxVec3& position)
 {
-	Matrix44 matrix = Matrix44::IDENTITY; 
-
-	//Rotation components
-	matrix.m_values[Matrix44::Ix] = 1 - (2 * (quat.z * quat.z + quat.y * quat.y));
-	matrix.m_values[Matrix44::Iy] = 2 * (quat.x * quat.y - quat.z * quat.w);
-	matrix.m_values[Matrix44::Iz] = 2 * (quat.y * quat.w - quat.x * quat.z);
-
-	matrix.m_values[Matrix44::Jx] = 2 * (quat.x * quat.y + quat.z * quat.w);
-	matrix.m_values[Matrix44::Jy] = 1 - (2 * (quat.x * quat.x + quat.z * quat.z));
-	matrix.m_values[Matrix44::Jz] = 2 * (quat.y * quat.z - quat.x * quat.w);
+	return PxQuatToQuaternion(quat).GetConjugate().GetMatrix(PxVectorToVec(position));
+}
 
-	matrix.m_values[Matrix44::Kx] = 2 * (quat.x * quat.z - quat.y * quat.w);
-	matrix.m_values[Matrix44::Ky] = 2 * (quat.y * quat.z + quat.x * quat.w);
-	matrix.m_values[Matrix44::Kz] = 1 - (2 * (quat.y * quat.y - quat.x * quat.x));
+//------------------------------------------------------------------------------------------------------------------------------
+// Same as MakeMatrixFromQuaternion on each actor's global pose, converted 4 at a time. Use this over per actor calls
+// when pulling the whole scene back after a simulate.
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC void PhysXSystem::MakeMatricesFromActors(Matrix44* outMatrices, PxRigidActor* const* actors, int numActors)
+{
+	std::vector<Quaternion> rotations;
+	std::vector<Vec3> positions;
+	rotations.resize(numActors);
+	positions.resize(numActors);
 
-	//Translation
-	matrix.m_values[Matrix44::Tx] = position.x;
-	matrix.m_values[Matrix44::Ty] = position.y;
-	matrix.m_values[Matrix44::Tz] = position.z;
+	for (int actorIndex = 0; actorIndex < numActors; actorIndex++)
+	{
+		PxTransform pose = actors[actorIndex]->getGlobalPose();
+		rotations[actorIndex] = PxQuatToQuaternion(pose.q).GetConjugate();
+		positions[actorIndex] = PxVectorToVec(pose.p);
+	}
 
-	return matrix;
+	MakeMatricesFromQuaternions(outMatrices, rotations.data(), positions.data(), numActors);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -1225,44 +1233,38 @@ STATIC physx::PxQuat PhysXSystem::MakeQuaternionFromPxVectors(const PxVec3& vect
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-STATIC bool PhysXSystem::LoadCollisionMeshFromData(EventArgs& args)
+// Loads the collision source the event describes and runs it through PxCooking, shared by loading and the asset cooker
+//------------------------------------------------------------------------------------------------------------------------------
+static bool CookCollisionMeshFromArgs(EventArgs& args, PxDefaultMemoryOutputStream& outStream, bool loadNestedCollision)
 {
-	//Load the mesh
-	DebuggerPrintf("\n\n Called event LoadCollisionMeshFromData");
 	ObjectLoader loader;
+	loader.m_loadCollision = loadNestedCollision;
 
-	std::string id = "";
 	std::string src = "";
-	id = args.GetValue("id", id);
 	src = args.GetValue("src", src);
 
-	if (id == "")
+	//Check the file extension
+	std::vector<std::string> strings = SplitStringOnDelimiter(src, '.');
+	bool isDataDriven = false;
+	if (strings.size() > 1)
 	{
-		//The id is invalid so just return
-		return false;
-	}
-	else
-	{
-		//Id was valid so now let's load the mesh
-		//Check the file extension
-		std::vector<std::string> strings = SplitStringOnDelimiter(src, '.');
-		bool isDataDriven = false;
-		if (strings.size() > 1)
+		if (strings[(strings.size() - 1)] == "mesh")
 		{
-			if (strings[(strings.size() - 1)] == "mesh")
-			{
-				isDataDriven = true;
-			}
+			isDataDriven = true;
 		}
+	}
 
-		//Before we can CreateMeshFromFile we need to send it the required transform, scale, invert, tangent information
-		loader.m_tangents = args.GetValue("tangents", loader.m_tangents);
-		loader.m_scale = args.GetValue("scale", loader.m_scale);
-		loader.m_transform = args.GetValue("transform", loader.m_transform);
-		loader.m_invert = args.GetValue("invert", loader.m_invert);
+	//Before we can CreateMeshFromFile we need to send it the required transform, scale, invert, tangent information
+	loader.m_tangents = args.GetValue("tangents", loader.m_tangents);
+	loader.m_scale = args.GetValue("scale", loader.m_scale);
+	loader.m_transform = args.GetValue("transform", loader.m_transform);
+	loader.m_invert = args.GetValue("invert", loader.m_invert);
 
-		//This will now load the mesh from file
-		loader.LoadMeshFromFile(g_renderContext, MODEL_PATH + src, isDataDriven);
+	//This will now load the mesh from file
+	loader.LoadMeshFromFile(g_renderContext, MODEL_PATH + src, isDataDriven);
+	if (loader.m_cpuMesh == nullptr)
+	{
+		return false;
 	}
 
 	//Create a PxConvexMesh from the vertex array 
@@ -1277,20 +1279,56 @@ STATIC bool PhysXSystem::LoadCollisionMeshFromData(EventArgs& args)
 	desc.flags = PxConvexFlag::eCOMPUTE_CONVEX;
 
 	//Use PxCooking to construct the PxConvexMesh
-	PxDefaultMemoryOutputStream buffer;
 	PxConvexMeshCookingResult::Enum result;
-	if (!g_PxPhysXSystem->GetPhysXCookingModule()->cookConvexMesh(desc, buffer, &result))
-	{
-		//There was a problem making the mesh
-		//For now we are going to just yell and die
-		ERROR_AND_DIE("Failed to cook collision mesh for object in LoadCollisionMeshFromData");
+	bool cooked = g_PxPhysXSystem->GetPhysXCookingModule()->cookConvexMesh(desc, outStream, &result);
+
+	delete[] convexVerts;
+	return cooked;
+}
 
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC bool PhysXSystem::LoadCollisionMeshFromData(EventArgs& args)
+{
+	//Load the mesh
+	DebuggerPrintf("\n\n Called event LoadCollisionMeshFromData");
+
+	std::string id = "";
+	std::string cookedPath = "";
+	id = args.GetValue("id", id);
+	cookedPath = args.GetValue("cooked", cookedPath);
+
+	if (id == "")
+	{
+		//The id is invalid so just return
 		return false;
 	}
 
-	//We can actually create the convexMesh
-	PxDefaultMemoryInputData input(buffer.getData(), buffer.getSize());
-	PxConvexMesh* convexMesh = g_PxPhysXSystem->GetPhysXSDK()->createConvexMesh(input);
+	PxConvexMesh* convexMesh = nullptr;
+
+	//A hull cooked ahead of time skips loading the source mesh and PxCooking entirely
+	Buffer cookedBuffer;
+	if (cookedPath != "" && LoadBinaryFileToExistingBuffer(cookedPath, cookedBuffer) && cookedBuffer.size() > 0)
+	{
+		PxDefaultMemoryInputData input(&cookedBuffer[0], (PxU32)cookedBuffer.size());
+		convexMesh = g_PxPhysXSystem->GetPhysXSDK()->createConvexMesh(input);
+	}
+
+	if (convexMesh == nullptr)
+	{
+		PxDefaultMemoryOutputStream buffer;
+		if (!CookCollisionMeshFromArgs(args, buffer, true))
+		{
+			//There was a problem making the mesh
+			//For now we are going to just yell and die
+			ERROR_AND_DIE("Failed to cook collision mesh for object in LoadCollisionMeshFromData");
+
+			return false;
+		}
+
+		//We can actually create the convexMesh
+		PxDefaultMemoryInputData input(buffer.getData(), buffer.getSize());
+		convexMesh = g_PxPhysXSystem->GetPhysXSDK()->createConvexMesh(input);
+	}
 
 	//Maintain a map of std::string id to std::vector<PxConvexMesh*> 
 	std::map<std::string, std::vector<PxConvexMesh*>>::iterator itr = g_PxPhysXSystem->m_collisionMeshRepository.find(id);
@@ -1331,6 +1369,28 @@ STATIC bool PhysXSystem::LoadCollisionMeshFromData(EventArgs& args)
 	return true;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+// Asset cooker side of the collision events: writes the PxCooking stream to args "cooked" and reports back in "succeeded"
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC bool PhysXSystem::CookCollisionMeshToFile(EventArgs& args)
+{
+	std::string cookedPath = "";
+	cookedPath = args.GetValue("cooked", cookedPath);
+
+	PxDefaultMemoryOutputStream stream;
+	if (cookedPath == "" || !CookCollisionMeshFromArgs(args, stream, false))
+	{
+		args.SetValue("succeeded", false);
+		return false;
+	}
+
+	Buffer cookedBuffer(stream.getData(), stream.getData() + stream.getSize());
+	bool succeeded = SaveBinaryFileFromBuffer(cookedPath, cookedBuffer);
+
+	args.SetValue("succeeded", succeeded);
+	return succeeded;
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 void PhysXSystem::AddVertMasterBufferToPxVecBuffer(PxVec3* convexVerts, const VertexMaster* vertices, int numVerts)
 {
@@ -24,6 +24,7 @@ class NamedProperties;
 struct Vec3;
 struct Vec4;
 struct Matrix44;
+struct Quaternion;
 
 typedef unsigned int uint;
 
@@ -112,16 +113,20 @@ public:
 	static Vec4			PxVectorToVec(const PxVec4& pxVector);
 	static PxVec3		VecToPxVector(const Vec3& vector);
 	static PxVec4		VecToPxVector(const Vec4& vector);
-	static Vec3			QuaternionToEulerAngles(const PxQuat& quat);
+	static Quaternion	PxQuatToQuaternion(const PxQuat& pxQuat);
+	static PxQuat		QuaternionToPxQuat(const Quaternion& quaternion);
+	static Vec3			QuaternionToEulerAngles(const PxQuat& quat);			// lossy near +-90 pitch, prefer staying in quaternions
 	static PxQuat		EulerAnglesToQuaternion(const Vec3& eulerAngles);
 	static PxQuat		MakeQuaternionFromMatrix(const Matrix44& matrix);
 	static float		GetRadiansPerSecondToRotationsPerMinute(float radiansPerSecond);
 
 	static Matrix44		MakeMatrixFromQuaternion(const PxQuat& quat, const PxVec3& position);
+	static void			MakeMatricesFromActors(Matrix44* outMatrices, PxRigidActor* const* actors, int numActors);
 	static PxQuat		MakeQuaternionFromVectors(const Vec3& vector1, const Vec3& vector2);
 	static PxQuat		MakeQuaternionFromPxVectors(const PxVec3& vector1, const PxVec3& vector2);
 
 	static bool			LoadCollisionMeshFromData(EventArgs& args);
+	static bool			CookCollisionMeshToFile(EventArgs& args);
 
 private:
 
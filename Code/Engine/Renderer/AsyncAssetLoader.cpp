@@ -0,0 +1,501 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/AsyncAssetLoader.hpp"
+//Engine Systems
+#include "Engine/Commons/StringUtils.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/Image.hpp"
+#include "Engine/Core/JobSystem/Job.hpp"
+#include "Engine/Core/JobSystem/JobSystem.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Vertex_Lit.hpp"
+#include "Engine/Renderer/CPUMesh.hpp"
+#include "Engine/Renderer/GPUMesh.hpp"
+#include "Engine/Renderer/ObjectLoader.hpp"
+#include "Engine/Renderer/RenderContext.hpp"
+#include "Engine/Renderer/Shader.hpp"
+#include "Engine/Renderer/Texture.hpp"
+#include <thread>
+
+//------------------------------------------------------------------------------------------------------------------------------
+// One job per queue entry. The job loads whichever request has the highest priority when it runs rather than the one
+// that queued it, so a request made later with a higher priority still goes first.
+//------------------------------------------------------------------------------------------------------------------------------
+class AssetLoadJob : public Job
+{
+public:
+	AssetLoadJob(AsyncAssetLoader* loader, std::atomic<int>* jobsRemaining)
+		: m_loader(loader),
+		m_jobsRemaining(jobsRemaining)
+	{
+		SetJobCategory(JOB_IO);
+	}
+
+	void Execute()
+	{
+		AssetRequest* request = m_loader->PopHighestPriorityRequest();
+		if (request != nullptr)
+		{
+			m_loader->LoadOnIOThread(request);
+		}
+
+		m_jobsRemaining->fetch_sub(1);
+	}
+
+private:
+	AsyncAssetLoader*		m_loader = nullptr;
+	std::atomic<int>*		m_jobsRemaining = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+static bool IsMeshFileDataDriven(const std::string& fileName)
+{
+	std::vector<std::string> strings = SplitStringOnDelimiter(fileName, '.');
+	return strings.size() > 1 && strings[strings.size() - 1] == "mesh";
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+AsyncAssetLoader::AsyncAssetLoader(RenderContext* renderContext)
+	: m_renderContext(renderContext)
+{
+	m_loadJobsRemaining = 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+AsyncAssetLoader::~AsyncAssetLoader()
+{
+	Reset();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+AssetHandle AsyncAssetLoader::RequestTextureView(const std::string& fileName, eAssetPriority priority /*= ASSET_PRIORITY_NORMAL*/)
+{
+	return Request(ASSET_TEXTURE, fileName, priority);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+AssetHandle AsyncAssetLoader::RequestMesh(const std::string& fileName, eAssetPriority priority /*= ASSET_PRIORITY_NORMAL*/)
+{
+	return Request(ASSET_MESH, fileName, priority);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+AssetHandle AsyncAssetLoader::RequestShader(const std::string& fileName, eAssetPriority priority /*= ASSET_PRIORITY_NORMAL*/)
+{
+	return Request(ASSET_SHADER, fileName, priority);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+AssetHandle AsyncAssetLoader::Request(eAssetType type, const std::string& fileName, eAssetPriority priority)
+{
+	std::map<std::string, AssetHandle>::iterator existing = m_handlesByName[type].find(fileName);
+	if (existing != m_handlesByName[type].end())
+	{
+		AssetRequest* request = m_requests[existing->second];
+
+		bool isBumped = false;
+		{
+			std::lock_guard<std::mutex> lock(m_pendingMutex);
+			if (request->m_state == ASSET_QUEUED && priority > request->m_priority)
+			{
+				//The old entry is skipped when it comes up, the request isn't queued anymore by then
+				request->m_priority = priority;
+				m_pendingQueue.push({ priority, m_nextSequence++, request });
+				isBumped = true;
+			}
+		}
+
+		if (isBumped)
+		{
+			m_loadJobsRemaining++;
+			JobSystem::GetInstance()->Run(new AssetLoadJob(this, &m_loadJobsRemaining));
+		}
+
+		return request->m_handle;
+	}
+
+	AssetRequest* request = new AssetRequest();
+	request->m_handle = m_nextHandle++;
+	request->m_type = type;
+	request->m_fileName = fileName;
+	request->m_priority = priority;
+
+	m_requests[request->m_handle] = request;
+	m_handlesByName[type][fileName] = request->m_handle;
+
+	//Already loaded through the RenderContext, nothing to stream
+	if (FindLoadedAsset(request))
+	{
+		request->m_state = ASSET_READY;
+		return request->m_handle;
+	}
+
+	m_numPendingRequests++;
+
+	{
+		std::lock_guard<std::mutex> lock(m_pendingMutex);
+		m_pendingQueue.push({ priority, m_nextSequence++, request });
+	}
+
+	m_loadJobsRemaining++;
+	JobSystem::GetInstance()->Run(new AssetLoadJob(this, &m_loadJobsRemaining));
+
+	return request->m_handle;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+AssetRequest* AsyncAssetLoader::FindRequest(AssetHandle handle) const
+{
+	std::map<AssetHandle, AssetRequest*>::const_iterator request = m_requests.find(handle);
+	if (request == m_requests.end())
+	{
+		return nullptr;
+	}
+
+	return request->second;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Fills in the result if the RenderContext already has the asset, sync loads of the same file may have beaten us to it
+//------------------------------------------------------------------------------------------------------------------------------
+bool AsyncAssetLoader::FindLoadedAsset(AssetRequest* request) const
+{
+	switch (request->m_type)
+	{
+	case ASSET_TEXTURE:
+	{
+		std::map<std::string, TextureView*>::const_iterator item = m_renderContext->m_cachedTextureViews.find(request->m_fileName);
+		if (item != m_renderContext->m_cachedTextureViews.end() && item->second != nullptr)
+		{
+			request->m_textureView = item->second;
+			return true;
+		}
+	}
+	break;
+	case ASSET_MESH:
+	{
+		std::map<std::string, GPUMesh*>::const_iterator item = m_renderContext->m_modelDatabase.find(MODEL_PATH + request->m_fileName);
+		if (item != m_renderContext->m_modelDatabase.end() && item->second != nullptr)
+		{
+			request->m_mesh = item->second;
+			return true;
+		}
+	}
+	break;
+	case ASSET_SHADER:
+	{
+		std::map<std::string, Shader*>::const_iterator item = m_renderContext->m_loadedShaders.find(SHADER_PATH + request->m_fileName);
+		if (item != m_renderContext->m_loadedShaders.end() && item->second != nullptr)
+		{
+			request->m_shader = item->second;
+			return true;
+		}
+	}
+	break;
+	default:
+	break;
+	}
+
+	return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+eAssetState AsyncAssetLoader::GetState(AssetHandle handle) const
+{
+	AssetRequest* request = FindRequest(handle);
+	if (request == nullptr)
+	{
+		return ASSET_FAILED;
+	}
+
+	return (eAssetState)request->m_state.load();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+TextureView* AsyncAssetLoader::GetTextureView(AssetHandle handle)
+{
+	AssetRequest* request = FindRequest(handle);
+	if (request != nullptr && request->m_state == ASSET_READY)
+	{
+		return request->m_textureView;
+	}
+
+	return m_renderContext->m_prodigyDefaultTextures[WHITE];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+GPUMesh* AsyncAssetLoader::GetMesh(AssetHandle handle)
+{
+	AssetRequest* request = FindRequest(handle);
+	if (request != nullptr && request->m_state == ASSET_READY)
+	{
+		return request->m_mesh;
+	}
+
+	//Unit cube, made the first time something has to stand in for a mesh
+	if (m_placeholderMesh == nullptr)
+	{
+		CPUMesh placeholder;
+		CPUMeshAddCube(&placeholder, AABB3(Vec3(-0.5f, -0.5f, -0.5f), Vec3(0.5f, 0.5f, 0.5f)));
+
+		m_placeholderMesh = new GPUMesh(m_renderContext);
+		m_placeholderMesh->CreateFromCPUMesh<Vertex_Lit>(&placeholder);
+	}
+
+	return m_placeholderMesh;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Shader* AsyncAssetLoader::GetShader(AssetHandle handle)
+{
+	AssetRequest* request = FindRequest(handle);
+	if (request != nullptr && request->m_state == ASSET_READY)
+	{
+		return request->m_shader;
+	}
+
+	return m_renderContext->CreateOrGetShaderFromFile(ASSET_PLACEHOLDER_SHADER);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+AssetRequest* AsyncAssetLoader::PopHighestPriorityRequest()
+{
+	std::lock_guard<std::mutex> lock(m_pendingMutex);
+
+	while (!m_pendingQueue.empty())
+	{
+		AssetRequest* request = m_pendingQueue.top().m_request;
+		m_pendingQueue.pop();
+
+		//Entries left behind by a priority bump
+		if (request->m_state == ASSET_QUEUED)
+		{
+			request->m_state = ASSET_LOADING;
+			return request;
+		}
+	}
+
+	return nullptr;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Everything that doesn't need the device. Failures leave the payload empty and the main thread marks them failed.
+//------------------------------------------------------------------------------------------------------------------------------
+void AsyncAssetLoader::LoadOnIOThread(AssetRequest* request)
+{
+	switch (request->m_type)
+	{
+	case ASSET_TEXTURE:
+	{
+		std::string path = Texture2D::GetPathForTextureFile(request->m_fileName);
+
+		Image* image = new Image(path.c_str());
+		if (image->GetImageDimensions() == IntVec2::ZERO)
+		{
+			DebuggerPrintf("\n Streaming failed for texture %s", path.c_str());
+			delete image;
+			image = nullptr;
+		}
+
+		request->m_image = image;
+	}
+	break;
+	case ASSET_MESH:
+	{
+		std::string path = MODEL_PATH + request->m_fileName;
+		if (!DoesFileExist(path))
+		{
+			DebuggerPrintf("\n Streaming failed for mesh %s", path.c_str());
+			break;
+		}
+
+		//No render context, so the GPUMesh and collision events wait for the finalize
+		ObjectLoader* loader = new ObjectLoader();
+		loader->LoadMeshDataFromFile(path, IsMeshFileDataDriven(request->m_fileName));
+
+		//Otherwise the destructor writes the cooked file on the main thread
+		loader->MakeCookedVersion();
+
+		request->m_meshLoader = loader;
+	}
+	break;
+	case ASSET_SHADER:
+	{
+		Shader* shader = new Shader();
+		if (!shader->CompileFromFile(SHADER_PATH + request->m_fileName))
+		{
+			DebuggerPrintf("\n Streaming failed for shader %s", request->m_fileName.c_str());
+			delete shader;
+			shader = nullptr;
+		}
+
+		request->m_shader = shader;
+	}
+	break;
+	default:
+	break;
+	}
+
+	m_finishedQueue.EnqueueLocked(request);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void AsyncAssetLoader::ProcessFinishedLoads(double budgetMS /*= ASSET_FINALIZE_BUDGET_MS*/)
+{
+	double startMS = GetCurrentTimeSeconds() * 1000.0;
+
+	//At least one per call so a tiny budget can't starve the queue
+	AssetRequest* request = nullptr;
+	while (m_finishedQueue.DequeueLocked(&request))
+	{
+		FinalizeOnMainThread(request);
+
+		if (GetCurrentTimeSeconds() * 1000.0 - startMS >= budgetMS)
+		{
+			break;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void AsyncAssetLoader::FinalizeOnMainThread(AssetRequest* request)
+{
+	Image* image = request->m_image;
+	ObjectLoader* meshLoader = request->m_meshLoader;
+	Shader* shader = request->m_shader;
+
+	request->m_image = nullptr;
+	request->m_meshLoader = nullptr;
+	request->m_shader = nullptr;
+
+	//A sync load may have finished the same file while we were reading it
+	if (FindLoadedAsset(request))
+	{
+		delete image;
+		delete meshLoader;
+		delete shader;
+
+		request->m_state = ASSET_READY;
+		m_numPendingRequests--;
+		return;
+	}
+
+	switch (request->m_type)
+	{
+	case ASSET_TEXTURE:
+	{
+		if (image != nullptr)
+		{
+			request->m_textureView = m_renderContext->CreateTextureViewFromImage(request->m_fileName, *image);
+			delete image;
+		}
+	}
+	break;
+	case ASSET_MESH:
+	{
+		if (meshLoader != nullptr && meshLoader->m_cpuMesh != nullptr)
+		{
+			meshLoader->m_renderContext = m_renderContext;
+			meshLoader->FinishLoadOnMainThread();
+
+			request->m_mesh = m_renderContext->AddLoadedMeshToDatabase(request->m_fileName, meshLoader);
+		}
+
+		delete meshLoader;
+	}
+	break;
+	case ASSET_SHADER:
+	{
+		if (shader != nullptr)
+		{
+			shader->CreateStagesFromByteCode(m_renderContext);
+			m_renderContext->m_loadedShaders[SHADER_PATH + request->m_fileName] = shader;
+			request->m_shader = shader;
+		}
+	}
+	break;
+	default:
+	break;
+	}
+
+	bool loaded = request->m_textureView != nullptr || request->m_mesh != nullptr || request->m_shader != nullptr;
+	request->m_state = loaded ? ASSET_READY : ASSET_FAILED;
+	m_numPendingRequests--;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void AsyncAssetLoader::FinishAllLoads()
+{
+	JobSystem* jobSystem = JobSystem::GetInstance();
+
+	while (m_numPendingRequests > 0)
+	{
+		//Help the I/O thread instead of just waiting on it
+		if (!jobSystem->ProcessCategory(JOB_IO))
+		{
+			std::this_thread::yield();
+		}
+
+		ProcessFinishedLoads(0.0);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void AsyncAssetLoader::WaitForLoadJobs()
+{
+	if (m_loadJobsRemaining.load() == 0)
+	{
+		return;
+	}
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	while (m_loadJobsRemaining.load() > 0)
+	{
+		if (!jobSystem->ProcessCategory(JOB_IO))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void AsyncAssetLoader::Reset()
+{
+	//Nothing new gets picked up, then wait for what's already reading
+	{
+		std::lock_guard<std::mutex> lock(m_pendingMutex);
+		while (!m_pendingQueue.empty())
+		{
+			m_pendingQueue.pop();
+		}
+	}
+
+	WaitForLoadJobs();
+
+	//Loaded but never handed to the RenderContext
+	AssetRequest* request = nullptr;
+	while (m_finishedQueue.DequeueLocked(&request))
+	{
+		delete request->m_image;
+		delete request->m_meshLoader;
+		delete request->m_shader;
+	}
+
+	std::map<AssetHandle, AssetRequest*>::iterator requestIterator = m_requests.begin();
+	while (requestIterator != m_requests.end())
+	{
+		delete requestIterator->second;
+		requestIterator++;
+	}
+
+	m_requests.clear();
+	for (int typeIndex = 0; typeIndex < NUM_ASSET_TYPES; typeIndex++)
+	{
+		m_handlesByName[typeIndex].clear();
+	}
+
+	m_numPendingRequests = 0;
+
+	delete m_placeholderMesh;
+	m_placeholderMesh = nullptr;
+}
@@ -0,0 +1,153 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+//Engine Systems
+#include "Engine/Commons/EngineCommon.hpp"
+#include "Engine/Core/Async/AsyncQueue.hpp"
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <string>
+
+class AssetLoadJob;
+class GPUMesh;
+class Image;
+class ObjectLoader;
+class RenderContext;
+class Shader;
+class TextureView;
+
+//------------------------------------------------------------------------------------------------------------------------------
+typedef uint AssetHandle;
+
+constexpr AssetHandle	INVALID_ASSET_HANDLE = 0U;
+constexpr double		ASSET_FINALIZE_BUDGET_MS = 2.0;						// device work per frame for loads that finished reading
+constexpr char			ASSET_PLACEHOLDER_SHADER[] = "default_unlit.xml";
+
+//------------------------------------------------------------------------------------------------------------------------------
+enum eAssetType
+{
+	ASSET_TEXTURE = 0,
+	ASSET_MESH,
+	ASSET_SHADER,
+
+	NUM_ASSET_TYPES
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+enum eAssetState
+{
+	ASSET_QUEUED = 0,		// waiting for the I/O thread
+	ASSET_LOADING,			// being read and decoded, or waiting for the main thread to create its device objects
+	ASSET_READY,
+	ASSET_FAILED			// the placeholder is used for good
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+enum eAssetPriority
+{
+	ASSET_PRIORITY_LOW = 0,			// not visible yet
+	ASSET_PRIORITY_NORMAL,
+	ASSET_PRIORITY_HIGH,
+	ASSET_PRIORITY_CRITICAL			// on screen right now
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct AssetRequest
+{
+	AssetHandle				m_handle = INVALID_ASSET_HANDLE;
+	eAssetType				m_type = ASSET_TEXTURE;
+	std::string				m_fileName = "";				// the same name the RenderContext CreateOrGet functions take
+	int						m_priority = ASSET_PRIORITY_NORMAL;
+	std::atomic<int>		m_state = ASSET_QUEUED;
+
+	//Filled on the I/O thread
+	Image*					m_image = nullptr;
+	ObjectLoader*			m_meshLoader = nullptr;
+
+	//Owned by the RenderContext databases once ready (m_shader is ours until then)
+	TextureView*			m_textureView = nullptr;
+	GPUMesh*				m_mesh = nullptr;
+	Shader*					m_shader = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct AssetQueueEntry
+{
+	int						m_priority = ASSET_PRIORITY_NORMAL;
+	uint					m_sequence = 0U;				// requests of equal priority load in the order they were made
+	AssetRequest*			m_request = nullptr;
+
+	bool operator<(const AssetQueueEntry& other) const
+	{
+		if (m_priority != other.m_priority)
+		{
+			return m_priority < other.m_priority;
+		}
+
+		return m_sequence > other.m_sequence;
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Streams textures, meshes and shaders without stalling the frame. A request returns a handle right away; file reads,
+// decodes, mesh parsing and shader compiles run on the JobSystem's I/O thread in priority order, and the device objects
+// are made on the main thread in ProcessFinishedLoads, a few per frame. Until an asset is ready its Get function returns
+// a placeholder. Finished assets go into the same databases the RenderContext CreateOrGet functions use, so sync and
+// async loads of the same file share one copy.
+//------------------------------------------------------------------------------------------------------------------------------
+class AsyncAssetLoader
+{
+	friend class AssetLoadJob;
+
+public:
+	explicit AsyncAssetLoader(RenderContext* renderContext);
+	~AsyncAssetLoader();
+
+	//Requesting a file again returns the same handle and can only raise its priority
+	AssetHandle				RequestTextureView(const std::string& fileName, eAssetPriority priority = ASSET_PRIORITY_NORMAL);
+	AssetHandle				RequestMesh(const std::string& fileName, eAssetPriority priority = ASSET_PRIORITY_NORMAL);
+	AssetHandle				RequestShader(const std::string& fileName, eAssetPriority priority = ASSET_PRIORITY_NORMAL);
+
+	eAssetState				GetState(AssetHandle handle) const;		// unknown handles are ASSET_FAILED
+	inline bool				IsReady(AssetHandle handle) const		{ return GetState(handle) == ASSET_READY; }
+	inline int				GetNumPendingRequests() const			{ return m_numPendingRequests; }
+
+	TextureView*			GetTextureView(AssetHandle handle);
+	GPUMesh*				GetMesh(AssetHandle handle);
+	Shader*					GetShader(AssetHandle handle);
+
+	//Main thread only
+	void					ProcessFinishedLoads(double budgetMS = ASSET_FINALIZE_BUDGET_MS);
+	void					FinishAllLoads();		// blocks until nothing is pending, for loading screens
+	void					Reset();				// handles become invalid, RenderContext calls this before clearing its databases
+
+private:
+	AssetHandle				Request(eAssetType type, const std::string& fileName, eAssetPriority priority);
+	AssetRequest*			FindRequest(AssetHandle handle) const;
+	bool					FindLoadedAsset(AssetRequest* request) const;
+
+	//I/O thread
+	AssetRequest*			PopHighestPriorityRequest();
+	void					LoadOnIOThread(AssetRequest* request);
+
+	void					FinalizeOnMainThread(AssetRequest* request);
+	void					WaitForLoadJobs();
+
+private:
+	RenderContext*							m_renderContext = nullptr;
+
+	//Main thread only
+	std::map<AssetHandle, AssetRequest*>	m_requests;
+	std::map<std::string, AssetHandle>		m_handlesByName[NUM_ASSET_TYPES];
+	AssetHandle								m_nextHandle = 1U;
+	int										m_numPendingRequests = 0;
+	GPUMesh*								m_placeholderMesh = nullptr;
+
+	//Shared with the I/O thread
+	std::priority_queue<AssetQueueEntry>	m_pendingQueue;
+	std::mutex								m_pendingMutex;
+	uint									m_nextSequence = 0U;
+	AsyncQueue<AssetRequest*>				m_finishedQueue;
+	std::atomic<int>						m_loadJobsRemaining;
+};
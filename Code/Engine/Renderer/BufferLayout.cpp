@@ -36,6 +36,11 @@ const BufferLayout* BufferLayout::For( BufferAttributeT const *attributeList, si
 	while(!attributeList[i].IsNull())
 	{
 		bufferLayout->m_attributes.push_back(attributeList[i]);
+
+		if (attributeList[i].m_name == "POSITION" && attributeList[i].m_type == DF_UNORM16_4)
+		{
+			bufferLayout->m_hasQuantizedPosition = true;
+		}
 		i++;
 	}
 	
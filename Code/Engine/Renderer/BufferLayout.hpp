@@ -30,11 +30,14 @@ public:
 
 	inline uint GetAttributeCount() const		{ return static_cast<uint>(m_attributes.size()); }
 	inline uint GetStride() const				{ return m_stride; }
+	inline bool HasQuantizedPosition() const	{ return m_hasQuantizedPosition; }
 
 public:
 	std::vector<BufferAttributeT> m_attributes;   // what is in this buffer and how does it bind
 	uint m_stride;                                  // how large is a single element
 	CopyFromMasterCallback m_copyFromMaster;        // how do we copy master to this format?
+	bool m_hasQuantizedPosition = false;            // POSITION needs the mesh's offset and scale to decode
+	bool m_matchesMaster = false;                   // laid out byte for byte like VertexMaster, uploads need no copy
 
 	
 	// This static function is called by the template to create a BufferLayout for any type of Vertex that is passed to it
@@ -5,6 +5,7 @@
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/OBB2.hpp"
 #include "Engine/Renderer/CPUMesh.hpp"
+#include "Engine/Renderer/TangentGenerator.hpp"
 
 //------------------------------------------------------------------------------------------------------------------------------
 CPUMesh::CPUMesh()
@@ -270,8 +271,8 @@ void CPUMeshAddUVSphere( CPUMesh *out, const Vec3& center, float radius, const R
 			Vec3 norm = position - center;
 			norm = norm.GetNormalized();
 
-			//Get the tangent and bi tangent to the vertex
-			Vec3 tangent = Vec3( -1.f * CosDegrees(phi) * SinDegrees(theta), 0.f, CosDegrees(phi) * CosDegrees(theta));
+			//Tangent is d(position)/du divided by |cos(phi)|, so it stays unit length and is defined at the poles too
+			Vec3 tangent = Vec3( SinDegrees(theta), 0.f, -1.f * CosDegrees(theta));
 			Vec3 biTangent = GetCrossProduct(tangent, norm);
 
 			out->SetUV(Vec2(u,v));
@@ -337,8 +338,8 @@ void CPUMeshAddUVCapsule(CPUMesh *out, const Vec3& start, const Vec3& end, float
 			Vec3 norm = position - center;
 			norm = norm.GetNormalized();
 
-			//Get the tangent and bi tangent to the vertex
-			Vec3 tangent = Vec3(-1.f * CosDegrees(phi) * SinDegrees(theta), 0.f, CosDegrees(phi) * CosDegrees(theta));
+			//Tangent is d(position)/du divided by |cos(phi)|, so it stays unit length and is defined at the poles too
+			Vec3 tangent = Vec3(SinDegrees(theta), 0.f, -1.f * CosDegrees(theta));
 			Vec3 biTangent = GetCrossProduct(tangent, norm);
 
 			out->SetUV(Vec2(u, v));
@@ -364,6 +365,115 @@ void CPUMeshAddUVCapsule(CPUMesh *out, const Vec3& start, const Vec3& end, float
 
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+// Same rows as the top half of CPUMeshAddUVSphere, v runs from the pole to the equator
+//------------------------------------------------------------------------------------------------------------------------------
+void CPUMeshAddUVHemisphere( CPUMesh *out, const Vec3& center, float radius, const Rgba& color, uint wedges /*= 32*/, uint slices /*= 8 */ )
+{
+	int lastIndex = out->GetVertexCount();
+
+	out->SetStampColor( color ); 
+
+	int ustep = wedges + 1;
+	int vstep = slices + 1;
+
+	float phi;			//Angle along the j,k plane
+	float theta;		//Angle along the i,k plane
+
+	//Map out all the vertices
+	for(int vIndex = 0; vIndex < vstep; vIndex++)
+	{
+		float v = static_cast<float>(vIndex) / static_cast<float>(slices);
+		phi = RangeMapFloat(v, 0.f, 1.f, 90.f, 180.f);
+
+		for(int uIndex = 0; uIndex < ustep; uIndex++)
+		{
+			float u = static_cast<float>(uIndex) / static_cast<float>(wedges);
+			theta = u * 360.f;
+			Vec3 position = GetSphericalToCartesian(radius, theta, phi) + center;
+
+			//Get the normal to the vertex
+			Vec3 norm = position - center;
+			norm = norm.GetNormalized();
+
+			Vec3 tangent = Vec3( SinDegrees(theta), 0.f, -1.f * CosDegrees(theta));
+			Vec3 biTangent = GetCrossProduct(tangent, norm);
+
+			out->SetUV(Vec2(u,v));
+			out->SetNormal(norm);
+			out->SetTangent(tangent);
+			out->SetBiTangent(biTangent);
+			out->AddVertex(position);
+		}
+	}
+
+	//Map out all the Indices
+	for(int y = 0; y < static_cast<int>(slices); y++)
+	{
+		for(int x = 0; x < static_cast<int>(wedges); x++)
+		{
+			uint TL = y * ustep + x;
+			uint TR = TL + 1;
+			uint BL = TL + ustep;
+			uint BR = BL + 1;
+			out->AddIndexedQuad(TL + lastIndex, TR + lastIndex, BL + lastIndex, BR + lastIndex);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The band CPUMeshAddUVCapsule puts between its two halves, top row first so it winds like the sphere
+//------------------------------------------------------------------------------------------------------------------------------
+void CPUMeshAddUVCylinder( CPUMesh *out, const Vec3& bottom, float height, float radius, const Rgba& color, uint wedges /*= 32 */ )
+{
+	int lastIndex = out->GetVertexCount();
+
+	out->SetStampColor( color ); 
+
+	int ustep = wedges + 1;
+
+	for(int vIndex = 0; vIndex < 2; vIndex++)
+	{
+		Vec3 center = bottom + Vec3(0.f, (vIndex == 0) ? height : 0.f, 0.f);
+
+		for(int uIndex = 0; uIndex < ustep; uIndex++)
+		{
+			float u = static_cast<float>(uIndex) / static_cast<float>(wedges);
+			float theta = u * 360.f;
+			Vec3 norm = GetSphericalToCartesian(1.f, theta, 180.f);
+
+			Vec3 tangent = Vec3( SinDegrees(theta), 0.f, -1.f * CosDegrees(theta));
+			Vec3 biTangent = GetCrossProduct(tangent, norm);
+
+			out->SetUV(Vec2(u, static_cast<float>(vIndex)));
+			out->SetNormal(norm);
+			out->SetTangent(tangent);
+			out->SetBiTangent(biTangent);
+			out->AddVertex(center + norm * radius);
+		}
+	}
+
+	for(int x = 0; x < static_cast<int>(wedges); x++)
+	{
+		uint TL = x;
+		uint TR = TL + 1;
+		uint BL = TL + ustep;
+		uint BR = BL + 1;
+		out->AddIndexedQuad(TL + lastIndex, TR + lastIndex, BL + lastIndex, BR + lastIndex);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CPUMeshGenerateTangents( CPUMesh *out, uint firstIndex /*= 0*/ )
+{
+	if (firstIndex >= out->GetIndexCount())
+	{
+		return;
+	}
+
+	GenerateFastTangents(out->GetVerticesEditable(), out->GetVertexCount(), out->GetIndices() + firstIndex, out->GetIndexCount() - firstIndex);
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 void CPUMesh::AddIndexedTriangle( uint i0, uint i1, uint i2 )
 {
@@ -389,11 +499,38 @@ uint CPUMesh::GetVertexCount() const
 	return static_cast<int>(m_vertices.size());
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+bool CPUMesh::GetBounds( Vec3* outMins, Vec3* outMaxs ) const
+{
+	if (m_vertices.empty())
+	{
+		*outMins = Vec3::ZERO;
+		*outMaxs = Vec3::ZERO;
+		return false;
+	}
+
+	Vec3 mins = m_vertices[0].m_position;
+	Vec3 maxs = m_vertices[0].m_position;
+
+	int numVertices = static_cast<int>(m_vertices.size());
+	for (int vertexIndex = 1; vertexIndex < numVertices; vertexIndex++)
+	{
+		mins = Vec3::GetComponentMin(mins, m_vertices[vertexIndex].m_position);
+		maxs = Vec3::GetComponentMax(maxs, m_vertices[vertexIndex].m_position);
+	}
+
+	*outMins = mins;
+	*outMaxs = maxs;
+	return true;
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 void CPUMesh::Clear()
 {
 	m_vertices.clear();
 	m_indices.clear();
+	m_lodIndices.clear();
+	m_lods.clear();
 
 	m_stamp.m_position = Vec3::ZERO;
 	m_stamp.m_color = Rgba::WHITE;
@@ -523,17 +660,44 @@ void CPUMesh::AddIndex( uint index )
 	m_indices.push_back(index);
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+void CPUMesh::AddVertices( const VertexMaster* vertices, uint count )
+{
+	m_vertices.insert(m_vertices.end(), vertices, vertices + count);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CPUMesh::AddIndices( const uint* indices, uint count )
+{
+	m_indices.insert(m_indices.end(), indices, indices + count);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void CPUMesh::SetLODs( const uint* lodIndices, uint numLODIndices, const MeshLOD* lods, uint numLODs )
+{
+	m_lodIndices.assign(lodIndices, lodIndices + numLODIndices);
+	m_lods.assign(lods, lods + numLODs);
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 uint* CPUMesh::GetIndicesEditable()
 {
 	return &m_indices[0];
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+VertexMaster* CPUMesh::GetVerticesEditable()
+{
+	return m_vertices.data();
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 void CPUMesh::TransformVerticesInRange(int startIndex, int endIndex, const Matrix44& transform)
 {
-	for (int index = startIndex; index < endIndex; index++)
+	if (endIndex <= startIndex)
 	{
-		m_vertices[index].m_position = transform.TransformPosition3D(m_vertices[index].m_position);
+		return;
 	}
+
+	transform.TransformVertices(&m_vertices[startIndex], endIndex - startIndex, false);
 }
@@ -4,6 +4,7 @@
 #include "Engine/Math/Vec3.hpp"
 #include "Engine/Math/VertexMaster.hpp"
 #include "Engine/Renderer/BufferLayout.hpp"
+#include "Engine/Renderer/MeshSimplifier.hpp"
 #include "Engine/Renderer/Rgba.hpp"
 #include <vector>
 
@@ -49,12 +50,17 @@ public:
 	VertexMaster const*			GetVertices() const;     
 	uint const*					GetIndices() const;
 	uint*						GetIndicesEditable();
+	VertexMaster*				GetVerticesEditable();
 
 	// Stamp a vertex into the list - return the index; 
 	uint						AddVertex( const VertexMaster& m );     
 	uint						AddVertex( const Vec3& pos );           
 	
 	void						AddIndex( uint index);
+
+	// Bulk versions, appended as is (cooked meshes)
+	void						AddVertices( const VertexMaster* vertices, uint count );
+	void						AddIndices( const uint* indices, uint count );
 	// Adds a single triangle; 
 	void						AddIndexedTriangle( uint i0, uint i1, uint i2 );
 	// adds two triangles (bl, tr, tl) and (bl, br, tr)
@@ -62,9 +68,17 @@ public:
 	
 	void						TransformVerticesInRange(int startIndex, int endIndex, const Matrix44& transform);
 
+	// LOD1 and down (see GenerateLODChain), using the same vertices. The regular indices stay LOD0.
+	void						SetLODs( const uint* lodIndices, uint numLODIndices, const MeshLOD* lods, uint numLODs );
+	inline uint					GetLODCount() const			{ return static_cast<uint>(m_lods.size()); }
+	inline const MeshLOD*		GetLODs() const				{ return m_lods.data(); }
+	inline const uint*			GetLODIndices() const		{ return m_lodIndices.data(); }
+	inline uint					GetLODIndexCount() const	{ return static_cast<uint>(m_lodIndices.size()); }
+
 	// Helpers
 	uint		GetVertexCount() const;                 
 	uint		GetIndexCount() const;                  
+	bool		GetBounds(Vec3* outMins, Vec3* outMaxs) const;	// false (and zero bounds) for an empty mesh
 
 	inline bool UsesIndexBuffer() const          { return GetIndexCount() > 0; }
 	inline uint GetElementCount() const          { return UsesIndexBuffer() ? GetIndexCount() : GetVertexCount(); }
@@ -72,6 +86,8 @@ public:
 private:
 	std::vector<VertexMaster>  m_vertices;       
 	std::vector<uint>          m_indices;        
+	std::vector<uint>          m_lodIndices;
+	std::vector<MeshLOD>       m_lods;
 
 	VertexMaster m_stamp;                        
 	const BufferLayout* m_layout;                
@@ -87,5 +103,11 @@ void			CPUMeshAddQuad( CPUMesh *out, const AABB2& quad, const Rgba& color = Rgba
 void			CPUMeshAddCube( CPUMesh *out, const AABB3& box, const Rgba& color = Rgba::WHITE);
 void			CPUMeshAddUVSphere( CPUMesh *out, const Vec3& center, float radius, const Rgba& color = Rgba::WHITE, uint wedges = 32, uint slices = 16 );							
 void			CPUMeshAddUVCapsule(CPUMesh *out, const Vec3& start, const Vec3& end, float radius, const Rgba& color, uint wedges = 32, uint slices = 16);
+void			CPUMeshAddUVHemisphere( CPUMesh *out, const Vec3& center, float radius, const Rgba& color = Rgba::WHITE, uint wedges = 32, uint slices = 8 );	// the +Y half
+void			CPUMeshAddUVCylinder( CPUMesh *out, const Vec3& bottom, float height, float radius, const Rgba& color = Rgba::WHITE, uint wedges = 32 );		// open ended, along +Y
 void			CPUMeshAddBox2D( CPUMesh *out, const OBB2& obb, Rgba const &color = Rgba::WHITE);
 
+// Fast approximate tangents (see GenerateFastTangents) for the triangles from firstIndex on, for procedural meshes that
+// don't set their own. Imported meshes get MikkTSpace instead.
+void			CPUMeshGenerateTangents( CPUMesh *out, uint firstIndex = 0 );
+
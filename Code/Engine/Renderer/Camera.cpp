@@ -9,6 +9,7 @@
 #include "Engine/Math/Frustum.hpp"
 #include "Engine/Math/IntVec2.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Quaternion.hpp"
 #include "Engine/Math/Ray3D.hpp"
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -130,6 +131,12 @@ void Camera::SetModelMatrix( Matrix44 camModel )
 	m_view = Matrix44::InvertOrthoNormal(m_cameraModel);
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+void Camera::SetTransform( const Vec3& position, const Quaternion& orientation )
+{
+	SetModelMatrix(orientation.GetMatrix(position));
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 const Matrix44& Camera::GetModelMatrix() const
 {
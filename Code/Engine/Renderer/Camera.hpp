@@ -13,6 +13,7 @@ class UniformBuffer;
 struct AABB2;
 struct Frustum;
 struct IntVec2;
+struct Quaternion;
 struct Ray3D;
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -47,6 +48,7 @@ public:
 
 	//Transforms and Matrices
 	void					SetModelMatrix(Matrix44 camModel);
+	void					SetTransform(const Vec3& position, const Quaternion& orientation);	//skips the Euler round trip
 	const Matrix44&			GetModelMatrix() const;
 	const Matrix44&			GetViewMatrix() const;
 	const Matrix44&			GetProjectionMatrix() const;
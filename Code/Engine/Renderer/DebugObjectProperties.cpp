@@ -77,17 +77,6 @@ Point3DProperties::Point3DProperties( eDebugRenderObject renderObject, const Vec
 	m_texture = texture;
 	m_position = position;
 	m_size = size;
-
-	Vec2 right = Vec2(1.f, 0.f);
-	Vec2 up = Vec2(0.f, 1.f);
-
-	Vec3 mins = Vec3(-m_size * 0.5f, -m_size * 0.5f, 0.f);
-	Vec3 maxs = Vec3(m_size * 0.5f, m_size * 0.5f, 0.f);
-
-	m_point = AABB2(mins, maxs);
-	m_mesh = new CPUMesh();
-	m_mesh->Clear();
-	CPUMeshAddQuad(m_mesh, m_point);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -95,9 +84,6 @@ Point3DProperties::~Point3DProperties()
 {
 	delete m_texture;
 	m_texture = nullptr;
-
-	delete m_mesh;
-	m_mesh = nullptr;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -131,31 +117,12 @@ Line3DProperties::Line3DProperties( eDebugRenderObject renderObject, const Vec3&
 	m_startPos = startPos;
 	m_endPos = endPos;
 	m_lineWidth = lineWidth;
-
-	
-	Vec3 disp = m_startPos - m_endPos;
-	float length = disp.GetLength();
-	Vec3 norm = disp.GetNormalized();
-	//Vec2 tangentXZ = Vec2(norm.x, norm.y).GetRotated90Degrees();
-	//Vec3 tangent = Vec3(tangentXZ.x, 0.f, tangentXZ.y).GetNormalized();
-	Vec3 center = m_endPos + norm * length * 0.5f;
-
-	Vec3 mins = Vec3(m_startPos.x, m_startPos.y - (Vec2(0.f, 1.f) * lineWidth * 0.5f).y, m_startPos.z);
-	Vec3 maxs = Vec3(m_endPos.x, m_endPos.y + (Vec2(0.f, 1.f) * lineWidth * 0.5f).y, m_endPos.z);
-
-	m_line = AABB2(mins, maxs);
-	m_center = center;
-	
-	m_mesh = new CPUMesh();
-	m_mesh->Clear();
-	CPUMeshAddQuad(m_mesh, m_line);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
 Line3DProperties::~Line3DProperties()
 {
-	delete m_mesh;
-	m_mesh = nullptr;
+
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -170,17 +137,12 @@ SphereProperties::SphereProperties( eDebugRenderObject renderObject, const Vec3&
 	m_center = center;
 	m_radius = radius;
 	m_texture = texture;
-
-	m_mesh = new CPUMesh();
-	m_mesh->Clear();
-	CPUMeshAddUVSphere( m_mesh, center, radius);  
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
 SphereProperties::~SphereProperties()
 {
-	delete m_mesh;
-	m_mesh = nullptr;
+
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -195,17 +157,12 @@ BoxProperties::BoxProperties( eDebugRenderObject renderObject, const AABB3& box,
 	m_box = box;
 	m_texture = texture;
 	m_position = position;
-
-	m_mesh = new CPUMesh();
-	m_mesh->Clear();
-	CPUMeshAddCube( m_mesh, box);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
 BoxProperties::~BoxProperties()
 {
-	delete m_mesh;
-	m_mesh = nullptr;
+
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -222,16 +179,12 @@ Quad3DProperties::Quad3DProperties( eDebugRenderObject renderObject, const AABB2
 	m_billBoarded = billBoarded;
 
 	m_quad = quad;
-	m_mesh = new CPUMesh();
-	m_mesh->Clear();
-	CPUMeshAddQuad(m_mesh, m_quad);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
 Quad3DProperties::~Quad3DProperties()
 {
-	delete m_mesh;
-	m_mesh = nullptr;
+
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -335,15 +288,10 @@ CapsuleProperties::CapsuleProperties(eDebugRenderObject renderObject, const Caps
 	m_position = position;
 	m_capsule = capsule;
 	m_texture = texture;
-
-	m_mesh = new CPUMesh();
-	m_mesh->Clear();
-	CPUMeshAddUVCapsule(m_mesh, capsule.m_start, capsule.m_end, capsule.m_radius, Rgba::WHITE);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
 CapsuleProperties::~CapsuleProperties()
 {
-	delete m_mesh;
-	m_mesh = nullptr;
+
 }
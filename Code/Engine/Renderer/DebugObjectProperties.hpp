@@ -58,8 +58,6 @@ public:
 	float m_durationSeconds         = 0.0f;  // show for a single frame
 	float m_startDuration			= 0.f;
 	Rgba m_currentColor				= Rgba::WHITE;
-
-	CPUMesh* m_mesh;
 };
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -162,8 +160,6 @@ public:
 	Vec3 m_position						= Vec3::ZERO;
 	TextureView* m_texture				= nullptr;
 	float m_size						= DEFAULT_POINT_SIZE_3D;
-	
-	AABB2 m_point;
 };
 
 // Line
@@ -178,10 +174,7 @@ public:
 public:
 	Vec3 m_startPos						= Vec3::ZERO;
 	Vec3 m_endPos						= Vec3::ZERO;
-	Vec3 m_center						= Vec3::ZERO;
 	float m_lineWidth					= DEFAULT_LINE_WIDTH;
-
-	AABB2 m_line;
 };
 
 // Quad
@@ -2,6 +2,7 @@
 #include "Engine/Renderer/DebugRender.hpp"
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/EventSystems.hpp"
+#include "Engine/Core/FileUtils.hpp"
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/IntVec2.hpp"
@@ -10,6 +11,7 @@
 #include "Engine/Math/Vertex_PCU.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/DebugRenderBatcher.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
 #include "Engine/Renderer/Shader.hpp"
 #include <cmath>
@@ -57,6 +59,18 @@ void DebugRender::Startup( RenderContext* renderContext )
 	m_defaultShader = m_renderContext->CreateOrGetShaderFromFile(m_defaultShaderPath);
 	m_defaultShader->SetDepth(eCompareOp::COMPARE_LEQUAL, true);
 
+	//Instancing is optional, without the shader the batcher transforms primitives on the CPU instead
+	if(DoesFileExist(std::string(SHADER_PATH) + m_instancedShaderPath))
+	{
+		m_instancedShader = m_renderContext->CreateOrGetShaderFromFile(m_instancedShaderPath);
+		if(!m_instancedShader->m_vertexStage.IsValid() || !m_instancedShader->m_pixelStage.IsValid())
+		{
+			m_instancedShader = nullptr;
+		}
+	}
+
+	m_batcher = new DebugRenderBatcher(m_renderContext, m_instancedShader);
+
 	g_eventSystem->SubscribeEventCallBackFn("DisableDebug", DisableDebugRender);
 	g_eventSystem->SubscribeEventCallBackFn("EnableDebug", EnableDebugRender);
 	g_eventSystem->SubscribeEventCallBackFn("ClearAllDebug", ClearAllLiveObjects);
@@ -91,6 +105,9 @@ void DebugRender::Shutdown()
 	delete m_debug2DCam;
 	m_debug2DCam = nullptr;
 
+	delete m_batcher;
+	m_batcher = nullptr;
+
 	s_debugRender = nullptr;
 
 	//TODO("Properly delete all the DebugRenderOptionsT objects stored in vectors");
@@ -152,13 +169,6 @@ void DebugRender::Update( float deltaTime )
 			blendFraction = 1 - blendFraction;
 
 			Rgba::LerpRGB( objectProperties->m_currentColor, m_worldRenderObjects[objectIndex].beginColor, m_worldRenderObjects[objectIndex].endColor, blendFraction );
-			
-			if(objectProperties->m_renderObjectType == DEBUG_RENDER_TEXT3D)
-			{
-				continue;
-			}
-
-			objectProperties->m_mesh->SetColor(objectProperties->m_currentColor);
 		}
 	}
 
@@ -292,6 +302,9 @@ void DebugRender::DebugRenderToCamera() const
 		default:						{	ERROR_AND_DIE("The debug object is not yet defined in DebugRenderToCamera");	}	break;
 		}
 	}
+
+	//Everything but text was only queued above
+	m_batcher->Flush(m_defaultShader, m_xrayShader);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -658,98 +671,48 @@ void DebugRender::DrawText2D( const DebugRenderOptionsT* renderObject ) const
 //------------------------------------------------------------------------------------------------------------------------------
 void DebugRender::DrawPoint3D( const DebugRenderOptionsT* renderObject ) const
 {
-	m_renderContext->BindTextureViewWithSampler(0U, nullptr);
-
 	Point3DProperties* objectProperties = reinterpret_cast<Point3DProperties*>(renderObject->objectProperties);
 	if(objectProperties->m_renderObjectType != DEBUG_RENDER_POINT3D)
 	{
 		ERROR_AND_DIE("Object recieved in DebugRender was not a 3D Point. Check inputs");
 	}
 
-	//Setup mesh here
-	GPUMesh point = GPUMesh( m_renderContext ); 
-	point.CreateFromCPUMesh<Vertex_PCU>( objectProperties->m_mesh, GPU_MEMORY_USAGE_STATIC );
-	SetObjectMatrixForBillBoard(objectProperties->m_position);
-
-
-	//Setup the textures on the render context
-	m_renderContext->BindTextureViewWithSampler(0U, objectProperties->m_texture); 
-
-	switch (renderObject->mode)
-	{
-		case DEBUG_RENDER_USE_DEPTH:
-		m_renderContext->SetDepth(true);
-		m_renderContext->DrawMesh(&point);
-		break;
-		case DEBUG_RENDER_ALWAYS:
-		m_renderContext->SetDepth(false);
-		m_renderContext->DrawMesh(&point);
-		break;
-		case DEBUG_RENDER_XRAY:
-		{
-			//Make 2 draw calls here
-			//One with compare op lequals and one with compare op greater than (edit alpha on that one)
-			m_renderContext->SetGlobalTint(Rgba::DARK_GREY);
-			m_xrayShader->SetDepth(eCompareOp::COMPARE_GREATER, false);
-			m_renderContext->BindShader(m_xrayShader);
-			m_renderContext->DrawMesh(&point);
-			m_renderContext->BindShader(m_defaultShader);
-			m_renderContext->DrawMesh(&point);
-		}
-		break;
-	}
+	//Billboarded square around the point
+	const Matrix44& cameraModel = m_debug3DCam->GetModelMatrix();
+	Vec3 right = cameraModel.GetIBasis() * objectProperties->m_size * 0.5f;
+	Vec3 up = cameraModel.GetJBasis() * objectProperties->m_size * 0.5f;
+	Vec3 position = objectProperties->m_position;
 
+	m_batcher->AddQuad(renderObject->mode, objectProperties->m_texture, position - right + up, position + right + up, position - right - up, position + right - up, objectProperties->m_currentColor);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
 void DebugRender::DrawQuad3D( const DebugRenderOptionsT* renderObject ) const
 {
-	m_renderContext->BindTextureViewWithSampler(0U, nullptr);
-
 	Quad3DProperties* objectProperties = reinterpret_cast<Quad3DProperties*>(renderObject->objectProperties);
 	if(objectProperties->m_renderObjectType != DEBUG_RENDER_QUAD3D)
 	{
 		ERROR_AND_DIE("Object recieved in DebugRender was not a 3D Quad. Check inputs");
 	}
 
-	//Setup mesh here
-	GPUMesh quad = GPUMesh( m_renderContext ); 
-	quad.CreateFromCPUMesh<Vertex_PCU>( objectProperties->m_mesh, GPU_MEMORY_USAGE_STATIC );
+	Vec3 iBasis = Vec3(1.f, 0.f, 0.f);
+	Vec3 jBasis = Vec3(0.f, 1.f, 0.f);
+	Vec3 kBasis = Vec3(0.f, 0.f, 1.f);
 	if(objectProperties->m_billBoarded)
 	{
-		SetObjectMatrixForBillBoard(objectProperties->m_position);
-	}
-	else
-	{
-		SetObjectMatrixForPosition(objectProperties->m_position);
+		const Matrix44& cameraModel = m_debug3DCam->GetModelMatrix();
+		iBasis = cameraModel.GetIBasis();
+		jBasis = cameraModel.GetJBasis();
+		kBasis = cameraModel.GetKBasis();
 	}
 
-	//Setup the textures on the render context
-	m_renderContext->BindTextureViewWithSampler(0U, objectProperties->m_texture); 
+	//Stretch the unit quad over the AABB2, which is relative to the position
+	const AABB2& quad = objectProperties->m_quad;
+	Vec2 dimensions = quad.m_maxBounds - quad.m_minBounds;
+	Vec3 origin = objectProperties->m_position + iBasis * quad.m_minBounds.x + jBasis * quad.m_minBounds.y;
+	Matrix44 model = Matrix44(iBasis * dimensions.x, jBasis * dimensions.y, kBasis, origin);
 
-	switch (renderObject->mode)
-	{
-		case DEBUG_RENDER_USE_DEPTH:
-		m_renderContext->SetDepth(true);
-		m_renderContext->DrawMesh(&quad);
-		break;
-		case DEBUG_RENDER_ALWAYS:
-		m_renderContext->SetDepth(false);
-		m_renderContext->DrawMesh(&quad);
-		break;
-		case DEBUG_RENDER_XRAY:
-		{
-			//Make 2 draw calls here
-			//One with compare op lequals and one with compare op greater than (edit alpha on that one)
-			m_renderContext->SetGlobalTint(Rgba::DARK_GREY);
-			m_xrayShader->SetDepth(eCompareOp::COMPARE_GREATER, false);
-			m_renderContext->BindShader(m_xrayShader);
-			m_renderContext->DrawMesh(&quad);
-			m_renderContext->BindShader(m_defaultShader);
-			m_renderContext->DrawMesh(&quad);
-		}
-		break;
-	}
+	m_batcher->AddInstance(DEBUG_PRIMITIVE_QUAD, renderObject->mode, false, objectProperties->m_texture, model, objectProperties->m_currentColor);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -761,38 +724,19 @@ void DebugRender::DrawLine3D( const DebugRenderOptionsT* renderObject ) const
 		ERROR_AND_DIE("Object recieved in DebugRender was not a 3D Line. Check inputs");
 	}
 
-	//Setup mesh here
-	GPUMesh line = GPUMesh( m_renderContext ); 
-	line.CreateFromCPUMesh<Vertex_PCU>( objectProperties->m_mesh, GPU_MEMORY_USAGE_STATIC );
-	SetObjectMatrixForPosition(objectProperties->m_center);
-	//SetObjectMatrixForBillBoard(objectProperties->m_center);
-
-	//Setup the textures on the render context
-	m_renderContext->BindTextureViewWithSampler(0U, nullptr); 
+	Vec3 start = objectProperties->m_startPos;
+	Vec3 end = objectProperties->m_endPos;
 
-	switch (renderObject->mode)
+	//Ribbon turned towards the camera so the line keeps its width from any angle
+	Vec3 toCamera = m_debug3DCam->GetModelMatrix().GetTBasis() - (start + end) * 0.5f;
+	Vec3 side = GetCrossProduct(end - start, toCamera);
+	if(side.GetLengthSquared() == 0.f)
 	{
-		case DEBUG_RENDER_USE_DEPTH:
-		m_renderContext->SetDepth(true);
-		m_renderContext->DrawMesh(&line);
-		break;
-		case DEBUG_RENDER_ALWAYS:
-		m_renderContext->SetDepth(false);
-		m_renderContext->DrawMesh(&line);
-		break;
-		case DEBUG_RENDER_XRAY:
-		{
-			//Make 2 draw calls here
-			//One with compare op lequals and one with compare op greater than (edit alpha on that one)
-			m_renderContext->SetGlobalTint(Rgba::DARK_GREY);
-			m_xrayShader->SetDepth(eCompareOp::COMPARE_GREATER, false);
-			m_renderContext->BindShader(m_xrayShader);
-			m_renderContext->DrawMesh(&line);
-			m_renderContext->BindShader(m_defaultShader);
-			m_renderContext->DrawMesh(&line);
-		}
-		break;
+		side = m_debug3DCam->GetModelMatrix().GetIBasis();
 	}
+	side = side.GetNormalized() * objectProperties->m_lineWidth * 0.5f;
+
+	m_batcher->AddQuad(renderObject->mode, nullptr, start + side, end + side, start - side, end - side, objectProperties->m_currentColor);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -804,37 +748,10 @@ void DebugRender::DrawSphere( const DebugRenderOptionsT* renderObject ) const
 		ERROR_AND_DIE("Object recieved in DebugRender was not a Sphere. Check inputs");
 	}
 
-	//Setup mesh here
-	GPUMesh sphere = GPUMesh( m_renderContext ); 
-	sphere.CreateFromCPUMesh<Vertex_PCU>( objectProperties->m_mesh, GPU_MEMORY_USAGE_STATIC );
-	SetObjectMatrixForPosition(objectProperties->m_center);
-
-	//Setup the textures on the render context
-	m_renderContext->BindTextureViewWithSampler(0U, objectProperties->m_texture); 
+	float radius = objectProperties->m_radius;
+	Matrix44 model = Matrix44(Vec3(radius, 0.f, 0.f), Vec3(0.f, radius, 0.f), Vec3(0.f, 0.f, radius), objectProperties->m_center);
 
-	switch (renderObject->mode)
-	{
-		case DEBUG_RENDER_USE_DEPTH:
-		m_renderContext->SetDepth(true);
-		m_renderContext->DrawMesh(&sphere);
-		break;
-		case DEBUG_RENDER_ALWAYS:
-		m_renderContext->SetDepth(false);
-		m_renderContext->DrawMesh(&sphere);
-		break;
-		case DEBUG_RENDER_XRAY:
-		{
-			//Make 2 draw calls here
-			//One with compare op lequals and one with compare op greater than (edit alpha on that one)
-			m_renderContext->SetGlobalTint(Rgba::DARK_GREY);
-			m_xrayShader->SetDepth(eCompareOp::COMPARE_GREATER, false);
-			m_renderContext->BindShader(m_xrayShader);
-			m_renderContext->DrawMesh(&sphere);
-			m_renderContext->BindShader(m_defaultShader);
-			m_renderContext->DrawMesh(&sphere);
-		}
-		break;
-	}
+	m_batcher->AddInstance(DEBUG_PRIMITIVE_SPHERE, renderObject->mode, false, objectProperties->m_texture, model, objectProperties->m_currentColor);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -846,39 +763,10 @@ void DebugRender::DrawWireSphere( const DebugRenderOptionsT* renderObject ) cons
 		ERROR_AND_DIE("Object recieved in DebugRender was not a Sphere. Check inputs");
 	}
 
-	//Setup mesh here
-	GPUMesh sphere = GPUMesh( m_renderContext ); 
-	sphere.CreateFromCPUMesh<Vertex_PCU>( objectProperties->m_mesh, GPU_MEMORY_USAGE_STATIC );
-	SetObjectMatrixForPosition(objectProperties->m_center);
+	float radius = objectProperties->m_radius;
+	Matrix44 model = Matrix44(Vec3(radius, 0.f, 0.f), Vec3(0.f, radius, 0.f), Vec3(0.f, 0.f, radius), objectProperties->m_center);
 
-	//Setup the textures on the render context
-	m_renderContext->BindTextureViewWithSampler(0U, objectProperties->m_texture); 
-
-	m_renderContext->SetRasterStateWireFrame();
-	switch (renderObject->mode)
-	{
-		case DEBUG_RENDER_USE_DEPTH:
-		m_renderContext->SetDepth(true);
-		m_renderContext->DrawMesh(&sphere);
-		break;
-		case DEBUG_RENDER_ALWAYS:
-		m_renderContext->SetDepth(false);
-		m_renderContext->DrawMesh(&sphere);
-		break;
-		case DEBUG_RENDER_XRAY:
-		{
-			//Make 2 draw calls here
-			//One with compare op lequals and one with compare op greater than (edit alpha on that one)
-			m_renderContext->SetGlobalTint(Rgba::DARK_GREY);
-			m_xrayShader->SetDepth(eCompareOp::COMPARE_GREATER, false);
-			m_renderContext->BindShader(m_xrayShader);
-			m_renderContext->DrawMesh(&sphere);
-			m_renderContext->BindShader(m_defaultShader);
-			m_renderContext->DrawMesh(&sphere);
-		}
-		break;
-	}
-	m_renderContext->CreateAndSetDefaultRasterState();
+	m_batcher->AddInstance(DEBUG_PRIMITIVE_SPHERE, renderObject->mode, true, objectProperties->m_texture, model, objectProperties->m_currentColor);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -890,37 +778,15 @@ void DebugRender::DrawBox( const DebugRenderOptionsT* renderObject ) const
 		ERROR_AND_DIE("Object recieved in DebugRender was not a Box. Check inputs");
 	}
 
-	//Setup mesh here
-	GPUMesh box = GPUMesh( m_renderContext ); 
-	box.CreateFromCPUMesh<Vertex_PCU>( objectProperties->m_mesh, GPU_MEMORY_USAGE_STATIC );
-	SetObjectMatrixForPosition(objectProperties->m_position);
-
-	//Setup the textures on the render context
-	m_renderContext->BindTextureViewWithSampler(0U, objectProperties->m_texture); 
+	//Unit cube edges mapped onto the box edges, the box is relative to the position
+	const AABB3& box = objectProperties->m_box;
+	Vec3 iBasis = box.m_frontBottomRight - box.m_frontBottomLeft;
+	Vec3 jBasis = box.m_frontTopLeft - box.m_frontBottomLeft;
+	Vec3 kBasis = box.m_backBottomLeft - box.m_frontBottomLeft;
+	Vec3 center = (box.m_frontBottomLeft + box.m_backTopRight) * 0.5f + objectProperties->m_position;
+	Matrix44 model = Matrix44(iBasis, jBasis, kBasis, center);
 
-	switch (renderObject->mode)
-	{
-		case DEBUG_RENDER_USE_DEPTH:
-		m_renderContext->SetDepth(true);
-		m_renderContext->DrawMesh(&box);
-		break;
-		case DEBUG_RENDER_ALWAYS:
-		m_renderContext->SetDepth(false);
-		m_renderContext->DrawMesh(&box);
-		break;
-		case DEBUG_RENDER_XRAY:
-		{
-			//Make 2 draw calls here
-			//One with compare op lequals and one with compare op greater than (edit alpha on that one)
-			m_renderContext->SetGlobalTint(Rgba::DARK_GREY);
-			m_xrayShader->SetDepth(eCompareOp::COMPARE_GREATER, false);
-			m_renderContext->BindShader(m_xrayShader);
-			m_renderContext->DrawMesh(&box);
-			m_renderContext->BindShader(m_defaultShader);
-			m_renderContext->DrawMesh(&box);
-		}
-	break;
-	}
+	m_batcher->AddInstance(DEBUG_PRIMITIVE_BOX, renderObject->mode, false, objectProperties->m_texture, model, objectProperties->m_currentColor);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -932,39 +798,15 @@ void DebugRender::DrawWireBox( const DebugRenderOptionsT* renderObject ) const
 		ERROR_AND_DIE("Object recieved in DebugRender was not a Box. Check inputs");
 	}
 
-	//Setup mesh here
-	GPUMesh box = GPUMesh( m_renderContext ); 
-	box.CreateFromCPUMesh<Vertex_PCU>( objectProperties->m_mesh, GPU_MEMORY_USAGE_STATIC );
-	SetObjectMatrixForPosition(objectProperties->m_position);
+	//Unit cube edges mapped onto the box edges, the box is relative to the position
+	const AABB3& box = objectProperties->m_box;
+	Vec3 iBasis = box.m_frontBottomRight - box.m_frontBottomLeft;
+	Vec3 jBasis = box.m_frontTopLeft - box.m_frontBottomLeft;
+	Vec3 kBasis = box.m_backBottomLeft - box.m_frontBottomLeft;
+	Vec3 center = (box.m_frontBottomLeft + box.m_backTopRight) * 0.5f + objectProperties->m_position;
+	Matrix44 model = Matrix44(iBasis, jBasis, kBasis, center);
 
-	//Setup the textures on the render context
-	m_renderContext->BindTextureViewWithSampler(0U, objectProperties->m_texture); 
-
-	m_renderContext->SetRasterStateWireFrame();
-	switch (renderObject->mode)
-	{
-		case DEBUG_RENDER_USE_DEPTH:
-		m_renderContext->SetDepth(true);
-		m_renderContext->DrawMesh(&box);
-		break;
-		case DEBUG_RENDER_ALWAYS:
-		m_renderContext->SetDepth(false);
-		m_renderContext->DrawMesh(&box);
-		break;
-		case DEBUG_RENDER_XRAY:
-		{
-			//Make 2 draw calls here
-			//One with compare op lequals and one with compare op greater than (edit alpha on that one)
-			m_renderContext->SetGlobalTint(Rgba::DARK_GREY);
-			m_xrayShader->SetDepth(eCompareOp::COMPARE_GREATER, false);
-			m_renderContext->BindShader(m_xrayShader);
-			m_renderContext->DrawMesh(&box);
-			m_renderContext->BindShader(m_defaultShader);
-			m_renderContext->DrawMesh(&box);
-		}
-		break;
-	}
-	m_renderContext->CreateAndSetDefaultRasterState();
+	m_batcher->AddInstance(DEBUG_PRIMITIVE_BOX, renderObject->mode, true, objectProperties->m_texture, model, objectProperties->m_currentColor);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -1024,7 +866,7 @@ void DebugRender::DrawText3D( const DebugRenderOptionsT* renderObject ) const
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-void DebugRender::DrawCapsule3D(const DebugRenderOptionsT* renderObject) const
+void DebugRender::DrawCapsule3D( const DebugRenderOptionsT* renderObject ) const
 {
 	CapsuleProperties* objectProperties = reinterpret_cast<CapsuleProperties*>(renderObject->objectProperties);
 	if (objectProperties->m_renderObjectType != DEBUG_RENDER_CAPSULE)
@@ -1032,41 +874,11 @@ void DebugRender::DrawCapsule3D(const DebugRenderOptionsT* renderObject) const
 		ERROR_AND_DIE("Object recieved in DebugRender was not a Capsule. Check inputs");
 	}
 
-	//Setup mesh here
-	GPUMesh capsule = GPUMesh(m_renderContext);
-	capsule.CreateFromCPUMesh<Vertex_PCU>(objectProperties->m_mesh, GPU_MEMORY_USAGE_STATIC);
-	SetObjectMatrixForPosition(objectProperties->m_position);
-
-	//Setup the textures on the render context
-	m_renderContext->BindTextureViewWithSampler(0U, objectProperties->m_texture);
-
-	switch (renderObject->mode)
-	{
-	case DEBUG_RENDER_USE_DEPTH:
-		m_renderContext->SetDepth(true);
-		m_renderContext->DrawMesh(&capsule);
-		break;
-	case DEBUG_RENDER_ALWAYS:
-		m_renderContext->SetDepth(false);
-		m_renderContext->DrawMesh(&capsule);
-		break;
-	case DEBUG_RENDER_XRAY:
-	{
-		//Make 2 draw calls here
-		//One with compare op lequals and one with compare op greater than (edit alpha on that one)
-		m_renderContext->SetGlobalTint(Rgba::DARK_GREY);
-		m_xrayShader->SetDepth(eCompareOp::COMPARE_GREATER, false);
-		m_renderContext->BindShader(m_xrayShader);
-		m_renderContext->DrawMesh(&capsule);
-		m_renderContext->BindShader(m_defaultShader);
-		m_renderContext->DrawMesh(&capsule);
-	}
-	break;
-	}
+	AddCapsuleInstances(renderObject->mode, false, objectProperties);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-void DebugRender::DrawWireCapsule3D(const DebugRenderOptionsT* renderObject) const
+void DebugRender::DrawWireCapsule3D( const DebugRenderOptionsT* renderObject ) const
 {
 	CapsuleProperties* objectProperties = reinterpret_cast<CapsuleProperties*>(renderObject->objectProperties);
 	if (objectProperties->m_renderObjectType != DEBUG_RENDER_WIRE_CAPSULE)
@@ -1074,39 +886,32 @@ void DebugRender::DrawWireCapsule3D(const DebugRenderOptionsT* renderObject) con
 		ERROR_AND_DIE("Object recieved in DebugRender was not a Capsule. Check inputs");
 	}
 
-	//Setup mesh here
-	GPUMesh capsule = GPUMesh(m_renderContext);
-	capsule.CreateFromCPUMesh<Vertex_PCU>(objectProperties->m_mesh, GPU_MEMORY_USAGE_STATIC);
-	SetObjectMatrixForPosition(objectProperties->m_position);
+	AddCapsuleInstances(renderObject->mode, true, objectProperties);
+}
 
-	//Setup the textures on the render context
-	m_renderContext->BindTextureViewWithSampler(0U, objectProperties->m_texture);
+//------------------------------------------------------------------------------------------------------------------------------
+void DebugRender::AddCapsuleInstances( eDebugRenderMode mode, bool isWireFrame, const CapsuleProperties* objectProperties ) const
+{
+	const Capsule3D& capsule = objectProperties->m_capsule;
+	Vec3 start = capsule.m_start + objectProperties->m_position;
+	Vec3 end = capsule.m_end + objectProperties->m_position;
+	float radius = capsule.m_radius;
 
-	m_renderContext->SetRasterStateWireFrame();
-	switch (renderObject->mode)
-	{
-	case DEBUG_RENDER_USE_DEPTH:
-		m_renderContext->SetDepth(true);
-		m_renderContext->DrawMesh(&capsule);
-		break;
-	case DEBUG_RENDER_ALWAYS:
-		m_renderContext->SetDepth(false);
-		m_renderContext->DrawMesh(&capsule);
-		break;
-	case DEBUG_RENDER_XRAY:
-	{
-		//Make 2 draw calls here
-		//One with compare op lequals and one with compare op greater than (edit alpha on that one)
-		m_renderContext->SetGlobalTint(Rgba::DARK_GREY);
-		m_xrayShader->SetDepth(eCompareOp::COMPARE_GREATER, false);
-		m_renderContext->BindShader(m_xrayShader);
-		m_renderContext->DrawMesh(&capsule);
-		m_renderContext->BindShader(m_defaultShader);
-		m_renderContext->DrawMesh(&capsule);
-	}
-	break;
-	}
-	m_renderContext->CreateAndSetDefaultRasterState();
+	//Basis with J running from end to start, the caps are hemispheres and the sides a cylinder along it
+	Vec3 axis = start - end;
+	float length = axis.GetLength();
+	Vec3 jBasis = (length > 0.f) ? axis / length : Vec3::UP;
+	Vec3 reference = (fabsf(jBasis.y) < 0.99f) ? Vec3(0.f, 1.f, 0.f) : Vec3(1.f, 0.f, 0.f);
+	Vec3 iBasis = GetCrossProduct(jBasis, reference).GetNormalized();
+	Vec3 kBasis = GetCrossProduct(iBasis, jBasis);
+
+	Matrix44 topCap = Matrix44(iBasis * radius, jBasis * radius, kBasis * radius, start);
+	Matrix44 bottomCap = Matrix44(iBasis * radius, jBasis * -radius, kBasis * -radius, end);
+	Matrix44 sides = Matrix44(iBasis * radius, jBasis * length, kBasis * radius, end);
+
+	m_batcher->AddInstance(DEBUG_PRIMITIVE_HEMISPHERE, mode, isWireFrame, objectProperties->m_texture, topCap, objectProperties->m_currentColor);
+	m_batcher->AddInstance(DEBUG_PRIMITIVE_HEMISPHERE, mode, isWireFrame, objectProperties->m_texture, bottomCap, objectProperties->m_currentColor);
+	m_batcher->AddInstance(DEBUG_PRIMITIVE_CYLINDER, mode, isWireFrame, objectProperties->m_texture, sides, objectProperties->m_currentColor);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
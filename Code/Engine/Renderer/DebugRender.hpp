@@ -14,6 +14,7 @@ struct Capsule3D;
 struct IntVec2;
 
 class BitmapFont;
+class DebugRenderBatcher;
 class Disc2D;
 class TextureView;
 class RenderContext;
@@ -191,6 +192,7 @@ private:
 	void							DrawText3D			( const DebugRenderOptionsT* renderObject ) const;
 	void							DrawCapsule3D		(const DebugRenderOptionsT* renderObject) const;
 	void							DrawWireCapsule3D	(const DebugRenderOptionsT* renderObject) const;
+	void							AddCapsuleInstances	( eDebugRenderMode mode, bool isWireFrame, const CapsuleProperties* objectProperties ) const;
 
 	//Destroy objects functions
 	void							DestroyAllScreenObjects();
@@ -219,6 +221,9 @@ private:
 	Shader*									m_defaultShader					= nullptr;
 	std::string								m_defaultShaderPath				= "default_unlit.xml";
 	std::string								m_xmlShaderPath					= "default_unlit_xray.xml";
+	std::string								m_instancedShaderPath			= "default_unlit_instanced.xml";
+	Shader*									m_instancedShader				= nullptr;		// nullptr when the data has no instanced shader
+	DebugRenderBatcher*						m_batcher						= nullptr;
 
 	//Keep a reference to the DebugRender instance for use with event systems
 	static DebugRender*						s_debugRender;
@@ -0,0 +1,376 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/DebugRenderBatcher.hpp"
+//Engine Systems
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Renderer/BufferLayout.hpp"
+#include "Engine/Renderer/CPUMesh.hpp"
+#include "Engine/Renderer/GPUMesh.hpp"
+#include "Engine/Renderer/IndexBuffer.hpp"
+#include "Engine/Renderer/RenderContext.hpp"
+#include "Engine/Renderer/Shader.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+#include <algorithm>
+#include <functional>
+#include <stddef.h>
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC BufferAttributeT DebugInstanceT::LAYOUT[] = {
+	BufferAttributeT( "INSTANCE_I",			DF_RGBA32,		offsetof(DebugInstanceT, model) + sizeof(float) * Matrix44::Ix ),
+	BufferAttributeT( "INSTANCE_J",			DF_RGBA32,		offsetof(DebugInstanceT, model) + sizeof(float) * Matrix44::Jx ),
+	BufferAttributeT( "INSTANCE_K",			DF_RGBA32,		offsetof(DebugInstanceT, model) + sizeof(float) * Matrix44::Kx ),
+	BufferAttributeT( "INSTANCE_T",			DF_RGBA32,		offsetof(DebugInstanceT, model) + sizeof(float) * Matrix44::Tx ),
+	BufferAttributeT( "INSTANCE_COLOR",		DF_RGBA32,		offsetof(DebugInstanceT, color) ),
+	BufferAttributeT() // end
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC const BufferLayout* DebugInstanceT::layout = BufferLayout::For( DebugInstanceT::LAYOUT, sizeof(DebugInstanceT), nullptr );
+
+//------------------------------------------------------------------------------------------------------------------------------
+DebugRenderBatcher::DebugRenderBatcher( RenderContext* renderContext, Shader* instancedShader )
+{
+	m_renderContext = renderContext;
+	m_instancedShader = instancedShader;
+
+	for (uint primitive = 0; primitive < NUM_DEBUG_PRIMITIVES; primitive++)
+	{
+		m_unitCPUMeshes[primitive] = new CPUMesh();
+	}
+
+	CPUMeshAddQuad(m_unitCPUMeshes[DEBUG_PRIMITIVE_QUAD], AABB2(Vec2::ZERO, Vec2::ONE));
+	CPUMeshAddCube(m_unitCPUMeshes[DEBUG_PRIMITIVE_BOX], AABB3::UNIT_CUBE);
+	CPUMeshAddUVSphere(m_unitCPUMeshes[DEBUG_PRIMITIVE_SPHERE], Vec3::ZERO, 1.f);
+	CPUMeshAddUVHemisphere(m_unitCPUMeshes[DEBUG_PRIMITIVE_HEMISPHERE], Vec3::ZERO, 1.f);
+	CPUMeshAddUVCylinder(m_unitCPUMeshes[DEBUG_PRIMITIVE_CYLINDER], Vec3::ZERO, 1.f, 1.f);
+
+	for (uint primitive = 0; primitive < NUM_DEBUG_PRIMITIVES; primitive++)
+	{
+		m_unitMeshes[primitive] = new GPUMesh(m_renderContext);
+		m_unitMeshes[primitive]->CreateFromCPUMesh<Vertex_PCU>(m_unitCPUMeshes[primitive], GPU_MEMORY_USAGE_STATIC);
+	}
+
+	m_instanceBuffer = new VertexBuffer(m_renderContext);
+	m_streamBuffer = new VertexBuffer(m_renderContext);
+	m_streamIndexBuffer = new IndexBuffer(m_renderContext);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+DebugRenderBatcher::~DebugRenderBatcher()
+{
+	for (uint primitive = 0; primitive < NUM_DEBUG_PRIMITIVES; primitive++)
+	{
+		delete m_unitMeshes[primitive];
+		m_unitMeshes[primitive] = nullptr;
+
+		delete m_unitCPUMeshes[primitive];
+		m_unitCPUMeshes[primitive] = nullptr;
+	}
+
+	delete m_instanceBuffer;
+	m_instanceBuffer = nullptr;
+
+	delete m_streamBuffer;
+	m_streamBuffer = nullptr;
+
+	delete m_streamIndexBuffer;
+	m_streamIndexBuffer = nullptr;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void DebugRenderBatcher::AddInstance( eDebugPrimitive primitive, eDebugRenderMode mode, bool isWireFrame, TextureView* texture, const Matrix44& model, const Rgba& color )
+{
+	BatchItemT item;
+	item.mode = mode;
+	item.isWireFrame = isWireFrame;
+	item.texture = texture;
+	item.primitive = primitive;
+	item.dataIndex = static_cast<uint>(m_instances.size());
+	m_items.push_back(item);
+
+	DebugInstanceT instance;
+	instance.model = model;
+	instance.color = color;
+	m_instances.push_back(instance);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void DebugRenderBatcher::AddQuad( eDebugRenderMode mode, TextureView* texture, const Vec3& topLeft, const Vec3& topRight, const Vec3& bottomLeft, const Vec3& bottomRight, const Rgba& color )
+{
+	BatchItemT item;
+	item.mode = mode;
+	item.isWireFrame = false;
+	item.texture = texture;
+	item.primitive = DEBUG_PRIMITIVE_STREAM;
+	item.dataIndex = static_cast<uint>(m_quadVertices.size());
+	m_items.push_back(item);
+
+	m_quadVertices.push_back(Vertex_PCU(topLeft, color, Vec2(0.f, 0.f)));
+	m_quadVertices.push_back(Vertex_PCU(topRight, color, Vec2(1.f, 0.f)));
+	m_quadVertices.push_back(Vertex_PCU(bottomLeft, color, Vec2(0.f, 1.f)));
+	m_quadVertices.push_back(Vertex_PCU(bottomRight, color, Vec2(1.f, 1.f)));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Render mode first so depth state changes the least, wire frame next since changing the raster state makes a new one
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC bool DebugRenderBatcher::SortItems( const BatchItemT& lhs, const BatchItemT& rhs )
+{
+	if (lhs.mode != rhs.mode)
+	{
+		return lhs.mode < rhs.mode;
+	}
+
+	if (lhs.isWireFrame != rhs.isWireFrame)
+	{
+		return !lhs.isWireFrame;
+	}
+
+	if (lhs.texture != rhs.texture)
+	{
+		return std::less<TextureView*>()(lhs.texture, rhs.texture);
+	}
+
+	return lhs.primitive < rhs.primitive;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool DebugRenderBatcher::IsInstanced( uint primitive ) const
+{
+	return primitive != DEBUG_PRIMITIVE_STREAM && m_instancedShader != nullptr;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+uint DebugRenderBatcher::GetStreamVertexCount( const BatchItemT& item ) const
+{
+	return (item.primitive == DEBUG_PRIMITIVE_STREAM) ? 4U : m_unitCPUMeshes[item.primitive]->GetVertexCount();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+uint DebugRenderBatcher::GetStreamIndexCount( const BatchItemT& item ) const
+{
+	return (item.primitive == DEBUG_PRIMITIVE_STREAM) ? 6U : m_unitCPUMeshes[item.primitive]->GetIndexCount();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// firstVertex is where outVertices sits in the stream, the indices written point at the whole stream
+//------------------------------------------------------------------------------------------------------------------------------
+void DebugRenderBatcher::WriteStreamItem( Vertex_PCU* outVertices, uint* outIndices, uint firstVertex, const BatchItemT& item ) const
+{
+	if (item.primitive == DEBUG_PRIMITIVE_STREAM)
+	{
+		const Vertex_PCU* quad = &m_quadVertices[item.dataIndex];
+		outVertices[0] = quad[0];
+		outVertices[1] = quad[1];
+		outVertices[2] = quad[2];
+		outVertices[3] = quad[3];
+
+		//Same winding as CPUMeshAddQuad
+		outIndices[0] = firstVertex + 0;
+		outIndices[1] = firstVertex + 2;
+		outIndices[2] = firstVertex + 1;
+		outIndices[3] = firstVertex + 2;
+		outIndices[4] = firstVertex + 3;
+		outIndices[5] = firstVertex + 1;
+		return;
+	}
+
+	//No instancing, so the unit mesh is transformed here
+	const DebugInstanceT& instance = m_instances[item.dataIndex];
+	const CPUMesh* mesh = m_unitCPUMeshes[item.primitive];
+	const VertexMaster* vertices = mesh->GetVertices();
+	const uint* indices = mesh->GetIndices();
+
+	uint numVertices = mesh->GetVertexCount();
+	for (uint vertexIndex = 0; vertexIndex < numVertices; vertexIndex++)
+	{
+		const VertexMaster& vertex = vertices[vertexIndex];
+		outVertices[vertexIndex] = Vertex_PCU(instance.model.TransformPosition3D(vertex.m_position), instance.color, vertex.m_uv);
+	}
+
+	uint numIndices = mesh->GetIndexCount();
+	for (uint index = 0; index < numIndices; index++)
+	{
+		outIndices[index] = firstVertex + indices[index];
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void DebugRenderBatcher::Flush( Shader* defaultShader, Shader* xrayShader )
+{
+	if (m_items.empty())
+	{
+		return;
+	}
+
+	std::stable_sort(m_items.begin(), m_items.end(), SortItems);
+
+	uint numInstances = 0;
+	uint numStreamVertices = 0;
+	uint numStreamIndices = 0;
+	for (size_t itemIndex = 0; itemIndex < m_items.size(); itemIndex++)
+	{
+		if (IsInstanced(m_items[itemIndex].primitive))
+		{
+			numInstances++;
+		}
+		else
+		{
+			numStreamVertices += GetStreamVertexCount(m_items[itemIndex]);
+			numStreamIndices += GetStreamIndexCount(m_items[itemIndex]);
+		}
+	}
+
+	//The buffers are written once in sorted order, so every run is a contiguous range of the instances or stream indices
+	DebugInstanceT* instances = (numInstances > 0) ? reinterpret_cast<DebugInstanceT*>(m_instanceBuffer->MapForWrite(numInstances, sizeof(DebugInstanceT))) : nullptr;
+	Vertex_PCU* streamVertices = (numStreamVertices > 0) ? reinterpret_cast<Vertex_PCU*>(m_streamBuffer->MapForWrite(numStreamVertices, sizeof(Vertex_PCU))) : nullptr;
+	uint* streamIndices = (numStreamIndices > 0) ? m_streamIndexBuffer->MapForWrite(numStreamIndices) : nullptr;
+
+	bool mapped = (numInstances == 0 || instances != nullptr) && (numStreamVertices == 0 || (streamVertices != nullptr && streamIndices != nullptr));
+
+	m_runs.clear();
+	uint instanceIndex = 0;
+	uint streamVertex = 0;
+	uint streamIndex = 0;
+	for (size_t itemIndex = 0; mapped && itemIndex < m_items.size(); itemIndex++)
+	{
+		const BatchItemT& item = m_items[itemIndex];
+		bool isInstanced = IsInstanced(item.primitive);
+
+		BatchRunT run;
+		run.mode = item.mode;
+		run.isWireFrame = item.isWireFrame;
+		run.texture = item.texture;
+		run.primitive = isInstanced ? item.primitive : DEBUG_PRIMITIVE_STREAM;
+
+		if (isInstanced)
+		{
+			instances[instanceIndex] = m_instances[item.dataIndex];
+			run.first = instanceIndex;
+			run.count = 1;
+			instanceIndex++;
+		}
+		else
+		{
+			WriteStreamItem(streamVertices + streamVertex, streamIndices + streamIndex, streamVertex, item);
+			run.first = streamIndex;
+			run.count = GetStreamIndexCount(item);
+			streamVertex += GetStreamVertexCount(item);
+			streamIndex += run.count;
+		}
+
+		BatchRunT* lastRun = m_runs.empty() ? nullptr : &m_runs.back();
+		if (lastRun != nullptr && lastRun->mode == run.mode && lastRun->isWireFrame == run.isWireFrame && lastRun->texture == run.texture
+			&& lastRun->primitive == run.primitive && lastRun->first + lastRun->count == run.first)
+		{
+			lastRun->count += run.count;
+		}
+		else
+		{
+			m_runs.push_back(run);
+		}
+	}
+
+	if (instances != nullptr)
+	{
+		m_instanceBuffer->Unmap();
+	}
+
+	if (streamVertices != nullptr)
+	{
+		m_streamBuffer->Unmap();
+	}
+
+	if (streamIndices != nullptr)
+	{
+		m_streamIndexBuffer->Unmap();
+	}
+
+	//Stream vertices are already in world space
+	m_renderContext->SetModelMatrix(Matrix44::IDENTITY);
+
+	bool isWireFrame = false;
+	for (size_t runIndex = 0; runIndex < m_runs.size(); runIndex++)
+	{
+		const BatchRunT& run = m_runs[runIndex];
+		if (run.isWireFrame != isWireFrame)
+		{
+			if (run.isWireFrame)
+			{
+				m_renderContext->SetRasterStateWireFrame();
+			}
+			else
+			{
+				m_renderContext->CreateAndSetDefaultRasterState();
+			}
+
+			isWireFrame = run.isWireFrame;
+		}
+
+		bool isStream = (run.primitive == DEBUG_PRIMITIVE_STREAM);
+		Shader* shader = isStream ? defaultShader : m_instancedShader;
+
+		switch (run.mode)
+		{
+		case DEBUG_RENDER_USE_DEPTH:
+		{
+			shader->SetDepth(eCompareOp::COMPARE_LEQUAL, true);
+			DrawRun(run, shader);
+		}
+		break;
+		case DEBUG_RENDER_ALWAYS:
+		{
+			shader->SetDepth(eCompareOp::COMPARE_ALWAYS, false);
+			DrawRun(run, shader);
+		}
+		break;
+		case DEBUG_RENDER_XRAY:
+		{
+			//Darkened where it is behind something, then drawn normally on top
+			Shader* behindShader = isStream ? xrayShader : m_instancedShader;
+			m_renderContext->SetGlobalTint(Rgba::DARK_GREY);
+			behindShader->SetDepth(eCompareOp::COMPARE_GREATER, false);
+			DrawRun(run, behindShader);
+
+			m_renderContext->SetGlobalTint(Rgba::WHITE);
+			shader->SetDepth(eCompareOp::COMPARE_LEQUAL, true);
+			DrawRun(run, shader);
+		}
+		break;
+		}
+	}
+
+	if (isWireFrame)
+	{
+		m_renderContext->CreateAndSetDefaultRasterState();
+	}
+
+	//Leave the shaders the way DebugRender set them up
+	defaultShader->SetDepth(eCompareOp::COMPARE_LEQUAL, true);
+	xrayShader->SetDepth(eCompareOp::COMPARE_LEQUAL, true);
+	if (m_instancedShader != nullptr)
+	{
+		m_instancedShader->SetDepth(eCompareOp::COMPARE_LEQUAL, true);
+	}
+	m_renderContext->BindShader(defaultShader);
+
+	m_items.clear();
+	m_instances.clear();
+	m_quadVertices.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void DebugRenderBatcher::DrawRun( const BatchRunT& run, Shader* shader ) const
+{
+	m_renderContext->BindShader(shader);
+	m_renderContext->BindTextureViewWithSampler(0U, run.texture);
+
+	if (run.primitive == DEBUG_PRIMITIVE_STREAM)
+	{
+		m_renderContext->DrawIndexedVertexBuffer(m_streamBuffer, m_streamIndexBuffer, Vertex_PCU::layout, run.count, run.first);
+	}
+	else
+	{
+		m_renderContext->DrawMeshInstanced(m_unitMeshes[run.primitive], m_instanceBuffer, DebugInstanceT::layout, run.count, run.first);
+	}
+}
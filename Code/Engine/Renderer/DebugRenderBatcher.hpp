@@ -0,0 +1,117 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+//Engine Systems
+#include "Engine/Math/Matrix44.hpp"
+#include "Engine/Math/Vertex_PCU.hpp"
+#include "Engine/Renderer/DebugRender.hpp"
+#include "Engine/Renderer/Rgba.hpp"
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct BufferAttributeT;
+class BufferLayout;
+class CPUMesh;
+class GPUMesh;
+class IndexBuffer;
+class RenderContext;
+class Shader;
+class TextureView;
+class VertexBuffer;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Unit meshes made once at startup, instances scale and place them
+//------------------------------------------------------------------------------------------------------------------------------
+enum eDebugPrimitive
+{
+	DEBUG_PRIMITIVE_QUAD,			// (0,0) to (1,1) in XY
+	DEBUG_PRIMITIVE_BOX,			// AABB3::UNIT_CUBE
+	DEBUG_PRIMITIVE_SPHERE,			// radius 1 at the origin
+	DEBUG_PRIMITIVE_HEMISPHERE,		// +Y half of the sphere, capsule caps
+	DEBUG_PRIMITIVE_CYLINDER,		// open, radius 1, y from 0 to 1, capsule sides
+
+	NUM_DEBUG_PRIMITIVES
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Per instance data, input slot 1 of the instanced shader:
+//	INSTANCE_I, INSTANCE_J, INSTANCE_K, INSTANCE_T	float4 columns of the model matrix, world = x*I + y*J + z*K + T
+//	INSTANCE_COLOR									float4, multiplies the vertex color
+//------------------------------------------------------------------------------------------------------------------------------
+struct DebugInstanceT
+{
+	Matrix44	model;
+	Rgba		color;
+
+	static BufferAttributeT LAYOUT[];
+	static const BufferLayout* layout;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Collects a frame of 3D debug objects and draws them in as few calls as it can.
+//
+// Everything is sorted by render mode, fill mode and texture. Primitives then draw once per run through the instance
+// buffer. Lines and points are quads written into one dynamic indexed stream, uploaded once and drawn a range per run.
+// Without an instanced shader the primitives are transformed on the CPU into that stream instead, their vertices once
+// each with the unit mesh's indices rebased onto them, which keeps every object on a handful of draws either way.
+//------------------------------------------------------------------------------------------------------------------------------
+class DebugRenderBatcher
+{
+public:
+	explicit DebugRenderBatcher( RenderContext* renderContext, Shader* instancedShader );
+	~DebugRenderBatcher();
+
+	void					AddInstance( eDebugPrimitive primitive, eDebugRenderMode mode, bool isWireFrame, TextureView* texture, const Matrix44& model, const Rgba& color );
+	// Corners in world space, UVs as CPUMeshAddQuad puts them
+	void					AddQuad( eDebugRenderMode mode, TextureView* texture, const Vec3& topLeft, const Vec3& topRight, const Vec3& bottomLeft, const Vec3& bottomRight, const Rgba& color );
+
+	// Uploads and draws everything added since the last flush
+	void					Flush( Shader* defaultShader, Shader* xrayShader );
+
+private:
+	// One object as it was added, DEBUG_PRIMITIVE_STREAM for quads
+	struct BatchItemT
+	{
+		eDebugRenderMode	mode;
+		bool				isWireFrame;
+		TextureView*		texture;
+		uint				primitive;
+		uint				dataIndex;			// into m_instances or m_quadVertices
+	};
+
+	// Consecutive items that draw together
+	struct BatchRunT
+	{
+		eDebugRenderMode	mode;
+		bool				isWireFrame;
+		TextureView*		texture;
+		uint				primitive;
+		uint				first;				// instance or stream index
+		uint				count;
+	};
+
+	static constexpr uint	DEBUG_PRIMITIVE_STREAM = NUM_DEBUG_PRIMITIVES;
+	static bool				SortItems( const BatchItemT& lhs, const BatchItemT& rhs );
+
+	bool					IsInstanced( uint primitive ) const;
+	uint					GetStreamVertexCount( const BatchItemT& item ) const;
+	uint					GetStreamIndexCount( const BatchItemT& item ) const;
+	void					WriteStreamItem( Vertex_PCU* outVertices, uint* outIndices, uint firstVertex, const BatchItemT& item ) const;
+	void					DrawRun( const BatchRunT& run, Shader* shader ) const;
+
+private:
+	RenderContext*			m_renderContext = nullptr;
+	Shader*					m_instancedShader = nullptr;		// nullptr draws primitives through the stream
+
+	CPUMesh*				m_unitCPUMeshes[NUM_DEBUG_PRIMITIVES];
+	GPUMesh*				m_unitMeshes[NUM_DEBUG_PRIMITIVES];
+
+	VertexBuffer*			m_instanceBuffer = nullptr;
+	VertexBuffer*			m_streamBuffer = nullptr;
+	IndexBuffer*			m_streamIndexBuffer = nullptr;
+
+	// Cleared every flush, the capacity is kept
+	std::vector<BatchItemT>			m_items;
+	std::vector<DebugInstanceT>		m_instances;
+	std::vector<Vertex_PCU>			m_quadVertices;			// 4 per quad, top left, top right, bottom left, bottom right
+	std::vector<BatchRunT>			m_runs;
+};
@@ -1,6 +1,8 @@
 //------------------------------------------------------------------------------------------------------------------------------
 #include "Engine/Commons/ErrorWarningAssert.hpp"
 #include "Engine/Renderer/GPUMesh.hpp"
+#include "Engine/Math/VertexPacking.hpp"
+#include <string.h>
 
 //------------------------------------------------------------------------------------------------------------------------------
 GPUMesh::GPUMesh( RenderContext *renderContext )
@@ -38,6 +40,115 @@ void GPUMesh::SetDrawCall( bool useIndexBuffer, uint elemCount )
 	m_useIndexBuffer = useIndexBuffer; 
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+void GPUMesh::UpdatePositionQuantization()
+{
+	if (m_layout != nullptr && m_layout->HasQuantizedPosition())
+	{
+		GetPositionQuantization(m_boundsMins, m_boundsMaxs, &m_positionOffset, &m_positionScale);
+	}
+	else
+	{
+		m_positionOffset = Vec3::ZERO;
+		m_positionScale = Vec3::ONE;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void GPUMesh::SetLODs( const MeshLOD* lods, uint numLODs )
+{
+	if (numLODs < 2)
+	{
+		m_lods.clear();
+		return;
+	}
+
+	m_lods.assign(lods, lods + numLODs);
+	m_elementCount = m_lods[0].m_numIndices;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+uint GPUMesh::SelectLOD( float pixelsPerUnit, float maxPixelError ) const
+{
+	//Coarsest first, errors only grow down the chain
+	for (uint lodIndex = GetLODCount(); lodIndex > 1; lodIndex--)
+	{
+		if (m_lods[lodIndex - 1].m_error * pixelsPerUnit <= maxPixelError)
+		{
+			return lodIndex - 1;
+		}
+	}
+
+	return 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void GPUMesh::CreateIndicesFromCPUMesh( CPUMesh const *mesh )
+{
+	uint numLODs = mesh->GetLODCount();
+	if (numLODs == 0)
+	{
+		m_indexBuffer->CreateStaticFor( mesh->GetIndices(), mesh->GetIndexCount() ); 
+		SetDrawCall( mesh->UsesIndexBuffer(), mesh->GetElementCount() ); 
+		m_lods.clear();
+		return;
+	}
+
+	//One index buffer for every level, draws pick their range out of it
+	uint numIndices = mesh->GetIndexCount();
+	std::vector<uint> indices;
+	indices.reserve(numIndices + mesh->GetLODIndexCount());
+	indices.insert(indices.end(), mesh->GetIndices(), mesh->GetIndices() + numIndices);
+	indices.insert(indices.end(), mesh->GetLODIndices(), mesh->GetLODIndices() + mesh->GetLODIndexCount());
+
+	std::vector<MeshLOD> lods(numLODs + 1);
+	lods[0].m_numIndices = numIndices;
+	for (uint lodIndex = 0; lodIndex < numLODs; lodIndex++)
+	{
+		lods[lodIndex + 1] = mesh->GetLODs()[lodIndex];
+		lods[lodIndex + 1].m_firstIndex += numIndices;
+	}
+
+	m_indexBuffer->CreateStaticFor( indices.data(), static_cast<uint>(indices.size()) );
+	SetDrawCall( true, static_cast<uint>(indices.size()) );
+	SetLODs( lods.data(), static_cast<uint>(lods.size()) );
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC const void* GPUMesh::ConvertForStaticUpload( const BufferLayout* layout, const VertexMaster* vertices, uint numVertices, std::vector<unsigned char>& scratch )
+{
+	if (layout->m_matchesMaster)
+	{
+		return vertices;
+	}
+
+	scratch.resize(static_cast<size_t>(layout->m_stride) * numVertices);
+	layout->m_copyFromMaster(scratch.data(), vertices, numVertices);
+	return scratch.data();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void GPUMesh::CopyVerticesToGPU( const BufferLayout* layout, const VertexMaster* vertices, uint numVertices )
+{
+	void* mappedVertices = m_vertexBuffer->MapForWrite(numVertices, layout->m_stride);
+	if (mappedVertices == nullptr)
+	{
+		return;
+	}
+
+	if (layout->m_matchesMaster)
+	{
+		memcpy(mappedVertices, vertices, static_cast<size_t>(layout->m_stride) * numVertices);
+	}
+	else
+	{
+		layout->m_copyFromMaster(mappedVertices, vertices, numVertices);
+	}
+
+	m_vertexBuffer->Unmap();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
 void GPUMesh::CopyIndices(uint const *indices, uint count)
 {
 	bool result = m_indexBuffer->CreateStaticFor(indices, count);
@@ -50,6 +161,23 @@ void GPUMesh::CopyIndices(uint const *indices, uint count)
 	SetDrawCall((count > 0), (count > 0) ? count : m_elementCount);
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+void GPUMesh::CreateFromVertexData( const void* vertices, const BufferLayout* layout, uint numVertices, const uint* indices, uint numIndices )
+{
+	if (layout == nullptr)
+	{
+		ERROR_AND_DIE("The buffer layout for the vertex data was nullptr!");
+	}
+
+	m_vertexBuffer->CreateStaticForBuffer(vertices, layout->m_stride, numVertices);
+	m_indexBuffer->CreateStaticFor(indices, numIndices);
+
+	m_lods.clear();
+	SetDrawCall((numIndices > 0), (numIndices > 0) ? numIndices : numVertices);
+	m_layout = (BufferLayout*)layout;
+	UpdatePositionQuantization();
+}
+
 /*
 void GPUMesh::CreateFromCPUMesh( CPUMesh const *mesh, eGPUMemoryUsage mem /*= GPU_MEMORY_USAGE_STATIC  )
 {
@@ -33,13 +33,35 @@ public:
 	void					CopyVertexArray(const VertexMaster& verts, uint numVerts);
 	void					CopyIndices( uint const *indices, uint count );                                     
 
+	// Vertices already in the layout's format (cooked PMSH blobs), uploaded straight from the given memory
+	void					CreateFromVertexData( const void* vertices, const BufferLayout* layout, uint numVertices, const uint* indices, uint numIndices );
+
 	void					SetDrawCall( bool useIndexBuffer, uint elemCount ); 
 
+	// Offset and scale from the bounds when the layout's positions are quantized, identity otherwise
+	void					UpdatePositionQuantization();
+
+	// Every level, LOD0 included, as ranges of the index buffer. Fewer than two levels means no LODs.
+	void					SetLODs( const MeshLOD* lods, uint numLODs );
+	// The coarsest level whose error is under maxPixelError when one mesh unit covers pixelsPerUnit pixels
+	uint					SelectLOD( float pixelsPerUnit, float maxPixelError ) const;
+	inline uint				GetLODCount() const { return static_cast<uint>(m_lods.size()); }
+	inline const MeshLOD&	GetLOD( uint lodIndex ) const { return m_lods[lodIndex]; }
+
 	inline bool				UsesIndexBuffer() {return m_useIndexBuffer;}
 	inline uint				GetElementCount() {return m_elementCount;}
 	inline uint				GetVertexCount() {return m_vertexBuffer->GetVertexCount();}
 	inline std::string const&	GetDefaultMaterialName() const { return m_defaultMaterial; } // A09
 
+private:
+	void					CreateIndicesFromCPUMesh( CPUMesh const *mesh );		// LOD0 followed by the mesh's LODs, if it has any
+
+	// Vertices in the layout's format for a static upload: the masters themselves when the layout matches, otherwise
+	// converted into scratch, which the caller keeps alive until the upload is done
+	static const void*		ConvertForStaticUpload( const BufferLayout* layout, const VertexMaster* vertices, uint numVertices, std::vector<unsigned char>& scratch );
+	// Dynamic upload, converted straight into the mapped vertex buffer
+	void					CopyVerticesToGPU( const BufferLayout* layout, const VertexMaster* vertices, uint numVertices );
+
 public: 
 	VertexBuffer*			m_vertexBuffer = nullptr; 
 	IndexBuffer*			m_indexBuffer = nullptr; 
@@ -49,6 +71,16 @@ public:
 	uint					m_elementCount = 0U; 
 	bool					m_useIndexBuffer; 
 	std::string				m_defaultMaterial = "";
+
+	// local space bounds of the CPUMesh this was made from, used for culling
+	Vec3					m_boundsMins = Vec3::ZERO;
+	Vec3					m_boundsMaxs = Vec3::ZERO;
+
+	std::vector<MeshLOD>	m_lods;
+
+	// position = offset + stored * scale, RenderContext hands these to the shader in the model buffer
+	Vec3					m_positionOffset = Vec3::ZERO;
+	Vec3					m_positionScale = Vec3::ONE;
 };
 
 template <typename VertexType>
@@ -61,13 +93,10 @@ void GPUMesh::CopyVertexArray(const VertexMaster& verts, uint numVerts)
 	}
 
 	//We actually have a buffer layout with valid data
-	std::vector<VertexType> vertices;
-
-	vertices.reserve(numVerts);
+	std::vector<unsigned char> scratch;
+	const void* vertices = ConvertForStaticUpload(layout, &verts, numVerts, scratch);
 
-	layout->m_copyFromMaster(vertices.data(), &verts, numVerts);
-
-	bool result = m_vertexBuffer->CreateStaticForBuffer(vertices.data(), layout->m_stride, numVerts);
+	bool result = m_vertexBuffer->CreateStaticForBuffer(vertices, layout->m_stride, numVerts);
 	if (!result)
 	{
 		ERROR_AND_DIE("The vertex buffer could not be created");
@@ -93,19 +122,17 @@ void GPUMesh::CreateFromCPUMesh( CPUMesh const *mesh, eGPUMemoryUsage mem )
 		ERROR_RECOVERABLE("Creating STATIC mesh from CPU but GPU mem type is not static");
 	}
 	//We actually have a buffer layout with valid data
-	std::vector<VertexType> vertices;
-
 	uint vcount = mesh->GetVertexCount(); 
-	vertices.reserve( vcount ); 
+	std::vector<unsigned char> scratch;
+	const void* vertices = ConvertForStaticUpload(layout, mesh->GetVertices(), vcount, scratch);
 
-	layout->m_copyFromMaster(vertices.data(), mesh->GetVertices(), vcount);
+	m_vertexBuffer->CreateStaticForBuffer(vertices, layout->m_stride, vcount);
+	CreateIndicesFromCPUMesh( mesh );
 
-	m_vertexBuffer->CreateStaticForBuffer(vertices.data(), layout->m_stride, vcount);
-	m_indexBuffer->CreateStaticFor( mesh->GetIndices(), mesh->GetIndexCount() ); 
-
-	SetDrawCall( mesh->UsesIndexBuffer(), mesh->GetElementCount() ); 
+	mesh->GetBounds( &m_boundsMins, &m_boundsMaxs );
 
 	m_layout = (BufferLayout*)layout;
+	UpdatePositionQuantization();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -123,16 +150,13 @@ void GPUMesh::CopyFromCPUMesh( CPUMesh const *mesh, eGPUMemoryUsage mem )
 		ERROR_RECOVERABLE("Creating DYNAMIC mesh from CPU but GPU mem type is not Dynamic");
 	}
 
-	std::vector<VertexType> vertices; 
-
-	uint vcount = mesh->GetVertexCount(); 
-	vertices.reserve( vcount ); 
-
-	layout->m_copyFromMaster(vertices.data(), mesh->GetVertices(), vcount);
-
-	m_vertexBuffer->CopyCPUToGPU( vertices.data(), vcount, layout->m_stride);
+	CopyVerticesToGPU( layout, mesh->GetVertices(), mesh->GetVertexCount() );
 	m_indexBuffer->CopyCPUToGPU( mesh->GetIndices(), mesh->GetIndexCount() ); 
 
+	//Dynamic meshes only ever draw LOD0
+	m_lods.clear();
 	SetDrawCall( mesh->UsesIndexBuffer(), mesh->GetElementCount() ); 
-	m_layout = layout;
+	mesh->GetBounds( &m_boundsMins, &m_boundsMaxs );
+	m_layout = (BufferLayout*)layout;
+	UpdatePositionQuantization();
 }
\ No newline at end of file
@@ -44,7 +44,7 @@ bool IndexBuffer::CreateStaticFor( uint const *indices, uint const count )
 bool IndexBuffer::CopyCPUToGPU( uint const *indices, uint const count )
 {
 	// how many bytes do we need
-	size_t sizeNeeded = count * sizeof(Vertex_PCU); 
+	size_t sizeNeeded = count * sizeof(uint); 
 
 	// if we don't have enough room, or this is a static
 	// buffer, recreate (Create should release the old buffer)
@@ -52,7 +52,7 @@ bool IndexBuffer::CopyCPUToGPU( uint const *indices, uint const count )
 	{
 		bool result = CreateBuffer( indices, 
 			sizeNeeded,        // total size needed for buffer?
-			sizeof(Vertex_PCU), // stride - size from one vertex to another
+			sizeof(uint), // stride - size from one index to another
 			RENDER_BUFFER_USAGE_INDEX_STREAM_BIT, 
 			GPU_MEMORY_USAGE_DYNAMIC ); // probably want dynamic if we're using copy
 
@@ -82,3 +82,28 @@ bool IndexBuffer::CopyCPUToGPU( uint const *indices, uint const count )
 	return false;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+uint* IndexBuffer::MapForWrite( uint const count )
+{
+	size_t sizeNeeded = count * sizeof(uint); 
+	if (sizeNeeded == 0)
+	{
+		m_indexCount = 0U;
+		return nullptr;
+	}
+
+	// same rules as CopyCPUToGPU, only made (without data) when it is too small or static
+	if (sizeNeeded > GetSize() || IsStatic()) 
+	{
+		if (!CreateBuffer( nullptr, sizeNeeded, sizeof(uint), RENDER_BUFFER_USAGE_INDEX_STREAM_BIT, GPU_MEMORY_USAGE_DYNAMIC ))
+		{
+			m_indexCount = 0U;
+			return nullptr;
+		}
+	}
+
+	uint* indices = reinterpret_cast<uint*>(RenderBuffer::MapForWrite());
+	m_indexCount = (indices != nullptr) ? count : 0U;
+	return indices;
+}
+
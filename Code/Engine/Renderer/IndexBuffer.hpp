@@ -13,6 +13,9 @@ public:
 	bool CreateStaticFor( uint const *indices, uint const count );          // A04
 	bool CopyCPUToGPU( uint const *indices, uint const count );            // A04
 
+	// Like CopyCPUToGPU but hands back the mapped memory so indices can be written straight into it. Finish with Unmap.
+	uint* MapForWrite( uint const count );
+
 	inline uint	GetIndexCount() {return m_indexCount;}
 
 public: 
@@ -0,0 +1,549 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/MeshOptimizer.hpp"
+//Engine Systems
+#include "Engine/Math/MathUtils.hpp"
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr uint		MESH_OPTIMIZER_INVALID_INDEX = 0xFFFFFFFFU;
+
+//Forsyth's tuned values, the cache here is the optimizer's model and is deliberately larger than the FIFO we measure with
+constexpr int		FORSYTH_CACHE_SIZE = 32;
+constexpr float		FORSYTH_CACHE_DECAY_POWER = 1.5f;
+constexpr float		FORSYTH_LAST_TRIANGLE_SCORE = 0.75f;
+constexpr float		FORSYTH_VALENCE_BOOST_SCALE = 2.0f;
+constexpr float		FORSYTH_VALENCE_BOOST_POWER = 0.5f;
+constexpr uint		FORSYTH_MAX_TABLED_VALENCE = 64;
+
+//------------------------------------------------------------------------------------------------------------------------------
+static uint HashVertex( const VertexMaster& vertex )
+{
+	//FNV-1a over the bytes, VertexMaster is all floats so there is no padding to worry about
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&vertex);
+	uint hash = 2166136261U;
+
+	for (size_t byteIndex = 0; byteIndex < sizeof(VertexMaster); byteIndex++)
+	{
+		hash ^= bytes[byteIndex];
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void MakeZerosPositive( VertexMaster& vertex )
+{
+	float* values = reinterpret_cast<float*>(&vertex);
+	for (size_t valueIndex = 0; valueIndex < sizeof(VertexMaster) / sizeof(float); valueIndex++)
+	{
+		if (values[valueIndex] == 0.f)
+		{
+			values[valueIndex] = 0.f;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+uint WeldVertices( std::vector<VertexMaster>& vertices, std::vector<uint>& indices )
+{
+	static_assert(sizeof(VertexMaster) % sizeof(float) == 0, "Welding compares VertexMaster as raw floats");
+
+	uint numVertices = static_cast<uint>(vertices.size());
+	uint tableSize = 2;
+	while (tableSize < numVertices * 2)
+	{
+		tableSize <<= 1;
+	}
+
+	//Open addressing, slots hold the index of the kept vertex. Kept vertices are compacted to the front as we go,
+	//which only ever overwrites vertices that were already looked at.
+	std::vector<uint> table(tableSize, MESH_OPTIMIZER_INVALID_INDEX);
+	std::vector<uint> remap(numVertices);
+	uint numUnique = 0;
+
+	for (uint vertexIndex = 0; vertexIndex < numVertices; vertexIndex++)
+	{
+		//-0 and 0 are the same vertex but not the same bytes, the transforms in the loader make plenty of -0
+		MakeZerosPositive(vertices[vertexIndex]);
+
+		uint slot = HashVertex(vertices[vertexIndex]) & (tableSize - 1);
+		while (true)
+		{
+			uint candidate = table[slot];
+			if (candidate == MESH_OPTIMIZER_INVALID_INDEX)
+			{
+				table[slot] = numUnique;
+				vertices[numUnique] = vertices[vertexIndex];
+				remap[vertexIndex] = numUnique++;
+				break;
+			}
+
+			if (memcmp(&vertices[candidate], &vertices[vertexIndex], sizeof(VertexMaster)) == 0)
+			{
+				remap[vertexIndex] = candidate;
+				break;
+			}
+
+			slot = (slot + 1) & (tableSize - 1);
+		}
+	}
+
+	for (uint& index : indices)
+	{
+		index = remap[index];
+	}
+
+	vertices.resize(numUnique);
+	return numUnique;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct ForsythScoreTables
+{
+	float	m_cacheScores[FORSYTH_CACHE_SIZE];
+	float	m_valenceScores[FORSYTH_MAX_TABLED_VALENCE + 1];
+
+	ForsythScoreTables()
+	{
+		for (int cachePosition = 0; cachePosition < FORSYTH_CACHE_SIZE; cachePosition++)
+		{
+			if (cachePosition < 3)
+			{
+				//The last triangle's vertices get a fixed score so the optimizer doesn't just fan around one vertex
+				m_cacheScores[cachePosition] = FORSYTH_LAST_TRIANGLE_SCORE;
+			}
+			else
+			{
+				float scaler = 1.f / static_cast<float>(FORSYTH_CACHE_SIZE - 3);
+				m_cacheScores[cachePosition] = powf(1.f - static_cast<float>(cachePosition - 3) * scaler, FORSYTH_CACHE_DECAY_POWER);
+			}
+		}
+
+		m_valenceScores[0] = 0.f;
+		for (uint valence = 1; valence <= FORSYTH_MAX_TABLED_VALENCE; valence++)
+		{
+			m_valenceScores[valence] = FORSYTH_VALENCE_BOOST_SCALE * powf(static_cast<float>(valence), -FORSYTH_VALENCE_BOOST_POWER);
+		}
+	}
+
+	//Vertices with few triangles left are boosted so lone triangles don't get stranded
+	float GetVertexScore( int cachePosition, uint liveTriangles ) const
+	{
+		if (liveTriangles == 0)
+		{
+			return -1.f;
+		}
+
+		float score = (cachePosition >= 0) ? m_cacheScores[cachePosition] : 0.f;
+		if (liveTriangles <= FORSYTH_MAX_TABLED_VALENCE)
+		{
+			score += m_valenceScores[liveTriangles];
+		}
+		else
+		{
+			score += FORSYTH_VALENCE_BOOST_SCALE * powf(static_cast<float>(liveTriangles), -FORSYTH_VALENCE_BOOST_POWER);
+		}
+
+		return score;
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Greedy: always emit the best scoring triangle that touches the cache, only scanning the input when nothing does
+//------------------------------------------------------------------------------------------------------------------------------
+void OptimizeVertexCache( uint* indices, uint numIndices, uint numVertices )
+{
+	static const ForsythScoreTables s_scoreTables;
+
+	uint numTriangles = numIndices / 3;
+	if (numTriangles == 0)
+	{
+		return;
+	}
+
+	//Triangles per vertex as offsets into one adjacency array, live triangles are kept at the front of each range
+	std::vector<uint> liveTriangles(numVertices, 0);
+	for (uint index = 0; index < numTriangles * 3; index++)
+	{
+		liveTriangles[indices[index]]++;
+	}
+
+	std::vector<uint> adjacencyOffsets(numVertices + 1, 0);
+	for (uint vertexIndex = 0; vertexIndex < numVertices; vertexIndex++)
+	{
+		adjacencyOffsets[vertexIndex + 1] = adjacencyOffsets[vertexIndex] + liveTriangles[vertexIndex];
+	}
+
+	std::vector<uint> adjacency(numTriangles * 3);
+	std::vector<uint> fillCounts(numVertices, 0);
+	for (uint triangleIndex = 0; triangleIndex < numTriangles; triangleIndex++)
+	{
+		for (uint corner = 0; corner < 3; corner++)
+		{
+			uint vertexIndex = indices[triangleIndex * 3 + corner];
+			adjacency[adjacencyOffsets[vertexIndex] + fillCounts[vertexIndex]++] = triangleIndex;
+		}
+	}
+
+	std::vector<int> cachePositions(numVertices, -1);
+	std::vector<float> vertexScores(numVertices);
+	for (uint vertexIndex = 0; vertexIndex < numVertices; vertexIndex++)
+	{
+		vertexScores[vertexIndex] = s_scoreTables.GetVertexScore(-1, liveTriangles[vertexIndex]);
+	}
+
+	std::vector<float> triangleScores(numTriangles);
+	std::vector<char> isEmitted(numTriangles, 0);
+	uint bestTriangle = 0;
+	for (uint triangleIndex = 0; triangleIndex < numTriangles; triangleIndex++)
+	{
+		const uint* triangle = &indices[triangleIndex * 3];
+		triangleScores[triangleIndex] = vertexScores[triangle[0]] + vertexScores[triangle[1]] + vertexScores[triangle[2]];
+		if (triangleScores[triangleIndex] > triangleScores[bestTriangle])
+		{
+			bestTriangle = triangleIndex;
+		}
+	}
+
+	std::vector<uint> output(numTriangles * 3);
+	uint cache[FORSYTH_CACHE_SIZE + 3];
+	uint cacheCount = 0;
+	uint inputCursor = 0;
+
+	for (uint outputTriangle = 0; outputTriangle < numTriangles; outputTriangle++)
+	{
+		if (bestTriangle == MESH_OPTIMIZER_INVALID_INDEX)
+		{
+			while (isEmitted[inputCursor])
+			{
+				inputCursor++;
+			}
+			bestTriangle = inputCursor;
+		}
+
+		const uint* triangle = &indices[bestTriangle * 3];
+		output[outputTriangle * 3 + 0] = triangle[0];
+		output[outputTriangle * 3 + 1] = triangle[1];
+		output[outputTriangle * 3 + 2] = triangle[2];
+		isEmitted[bestTriangle] = 1;
+
+		//The triangle's vertices move to the front of the LRU cache, everything else shifts back
+		uint newCache[FORSYTH_CACHE_SIZE + 3];
+		uint newCacheCount = 0;
+		for (uint corner = 0; corner < 3; corner++)
+		{
+			if (std::find(newCache, newCache + newCacheCount, triangle[corner]) == newCache + newCacheCount)
+			{
+				newCache[newCacheCount++] = triangle[corner];
+			}
+		}
+
+		for (uint cacheIndex = 0; cacheIndex < cacheCount; cacheIndex++)
+		{
+			if (std::find(newCache, newCache + newCacheCount, cache[cacheIndex]) == newCache + newCacheCount)
+			{
+				newCache[newCacheCount++] = cache[cacheIndex];
+			}
+		}
+
+		//Swap the emitted triangle out of each corner's live range
+		for (uint corner = 0; corner < 3; corner++)
+		{
+			uint vertexIndex = triangle[corner];
+			uint* liveBegin = &adjacency[adjacencyOffsets[vertexIndex]];
+			uint* liveEnd = liveBegin + liveTriangles[vertexIndex];
+			uint* found = std::find(liveBegin, liveEnd, bestTriangle);
+			if (found != liveEnd)
+			{
+				*found = *(liveEnd - 1);
+				liveTriangles[vertexIndex]--;
+			}
+		}
+
+		//Vertices pushed out of the cache still need their score dropped, so they are updated too
+		for (uint cacheIndex = 0; cacheIndex < newCacheCount; cacheIndex++)
+		{
+			uint vertexIndex = newCache[cacheIndex];
+			int cachePosition = (cacheIndex < static_cast<uint>(FORSYTH_CACHE_SIZE)) ? static_cast<int>(cacheIndex) : -1;
+			cachePositions[vertexIndex] = cachePosition;
+			vertexScores[vertexIndex] = s_scoreTables.GetVertexScore(cachePosition, liveTriangles[vertexIndex]);
+		}
+
+		bestTriangle = MESH_OPTIMIZER_INVALID_INDEX;
+		float bestScore = -1.f;
+		for (uint cacheIndex = 0; cacheIndex < newCacheCount; cacheIndex++)
+		{
+			uint vertexIndex = newCache[cacheIndex];
+			const uint* liveBegin = &adjacency[adjacencyOffsets[vertexIndex]];
+			for (uint liveIndex = 0; liveIndex < liveTriangles[vertexIndex]; liveIndex++)
+			{
+				uint triangleIndex = liveBegin[liveIndex];
+				const uint* liveTriangle = &indices[triangleIndex * 3];
+				float score = vertexScores[liveTriangle[0]] + vertexScores[liveTriangle[1]] + vertexScores[liveTriangle[2]];
+				triangleScores[triangleIndex] = score;
+				if (score > bestScore)
+				{
+					bestScore = score;
+					bestTriangle = triangleIndex;
+				}
+			}
+		}
+
+		cacheCount = std::min(newCacheCount, static_cast<uint>(FORSYTH_CACHE_SIZE));
+		memcpy(cache, newCache, cacheCount * sizeof(uint));
+	}
+
+	memcpy(indices, output.data(), output.size() * sizeof(uint));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// FIFO cache model, a vertex is a hit if it was transformed fewer than cacheSize misses ago
+//------------------------------------------------------------------------------------------------------------------------------
+struct FIFOCacheModel
+{
+	std::vector<uint>	m_timestamps;
+	uint				m_cacheSize = MESH_OPTIMIZER_CACHE_SIZE;
+	uint				m_time = 0;
+
+	FIFOCacheModel( uint numVertices, uint cacheSize )
+		:	m_timestamps(numVertices, 0),
+			m_cacheSize(cacheSize),
+			m_time(cacheSize + 1)
+	{
+	}
+
+	void Reset()
+	{
+		m_time += m_cacheSize + 1;
+	}
+
+	uint AddTriangle( const uint* triangle )
+	{
+		uint misses = 0;
+		for (uint corner = 0; corner < 3; corner++)
+		{
+			if (m_time - m_timestamps[triangle[corner]] > m_cacheSize)
+			{
+				m_timestamps[triangle[corner]] = m_time++;
+				misses++;
+			}
+		}
+
+		return misses;
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+float ComputeACMR( const uint* indices, uint numIndices, uint numVertices, uint cacheSize )
+{
+	uint numTriangles = numIndices / 3;
+	if (numTriangles == 0)
+	{
+		return 0.f;
+	}
+
+	FIFOCacheModel cacheModel(numVertices, cacheSize);
+	uint misses = 0;
+	for (uint triangleIndex = 0; triangleIndex < numTriangles; triangleIndex++)
+	{
+		misses += cacheModel.AddTriangle(&indices[triangleIndex * 3]);
+	}
+
+	return static_cast<float>(misses) / static_cast<float>(numTriangles);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct OverdrawCluster
+{
+	uint	m_firstTriangle = 0;
+	uint	m_numTriangles = 0;
+	float	m_sortKey = 0.f;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Expects the vertex cache optimized order. Clusters are runs of that order which can be moved around without costing
+// more than threshold times the ACMR, they are then drawn in order of how far out they face from the mesh center.
+//------------------------------------------------------------------------------------------------------------------------------
+void OptimizeOverdraw( uint* indices, uint numIndices, const VertexMaster* vertices, uint numVertices, float threshold )
+{
+	uint numTriangles = numIndices / 3;
+	if (numTriangles == 0)
+	{
+		return;
+	}
+
+	//Hard boundaries: triangles where the cache was cold anyway, cutting there costs nothing
+	std::vector<uint> hardBoundaries;
+	FIFOCacheModel cacheModel(numVertices, MESH_OPTIMIZER_CACHE_SIZE);
+	for (uint triangleIndex = 0; triangleIndex < numTriangles; triangleIndex++)
+	{
+		if (cacheModel.AddTriangle(&indices[triangleIndex * 3]) == 3)
+		{
+			hardBoundaries.push_back(triangleIndex);
+		}
+	}
+	hardBoundaries.push_back(numTriangles);
+
+	//Soft boundaries: inside each hard cluster, cut once the run so far is within threshold of the cluster's ACMR
+	std::vector<OverdrawCluster> clusters;
+	for (uint boundaryIndex = 0; boundaryIndex + 1 < hardBoundaries.size(); boundaryIndex++)
+	{
+		uint clusterStart = hardBoundaries[boundaryIndex];
+		uint clusterEnd = hardBoundaries[boundaryIndex + 1];
+
+		cacheModel.Reset();
+		uint clusterMisses = 0;
+		for (uint triangleIndex = clusterStart; triangleIndex < clusterEnd; triangleIndex++)
+		{
+			clusterMisses += cacheModel.AddTriangle(&indices[triangleIndex * 3]);
+		}
+
+		float clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>(clusterEnd - clusterStart);
+
+		cacheModel.Reset();
+		uint runStart = clusterStart;
+		uint runMisses = 0;
+		for (uint triangleIndex = clusterStart; triangleIndex < clusterEnd; triangleIndex++)
+		{
+			runMisses += cacheModel.AddTriangle(&indices[triangleIndex * 3]);
+			uint runTriangles = triangleIndex + 1 - runStart;
+
+			if (triangleIndex + 1 < clusterEnd && static_cast<float>(runMisses) <= clusterThreshold * static_cast<float>(runTriangles))
+			{
+				OverdrawCluster cluster;
+				cluster.m_firstTriangle = runStart;
+				cluster.m_numTriangles = runTriangles;
+				clusters.push_back(cluster);
+
+				cacheModel.Reset();
+				runStart = triangleIndex + 1;
+				runMisses = 0;
+			}
+		}
+
+		OverdrawCluster cluster;
+		cluster.m_firstTriangle = runStart;
+		cluster.m_numTriangles = clusterEnd - runStart;
+		clusters.push_back(cluster);
+	}
+
+	//Area weighted centroids and normals, the cross product length is already twice the area
+	Vec3 meshCentroid = Vec3::ZERO;
+	float meshArea = 0.f;
+	std::vector<Vec3> clusterCentroids(clusters.size(), Vec3::ZERO);
+	std::vector<Vec3> clusterNormals(clusters.size(), Vec3::ZERO);
+	for (size_t clusterIndex = 0; clusterIndex < clusters.size(); clusterIndex++)
+	{
+		const OverdrawCluster& cluster = clusters[clusterIndex];
+		float clusterArea = 0.f;
+
+		for (uint triangleIndex = cluster.m_firstTriangle; triangleIndex < cluster.m_firstTriangle + cluster.m_numTriangles; triangleIndex++)
+		{
+			const Vec3& a = vertices[indices[triangleIndex * 3 + 0]].m_position;
+			const Vec3& b = vertices[indices[triangleIndex * 3 + 1]].m_position;
+			const Vec3& c = vertices[indices[triangleIndex * 3 + 2]].m_position;
+
+			Vec3 normal = GetCrossProduct(b - a, c - a);
+			float area = normal.GetLength();
+			Vec3 center = (a + b + c) / 3.f;
+
+			clusterCentroids[clusterIndex] += center * area;
+			clusterNormals[clusterIndex] += normal;
+			clusterArea += area;
+		}
+
+		meshCentroid += clusterCentroids[clusterIndex];
+		meshArea += clusterArea;
+		if (clusterArea > 0.f)
+		{
+			clusterCentroids[clusterIndex] /= clusterArea;
+		}
+	}
+
+	if (meshArea > 0.f)
+	{
+		meshCentroid /= meshArea;
+	}
+
+	for (size_t clusterIndex = 0; clusterIndex < clusters.size(); clusterIndex++)
+	{
+		float normalLength = clusterNormals[clusterIndex].GetLength();
+		Vec3 normal = (normalLength > 0.f) ? clusterNormals[clusterIndex] / normalLength : Vec3::ZERO;
+		clusters[clusterIndex].m_sortKey = GetDotProduct(clusterCentroids[clusterIndex] - meshCentroid, normal);
+	}
+
+	//Outward facing clusters first, they are the ones most likely to hide the rest
+	std::stable_sort(clusters.begin(), clusters.end(), [](const OverdrawCluster& a, const OverdrawCluster& b)
+	{
+		return a.m_sortKey > b.m_sortKey;
+	});
+
+	std::vector<uint> output;
+	output.reserve(numTriangles * 3);
+	for (const OverdrawCluster& cluster : clusters)
+	{
+		output.insert(output.end(), indices + cluster.m_firstTriangle * 3, indices + (cluster.m_firstTriangle + cluster.m_numTriangles) * 3);
+	}
+
+	memcpy(indices, output.data(), output.size() * sizeof(uint));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+uint OptimizeVertexFetch( std::vector<VertexMaster>& vertices, std::vector<uint>& indices )
+{
+	std::vector<uint> remap(vertices.size(), MESH_OPTIMIZER_INVALID_INDEX);
+	uint numUsed = 0;
+
+	for (uint& index : indices)
+	{
+		if (remap[index] == MESH_OPTIMIZER_INVALID_INDEX)
+		{
+			remap[index] = numUsed++;
+		}
+		index = remap[index];
+	}
+
+	std::vector<VertexMaster> reordered(numUsed);
+	for (size_t vertexIndex = 0; vertexIndex < vertices.size(); vertexIndex++)
+	{
+		if (remap[vertexIndex] != MESH_OPTIMIZER_INVALID_INDEX)
+		{
+			reordered[remap[vertexIndex]] = vertices[vertexIndex];
+		}
+	}
+
+	vertices.swap(reordered);
+	return numUsed;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void OptimizeMesh( std::vector<VertexMaster>& vertices, std::vector<uint>& indices, MeshOptimizerStats* outStats )
+{
+	MeshOptimizerStats stats;
+	stats.m_verticesBefore = static_cast<uint>(vertices.size());
+	stats.m_numIndices = static_cast<uint>(indices.size());
+	stats.m_acmrBefore = ComputeACMR(indices.data(), stats.m_numIndices, stats.m_verticesBefore);
+
+	if (indices.size() >= 3)
+	{
+		uint numVertices = WeldVertices(vertices, indices);
+		OptimizeVertexCache(indices.data(), stats.m_numIndices, numVertices);
+		OptimizeOverdraw(indices.data(), stats.m_numIndices, vertices.data(), numVertices);
+		OptimizeVertexFetch(vertices, indices);
+	}
+
+	stats.m_verticesAfter = static_cast<uint>(vertices.size());
+	stats.m_acmrAfter = ComputeACMR(indices.data(), stats.m_numIndices, stats.m_verticesAfter);
+	if (stats.m_verticesAfter > 0)
+	{
+		stats.m_atvrAfter = stats.m_acmrAfter * static_cast<float>(stats.m_numIndices / 3) / static_cast<float>(stats.m_verticesAfter);
+	}
+
+	if (outStats != nullptr)
+	{
+		*outStats = stats;
+	}
+}
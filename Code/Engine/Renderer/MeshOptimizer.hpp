@@ -0,0 +1,45 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+//Engine Systems
+#include "Engine/Math/VertexMaster.hpp"
+#include <vector>
+
+typedef unsigned int uint;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Index buffer and vertex order optimization for imported meshes. Meant for cook time, none of it is cheap enough
+// to run every load. The stages run in this order:
+//
+//	1) Weld: identical vertices are merged so triangles share them (importers emit one vertex per face corner)
+//	2) Vertex cache: triangles are reordered so recently transformed vertices are reused (Forsyth's linear speed
+//	   vertex cache optimization)
+//	3) Overdraw: the cache friendly order is cut into clusters which are drawn outermost first, so more of the mesh
+//	   is rejected by the depth test (Sander et al, Fast Triangle Reordering for Vertex Locality and Reduced Overdraw)
+//	4) Vertex fetch: vertices are renumbered in the order the index buffer first reads them
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr uint		MESH_OPTIMIZER_CACHE_SIZE = 16;				// FIFO size used when simulating the post transform cache
+constexpr float		MESH_OPTIMIZER_OVERDRAW_THRESHOLD = 1.05f;	// how much ACMR the overdraw pass may give up
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct MeshOptimizerStats
+{
+	uint		m_verticesBefore = 0;
+	uint		m_verticesAfter = 0;
+	uint		m_numIndices = 0;
+	float		m_acmrBefore = 0.f;			// average cache miss ratio, transformed vertices per triangle (0.5 is ideal, 3 is worst)
+	float		m_acmrAfter = 0.f;
+	float		m_atvrAfter = 0.f;			// average transform to vertex ratio, 1 means every vertex is transformed exactly once
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Returns the new vertex count, indices are remapped in place
+uint		WeldVertices(std::vector<VertexMaster>& vertices, std::vector<uint>& indices);
+void		OptimizeVertexCache(uint* indices, uint numIndices, uint numVertices);
+void		OptimizeOverdraw(uint* indices, uint numIndices, const VertexMaster* vertices, uint numVertices, float threshold = MESH_OPTIMIZER_OVERDRAW_THRESHOLD);
+// Returns the new vertex count, unreferenced vertices are dropped
+uint		OptimizeVertexFetch(std::vector<VertexMaster>& vertices, std::vector<uint>& indices);
+
+float		ComputeACMR(const uint* indices, uint numIndices, uint numVertices, uint cacheSize = MESH_OPTIMIZER_CACHE_SIZE);
+
+// All of the above, in order. Expects a triangle list.
+void		OptimizeMesh(std::vector<VertexMaster>& vertices, std::vector<uint>& indices, MeshOptimizerStats* outStats = nullptr);
@@ -0,0 +1,878 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/MeshSimplifier.hpp"
+//Engine Systems
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Renderer/MeshOptimizer.hpp"
+#include <algorithm>
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr uint		MESH_SIMPLIFIER_INVALID_INDEX = 0xFFFFFFFFU;
+constexpr double	MESH_SIMPLIFIER_BORDER_WEIGHT = 10.0;		// open border edges hold their shape much harder than faces
+constexpr double	MESH_SIMPLIFIER_SEAM_WEIGHT = 1.0;			// seams can only collapse along themselves anyway
+constexpr float		MESH_SIMPLIFIER_MAX_NORMAL_TURN = 0.25f;		// cosine, collapses that turn a triangle further are flips
+constexpr float		MESH_SIMPLIFIER_MIN_TRIANGLE_SHAPE = 1e-3f;	// twice the area over the longest edge squared, flatter counts as no area
+constexpr float		MESH_SIMPLIFIER_PASS_ERROR_SCALE = 1.5f;		// how far past the goal's error a pass may go
+
+//------------------------------------------------------------------------------------------------------------------------------
+enum eSimplifierVertexKind : unsigned char
+{
+	SIMPLIFIER_VERTEX_MANIFOLD = 0,		// one wedge, closed fan, can collapse onto any neighbour
+	SIMPLIFIER_VERTEX_BORDER,			// one wedge on an open border, only collapses along it
+	SIMPLIFIER_VERTEX_SEAM,				// two wedges either side of a UV or normal seam, only collapses along it
+	SIMPLIFIER_VERTEX_LOCKED			// corners, seam junctions and anything non manifold
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The plane distances squared form of a quadric, in doubles since the plane terms cancel badly far from the origin
+//------------------------------------------------------------------------------------------------------------------------------
+struct SimplifierQuadric
+{
+	double		m_a00 = 0.0;
+	double		m_a11 = 0.0;
+	double		m_a22 = 0.0;
+	double		m_a10 = 0.0;
+	double		m_a20 = 0.0;
+	double		m_a21 = 0.0;
+	double		m_b0 = 0.0;
+	double		m_b1 = 0.0;
+	double		m_b2 = 0.0;
+	double		m_c = 0.0;
+	double		m_weight = 0.0;
+
+	void AddPlane( const Vec3& normal, double distance, double weight )
+	{
+		double x = normal.x;
+		double y = normal.y;
+		double z = normal.z;
+
+		m_a00 += weight * x * x;
+		m_a11 += weight * y * y;
+		m_a22 += weight * z * z;
+		m_a10 += weight * y * x;
+		m_a20 += weight * z * x;
+		m_a21 += weight * z * y;
+		m_b0 += weight * x * distance;
+		m_b1 += weight * y * distance;
+		m_b2 += weight * z * distance;
+		m_c += weight * distance * distance;
+		m_weight += weight;
+	}
+
+	void Add( const SimplifierQuadric& other )
+	{
+		m_a00 += other.m_a00;
+		m_a11 += other.m_a11;
+		m_a22 += other.m_a22;
+		m_a10 += other.m_a10;
+		m_a20 += other.m_a20;
+		m_a21 += other.m_a21;
+		m_b0 += other.m_b0;
+		m_b1 += other.m_b1;
+		m_b2 += other.m_b2;
+		m_c += other.m_c;
+		m_weight += other.m_weight;
+	}
+
+	//Weighted mean of the squared distances to the planes
+	float GetError( const Vec3& position ) const
+	{
+		double x = position.x;
+		double y = position.y;
+		double z = position.z;
+
+		double rx = m_a00 * x + m_a10 * y + m_a20 * z;
+		double ry = m_a10 * x + m_a11 * y + m_a21 * z;
+		double rz = m_a20 * x + m_a21 * y + m_a22 * z;
+
+		double error = rx * x + ry * y + rz * z + 2.0 * (m_b0 * x + m_b1 * y + m_b2 * z) + m_c;
+		error = fabs(error);
+
+		return static_cast<float>((m_weight > 0.0) ? error / m_weight : error);
+	}
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct SimplifierCollapse
+{
+	uint		m_from = 0;					// position ids, the first vertex of each position
+	uint		m_to = 0;
+	float		m_error = 0.f;				// squared
+
+	bool operator<( const SimplifierCollapse& other ) const		{ return m_error < other.m_error; }
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Everything SimplifyMesh works with. Vertices that share a position are wedges of that position; they're kept in a
+// ring through m_nextWedge and the first of them is the position id the quadrics and kinds are stored under.
+//------------------------------------------------------------------------------------------------------------------------------
+struct MeshSimplifier
+{
+	const VertexMaster*					m_vertices = nullptr;
+	uint								m_numVertices = 0;
+	std::vector<uint>&					m_indices;
+
+	std::vector<uint>					m_positionIds;
+	std::vector<uint>					m_nextWedge;
+	std::vector<SimplifierQuadric>		m_quadrics;
+	std::vector<uint>					m_collapsedInto;	// per position id, where it went (itself if it's still there)
+
+	//Rebuilt every pass from the current indices
+	std::vector<unsigned char>			m_kinds;
+	std::vector<unsigned char>			m_isReferenced;		// wedges left unused by earlier collapses (or never used) don't count
+	std::vector<uint>					m_openNext;			// per wedge, where its one open edge goes (or comes from)
+	std::vector<uint>					m_openPrev;
+	std::vector<uint64_t>				m_wedgeEdges;		// sorted, for lookups
+	std::vector<uint64_t>				m_positionEdges;
+	std::vector<uint>					m_triangleOffsets;	// triangles around each position id
+	std::vector<uint>					m_triangles;
+
+	std::vector<unsigned char>			m_isLocked;			// already moved this pass
+	std::vector<uint>					m_wedgeTargets;		// scratch for one collapse, pairs of from and to
+
+	explicit MeshSimplifier( std::vector<uint>& indices ) : m_indices(indices) {}
+
+	inline const Vec3& GetPosition( uint vertex ) const		{ return m_vertices[vertex].m_position; }
+
+	void	BuildPositionIds();
+	void	ClassifyVertices();
+	void	AddQuadrics();
+	void	BuildTriangleAdjacency();
+	void	GatherCollapses( std::vector<SimplifierCollapse>& outCollapses ) const;
+	bool	CanCollapse( uint from, uint to ) const;
+	bool	FindWedgeTargets( uint from, uint to );
+	bool	HasTriangleFlips( uint from, uint to ) const;
+	uint	PerformCollapse( uint from, uint to );
+	void	RemoveDegenerateTriangles();
+	float	GetMaxSourceDistance();
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Closest point on a triangle (Ericson, Real-Time Collision Detection 5.1.5), returned as the distance squared to it
+//------------------------------------------------------------------------------------------------------------------------------
+static float GetDistanceSquaredToTriangle( const Vec3& point, const Vec3& a, const Vec3& b, const Vec3& c )
+{
+	Vec3 ab = b - a;
+	Vec3 ac = c - a;
+	Vec3 ap = point - a;
+	float d1 = GetDotProduct(ab, ap);
+	float d2 = GetDotProduct(ac, ap);
+	if (d1 <= 0.f && d2 <= 0.f)
+	{
+		return ap.GetLengthSquared();
+	}
+
+	Vec3 bp = point - b;
+	float d3 = GetDotProduct(ab, bp);
+	float d4 = GetDotProduct(ac, bp);
+	if (d3 >= 0.f && d4 <= d3)
+	{
+		return bp.GetLengthSquared();
+	}
+
+	float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f)
+	{
+		return (ap - ab * (d1 / (d1 - d3))).GetLengthSquared();
+	}
+
+	Vec3 cp = point - c;
+	float d5 = GetDotProduct(ab, cp);
+	float d6 = GetDotProduct(ac, cp);
+	if (d6 >= 0.f && d5 <= d6)
+	{
+		return cp.GetLengthSquared();
+	}
+
+	float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f)
+	{
+		return (ap - ac * (d2 / (d2 - d6))).GetLengthSquared();
+	}
+
+	float va = d3 * d6 - d5 * d4;
+	if (va <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f)
+	{
+		return (bp - (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)))).GetLengthSquared();
+	}
+
+	float denominator = va + vb + vc;
+	if (denominator <= 0.f)
+	{
+		//Zero area, the edges above already covered it
+		return std::min(ap.GetLengthSquared(), std::min(bp.GetLengthSquared(), cp.GetLengthSquared()));
+	}
+
+	return (ap - ab * (vb / denominator) - ac * (vc / denominator)).GetLengthSquared();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static inline uint64_t MakeEdgeKey( uint from, uint to )
+{
+	return (static_cast<uint64_t>(from) << 32) | static_cast<uint64_t>(to);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static inline bool HasEdge( const std::vector<uint64_t>& sortedEdges, uint from, uint to )
+{
+	return std::binary_search(sortedEdges.begin(), sortedEdges.end(), MakeEdgeKey(from, to));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static uint HashPosition( const Vec3& position )
+{
+	//-0 and 0 are the same position but not the same bytes
+	float values[3] = { position.x, position.y, position.z };
+	for (int axis = 0; axis < 3; axis++)
+	{
+		values[axis] = (values[axis] == 0.f) ? 0.f : values[axis];
+	}
+
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(values);
+	uint hash = 2166136261U;
+
+	for (size_t byteIndex = 0; byteIndex < sizeof(values); byteIndex++)
+	{
+		hash ^= bytes[byteIndex];
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void MeshSimplifier::BuildPositionIds()
+{
+	uint tableSize = 2;
+	while (tableSize < m_numVertices * 2)
+	{
+		tableSize <<= 1;
+	}
+
+	std::vector<uint> table(tableSize, MESH_SIMPLIFIER_INVALID_INDEX);
+	m_positionIds.resize(m_numVertices);
+	m_nextWedge.resize(m_numVertices);
+
+	for (uint vertexIndex = 0; vertexIndex < m_numVertices; vertexIndex++)
+	{
+		const Vec3& position = GetPosition(vertexIndex);
+
+		uint slot = HashPosition(position) & (tableSize - 1);
+		while (true)
+		{
+			uint candidate = table[slot];
+			if (candidate == MESH_SIMPLIFIER_INVALID_INDEX)
+			{
+				table[slot] = vertexIndex;
+				m_positionIds[vertexIndex] = vertexIndex;
+				m_nextWedge[vertexIndex] = vertexIndex;
+				break;
+			}
+
+			const Vec3& candidatePosition = GetPosition(candidate);
+			if (candidatePosition.x == position.x && candidatePosition.y == position.y && candidatePosition.z == position.z)
+			{
+				m_positionIds[vertexIndex] = candidate;
+				m_nextWedge[vertexIndex] = m_nextWedge[candidate];
+				m_nextWedge[candidate] = vertexIndex;
+				break;
+			}
+
+			slot = (slot + 1) & (tableSize - 1);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// An open edge is a half edge whose opposite isn't in the mesh. Across a seam it is there between the positions but
+// not between the wedges, on a border it isn't there at all.
+//------------------------------------------------------------------------------------------------------------------------------
+void MeshSimplifier::ClassifyVertices()
+{
+	uint numIndices = static_cast<uint>(m_indices.size());
+
+	m_wedgeEdges.clear();
+	m_positionEdges.clear();
+	m_wedgeEdges.reserve(numIndices);
+	m_positionEdges.reserve(numIndices);
+
+	for (uint index = 0; index < numIndices; index++)
+	{
+		uint from = m_indices[index];
+		uint to = m_indices[(index % 3 == 2) ? index - 2 : index + 1];
+
+		m_wedgeEdges.push_back(MakeEdgeKey(from, to));
+		m_positionEdges.push_back(MakeEdgeKey(m_positionIds[from], m_positionIds[to]));
+	}
+
+	std::sort(m_wedgeEdges.begin(), m_wedgeEdges.end());
+	std::sort(m_positionEdges.begin(), m_positionEdges.end());
+
+	m_isReferenced.assign(m_numVertices, 0);
+	for (uint index = 0; index < numIndices; index++)
+	{
+		m_isReferenced[m_indices[index]] = 1;
+	}
+
+	std::vector<uint> numOpenOut(m_numVertices, 0);
+	std::vector<uint> numOpenIn(m_numVertices, 0);
+	m_openNext.assign(m_numVertices, MESH_SIMPLIFIER_INVALID_INDEX);
+	m_openPrev.assign(m_numVertices, MESH_SIMPLIFIER_INVALID_INDEX);
+
+	for (uint index = 0; index < numIndices; index++)
+	{
+		uint from = m_indices[index];
+		uint to = m_indices[(index % 3 == 2) ? index - 2 : index + 1];
+
+		if (!HasEdge(m_wedgeEdges, to, from))
+		{
+			numOpenOut[from]++;
+			numOpenIn[to]++;
+			m_openNext[from] = to;
+			m_openPrev[to] = from;
+		}
+	}
+
+	m_kinds.assign(m_numVertices, SIMPLIFIER_VERTEX_LOCKED);
+	for (uint vertexIndex = 0; vertexIndex < m_numVertices; vertexIndex++)
+	{
+		if (m_positionIds[vertexIndex] != vertexIndex)
+		{
+			continue;
+		}
+
+		uint numWedges = 0;
+		uint firstWedge = vertexIndex;
+		bool hasSimpleLoops = true;
+		bool isSeam = true;
+
+		uint wedge = vertexIndex;
+		do
+		{
+			if (!m_isReferenced[wedge])
+			{
+				wedge = m_nextWedge[wedge];
+				continue;
+			}
+
+			firstWedge = (numWedges == 0) ? wedge : firstWedge;
+			numWedges++;
+
+			if (numOpenOut[wedge] == 0 && numOpenIn[wedge] == 0)
+			{
+				isSeam = false;
+			}
+			else if (numOpenOut[wedge] != 1 || numOpenIn[wedge] != 1)
+			{
+				hasSimpleLoops = false;
+			}
+			else
+			{
+				//Across a seam the other side has the same positions the other way around
+				uint next = m_positionIds[m_openNext[wedge]];
+				uint prev = m_positionIds[m_openPrev[wedge]];
+				if (!HasEdge(m_positionEdges, next, vertexIndex) || !HasEdge(m_positionEdges, vertexIndex, prev))
+				{
+					isSeam = false;
+				}
+			}
+
+			wedge = m_nextWedge[wedge];
+		} while (wedge != vertexIndex);
+
+		if (!hasSimpleLoops)
+		{
+			continue;
+		}
+
+		if (numWedges == 1)
+		{
+			m_kinds[vertexIndex] = (numOpenOut[firstWedge] == 0) ? SIMPLIFIER_VERTEX_MANIFOLD : SIMPLIFIER_VERTEX_BORDER;
+		}
+		else if (numWedges == 2 && isSeam)
+		{
+			m_kinds[vertexIndex] = SIMPLIFIER_VERTEX_SEAM;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Face planes weighted by area, plus planes through the open edges standing up off the face so borders and seams
+// resist being pulled sideways
+//------------------------------------------------------------------------------------------------------------------------------
+void MeshSimplifier::AddQuadrics()
+{
+	m_quadrics.assign(m_numVertices, SimplifierQuadric());
+
+	uint numIndices = static_cast<uint>(m_indices.size());
+	for (uint firstIndex = 0; firstIndex < numIndices; firstIndex += 3)
+	{
+		const Vec3& position0 = GetPosition(m_indices[firstIndex]);
+		const Vec3& position1 = GetPosition(m_indices[firstIndex + 1]);
+		const Vec3& position2 = GetPosition(m_indices[firstIndex + 2]);
+
+		Vec3 faceNormal = GetCrossProduct(position1 - position0, position2 - position0);
+		float doubleArea = faceNormal.GetLength();
+		if (doubleArea == 0.f)
+		{
+			continue;
+		}
+
+		faceNormal /= doubleArea;
+		double distance = -GetDotProduct(faceNormal, position0);
+		for (uint corner = 0; corner < 3; corner++)
+		{
+			m_quadrics[m_positionIds[m_indices[firstIndex + corner]]].AddPlane(faceNormal, distance, doubleArea * 0.5);
+		}
+
+		for (uint corner = 0; corner < 3; corner++)
+		{
+			uint from = m_indices[firstIndex + corner];
+			uint to = m_indices[firstIndex + (corner + 1) % 3];
+			if (HasEdge(m_wedgeEdges, to, from))
+			{
+				continue;
+			}
+
+			bool isBorder = !HasEdge(m_positionEdges, m_positionIds[to], m_positionIds[from]);
+			Vec3 edge = GetPosition(to) - GetPosition(from);
+			Vec3 edgeNormal = GetCrossProduct(edge, faceNormal);
+			float edgeNormalLength = edgeNormal.GetLength();
+			if (edgeNormalLength == 0.f)
+			{
+				continue;
+			}
+
+			edgeNormal /= edgeNormalLength;
+			double edgeDistance = -GetDotProduct(edgeNormal, GetPosition(from));
+			double edgeWeight = edge.GetLengthSquared() * (isBorder ? MESH_SIMPLIFIER_BORDER_WEIGHT : MESH_SIMPLIFIER_SEAM_WEIGHT);
+
+			m_quadrics[m_positionIds[from]].AddPlane(edgeNormal, edgeDistance, edgeWeight);
+			m_quadrics[m_positionIds[to]].AddPlane(edgeNormal, edgeDistance, edgeWeight);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void MeshSimplifier::BuildTriangleAdjacency()
+{
+	uint numIndices = static_cast<uint>(m_indices.size());
+
+	m_triangleOffsets.assign(m_numVertices + 1, 0);
+	for (uint index = 0; index < numIndices; index++)
+	{
+		m_triangleOffsets[m_positionIds[m_indices[index]] + 1]++;
+	}
+
+	for (uint vertexIndex = 0; vertexIndex < m_numVertices; vertexIndex++)
+	{
+		m_triangleOffsets[vertexIndex + 1] += m_triangleOffsets[vertexIndex];
+	}
+
+	std::vector<uint> fill(m_triangleOffsets.begin(), m_triangleOffsets.end() - 1);
+	m_triangles.resize(numIndices);
+	for (uint index = 0; index < numIndices; index++)
+	{
+		m_triangles[fill[m_positionIds[m_indices[index]]]++] = index / 3;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool MeshSimplifier::CanCollapse( uint from, uint to ) const
+{
+	unsigned char fromKind = m_kinds[from];
+	unsigned char toKind = m_kinds[to];
+
+	if (fromKind == SIMPLIFIER_VERTEX_MANIFOLD)
+	{
+		return true;
+	}
+
+	if (fromKind == SIMPLIFIER_VERTEX_LOCKED || (toKind != fromKind && toKind != SIMPLIFIER_VERTEX_LOCKED))
+	{
+		return false;
+	}
+
+	//Borders and seams only along their open edges, for seams on both sides
+	uint wedge = from;
+	do
+	{
+		if (m_isReferenced[wedge] && m_positionIds[m_openNext[wedge]] != to && m_positionIds[m_openPrev[wedge]] != to)
+		{
+			return false;
+		}
+
+		wedge = m_nextWedge[wedge];
+	} while (wedge != from);
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void MeshSimplifier::GatherCollapses( std::vector<SimplifierCollapse>& outCollapses ) const
+{
+	outCollapses.clear();
+
+	uint numIndices = static_cast<uint>(m_indices.size());
+	for (uint index = 0; index < numIndices; index++)
+	{
+		uint positionA = m_positionIds[m_indices[index]];
+		uint positionB = m_positionIds[m_indices[(index % 3 == 2) ? index - 2 : index + 1]];
+
+		//Interior edges show up twice, once each way
+		if (positionA == positionB || (positionA > positionB && HasEdge(m_positionEdges, positionB, positionA)))
+		{
+			continue;
+		}
+
+		bool canCollapseAB = CanCollapse(positionA, positionB);
+		bool canCollapseBA = CanCollapse(positionB, positionA);
+		if (!canCollapseAB && !canCollapseBA)
+		{
+			continue;
+		}
+
+		float errorAB = canCollapseAB ? m_quadrics[positionA].GetError(GetPosition(positionB)) : FLT_MAX;
+		float errorBA = canCollapseBA ? m_quadrics[positionB].GetError(GetPosition(positionA)) : FLT_MAX;
+
+		SimplifierCollapse collapse;
+		collapse.m_from = (errorAB <= errorBA) ? positionA : positionB;
+		collapse.m_to = (errorAB <= errorBA) ? positionB : positionA;
+		collapse.m_error = (errorAB <= errorBA) ? errorAB : errorBA;
+		outCollapses.push_back(collapse);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Each wedge of from goes to the wedge of to it shares a triangle with, so the attributes on either side of a seam
+// stay on their side
+//------------------------------------------------------------------------------------------------------------------------------
+bool MeshSimplifier::FindWedgeTargets( uint from, uint to )
+{
+	m_wedgeTargets.clear();
+
+	uint wedge = from;
+	do
+	{
+		if (!m_isReferenced[wedge])
+		{
+			wedge = m_nextWedge[wedge];
+			continue;
+		}
+
+		uint target = MESH_SIMPLIFIER_INVALID_INDEX;
+		for (uint adjacentIndex = m_triangleOffsets[from]; adjacentIndex < m_triangleOffsets[from + 1] && target == MESH_SIMPLIFIER_INVALID_INDEX; adjacentIndex++)
+		{
+			const uint* triangle = &m_indices[m_triangles[adjacentIndex] * 3];
+			if (triangle[0] != wedge && triangle[1] != wedge && triangle[2] != wedge)
+			{
+				continue;
+			}
+
+			for (uint corner = 0; corner < 3; corner++)
+			{
+				if (m_positionIds[triangle[corner]] == to)
+				{
+					target = triangle[corner];
+					break;
+				}
+			}
+		}
+
+		if (target == MESH_SIMPLIFIER_INVALID_INDEX)
+		{
+			return false;
+		}
+
+		m_wedgeTargets.push_back(wedge);
+		m_wedgeTargets.push_back(target);
+
+		wedge = m_nextWedge[wedge];
+	} while (wedge != from);
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool MeshSimplifier::HasTriangleFlips( uint from, uint to ) const
+{
+	const Vec3& fromPosition = GetPosition(from);
+	const Vec3& toPosition = GetPosition(to);
+
+	for (uint adjacentIndex = m_triangleOffsets[from]; adjacentIndex < m_triangleOffsets[from + 1]; adjacentIndex++)
+	{
+		const uint* triangle = &m_indices[m_triangles[adjacentIndex] * 3];
+
+		uint fromCorner = 0;
+		bool hasTo = false;
+		for (uint corner = 0; corner < 3; corner++)
+		{
+			uint positionId = m_positionIds[triangle[corner]];
+			fromCorner = (positionId == from) ? corner : fromCorner;
+			hasTo = hasTo || (positionId == to);
+		}
+
+		//Triangles on the edge go away
+		if (hasTo)
+		{
+			continue;
+		}
+
+		const Vec3& position1 = GetPosition(triangle[(fromCorner + 1) % 3]);
+		const Vec3& position2 = GetPosition(triangle[(fromCorner + 2) % 3]);
+
+		Vec3 oldNormal = GetCrossProduct(position1 - fromPosition, position2 - fromPosition);
+		Vec3 newNormal = GetCrossProduct(position1 - toPosition, position2 - toPosition);
+
+		//Slivers the source already had have no facing to keep, like the rows of a UV sphere's poles
+		float oldEdgeSquared = std::max((position1 - fromPosition).GetLengthSquared(), std::max((position2 - fromPosition).GetLengthSquared(), (position2 - position1).GetLengthSquared()));
+		if (oldNormal.GetLength() <= MESH_SIMPLIFIER_MIN_TRIANGLE_SHAPE * oldEdgeSquared)
+		{
+			continue;
+		}
+
+		//A zero normal passes the turn test as 0 <= 0, slivers just short of zero need their own check
+		if (GetDotProduct(oldNormal, newNormal) <= MESH_SIMPLIFIER_MAX_NORMAL_TURN * oldNormal.GetLength() * newNormal.GetLength())
+		{
+			return true;
+		}
+
+		float newEdgeSquared = std::max((position1 - toPosition).GetLengthSquared(), std::max((position2 - toPosition).GetLengthSquared(), (position2 - position1).GetLengthSquared()));
+		if (newNormal.GetLength() <= MESH_SIMPLIFIER_MIN_TRIANGLE_SHAPE * newEdgeSquared)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Returns how many triangles became degenerate
+//------------------------------------------------------------------------------------------------------------------------------
+uint MeshSimplifier::PerformCollapse( uint from, uint to )
+{
+	uint numRemoved = 0;
+
+	for (uint adjacentIndex = m_triangleOffsets[from]; adjacentIndex < m_triangleOffsets[from + 1]; adjacentIndex++)
+	{
+		uint* triangle = &m_indices[m_triangles[adjacentIndex] * 3];
+		bool hasTo = false;
+
+		for (uint corner = 0; corner < 3; corner++)
+		{
+			hasTo = hasTo || (m_positionIds[triangle[corner]] == to);
+
+			for (size_t targetIndex = 0; targetIndex < m_wedgeTargets.size(); targetIndex += 2)
+			{
+				if (triangle[corner] == m_wedgeTargets[targetIndex])
+				{
+					triangle[corner] = m_wedgeTargets[targetIndex + 1];
+					break;
+				}
+			}
+		}
+
+		numRemoved += hasTo ? 1 : 0;
+	}
+
+	m_quadrics[to].Add(m_quadrics[from]);
+	m_collapsedInto[from] = to;
+	m_isLocked[from] = 1;
+	m_isLocked[to] = 1;
+
+	return numRemoved;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void MeshSimplifier::RemoveDegenerateTriangles()
+{
+	uint numIndices = static_cast<uint>(m_indices.size());
+	uint numKept = 0;
+
+	for (uint firstIndex = 0; firstIndex < numIndices; firstIndex += 3)
+	{
+		uint position0 = m_positionIds[m_indices[firstIndex]];
+		uint position1 = m_positionIds[m_indices[firstIndex + 1]];
+		uint position2 = m_positionIds[m_indices[firstIndex + 2]];
+
+		if (position0 == position1 || position1 == position2 || position2 == position0)
+		{
+			continue;
+		}
+
+		m_indices[numKept] = m_indices[firstIndex];
+		m_indices[numKept + 1] = m_indices[firstIndex + 1];
+		m_indices[numKept + 2] = m_indices[firstIndex + 2];
+		numKept += 3;
+	}
+
+	m_indices.resize(numKept);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// How far the source vertices ended up from the simplified surface. Each is measured against the triangles around the
+// position it collapsed into rather than the whole mesh, which can only overestimate, so LODs never switch in early.
+//------------------------------------------------------------------------------------------------------------------------------
+float MeshSimplifier::GetMaxSourceDistance()
+{
+	BuildTriangleAdjacency();
+
+	float maxDistanceSquared = 0.f;
+	for (uint vertexIndex = 0; vertexIndex < m_numVertices; vertexIndex++)
+	{
+		if (m_positionIds[vertexIndex] != vertexIndex)
+		{
+			continue;
+		}
+
+		uint survivor = vertexIndex;
+		while (m_collapsedInto[survivor] != survivor)
+		{
+			survivor = m_collapsedInto[survivor];
+		}
+
+		const Vec3& sourcePosition = GetPosition(vertexIndex);
+		float distanceSquared = (sourcePosition - GetPosition(survivor)).GetLengthSquared();
+
+		for (uint adjacentIndex = m_triangleOffsets[survivor]; adjacentIndex < m_triangleOffsets[survivor + 1]; adjacentIndex++)
+		{
+			const uint* triangle = &m_indices[m_triangles[adjacentIndex] * 3];
+			distanceSquared = std::min(distanceSquared, GetDistanceSquaredToTriangle(sourcePosition, GetPosition(triangle[0]), GetPosition(triangle[1]), GetPosition(triangle[2])));
+		}
+
+		maxDistanceSquared = std::max(maxDistanceSquared, distanceSquared);
+	}
+
+	return sqrtf(maxDistanceSquared);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Collapses run in passes: every allowed edge is costed, then the cheapest go in order as long as neither end has
+// moved yet this pass, which keeps the costs and flip checks of a pass valid without a priority queue to update.
+//------------------------------------------------------------------------------------------------------------------------------
+float SimplifyMesh( const VertexMaster* vertices, uint numVertices, const uint* indices, uint numIndices, uint targetIndexCount, float targetError, std::vector<uint>& outIndices )
+{
+	outIndices.assign(indices, indices + numIndices);
+	if (numIndices <= targetIndexCount || numVertices == 0)
+	{
+		return 0.f;
+	}
+
+	MeshSimplifier simplifier(outIndices);
+	simplifier.m_vertices = vertices;
+	simplifier.m_numVertices = numVertices;
+
+	simplifier.BuildPositionIds();
+	simplifier.ClassifyVertices();
+	simplifier.AddQuadrics();
+
+	simplifier.m_collapsedInto.resize(numVertices);
+	for (uint vertexIndex = 0; vertexIndex < numVertices; vertexIndex++)
+	{
+		simplifier.m_collapsedInto[vertexIndex] = vertexIndex;
+	}
+
+	float targetErrorSquared = (targetError < sqrtf(FLT_MAX)) ? targetError * targetError : FLT_MAX;
+	std::vector<SimplifierCollapse> collapses;
+
+	for (uint pass = 0; outIndices.size() > targetIndexCount; pass++)
+	{
+		//The first pass uses the classification AddQuadrics needed
+		if (pass > 0)
+		{
+			simplifier.ClassifyVertices();
+		}
+
+		simplifier.GatherCollapses(collapses);
+		if (collapses.empty())
+		{
+			break;
+		}
+
+		std::sort(collapses.begin(), collapses.end());
+
+		//A manifold collapse takes two triangles, so about half as many collapses as triangles to lose
+		uint trianglesToRemove = (static_cast<uint>(outIndices.size()) - targetIndexCount + 2) / 3;
+		size_t goalIndex = std::min(static_cast<size_t>(trianglesToRemove / 2), collapses.size() - 1);
+		float passErrorLimit = std::min(collapses[goalIndex].m_error * MESH_SIMPLIFIER_PASS_ERROR_SCALE, targetErrorSquared);
+
+		simplifier.BuildTriangleAdjacency();
+		simplifier.m_isLocked.assign(numVertices, 0);
+
+		uint numRemoved = 0;
+		uint numCollapses = 0;
+		for (const SimplifierCollapse& collapse : collapses)
+		{
+			if (collapse.m_error > passErrorLimit || numRemoved >= trianglesToRemove)
+			{
+				break;
+			}
+
+			if (simplifier.m_isLocked[collapse.m_from] || simplifier.m_isLocked[collapse.m_to])
+			{
+				continue;
+			}
+
+			if (!simplifier.FindWedgeTargets(collapse.m_from, collapse.m_to) || simplifier.HasTriangleFlips(collapse.m_from, collapse.m_to))
+			{
+				continue;
+			}
+
+			numRemoved += simplifier.PerformCollapse(collapse.m_from, collapse.m_to);
+			numCollapses++;
+		}
+
+		if (numCollapses == 0)
+		{
+			break;
+		}
+
+		simplifier.RemoveDegenerateTriangles();
+	}
+
+	//The quadric error is a mean over the merged planes and reads low, the LODs get an actual distance
+	return simplifier.GetMaxSourceDistance();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void GenerateLODChain( const std::vector<VertexMaster>& vertices, const std::vector<uint>& indices, uint maxLevels, std::vector<uint>& outLODIndices, std::vector<MeshLOD>& outLODs )
+{
+	outLODIndices.clear();
+	outLODs.clear();
+
+	uint numVertices = static_cast<uint>(vertices.size());
+	uint previousIndexCount = static_cast<uint>(indices.size());
+	std::vector<uint> lodIndices;
+
+	for (uint level = 1; level < maxLevels; level++)
+	{
+		uint targetIndexCount = static_cast<uint>(static_cast<float>(previousIndexCount / 3) * MESH_LOD_TRIANGLE_RATIO) * 3;
+		if (targetIndexCount < MESH_LOD_MIN_TRIANGLES * 3)
+		{
+			break;
+		}
+
+		//From LOD0 every time so the error is against the real surface, not the last approximation
+		float error = SimplifyMesh(vertices.data(), numVertices, indices.data(), static_cast<uint>(indices.size()), targetIndexCount, FLT_MAX, lodIndices);
+		uint numIndices = static_cast<uint>(lodIndices.size());
+		if (numIndices == 0 || static_cast<float>(numIndices) > static_cast<float>(previousIndexCount) * MESH_LOD_MIN_REDUCTION)
+		{
+			break;
+		}
+
+		OptimizeVertexCache(lodIndices.data(), numIndices, numVertices);
+
+		MeshLOD lod;
+		lod.m_firstIndex = static_cast<uint>(outLODIndices.size());
+		lod.m_numIndices = numIndices;
+		lod.m_error = error;
+		outLODs.push_back(lod);
+
+		outLODIndices.insert(outLODIndices.end(), lodIndices.begin(), lodIndices.end());
+		previousIndexCount = numIndices;
+	}
+}
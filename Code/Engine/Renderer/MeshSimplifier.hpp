@@ -0,0 +1,38 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+//Engine Systems
+#include "Engine/Math/VertexMaster.hpp"
+#include <vector>
+
+typedef unsigned int uint;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Level of detail generation by quadric error metric edge collapse (Garland and Heckbert, Surface Simplification Using
+// Quadric Error Metrics). Meant for cook time like MeshOptimizer.
+//
+// Collapses only move a vertex onto one of its neighbours, so every LOD keeps using the LOD0 vertices and only the
+// index buffer changes. Vertices that share a position but not their other attributes (UV and normal seams) are
+// collapsed together and only along the seam, and open borders only along the border, so neither tears or slides.
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr uint		MESH_LOD_MAX_LEVELS = 4;				// LOD0 included
+constexpr float		MESH_LOD_TRIANGLE_RATIO = 0.5f;			// each LOD aims for this many of the previous LOD's triangles
+constexpr float		MESH_LOD_MIN_REDUCTION = 0.9f;			// a LOD that keeps more than this of the previous one isn't worth it
+constexpr uint		MESH_LOD_MIN_TRIANGLES = 16;
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct MeshLOD
+{
+	uint		m_firstIndex = 0;
+	uint		m_numIndices = 0;
+	float		m_error = 0.f;				// how far any LOD0 vertex is from this LOD's surface at most, in mesh units. 0 for LOD0
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Returns the largest distance from a source vertex to the simplified surface. Stops at the target index count or when
+// the next collapse's root mean square distance to the planes it merges would go over targetError, whichever comes
+// first. Expects a triangle list.
+float		SimplifyMesh(const VertexMaster* vertices, uint numVertices, const uint* indices, uint numIndices, uint targetIndexCount, float targetError, std::vector<uint>& outIndices);
+
+// LOD1 and down, each simplified from LOD0 and cache optimized. Their indices are appended to outLODIndices and
+// outLODs gets one entry per level with m_firstIndex into outLODIndices. Stops early when a level stops paying off.
+void		GenerateLODChain(const std::vector<VertexMaster>& vertices, const std::vector<uint>& indices, uint maxLevels, std::vector<uint>& outLODIndices, std::vector<MeshLOD>& outLODs);
@@ -3,76 +3,336 @@
 #include "Engine/Commons/StringUtils.hpp"
 #include "Engine/Core/EventSystems.hpp"
 #include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/JobSystem/Job.hpp"
+#include "Engine/Core/JobSystem/JobSystem.hpp"
+#include "Engine/Core/MemoryMappedFile.hpp"
 #include "Engine/Core/NamedProperties.hpp"
 #include "Engine/Core/XMLUtils/XMLUtils.hpp"
+#include "Engine/Math/MeshBVH.hpp"
 #include "Engine/Math/Vertex_Lit.hpp"
+#include "Engine/Math/Vertex_LitPacked.hpp"
+#include "Engine/Math/Vertex_LitQuantized.hpp"
 #include "Engine/Renderer/CPUMesh.hpp"
 #include "Engine/Renderer/GPUMesh.hpp"
+#include "Engine/Renderer/MeshOptimizer.hpp"
+#include "Engine/Renderer/MeshSimplifier.hpp"
+#include "Engine/Renderer/PMSHFormat.hpp"
 #include "Engine/Renderer/RenderContext.hpp"
+#include "Engine/Renderer/TangentGenerator.hpp"
 #include <vector>
-#include <fstream>
+#include <atomic>
+#include <stddef.h>
+#include <string.h>
+#include <thread>
 
 //------------------------------------------------------------------------------------------------------------------------------
-ObjectLoader::ObjectLoader()
+constexpr size_t		OBJ_MIN_BYTES_PER_JOB = 1024 * 1024;		// smaller files parse faster than a job can be scheduled
+
+//------------------------------------------------------------------------------------------------------------------------------
+// PMSH v2 vertices are Vertex_Lit, which is laid out exactly like VertexMaster, so the same blob fills the CPUMesh
+//------------------------------------------------------------------------------------------------------------------------------
+static_assert(sizeof(Vertex_Lit) == sizeof(VertexMaster), "Vertex_Lit and VertexMaster must match for cooked meshes");
+static_assert(offsetof(Vertex_Lit, m_normal) == offsetof(VertexMaster, m_normal)
+	&& offsetof(Vertex_Lit, m_tangent) == offsetof(VertexMaster, m_tangent)
+	&& offsetof(Vertex_Lit, m_biTangent) == offsetof(VertexMaster, m_biTangent)
+	&& offsetof(Vertex_Lit, m_color) == offsetof(VertexMaster, m_color)
+	&& offsetof(Vertex_Lit, m_uv) == offsetof(VertexMaster, m_uv), "Vertex_Lit and VertexMaster must match for cooked meshes");
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The BVH is cooked next to the PMSH as its own file so meshes and BVHs are versioned separately
+//------------------------------------------------------------------------------------------------------------------------------
+static std::string GetCookedPathWithExtension(const std::string& fileName, const char* extension)
 {
+	std::vector<std::string> splits = SplitStringOnDelimiter(fileName, '.');
+	std::string cookedPath = "";
+	for (int index = 0; index < (int)splits.size() - 1; index++)
+	{
+		cookedPath += splits[index];
+	}
+	cookedPath += extension;
 
+	return cookedPath;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-ObjectLoader::~ObjectLoader()
+std::string GetCookedMeshPath(const std::string& meshFileName)
 {
-	MakeCookedVersion();
+	return GetCookedPathWithExtension(meshFileName, ".pmsh");
+}
 
-	if (m_mesh != nullptr)
+//------------------------------------------------------------------------------------------------------------------------------
+std::string GetCookedCollisionPath(const std::string& meshFileName, int collisionIndex)
+{
+	return GetCookedPathWithExtension(meshFileName, Stringf("_collision%d.pcvx", collisionIndex).c_str());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void LoadCookedBVH(ObjectLoader* object, const std::string& fileName)
+{
+	//A sidecar left over from when the XML still asked for a BVH is ignored
+	if (!object->m_isDataDriven || !object->m_buildBVH)
 	{
-		delete m_mesh;
+		return;
 	}
+
+	Buffer bvhBuffer;
+	if (LoadBinaryFileToExistingBuffer(GetCookedPathWithExtension(fileName, ".pbvh"), bvhBuffer))
+	{
+		BufferReadUtils readUtils(bvhBuffer);
+		object->m_bvh = new MeshBVH();
+		if (object->m_bvh->ReadFromBuffer(readUtils, MeshBVH::HashSourceTriangles(*object->m_cpuMesh)))
+		{
+			return;
+		}
+	}
+
+	//Missing, stale or broken sidecar, rebuild from the cooked mesh instead
+	object->CreateBVH();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-STATIC ObjectLoader* ObjectLoader::MakeLoaderAndLoadMeshFromFile(RenderContext* renderContext, const std::string& fileName, bool isDataDriven)
+// What one chunk of an OBJ file parses to. Positive face indices are absolute, negative (relative) ones are resolved
+// against the chunk's own counts and listed in m_relativeFixups so the chunk's base can be added once all counts are known.
+//------------------------------------------------------------------------------------------------------------------------------
+struct ObjChunk
 {
-	ObjectLoader* object = new ObjectLoader();
-	object->m_renderContext = renderContext;
-	
-	object->m_fullFileName = fileName;
+	const char*				m_start = nullptr;
+	const char*				m_end = nullptr;
 
-	DebuggerPrintf("Loading: %s\n", object->m_fullFileName.c_str());
+	std::vector<Vec3>		m_positions;
+	std::vector<Vec2>		m_uvs;
+	std::vector<Vec3>		m_normals;
+	std::vector<ObjIndex>	m_indices;
+	std::vector<int>		m_relativeFixups;				// index * 3 + component (0 vertex, 1 uv, 2 normal)
+};
 
-	//Chck if a cooked version exists
-	std::vector<std::string> splits = SplitStringOnDelimiter(fileName, '.');
-	std::string pmeshPath = "";
-	for (int index = 0; index < splits.size() - 1; index++)
+//------------------------------------------------------------------------------------------------------------------------------
+static inline const char* SkipObjSpaces(const char* cursor, const char* end)
+{
+	while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r'))
 	{
-		pmeshPath += splits[index];
+		cursor++;
 	}
-	pmeshPath += ".pmsh";
 
-	Buffer readBuffer;
-	if (LoadBinaryFileToExistingBuffer(pmeshPath, readBuffer))
+	return cursor;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// One face corner: v, v/vt, v//vn or v/vt/vn. Missing components are -1, same as the old atoi("") - 1.
+// Returns the corner's relative components as a mask (bit 0 vertex, 1 uv, 2 normal).
+//------------------------------------------------------------------------------------------------------------------------------
+static const char* ParseObjFaceCorner(const ObjChunk& chunk, const char* cursor, const char* lineEnd, ObjIndex* outIndex, int* outRelativeMask)
+{
+	int counts[3] = { (int)chunk.m_positions.size(), (int)chunk.m_uvs.size(), (int)chunk.m_normals.size() };
+	int values[3] = { -1, -1, -1 };
+	*outRelativeMask = 0;
+
+	for (int component = 0; component < 3; component++)
 	{
-		//This is a cooked mesh
-		object->m_isCooked = true;
+		//The int parser skips blanks, which would run "2// 3" into the next corner
+		int value = 0;
+		const char* numberEnd = cursor;
+		if (cursor < lineEnd && *cursor != ' ' && *cursor != '\t')
+		{
+			numberEnd = ParseIntFromRange(cursor, lineEnd, &value);
+		}
 
-		object->LoadFromPMSH(fileName, readBuffer);
-		object->CreateGPUMesh();
-		return object;
+		if (numberEnd != cursor)
+		{
+			if (value < 0)
+			{
+				values[component] = counts[component] + value;
+				*outRelativeMask |= 1 << component;
+			}
+			else
+			{
+				values[component] = value - 1;
+			}
+			cursor = numberEnd;
+		}
+		else if (component == 0)
+		{
+			return cursor;
+		}
+
+		if (cursor >= lineEnd || *cursor != '/')
+		{
+			break;
+		}
+		cursor++;
 	}
 
-	//Open file and see what it says
-	if (isDataDriven)
+	outIndex->vertexIndex = values[0];
+	outIndex->uvIndex = values[1];
+	outIndex->normalIndex = values[2];
+	return cursor;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static inline void PushObjCorner(ObjChunk* chunk, const ObjIndex& corner, int relativeMask)
+{
+	int indexPosition = (int)chunk->m_indices.size();
+	chunk->m_indices.push_back(corner);
+
+	for (int component = 0; relativeMask != 0; component++, relativeMask >>= 1)
 	{
-		//Load the models from xml;
-		object->LoadFromXML(fileName);
-		object->CreateGPUMesh();
+		if (relativeMask & 1)
+		{
+			chunk->m_relativeFixups.push_back(indexPosition * 3 + component);
+		}
 	}
-	else
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Single pass over the text, no strings or per line allocations. Faces of any size are fanned into triangles.
+//------------------------------------------------------------------------------------------------------------------------------
+static void ParseObjChunk(ObjChunk* chunk, bool invertWinding)
+{
+	const char* cursor = chunk->m_start;
+	const char* end = chunk->m_end;
+
+	while (cursor < end)
+	{
+		const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+		if (lineEnd == nullptr)
+		{
+			lineEnd = end;
+		}
+
+		cursor = SkipObjSpaces(cursor, lineEnd);
+		if (lineEnd - cursor >= 2 && cursor[0] == 'v')
+		{
+			if (cursor[1] == ' ' || cursor[1] == '\t')
+			{
+				Vec3 position = Vec3::ZERO;
+				const char* valueCursor = ParseFloatFromRange(cursor + 1, lineEnd, &position.x);
+				valueCursor = ParseFloatFromRange(valueCursor, lineEnd, &position.y);
+				ParseFloatFromRange(valueCursor, lineEnd, &position.z);
+				chunk->m_positions.push_back(position);
+			}
+			else if (cursor[1] == 'n')
+			{
+				Vec3 normal = Vec3::ZERO;
+				const char* valueCursor = ParseFloatFromRange(cursor + 2, lineEnd, &normal.x);
+				valueCursor = ParseFloatFromRange(valueCursor, lineEnd, &normal.y);
+				ParseFloatFromRange(valueCursor, lineEnd, &normal.z);
+				chunk->m_normals.push_back(normal);
+			}
+			else if (cursor[1] == 't')
+			{
+				Vec2 uv = Vec2::ZERO;
+				const char* valueCursor = ParseFloatFromRange(cursor + 2, lineEnd, &uv.x);
+				ParseFloatFromRange(valueCursor, lineEnd, &uv.y);
+				uv.y = 1 - uv.y;
+				chunk->m_uvs.push_back(uv);
+			}
+		}
+		else if (lineEnd - cursor >= 2 && cursor[0] == 'f' && (cursor[1] == ' ' || cursor[1] == '\t'))
+		{
+			ObjIndex first;
+			ObjIndex previous;
+			int firstMask = 0;
+			int previousMask = 0;
+			int numCorners = 0;
+
+			const char* cornerCursor = SkipObjSpaces(cursor + 1, lineEnd);
+			while (cornerCursor < lineEnd)
+			{
+				ObjIndex corner;
+				int cornerMask = 0;
+				const char* cornerEnd = ParseObjFaceCorner(*chunk, cornerCursor, lineEnd, &corner, &cornerMask);
+				if (cornerEnd == cornerCursor)
+				{
+					break;
+				}
+
+				if (numCorners == 0)
+				{
+					first = corner;
+					firstMask = cornerMask;
+				}
+				else if (numCorners >= 2)
+				{
+					PushObjCorner(chunk, first, firstMask);
+					if (!invertWinding)
+					{
+						PushObjCorner(chunk, previous, previousMask);
+						PushObjCorner(chunk, corner, cornerMask);
+					}
+					else
+					{
+						PushObjCorner(chunk, corner, cornerMask);
+						PushObjCorner(chunk, previous, previousMask);
+					}
+				}
+
+				previous = corner;
+				previousMask = cornerMask;
+				numCorners++;
+				cornerCursor = SkipObjSpaces(cornerEnd, lineEnd);
+			}
+		}
+
+		cursor = lineEnd + 1;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+class ObjChunkJob : public Job
+{
+public:
+	ObjChunkJob(ObjChunk* chunk, bool invertWinding, std::atomic<int>* jobsRemaining)
+		: m_chunk(chunk), m_invertWinding(invertWinding), m_jobsRemaining(jobsRemaining)
+	{
+	}
+
+	void Execute()
 	{
-		object->CreateFromString(fileName.c_str());
-		object->CreateCPUMesh();
-		object->CreateGPUMesh();
+		ParseObjChunk(m_chunk, m_invertWinding);
+
+		//Last thing we touch, the chunk and counter belong to the waiting caller
+		m_jobsRemaining->fetch_sub(1);
 	}
 
+private:
+	ObjChunk*				m_chunk = nullptr;
+	bool					m_invertWinding = false;
+	std::atomic<int>*		m_jobsRemaining = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+ObjectLoader::ObjectLoader()
+{
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+ObjectLoader::~ObjectLoader()
+{
+	MakeCookedVersion();
+
+	if (m_mesh != nullptr)
+	{
+		delete m_mesh;
+	}
+
+	if (m_cpuMesh != nullptr)
+	{
+		delete m_cpuMesh;
+	}
+
+	if (m_bvh != nullptr)
+	{
+		delete m_bvh;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC ObjectLoader* ObjectLoader::MakeLoaderAndLoadMeshFromFile(RenderContext* renderContext, const std::string& fileName, bool isDataDriven)
+{
+	ObjectLoader* object = new ObjectLoader();
+	object->LoadMeshFromFile(renderContext, fileName, isDataDriven);
+
 	return object;
 }
 
@@ -81,30 +341,32 @@ void ObjectLoader::LoadMeshFromFile(RenderContext* renderContext, const std::str
 {
 	m_renderContext = renderContext;
 
-	DebuggerPrintf("Loading: %s\n", fileName.c_str());
+	LoadMeshDataFromFile(fileName, isDataDriven);
+	FinishLoadOnMainThread();
+}
 
+//------------------------------------------------------------------------------------------------------------------------------
+// Everything up to the CPUMesh (and BVH). When m_renderContext is null nothing here touches the device or fires events,
+// so the streaming loader runs it on the I/O thread.
+//------------------------------------------------------------------------------------------------------------------------------
+void ObjectLoader::LoadMeshDataFromFile(const std::string& fileName, bool isDataDriven)
+{
 	m_fullFileName = fileName;
 
 	DebuggerPrintf("Loading: %s\n", m_fullFileName.c_str());
 
 	//Chck if a cooked version exists
-	std::vector<std::string> splits = SplitStringOnDelimiter(fileName, '.');
-	std::string pmeshPath = "";
-	for (int index = 0; index < splits.size() - 1; index++)
-	{
-		pmeshPath += splits[index];
-	}
-	pmeshPath += ".pmsh";
-
-	Buffer readBuffer;
-	if (LoadBinaryFileToExistingBuffer(pmeshPath, readBuffer))
+	MemoryMappedFile pmshFile;
+	if (pmshFile.Open(GetCookedMeshPath(fileName)))
 	{
 		//This is a cooked mesh
 		m_isCooked = true;
 
-		LoadFromPMSH(fileName, readBuffer);
-		CreateGPUMesh();
+		//The mesh is cooked but the material, colliders and vertex format still come from the XML
+		m_isDataDriven = isDataDriven && ReadSettingsFromXML(fileName);
 
+		LoadFromPMSHData(pmshFile.GetData(), pmshFile.GetSize());
+		LoadCookedBVH(this, fileName);
 		return;
 	}
 
@@ -113,23 +375,120 @@ void ObjectLoader::LoadMeshFromFile(RenderContext* renderContext, const std::str
 	{
 		//Load the models from xml;
 		LoadFromXML(fileName);
-		CreateGPUMesh();
+		m_isDataDriven = true;
 	}
 	else
 	{
 		CreateFromString(fileName.c_str());
 		CreateCPUMesh();
-		CreateGPUMesh();
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The GPUMesh and the colliders the .mesh asks for
+//------------------------------------------------------------------------------------------------------------------------------
+void ObjectLoader::FinishLoadOnMainThread()
+{
+	CreateGPUMesh();
+
+	if (m_isDataDriven && m_loadCollision)
+	{
+		FireCollisionEvents("ReadCollisionMeshFromData");
 	}
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
 void ObjectLoader::LoadFromPMSH(const std::string& fileName, Buffer& readBuffer)
 {
-	BufferReadUtils readUtils(readBuffer);
+	UNUSED(fileName);
+	LoadFromPMSHData(readBuffer.data(), readBuffer.size());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ObjectLoader::LoadFromPMSHData(const uchar* data, size_t size)
+{
+	int versionMajor = GetPMSHVersionMajor(data, size);
+	if (versionMajor == 0)
+	{
+		ERROR_AND_DIE("FourCC code mismatch for PMSH");
+	}
+	else if (versionMajor == 1)
+	{
+		LoadFromPMSHVersion1(data, size);
+		return;
+	}
+	else if (versionMajor != PMSH_VERSION_MAJOR)
+	{
+		ERROR_AND_DIE("Major Version mismatch for PMSH");
+	}
+
+	PMSHView view;
+	if (!ReadPMSHView(&view, data, size))
+	{
+		ERROR_AND_DIE("PMSH file is corrupt");
+	}
+
+	const PMSHSection* vertexSection = view.FindSection(PMSH_SECTION_VERTEX_LIT);
+	const PMSHSection* indexSection = view.FindSection(PMSH_SECTION_INDICES);
+	if (vertexSection == nullptr || vertexSection->m_stride != sizeof(Vertex_Lit) || (indexSection != nullptr && indexSection->m_stride != sizeof(uint)))
+	{
+		ERROR_AND_DIE("PMSH is missing its Vertex_Lit or index section");
+	}
+
+	const void* vertices = view.GetSectionData(*vertexSection);
+	const uint* indices = (indexSection != nullptr) ? static_cast<const uint*>(view.GetSectionData(*indexSection)) : nullptr;
+	uint numVertices = vertexSection->m_count;
+	uint numIndices = (indexSection != nullptr) ? indexSection->m_count : 0U;
+
+	//2.1 index sections carry the LODs after LOD0
+	const PMSHSection* lodSection = view.FindSection(PMSH_SECTION_LODS);
+	const PMSHLod* pmshLods = (lodSection != nullptr) ? static_cast<const PMSHLod*>(view.GetSectionData(*lodSection)) : nullptr;
+	uint numLODs = (lodSection != nullptr) ? lodSection->m_count : 0U;
+	uint numLOD0Indices = (numLODs > 0) ? pmshLods[0].m_numIndices : numIndices;
+
+	std::vector<MeshLOD> lods(numLODs);
+	for (uint lodIndex = 0; lodIndex < numLODs; lodIndex++)
+	{
+		lods[lodIndex].m_firstIndex = pmshLods[lodIndex].m_firstIndex;
+		lods[lodIndex].m_numIndices = pmshLods[lodIndex].m_numIndices;
+		lods[lodIndex].m_error = pmshLods[lodIndex].m_error;
+	}
+
+	//One copy for the CPU side (collision, BVH), no per vertex work
+	m_cpuMesh = new CPUMesh();
+	m_cpuMesh->AddVertices(static_cast<const VertexMaster*>(vertices), numVertices);
+	m_cpuMesh->AddIndices(indices, numLOD0Indices);
+
+	if (numLODs > 1)
+	{
+		//The CPUMesh keeps LOD0 apart, so its LOD ranges start after it
+		std::vector<MeshLOD> cpuLODs(lods.begin() + 1, lods.end());
+		for (MeshLOD& lod : cpuLODs)
+		{
+			lod.m_firstIndex -= numLOD0Indices;
+		}
+
+		m_cpuMesh->SetLODs(indices + numLOD0Indices, numIndices - numLOD0Indices, cpuLODs.data(), static_cast<uint>(cpuLODs.size()));
+	}
+
+	//The GPU gets the blob straight from the file, packed formats are encoded from the CPUMesh in CreateGPUMesh
+	if (m_renderContext != nullptr && m_vertexFormat == MESH_VERTEX_LIT)
+	{
+		m_mesh = new GPUMesh(m_renderContext);
+		m_mesh->CreateFromVertexData(vertices, Vertex_Lit::layout, numVertices, indices, numIndices);
+		m_mesh->SetLODs(lods.data(), numLODs);
+		m_mesh->m_boundsMins = Vec3(view.m_header->m_boundsMins[0], view.m_header->m_boundsMins[1], view.m_header->m_boundsMins[2]);
+		m_mesh->m_boundsMaxs = Vec3(view.m_header->m_boundsMaxs[0], view.m_header->m_boundsMaxs[1], view.m_header->m_boundsMaxs[2]);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ObjectLoader::LoadFromPMSHVersion1(const uchar* data, size_t size)
+{
+	BufferReadUtils readUtils(data, size);
 
 	//Check FourCC
-	uchar* fourCC = new uchar[4];
+	uchar fourCC[4];
 	readUtils.ParseByteArray(fourCC, 4);
 
 	if (fourCC[0] != 'P' || fourCC[1] != 'M' || fourCC[2] != 'S' || fourCC[3] != 'H')
@@ -137,7 +496,7 @@ void ObjectLoader::LoadFromPMSH(const std::string& fileName, Buffer& readBuffer)
 		ERROR_AND_DIE("FourCC code mismatch for PMSH");
 	}
 
-	uchar byte = readUtils.ParseByte();
+	readUtils.ParseByte();
 	uchar versionMajor = readUtils.ParseByte();
 	if (versionMajor != 1)
 	{
@@ -178,249 +537,231 @@ void ObjectLoader::LoadFromPMSH(const std::string& fileName, Buffer& readBuffer)
 
 //------------------------------------------------------------------------------------------------------------------------------
 void ObjectLoader::LoadFromXML(const std::string& fileName)
+{
+	if (!ReadSettingsFromXML(fileName))
+	{
+		ERROR_AND_DIE(">> Error loading Mesh XML file ");
+		return;
+	}
+
+	CreateFromString((MODEL_PATH + m_source).c_str());
+	CreateCPUMesh();
+
+	if (m_buildBVH)
+	{
+		CreateBVH();
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Everything the .mesh says except building the mesh itself, so cooked loads and the cooker can use it too
+//------------------------------------------------------------------------------------------------------------------------------
+bool ObjectLoader::ReadSettingsFromXML(const std::string& fileName)
 {
 	//Open the xml file and parse it
 	tinyxml2::XMLDocument meshDoc;
 	meshDoc.LoadFile(fileName.c_str());
 
-	if (meshDoc.ErrorID() != tinyxml2::XML_SUCCESS)
+	if (meshDoc.ErrorID() != tinyxml2::XML_SUCCESS || meshDoc.RootElement() == nullptr)
 	{
+		return false;
+	}
+
+	//We loaded the file successfully
+	XMLElement* root = meshDoc.RootElement();
+
+	m_id = ParseXmlAttribute(*root, "id", "");
+
+	if (root->FindAttribute("src"))
+	{
+		m_source = ParseXmlAttribute(*root, "src", m_source);
+	}
 	
-		ERROR_AND_DIE(">> Error loading Mesh XML file ");
-		return;
+	if (root->FindAttribute("invert"))
+	{
+		m_invert = ParseXmlAttribute(*root, "invert", false);
 	}
-	else
+
+	if (root->FindAttribute("tangents"))
 	{
-		//We loaded the file successfully
-		XMLElement* root = meshDoc.RootElement();
+		m_tangents = ParseXmlAttribute(*root, "tangents", false);
+	}
 
-		if (root->FindAttribute("src"))
-		{
-			m_source = ParseXmlAttribute(*root, "src", m_source);
-		}
-		
-		if (root->FindAttribute("invert"))
-		{
-			m_invert = ParseXmlAttribute(*root, "invert", false);
-		}
+	if (root->FindAttribute("scale"))
+	{
+		m_scale = ParseXmlAttribute(*root, "scale", 1.f);
+	}
+	
+	if (root->FindAttribute("bvh"))
+	{
+		m_buildBVH = ParseXmlAttribute(*root, "bvh", false);
+	}
 
-		if (root->FindAttribute("tangents"))
-		{
-			m_tangents = ParseXmlAttribute(*root, "tangents", false);
-		}
+	m_transform = ParseXmlAttribute(*root, "transform", "");
 
-		if (root->FindAttribute("scale"))
-		{
-			m_scale = ParseXmlAttribute(*root, "scale", 1.f);
-		}
-		
-		m_transform = ParseXmlAttribute(*root, "transform", "");
+	if (root->FindAttribute("lods"))
+	{
+		m_numLODs = ParseXmlAttribute(*root, "lods", MESH_LOD_MAX_LEVELS);
+	}
 
-		CreateFromString((MODEL_PATH + m_source).c_str());
-		CreateCPUMesh();
+	std::string vertexFormat = ParseXmlAttribute(*root, "vertexFormat", "lit");
+	if (vertexFormat == "packed")
+	{
+		m_vertexFormat = MESH_VERTEX_PACKED;
+	}
+	else if (vertexFormat == "quantized")
+	{
+		m_vertexFormat = MESH_VERTEX_QUANTIZED;
+	}
+	else
+	{
+		m_vertexFormat = MESH_VERTEX_LIT;
+	}
 
-		XMLElement* elem = root->FirstChildElement("material");
-		if (elem != nullptr)
-		{
-			//Set the default material path for this model from XML
-			m_defaultMaterialPath = ParseXmlAttribute(*elem, "src", "");
-		}
+	XMLElement* elem = root->FirstChildElement("material");
+	if (elem != nullptr)
+	{
+		//Set the default material path for this model from XML
+		m_defaultMaterialPath = ParseXmlAttribute(*elem, "src", "");
+	}
 
-		elem = root->FirstChildElement("collision");
-		while (elem != nullptr)
-		{
-			//We requested to create a static collider with this model so generate that using the PhysX System
-			NamedProperties eventArgs;
-			eventArgs.SetValue("id", ParseXmlAttribute(*root, "id", ""));
-			eventArgs.SetValue("src", ParseXmlAttribute(*elem, "src", ""));
-			eventArgs.SetValue("physXFlags", ParseXmlAttribute(*elem, "physXFlags", ""));
-			eventArgs.SetValue("position", ParseXmlAttribute(*elem, "position", Vec3::ZERO));
+	m_collisions.clear();
+	elem = root->FirstChildElement("collision");
+	while (elem != nullptr)
+	{
+		ObjCollisionSource collision;
+		collision.m_source = ParseXmlAttribute(*elem, "src", "");
+		collision.m_physXFlags = ParseXmlAttribute(*elem, "physXFlags", "");
+		collision.m_position = ParseXmlAttribute(*elem, "position", Vec3::ZERO);
+		m_collisions.push_back(collision);
 
-			eventArgs.SetValue("transform", m_transform);
-			eventArgs.SetValue("scale", m_scale);
-			eventArgs.SetValue("invert", m_invert);
-			eventArgs.SetValue("tangents", m_tangents);
+		elem = elem->NextSiblingElement("collision");
+	}
 
-			g_eventSystem->FireEvent("ReadCollisionMeshFromData", eventArgs);
+	return true;
+}
 
-			elem = elem->NextSiblingElement("collision");
+//------------------------------------------------------------------------------------------------------------------------------
+int ObjectLoader::FireCollisionEvents(const std::string& eventName)
+{
+	int numSucceeded = 0;
+
+	for (int collisionIndex = 0; collisionIndex < (int)m_collisions.size(); collisionIndex++)
+	{
+		//We requested to create a static collider with this model so generate that using the PhysX System
+		NamedProperties eventArgs;
+		eventArgs.SetValue("id", m_id);
+		eventArgs.SetValue("src", m_collisions[collisionIndex].m_source);
+		eventArgs.SetValue("physXFlags", m_collisions[collisionIndex].m_physXFlags);
+		eventArgs.SetValue("position", m_collisions[collisionIndex].m_position);
+		eventArgs.SetValue("cooked", GetCookedCollisionPath(m_fullFileName, collisionIndex));
+
+		eventArgs.SetValue("transform", m_transform);
+		eventArgs.SetValue("scale", m_scale);
+		eventArgs.SetValue("invert", m_invert);
+		eventArgs.SetValue("tangents", m_tangents);
+
+		g_eventSystem->FireEvent(eventName, eventArgs);
+
+		if (eventArgs.GetValue("succeeded", false))
+		{
+			numSucceeded++;
 		}
 	}
+
+	return numSucceeded;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+// data is the path of the .obj. The file is mapped and parsed in place; big files are split on line boundaries and each
+// piece is parsed by a job into its own arrays, which are then appended in file order.
 //------------------------------------------------------------------------------------------------------------------------------
 void ObjectLoader::CreateFromString(const char* data)
 {
-	std::ifstream fileStream;
-	fileStream.open(data, std::ios::beg);
+	MemoryMappedFile file;
+	if (!file.Open(data))
+	{
+		DebuggerPrintf("\n Could not open OBJ file %s", data);
+		return;
+	}
 
-	std::string lineString;
-	
-	while (std::getline(fileStream, lineString))
+	const char* fileStart = reinterpret_cast<const char*>(file.GetData());
+	const char* fileEnd = fileStart + file.GetSize();
+
+	int numChunks = (int)(file.GetSize() / OBJ_MIN_BYTES_PER_JOB) + 1;
+	int numThreads = (int)std::thread::hardware_concurrency();
+	if (numThreads > 0 && numChunks > numThreads)
+	{
+		numChunks = numThreads;
+	}
+
+	std::vector<ObjChunk> chunks(numChunks);
+	const char* chunkStart = fileStart;
+	for (int chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
 	{
-		if (lineString.size() == 0 || lineString[0] == '#')
+		const char* chunkEnd = fileEnd;
+		if (chunkIndex < numChunks - 1)
 		{
-			continue;
+			chunkEnd = chunkStart + (fileEnd - chunkStart) / (numChunks - chunkIndex);
+			const char* newLine = static_cast<const char*>(memchr(chunkEnd, '\n', static_cast<size_t>(fileEnd - chunkEnd)));
+			chunkEnd = (newLine != nullptr) ? newLine + 1 : fileEnd;
 		}
-		else if (lineString[0] == 'v' && lineString[1] == ' ')
+
+		chunks[chunkIndex].m_start = chunkStart;
+		chunks[chunkIndex].m_end = chunkEnd;
+		chunkStart = chunkEnd;
+	}
+
+	if (numChunks == 1)
+	{
+		ParseObjChunk(&chunks[0], m_invert);
+	}
+	else
+	{
+		JobSystem* jobSystem = JobSystem::GetInstance();
+		std::atomic<int> jobsRemaining(numChunks - 1);
+		for (int chunkIndex = 1; chunkIndex < numChunks; chunkIndex++)
 		{
-			//Read the vertex
-			std::vector<std::string> tokens = SplitStringOnDelimiter(lineString, ' ');
+			jobSystem->Run(new ObjChunkJob(&chunks[chunkIndex], m_invert, &jobsRemaining));
+		}
 
-			for (int i = 0; i < (int)tokens.size(); i++)
+		//Parse the first chunk here and help out with the rest rather than sleeping
+		ParseObjChunk(&chunks[0], m_invert);
+		while (jobsRemaining.load() > 0)
+		{
+			if (!jobSystem->ProcessCategory(JOB_GENERIC))
 			{
-				if (tokens[i] == "" || tokens[i] == "v")
-				{
-					tokens.erase(tokens.begin() + i);
-					i = -1;
-				}
+				std::this_thread::yield();
 			}
-
-			Vec3 value;
-			std::string valueString(tokens[0]);
-			valueString += ",";
-			valueString += std::string(tokens[1]);
-			valueString += ",";
-			valueString += std::string(tokens[2]);
-
-			value.SetFromText(valueString.c_str());
-
-			m_positions.push_back(value);
 		}
-		else if (lineString[0] == 'v' && lineString[1] == 'n')
-		{
-			// read the normal
-			std::vector<std::string> tokens = SplitStringOnDelimiter(lineString, ' ');
-
-			Vec3 value;
-			std::string valueString(tokens[1]);
-			valueString += ",";
-			valueString += std::string(tokens[2]);
-			valueString += ",";
-			valueString += std::string(tokens[3]);
+	}
 
-			value.SetFromText(valueString.c_str());
+	//Append in file order; relative indices only knew their own chunk's counts so they get the chunk's base added
+	int positionBase = (int)m_positions.size();
+	int uvBase = (int)m_uvs.size();
+	int normalBase = (int)m_normals.size();
 
-			m_normals.push_back(value);
-		}
-		else if (lineString[0] == 'v' && lineString[1] == 't')
-		{
-			//Read the uv
-			std::vector<std::string> tokens = SplitStringOnDelimiter(lineString, ' ');
-
-			Vec2 value;
-			std::string valueString(tokens[1]);
-			valueString += ",";
-			valueString += std::string(tokens[2]);
+	for (int chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
+	{
+		ObjChunk& chunk = chunks[chunkIndex];
+		int indexBase = (int)m_indices.size();
 
-			value.SetFromText(valueString.c_str());
-			value.y = 1 - value.y;
+		m_positions.insert(m_positions.end(), chunk.m_positions.begin(), chunk.m_positions.end());
+		m_uvs.insert(m_uvs.end(), chunk.m_uvs.begin(), chunk.m_uvs.end());
+		m_normals.insert(m_normals.end(), chunk.m_normals.begin(), chunk.m_normals.end());
+		m_indices.insert(m_indices.end(), chunk.m_indices.begin(), chunk.m_indices.end());
 
-			m_uvs.push_back(value);
-		}
-		else if (lineString[0] == 'f')
+		int bases[3] = { positionBase, uvBase, normalBase };
+		for (int fixup : chunk.m_relativeFixups)
 		{
-			//Read index for the face
-			std::vector<std::string> tokens = SplitStringOnDelimiter(lineString, ' ');
-
-			for (int i = 0; i < (int)tokens.size(); i++)
-			{
-				if (tokens[i] == "" || tokens[i] == "f")
-				{
-					tokens.erase(tokens.begin() + i);
-				}
-			}
-
-			int numIndices = (int)tokens.size();
-
-// 			if (SplitStringOnDelimiter(tokens[0], '/').size() == 1)
-// 			{
-// 				//If there is only 1 entry for the faces
-// 				ObjIndex idx;
-// 				idx.vertexIndex = atoi(tokens[0].c_str()) - 1;
-// 				idx.uvIndex = 0;
-// 				idx.normalIndex = 0;
-// 
-// 				m_indices.push_back(idx);
-// 			}
-			
-			if (numIndices == 3)
-			{
-				if (!m_invert)
-				{
-					//We have a tri so this is EZ
-					this->AddIndexForMesh(tokens[0]);
-					this->AddIndexForMesh(tokens[1]);
-					this->AddIndexForMesh(tokens[2]);
-				}
-				else
-				{
-					//We have a tri so this is EZ
-					this->AddIndexForMesh(tokens[0]);
-					this->AddIndexForMesh(tokens[2]);
-					this->AddIndexForMesh(tokens[1]);
-				}
-			}
-			else if (numIndices == 4)
-			{
-				if (!m_invert)
-				{
-					//We have quad so better plit into tris
-					this->AddIndexForMesh(tokens[0]);
-					this->AddIndexForMesh(tokens[1]);
-					this->AddIndexForMesh(tokens[2]);
-
-					this->AddIndexForMesh(tokens[0]);
-					this->AddIndexForMesh(tokens[2]);
-					this->AddIndexForMesh(tokens[3]);
-				}
-				else
-				{
-					//We have quad so better plit into tris
-					this->AddIndexForMesh(tokens[0]);
-					this->AddIndexForMesh(tokens[2]);
-					this->AddIndexForMesh(tokens[1]);
-
-					this->AddIndexForMesh(tokens[0]);
-					this->AddIndexForMesh(tokens[3]);
-					this->AddIndexForMesh(tokens[2]);
-				}
-			}
-			else
-			{
-				if (!m_invert)
-				{
-					//We have 5 face so better plit into tris
-					this->AddIndexForMesh(tokens[0]);
-					this->AddIndexForMesh(tokens[1]);
-					this->AddIndexForMesh(tokens[2]);
-
-					this->AddIndexForMesh(tokens[0]);
-					this->AddIndexForMesh(tokens[2]);
-					this->AddIndexForMesh(tokens[3]);
-
-					this->AddIndexForMesh(tokens[0]);
-					this->AddIndexForMesh(tokens[3]);
-					this->AddIndexForMesh(tokens[4]);
-				}
-				else
-				{
-					//We have 5 face so better plit into tris
-					this->AddIndexForMesh(tokens[0]);
-					this->AddIndexForMesh(tokens[2]);
-					this->AddIndexForMesh(tokens[1]);
-
-					this->AddIndexForMesh(tokens[0]);
-					this->AddIndexForMesh(tokens[3]);
-					this->AddIndexForMesh(tokens[2]);
-
-					this->AddIndexForMesh(tokens[0]);
-					this->AddIndexForMesh(tokens[4]);
-					this->AddIndexForMesh(tokens[3]);
-				}
-			}
+			ObjIndex& index = m_indices[indexBase + fixup / 3];
+			int* components[3] = { &index.vertexIndex, &index.uvIndex, &index.normalIndex };
+			*components[fixup % 3] += bases[fixup % 3];
 		}
 
+		positionBase += (int)chunk.m_positions.size();
+		uvBase += (int)chunk.m_uvs.size();
+		normalBase += (int)chunk.m_normals.size();
 	}
 }
 
@@ -445,14 +786,21 @@ void ObjectLoader::CreateCPUMesh()
 
 	std::vector<VertexMaster> vertices;
 	std::vector<uint> indices;
+	vertices.reserve(numIndices);
+	indices.reserve(numIndices);
 	for (int index = 0; index < numIndices; index++)
 	{
 		VertexMaster vertex;
 
 		vertex.m_position = m_positions[m_indices[index].vertexIndex];
-		vertex.m_normal = m_normals[m_indices[index].normalIndex];
 
-		if (m_uvs.size() != 0)		
+		//Faces written as v or v/vt have no normal
+		if (m_indices[index].normalIndex >= 0 && m_indices[index].normalIndex < (int)m_normals.size())
+		{
+			vertex.m_normal = m_normals[m_indices[index].normalIndex];
+		}
+
+		if (m_indices[index].uvIndex >= 0 && m_indices[index].uvIndex < (int)m_uvs.size())
 		{
 			vertex.m_uv = m_uvs[m_indices[index].uvIndex];
 		}
@@ -504,80 +852,87 @@ void ObjectLoader::CreateCPUMesh()
 		mat.SetJBasis(vectors[1]);
 		mat.SetKBasis(vectors[2]);
 
-		for (int vertexIndex = 0; vertexIndex < (int)vertices.size(); vertexIndex++)
+		//No translation in mat, so normals go through the same 3x3 as before
+		if (vertices.size() > 0)
 		{
-			vertices[vertexIndex].m_position = mat.TransformPosition3D(vertices[vertexIndex].m_position);
-			vertices[vertexIndex].m_normal = mat.TransformPosition3D(vertices[vertexIndex].m_normal);
+			mat.TransformVertices(&vertices[0], (int)vertices.size());
 		}
 
 	}
 
+	//Still one vertex per corner and already in its final space, which is what MikkTSpace wants. Needs normals and UVs.
+	if (m_tangents && !m_normals.empty() && !m_uvs.empty())
+	{
+		GenerateMikkTSpaceTangents(vertices, indices);
+	}
+
+	//Corners that ended up identical are shared. The GPU order is only tuned when cooking, it's too slow for every load.
+	if (m_cookingRun)
+	{
+		OptimizeMesh(vertices, indices, &m_optimizerStats);
+	}
+	else
+	{
+		WeldVertices(vertices, indices);
+	}
+
 	m_cpuMesh = new CPUMesh();
-	for (int vertIndex = 0; vertIndex < (int)vertices.size(); ++vertIndex)
+	m_cpuMesh->AddVertices(vertices.data(), (uint)vertices.size());
+	m_cpuMesh->AddIndices(indices.data(), (uint)indices.size());
+
+	//The LODs share LOD0's vertices, so they come after the vertex order is final. Cook time only like the optimizer.
+	if (m_cookingRun && m_numLODs > 1)
 	{
-		m_cpuMesh->AddVertex(vertices[vertIndex]);
-		m_cpuMesh->AddIndex(vertIndex);
+		std::vector<uint> lodIndices;
+		std::vector<MeshLOD> lods;
+		GenerateLODChain(vertices, indices, m_numLODs, lodIndices, lods);
+		m_cpuMesh->SetLODs(lodIndices.data(), (uint)lodIndices.size(), lods.data(), (uint)lods.size());
 	}
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
 void ObjectLoader::CreateGPUMesh()
 {
-	m_mesh = new GPUMesh(m_renderContext);
-	m_mesh->CreateFromCPUMesh<Vertex_Lit>(m_cpuMesh);
+	//v2 PMSH loads upload straight from the file and already made it
+	if (m_mesh == nullptr)
+	{
+		m_mesh = new GPUMesh(m_renderContext);
+
+		switch (m_vertexFormat)
+		{
+		case MESH_VERTEX_PACKED:		m_mesh->CreateFromCPUMesh<Vertex_LitPacked>(m_cpuMesh);		break;
+		case MESH_VERTEX_QUANTIZED:		m_mesh->CreateFromCPUMesh<Vertex_LitQuantized>(m_cpuMesh);	break;
+		default:						m_mesh->CreateFromCPUMesh<Vertex_Lit>(m_cpuMesh);			break;
+		}
+	}
+
 	m_mesh->m_defaultMaterial = m_defaultMaterialPath;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-void ObjectLoader::MakeCookedVersion()
+void ObjectLoader::CreateBVH()
 {
-	if (m_isCooked || !m_cookingRun)
+	if (m_bvh == nullptr)
 	{
-		DebuggerPrintf("\n Mesh is already a cooked mesh");
-		return;
+		m_bvh = new MeshBVH();
 	}
 
-	//Write cooked version to disk
-
-	Buffer buffer;
-	BufferWriteUtils writeBufferUtil(buffer);
-
-	//Header
-	//Four CC
-	writeBufferUtil.AppendByte('P');
-	writeBufferUtil.AppendByte('M');
-	writeBufferUtil.AppendByte('S');
-	writeBufferUtil.AppendByte('H');
-
-	//Reserved Byte
-	writeBufferUtil.AppendByte(0);
-
-	//File Number
-	writeBufferUtil.AppendByte(1);
-	writeBufferUtil.AppendByte(0);
-
-	//Endianness
-	writeBufferUtil.AppendByte(writeBufferUtil.m_endianMode);
-
-	//Mesh Data
-	uint numVertices = m_cpuMesh->GetVertexCount();
-	uint numIndices = m_cpuMesh->GetIndexCount();
-	writeBufferUtil.AppendUint32(numVertices);
-	writeBufferUtil.AppendUint32(numIndices);
+	m_bvh->BuildFromCPUMesh(*m_cpuMesh, (int)std::thread::hardware_concurrency());
+}
 
-	//Vertex Data
-	const VertexMaster* vertices = m_cpuMesh->GetVertices();
-	for (int vertexIndex = 0; vertexIndex < (int)numVertices; vertexIndex++)
+//------------------------------------------------------------------------------------------------------------------------------
+bool ObjectLoader::MakeCookedVersion()
+{
+	if (m_isCooked || !m_cookingRun || m_cpuMesh == nullptr)
 	{
-		writeBufferUtil.AppendVertexMaster(vertices[vertexIndex]);
+		DebuggerPrintf("\n Mesh is already a cooked mesh");
+		return false;
 	}
 
-	//Index Data
-	const uint* indices = m_cpuMesh->GetIndices();
-	for (int indiceIndex = 0; indiceIndex < (int)numIndices; indiceIndex++)
-	{
-		writeBufferUtil.AppendUint32(indices[indiceIndex]);
-	}
+	//Write cooked version to disk
+
+	Buffer buffer;
+	WritePMSH(buffer, *m_cpuMesh);
 
 	std::string fileSavePath = "";
 	std::vector<std::string> splits = SplitStringOnDelimiter(m_fullFileName, '.');
@@ -596,9 +951,31 @@ void ObjectLoader::MakeCookedVersion()
 	if (success)
 	{
 		DebuggerPrintf("\n Sucessfully cooked %s PMSH to disk", fileSavePath.c_str());
+
+		//What we hold now matches the file, the destructor has nothing left to write
+		m_isCooked = true;
 	}
 	else
 	{
 		DebuggerPrintf("\n Failed to cook %s PMSH to disk", fileSavePath.c_str());
 	}
+
+	if (m_bvh != nullptr && success)
+	{
+		Buffer bvhBuffer;
+		BufferWriteUtils bvhWriteUtils(bvhBuffer);
+		m_bvh->WriteToBuffer(bvhWriteUtils);
+
+		std::string bvhSavePath = GetCookedPathWithExtension(m_fullFileName, ".pbvh");
+		if (SaveBinaryFileFromBuffer(bvhSavePath, bvhBuffer))
+		{
+			DebuggerPrintf("\n Sucessfully cooked %s PBVH to disk", bvhSavePath.c_str());
+		}
+		else
+		{
+			DebuggerPrintf("\n Failed to cook %s PBVH to disk", bvhSavePath.c_str());
+		}
+	}
+
+	return success;
 }
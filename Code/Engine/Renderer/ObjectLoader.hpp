@@ -6,12 +6,15 @@
 #include "Engine/Core/BufferWriteUtils.hpp"
 #include "Engine/Core/BufferReadUtils.hpp"
 #include "Engine/Commons/EngineCommon.hpp"
+#include "Engine/Renderer/MeshOptimizer.hpp"
+#include "Engine/Renderer/MeshSimplifier.hpp"
 // Others
 #include <string>
 #include <vector>
 
 class CPUMesh;
 class GPUMesh;
+class MeshBVH;
 class RenderContext;
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -22,6 +25,30 @@ struct ObjIndex
 	int normalIndex = 0;
 };
 
+//------------------------------------------------------------------------------------------------------------------------------
+// A <collision> entry in a .mesh file, turned into a PhysX convex mesh by whoever handles the collision events
+//------------------------------------------------------------------------------------------------------------------------------
+struct ObjCollisionSource
+{
+	std::string		m_source = "";
+	std::string		m_physXFlags = "";
+	Vec3			m_position = Vec3::ZERO;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// vertexFormat in a .mesh file. The packed formats need shaders that decode them, so meshes opt in one at a time.
+//------------------------------------------------------------------------------------------------------------------------------
+enum eMeshVertexFormat
+{
+	MESH_VERTEX_LIT = 0,		// "lit", Vertex_Lit
+	MESH_VERTEX_PACKED,			// "packed", Vertex_LitPacked
+	MESH_VERTEX_QUANTIZED		// "quantized", Vertex_LitQuantized
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+std::string		GetCookedMeshPath(const std::string& meshFileName);								// .pmsh next to the .obj or .mesh
+std::string		GetCookedCollisionPath(const std::string& meshFileName, int collisionIndex);	// PhysX cooked hull for one <collision>
+
 //------------------------------------------------------------------------------------------------------------------------------
 class ObjectLoader
 {
@@ -31,15 +58,25 @@ public:
 	static ObjectLoader*	MakeLoaderAndLoadMeshFromFile(RenderContext* renderContext, const std::string& filePath, bool isDataDriven);
 
 	void					LoadMeshFromFile(RenderContext* renderContext, const std::string& fileName, bool isDataDriven);
+	void					LoadMeshDataFromFile(const std::string& fileName, bool isDataDriven);	// no device work or events when m_renderContext is null
+	void					FinishLoadOnMainThread();												// GPUMesh and collision events
 	
 	void					LoadFromPMSH(const std::string& fileName, Buffer& readBuffer);
+	void					LoadFromPMSHData(const uchar* data, size_t size);		// v1 or v2, v2 also creates the GPUMesh
 	void					LoadFromXML(const std::string& fileName);
+	bool					ReadSettingsFromXML(const std::string& fileName);		// false if the XML can't be read
+	int						FireCollisionEvents(const std::string& eventName);		// returns how many handlers set "succeeded"
 	void					CreateFromString(const char* data);
 	void					AddIndexForMesh(const std::string& indices);
 	void					CreateCPUMesh();
 	void					CreateGPUMesh();
+	void					CreateBVH();
+
+	bool					MakeCookedVersion();
+
+private:
+	void					LoadFromPMSHVersion1(const uchar* data, size_t size);
 
-	void					MakeCookedVersion();
 public:
 	std::vector<Vec3>				m_positions;
 	std::vector<Vec2>				m_uvs;
@@ -49,15 +86,24 @@ public:
 	RenderContext*					m_renderContext = nullptr;
 	CPUMesh*						m_cpuMesh = nullptr;
 	GPUMesh*						m_mesh = nullptr;
+	MeshBVH*						m_bvh = nullptr;			// only built when the XML asks for it with bvh="true"
+	MeshOptimizerStats				m_optimizerStats;			// from CreateCPUMesh, only filled in on cooking runs
 
+	std::string						m_id = "";
 	std::string						m_source = "";
 	std::string						m_fullFileName = "";
 	std::string						m_transform = "";
 	std::string						m_defaultMaterialPath = "";
+	std::vector<ObjCollisionSource>	m_collisions;
 	bool							m_invert = false;
 	bool							m_tangents = false;
+	bool							m_buildBVH = false;
 	bool							m_isCooked = false;
+	bool							m_isDataDriven = false;		// the .mesh XML was read, so there may be colliders to load
+	bool							m_loadCollision = true;		// the cooker only wants the render mesh
 	float							m_scale = 0.f;
+	uint							m_numLODs = MESH_LOD_MAX_LEVELS;	// LOD0 included, lods="1" in the XML turns them off
+	eMeshVertexFormat				m_vertexFormat = MESH_VERTEX_LIT;
 
 	bool							m_cookingRun = RUN_COOKING;
 };
\ No newline at end of file
@@ -0,0 +1,228 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/PMSHFormat.hpp"
+//Engine Systems
+#include "Engine/Commons/EngineCommon.hpp"
+#include "Engine/Math/Vertex_Lit.hpp"
+#include "Engine/Renderer/CPUMesh.hpp"
+#include <string.h>
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr uint		PMSH_MAX_WRITTEN_SECTIONS = 3;
+
+//------------------------------------------------------------------------------------------------------------------------------
+static uint64_t AlignPMSHOffset( uint64_t offset )
+{
+	return (offset + PMSH_SECTION_ALIGNMENT - 1) & ~static_cast<uint64_t>(PMSH_SECTION_ALIGNMENT - 1);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static eBufferEndianness GetNativeEndianness()
+{
+	return PLATFORM_IS_BIG_ENDIAN ? BUFFER_BIG_ENDIAN : BUFFER_LITTLE_ENDIAN;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const PMSHSection* PMSHView::FindSection( uint type ) const
+{
+	for (uint sectionIndex = 0; sectionIndex < m_header->m_numSections; sectionIndex++)
+	{
+		if (m_sections[sectionIndex].m_type == type)
+		{
+			return &m_sections[sectionIndex];
+		}
+	}
+
+	return nullptr;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const void* PMSHView::GetSectionData( const PMSHSection& section ) const
+{
+	return m_data + section.m_offset;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int GetPMSHVersionMajor( const unsigned char* data, size_t size )
+{
+	if (size < 8 || data[0] != 'P' || data[1] != 'M' || data[2] != 'S' || data[3] != 'H')
+	{
+		return 0;
+	}
+
+	return static_cast<int>(data[5]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Everything is checked against the file size up front so the loader can use the blobs without further checks
+//------------------------------------------------------------------------------------------------------------------------------
+bool ReadPMSHView( PMSHView* out, const unsigned char* data, size_t size )
+{
+	if (GetPMSHVersionMajor(data, size) != PMSH_VERSION_MAJOR || size < sizeof(PMSHHeader))
+	{
+		DebuggerPrintf("\n Not a v2 PMSH");
+		return false;
+	}
+
+	const PMSHHeader* header = reinterpret_cast<const PMSHHeader*>(data);
+	if (header->m_endianness != GetNativeEndianness() && header->m_endianness != BUFFER_NATIVE)
+	{
+		DebuggerPrintf("\n PMSH was cooked for the other endianness");
+		return false;
+	}
+
+	if (header->m_headerSize < sizeof(PMSHHeader) || header->m_sectionTableOffset % alignof(PMSHSection) != 0
+		|| static_cast<uint64_t>(header->m_sectionTableOffset) + static_cast<uint64_t>(header->m_numSections) * sizeof(PMSHSection) > size)
+	{
+		DebuggerPrintf("\n PMSH section table is out of range");
+		return false;
+	}
+
+	const PMSHSection* sections = reinterpret_cast<const PMSHSection*>(data + header->m_sectionTableOffset);
+	for (uint sectionIndex = 0; sectionIndex < header->m_numSections; sectionIndex++)
+	{
+		const PMSHSection& section = sections[sectionIndex];
+		if (section.m_offset % PMSH_SECTION_ALIGNMENT != 0 || section.m_offset > size || section.m_size > size - section.m_offset
+			|| section.m_size != static_cast<uint64_t>(section.m_stride) * section.m_count)
+		{
+			DebuggerPrintf("\n PMSH section %u is truncated or misaligned", sectionIndex);
+			return false;
+		}
+	}
+
+	//LOD ranges have to be inside the index section
+	const PMSHSection* lodSection = nullptr;
+	const PMSHSection* indexSection = nullptr;
+	for (uint sectionIndex = 0; sectionIndex < header->m_numSections; sectionIndex++)
+	{
+		lodSection = (sections[sectionIndex].m_type == PMSH_SECTION_LODS) ? &sections[sectionIndex] : lodSection;
+		indexSection = (sections[sectionIndex].m_type == PMSH_SECTION_INDICES) ? &sections[sectionIndex] : indexSection;
+	}
+
+	if (lodSection != nullptr)
+	{
+		const PMSHLod* lods = reinterpret_cast<const PMSHLod*>(data + lodSection->m_offset);
+		uint numIndices = (indexSection != nullptr) ? indexSection->m_count : 0U;
+
+		for (uint lodIndex = 0; lodIndex < lodSection->m_count; lodIndex++)
+		{
+			if (lodSection->m_stride != sizeof(PMSHLod) || lods[lodIndex].m_firstIndex > numIndices || lods[lodIndex].m_numIndices > numIndices - lods[lodIndex].m_firstIndex)
+			{
+				DebuggerPrintf("\n PMSH LOD %u is outside the index section", lodIndex);
+				return false;
+			}
+		}
+
+		//The loader splits LOD0 off the front of the index section and the chain after it
+		if (lodSection->m_count > 0 && (lods[0].m_firstIndex != 0 || lods[0].m_numIndices != header->m_numIndices))
+		{
+			DebuggerPrintf("\n PMSH LOD0 is not the start of the index section");
+			return false;
+		}
+
+		for (uint lodIndex = 1; lodIndex < lodSection->m_count; lodIndex++)
+		{
+			if (lods[lodIndex].m_firstIndex < lods[0].m_numIndices)
+			{
+				DebuggerPrintf("\n PMSH LOD %u overlaps LOD0", lodIndex);
+				return false;
+			}
+		}
+	}
+
+	out->m_data = data;
+	out->m_size = size;
+	out->m_header = header;
+	out->m_sections = sections;
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void WritePMSH( Buffer& out, const CPUMesh& mesh )
+{
+	uint numVertices = mesh.GetVertexCount();
+	uint numIndices = mesh.GetIndexCount();
+	uint numLODs = (mesh.GetLODCount() > 0) ? mesh.GetLODCount() + 1 : 0U;
+	uint numLODIndices = (numLODs > 0) ? mesh.GetLODIndexCount() : 0U;
+	uint numSections = (numLODs > 0) ? PMSH_MAX_WRITTEN_SECTIONS : PMSH_MAX_WRITTEN_SECTIONS - 1;
+
+	//Header, section table, then the blobs
+	PMSHHeader header;
+	memset(&header, 0, sizeof(header));
+	header.m_fourCC[0] = 'P';
+	header.m_fourCC[1] = 'M';
+	header.m_fourCC[2] = 'S';
+	header.m_fourCC[3] = 'H';
+	header.m_versionMajor = PMSH_VERSION_MAJOR;
+	header.m_versionMinor = PMSH_VERSION_MINOR;
+	header.m_endianness = static_cast<unsigned char>(GetNativeEndianness());
+	header.m_headerSize = sizeof(PMSHHeader);
+	header.m_sectionTableOffset = sizeof(PMSHHeader);
+	header.m_numSections = numSections;
+	header.m_numVertices = numVertices;
+	header.m_numIndices = numIndices;
+
+	Vec3 boundsMins;
+	Vec3 boundsMaxs;
+	mesh.GetBounds(&boundsMins, &boundsMaxs);
+	header.m_boundsMins[0] = boundsMins.x;
+	header.m_boundsMins[1] = boundsMins.y;
+	header.m_boundsMins[2] = boundsMins.z;
+	header.m_boundsMaxs[0] = boundsMaxs.x;
+	header.m_boundsMaxs[1] = boundsMaxs.y;
+	header.m_boundsMaxs[2] = boundsMaxs.z;
+
+	PMSHSection sections[PMSH_MAX_WRITTEN_SECTIONS];
+	memset(sections, 0, sizeof(sections));
+
+	sections[0].m_type = PMSH_SECTION_VERTEX_LIT;
+	sections[0].m_stride = sizeof(Vertex_Lit);
+	sections[0].m_count = numVertices;
+	sections[0].m_offset = AlignPMSHOffset(header.m_sectionTableOffset + sizeof(PMSHSection) * numSections);
+	sections[0].m_size = static_cast<uint64_t>(sizeof(Vertex_Lit)) * numVertices;
+
+	//LOD0 then the LOD chain, so every level can be drawn out of one index buffer
+	sections[1].m_type = PMSH_SECTION_INDICES;
+	sections[1].m_stride = sizeof(uint);
+	sections[1].m_count = numIndices + numLODIndices;
+	sections[1].m_offset = AlignPMSHOffset(sections[0].m_offset + sections[0].m_size);
+	sections[1].m_size = static_cast<uint64_t>(sizeof(uint)) * sections[1].m_count;
+
+	sections[2].m_type = PMSH_SECTION_LODS;
+	sections[2].m_stride = sizeof(PMSHLod);
+	sections[2].m_count = numLODs;
+	sections[2].m_offset = AlignPMSHOffset(sections[1].m_offset + sections[1].m_size);
+	sections[2].m_size = static_cast<uint64_t>(sizeof(PMSHLod)) * numLODs;
+
+	const PMSHSection& lastSection = sections[numSections - 1];
+	out.clear();
+	out.resize(static_cast<size_t>(lastSection.m_offset + lastSection.m_size), 0);
+
+	memcpy(&out[0], &header, sizeof(header));
+	memcpy(&out[header.m_sectionTableOffset], sections, sizeof(PMSHSection) * numSections);
+
+	//Converted once here so the loader never has to
+	if (numVertices > 0)
+	{
+		Vertex_Lit::CopyFromMaster(&out[static_cast<size_t>(sections[0].m_offset)], mesh.GetVertices(), numVertices);
+	}
+
+	if (numIndices > 0)
+	{
+		memcpy(&out[static_cast<size_t>(sections[1].m_offset)], mesh.GetIndices(), sizeof(uint) * numIndices);
+	}
+
+	if (numLODs > 0)
+	{
+		memcpy(&out[static_cast<size_t>(sections[1].m_offset) + sizeof(uint) * numIndices], mesh.GetLODIndices(), sizeof(uint) * numLODIndices);
+
+		PMSHLod* lods = reinterpret_cast<PMSHLod*>(&out[static_cast<size_t>(sections[2].m_offset)]);
+		lods[0].m_numIndices = numIndices;
+		for (uint lodIndex = 1; lodIndex < numLODs; lodIndex++)
+		{
+			const MeshLOD& lod = mesh.GetLODs()[lodIndex - 1];
+			lods[lodIndex].m_firstIndex = numIndices + lod.m_firstIndex;
+			lods[lodIndex].m_numIndices = lod.m_numIndices;
+			lods[lodIndex].m_error = lod.m_error;
+		}
+	}
+}
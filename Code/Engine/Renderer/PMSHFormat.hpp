@@ -0,0 +1,100 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+//Engine Systems
+#include "Engine/Core/BufferUtilCommons.hpp"
+#include <stdint.h>
+
+class CPUMesh;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Cooked mesh (.pmsh) layout
+//
+// v1: 8 byte header, vertex and index counts, then every VertexMaster and index written field by field through
+//     BufferWriteUtils. Still loads, but has to be parsed one field at a time.
+// v2: a 64 byte header and a section table pointing at 16 byte aligned blobs that are already in the GPU vertex format
+//     and native (little endian) byte order. Loading maps the file and hands the blobs straight to the upload, nothing
+//     is parsed. The first 8 bytes match v1 so both are told apart by the version byte.
+// v2.1: meshes with LODs add a LODS section, and the index section holds LOD0 followed by the other levels. The
+//     header's index count is LOD0's.
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr unsigned char		PMSH_VERSION_MAJOR = 2;
+constexpr unsigned char		PMSH_VERSION_MINOR = 1;
+constexpr uint				PMSH_SECTION_ALIGNMENT = 16;
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr uint MakePMSHFourCC( char a, char b, char c, char d )
+{
+	return static_cast<uint>(static_cast<unsigned char>(a)) | (static_cast<uint>(static_cast<unsigned char>(b)) << 8)
+		| (static_cast<uint>(static_cast<unsigned char>(c)) << 16) | (static_cast<uint>(static_cast<unsigned char>(d)) << 24);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+enum ePMSHSectionType : uint
+{
+	PMSH_SECTION_VERTEX_LIT = MakePMSHFourCC('V', 'L', 'I', 'T'),		// Vertex_Lit array
+	PMSH_SECTION_VERTEX_PCU = MakePMSHFourCC('V', 'P', 'C', 'U'),		// Vertex_PCU array
+	PMSH_SECTION_INDICES = MakePMSHFourCC('I', 'N', '3', '2'),			// uint array
+	PMSH_SECTION_LODS = MakePMSHFourCC('L', 'O', 'D', 'S'),				// PMSHLod array, LOD0 first
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct PMSHHeader
+{
+	unsigned char			m_fourCC[4];				// P M S H
+	unsigned char			m_reserved;
+	unsigned char			m_versionMajor;
+	unsigned char			m_versionMinor;
+	unsigned char			m_endianness;				// eBufferEndianness, v2 is always written little endian
+	uint					m_headerSize;				// sizeof(PMSHHeader), lets later minor versions grow the header
+	uint					m_sectionTableOffset;
+	uint					m_numSections;
+	uint					m_numVertices;
+	uint					m_numIndices;
+	uint					m_flags;
+	float					m_boundsMins[3];
+	float					m_boundsMaxs[3];
+	uint					m_padding[2];
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct PMSHSection
+{
+	uint					m_type;						// ePMSHSectionType, unknown types are skipped
+	uint					m_stride;					// bytes per element
+	uint					m_count;
+	uint					m_padding;
+	uint64_t				m_offset;					// from the start of the file, PMSH_SECTION_ALIGNMENT aligned
+	uint64_t				m_size;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct PMSHLod
+{
+	uint					m_firstIndex;				// into the index section
+	uint					m_numIndices;
+	float					m_error;					// MeshLOD::m_error
+	uint					m_padding;
+};
+
+static_assert(sizeof(PMSHHeader) == 64, "PMSHHeader is read straight from disk and must stay 64 bytes");
+static_assert(sizeof(PMSHSection) == 32, "PMSHSection is read straight from disk and must stay 32 bytes");
+static_assert(sizeof(PMSHLod) == 16, "PMSHLod is read straight from disk and must stay 16 bytes");
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Pointers into a v2 file in memory, nothing owned. Only valid while the file data is.
+//------------------------------------------------------------------------------------------------------------------------------
+struct PMSHView
+{
+	const unsigned char*	m_data = nullptr;
+	size_t					m_size = 0;
+	const PMSHHeader*		m_header = nullptr;
+	const PMSHSection*		m_sections = nullptr;
+
+	const PMSHSection*		FindSection(uint type) const;					// nullptr if the file does not have it
+	const void*				GetSectionData(const PMSHSection& section) const;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+int			GetPMSHVersionMajor(const unsigned char* data, size_t size);	// 0 when it isn't a PMSH at all
+bool		ReadPMSHView(PMSHView* out, const unsigned char* data, size_t size);	// false (and why in the debug output) for a bad v2
+void		WritePMSH(Buffer& out, const CPUMesh& mesh);					// v2, Vertex_Lit vertices, 32 bit indices and the LODs
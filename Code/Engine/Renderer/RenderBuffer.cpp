@@ -152,6 +152,23 @@ bool RenderBuffer::CopyCPUToGPU( void const *data, size_t const byteSize )
 	ASSERT( !IsStatic() ); 
 	ASSERT( byteSize <= m_bufferSize ); 
 	
+	void* mappedData = MapForWrite();
+	if (mappedData == nullptr)
+	{
+		return false;
+	}
+
+	// we're mapped!  Copy over
+	memcpy( mappedData, data, byteSize ); 
+
+	// unlock the resource (we're done writing)
+	Unmap();
+	return true; 
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void* RenderBuffer::MapForWrite()
+{
 	// Map and copy
 	// This is a command, so runs using the context
 	ID3D11DeviceContext *deviceContext = m_owningRenderContext->m_D3DContext; 
@@ -165,21 +182,13 @@ bool RenderBuffer::CopyCPUToGPU( void const *data, size_t const byteSize )
 		0U,   // option to allow this to fail if the resource is in use, 0U means we'll wait...
 		&resource ); 
 
-	if (SUCCEEDED(hr)) 
-	{
-		// we're mapped!  Copy over
-		memcpy( resource.pData, data, byteSize ); 
-
-		// unlock the resource (we're done writing)
-		deviceContext->Unmap( m_handle, 0 ); 
-
-		return true; 
+	return SUCCEEDED(hr) ? resource.pData : nullptr;
+}
 
-	} 
-	else 
-	{
-		return false; 
-	}
+//------------------------------------------------------------------------------------------------------------------------------
+void RenderBuffer::Unmap()
+{
+	m_owningRenderContext->m_D3DContext->Unmap( m_handle, 0 ); 
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -28,6 +28,9 @@ public:
 
 	static D3D11_USAGE DXUsageFromMemoryUsage( eGPUMemoryUsage const usage );
 
+	// Ends a MapForWrite
+	void					Unmap();
+
 protected:
 	// for doing initial setup - we'll mark 
 	// it as protected as the higher level classes
@@ -42,6 +45,10 @@ protected:
 	// Only valid for DYNAMIC buffers; 
 	bool					CopyCPUToGPU( void const *data, size_t const byteSize ); 
 
+	// Discards the old contents and returns where to write the new ones, nullptr if the map failed. Only valid for 
+	// DYNAMIC buffers, the memory is write combined so write it once front to back and never read it.
+	void*					MapForWrite();
+
 public:
 	RenderContext*				m_owningRenderContext = nullptr; 
 	eRenderBufferUsageBits		m_bufferUsage; 
@@ -203,6 +203,8 @@ RenderContext::RenderContext(WindowContext* window)
 	m_hwnd = window->m_hwnd;
 	D3D11Setup(window->m_hwnd);
 	Startup();
+
+	m_assetLoader = new AsyncAssetLoader(this);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -358,43 +360,9 @@ BitmapFont* RenderContext::CreateBitmapFontFromFile(const std::string& bitmapNam
 //------------------------------------------------------------------------------------------------------------------------------
 Shader* RenderContext::CreateShaderFromFile(const std::string& fileName)
 {
-	//Check the file extention
-	std::vector<std::string> strings = SplitStringOnDelimiter(fileName, '.');
-	bool isDataDriven = false;
-	if(strings.size() > 1)
-	{
-		for(int i = 0; i < (int)strings.size(); i++)
-		{
-			if(strings[i] == "xml")
-			{
-				isDataDriven = true;
-			}
-		}
-	}
-
 	Shader* shader = new Shader();
-	char* outData = nullptr;
-	unsigned long bufferSize;
-	if(isDataDriven)
-	{
-		//Load the Shader from XML
-		shader->LoadShaderFromXMLSource(fileName);
-
-		bufferSize = CreateFileReadBuffer( shader->m_shaderSourcePath, &outData); 
-
-		shader->m_vertexStage.LoadShaderFromSource(this, shader->m_shaderSourcePath, outData, bufferSize, SHADER_STAGE_VERTEX);
-		shader->m_pixelStage.LoadShaderFromSource(this, shader->m_shaderSourcePath, outData, bufferSize, SHADER_STAGE_FRAGMENT);
-	}
-	else
-	{
-		bufferSize = CreateFileReadBuffer( fileName, &outData); 
-
-		shader->m_vertexStage.LoadShaderFromSource(this, fileName, outData, bufferSize, SHADER_STAGE_VERTEX );
-		shader->m_pixelStage.LoadShaderFromSource(this, fileName, outData, bufferSize, SHADER_STAGE_FRAGMENT);
-	}
-
-	//Delete your outData!
-	delete[] outData;
+	shader->CompileFromFile(fileName);
+	shader->CreateStagesFromByteCode(this);
 
 	m_loadedShaders[fileName] = shader;
 	return shader;
@@ -567,6 +535,9 @@ void RenderContext::BeginFrame()
 {
 	gProfiler->ProfilerPush("RenderContext::BeginFrame");
 
+	//Device side of whatever streamed in since last frame
+	m_assetLoader->ProcessFinishedLoads();
+
 	// Get the back buffer
 	ID3D11Texture2D *back_buffer = nullptr;
 	m_D3DSwapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (LPVOID*)&back_buffer);
@@ -710,6 +681,9 @@ void RenderContext::Shutdown()
 	delete m_immediateMesh;
 	m_immediateMesh = nullptr;
 
+	delete m_assetLoader;
+	m_assetLoader = nullptr;
+
 	ClearAllAssetRepositories();
 
 	/*
@@ -730,6 +704,12 @@ void RenderContext::Shutdown()
 //------------------------------------------------------------------------------------------------------------------------------
 void RenderContext::ClearAllAssetRepositories()
 {
+	//Streaming requests point into the databases below
+	if (m_assetLoader != nullptr)
+	{
+		m_assetLoader->Reset();
+	}
+
 	//m_loadedShaders;
 	std::map< std::string, Shader*>::iterator shaderIterator;
 	std::map< std::string, Shader*>::iterator lastShaderIterator;
@@ -1071,6 +1051,25 @@ void RenderContext::RegisterTextureView(std::string const &fileName, TextureView
 	}
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+// For images decoded somewhere else, the streaming loader decodes on its I/O thread
+//------------------------------------------------------------------------------------------------------------------------------
+TextureView* RenderContext::CreateTextureViewFromImage(const std::string& fileName, const Image& image)
+{
+	Texture2D *tex = new Texture2D(this); 
+	if (!tex->LoadTextureFromImage(image))
+	{
+		delete tex;
+		return nullptr;
+	}
+
+	TextureView* view = tex->CreateTextureView2D(); 
+	delete tex;  
+
+	m_cachedTextureViews[fileName] = view; 
+	return view;
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 void RenderContext::Draw( uint vertexCount, uint byteOffset )
 {
@@ -1089,7 +1088,7 @@ void RenderContext::Draw( uint vertexCount, uint byteOffset )
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-void RenderContext::DrawIndexed( uint indexCount)
+void RenderContext::DrawIndexed( uint indexCount, uint startIndex )
 {
 	//bool result =  m_currentShader->CreateInputLayoutForVertexPCU(); 
 
@@ -1098,7 +1097,7 @@ void RenderContext::DrawIndexed( uint indexCount)
 
 	// Draw
 	m_D3DContext->DrawIndexed( indexCount, 
-		0,       // elem offset 
+		startIndex,       // elem offset 
 		0 );     // vert offset 
 }
 
@@ -1330,21 +1329,70 @@ void RenderContext::DrawVertexArray( Vertex_PCU const *vertices, uint count )
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-bool RenderContext::PreDraw( GPUMesh *mesh)
+bool RenderContext::PreDraw( GPUMesh *mesh, const BufferLayout* instanceLayout )
 {
 	//Bind the uniforms
 	UpdateLightBuffer();
 	BindUniformBuffer(UNIFORM_SLOT_LIGHT, m_gpuLightBuffer);
 
+	//Quantized positions decode with the mesh's offset and scale, only re-upload the model buffer when they change
+	Vec4 positionOffset = Vec4(mesh->m_positionOffset.x, mesh->m_positionOffset.y, mesh->m_positionOffset.z, 0.f);
+	Vec4 positionScale = Vec4(mesh->m_positionScale.x, mesh->m_positionScale.y, mesh->m_positionScale.z, 0.f);
+	if (m_cpuModelBuffer.PositionOffset != positionOffset || m_cpuModelBuffer.PositionScale != positionScale)
+	{
+		m_cpuModelBuffer.PositionOffset = positionOffset;
+		m_cpuModelBuffer.PositionScale = positionScale;
+		m_modelBuffer->CopyCPUToGPU( &m_cpuModelBuffer, sizeof(m_cpuModelBuffer) ); 
+	}
+
 	//Bind vertex and index streams
 	BindVertexStream( mesh->m_vertexBuffer ); 
 	BindIndexStream( mesh->m_indexBuffer ); 
 
 	//Creat the input layout based on the mesh's layout
-	bool result = m_currentShader->CreateInputLayout(mesh->m_layout);
+	bool result = m_currentShader->CreateInputLayout(mesh->m_layout, instanceLayout);
 	return result;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+// Screen space error: the LOD's error in world units over the distance from the camera to the mesh's bounding sphere,
+// scaled by how many pixels the projection puts in one unit at distance one
+//------------------------------------------------------------------------------------------------------------------------------
+uint RenderContext::SelectLODForMesh( const GPUMesh* mesh ) const
+{
+	if (m_lodPixelError <= 0.f || m_currentCamera == nullptr || m_currentCamera->m_colorTargetView == nullptr)
+	{
+		return 0;
+	}
+
+	const Matrix44& model = m_cpuModelBuffer.ModelMatrix;
+	const Matrix44& projection = m_currentCamera->GetProjectionMatrix();
+	float halfHeight = static_cast<float>(m_currentCamera->m_colorTargetView->m_height) * 0.5f;
+
+	float modelScale = model.GetIBasis().GetLength();
+	modelScale = (model.GetJBasis().GetLength() > modelScale) ? model.GetJBasis().GetLength() : modelScale;
+	modelScale = (model.GetKBasis().GetLength() > modelScale) ? model.GetKBasis().GetLength() : modelScale;
+	float pixelsPerUnit = projection.m_values[Matrix44::Jy] * halfHeight * modelScale;
+
+	//Perspective projections put the depth in w, orthographic ones don't shrink with distance
+	if (projection.m_values[Matrix44::Kw] != 0.f)
+	{
+		Vec3 center = model.TransformPosition3D((mesh->m_boundsMins + mesh->m_boundsMaxs) * 0.5f);
+		float radius = (mesh->m_boundsMaxs - mesh->m_boundsMins).GetLength() * 0.5f * modelScale;
+		float distance = (center - m_currentCamera->GetModelMatrix().GetTBasis()).GetLength() - radius;
+
+		//Inside the bounds always gets LOD0
+		if (distance <= 0.f)
+		{
+			return 0;
+		}
+
+		pixelsPerUnit /= distance;
+	}
+
+	return mesh->SelectLOD(fabsf(pixelsPerUnit), m_lodPixelError);
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 void RenderContext::DrawMesh( GPUMesh *mesh )
 {
@@ -1352,7 +1400,12 @@ void RenderContext::DrawMesh( GPUMesh *mesh )
 
 	if(result)
 	{
-		if (mesh->UsesIndexBuffer()) 
+		if (mesh->UsesIndexBuffer() && mesh->GetLODCount() > 1)
+		{
+			const MeshLOD& lod = mesh->GetLOD(SelectLODForMesh(mesh));
+			DrawIndexed( lod.m_numIndices, lod.m_firstIndex );
+		}
+		else if (mesh->UsesIndexBuffer()) 
 		{
 			DrawIndexed( mesh->GetElementCount()); 
 		} 
@@ -1367,6 +1420,59 @@ void RenderContext::DrawMesh( GPUMesh *mesh )
 	}
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+void RenderContext::DrawMeshInstanced( GPUMesh *mesh, VertexBuffer *instances, const BufferLayout* instanceLayout, uint instanceCount, uint firstInstance )
+{
+	if (instanceCount == 0)
+	{
+		return;
+	}
+
+	bool result = PreDraw(mesh, instanceLayout);
+	if (!result)
+	{
+		ERROR_AND_DIE("Could not create instanced input layout!");
+	}
+
+	uint stride = instanceLayout->GetStride();
+	uint offset = 0U;
+	m_D3DContext->IASetVertexBuffers( 1, 1, &instances->m_handle, &stride, &offset );
+
+	m_D3DContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	m_D3DContext->IASetInputLayout( m_currentShader->m_inputLayout );
+
+	if (mesh->UsesIndexBuffer())
+	{
+		uint indexCount = (mesh->GetLODCount() > 1) ? mesh->GetLOD(0).m_numIndices : mesh->GetElementCount();
+		m_D3DContext->DrawIndexedInstanced( indexCount, instanceCount, 0U, 0, firstInstance );
+	}
+	else
+	{
+		m_D3DContext->DrawInstanced( mesh->GetVertexCount(), instanceCount, 0U, firstInstance );
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void RenderContext::DrawIndexedVertexBuffer( VertexBuffer *vbo, IndexBuffer *ibo, const BufferLayout* layout, uint indexCount, uint firstIndex )
+{
+	if (indexCount == 0)
+	{
+		return;
+	}
+
+	BindVertexStream( vbo ); 
+	BindIndexStream( ibo ); 
+	bool result = m_currentShader->CreateInputLayout(layout);
+	if(result)
+	{
+		DrawIndexed( indexCount, firstIndex ); 
+	}
+	else
+	{
+		ERROR_AND_DIE("Could not create Shader Input Layout for the vertex buffer");
+	}
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 // Version to apply the effect on the default FX Color Target
 //------------------------------------------------------------------------------------------------------------------------------
@@ -1532,25 +1638,33 @@ GPUMesh* RenderContext::CreateOrGetMeshFromFile(const std::string& fileName)
 
 		//Create the Model
 		ObjectLoader* model = ObjectLoader::MakeLoaderAndLoadMeshFromFile(this, filePath, isDataDriven);
-		
-		//Setup materials
-		std::vector<std::string> splits = SplitStringOnDelimiter(fileName, '.');
-		if (splits[splits.size() - 1] == "obj" || splits[splits.size() - 1] == "mesh")
-		{
-			filePath = MODEL_PATH + splits[0] + ".mat";
-			model->m_mesh->m_defaultMaterial = filePath;
-		}
-
-		filePath = MODEL_PATH + fileName;
-		m_modelDatabase.insert(std::pair<std::string, GPUMesh*>(filePath, model->m_mesh));
-		model->m_mesh = nullptr;
+		GPUMesh* mesh = AddLoadedMeshToDatabase(fileName, model);
 		
 		delete model;
 		
-		return m_modelDatabase[filePath];
+		return mesh;
 	}
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+// Takes the GPUMesh from a loader that has finished, shared by sync loads and the streaming loader
+//------------------------------------------------------------------------------------------------------------------------------
+GPUMesh* RenderContext::AddLoadedMeshToDatabase(const std::string& fileName, ObjectLoader* model)
+{
+	//Setup materials
+	std::vector<std::string> splits = SplitStringOnDelimiter(fileName, '.');
+	if (splits[splits.size() - 1] == "obj" || splits[splits.size() - 1] == "mesh")
+	{
+		model->m_mesh->m_defaultMaterial = MODEL_PATH + splits[0] + ".mat";
+	}
+
+	std::string filePath = MODEL_PATH + fileName;
+	m_modelDatabase.insert(std::pair<std::string, GPUMesh*>(filePath, model->m_mesh));
+	model->m_mesh = nullptr;
+
+	return m_modelDatabase[filePath];
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 void RenderContext::AddMeshToDatabase(const std::string& fileName, GPUMesh* mesh)
 {
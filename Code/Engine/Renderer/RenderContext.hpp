@@ -1,6 +1,7 @@
 //------------------------------------------------------------------------------------------------------------------------------
 #pragma once
 #include "Engine/Math/Vertex_PCU.hpp"
+#include "Engine/Renderer/AsyncAssetLoader.hpp"
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Renderer/ImGUISystem.hpp"
 #include "Engine/Renderer/RendererTypes.hpp"
@@ -12,11 +13,13 @@
 
 //------------------------------------------------------------------------------------------------------------------------------
 //Forward Declarations
+class BufferLayout;
 class ColorTargetView;
 class GPUMesh;
 class Image;
 class IndexBuffer;
 class Material;
+class ObjectLoader;
 class Model;
 class RenderBuffer;
 class Shader;
@@ -37,6 +40,9 @@ struct IDXGISwapChain;
 struct ID3D11RenderTargetView;
 struct ID3D11RasterizerState;
 
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr float		DEFAULT_LOD_PIXEL_ERROR = 1.f;
+
 //------------------------------------------------------------------------------------------------------------------------------
 enum eProdigyDefaultTexture
 {
@@ -50,6 +56,7 @@ enum eProdigyDefaultTexture
 //------------------------------------------------------------------------------------------------------------------------------
 class RenderContext
 {
+	friend class AsyncAssetLoader;
 	friend class DepthStencilTargetView;
 	friend class ImGUISystem;
 	friend class Material;
@@ -110,6 +117,9 @@ public:
 	GPUMesh*					CreateOrGetMeshFromFile( const std::string& fileName );
 	void						AddMeshToDatabase(const std::string& fileName, GPUMesh* mesh);
 
+	//Streamed resources, the Get functions on the loader return placeholders until they're ready
+	inline AsyncAssetLoader*	GetAssetLoader()		{ return m_assetLoader; }
+
 	//Shader data
 	void						BindShader(Shader* shader);
 	void						SetBlendMode(eBlendMode blendMode);
@@ -155,11 +165,19 @@ public:
 
 	//Draw Calls	
 	void						Draw(uint vertexCount, uint byteOffset = 0U);
-	void						DrawIndexed( uint indexCount);                                 
+	void						DrawIndexed( uint indexCount, uint startIndex = 0U );                                 
 	void						DrawVertexArray( Vertex_PCU const *vertices, uint count ); 
 	void						DrawVertexArray( int numVertexes, const Vertex_PCU* vertexes );
 	void						DrawVertexArray( const std::vector<Vertex_PCU>& vertexes);
 	void						DrawMesh( GPUMesh *mesh );                                         
+	// LOD0 once per instance, instanceLayout describes the per instance data in instances (input slot 1)
+	void						DrawMeshInstanced( GPUMesh *mesh, VertexBuffer *instances, const BufferLayout* instanceLayout, uint instanceCount, uint firstInstance = 0U );
+	// A range of indices into buffers filled elsewhere, for streams that are uploaded once and drawn in pieces
+	void						DrawIndexedVertexBuffer( VertexBuffer *vbo, IndexBuffer *ibo, const BufferLayout* layout, uint indexCount, uint firstIndex = 0U );
+
+	// Meshes with LODs draw the coarsest one that stays within this many pixels of LOD0, 0 always draws LOD0
+	inline void					SetLODPixelError( float pixels )	{ m_lodPixelError = pixels; }
+	inline float				GetLODPixelError() const			{ return m_lodPixelError; }
 	
 	//Full screen effects helpers
 	void						ApplyEffect(Material *mat);
@@ -183,11 +201,14 @@ private:
 
 	void						DemoRender();            // Does rendering for this demo
 
-	bool						PreDraw(GPUMesh *mesh);
+	bool						PreDraw(GPUMesh *mesh, const BufferLayout* instanceLayout = nullptr);
+	uint						SelectLODForMesh(const GPUMesh* mesh) const;
 
 	// Private (internal) member functions will go here
 	BitmapFont*					CreateBitmapFontFromFile(const std::string& bitmapName, eFontType fontType, const IntVec2& splitSize);
 	Shader*						CreateShaderFromFile(const std::string& fileName);
+	TextureView*				CreateTextureViewFromImage(const std::string& fileName, const Image& image);
+	GPUMesh*					AddLoadedMeshToDatabase(const std::string& fileName, ObjectLoader* model);
 
 private:
 	// Private (internal) data members will go here
@@ -196,6 +217,7 @@ private:
 	std::map<std::string, TextureView*>					m_cachedTextureViews;
 	std::map<std::string, Material*>					m_materialDatabase;
 	std::map<std::string, GPUMesh*>						m_modelDatabase;
+	AsyncAssetLoader*									m_assetLoader = nullptr;
 
 	ID3D11Device										*m_D3DDevice = nullptr;
 	ID3D11DeviceContext									*m_D3DContext = nullptr;
@@ -230,6 +252,7 @@ private:
 
 	GPUMesh*											m_immediateMesh = nullptr;
 	ModelBufferT										m_cpuModelBuffer;
+	float												m_lodPixelError = DEFAULT_LOD_PIXEL_ERROR;
 
 	//Full screen effects
 	Camera*												m_FXCam = nullptr;
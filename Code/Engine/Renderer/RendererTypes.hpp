@@ -67,6 +67,10 @@ struct ModelBufferT
 {
 	Matrix44 ModelMatrix;
 	Rgba TintColor = Rgba::WHITE;
+
+	// Undoes position quantization (Vertex_LitQuantized), identity for float positions
+	Vec4 PositionOffset = Vec4(0.f, 0.f, 0.f, 0.f);
+	Vec4 PositionScale = Vec4(1.f, 1.f, 1.f, 0.f);
 };
 
 // I start at slot 1 out of habit.  I reserve slot 0 for what I call the "SYTEM" buffer, which
@@ -180,6 +184,12 @@ enum eDataFormat
 	DF_VEC2, 
 	DF_VEC3, 
 	DF_RGBA32, 
+
+	//Packed formats, see VertexPacking.hpp
+	DF_SNORM16_2,		// octahedral directions
+	DF_RGBA8_UNORM,
+	DF_HALF2,
+	DF_UNORM16_4,		// quantized positions
 };
 
 //------------------------------------------------------------------------------------------------------------------------------
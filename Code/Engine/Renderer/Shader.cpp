@@ -162,6 +162,10 @@ STATIC DXGI_FORMAT Shader::GetDXDataFormat( eDataFormat const format )
 	case DF_RGBA32:					return DXGI_FORMAT_R32G32B32A32_FLOAT;
 	case DF_VEC2:					return DXGI_FORMAT_R32G32_FLOAT;
 	case DF_VEC3:					return DXGI_FORMAT_R32G32B32_FLOAT;
+	case DF_SNORM16_2:				return DXGI_FORMAT_R16G16_SNORM;
+	case DF_RGBA8_UNORM:			return DXGI_FORMAT_R8G8B8A8_UNORM;
+	case DF_HALF2:					return DXGI_FORMAT_R16G16_FLOAT;
+	case DF_UNORM16_4:				return DXGI_FORMAT_R16G16B16A16_UNORM;
 	case DF_NULL:					ERROR_AND_DIE("The format recieved was null");
 	default:
 	{
@@ -361,9 +365,9 @@ bool Shader::CreateInputLayoutForVertexPCU()
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-bool Shader::CreateInputLayout(const BufferLayout* layout)
+bool Shader::CreateInputLayout(const BufferLayout* layout, const BufferLayout* instanceLayout)
 {
-	if(layout == m_bufferLayout)
+	if(layout == m_bufferLayout && instanceLayout == m_instanceLayout)
 	{
 		return true;
 	}
@@ -371,22 +375,28 @@ bool Shader::CreateInputLayout(const BufferLayout* layout)
 	//Free old inputLayout
 	DX_SAFE_RELEASE( m_inputLayout ); 
 
-	D3D11_INPUT_ELEMENT_DESC *inputDescription = new D3D11_INPUT_ELEMENT_DESC[layout->GetAttributeCount()];
+	int vertexCount = (int)layout->GetAttributeCount();
+	int count = vertexCount + ((instanceLayout != nullptr) ? (int)instanceLayout->GetAttributeCount() : 0);
+
+	D3D11_INPUT_ELEMENT_DESC *inputDescription = new D3D11_INPUT_ELEMENT_DESC[count];
 	//D3D11_INPUT_ELEMENT_DESC inputDescription[3];
 
-	memset( inputDescription, 0, sizeof(inputDescription) ); 
+	memset( inputDescription, 0, sizeof(D3D11_INPUT_ELEMENT_DESC) * count ); 
 
-	int count = (int)layout->GetAttributeCount();
 	for(int attrIdx = 0; attrIdx < count; attrIdx++)
 	{
+		//Vertex attributes first, then the instance ones
+		bool isInstanceData = (attrIdx >= vertexCount);
+		const BufferAttributeT& attribute = isInstanceData ? instanceLayout->m_attributes[attrIdx - vertexCount] : layout->m_attributes[attrIdx];
+
 		// Map Position
-		inputDescription[attrIdx].SemanticName = layout->m_attributes[attrIdx].m_name.c_str();             // __semantic__ name we gave this input -> float3 pos : POSITION; 
+		inputDescription[attrIdx].SemanticName = attribute.m_name.c_str();             // __semantic__ name we gave this input -> float3 pos : POSITION; 
 		inputDescription[attrIdx].SemanticIndex = 0;                     // Semantics that share a name (or are large) are spread over multiple indices (matrix4x4s are four floats for instance)
-		inputDescription[attrIdx].Format = Shader::GetDXDataFormat(layout->m_attributes[attrIdx].m_type);// DXGI_FORMAT_R32G32B32_FLOAT;  // Type this data is (float3/vec3 - so 3 floats)
-		inputDescription[attrIdx].InputSlot = 0U;                        // Input Pipe this comes from (ignored unless doing instanced rendering)
-		inputDescription[attrIdx].AlignedByteOffset = (UINT) layout->m_attributes[attrIdx].m_memberOffset;   // memory offset this data starts (where is position relative to the vertex, 0 in this case)
-		inputDescription[attrIdx].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;   // What is this data for (per vertex data is the only one we'll be dealing with in this class)
-		inputDescription[attrIdx].InstanceDataStepRate = 0U;             // If this were instance data - how often do we step it (0 for vertex data)
+		inputDescription[attrIdx].Format = Shader::GetDXDataFormat(attribute.m_type);// DXGI_FORMAT_R32G32B32_FLOAT;  // Type this data is (float3/vec3 - so 3 floats)
+		inputDescription[attrIdx].InputSlot = isInstanceData ? 1U : 0U;                        // Input Pipe this comes from (ignored unless doing instanced rendering)
+		inputDescription[attrIdx].AlignedByteOffset = (UINT) attribute.m_memberOffset;   // memory offset this data starts (where is position relative to the vertex, 0 in this case)
+		inputDescription[attrIdx].InputSlotClass = isInstanceData ? D3D11_INPUT_PER_INSTANCE_DATA : D3D11_INPUT_PER_VERTEX_DATA;   // What is this data for
+		inputDescription[attrIdx].InstanceDataStepRate = isInstanceData ? 1U : 0U;             // If this were instance data - how often do we step it (0 for vertex data)
 
 	}
 
@@ -404,6 +414,7 @@ bool Shader::CreateInputLayout(const BufferLayout* layout)
 	delete[] inputDescription;
 
 	m_bufferLayout = layout;
+	m_instanceLayout = instanceLayout;
 
 	return SUCCEEDED(hr); 
 
@@ -619,12 +630,73 @@ void Shader::ReadFromPass( XMLElement& passEntry )
 	m_shaderSourcePath = ParseXmlAttribute(passEntry, "src", m_shaderSourcePath);
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+bool Shader::CompileFromFile( const std::string &fileName )
+{
+	//Check the file extention
+	std::vector<std::string> strings = SplitStringOnDelimiter(fileName, '.');
+	bool isDataDriven = false;
+	if(strings.size() > 1)
+	{
+		for(int i = 0; i < (int)strings.size(); i++)
+		{
+			if(strings[i] == "xml")
+			{
+				isDataDriven = true;
+			}
+		}
+	}
+
+	std::string sourcePath = fileName;
+	if(isDataDriven)
+	{
+		//Load the Shader from XML
+		if (!DoesFileExist(fileName))
+		{
+			DebuggerPrintf("\n Shader file %s does not exist", fileName.c_str());
+			return false;
+		}
+
+		LoadShaderFromXMLSource(fileName);
+		sourcePath = m_shaderSourcePath;
+	}
+
+	char* outData = nullptr;
+	unsigned long bufferSize = CreateFileReadBuffer( sourcePath, &outData); 
+
+	bool vertexCompiled = m_vertexStage.CompileFromSource(sourcePath, outData, bufferSize, SHADER_STAGE_VERTEX);
+	bool pixelCompiled = m_pixelStage.CompileFromSource(sourcePath, outData, bufferSize, SHADER_STAGE_FRAGMENT);
+
+	//Delete your outData!
+	delete[] outData;
+
+	return vertexCompiled && pixelCompiled;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool Shader::CreateStagesFromByteCode( RenderContext *renderContext )
+{
+	bool vertexCreated = m_vertexStage.CreateFromByteCode(renderContext);
+	bool pixelCreated = m_pixelStage.CreateFromByteCode(renderContext);
+
+	return vertexCreated && pixelCreated;
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 bool ShaderStage::LoadShaderFromSource( RenderContext *renderContext, const std::string &fileName, void const *source, unsigned long sourceSize, eShaderStage stage )
+{
+	if (!CompileFromSource(fileName, source, sourceSize, stage))
+	{
+		return false;
+	}
+
+	return CreateFromByteCode(renderContext);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool ShaderStage::CompileFromSource( const std::string &fileName, void const *source, unsigned long sourceSize, eShaderStage stage )
 {
 	m_stage = stage; 
-	m_owningRenderContext = renderContext;
-	ID3D11Device *device = renderContext->m_D3DDevice; 
 
 	const char* stageEntry;
 	if(m_stageEntry == "")
@@ -636,13 +708,21 @@ bool ShaderStage::LoadShaderFromSource( RenderContext *renderContext, const std:
 		stageEntry = m_stageEntry.c_str();
 	}
 
-
 	m_byteCode = CompileHLSLToShaderBlob( fileName.c_str(), source, sourceSize, stageEntry, Shader::GetShaderModelForStage(stage) ); 
+	return m_byteCode != nullptr;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool ShaderStage::CreateFromByteCode( RenderContext *renderContext )
+{
+	m_owningRenderContext = renderContext;
+	ID3D11Device *device = renderContext->m_D3DDevice; 
+
 	if (m_byteCode == nullptr) {
 		return false; 
 	}
 
-	switch (stage) 
+	switch (m_stage) 
 	{
 	case SHADER_STAGE_VERTEX:    // Compile the byte code to the final shader (driver/hardware specific program)
 	device->CreateVertexShader( m_byteCode->GetBufferPointer(), 
@@ -661,7 +741,7 @@ bool ShaderStage::LoadShaderFromSource( RenderContext *renderContext, const std:
 
 	//We need to keep byte code for vertex shader to use in InputLayout to feed details
 	//about the type of input being sent to the shader pipeline
-	if(stage != SHADER_STAGE_VERTEX)
+	if(m_stage != SHADER_STAGE_VERTEX)
 	{
 		DX_SAFE_RELEASE(m_byteCode);
 	}
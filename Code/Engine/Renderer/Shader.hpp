@@ -28,6 +28,10 @@ public:
 public:
 	bool LoadShaderFromSource( RenderContext *renderContext, const std::string &fileName, void const *source, unsigned long sourceSize, eShaderStage stage );
 
+	// LoadShaderFromSource in two halves, compiling doesn't need the device so it can happen off the main thread
+	bool CompileFromSource( const std::string &fileName, void const *source, unsigned long sourceSize, eShaderStage stage );
+	bool CreateFromByteCode( RenderContext *renderContext );
+
 	eShaderStage m_stage; 
 	union {
 		ID3D11Resource *m_handle; 
@@ -61,6 +65,10 @@ public:
 
 	// XML Utilities for Shader
 	void					LoadShaderFromXMLSource( const std::string &fileName);
+	
+	// Reads the .xml (or plain .hlsl) and compiles both stages, nothing here touches the device
+	bool					CompileFromFile( const std::string &fileName );
+	bool					CreateStagesFromByteCode( RenderContext *renderContext );
 	void					SetBlendDataFromString();
 	void					SetDepthOpFromString();
 	eBlendOperation			SetOpFromString( const std::string& blendOp );
@@ -69,7 +77,8 @@ public:
 	
 	// Create Input layouts based on what type of buffer we are passing
 	bool					CreateInputLayoutForVertexPCU(); 
-	bool					CreateInputLayout(const BufferLayout* layout);
+	// instanceLayout, if given, is read from input slot 1 once per instance
+	bool					CreateInputLayout(const BufferLayout* layout, const BufferLayout* instanceLayout = nullptr);
 
 
 	// Depth stencil state now also needs to be generated; 
@@ -118,6 +127,7 @@ public:
 	std::string		m_blendDstAlphaString = "";
 
 	BufferLayout const *m_bufferLayout = nullptr;
+	BufferLayout const *m_instanceLayout = nullptr;
 
 	ID3D11InputLayout*			m_inputLayout = nullptr; 
 	ID3D11BlendState*			m_blendState = nullptr; 
@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/StaticMeshCuller.hpp"
+//Engine Systems
+#include "Engine/Commons/EngineCommon.hpp"
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Math/Matrix44.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/GPUMesh.hpp"
+#include "Engine/Renderer/Model.hpp"
+#include <math.h>
+
+//------------------------------------------------------------------------------------------------------------------------------
+StaticMeshCuller::StaticMeshCuller()
+{
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+StaticMeshCuller::~StaticMeshCuller()
+{
+
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int StaticMeshCuller::AddModel( Model* model )
+{
+	Vec3 worldMins;
+	Vec3 worldMaxs;
+	TransformBounds(&worldMins, &worldMaxs, model->m_modelMatrix, model->m_mesh->m_boundsMins, model->m_mesh->m_boundsMaxs);
+
+	return AddModel(model, worldMins, worldMaxs);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int StaticMeshCuller::AddModel( Model* model, const Vec3& worldMins, const Vec3& worldMaxs )
+{
+	m_models.push_back(model);
+	m_isBVHDirty = true;
+
+	return m_worldBounds.AddBounds(worldMins, worldMaxs);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void StaticMeshCuller::UpdateModelBounds( int modelIndex, const Vec3& worldMins, const Vec3& worldMaxs )
+{
+	m_worldBounds.SetBounds(modelIndex, worldMins, worldMaxs);
+	m_isBVHDirty = true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void StaticMeshCuller::Clear()
+{
+	m_models.clear();
+	m_worldBounds.Clear();
+	m_bvh.Clear();
+	m_isBVHDirty = false;
+	m_lastNumVisible = 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void StaticMeshCuller::CullForCamera( std::vector<Model*>* outVisible, const Camera& camera )
+{
+	CullForFrustum(outVisible, camera.GetWorldFrustum());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void StaticMeshCuller::CullForFrustum( std::vector<Model*>* outVisible, const Frustum& frustum )
+{
+	if (m_isBVHDirty)
+	{
+		m_bvh.Build(m_worldBounds);
+		m_isBVHDirty = false;
+	}
+
+	m_visibleScratch.clear();
+	m_bvh.CullFrustum(&m_visibleScratch, frustum);
+
+	m_lastNumVisible = static_cast<int>(m_visibleScratch.size());
+	outVisible->reserve(outVisible->size() + m_visibleScratch.size());
+	for (int visibleIndex = 0; visibleIndex < m_lastNumVisible; visibleIndex++)
+	{
+		outVisible->push_back(m_models[m_visibleScratch[visibleIndex]]);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Box around a transformed box: the new center is the transformed center, and each new half extent is the old half
+// extents through the absolute basis vectors
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC void StaticMeshCuller::TransformBounds( Vec3* outMins, Vec3* outMaxs, const Matrix44& transform, const Vec3& mins, const Vec3& maxs )
+{
+	Vec3 center = transform.TransformPosition3D((mins + maxs) * 0.5f);
+	Vec3 halfExtents = (maxs - mins) * 0.5f;
+
+	const float* values = transform.m_values;
+	Vec3 worldHalfExtents;
+	worldHalfExtents.x = fabsf(values[Matrix44::Ix]) * halfExtents.x + fabsf(values[Matrix44::Jx]) * halfExtents.y + fabsf(values[Matrix44::Kx]) * halfExtents.z;
+	worldHalfExtents.y = fabsf(values[Matrix44::Iy]) * halfExtents.x + fabsf(values[Matrix44::Jy]) * halfExtents.y + fabsf(values[Matrix44::Ky]) * halfExtents.z;
+	worldHalfExtents.z = fabsf(values[Matrix44::Iz]) * halfExtents.x + fabsf(values[Matrix44::Jz]) * halfExtents.y + fabsf(values[Matrix44::Kz]) * halfExtents.z;
+
+	*outMins = center - worldHalfExtents;
+	*outMaxs = center + worldHalfExtents;
+}
@@ -0,0 +1,48 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+//Engine Systems
+#include "Engine/Math/FrustumCulling.hpp"
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------------------
+class Model;
+struct Camera;
+struct Frustum;
+struct Matrix44;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Frustum culling for models that do not move. Models are added once with their world bounds, the BVH is rebuilt the next
+// time something is culled, and each camera gets the list of models it can see to pass on to DrawMesh.
+//
+// Models added without bounds use the bounds their GPUMesh got from its CPUMesh, moved by the model matrix. Moving a model
+// after adding it needs a Clear and re-add (or UpdateModelBounds).
+//------------------------------------------------------------------------------------------------------------------------------
+class StaticMeshCuller
+{
+public:
+	StaticMeshCuller();
+	~StaticMeshCuller();
+
+	int							AddModel(Model* model);
+	int							AddModel(Model* model, const Vec3& worldMins, const Vec3& worldMaxs);
+	void						UpdateModelBounds(int modelIndex, const Vec3& worldMins, const Vec3& worldMaxs);
+	void						Clear();
+
+	//Visible models are appended to outVisible, which is not cleared first
+	void						CullForCamera(std::vector<Model*>* outVisible, const Camera& camera);
+	void						CullForFrustum(std::vector<Model*>* outVisible, const Frustum& frustum);
+
+	inline int					GetNumModels() const			{ return static_cast<int>(m_models.size()); }
+	inline int					GetLastNumVisible() const		{ return m_lastNumVisible; }
+
+	static void					TransformBounds(Vec3* outMins, Vec3* outMaxs, const Matrix44& transform, const Vec3& mins, const Vec3& maxs);
+
+private:
+	std::vector<Model*>			m_models;
+	PackedBounds3				m_worldBounds;
+	CullingBVH					m_bvh;
+	bool						m_isBVHDirty = false;
+
+	std::vector<int>			m_visibleScratch;
+	int							m_lastNumVisible = 0;
+};
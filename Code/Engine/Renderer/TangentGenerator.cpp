@@ -0,0 +1,382 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/TangentGenerator.hpp"
+//Engine Systems
+#include "Engine/Core/JobSystem/Job.hpp"
+#include "Engine/Core/JobSystem/JobSystem.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "ThirdParty/mikkt/mikktspace.h"
+#include <atomic>
+#include <math.h>
+#include <string.h>
+#include <thread>
+
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr uint		MESH_TANGENT_INVALID_INDEX = 0xFFFFFFFFU;
+constexpr float		MESH_TANGENT_MIN_UV_AREA = 1e-12f;			// UV determinant below this gives no usable direction
+constexpr float		MESH_TANGENT_MIN_LENGTH_SQUARED = 1e-12f;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// One group of triangles for MikkTSpace, m_triangles are triangle numbers in the full index list
+//------------------------------------------------------------------------------------------------------------------------------
+struct MikkTSpacePartition
+{
+	VertexMaster*		m_vertices = nullptr;
+	const Vec3*			m_normals = nullptr;
+	const uint*			m_indices = nullptr;
+	const uint*			m_triangles = nullptr;
+	uint				m_numTriangles = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+static const MikkTSpacePartition* GetMikkTSpacePartition( const SMikkTSpaceContext* context )
+{
+	return static_cast<const MikkTSpacePartition*>(context->m_pUserData);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static uint GetMikkTSpaceVertex( const SMikkTSpaceContext* context, int face, int corner )
+{
+	const MikkTSpacePartition* partition = GetMikkTSpacePartition(context);
+	return partition->m_indices[partition->m_triangles[face] * 3 + corner];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static int GetMikkTSpaceNumFaces( const SMikkTSpaceContext* context )
+{
+	return static_cast<int>(GetMikkTSpacePartition(context)->m_numTriangles);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static int GetMikkTSpaceNumVerticesOfFace( const SMikkTSpaceContext*, const int )
+{
+	return 3;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void GetMikkTSpacePosition( const SMikkTSpaceContext* context, float outPosition[], const int face, const int corner )
+{
+	const Vec3& position = GetMikkTSpacePartition(context)->m_vertices[GetMikkTSpaceVertex(context, face, corner)].m_position;
+	outPosition[0] = position.x;
+	outPosition[1] = position.y;
+	outPosition[2] = position.z;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void GetMikkTSpaceNormal( const SMikkTSpaceContext* context, float outNormal[], const int face, const int corner )
+{
+	const Vec3& normal = GetMikkTSpacePartition(context)->m_normals[GetMikkTSpaceVertex(context, face, corner)];
+	outNormal[0] = normal.x;
+	outNormal[1] = normal.y;
+	outNormal[2] = normal.z;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void GetMikkTSpaceTexCoord( const SMikkTSpaceContext* context, float outUV[], const int face, const int corner )
+{
+	const Vec2& uv = GetMikkTSpacePartition(context)->m_vertices[GetMikkTSpaceVertex(context, face, corner)].m_uv;
+	outUV[0] = uv.x;
+	outUV[1] = uv.y;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The real bitangent is kept rather than rebuilt from the sign, VertexMaster has room for it. MikkTSpace's points along
+// +v, which runs down the image for us (the OBJ loader flips v), and ours points up it like CPUMeshAddQuad's.
+//------------------------------------------------------------------------------------------------------------------------------
+static void SetMikkTSpaceTangent( const SMikkTSpaceContext* context, const float tangent[], const float biTangent[], const float, const float, const tbool, const int face, const int corner )
+{
+	VertexMaster& vertex = GetMikkTSpacePartition(context)->m_vertices[GetMikkTSpaceVertex(context, face, corner)];
+	vertex.m_tangent = Vec3(tangent[0], tangent[1], tangent[2]);
+	vertex.m_biTangent = Vec3(-biTangent[0], -biTangent[1], -biTangent[2]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static SMikkTSpaceInterface s_mikkTSpaceInterface =
+{
+	GetMikkTSpaceNumFaces,
+	GetMikkTSpaceNumVerticesOfFace,
+	GetMikkTSpacePosition,
+	GetMikkTSpaceNormal,
+	GetMikkTSpaceTexCoord,
+	nullptr,
+	SetMikkTSpaceTangent
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void GenerateMikkTSpaceForPartition( MikkTSpacePartition* partition )
+{
+	SMikkTSpaceContext context;
+	context.m_pInterface = &s_mikkTSpaceInterface;
+	context.m_pUserData = partition;
+
+	genTangSpaceDefault(&context);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+class MikkTSpaceJob : public Job
+{
+public:
+	MikkTSpaceJob(MikkTSpacePartition* partition, std::atomic<int>* jobsRemaining)
+		: m_partition(partition), m_jobsRemaining(jobsRemaining)
+	{
+	}
+
+	void Execute()
+	{
+		GenerateMikkTSpaceForPartition(m_partition);
+
+		//Last thing we touch, the partition and counter belong to the waiting caller
+		m_jobsRemaining->fetch_sub(1);
+	}
+
+private:
+	MikkTSpacePartition*	m_partition = nullptr;
+	std::atomic<int>*		m_jobsRemaining = nullptr;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+static uint FindTriangleGroup( std::vector<uint>& parents, uint triangle )
+{
+	while (parents[triangle] != triangle)
+	{
+		parents[triangle] = parents[parents[triangle]];
+		triangle = parents[triangle];
+	}
+
+	return triangle;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// MikkTSpace's own test for "the same vertex": position, normal and UV compared with ==, so -0 and 0 agree
+//------------------------------------------------------------------------------------------------------------------------------
+static void GetMikkTSpaceCornerKey( const VertexMaster& vertex, const Vec3& normal, float outKey[8] )
+{
+	const float values[8] = { vertex.m_position.x, vertex.m_position.y, vertex.m_position.z, normal.x, normal.y, normal.z, vertex.m_uv.x, vertex.m_uv.y };
+	for (int valueIndex = 0; valueIndex < 8; valueIndex++)
+	{
+		outKey[valueIndex] = (values[valueIndex] == 0.f) ? 0.f : values[valueIndex];
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static uint HashMikkTSpaceCornerKey( const float key[8] )
+{
+	//FNV-1a over the bytes, zeros are already made positive so equal keys hash equal
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(key);
+	uint hash = 2166136261U;
+
+	for (size_t byteIndex = 0; byteIndex < sizeof(float) * 8; byteIndex++)
+	{
+		hash ^= bytes[byteIndex];
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void GenerateMikkTSpaceTangents( std::vector<VertexMaster>& vertices, const std::vector<uint>& indices )
+{
+	uint numVertices = static_cast<uint>(vertices.size());
+	uint numCorners = static_cast<uint>(indices.size());
+	uint numTriangles = numCorners / 3;
+	if (numTriangles == 0)
+	{
+		return;
+	}
+
+	//MikkTSpace wants unit normals and compares what it is given, so both it and the grouping see these
+	std::vector<Vec3> normals(numVertices);
+	for (uint vertexIndex = 0; vertexIndex < numVertices; vertexIndex++)
+	{
+		const Vec3& normal = vertices[vertexIndex].m_normal;
+		normals[vertexIndex] = (normal.GetLengthSquared() > MESH_TANGENT_MIN_LENGTH_SQUARED) ? normal.GetNormalized() : normal;
+	}
+
+	std::vector<uint> parents(numTriangles);
+	for (uint triangleIndex = 0; triangleIndex < numTriangles; triangleIndex++)
+	{
+		parents[triangleIndex] = triangleIndex;
+	}
+
+	//Triangles with an identical corner end up in the same group. The table holds the first corner seen with each key.
+	uint tableSize = 2;
+	while (tableSize < numTriangles * 6)
+	{
+		tableSize <<= 1;
+	}
+
+	std::vector<float> cornerKeys(static_cast<size_t>(numTriangles) * 3 * 8);
+	std::vector<uint> table(tableSize, MESH_TANGENT_INVALID_INDEX);
+	for (uint cornerIndex = 0; cornerIndex < numTriangles * 3; cornerIndex++)
+	{
+		float* key = &cornerKeys[static_cast<size_t>(cornerIndex) * 8];
+		GetMikkTSpaceCornerKey(vertices[indices[cornerIndex]], normals[indices[cornerIndex]], key);
+
+		uint slot = HashMikkTSpaceCornerKey(key) & (tableSize - 1);
+		while (table[slot] != MESH_TANGENT_INVALID_INDEX && memcmp(&cornerKeys[static_cast<size_t>(table[slot]) * 8], key, sizeof(float) * 8) != 0)
+		{
+			slot = (slot + 1) & (tableSize - 1);
+		}
+
+		if (table[slot] == MESH_TANGENT_INVALID_INDEX)
+		{
+			table[slot] = cornerIndex;
+			continue;
+		}
+
+		uint groupA = FindTriangleGroup(parents, table[slot] / 3);
+		uint groupB = FindTriangleGroup(parents, cornerIndex / 3);
+		parents[(groupA > groupB) ? groupA : groupB] = (groupA < groupB) ? groupA : groupB;
+	}
+
+	//Pack whole groups into partitions of about MESH_TANGENT_TRIANGLES_PER_JOB, a group bigger than that gets one to itself.
+	//Every triangle points straight at its group's root from here on
+	std::vector<uint> groupSizes(numTriangles, 0);
+	for (uint triangleIndex = 0; triangleIndex < numTriangles; triangleIndex++)
+	{
+		parents[triangleIndex] = FindTriangleGroup(parents, triangleIndex);
+		groupSizes[parents[triangleIndex]]++;
+	}
+
+	std::vector<uint> groupPartitions(numTriangles, MESH_TANGENT_INVALID_INDEX);
+	std::vector<uint> partitionSizes;
+	for (uint triangleIndex = 0; triangleIndex < numTriangles; triangleIndex++)
+	{
+		uint group = parents[triangleIndex];
+		if (groupPartitions[group] != MESH_TANGENT_INVALID_INDEX)
+		{
+			continue;
+		}
+
+		if (partitionSizes.empty() || (partitionSizes.back() > 0 && partitionSizes.back() + groupSizes[group] > MESH_TANGENT_TRIANGLES_PER_JOB))
+		{
+			partitionSizes.push_back(0);
+		}
+
+		groupPartitions[group] = static_cast<uint>(partitionSizes.size()) - 1;
+		partitionSizes.back() += groupSizes[group];
+	}
+
+	//Triangles keep their order inside a partition
+	uint numPartitions = static_cast<uint>(partitionSizes.size());
+	std::vector<MikkTSpacePartition> partitions(numPartitions);
+	std::vector<uint> partitionTriangles(numTriangles);
+	std::vector<uint> partitionCursors(numPartitions);
+
+	uint firstTriangle = 0;
+	for (uint partitionIndex = 0; partitionIndex < numPartitions; partitionIndex++)
+	{
+		MikkTSpacePartition& partition = partitions[partitionIndex];
+		partition.m_vertices = vertices.data();
+		partition.m_normals = normals.data();
+		partition.m_indices = indices.data();
+		partition.m_triangles = partitionTriangles.data() + firstTriangle;
+		partition.m_numTriangles = partitionSizes[partitionIndex];
+
+		partitionCursors[partitionIndex] = firstTriangle;
+		firstTriangle += partitionSizes[partitionIndex];
+	}
+
+	for (uint triangleIndex = 0; triangleIndex < numTriangles; triangleIndex++)
+	{
+		partitionTriangles[partitionCursors[groupPartitions[parents[triangleIndex]]]++] = triangleIndex;
+	}
+
+	if (numPartitions == 1)
+	{
+		GenerateMikkTSpaceForPartition(&partitions[0]);
+		return;
+	}
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	std::atomic<int> jobsRemaining(static_cast<int>(numPartitions) - 1);
+	for (uint partitionIndex = 1; partitionIndex < numPartitions; partitionIndex++)
+	{
+		jobSystem->Run(new MikkTSpaceJob(&partitions[partitionIndex], &jobsRemaining));
+	}
+
+	//Do the first partition here and help out with the rest rather than sleeping
+	GenerateMikkTSpaceForPartition(&partitions[0]);
+	while (jobsRemaining.load() > 0)
+	{
+		if (!jobSystem->ProcessCategory(JOB_GENERIC))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Lengyel's per triangle UV derivatives, summed per vertex then made orthonormal against the normal
+//------------------------------------------------------------------------------------------------------------------------------
+void GenerateFastTangents( VertexMaster* vertices, uint numVertices, const uint* indices, uint numIndices )
+{
+	std::vector<Vec3> tangents(numVertices, Vec3::ZERO);
+	std::vector<Vec3> biTangents(numVertices, Vec3::ZERO);
+	std::vector<bool> isReferenced(numVertices, false);
+
+	for (uint cornerIndex = 0; cornerIndex + 2 < numIndices; cornerIndex += 3)
+	{
+		uint triangle[3] = { indices[cornerIndex], indices[cornerIndex + 1], indices[cornerIndex + 2] };
+		isReferenced[triangle[0]] = true;
+		isReferenced[triangle[1]] = true;
+		isReferenced[triangle[2]] = true;
+
+		const VertexMaster& vertex0 = vertices[triangle[0]];
+		Vec3 edge1 = vertices[triangle[1]].m_position - vertex0.m_position;
+		Vec3 edge2 = vertices[triangle[2]].m_position - vertex0.m_position;
+		Vec2 uvEdge1 = vertices[triangle[1]].m_uv - vertex0.m_uv;
+		Vec2 uvEdge2 = vertices[triangle[2]].m_uv - vertex0.m_uv;
+
+		float determinant = uvEdge1.x * uvEdge2.y - uvEdge2.x * uvEdge1.y;
+		if (fabsf(determinant) < MESH_TANGENT_MIN_UV_AREA)
+		{
+			continue;
+		}
+
+		float inverseDeterminant = 1.f / determinant;
+		Vec3 tangent = (edge1 * uvEdge2.y - edge2 * uvEdge1.y) * inverseDeterminant;
+		Vec3 biTangent = (edge1 * uvEdge2.x - edge2 * uvEdge1.x) * inverseDeterminant;		// -d(position)/dv, up the image
+
+		for (int corner = 0; corner < 3; corner++)
+		{
+			tangents[triangle[corner]] += tangent;
+			biTangents[triangle[corner]] += biTangent;
+		}
+	}
+
+	for (uint vertexIndex = 0; vertexIndex < numVertices; vertexIndex++)
+	{
+		if (!isReferenced[vertexIndex])
+		{
+			continue;
+		}
+
+		VertexMaster& vertex = vertices[vertexIndex];
+		Vec3 normal = vertex.m_normal;
+		if (normal.GetLengthSquared() < MESH_TANGENT_MIN_LENGTH_SQUARED)
+		{
+			continue;
+		}
+		normal = normal.GetNormalized();
+
+		//No UV area around this vertex, any direction in the tangent plane will do
+		Vec3 tangent = tangents[vertexIndex] - normal * GetDotProduct(normal, tangents[vertexIndex]);
+		if (tangent.GetLengthSquared() < MESH_TANGENT_MIN_LENGTH_SQUARED)
+		{
+			Vec3 axis = (fabsf(normal.x) < 0.9f) ? Vec3(1.f, 0.f, 0.f) : Vec3(0.f, 1.f, 0.f);
+			tangent = axis - normal * GetDotProduct(normal, axis);
+		}
+		tangent = tangent.GetNormalized();
+
+		//Keep the handedness of the UVs, mirrored UVs flip the bitangent
+		Vec3 biTangent = GetCrossProduct(normal, tangent);
+		if (GetDotProduct(biTangent, biTangents[vertexIndex]) < 0.f)
+		{
+			biTangent *= -1.f;
+		}
+
+		vertex.m_tangent = tangent;
+		vertex.m_biTangent = biTangent;
+	}
+}
@@ -0,0 +1,29 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+//Engine Systems
+#include "Engine/Math/VertexMaster.hpp"
+#include <vector>
+
+typedef unsigned int uint;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Tangent space generation.
+//
+// Imported meshes use MikkTSpace (ThirdParty/mikkt) so they match what normal maps are baked against. It runs at import
+// and the result is cooked into the PMSH, so cooked loads never pay for it. Triangles only share a tangent with
+// triangles that have an identical corner (position, normal and UV), so the mesh is cut into groups that never do and
+// the groups are handed to the JobSystem. The result is the same as one MikkTSpace run over the whole mesh, except on
+// zero area triangles, which MikkTSpace fills in from whichever neighbour it meets first.
+//
+// Procedural meshes don't need to match a baker and use the fast path: per triangle UV derivatives summed onto the
+// vertices and made orthogonal to the normal.
+//------------------------------------------------------------------------------------------------------------------------------
+constexpr uint		MESH_TANGENT_TRIANGLES_PER_JOB = 8192;		// groups are packed into jobs of about this many triangles
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Expects a triangle list with a vertex per corner, the way importers emit them before welding. Tangents are written
+// per corner, so welding afterwards only merges corners MikkTSpace agreed on.
+void		GenerateMikkTSpaceTangents(std::vector<VertexMaster>& vertices, const std::vector<uint>& indices);
+
+// Any indexed triangle list. Only vertices the indices touch are written.
+void		GenerateFastTangents(VertexMaster* vertices, uint numVertices, const uint* indices, uint numIndices);
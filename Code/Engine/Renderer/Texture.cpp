@@ -41,23 +41,7 @@ Texture2D::~Texture2D()
 //------------------------------------------------------------------------------------------------------------------------------
 bool Texture2D::LoadTextureFromFile( std::string const &filename, bool isFont ) 
 {
-	std::string path = filename;
-
-	std::vector<std::string> splitStrings = SplitStringOnDelimiter(path, '/');
-
-	if(!isFont && splitStrings.size() == 1)
-	{
-		path = IMAGE_PATH + filename;
-	}
-	else if (splitStrings.size() > 1 && !isFont)
-	{
-		// Encountered a '/' character so this is for a model
-		path = MODEL_PATH + filename;
-	}
-	else
-	{
-		path = FONT_PATH + filename + ".png";
-	}
+	std::string path = GetPathForTextureFile(filename, isFont);
 
 	Image image(path.c_str());
 
@@ -513,6 +497,26 @@ STATIC Texture2D* Texture2D::CreateTextureFromImage(RenderContext* renderContext
 	return texture;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC std::string Texture2D::GetPathForTextureFile( std::string const &filename, bool isFont )
+{
+	std::vector<std::string> splitStrings = SplitStringOnDelimiter(filename, '/');
+
+	if(!isFont && splitStrings.size() == 1)
+	{
+		return IMAGE_PATH + filename;
+	}
+	else if (splitStrings.size() > 1 && !isFont)
+	{
+		// Encountered a '/' character so this is for a model
+		return MODEL_PATH + filename;
+	}
+	else
+	{
+		return FONT_PATH + filename + ".png";
+	}
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 Texture::Texture( RenderContext *renderContext )
 {
@@ -75,4 +75,7 @@ public:
 	static Texture2D* CreateMatchingColorTarget( Texture2D* other );
 
 	static Texture2D* CreateTextureFromImage(RenderContext* renderContext, const Image& image);
+
+	// Where LoadTextureFromFile looks for the image, so it can be decoded somewhere else first
+	static std::string GetPathForTextureFile( std::string const &filename, bool isFont = false );
 };
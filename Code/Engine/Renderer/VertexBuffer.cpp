@@ -65,6 +65,31 @@ bool VertexBuffer::CopyCPUToGPU( void const *vertices, uint const count, uint co
 	return false;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+void* VertexBuffer::MapForWrite( uint const count, uint const stride )
+{
+	size_t sizeNeeded = count * stride; 
+	if (sizeNeeded == 0)
+	{
+		m_vertexCount = 0U;
+		return nullptr;
+	}
+
+	// same rules as CopyCPUToGPU, only made (without data) when it is too small or static
+	if (sizeNeeded > GetSize() || IsStatic()) 
+	{
+		if (!CreateBuffer( nullptr, sizeNeeded, stride, RENDER_BUFFER_USAGE_VERTEX_STREAM_BIT, GPU_MEMORY_USAGE_DYNAMIC ))
+		{
+			m_vertexCount = 0U;
+			return nullptr;
+		}
+	}
+
+	void* vertices = RenderBuffer::MapForWrite();
+	m_vertexCount = (vertices != nullptr) ? count : 0U;
+	return vertices;
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 //Creating a static buffer because we could store a static mesh in which case the vertices dont 
 //change and can be saved as a static buffer
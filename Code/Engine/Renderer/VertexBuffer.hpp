@@ -19,6 +19,9 @@ public:
 
 	bool					CopyCPUToGPU( void const *vertices, uint const count, uint const stride ); 
 
+	// Like CopyCPUToGPU but hands back the mapped memory so vertices can be written straight into it. Finish with Unmap.
+	void*					MapForWrite( uint const count, uint const stride );
+
 	//For when we need a static vertex buffer (ex: static meshes)
 	bool					CreateStaticFor( Vertex_PCU const *vertices, uint const count );
 	